@@ -87,7 +87,6 @@ linux)
         libdbus-1-dev            \
         autoconf-archive         \
         doxygen                  \
-        ctags                    \
         expect                   \
         libboost-dev             \
         libboost-filesystem-dev  \
@@ -99,10 +99,22 @@ LOCAL_SRC_FILES := \
     third_party/wpantund/repo/src/wpanctl/wpanctl-utils.c \
     src/agent/agent_instance.cpp \
     src/agent/border_agent.cpp \
+    src/agent/commissioner_server.cpp \
+    src/agent/mdns_cache.cpp \
     src/agent/main.cpp \
     src/agent/ncp_wpantund.cpp \
-    src/common/event_emitter.cpp \
+    src/agent/state_server.cpp \
+    src/common/coap_native.cpp \
+    src/common/coap_router.cpp \
+    src/common/coap_rto.cpp \
+    src/common/event_loop.cpp \
+    src/common/event_loop_epoll.cpp \
+    src/common/event_loop_select.cpp \
+    src/common/log_record.cpp \
+    src/common/log_writer.cpp \
     src/common/logging.cpp \
+    src/common/time.cpp \
+    src/common/udp_batch.cpp \
     src/utils/hex.cpp \
     src/utils/strcpy_utils.cpp \
     $(NULL)
@@ -45,35 +45,30 @@ namespace BorderRouter {
 AgentInstance::AgentInstance(Ncp::Controller *aNcp)
     : mNcp(aNcp)
     , mBorderAgent(aNcp)
+    , mStateServer(aNcp)
+    , mCommissionerServer(aNcp)
 {
 }
 
-otbrError AgentInstance::Init(void)
+otbrError AgentInstance::Init(EventLoop &aEventLoop)
 {
     otbrError error = OTBR_ERROR_NONE;
 
-    SuccessOrExit(error = mNcp->Init());
+    SuccessOrExit(error = mNcp->Init(aEventLoop));
 
-    mBorderAgent.Init();
+    mBorderAgent.Init(aEventLoop);
+
+    // The state server is left disabled if this fails, Thread state is still served by polling.
+    mStateServer.Init(aEventLoop);
+
+    // Local commissioning is optional as well.
+    mCommissionerServer.Init(aEventLoop);
 
 exit:
     otbrLogResult("Initialize OpenThread Border Router Agent", error);
     return error;
 }
 
-void AgentInstance::UpdateFdSet(otSysMainloopContext &aMainloop)
-{
-    mNcp->UpdateFdSet(aMainloop);
-    mBorderAgent.UpdateFdSet(aMainloop.mReadFdSet, aMainloop.mWriteFdSet, aMainloop.mErrorFdSet, aMainloop.mMaxFd,
-                             aMainloop.mTimeout);
-}
-
-void AgentInstance::Process(const otSysMainloopContext &aMainloop)
-{
-    mNcp->Process(aMainloop);
-    mBorderAgent.Process(aMainloop.mReadFdSet, aMainloop.mWriteFdSet, aMainloop.mErrorFdSet);
-}
-
 AgentInstance::~AgentInstance(void)
 {
     Ncp::Controller::Destroy(mNcp);
@@ -36,11 +36,13 @@
 
 #include <stdarg.h>
 #include <stdint.h>
-#include <sys/select.h>
 #include <sys/types.h>
 
 #include "border_agent.hpp"
+#include "commissioner_server.hpp"
 #include "ncp.hpp"
+#include "state_server.hpp"
+#include "common/event_loop.hpp"
 
 namespace ot {
 
@@ -66,32 +68,20 @@ public:
     /**
      * This method initialize the agent.
      *
+     * @param[in]   aEventLoop  A reference to the event loop, which components register to.
+     *
      * @retval  OTBR_ERROR_NONE     Agent initialized successfully.
      * @retval  OTBR_ERROR_DTLS     Failed to initialize DTLS service.
      * @retval  OTBR_ERROR_ERRNO    Failed due to error indicated in errno.
      *
      */
-    otbrError Init(void);
-
-    /**
-     * This method updates the file descriptor sets and timeout for mainloop.
-     *
-     * @param[inout]    aMainloop   A reference to OpenThread mainloop context.
-     *
-     */
-    void UpdateFdSet(otSysMainloopContext &aMainloop);
-
-    /**
-     * This method performs processing.
-     *
-     * @param[in]       aMainloop   A reference to OpenThread mainloop context.
-     *
-     */
-    void Process(const otSysMainloopContext &aMainloop);
+    otbrError Init(EventLoop &aEventLoop);
 
 private:
-    Ncp::Controller *mNcp;
-    BorderAgent      mBorderAgent;
+    Ncp::Controller *  mNcp;
+    BorderAgent        mBorderAgent;
+    StateServer        mStateServer;
+    CommissionerServer mCommissionerServer;
 };
 
 } // namespace BorderRouter
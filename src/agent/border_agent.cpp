@@ -55,8 +55,7 @@ namespace ot {
 
 namespace BorderRouter {
 
-static const char   kBorderAgentServiceType[] = "_meshcop._udp."; ///< Border agent service type of mDNS
-static const size_t kMaxSizeOfPacket          = 1500;             ///< Max size of packet in bytes.
+static const char kBorderAgentServiceType[] = "_meshcop._udp."; ///< Border agent service type of mDNS
 
 /**
  * Locators
@@ -78,36 +77,66 @@ enum
 };
 
 BorderAgent::BorderAgent(Ncp::Controller *aNcp)
-#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    : mPublisher(Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, HandleMdnsState, this))
-#else
-    : mPublisher(NULL)
-#endif
+    : mEventLoop(NULL)
+    , mPublisher(NULL)
+    , mBrowser(NULL)
     , mNcp(aNcp)
 #if OTBR_ENABLE_NCP_WPANTUND
     , mSocket(-1)
+    , mFlushTimer(HandleFlushTimer, this)
 #endif
+    , mPublishTimer(HandlePublishTimer, this)
     , mThreadStarted(false)
+    , mPSKcInitialized(false)
 {
 }
 
-void BorderAgent::Init(void)
+void BorderAgent::Init(EventLoop &aEventLoop)
 {
+    mEventLoop = &aEventLoop;
+
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    mPublisher = Mdns::Publisher::Create(aEventLoop, AF_UNSPEC, NULL, NULL, HandleMdnsState, this);
+#endif
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD
+    mBrowser = Mdns::Browser::Create(aEventLoop, AF_UNSPEC, kBorderAgentServiceType, NULL, mPeers);
+#endif
+
     memset(mNetworkName, 0, sizeof(mNetworkName));
     memset(mExtPanId, 0, sizeof(mExtPanId));
+    memset(mPublishedName, 0, sizeof(mPublishedName));
 
 #if OTBR_ENABLE_NCP_WPANTUND
-    mNcp->On(Ncp::kEventUdpForwardStream, SendToCommissioner, this);
+    mNcp->On<Ncp::kEventUdpForwardStream>(SendToCommissioner, this);
+#endif
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    mNcp->On<Ncp::kEventExtPanId>(HandleExtPanId, this);
+    mNcp->On<Ncp::kEventNetworkName>(HandleNetworkName, this);
 #endif
+    mNcp->On<Ncp::kEventThreadState>(HandleThreadState, this);
+    mNcp->On<Ncp::kEventPSKc>(HandlePSKc, this);
+
+    {
+        // Network name and extended PAN ID are requested first so they are known when Thread state starts the agent.
+        const int events[] = {
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    mNcp->On(Ncp::kEventExtPanId, HandleExtPanId, this);
-    mNcp->On(Ncp::kEventNetworkName, HandleNetworkName, this);
+            Ncp::kEventNetworkName,
+            Ncp::kEventExtPanId,
 #endif
-    mNcp->On(Ncp::kEventThreadState, HandleThreadState, this);
-    mNcp->On(Ncp::kEventPSKc, HandlePSKc, this);
+            Ncp::kEventThreadState,
+            Ncp::kEventPSKc,
+        };
 
-    otbrLogResult("Check if Thread is up", mNcp->RequestEvent(Ncp::kEventThreadState));
-    otbrLogResult("Check if PSKc is initialized", mNcp->RequestEvent(Ncp::kEventPSKc));
+        otbrLogResult("Request NCP properties", mNcp->RequestEvents(events, sizeof(events) / sizeof(events[0])));
+    }
+
+    if (mBrowser != NULL)
+    {
+        // Other border agents are browsed regardless of Thread state, for clients to list networks nearby.
+        mPeers.On<Mdns::kEventServiceAdded>(HandlePeerAdded, this);
+        mPeers.On<Mdns::kEventServiceRemoved>(HandlePeerRemoved, this);
+        otbrLogResult("Browse border agents", mBrowser->Start());
+    }
 }
 
 otbrError BorderAgent::Start(void)
@@ -129,11 +158,11 @@ otbrError BorderAgent::Start(void)
     VerifyOrExit(mSocket != -1, error = OTBR_ERROR_ERRNO);
     VerifyOrExit(bind(mSocket, reinterpret_cast<struct sockaddr *>(&sin6), sizeof(sin6)) == 0,
                  error = OTBR_ERROR_ERRNO);
+    SuccessOrExit(error = mEventLoop->AddIo(mSocket, EventLoop::kEventReadable, HandleIo, this));
 #endif
 
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    SuccessOrExit(error = mNcp->RequestEvent(Ncp::kEventNetworkName));
-    SuccessOrExit(error = mNcp->RequestEvent(Ncp::kEventExtPanId));
+    // Network name and extended PAN ID were requested in Init() and are kept up to date by NCP events.
     StartPublishService();
 #endif // OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
 
@@ -150,6 +179,20 @@ void BorderAgent::Stop(void)
 #if OTBR_ENABLE_NCP_WPANTUND
     if (mSocket != -1)
     {
+        const UdpBatch::Counters &counters = mBatch.GetCounters();
+
+        mEventLoop->StopTimer(mFlushTimer);
+
+        if (mBatch.HasPending())
+        {
+            mBatch.Flush(mSocket);
+        }
+
+        otbrLog(OTBR_LOG_INFO, "Border agent UDP: %lu datagrams in %lu batches (%lu full), sent %lu in %lu batches",
+                counters.mReceivedDatagrams, counters.mReceiveBatches, counters.mFullReceiveBatches,
+                counters.mSentDatagrams, counters.mSendBatches);
+
+        mEventLoop->RemoveIo(mSocket);
         close(mSocket);
         mSocket = -1;
     }
@@ -169,6 +212,12 @@ BorderAgent::~BorderAgent(void)
         delete mPublisher;
         mPublisher = NULL;
     }
+
+    if (mBrowser != NULL)
+    {
+        delete mBrowser;
+        mBrowser = NULL;
+    }
 }
 
 void BorderAgent::HandleMdnsState(Mdns::State aState)
@@ -184,91 +233,97 @@ void BorderAgent::HandleMdnsState(Mdns::State aState)
     }
 }
 
+void BorderAgent::HandlePeerAdded(void *aContext, const Mdns::DiscoveredService &aService)
+{
+    (void)aContext;
+
+    otbrLog(OTBR_LOG_INFO, "Border agent %s found at %s:%u", aService.mName.c_str(), aService.mHostName.c_str(),
+            aService.mPort);
+}
+
+void BorderAgent::HandlePeerRemoved(void *aContext, const Mdns::DiscoveredService &aService)
+{
+    (void)aContext;
+
+    otbrLog(OTBR_LOG_INFO, "Border agent %s gone", aService.mName.c_str());
+}
+
 #if OTBR_ENABLE_NCP_WPANTUND
-void BorderAgent::SendToCommissioner(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::SendToCommissioner(void *          aContext,
+                                     const uint8_t * aBuffer,
+                                     uint16_t        aLength,
+                                     uint16_t        aPeerPort,
+                                     const in6_addr &aPeerAddr,
+                                     uint16_t        aSockPort)
 {
     struct sockaddr_in6 sin6;
-    const uint8_t *     packet      = va_arg(aArguments, const uint8_t *);
-    uint16_t            length      = static_cast<uint16_t>(va_arg(aArguments, unsigned int));
-    uint16_t            peerPort    = static_cast<uint16_t>(va_arg(aArguments, unsigned int));
-    const in6_addr *    addr        = va_arg(aArguments, const in6_addr *);
-    uint16_t            sockPort    = static_cast<uint16_t>(va_arg(aArguments, unsigned int));
     BorderAgent *       borderAgent = static_cast<BorderAgent *>(aContext);
 
-    (void)aEvent;
-    assert(aEvent == Ncp::kEventUdpForwardStream);
-    VerifyOrExit(sockPort == kBorderAgentUdpPort);
+    VerifyOrExit(aSockPort == kBorderAgentUdpPort);
     VerifyOrExit(borderAgent->mSocket != -1);
 
     memset(&sin6, 0, sizeof(sin6));
     sin6.sin6_family = AF_INET6;
-    memcpy(sin6.sin6_addr.s6_addr, addr->s6_addr, sizeof(sin6.sin6_addr));
-    sin6.sin6_port = htons(peerPort);
+    memcpy(sin6.sin6_addr.s6_addr, aPeerAddr.s6_addr, sizeof(sin6.sin6_addr));
+    sin6.sin6_port = htons(aPeerPort);
+
+    // Packets forwarded in the same pass of the event loop are sent together by the flush timer.
+    VerifyOrExit(borderAgent->mBatch.Send(borderAgent->mSocket, aBuffer, aLength, sin6, NULL) == OTBR_ERROR_NONE,
+                 perror("send to commissioner"));
 
+    if (borderAgent->mBatch.HasPending() && !borderAgent->mFlushTimer.IsRunning())
     {
-        ssize_t sent =
-            sendto(borderAgent->mSocket, packet, length, 0, reinterpret_cast<const sockaddr *>(&sin6), sizeof(sin6));
-        VerifyOrExit(sent == static_cast<ssize_t>(length), perror("send to commissioner"));
+        borderAgent->mEventLoop->StartTimer(borderAgent->mFlushTimer, 0);
     }
 
-    otbrLog(OTBR_LOG_DEBUG, "Sent to commissioner");
+    otbrLog(OTBR_LOG_DEBUG, "Queued to commissioner");
 
 exit:
     return;
 }
-#endif // OTBR_ENABLE_NCP_WPANTUND
-
-void BorderAgent::UpdateFdSet(fd_set & aReadFdSet,
-                              fd_set & aWriteFdSet,
-                              fd_set & aErrorFdSet,
-                              int &    aMaxFd,
-                              timeval &aTimeout)
+void BorderAgent::HandleIo(void *aContext, int aFd, unsigned int aEvents)
 {
-    (void)aErrorFdSet;
-    (void)aMaxFd;
-    (void)aReadFdSet;
-    (void)aTimeout;
-    (void)aWriteFdSet;
-
-#if OTBR_ENABLE_NCP_WPANTUND
-    if (mSocket != -1)
-    {
-        FD_SET(mSocket, &aReadFdSet);
-
-        if (mSocket > aMaxFd)
-        {
-            aMaxFd = mSocket;
-        }
-    }
+    (void)aFd;
+    (void)aEvents;
 
-#endif // OTBR_ENABLE_NCP_WPANTUND
+    static_cast<BorderAgent *>(aContext)->HandleIo();
 }
 
-void BorderAgent::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void BorderAgent::HandleIo(void)
 {
-    (void)aErrorFdSet;
-    (void)aReadFdSet;
-    (void)aWriteFdSet;
+    int count;
 
-#if OTBR_ENABLE_NCP_WPANTUND
-    uint8_t             packet[kMaxSizeOfPacket];
-    struct sockaddr_in6 sin6;
-    ssize_t             len     = sizeof(packet);
-    socklen_t           socklen = sizeof(sin6);
+    if (mBatch.HasPending())
+    {
+        mBatch.Flush(mSocket);
+    }
 
-    VerifyOrExit(mSocket != -1 && FD_ISSET(mSocket, &aReadFdSet));
+    count = mBatch.Receive(mSocket);
+    VerifyOrExit(count >= 0, perror("receive from commissioner"));
 
-    len = recvfrom(mSocket, packet, sizeof(packet), 0, reinterpret_cast<struct sockaddr *>(&sin6), &socklen);
-    VerifyOrExit(len > 0);
+    for (int i = 0; i < count; ++i)
+    {
+        const UdpBatch::Datagram &datagram = mBatch.GetReceived(static_cast<size_t>(i));
 
-    mNcp->UdpForwardSend(packet, static_cast<uint16_t>(len), ntohs(sin6.sin6_port), sin6.sin6_addr,
-                         kBorderAgentUdpPort);
+        mNcp->UdpForwardSend(datagram.mPacket, datagram.mLength, ntohs(datagram.mPeerSock.sin6_port),
+                             datagram.mPeerSock.sin6_addr, kBorderAgentUdpPort);
+    }
 
 exit:
-#endif
     return;
 }
 
+void BorderAgent::HandleFlushTimer(void *aContext)
+{
+    BorderAgent *borderAgent = static_cast<BorderAgent *>(aContext);
+
+    if (borderAgent->mBatch.HasPending())
+    {
+        borderAgent->mBatch.Flush(borderAgent->mSocket);
+    }
+}
+#endif // OTBR_ENABLE_NCP_WPANTUND
+
 void BorderAgent::PublishService(void)
 {
     char xpanid[sizeof(mExtPanId) * 2 + 1];
@@ -277,6 +332,36 @@ void BorderAgent::PublishService(void)
     Utils::Bytes2Hex(mExtPanId, sizeof(mExtPanId), xpanid);
     mPublisher->PublishService(kBorderAgentUdpPort, mNetworkName, kBorderAgentServiceType, "nn", mNetworkName, "xp",
                                xpanid, NULL);
+    strcpy_safe(mPublishedName, sizeof(mPublishedName), mNetworkName);
+}
+
+void BorderAgent::SchedulePublish(void)
+{
+    if (!mPublishTimer.IsRunning())
+    {
+        mEventLoop->StartTimer(mPublishTimer, 0);
+    }
+}
+
+void BorderAgent::HandlePublishTimer(void *aContext)
+{
+    static_cast<BorderAgent *>(aContext)->PublishPendingService();
+}
+
+void BorderAgent::PublishPendingService(void)
+{
+    VerifyOrExit(mPublisher->IsStarted() && mPublishedName[0] != '\0', StartPublishService());
+
+    if (strcmp(mPublishedName, mNetworkName) != 0)
+    {
+        // Only the border agent service is announced again, with its new name and text record together.
+        mPublisher->RenameService(kBorderAgentServiceType, mPublishedName, mNetworkName);
+    }
+
+    PublishService();
+
+exit:
+    return;
 }
 
 void BorderAgent::StartPublishService(void)
@@ -305,6 +390,9 @@ void BorderAgent::StopPublishService(void)
         mPublisher->Stop();
     }
 
+    mPublishedName[0] = '\0';
+    mEventLoop->StopTimer(mPublishTimer);
+
 exit:
     otbrLog(OTBR_LOG_INFO, "Stop publishing service");
 }
@@ -316,9 +404,8 @@ void BorderAgent::SetNetworkName(const char *aNetworkName)
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
     if (mThreadStarted)
     {
-        // Restart publisher to publish new service name.
-        mPublisher->Stop();
-        StartPublishService();
+        // Published when returning to the event loop, together with a following extended PAN ID change.
+        SchedulePublish();
     }
 #endif
 }
@@ -329,16 +416,14 @@ void BorderAgent::SetExtPanId(const uint8_t *aExtPanId)
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
     if (mThreadStarted)
     {
-        StartPublishService();
+        SchedulePublish();
     }
 #endif
 }
 
-void BorderAgent::HandlePSKc(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandlePSKc(void *aContext, const uint8_t *aPSKc)
 {
-    assert(aEvent == Ncp::kEventPSKc);
-
-    static_cast<BorderAgent *>(aContext)->HandlePSKc(va_arg(aArguments, const uint8_t *));
+    static_cast<BorderAgent *>(aContext)->HandlePSKc(aPSKc);
 }
 
 void BorderAgent::HandlePSKc(const uint8_t *aPSKc)
@@ -385,28 +470,19 @@ exit:
     otbrLog(OTBR_LOG_INFO, "Thread is %s", (aStarted ? "up" : "down"));
 }
 
-void BorderAgent::HandleThreadState(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleThreadState(void *aContext, bool aStarted)
 {
-    assert(aEvent == Ncp::kEventThreadState);
-
-    int started = va_arg(aArguments, int);
-    static_cast<BorderAgent *>(aContext)->HandleThreadState(started);
+    static_cast<BorderAgent *>(aContext)->HandleThreadState(aStarted);
 }
 
-void BorderAgent::HandleNetworkName(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleNetworkName(void *aContext, const char *aNetworkName)
 {
-    assert(aEvent == Ncp::kEventNetworkName);
-
-    const char *networkName = va_arg(aArguments, const char *);
-    static_cast<BorderAgent *>(aContext)->SetNetworkName(networkName);
+    static_cast<BorderAgent *>(aContext)->SetNetworkName(aNetworkName);
 }
 
-void BorderAgent::HandleExtPanId(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleExtPanId(void *aContext, const uint8_t *aExtPanId)
 {
-    assert(aEvent == Ncp::kEventExtPanId);
-
-    const uint8_t *xpanid = va_arg(aArguments, const uint8_t *);
-    static_cast<BorderAgent *>(aContext)->SetExtPanId(xpanid);
+    static_cast<BorderAgent *>(aContext)->SetExtPanId(aExtPanId);
 }
 
 } // namespace BorderRouter
@@ -37,7 +37,9 @@
 #include <stdint.h>
 
 #include "mdns.hpp"
+#include "mdns_cache.hpp"
 #include "ncp.hpp"
+#include "common/udp_batch.hpp"
 
 namespace ot {
 
@@ -72,30 +74,18 @@ public:
     /**
      * This method initialize border agent service.
      *
-     */
-    void Init(void);
-
-    /**
-     * This method updates the fd_set and timeout for mainloop.
-     *
-     * @param[inout]  aReadFdSet   A reference to read file descriptors.
-     * @param[inout]  aWriteFdSet  A reference to write file descriptors.
-     * @param[inout]  aErrorFdSet  A reference to error file descriptors.
-     * @param[inout]  aMaxFd       A reference to the max file descriptor.
-     * @param[inout]  aTimeout     A reference to timeout.
+     * @param[in]   aEventLoop  A reference to the event loop, which the border agent and MDNS services register to.
      *
      */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+    void Init(EventLoop &aEventLoop);
 
     /**
-     * This method performs border agent processing.
+     * This method returns the border agents discovered on the links of this host, including this one once published.
      *
-     * @param[in]   aReadFdSet   A reference to read file descriptors.
-     * @param[in]   aWriteFdSet  A reference to write file descriptors.
-     * @param[in]   aErrorFdSet  A reference to error file descriptors.
+     * @returns A reference to the cache of border agent services, keyed by instance name.
      *
      */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    const Mdns::ServiceCache &GetPeers(void) const { return mPeers; }
 
 private:
     /**
@@ -114,7 +104,16 @@ private:
     void Stop(void);
 
 #if OTBR_ENABLE_NCP_WPANTUND
-    static void SendToCommissioner(void *aContext, int aEvent, va_list aArguments);
+    static void SendToCommissioner(void *          aContext,
+                                   const uint8_t * aBuffer,
+                                   uint16_t        aLength,
+                                   uint16_t        aPeerPort,
+                                   const in6_addr &aPeerAddr,
+                                   uint16_t        aSockPort);
+
+    static void HandleIo(void *aContext, int aFd, unsigned int aEvents);
+    void        HandleIo(void);
+    static void HandleFlushTimer(void *aContext);
 #endif
 
     static void HandleMdnsState(void *aContext, Mdns::State aState)
@@ -122,30 +121,44 @@ private:
         static_cast<BorderAgent *>(aContext)->HandleMdnsState(aState);
     }
     void HandleMdnsState(Mdns::State aState);
-    void PublishService(void);
-    void StartPublishService(void);
-    void StopPublishService(void);
+
+    static void HandlePeerAdded(void *aContext, const Mdns::DiscoveredService &aService);
+    static void HandlePeerRemoved(void *aContext, const Mdns::DiscoveredService &aService);
+
+    void        PublishService(void);
+    void        SchedulePublish(void);
+    static void HandlePublishTimer(void *aContext);
+    void        PublishPendingService(void);
+    void        StartPublishService(void);
+    void        StopPublishService(void);
 
     void SetNetworkName(const char *aNetworkName);
     void SetExtPanId(const uint8_t *aExtPanId);
     void HandleThreadState(bool aStarted);
     void HandlePSKc(const uint8_t *aPSKc);
 
-    static void HandlePSKc(void *aContext, int aEvent, va_list aArguments);
-    static void HandleThreadState(void *aContext, int aEvent, va_list aArguments);
-    static void HandleNetworkName(void *aContext, int aEvent, va_list aArguments);
-    static void HandleExtPanId(void *aContext, int aEvent, va_list aArguments);
+    static void HandlePSKc(void *aContext, const uint8_t *aPSKc);
+    static void HandleThreadState(void *aContext, bool aStarted);
+    static void HandleNetworkName(void *aContext, const char *aNetworkName);
+    static void HandleExtPanId(void *aContext, const uint8_t *aExtPanId);
 
-    Mdns::Publisher *mPublisher;
-    Ncp::Controller *mNcp;
+    EventLoop *        mEventLoop;
+    Mdns::Publisher *  mPublisher;
+    Mdns::ServiceCache mPeers;
+    Mdns::Browser *    mBrowser;
+    Ncp::Controller *  mNcp;
 
 #if OTBR_ENABLE_NCP_WPANTUND
-    int mSocket;
+    int              mSocket;
+    UdpBatch         mBatch;
+    EventLoop::Timer mFlushTimer; ///< Sends the packets forwarded in one pass of the event loop together.
 #endif
-    uint8_t mExtPanId[kSizeExtPanId];
-    char    mNetworkName[kSizeNetworkName + 1];
-    bool    mThreadStarted;
-    bool    mPSKcInitialized;
+    uint8_t          mExtPanId[kSizeExtPanId];
+    char             mNetworkName[kSizeNetworkName + 1];
+    char             mPublishedName[kSizeNetworkName + 1]; ///< The service name last published, empty if none.
+    EventLoop::Timer mPublishTimer;                        ///< Publishes changes made in one pass together.
+    bool             mThreadStarted;
+    bool             mPSKcInitialized;
 };
 
 /**
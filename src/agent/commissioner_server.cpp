@@ -0,0 +1,575 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the local commissioning service.
+ */
+
+#include "commissioner_server.hpp"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+#include "utils/hex.hpp"
+#include "utils/strcpy_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+enum
+{
+    kMaxArgs        = 6,  ///< Max number of arguments of a command.
+    kMinPSKdLength  = 6,  ///< Min length of a PSKd, Thread 1.1 8.10.3.1.
+    kMaxPSKdLength  = 32, ///< Max length of a PSKd.
+    kMaxReplyLength = 64, ///< Max length of a line of reply.
+};
+
+static const char *const kStateNames[] = {"disabled", "petition", "active"};
+
+CommissionerServer::CommissionerServer(Ncp::Controller *aNcp, const char *aSocketName)
+    : mNcp(aNcp)
+    , mEventLoop(NULL)
+    , mSocketName(aSocketName)
+    , mSocket(-1)
+    , mNumRequests(0)
+    , mState(Ncp::kCommissionerStateDisabled)
+    , mJoinerTimer(HandleJoinerTimer, this)
+    , mPSKcInitialized(false)
+{
+    for (size_t i = 0; i < kMaxClients; ++i)
+    {
+        mClients[i].mFd       = -1;
+        mClients[i].mLength   = 0;
+        mClients[i].mStarting = false;
+    }
+
+    memset(mPSKc, 0, sizeof(mPSKc));
+}
+
+CommissionerServer::~CommissionerServer(void)
+{
+    for (size_t i = 0; i < kMaxClients; ++i)
+    {
+        Close(mClients[i]);
+    }
+
+    if (mEventLoop != NULL)
+    {
+        mEventLoop->StopTimer(mJoinerTimer);
+    }
+
+    if (mSocket != -1)
+    {
+        mEventLoop->RemoveIo(mSocket);
+        close(mSocket);
+        unlink(mSocketName);
+    }
+}
+
+otbrError CommissionerServer::Init(EventLoop &aEventLoop)
+{
+    otbrError   error = OTBR_ERROR_ERRNO;
+    sockaddr_un sun;
+
+    memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    VerifyOrExit(strlen(mSocketName) < sizeof(sun.sun_path), errno = ENAMETOOLONG);
+    strcpy_safe(sun.sun_path, sizeof(sun.sun_path), mSocketName);
+
+    // A socket left by a previous run would fail bind().
+    unlink(mSocketName);
+
+    mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    VerifyOrExit(mSocket != -1);
+    VerifyOrExit(fcntl(mSocket, F_SETFL, fcntl(mSocket, F_GETFL) | O_NONBLOCK) == 0);
+    VerifyOrExit(bind(mSocket, reinterpret_cast<sockaddr *>(&sun), sizeof(sun)) == 0);
+
+    // Clients may start the commissioner, so they must be as trusted as the agent.
+    VerifyOrExit(chmod(mSocketName, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) == 0);
+
+    VerifyOrExit(listen(mSocket, kMaxClients) == 0);
+    SuccessOrExit(error = aEventLoop.AddIo(mSocket, EventLoop::kEventReadable, HandleAccept, this));
+    mEventLoop = &aEventLoop;
+
+    mNcp->On<Ncp::kEventCommissionerState>(HandleCommissionerState, this);
+    mNcp->On<Ncp::kEventCommissionerResult>(HandleCommissionerResult, this);
+    mNcp->On<Ncp::kEventPSKc>(HandlePSKc, this);
+
+    {
+        const int events[] = {Ncp::kEventCommissionerState, Ncp::kEventPSKc};
+
+        // The NCP reports them again once it is up.
+        mNcp->RequestEvents(events, sizeof(events) / sizeof(events[0]));
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE && mSocket != -1)
+    {
+        close(mSocket);
+        mSocket = -1;
+    }
+
+    otbrLogResult("Start commissioning service", error);
+    return error;
+}
+
+void CommissionerServer::HandleAccept(void *aContext, int aFd, unsigned int aEvents)
+{
+    static_cast<CommissionerServer *>(aContext)->Accept();
+
+    (void)aFd;
+    (void)aEvents;
+}
+
+void CommissionerServer::HandleClient(void *aContext, int aFd, unsigned int aEvents)
+{
+    CommissionerServer *server = static_cast<CommissionerServer *>(aContext);
+
+    for (size_t i = 0; i < kMaxClients; ++i)
+    {
+        if (server->mClients[i].mFd == aFd)
+        {
+            server->Receive(server->mClients[i]);
+            break;
+        }
+    }
+
+    (void)aEvents;
+}
+
+void CommissionerServer::Accept(void)
+{
+    int     fd;
+    Client *client = NULL;
+
+    VerifyOrExit((fd = accept(mSocket, NULL, NULL)) != -1);
+
+    for (size_t i = 0; i < kMaxClients; ++i)
+    {
+        if (mClients[i].mFd == -1)
+        {
+            client = &mClients[i];
+            break;
+        }
+    }
+
+    VerifyOrExit(client != NULL, close(fd), otbrLog(OTBR_LOG_WARNING, "commissioning: too many clients"));
+
+    VerifyOrExit(mEventLoop->AddIo(fd, EventLoop::kEventReadable, HandleClient, this) == OTBR_ERROR_NONE,
+                 close(fd), otbrLog(OTBR_LOG_WARNING, "commissioning: failed to watch client: %s", strerror(errno)));
+
+    client->mFd       = fd;
+    client->mLength   = 0;
+    client->mStarting = false;
+
+exit:
+    return;
+}
+
+void CommissionerServer::Receive(Client &aClient)
+{
+    char    buffer[kMaxLineLength];
+    ssize_t count = recv(aClient.mFd, buffer, sizeof(buffer), 0);
+
+    VerifyOrExit(count > 0, Close(aClient));
+
+    for (ssize_t i = 0; i < count && aClient.mFd != -1; ++i)
+    {
+        if (buffer[i] != '\n')
+        {
+            // A line too long is marked by a length of kMaxLineLength, and rejected as a whole.
+            if (aClient.mLength < kMaxLineLength - 1)
+            {
+                aClient.mLine[aClient.mLength++] = buffer[i];
+            }
+            else
+            {
+                aClient.mLength = kMaxLineLength;
+            }
+            continue;
+        }
+
+        if (aClient.mLength == kMaxLineLength)
+        {
+            errno = E2BIG;
+            Reply(aClient, NULL);
+        }
+        else
+        {
+            if (aClient.mLength > 0 && aClient.mLine[aClient.mLength - 1] == '\r')
+            {
+                --aClient.mLength;
+            }
+
+            aClient.mLine[aClient.mLength] = '\0';
+
+            // Empty lines are ignored, as OpenThread CLI does.
+            if (aClient.mLength > 0)
+            {
+                HandleCommand(aClient, aClient.mLine);
+            }
+        }
+
+        aClient.mLength = 0;
+    }
+
+exit:
+    return;
+}
+
+void CommissionerServer::HandleCommand(Client &aClient, char *aLine)
+{
+    otbrError   error  = OTBR_ERROR_ERRNO;
+    const char *output = NULL;
+    char *      args[kMaxArgs];
+    int         argc = 0;
+    char *      savePtr;
+
+    for (char *arg = strtok_r(aLine, " \t", &savePtr); arg != NULL; arg = strtok_r(NULL, " \t", &savePtr))
+    {
+        VerifyOrExit(argc < kMaxArgs, errno = E2BIG);
+        args[argc++] = arg;
+    }
+
+    VerifyOrExit(argc >= 2 && !strcmp(args[0], "commissioner"), errno = EINVAL);
+
+    if (!strcmp(args[1], "start") && argc == 3)
+    {
+        error = HandleStart(aClient, args[2]);
+    }
+    else if (!strcmp(args[1], "stop") && argc == 2)
+    {
+        SuccessOrExit(error = PushRequest(&aClient, 0));
+        VerifyOrExit((error = mNcp->CommissionerStop()) == OTBR_ERROR_NONE, PopRequest());
+    }
+    else if (!strcmp(args[1], "state") && argc == 2)
+    {
+        output = kStateNames[mState];
+        error  = OTBR_ERROR_NONE;
+    }
+    else if (!strcmp(args[1], "joiner") && argc >= 5 && !strcmp(args[2], "add"))
+    {
+        error = HandleJoinerAdd(aClient, args[3], args[4], argc == 6 ? args[5] : NULL);
+    }
+    else
+    {
+        errno = EINVAL;
+    }
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        Reply(aClient, NULL);
+    }
+    else if (output != NULL)
+    {
+        Reply(aClient, output);
+        Reply(aClient, "Done");
+    }
+
+    // Otherwise answered by HandleCommissionerResult() once the NCP has handled the request.
+}
+
+otbrError CommissionerServer::HandleStart(Client &aClient, const char *aPSKc)
+{
+    otbrError ret = OTBR_ERROR_ERRNO;
+    uint8_t   pskc[kSizePSKc];
+
+    // The PSKc is what an external commissioner proves, so local clients are held to it too.
+    VerifyOrExit(strlen(aPSKc) == kSizePSKc * 2 && Utils::Hex2Bytes(aPSKc, pskc, sizeof(pskc)) == kSizePSKc,
+                 errno = EINVAL);
+    VerifyOrExit(mPSKcInitialized, errno = EAGAIN);
+    VerifyOrExit(memcmp(pskc, mPSKc, sizeof(pskc)) == 0, errno = EACCES);
+
+    SuccessOrExit(ret = PushRequest(&aClient, 0));
+    VerifyOrExit((ret = mNcp->CommissionerStart()) == OTBR_ERROR_NONE, PopRequest());
+
+exit:
+    return ret;
+}
+
+otbrError CommissionerServer::HandleJoinerAdd(Client &    aClient,
+                                              const char *aEui64,
+                                              const char *aPSKd,
+                                              const char *aTimeout)
+{
+    otbrError     ret     = OTBR_ERROR_ERRNO;
+    uint8_t       eui64[kSizeEui64];
+    bool          any     = !strcmp(aEui64, "*");
+    unsigned long timeout = kDefaultJoinerTimeout;
+    size_t        length  = strlen(aPSKd);
+
+    if (!any)
+    {
+        VerifyOrExit(strlen(aEui64) == kSizeEui64 * 2 && Utils::Hex2Bytes(aEui64, eui64, sizeof(eui64)) == kSizeEui64,
+                     errno = EINVAL);
+    }
+
+    VerifyOrExit(length >= kMinPSKdLength && length <= kMaxPSKdLength, errno = EINVAL);
+
+    if (aTimeout != NULL)
+    {
+        char *end;
+
+        timeout = strtoul(aTimeout, &end, 0);
+        // Bounded so that the window in milliseconds fits the timer.
+        VerifyOrExit(*end == '\0' && timeout > 0 && timeout <= kMaxJoinerTimeout, errno = EINVAL);
+    }
+
+    VerifyOrExit(mState == Ncp::kCommissionerStateActive, errno = EBUSY);
+
+    SuccessOrExit(ret = PushRequest(&aClient, timeout));
+    VerifyOrExit((ret = mNcp->CommissionerAddJoiner(any ? NULL : eui64, aPSKd, static_cast<uint32_t>(timeout))) ==
+                     OTBR_ERROR_NONE,
+                 PopRequest());
+
+exit:
+    return ret;
+}
+
+otbrError CommissionerServer::PushRequest(Client *aClient, unsigned long aJoinerTimeout)
+{
+    otbrError ret = OTBR_ERROR_ERRNO;
+
+    VerifyOrExit(mNumRequests < kMaxRequests, errno = EBUSY);
+
+    // Pushed before the request is sent, as its result may be emitted before the NCP returns.
+    mRequests[mNumRequests].mClient        = aClient;
+    mRequests[mNumRequests].mJoinerTimeout = aJoinerTimeout;
+    ++mNumRequests;
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+void CommissionerServer::PopRequest(void)
+{
+    // The request failed to be sent, so no result comes for it.
+    assert(mNumRequests > 0);
+    --mNumRequests;
+}
+
+void CommissionerServer::Reply(Client &aClient, const char *aOutput)
+{
+    char line[kMaxReplyLength];
+    int  length;
+
+    VerifyOrExit(aClient.mFd != -1);
+
+    // Errors are reported in errno, the way OpenThread CLI reports them.
+    if (aOutput == NULL)
+    {
+        length = snprintf(line, sizeof(line), "Error %d: %s\r\n", errno, strerror(errno));
+    }
+    else
+    {
+        length = snprintf(line, sizeof(line), "%s\r\n", aOutput);
+    }
+
+    length = (length < static_cast<int>(sizeof(line)) ? length : static_cast<int>(sizeof(line)) - 1);
+
+    // Replies are short, a client not reading them is dropped rather than blocking the agent.
+    VerifyOrExit(send(aClient.mFd, line, static_cast<size_t>(length), MSG_DONTWAIT | MSG_NOSIGNAL) == length,
+                 Close(aClient));
+
+exit:
+    return;
+}
+
+void CommissionerServer::Close(Client &aClient)
+{
+    if (aClient.mFd != -1)
+    {
+        mEventLoop->RemoveIo(aClient.mFd);
+        close(aClient.mFd);
+        aClient.mFd = -1;
+    }
+
+    aClient.mLength   = 0;
+    aClient.mStarting = false;
+
+    // Results of its requests are still to come, in order.
+    for (size_t i = 0; i < mNumRequests; ++i)
+    {
+        if (mRequests[i].mClient == &aClient)
+        {
+            mRequests[i].mClient = NULL;
+        }
+    }
+}
+
+void CommissionerServer::HandleCommissionerState(void *aContext, Ncp::CommissionerState aState)
+{
+    CommissionerServer *server = static_cast<CommissionerServer *>(aContext);
+
+    if (server->mState != aState)
+    {
+        otbrLog(OTBR_LOG_INFO, "commissioning: %s", kStateNames[aState]);
+        server->mState = aState;
+
+        if (aState == Ncp::kCommissionerStateDisabled)
+        {
+            server->mEventLoop->StopTimer(server->mJoinerTimer);
+        }
+    }
+
+    // Clients are answered even if the state is unchanged, as a petition may fail before the state is read back.
+    VerifyOrExit(aState != Ncp::kCommissionerStatePetition);
+
+    for (size_t i = 0; i < kMaxClients; ++i)
+    {
+        Client &client = server->mClients[i];
+
+        if (!client.mStarting)
+        {
+            continue;
+        }
+
+        client.mStarting = false;
+
+        if (aState == Ncp::kCommissionerStateActive)
+        {
+            server->Reply(client, "Done");
+        }
+        else
+        {
+            // The leader rejected the petition, or another commissioner is active.
+            errno = ECONNREFUSED;
+            server->Reply(client, NULL);
+        }
+    }
+
+exit:
+    return;
+}
+
+void CommissionerServer::HandleCommissionerResult(void *aContext, Ncp::CommissionerRequest aRequest, int aError)
+{
+    static_cast<CommissionerServer *>(aContext)->HandleCommissionerResult(aRequest, aError);
+}
+
+void CommissionerServer::HandleCommissionerResult(Ncp::CommissionerRequest aRequest, int aError)
+{
+    Request request;
+
+    // Not requested by this service.
+    VerifyOrExit(mNumRequests > 0);
+
+    request = mRequests[0];
+    --mNumRequests;
+    memmove(&mRequests[0], &mRequests[1], mNumRequests * sizeof(mRequests[0]));
+
+    if (aError == 0)
+    {
+        switch (aRequest)
+        {
+        case Ncp::kCommissionerRequestStart:
+            // Answered by HandleCommissionerState() once the petition is done.
+            VerifyOrExit(mState == Ncp::kCommissionerStateActive || request.mClient == NULL,
+                         request.mClient->mStarting = true);
+            break;
+
+        case Ncp::kCommissionerRequestStop:
+            mEventLoop->StopTimer(mJoinerTimer);
+            break;
+
+        case Ncp::kCommissionerRequestAddJoiner:
+        {
+            unsigned long fireTime = GetNow() + request.mJoinerTimeout * 1000;
+
+            // Keep the commissioner active until the last joiner allowed times out.
+            if (!mJoinerTimer.IsRunning() || static_cast<long>(mJoinerTimer.GetFireTime() - fireTime) < 0)
+            {
+                mEventLoop->StartTimer(mJoinerTimer, request.mJoinerTimeout * 1000);
+            }
+            break;
+        }
+        }
+    }
+
+    VerifyOrExit(request.mClient != NULL);
+
+    if (aError == 0)
+    {
+        Reply(*request.mClient, "Done");
+    }
+    else
+    {
+        errno = aError;
+        Reply(*request.mClient, NULL);
+    }
+
+exit:
+    return;
+}
+
+void CommissionerServer::HandlePSKc(void *aContext, const uint8_t *aPSKc)
+{
+    CommissionerServer *server = static_cast<CommissionerServer *>(aContext);
+
+    memcpy(server->mPSKc, aPSKc, sizeof(server->mPSKc));
+    server->mPSKcInitialized = true;
+}
+
+void CommissionerServer::HandleJoinerTimer(void *aContext)
+{
+    CommissionerServer *server = static_cast<CommissionerServer *>(aContext);
+    otbrError           error  = OTBR_ERROR_NONE;
+
+    otbrLog(OTBR_LOG_INFO, "commissioning: joiner window closed");
+
+    VerifyOrExit(server->mState != Ncp::kCommissionerStateDisabled);
+    SuccessOrExit(error = server->PushRequest(NULL, 0));
+    VerifyOrExit((error = server->mNcp->CommissionerStop()) == OTBR_ERROR_NONE, server->PopRequest());
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "commissioning: failed to stop: %s", strerror(errno));
+    }
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
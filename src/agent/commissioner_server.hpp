@@ -0,0 +1,176 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the local commissioning service.
+ */
+
+#ifndef COMMISSIONER_SERVER_HPP_
+#define COMMISSIONER_SERVER_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ncp.hpp"
+#include "common/event_loop.hpp"
+#include "common/types.hpp"
+
+/**
+ * The Unix socket of the commissioning service, next to the pidfiles so that other users cannot take its place.
+ *
+ */
+#ifndef OTBR_COMMISSIONER_SOCKET_NAME
+#define OTBR_COMMISSIONER_SOCKET_NAME "/var/run/otbr-commissioner.sock"
+#endif
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a local commissioning service, on top of the commissioner role of the NCP.
+ *
+ * The NCP talks MeshCoP to the leader and joiners itself, so local clients do not need a DTLS session to the
+ * border agent. Clients send lines of commands in the syntax of OpenThread CLI over a Unix stream socket, each
+ * answered with its output if any and then "Done" or "Error <errno>: <message>":
+ *
+ *   commissioner start <PSKc>                     Petition, the PSKc in hex must match the network.
+ *   commissioner stop                             Resign.
+ *   commissioner state                            Output disabled, petition or active.
+ *   commissioner joiner add <EUI-64|*> <PSKd> [timeout]   Allow a joiner, timeout in seconds.
+ *
+ * The socket is only accessible to the owner and group of the agent.
+ *
+ * Commands handled by the NCP are answered once it has handled them, with the error it reported if any, and
+ * "commissioner start" once the petition is done, with "Done" if accepted or an error if rejected, so clients need
+ * not poll the state. The commissioner role is given up once the last joiner allowed has timed out,
+ * rather than left active with nobody to commission.
+ *
+ */
+class CommissionerServer
+{
+public:
+    enum
+    {
+        kMaxClients           = 4,     ///< Max number of clients connected at once.
+        kMaxLineLength        = 128,   ///< Max length of a command line.
+        kDefaultJoinerTimeout = 120,   ///< Default time to allow a joiner, in seconds.
+        kMaxJoinerTimeout     = 86400, ///< Max time to allow a joiner, in seconds.
+    };
+
+    /**
+     * The constructor to initialize the commissioning service.
+     *
+     * @param[in]   aNcp            A pointer to the NCP controller.
+     * @param[in]   aSocketName     The path of the Unix socket to serve on.
+     *
+     */
+    CommissionerServer(Ncp::Controller *aNcp, const char *aSocketName = OTBR_COMMISSIONER_SOCKET_NAME);
+
+    ~CommissionerServer(void);
+
+    /**
+     * This method starts serving.
+     *
+     * The listening socket and client connections are registered to @p aEventLoop, which must outlive this object.
+     *
+     * @param[in]   aEventLoop  A reference to the event loop.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to start the service, error code is stored in errno.
+     *
+     */
+    otbrError Init(EventLoop &aEventLoop);
+
+private:
+    enum
+    {
+        kMaxRequests = kMaxClients * 2, ///< Max number of NCP requests in flight.
+    };
+
+    struct Client
+    {
+        int    mFd; ///< -1 if the entry is free
+        size_t mLength;
+        bool   mStarting; ///< Waiting for the result of the petition
+        char   mLine[kMaxLineLength];
+    };
+
+    struct Request
+    {
+        Client *      mClient;        ///< NULL if the client has closed, or for requests of the service itself
+        unsigned long mJoinerTimeout; ///< Seconds the joiner added is allowed for
+    };
+
+    static void HandleAccept(void *aContext, int aFd, unsigned int aEvents);
+    static void HandleClient(void *aContext, int aFd, unsigned int aEvents);
+    static void HandleCommissionerState(void *aContext, Ncp::CommissionerState aState);
+    static void HandleCommissionerResult(void *aContext, Ncp::CommissionerRequest aRequest, int aError);
+    static void HandlePSKc(void *aContext, const uint8_t *aPSKc);
+    static void HandleJoinerTimer(void *aContext);
+
+    void      Accept(void);
+    void      Receive(Client &aClient);
+    void      HandleCommand(Client &aClient, char *aLine);
+    otbrError HandleStart(Client &aClient, const char *aPSKc);
+    otbrError HandleJoinerAdd(Client &aClient, const char *aEui64, const char *aPSKd, const char *aTimeout);
+    void      HandleCommissionerResult(Ncp::CommissionerRequest aRequest, int aError);
+    otbrError PushRequest(Client *aClient, unsigned long aJoinerTimeout);
+    void      PopRequest(void);
+    void      Reply(Client &aClient, const char *aOutput);
+    void      Close(Client &aClient);
+
+    Ncp::Controller *      mNcp;
+    EventLoop *            mEventLoop;
+    const char *           mSocketName;
+    int                    mSocket;
+    Client                 mClients[kMaxClients];
+    Request                mRequests[kMaxRequests]; ///< In the order the NCP handles them
+    size_t                 mNumRequests;
+    Ncp::CommissionerState mState;
+    EventLoop::Timer       mJoinerTimer;
+    uint8_t                mPSKc[kSizePSKc];
+    bool                   mPSKcInitialized;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // COMMISSIONER_SERVER_HPP_
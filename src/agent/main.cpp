@@ -42,6 +42,7 @@
 #include "agent_instance.hpp"
 #include "ncp.hpp"
 #include "common/code_utils.hpp"
+#include "common/event_loop.hpp"
 #include "common/logging.hpp"
 #include "common/types.hpp"
 
@@ -50,9 +51,12 @@ static const char kDefaultInterfaceName[] = "wpan0";
 
 // Default poll timeout.
 static const struct timeval kPollTimeout = {10, 0};
-static const struct option  kOptions[]   = {{"debug-level", required_argument, NULL, 'd'},
+static const struct option  kOptions[]   = {{"async-log", no_argument, NULL, 'a'},
+                                         {"binary-log", no_argument, NULL, 'b'},
+                                         {"debug-level", required_argument, NULL, 'd'},
                                          {"help", no_argument, NULL, 'h'},
                                          {"thread-ifname", required_argument, NULL, 'I'},
+                                         {"log-file", required_argument, NULL, 'L'},
                                          {"verbose", no_argument, NULL, 'v'},
                                          {"version", no_argument, NULL, 'V'},
                                          {0, 0, 0, 0}};
@@ -66,7 +70,7 @@ static void HandleSignal(int aSignal)
     signal(aSignal, SIG_DFL);
 }
 
-static int Mainloop(AgentInstance &aInstance)
+static int Mainloop(EventLoop &aEventLoop)
 {
     int rval = EXIT_FAILURE;
 
@@ -77,26 +81,10 @@ static int Mainloop(AgentInstance &aInstance)
 
     while (true)
     {
-        otSysMainloopContext mainloop;
-
-        mainloop.mMaxFd   = -1;
-        mainloop.mTimeout = kPollTimeout;
-
-        FD_ZERO(&mainloop.mReadFdSet);
-        FD_ZERO(&mainloop.mWriteFdSet);
-        FD_ZERO(&mainloop.mErrorFdSet);
-
-        aInstance.UpdateFdSet(mainloop);
-
-        if (select(mainloop.mMaxFd + 1, &mainloop.mReadFdSet, &mainloop.mWriteFdSet, &mainloop.mErrorFdSet,
-                   &mainloop.mTimeout) >= 0)
-        {
-            aInstance.Process(mainloop);
-        }
-        else
+        if (aEventLoop.Poll(kPollTimeout) != OTBR_ERROR_NONE)
         {
             rval = OTBR_ERROR_ERRNO;
-            otbrLog(OTBR_LOG_ERR, "select() failed", strerror(errno));
+            otbrLog(OTBR_LOG_ERR, "Event loop failed: %s", strerror(errno));
             break;
         }
     }
@@ -107,10 +95,14 @@ static int Mainloop(AgentInstance &aInstance)
 static void PrintHelp(const char *aProgramName)
 {
 #if OTBR_ENABLE_NCP_WPANTUND
-    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v]\n", aProgramName);
+    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v] [-L LOG_FILE [-a] [-b]]\n", aProgramName);
 #else
-    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v] [RADIO_DEVICE] [RADIO_CONFIG]\n", aProgramName);
+    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v] [-L LOG_FILE [-a] [-b]] [RADIO_DEVICE] [RADIO_CONFIG]\n",
+            aProgramName);
 #endif
+    fprintf(stderr, "  -a, --async-log   Write logs from a background thread.\n");
+    fprintf(stderr, "  -b, --binary-log  Write LOG_FILE in the binary format, implies -a.\n");
+    fprintf(stderr, "  -L, --log-file    Also write logs of all levels to LOG_FILE.\n");
 }
 
 static void PrintVersion(void)
@@ -130,13 +122,26 @@ int main(int argc, char *argv[])
     int              opt;
     int              ret           = EXIT_SUCCESS;
     const char *     interfaceName = kDefaultInterfaceName;
+    const char *     logFile       = NULL;
     Ncp::Controller *ncp           = NULL;
+    EventLoop *      eventLoop     = NULL;
     bool             verbose       = false;
+    bool             asyncLog      = false;
+    bool             binaryLog     = false;
 
-    while ((opt = getopt_long(argc, argv, "d:hI:Vv", kOptions, NULL)) != -1)
+    while ((opt = getopt_long(argc, argv, "abd:hI:L:Vv", kOptions, NULL)) != -1)
     {
         switch (opt)
         {
+        case 'a':
+            asyncLog = true;
+            break;
+
+        case 'b':
+            asyncLog  = true;
+            binaryLog = true;
+            break;
+
         case 'd':
             logLevel = atoi(optarg);
             break;
@@ -145,6 +150,10 @@ int main(int argc, char *argv[])
             interfaceName = optarg;
             break;
 
+        case 'L':
+            logFile = optarg;
+            break;
+
         case 'v':
             verbose = true;
             break;
@@ -175,17 +184,36 @@ int main(int argc, char *argv[])
 
     otbrLogInit(kSyslogIdent, logLevel, verbose);
 
+    if (logFile != NULL)
+    {
+        otbrLogSetFilename(logFile);
+    }
+
+    if (asyncLog && otbrLogStartAsync(binaryLog) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to log asynchronously: %s", strerror(errno));
+    }
+
     otbrLog(OTBR_LOG_INFO, "Thread interface %s", interfaceName);
 
+    eventLoop = EventLoop::Create();
+    VerifyOrExit(eventLoop != NULL, ret = EXIT_FAILURE; otbrLog(OTBR_LOG_ERR, "Failed to create event loop"));
+
     {
+        // Components register to the event loop, so they are destroyed first.
         AgentInstance instance(ncp);
 
-        SuccessOrExit(ret = instance.Init());
-        SuccessOrExit(ret = Mainloop(instance));
+        SuccessOrExit(ret = instance.Init(*eventLoop));
+        SuccessOrExit(ret = Mainloop(*eventLoop));
     }
 
     otbrLogDeinit();
 
 exit:
+    if (eventLoop != NULL)
+    {
+        EventLoop::Destroy(eventLoop);
+    }
+
     return ret;
 }
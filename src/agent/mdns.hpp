@@ -34,8 +34,13 @@
 #ifndef MDNS_HPP_
 #define MDNS_HPP_
 
-#include <sys/select.h>
+#include <string>
+#include <vector>
 
+#include <stdint.h>
+#include <string.h>
+
+#include "common/event_loop.hpp"
 #include "common/types.hpp"
 
 namespace ot {
@@ -63,6 +68,75 @@ enum State
  */
 typedef void (*StateHandler)(void *aContext, State aState);
 
+/**
+ * This structure represents an entry of a text record.
+ *
+ */
+struct TxtEntry
+{
+    std::string          mName;  ///< The key of this entry.
+    std::vector<uint8_t> mValue; ///< The value of this entry, which may be binary.
+
+    /**
+     * The constructor to initialize an entry with a string value.
+     *
+     * @param[in]   aName       The key of this entry.
+     * @param[in]   aValue      The null-terminated value of this entry.
+     *
+     */
+    TxtEntry(const char *aName, const char *aValue)
+        : mName(aName)
+        , mValue(reinterpret_cast<const uint8_t *>(aValue), reinterpret_cast<const uint8_t *>(aValue) + strlen(aValue))
+    {
+    }
+
+    /**
+     * The constructor to initialize an entry with a binary value.
+     *
+     * @param[in]   aName       The key of this entry.
+     * @param[in]   aValue      A pointer to the value of this entry.
+     * @param[in]   aLength     The length of the value.
+     *
+     */
+    TxtEntry(const char *aName, const uint8_t *aValue, size_t aLength)
+        : mName(aName)
+        , mValue(aValue, aValue + aLength)
+    {
+    }
+};
+
+typedef std::vector<TxtEntry> TxtList;
+
+/**
+ * This structure describes a service to publish.
+ *
+ */
+struct ServiceInfo
+{
+    std::string mName;    ///< The name of this service.
+    std::string mType;    ///< The type of this service, e.g. "_meshcop._udp.".
+    uint16_t    mPort;    ///< The port number of this service.
+    TxtList     mTxtList; ///< The text record of this service.
+};
+
+typedef std::vector<ServiceInfo> ServiceList;
+
+/**
+ * This structure describes a service discovered by browsing.
+ *
+ */
+struct DiscoveredService
+{
+    std::string mName;     ///< The instance name of this service.
+    std::string mType;     ///< The type of this service, e.g. "_meshcop._udp".
+    std::string mDomain;   ///< The domain of this service, e.g. "local.".
+    std::string mHostName; ///< The host name this service resides on.
+    uint16_t    mPort;     ///< The port number of this service.
+    TxtList     mTxtList;  ///< The text record of this service.
+};
+
+class ServiceCache;
+
 /**
  * @addtogroup border-router-mdns
  *
@@ -119,37 +193,44 @@ public:
     virtual otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...) = 0;
 
     /**
-     * This method performs the MDNS processing.
+     * This method publishes or updates a list of services.
+     *
+     * New services of one call are registered together, e.g. in one Avahi entry group or over one shared
+     * mDNSResponder connection, and the time taken to register them is logged. A service already published with the
+     * same name and type is updated as by PublishService().
+     *
+     * @param[in]   aServices           The services to publish.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     * @retval  OTBR_ERROR_NONE     Successfully published or updated all the services.
+     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update some of the services.
+     * @retval  OTBR_ERROR_MDNS     Failed to publish or update some of the services for MDNS error.
      *
      */
-    virtual void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet) = 0;
+    virtual otbrError PublishServices(const ServiceList &aServices) = 0;
 
     /**
-     * This method updates the fd_set and timeout for mainloop.
+     * This method renames a published service, keeping its port and text record.
      *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling read.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
-     * @param[inout]    aTimeout        A reference to the timeout. Update this value if the MDNS service has
-     *                                  pending process in less than its current value.
+     * The service is renamed in place without restarting the MDNS service, and only this service is announced
+     * again. Changes made to the service before returning to the event loop, such as a following PublishService()
+     * with the new name to update the text record, are announced together.
+     *
+     * @param[in]   aType               The type of this service.
+     * @param[in]   aOldName            The current name of this service.
+     * @param[in]   aNewName            The new name of this service.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully renamed the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to rename the service, errno is ENOENT if no such service is published.
      *
      */
-    virtual void UpdateFdSet(fd_set & aReadFdSet,
-                             fd_set & aWriteFdSet,
-                             fd_set & aErrorFdSet,
-                             int &    aMaxFd,
-                             timeval &aTimeout) = 0;
+    virtual otbrError RenameService(const char *aType, const char *aOldName, const char *aNewName) = 0;
 
     virtual ~Publisher(void) {}
 
     /**
-     * This function creates a MDNS publisher.
+     * This function creates a MDNS publisher, which is served by the event loop.
      *
+     * @param[in]   aEventLoop          A reference to the event loop.
      * @param[in]   aProtocol           Protocol to use for publishing. AF_INET6, AF_INET or AF_UNSPEC.
      * @param[in]   aHost               The host where these services is residing on.
      * @param[in]   aDomain             The domain to register in.
@@ -159,7 +240,8 @@ public:
      * @returns A pointer to the newly created MDNS publisher.
      *
      */
-    static Publisher *Create(int          aProtocol,
+    static Publisher *Create(EventLoop &  aEventLoop,
+                             int          aProtocol,
                              const char * aHost,
                              const char * aDomain,
                              StateHandler aHandler,
@@ -174,6 +256,70 @@ public:
     static void Destroy(Publisher *aPublisher);
 };
 
+/**
+ * This interface defines the functionality of browsing MDNS services of one type.
+ *
+ * Discovered services are resolved and kept in a ServiceCache, so clients look up the cache and observe its events
+ * instead of sending queries. The cache entries expire with the records, and the MDNS service is not queried again
+ * for services already known.
+ *
+ */
+class Browser
+{
+public:
+    /**
+     * This method starts browsing.
+     *
+     * @retval OTBR_ERROR_NONE  Successfully started browsing.
+     * @retval OTBR_ERROR_MDNS  Failed to start browsing.
+     *
+     */
+    virtual otbrError Start(void) = 0;
+
+    /**
+     * This method stops browsing, and removes all the services from the cache.
+     *
+     */
+    virtual void Stop(void) = 0;
+
+    /**
+     * This method checks if browser has been started.
+     *
+     * @retval true     Already started.
+     * @retval false    Not started.
+     *
+     */
+    virtual bool IsStarted(void) const = 0;
+
+    virtual ~Browser(void) {}
+
+    /**
+     * This function creates a MDNS browser, which is served by the event loop and expires the cache with its timer.
+     *
+     * @param[in]   aEventLoop          A reference to the event loop.
+     * @param[in]   aProtocol           Protocol to browse on. AF_INET6, AF_INET or AF_UNSPEC.
+     * @param[in]   aType               The type of services to browse, e.g. "_meshcop._udp".
+     * @param[in]   aDomain             The domain to browse in. NULL to use default.
+     * @param[in]   aCache              A reference to the cache to keep discovered services.
+     *
+     * @returns A pointer to the newly created MDNS browser.
+     *
+     */
+    static Browser *Create(EventLoop &   aEventLoop,
+                           int           aProtocol,
+                           const char *  aType,
+                           const char *  aDomain,
+                           ServiceCache &aCache);
+
+    /**
+     * This function destroies the MDNS browser.
+     *
+     * @param[in]   aBrowser            A pointer to the browser.
+     *
+     */
+    static void Destroy(Browser *aBrowser);
+};
+
 /**
  * @}
  */
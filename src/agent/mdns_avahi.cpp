@@ -37,7 +37,9 @@
 #include <avahi-common/error.h>
 #include <avahi-common/malloc.h>
 #include <avahi-common/timeval.h>
+#include <assert.h>
 #include <errno.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -48,22 +50,19 @@
 #include "common/time.hpp"
 #include "utils/strcpy_utils.hpp"
 
-AvahiTimeout::AvahiTimeout(const struct timeval *aTimeout,
-                           AvahiTimeoutCallback  aCallback,
-                           void *                aContext,
-                           void *                aPoller)
-    : mCallback(aCallback)
+AvahiTimeout::AvahiTimeout(AvahiTimeoutCallback aCallback, void *aContext, void *aPoller)
+    : mTimer(HandleTimer, this)
+    , mCallback(aCallback)
     , mContext(aContext)
     , mPoller(aPoller)
 {
-    if (aTimeout)
-    {
-        mTimeout = ot::BorderRouter::GetNow() + ot::BorderRouter::GetTimestamp(*aTimeout);
-    }
-    else
-    {
-        mTimeout = 0;
-    }
+}
+
+void AvahiTimeout::HandleTimer(void *aContext)
+{
+    AvahiTimeout *timer = static_cast<AvahiTimeout *>(aContext);
+
+    timer->mCallback(timer, timer->mContext);
 }
 
 namespace ot {
@@ -72,7 +71,8 @@ namespace BorderRouter {
 
 namespace Mdns {
 
-Poller::Poller(void)
+Poller::Poller(EventLoop &aEventLoop)
+    : mEventLoop(aEventLoop)
 {
     mAvahiPoller.userdata         = this;
     mAvahiPoller.watch_new        = WatchNew;
@@ -96,16 +96,43 @@ AvahiWatch *Poller::WatchNew(const struct AvahiPoll *aPoller,
 
 AvahiWatch *Poller::WatchNew(int aFd, AvahiWatchEvent aEvent, AvahiWatchCallback aCallback, void *aContext)
 {
+    AvahiWatch *watch;
+    otbrError   error;
+
     assert(aEvent && aCallback && aFd >= 0);
 
-    mWatches.push_back(new AvahiWatch(aFd, aEvent, aCallback, aContext, this));
+    if (static_cast<size_t>(aFd) >= mWatches.size())
+    {
+        mWatches.resize(static_cast<size_t>(aFd) + 1, NULL);
+    }
+
+    watch         = new AvahiWatch(aFd, aEvent, aCallback, aContext, this);
+    watch->mNext  = mWatches[aFd];
+    mWatches[aFd] = watch;
+
+    // Watches of one file descriptor share its registration.
+    error = (watch->mNext == NULL ? mEventLoop.AddIo(aFd, GetIoEvents(watch), HandleIo, this)
+                                  : mEventLoop.ModifyIo(aFd, GetIoEvents(watch)));
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to watch avahi descriptor %d: %s", aFd, strerror(errno));
+    }
 
-    return mWatches.back();
+    return watch;
 }
 
 void Poller::WatchUpdate(AvahiWatch *aWatch, AvahiWatchEvent aEvent)
 {
+    Poller &poller = *reinterpret_cast<Poller *>(aWatch->mPoller);
+
     aWatch->mEvents = aEvent;
+
+    // The registration is only modified if the events of the file descriptor change.
+    if (poller.mEventLoop.ModifyIo(aWatch->mFd, GetIoEvents(poller.mWatches[aWatch->mFd])) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to watch avahi descriptor %d: %s", aWatch->mFd, strerror(errno));
+    }
 }
 
 AvahiWatchEvent Poller::WatchGetEvents(AvahiWatch *aWatch)
@@ -120,15 +147,46 @@ void Poller::WatchFree(AvahiWatch *aWatch)
 
 void Poller::WatchFree(AvahiWatch &aWatch)
 {
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
+    int fd = aWatch.mFd;
+
+    for (AvahiWatch **watch = &mWatches[fd]; *watch != NULL; watch = &(*watch)->mNext)
     {
-        if (*it == &aWatch)
+        if (*watch == &aWatch)
         {
-            mWatches.erase(it);
+            *watch = aWatch.mNext;
             delete &aWatch;
             break;
         }
     }
+
+    if (mWatches[fd] == NULL)
+    {
+        mEventLoop.RemoveIo(fd);
+    }
+    else
+    {
+        mEventLoop.ModifyIo(fd, GetIoEvents(mWatches[fd]));
+    }
+
+    // Keep the table no longer than the largest watched file descriptor.
+    while (!mWatches.empty() && mWatches.back() == NULL)
+    {
+        mWatches.pop_back();
+    }
+}
+
+unsigned int Poller::GetIoEvents(const AvahiWatch *aWatches)
+{
+    unsigned int events = 0;
+
+    for (const AvahiWatch *watch = aWatches; watch != NULL; watch = watch->mNext)
+    {
+        // A hang up is reported as readable by the event loop, errors are always reported.
+        events |= ((AVAHI_WATCH_IN | AVAHI_WATCH_HUP) & watch->mEvents ? EventLoop::kEventReadable : 0);
+        events |= (AVAHI_WATCH_OUT & watch->mEvents ? EventLoop::kEventWritable : 0);
+    }
+
+    return events;
 }
 
 AvahiTimeout *Poller::TimeoutNew(const AvahiPoll *     aPoller,
@@ -142,19 +200,30 @@ AvahiTimeout *Poller::TimeoutNew(const AvahiPoll *     aPoller,
 
 AvahiTimeout *Poller::TimeoutNew(const struct timeval *aTimeout, AvahiTimeoutCallback aCallback, void *aContext)
 {
-    mTimers.push_back(new AvahiTimeout(aTimeout, aCallback, aContext, this));
-    return mTimers.back();
+    AvahiTimeout *timer = new AvahiTimeout(aCallback, aContext, this);
+
+    TimeoutUpdate(*timer, aTimeout);
+
+    return timer;
 }
 
 void Poller::TimeoutUpdate(AvahiTimeout *aTimer, const struct timeval *aTimeout)
+{
+    static_cast<Poller *>(aTimer->mPoller)->TimeoutUpdate(*aTimer, aTimeout);
+}
+
+void Poller::TimeoutUpdate(AvahiTimeout &aTimer, const struct timeval *aTimeout)
 {
     if (aTimeout == NULL)
     {
-        aTimer->mTimeout = 0;
+        mEventLoop.StopTimer(aTimer.mTimer);
     }
     else
     {
-        aTimer->mTimeout = ot::BorderRouter::GetNow() + ot::BorderRouter::GetTimestamp(*aTimeout);
+        // Avahi passes an absolute wall clock time, avahi_age() is negative until then.
+        AvahiUsec age = avahi_age(aTimeout);
+
+        mEventLoop.StartTimer(aTimer.mTimer, age < 0 ? static_cast<unsigned long>(-age / 1000) : 0);
     }
 }
 
@@ -165,155 +234,79 @@ void Poller::TimeoutFree(AvahiTimeout *aTimer)
 
 void Poller::TimeoutFree(AvahiTimeout &aTimer)
 {
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
-    {
-        if (*it == &aTimer)
-        {
-            mTimers.erase(it);
-            delete &aTimer;
-            break;
-        }
-    }
+    mEventLoop.StopTimer(aTimer.mTimer);
+    delete &aTimer;
 }
 
-void Poller::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout)
+void Poller::DispatchWatches(int aFd)
 {
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
-    {
-        int             fd     = (*it)->mFd;
-        AvahiWatchEvent events = (*it)->mEvents;
-
-        if (AVAHI_WATCH_IN & events)
-        {
-            FD_SET(fd, &aReadFdSet);
-        }
-
-        if (AVAHI_WATCH_OUT & events)
-        {
-            FD_SET(fd, &aWriteFdSet);
-        }
-
-        if (AVAHI_WATCH_ERR & events)
-        {
-            FD_SET(fd, &aErrorFdSet);
-        }
+    bool dispatched = true;
 
-        if (AVAHI_WATCH_HUP & events)
-        {
-            // TODO what do with this event type?
-        }
-
-        if (aMaxFd < fd)
-        {
-            aMaxFd = fd;
-        }
-
-        (*it)->mHappened = 0;
-    }
-
-    unsigned long now = GetNow();
-
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
+    // Callbacks may free or add watches of this file descriptor, so the list is walked again after each one.
+    while (dispatched)
     {
-        unsigned long timeout = (*it)->mTimeout;
+        AvahiWatch *watch = static_cast<size_t>(aFd) < mWatches.size() ? mWatches[aFd] : NULL;
 
-        if (timeout == 0)
+        while (watch != NULL && watch->mPending == 0)
         {
-            continue;
+            watch = watch->mNext;
         }
 
-        if (static_cast<long>(timeout - now) <= 0)
-        {
-            aTimeout.tv_usec = 0;
-            aTimeout.tv_sec  = 0;
-            break;
-        }
-        else
-        {
-            time_t      sec;
-            suseconds_t usec;
+        dispatched = (watch != NULL);
 
-            timeout -= now;
-            sec  = static_cast<time_t>(timeout / 1000);
-            usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
+        if (dispatched)
+        {
+            AvahiWatchEvent events = static_cast<AvahiWatchEvent>(watch->mPending);
 
-            if (sec < aTimeout.tv_sec)
-            {
-                aTimeout.tv_sec = sec;
-            }
-            else if (sec == aTimeout.tv_sec)
-            {
-                if (usec < aTimeout.tv_usec)
-                {
-                    aTimeout.tv_usec = usec;
-                }
-            }
+            watch->mPending = 0;
+            watch->mCallback(watch, watch->mFd, events, watch->mContext);
         }
     }
 }
 
-void Poller::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void Poller::HandleIo(void *aContext, int aFd, unsigned int aEvents)
 {
-    unsigned long now = GetNow();
-
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
-    {
-        int             fd     = (*it)->mFd;
-        AvahiWatchEvent events = (*it)->mEvents;
-
-        (*it)->mHappened = 0;
-
-        if ((AVAHI_WATCH_IN & events) && FD_ISSET(fd, &aReadFdSet))
-        {
-            (*it)->mHappened |= AVAHI_WATCH_IN;
-        }
-
-        if ((AVAHI_WATCH_OUT & events) && FD_ISSET(fd, &aWriteFdSet))
-        {
-            (*it)->mHappened |= AVAHI_WATCH_OUT;
-        }
+    static_cast<Poller *>(aContext)->HandleIo(aFd, aEvents);
+}
 
-        if ((AVAHI_WATCH_ERR & events) && FD_ISSET(fd, &aErrorFdSet))
-        {
-            (*it)->mHappened |= AVAHI_WATCH_ERR;
-        }
+void Poller::HandleIo(int aFd, unsigned int aEvents)
+{
+    short         requested = 0;
+    struct pollfd pfd;
 
-        // TODO hup events
-        if ((*it)->mHappened)
-        {
-            (*it)->mCallback(*it, (*it)->mFd, static_cast<AvahiWatchEvent>((*it)->mHappened), (*it)->mContext);
-        }
-    }
+    requested |= (aEvents & EventLoop::kEventReadable ? POLLIN : 0);
+    requested |= (aEvents & EventLoop::kEventWritable ? POLLOUT : 0);
 
-    std::vector<AvahiTimeout *> expired;
+    // The event loop does not tell a hang up from readiness, poll() the ready descriptor for them.
+    pfd.fd      = aFd;
+    pfd.events  = requested;
+    pfd.revents = 0;
 
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
+    if (poll(&pfd, 1, 0) <= 0)
     {
-        if ((*it)->mTimeout == 0)
-        {
-            continue;
-        }
-
-        if (static_cast<long>((*it)->mTimeout - now) <= 0)
-        {
-            expired.push_back(*it);
-        }
+        pfd.revents = requested | (aEvents & EventLoop::kEventError ? POLLERR : 0);
     }
 
-    for (std::vector<AvahiTimeout *>::iterator it = expired.begin(); it != expired.end(); ++it)
+    for (AvahiWatch *watch = mWatches[aFd]; watch != NULL; watch = watch->mNext)
     {
-        AvahiTimeout *avahiTimeout = *it;
-        avahiTimeout->mCallback(avahiTimeout, avahiTimeout->mContext);
+        // Like poll(), errors and hang ups are reported whether interested or not.
+        watch->mHappened = pfd.revents & (watch->mEvents | AVAHI_WATCH_ERR | AVAHI_WATCH_HUP);
+        watch->mPending  = watch->mHappened;
     }
+
+    DispatchWatches(aFd);
 }
 
-PublisherAvahi::PublisherAvahi(int          aProtocol,
+PublisherAvahi::PublisherAvahi(EventLoop &  aEventLoop,
+                               int          aProtocol,
                                const char * aHost,
                                const char * aDomain,
                                StateHandler aHandler,
                                void *       aContext)
-    : mClient(NULL)
-    , mGroup(NULL)
+    : mEventLoop(aEventLoop)
+    , mClient(NULL)
+    , mPoller(aEventLoop)
+    , mCommitTimer(HandleCommitTimer, this)
     , mProtocol(aProtocol == AF_INET6 ? AVAHI_PROTO_INET6
                                       : aProtocol == AF_INET ? AVAHI_PROTO_INET : AVAHI_PROTO_UNSPEC)
     , mHost(aHost)
@@ -326,6 +319,13 @@ PublisherAvahi::PublisherAvahi(int          aProtocol,
 
 PublisherAvahi::~PublisherAvahi(void)
 {
+    mEventLoop.StopTimer(mCommitTimer);
+
+    // Watches and timeouts of the client are registered to the event loop.
+    if (mClient)
+    {
+        avahi_client_free(mClient);
+    }
 }
 
 otbrError PublisherAvahi::Start(void)
@@ -351,23 +351,15 @@ bool PublisherAvahi::IsStarted(void) const
 
 void PublisherAvahi::Stop(void)
 {
+    // Entry groups are freed along with the client.
     mServices.clear();
-
-    if (mGroup)
-    {
-        int error = avahi_entry_group_reset(mGroup);
-
-        if (error)
-        {
-            otbrLog(OTBR_LOG_ERR, "Failed to reset entry group: %s!", avahi_strerror(error));
-        }
-    }
+    mServiceIndex.clear();
+    mEventLoop.StopTimer(mCommitTimer);
 
     if (mClient)
     {
         avahi_client_free(mClient);
         mClient = NULL;
-        mGroup  = NULL;
         mState  = kStateIdle;
         mStateHandler(mContext, mState);
     }
@@ -385,32 +377,46 @@ void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupSt
 
 void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState)
 {
-    assert(mGroup == aGroup || mGroup == NULL);
+    size_t        count      = 0;
+    unsigned long commitTime = 0;
+
+    for (Services::const_iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        if (it->mGroup == aGroup)
+        {
+            commitTime = it->mCommitTime;
+            ++count;
+        }
+    }
 
-    otbrLog(OTBR_LOG_INFO, "Avahi group change to state %d.", aState);
-    mGroup = aGroup;
+    otbrLog(OTBR_LOG_INFO, "Avahi group of %zu services change to state %d.", count, aState);
 
     /* Called whenever the entry group state changes */
     switch (aState)
     {
     case AVAHI_ENTRY_GROUP_ESTABLISHED:
         /* The entry group has been established successfully */
-        otbrLog(OTBR_LOG_INFO, "Group established.");
+        if (count > 0)
+        {
+            unsigned long elapsed = GetNow() - commitTime;
+
+            otbrLog(OTBR_LOG_INFO, "%zu services established in %lu ms, %lu services per second.", count, elapsed,
+                    count * 1000 / (elapsed > 0 ? elapsed : 1));
+        }
         break;
 
     case AVAHI_ENTRY_GROUP_COLLISION:
-        otbrLog(OTBR_LOG_ERR, "Name collision!");
+        otbrLog(OTBR_LOG_ERR, "Name collision in group of %zu services!", count);
         break;
 
     case AVAHI_ENTRY_GROUP_FAILURE:
-        otbrLog(OTBR_LOG_ERR, "Group failed: %s!",
+        otbrLog(OTBR_LOG_ERR, "Group of %zu services failed: %s!", count,
                 avahi_strerror(avahi_client_errno(avahi_entry_group_get_client(aGroup))));
         /* Some kind of failure happened while we were registering our services */
         break;
 
     case AVAHI_ENTRY_GROUP_UNCOMMITED:
     case AVAHI_ENTRY_GROUP_REGISTERING:
-        otbrLog(OTBR_LOG_ERR, "Group ready.");
         break;
 
     default:
@@ -419,22 +425,13 @@ void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupSt
     }
 }
 
-void PublisherAvahi::CreateGroup(AvahiClient *aClient)
-{
-    VerifyOrExit(mGroup == NULL);
-
-    VerifyOrExit((mGroup = avahi_entry_group_new(aClient, HandleGroupState, this)) != NULL);
-
-exit:
-    if (mGroup == NULL)
-    {
-        otbrLog(OTBR_LOG_ERR, "avahi_entry_group_new() failed: %s", avahi_strerror(avahi_client_errno(aClient)));
-    }
-}
-
 void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aState)
 {
     otbrLog(OTBR_LOG_INFO, "Avahi client state changed to %d.", aState);
+
+    // This may be called from avahi_client_new() before it returns.
+    mClient = aClient;
+
     switch (aState)
     {
     case AVAHI_CLIENT_S_RUNNING:
@@ -442,9 +439,8 @@ void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aS
          * name on the network, so it's time to create our services */
         otbrLog(OTBR_LOG_INFO, "Avahi client ready.");
         mState = kStateReady;
-        CreateGroup(aClient);
         mStateHandler(mContext, mState);
-        avahi_entry_group_commit(mGroup);
+        CommitServices();
         break;
 
     case AVAHI_CLIENT_FAILURE:
@@ -466,9 +462,14 @@ void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aS
          * might be caused by a host name change. We need to wait
          * for our own records to register until the host name is
          * properly esatblished. */
-        if (mGroup)
+        for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
         {
-            avahi_entry_group_reset(mGroup);
+            if (it->mGroup)
+            {
+                avahi_entry_group_reset(it->mGroup);
+            }
+
+            it->mPending = true;
         }
         break;
 
@@ -482,86 +483,237 @@ void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aS
     }
 }
 
-void PublisherAvahi::UpdateFdSet(fd_set & aReadFdSet,
-                                 fd_set & aWriteFdSet,
-                                 fd_set & aErrorFdSet,
-                                 int &    aMaxFd,
-                                 timeval &aTimeout)
+PublisherAvahi::Service *PublisherAvahi::FindService(const char *aName, const char *aType)
 {
-    mPoller.UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+    ServiceIndex::const_iterator it = mServiceIndex.find(ServiceKey(aName, aType));
+
+    return it == mServiceIndex.end() ? NULL : &mServices[it->second];
 }
 
-void PublisherAvahi::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+AvahiStringList *PublisherAvahi::MakeTxtList(const Service &aService)
 {
-    mPoller.Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    AvahiStringList *list = NULL;
+
+    for (std::vector<std::string>::const_iterator it = aService.mTxt.begin(); it != aService.mTxt.end(); ++it)
+    {
+        list = avahi_string_list_add_arbitrary(list, reinterpret_cast<const uint8_t *>(it->data()), it->size());
+    }
+
+    return list;
 }
 
-otbrError PublisherAvahi::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+void PublisherAvahi::ScheduleCommit(void)
 {
-    otbrError ret   = OTBR_ERROR_ERRNO;
-    int       error = 0;
-    // aligned with AvahiStringList
-    AvahiStringList  buffer[kMaxSizeOfTxtRecord / sizeof(AvahiStringList)];
-    AvahiStringList *last = NULL;
-    AvahiStringList *curr = buffer;
-    va_list          args;
-    size_t           used = 0;
+    // Changes made in one pass of the event loop are committed together.
+    if (!mCommitTimer.IsRunning())
+    {
+        mEventLoop.StartTimer(mCommitTimer, 0);
+    }
+}
 
-    va_start(args, aType);
+void PublisherAvahi::HandleCommitTimer(void *aContext)
+{
+    static_cast<PublisherAvahi *>(aContext)->CommitServices();
+}
 
-    VerifyOrExit(mState == kStateReady, errno = EAGAIN);
+void PublisherAvahi::CommitServices(void)
+{
+    AvahiEntryGroup *group = NULL;
 
-    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
+    VerifyOrExit(mState == kStateReady);
+
+    // New services published since the last commit share one new entry group.
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
-        int         rval;
-        const char *value  = va_arg(args, const char *);
-        size_t      needed = sizeof(AvahiStringList) + strlen(name) + strlen(value);
+        if (it->mPending && it->mGroup == NULL)
+        {
+            if (group == NULL)
+            {
+                group = avahi_entry_group_new(mClient, HandleGroupState, this);
+                VerifyOrExit(group != NULL, otbrLog(OTBR_LOG_ERR, "Failed to create entry group: %s!",
+                                                    avahi_strerror(avahi_client_errno(mClient))));
+            }
+
+            it->mGroup = group;
+        }
+    }
 
-        VerifyOrExit(used + needed < sizeof(buffer), errno = EMSGSIZE);
-        curr->next = last;
-        last       = curr;
-        rval       = sprintf(reinterpret_cast<char *>(curr->text), "%s=%s", name, value);
-        assert(rval > 0);
-        curr->size = static_cast<size_t>(rval);
+    // A group is repopulated as a whole when any of its services changed.
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        if (it->mPending)
         {
-            const uint8_t *next = curr->text + curr->size;
-            curr                = OTBR_ALIGNED(next, AvahiStringList *);
+            int error = CommitGroup(it->mGroup);
+
+            if (error)
+            {
+                otbrLog(OTBR_LOG_ERR, "Failed to commit service %s: %s!", it->mName, avahi_strerror(error));
+            }
         }
-        used = static_cast<size_t>(reinterpret_cast<uint8_t *>(curr) - reinterpret_cast<uint8_t *>(buffer));
     }
 
+exit:
+    return;
+}
+
+int PublisherAvahi::CommitGroup(AvahiEntryGroup *aGroup)
+{
+    int           error = 0;
+    size_t        count = 0;
+    unsigned long now   = GetNow();
+
+    // Not retried until changed again if the group fails.
     for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
-        if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)) &&
-            it->mPort == aPort)
+        if (it->mGroup == aGroup)
         {
-            otbrLog(OTBR_LOG_INFO, "MDNS update service %s", aName);
-            error = avahi_entry_group_update_service_txt_strlst(
-                mGroup, AVAHI_IF_UNSPEC, mProtocol, static_cast<AvahiPublishFlags>(0), aName, aType, mDomain, last);
-            SuccessOrExit(error);
-            ret = OTBR_ERROR_NONE;
-            ExitNow();
+            it->mPending    = false;
+            it->mCommitTime = now;
         }
     }
 
-    otbrLog(OTBR_LOG_INFO, "MDNS create service %s", aName);
-    error = avahi_entry_group_add_service_strlst(mGroup, AVAHI_IF_UNSPEC, mProtocol, static_cast<AvahiPublishFlags>(0),
-                                                 aName, aType, mDomain, mHost, aPort, last);
-    SuccessOrExit(error);
+    SuccessOrExit(error = avahi_entry_group_reset(aGroup));
 
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
-        Service service;
-        strcpy_safe(service.mName, sizeof(service.mName), aName);
-        strcpy_safe(service.mType, sizeof(service.mType), aType);
-        service.mPort = aPort;
-        mServices.push_back(service);
+        AvahiStringList *txt;
+        int              rval;
+
+        if (it->mGroup != aGroup)
+        {
+            continue;
+        }
+
+        txt  = MakeTxtList(*it);
+        rval = avahi_entry_group_add_service_strlst(aGroup, AVAHI_IF_UNSPEC, mProtocol,
+                                                    static_cast<AvahiPublishFlags>(0), it->mName, it->mType, mDomain,
+                                                    mHost, it->mPort, txt);
+        avahi_string_list_free(txt);
+
+        if (rval)
+        {
+            // Other services of the group are still published.
+            otbrLog(OTBR_LOG_ERR, "Failed to add service %s: %s!", it->mName, avahi_strerror(rval));
+            continue;
+        }
+
+        ++count;
     }
 
-    ret = OTBR_ERROR_NONE;
+    otbrLog(OTBR_LOG_INFO, "MDNS commit %zu services", count);
+    SuccessOrExit(error = avahi_entry_group_commit(aGroup));
 
 exit:
+    return error;
+}
+
+otbrError PublisherAvahi::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+{
+    ServiceList services(1);
+    va_list     args;
+
+    va_start(args, aType);
+
+    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
+    {
+        services[0].mTxtList.push_back(TxtEntry(name, va_arg(args, const char *)));
+    }
+
     va_end(args);
 
+    services[0].mName = aName;
+    services[0].mType = aType;
+    services[0].mPort = aPort;
+
+    return PublishServices(services);
+}
+
+otbrError PublisherAvahi::PublishServices(const ServiceList &aServices)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mState == kStateReady, errno = EAGAIN, ret = OTBR_ERROR_ERRNO);
+
+    for (ServiceList::const_iterator it = aServices.begin(); it != aServices.end(); ++it)
+    {
+        otbrError error = PublishService(*it);
+
+        if (error != OTBR_ERROR_NONE)
+        {
+            ret = error;
+        }
+    }
+
+exit:
+    if (ret == OTBR_ERROR_ERRNO)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to publish service: %s!", strerror(errno));
+    }
+
+    return ret;
+}
+
+otbrError PublisherAvahi::PublishService(const ServiceInfo &aInfo)
+{
+    otbrError                ret   = OTBR_ERROR_ERRNO;
+    int                      error = 0;
+    std::vector<std::string> txt;
+    Service *                service;
+    size_t                   used = 0;
+
+    VerifyOrExit(aInfo.mName.size() < kMaxSizeOfServiceName && aInfo.mType.size() < kMaxSizeOfServiceType,
+                 errno = ENAMETOOLONG);
+
+    for (TxtList::const_iterator it = aInfo.mTxtList.begin(); it != aInfo.mTxtList.end(); ++it)
+    {
+        txt.push_back(it->mName + "=");
+        txt.back().append(it->mValue.begin(), it->mValue.end());
+        used += sizeof(AvahiStringList) + txt.back().size();
+        VerifyOrExit(used < kMaxSizeOfTxtRecord, errno = EMSGSIZE);
+    }
+
+    service = FindService(aInfo.mName.c_str(), aInfo.mType.c_str());
+
+    if (service == NULL)
+    {
+        Service newService;
+
+        otbrLog(OTBR_LOG_INFO, "MDNS create service %s", aInfo.mName.c_str());
+        strcpy_safe(newService.mName, sizeof(newService.mName), aInfo.mName.c_str());
+        strcpy_safe(newService.mType, sizeof(newService.mType), aInfo.mType.c_str());
+        newService.mPort       = aInfo.mPort;
+        newService.mGroup      = NULL;
+        newService.mPending    = true;
+        newService.mCommitTime = 0;
+        mServiceIndex[ServiceKey(newService.mName, newService.mType)] = mServices.size();
+        mServices.push_back(newService);
+        service = &mServices.back();
+        ScheduleCommit();
+    }
+    else if (service->mPort != aInfo.mPort)
+    {
+        service->mPort    = aInfo.mPort;
+        service->mPending = true;
+        ScheduleCommit();
+    }
+
+    service->mTxt.swap(txt);
+
+    if (!service->mPending)
+    {
+        AvahiStringList *list = MakeTxtList(*service);
+
+        otbrLog(OTBR_LOG_INFO, "MDNS update service %s", service->mName);
+        error = avahi_entry_group_update_service_txt_strlst(service->mGroup, AVAHI_IF_UNSPEC, mProtocol,
+                                                            static_cast<AvahiPublishFlags>(0), service->mName,
+                                                            service->mType, mDomain, list);
+        avahi_string_list_free(list);
+        SuccessOrExit(error);
+    }
+
+    ret = OTBR_ERROR_NONE;
+
+exit:
     if (error)
     {
         ret = OTBR_ERROR_MDNS;
@@ -570,15 +722,48 @@ exit:
 
     if (ret == OTBR_ERROR_ERRNO)
     {
-        otbrLog(OTBR_LOG_ERR, "Failed to publish service: %s!", strerror(errno));
+        otbrLog(OTBR_LOG_ERR, "Failed to publish service %s: %s!", aInfo.mName.c_str(), strerror(errno));
     }
 
     return ret;
 }
 
-Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
+otbrError PublisherAvahi::RenameService(const char *aType, const char *aOldName, const char *aNewName)
 {
-    return new PublisherAvahi(aFamily, aHost, aDomain, aHandler, aContext);
+    otbrError ret     = OTBR_ERROR_ERRNO;
+    Service * service = FindService(aOldName, aType);
+
+    VerifyOrExit(service != NULL, errno = ENOENT);
+    VerifyOrExit(FindService(aNewName, aType) == NULL, errno = EEXIST);
+    VerifyOrExit(strlen(aNewName) < sizeof(service->mName), errno = ENAMETOOLONG);
+
+    otbrLog(OTBR_LOG_INFO, "MDNS rename service %s to %s", aOldName, aNewName);
+    mServiceIndex[ServiceKey(aNewName, aType)] = mServiceIndex[ServiceKey(aOldName, aType)];
+    mServiceIndex.erase(ServiceKey(aOldName, aType));
+    strcpy_safe(service->mName, sizeof(service->mName), aNewName);
+
+    // The entry group is reset when committed, so the old name stays announced until then.
+    service->mPending = true;
+    ScheduleCommit();
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to rename service %s: %s!", aOldName, strerror(errno));
+    }
+
+    return ret;
+}
+
+Publisher *Publisher::Create(EventLoop &  aEventLoop,
+                             int          aFamily,
+                             const char * aHost,
+                             const char * aDomain,
+                             StateHandler aHandler,
+                             void *       aContext)
+{
+    return new PublisherAvahi(aEventLoop, aFamily, aHost, aDomain, aHandler, aContext);
 }
 
 void Publisher::Destroy(Publisher *aPublisher)
@@ -586,6 +771,266 @@ void Publisher::Destroy(Publisher *aPublisher)
     delete static_cast<PublisherAvahi *>(aPublisher);
 }
 
+BrowserAvahi::BrowserAvahi(EventLoop &   aEventLoop,
+                           int           aProtocol,
+                           const char *  aType,
+                           const char *  aDomain,
+                           ServiceCache &aCache)
+    : mCache(aCache)
+    , mClient(NULL)
+    , mBrowser(NULL)
+    , mPoller(aEventLoop)
+    , mProtocol(aProtocol == AF_INET6 ? AVAHI_PROTO_INET6
+                                      : aProtocol == AF_INET ? AVAHI_PROTO_INET : AVAHI_PROTO_UNSPEC)
+    , mType(aType)
+    , mDomain(aDomain)
+{
+}
+
+BrowserAvahi::~BrowserAvahi(void)
+{
+    Stop();
+}
+
+otbrError BrowserAvahi::Start(void)
+{
+    otbrError ret   = OTBR_ERROR_NONE;
+    int       error = 0;
+
+    mClient = avahi_client_new(mPoller.GetAvahiPoll(), AVAHI_CLIENT_NO_FAIL, HandleClientState, this, &error);
+
+    if (error)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to create avahi client: %s!", avahi_strerror(error));
+        ret = OTBR_ERROR_MDNS;
+    }
+
+    return ret;
+}
+
+bool BrowserAvahi::IsStarted(void) const
+{
+    return mClient != NULL;
+}
+
+void BrowserAvahi::Stop(void)
+{
+    FreeBrowser();
+
+    if (mClient)
+    {
+        avahi_client_free(mClient);
+        mClient = NULL;
+    }
+}
+
+void BrowserAvahi::FreeBrowser(void)
+{
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        avahi_service_resolver_free(it->second);
+    }
+
+    mResolvers.clear();
+
+    if (mBrowser)
+    {
+        avahi_service_browser_free(mBrowser);
+        mBrowser = NULL;
+    }
+
+    mCache.Clear();
+}
+
+uint32_t BrowserAvahi::GetInterface(AvahiIfIndex aInterface, AvahiProtocol aProtocol)
+{
+    // Records over IPv4 and IPv6 are reported and removed separately, even on the same interface.
+    return (static_cast<uint32_t>(aInterface) << 1) | (aProtocol == AVAHI_PROTO_INET6 ? 1 : 0);
+}
+
+void BrowserAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aState, void *aContext)
+{
+    static_cast<BrowserAvahi *>(aContext)->HandleClientState(aClient, aState);
+}
+
+void BrowserAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aState)
+{
+    // This may be called from avahi_client_new() before it returns.
+    mClient = aClient;
+
+    switch (aState)
+    {
+    case AVAHI_CLIENT_S_RUNNING:
+    case AVAHI_CLIENT_S_REGISTERING:
+    case AVAHI_CLIENT_S_COLLISION:
+        VerifyOrExit(mBrowser == NULL);
+
+        mBrowser = avahi_service_browser_new(mClient, AVAHI_IF_UNSPEC, mProtocol, mType, mDomain,
+                                             static_cast<AvahiLookupFlags>(0), HandleBrowse, this);
+
+        if (mBrowser == NULL)
+        {
+            otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", mType, avahi_strerror(avahi_client_errno(mClient)));
+        }
+        break;
+
+    case AVAHI_CLIENT_FAILURE:
+        otbrLog(OTBR_LOG_ERR, "Client failure: %s", avahi_strerror(avahi_client_errno(aClient)));
+
+        // fall through
+
+    case AVAHI_CLIENT_CONNECTING:
+        // Services known so far can no longer be tracked, they are browsed again once reconnected.
+        FreeBrowser();
+        break;
+
+    default:
+        assert(false);
+        break;
+    }
+
+exit:
+    return;
+}
+
+void BrowserAvahi::HandleBrowse(AvahiServiceBrowser *  aBrowser,
+                                AvahiIfIndex           aInterface,
+                                AvahiProtocol          aProtocol,
+                                AvahiBrowserEvent      aEvent,
+                                const char *           aName,
+                                const char *           aType,
+                                const char *           aDomain,
+                                AvahiLookupResultFlags aFlags,
+                                void *                 aContext)
+{
+    (void)aBrowser;
+    (void)aFlags;
+
+    static_cast<BrowserAvahi *>(aContext)->HandleBrowse(aInterface, aProtocol, aEvent, aName, aType, aDomain);
+}
+
+void BrowserAvahi::HandleBrowse(AvahiIfIndex      aInterface,
+                                AvahiProtocol     aProtocol,
+                                AvahiBrowserEvent aEvent,
+                                const char *      aName,
+                                const char *      aType,
+                                const char *      aDomain)
+{
+    ResolverKey         key(aName == NULL ? "" : aName, GetInterface(aInterface, aProtocol));
+    Resolvers::iterator it;
+
+    switch (aEvent)
+    {
+    case AVAHI_BROWSER_NEW:
+        VerifyOrExit(mResolvers.find(key) == mResolvers.end());
+
+        {
+            // Addresses are not resolved, the host name is resolved on use.
+            AvahiServiceResolver *resolver =
+                avahi_service_resolver_new(mClient, aInterface, aProtocol, aName, aType, aDomain, AVAHI_PROTO_UNSPEC,
+                                           AVAHI_LOOKUP_NO_ADDRESS, HandleResolve, this);
+
+            VerifyOrExit(resolver != NULL, otbrLog(OTBR_LOG_ERR, "Failed to resolve service %s: %s!", aName,
+                                                   avahi_strerror(avahi_client_errno(mClient))));
+            mResolvers[key] = resolver;
+        }
+        break;
+
+    case AVAHI_BROWSER_REMOVE:
+        it = mResolvers.find(key);
+
+        if (it != mResolvers.end())
+        {
+            avahi_service_resolver_free(it->second);
+            mResolvers.erase(it);
+        }
+
+        mCache.Remove(aName, key.second);
+        break;
+
+    case AVAHI_BROWSER_FAILURE:
+        otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", mType, avahi_strerror(avahi_client_errno(mClient)));
+        break;
+
+    case AVAHI_BROWSER_CACHE_EXHAUSTED:
+    case AVAHI_BROWSER_ALL_FOR_NOW:
+        otbrLog(OTBR_LOG_DEBUG, "Browsed %s, %u services known", mType, static_cast<unsigned>(mCache.GetSize()));
+        break;
+    }
+
+exit:
+    return;
+}
+
+void BrowserAvahi::HandleResolve(AvahiServiceResolver * aResolver,
+                                 AvahiIfIndex           aInterface,
+                                 AvahiProtocol          aProtocol,
+                                 AvahiResolverEvent     aEvent,
+                                 const char *           aName,
+                                 const char *           aType,
+                                 const char *           aDomain,
+                                 const char *           aHostName,
+                                 const AvahiAddress *   aAddress,
+                                 uint16_t               aPort,
+                                 AvahiStringList *      aTxt,
+                                 AvahiLookupResultFlags aFlags,
+                                 void *                 aContext)
+{
+    (void)aResolver;
+    (void)aAddress;
+    (void)aFlags;
+
+    static_cast<BrowserAvahi *>(aContext)->HandleResolve(aInterface, aProtocol, aEvent, aName, aType, aDomain,
+                                                         aHostName, aPort, aTxt);
+}
+
+void BrowserAvahi::HandleResolve(AvahiIfIndex       aInterface,
+                                 AvahiProtocol      aProtocol,
+                                 AvahiResolverEvent aEvent,
+                                 const char *       aName,
+                                 const char *       aType,
+                                 const char *       aDomain,
+                                 const char *       aHostName,
+                                 uint16_t           aPort,
+                                 AvahiStringList *  aTxt)
+{
+    DiscoveredService service;
+
+    // The resolver is kept to report changes, until the service is removed.
+    VerifyOrExit(aEvent == AVAHI_RESOLVER_FOUND, otbrLog(OTBR_LOG_WARNING, "Failed to resolve service %s: %s!",
+                                                         aName, avahi_strerror(avahi_client_errno(mClient))));
+
+    service.mName     = aName;
+    service.mType     = aType;
+    service.mDomain   = aDomain;
+    service.mHostName = aHostName;
+    service.mPort     = aPort;
+
+    for (AvahiStringList *entry = aTxt; entry != NULL; entry = avahi_string_list_get_next(entry))
+    {
+        AppendTxtEntry(service.mTxtList, avahi_string_list_get_text(entry), avahi_string_list_get_size(entry));
+    }
+
+    mCache.Update(service, GetInterface(aInterface, aProtocol), ServiceCache::kTtlInfinite);
+
+exit:
+    return;
+}
+
+Browser *Browser::Create(EventLoop &   aEventLoop,
+                         int           aProtocol,
+                         const char *  aType,
+                         const char *  aDomain,
+                         ServiceCache &aCache)
+{
+    return new BrowserAvahi(aEventLoop, aProtocol, aType, aDomain, aCache);
+}
+
+void Browser::Destroy(Browser *aBrowser)
+{
+    delete static_cast<BrowserAvahi *>(aBrowser);
+}
+
 } // namespace Mdns
 
 } // namespace BorderRouter
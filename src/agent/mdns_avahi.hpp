@@ -34,14 +34,19 @@
 #ifndef MDNS_AVAHI_HPP_
 #define MDNS_AVAHI_HPP_
 
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <avahi-client/client.h>
+#include <avahi-client/lookup.h>
 #include <avahi-client/publish.h>
 #include <avahi-common/domain.h>
 #include <avahi-common/watch.h>
 
 #include "mdns.hpp"
+#include "mdns_cache.hpp"
 
 /**
  * @addtogroup border-router-mdns
@@ -61,9 +66,11 @@ struct AvahiWatch
     int                mFd;       ///< The file descriptor to watch.
     AvahiWatchEvent    mEvents;   ///< The interested events.
     int                mHappened; ///< The events happened.
+    int                mPending;  ///< The events happened but not yet passed to mCallback.
     AvahiWatchCallback mCallback; ///< The function to be called when interested events happened on mFd.
     void *             mContext;  ///< A pointer to application-specific context.
     void *             mPoller;   ///< The poller created this watch.
+    AvahiWatch *       mNext;     ///< The next watch on the same file descriptor.
 
     /**
      * The constructor to initialize an Avahi watch.
@@ -78,9 +85,12 @@ struct AvahiWatch
     AvahiWatch(int aFd, AvahiWatchEvent aEvents, AvahiWatchCallback aCallback, void *aContext, void *aPoller)
         : mFd(aFd)
         , mEvents(aEvents)
+        , mHappened(0)
+        , mPending(0)
         , mCallback(aCallback)
         , mContext(aContext)
         , mPoller(aPoller)
+        , mNext(NULL)
     {
     }
 };
@@ -91,21 +101,28 @@ struct AvahiWatch
  */
 struct AvahiTimeout
 {
-    unsigned long        mTimeout;  ///< Absolute time when this timer timeout.
-    AvahiTimeoutCallback mCallback; ///< The function to be called when timeout.
-    void *               mContext;  ///< The pointer to application-specific context.
-    void *               mPoller;   ///< The poller created this timer.
+    ot::BorderRouter::EventLoop::Timer mTimer;    ///< The timer of the event loop.
+    AvahiTimeoutCallback               mCallback; ///< The function to be called when timeout.
+    void *                             mContext;  ///< The pointer to application-specific context.
+    void *                             mPoller;   ///< The poller created this timer.
 
     /**
      * The constructor to initialize an AvahiTimeout.
      *
-     * @param[in]   aTimeout    A pointer to the time after which the callback should be called.
      * @param[in]   aCallback   The function to be called after timeout.
      * @param[in]   aContext    A pointer to application-specific context.
      * @param[in]   aPoller     The Poller this timeout belongs to.
      *
      */
-    AvahiTimeout(const struct timeval *aTimeout, AvahiTimeoutCallback aCallback, void *aContext, void *aPoller);
+    AvahiTimeout(AvahiTimeoutCallback aCallback, void *aContext, void *aPoller);
+
+    /**
+     * This function is called when the timer of an AvahiTimeout fires.
+     *
+     * @param[in]   aContext    A pointer to the AvahiTimeout.
+     *
+     */
+    static void HandleTimer(void *aContext);
 };
 
 namespace ot {
@@ -124,30 +141,10 @@ public:
     /**
      * The constructor to initialize a Poller.
      *
-     */
-    Poller(void);
-
-    /**
-     * This method updates the fd_set and timeout for mainloop.
-     *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the max file descriptor.
-     * @param[inout]    aTimeout        A reference to the timeout.
+     * @param[in]   aEventLoop  A reference to the event loop, which watches and timeouts are registered to.
      *
      */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
-
-    /**
-     * This method performs avahi poll processing.
-     *
-     * @param[in]   aReadFdSet   A reference to read file descriptors.
-     * @param[in]   aWriteFdSet  A reference to write file descriptors.
-     * @param[in]   aErrorFdSet  A reference to error file descriptors.
-     *
-     */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    explicit Poller(EventLoop &aEventLoop);
 
     /**
      * This method returns the AvahiPoll.
@@ -158,8 +155,11 @@ public:
     const AvahiPoll *GetAvahiPoll(void) const { return &mAvahiPoller; }
 
 private:
-    typedef std::vector<AvahiWatch *>   Watches;
-    typedef std::vector<AvahiTimeout *> Timers;
+    /**
+     * Heads of the watch lists, indexed by file descriptor.
+     *
+     */
+    typedef std::vector<AvahiWatch *> Watches;
 
     static AvahiWatch *    WatchNew(const struct AvahiPoll *aPoller,
                                     int                     aFd,
@@ -177,12 +177,18 @@ private:
                                       void *                aContext);
     AvahiTimeout *         TimeoutNew(const struct timeval *aTimeout, AvahiTimeoutCallback aCallback, void *aContext);
     static void            TimeoutUpdate(AvahiTimeout *aTimer, const struct timeval *aTimeout);
+    void                   TimeoutUpdate(AvahiTimeout &aTimer, const struct timeval *aTimeout);
     static void            TimeoutFree(AvahiTimeout *aTimer);
     void                   TimeoutFree(AvahiTimeout &aTimer);
 
-    Watches   mWatches;
-    Timers    mTimers;
-    AvahiPoll mAvahiPoller;
+    static unsigned int GetIoEvents(const AvahiWatch *aWatches);
+    static void         HandleIo(void *aContext, int aFd, unsigned int aEvents);
+    void                HandleIo(int aFd, unsigned int aEvents);
+    void                DispatchWatches(int aFd);
+
+    EventLoop &mEventLoop;
+    Watches    mWatches;
+    AvahiPoll  mAvahiPoller;
 };
 
 /**
@@ -195,6 +201,7 @@ public:
     /**
      * The constructor to initialize a Publisher.
      *
+     * @param[in]   aEventLoop          A reference to the event loop.
      * @param[in]   aProtocol           The protocol used for publishing. IPv4, IPv6 or both.
      * @param[in]   aHost               The name of host residing the services to be published.
                                         NULL to use default.
@@ -203,14 +210,20 @@ public:
      * @param[in]   aContext            A pointer to application-specific context.
      *
      */
-    PublisherAvahi(int aProtocol, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext);
+    PublisherAvahi(EventLoop &  aEventLoop,
+                   int          aProtocol,
+                   const char * aHost,
+                   const char * aDomain,
+                   StateHandler aHandler,
+                   void *       aContext);
 
     ~PublisherAvahi(void);
 
     /**
      * This method publishes or updates a service.
      *
-     * @note only text record can be updated.
+     * Each service has its own entry group. A text record update is applied in place, other changes are committed
+     * before returning to the event loop.
      *
      * @param[in]   aName               The name of this service.
      * @param[in]   aType               The type of this service.
@@ -224,6 +237,35 @@ public:
      */
     otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...);
 
+    /**
+     * This method publishes or updates a list of services.
+     *
+     * New services published before returning to the event loop are added to one entry group and committed together.
+     *
+     * @param[in]   aServices           The services to publish.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully published or updated all the services.
+     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update some of the services.
+     * @retval  OTBR_ERROR_MDNS     Failed to publish or update some of the services for avahi error.
+     *
+     */
+    otbrError PublishServices(const ServiceList &aServices);
+
+    /**
+     * This method renames a published service, keeping its port and text record.
+     *
+     * The entry group of the service is reset and committed with the new name before returning to the event loop.
+     *
+     * @param[in]   aType               The type of this service.
+     * @param[in]   aOldName            The current name of this service.
+     * @param[in]   aNewName            The new name of this service.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully renamed the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to rename the service.
+     *
+     */
+    otbrError RenameService(const char *aType, const char *aOldName, const char *aNewName);
+
     /**
      * This method starts the MDNS service.
      *
@@ -248,28 +290,6 @@ public:
      */
     void Stop(void);
 
-    /**
-     * This method performs avahi poll processing.
-     *
-     * @param[in]   aReadFdSet          A reference to read file descriptors.
-     * @param[in]   aWriteFdSet         A reference to write file descriptors.
-     * @param[in]   aErrorFdSet         A reference to error file descriptors.
-     *
-     */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
-
-    /**
-     * This method updates the fd_set and timeout for mainloop.
-     *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the max file descriptor.
-     * @param[inout]    aTimeout        A reference to the timeout.
-     *
-     */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
-
 private:
     enum
     {
@@ -282,24 +302,40 @@ private:
 
     struct Service
     {
-        char     mName[kMaxSizeOfServiceName];
-        char     mType[kMaxSizeOfServiceType];
-        uint16_t mPort;
+        char                     mName[kMaxSizeOfServiceName];
+        char                     mType[kMaxSizeOfServiceType];
+        uint16_t                 mPort;
+        std::vector<std::string> mTxt;        ///< Text record entries in the order of publishing.
+        AvahiEntryGroup *        mGroup;      ///< The entry group of this service, shared with services published
+                                              ///< together, NULL until first committed.
+        bool                     mPending;    ///< Whether the entry group is to be repopulated and committed.
+        unsigned long            mCommitTime; ///< The time of the last commit, in milliseconds.
     };
 
-    typedef std::vector<Service> Services;
+    typedef std::vector<Service>                      Services;
+    typedef std::pair<std::string, std::string>       ServiceKey;   ///< The name and type of a service.
+    typedef std::map<ServiceKey, Services::size_type> ServiceIndex; ///< Positions of services in mServices.
+
+    otbrError        PublishService(const ServiceInfo &aInfo);
+    Service *        FindService(const char *aName, const char *aType);
+    AvahiStringList *MakeTxtList(const Service &aService);
+    void             CommitServices(void);
+    void             ScheduleCommit(void);
+    static void      HandleCommitTimer(void *aContext);
+    int              CommitGroup(AvahiEntryGroup *aGroup);
 
     static void HandleClientState(AvahiClient *aClient, AvahiClientState aState, void *aContext);
     void        HandleClientState(AvahiClient *aClient, AvahiClientState aState);
 
-    void        CreateGroup(AvahiClient *aClient);
     static void HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState, void *aContext);
     void        HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState);
 
+    EventLoop &      mEventLoop;
     Services         mServices;
+    ServiceIndex     mServiceIndex;
     AvahiClient *    mClient;
-    AvahiEntryGroup *mGroup;
     Poller           mPoller;
+    EventLoop::Timer mCommitTimer; ///< Commits changes made in one pass of the event loop together.
     int              mProtocol;
     const char *     mHost;
     const char *     mDomain;
@@ -308,6 +344,114 @@ private:
     void *           mContext;
 };
 
+/**
+ * This class implements MDNS browser with avahi.
+ *
+ * Avahi does not report record TTLs, it tracks them itself and reports a service removed when its records expire, so
+ * services are kept in the cache with kTtlInfinite until removed. A resolver is kept for each service on each
+ * interface and protocol, so changes of its text record are reported as well.
+ *
+ */
+class BrowserAvahi : public Browser
+{
+public:
+    /**
+     * The constructor to initialize a Browser.
+     *
+     * @param[in]   aEventLoop          A reference to the event loop.
+     * @param[in]   aProtocol           The protocol to browse on. IPv4, IPv6 or both.
+     * @param[in]   aType               The type of services to browse.
+     * @param[in]   aDomain             The domain to browse in. NULL to use default.
+     * @param[in]   aCache              A reference to the cache to keep discovered services.
+     *
+     */
+    BrowserAvahi(EventLoop &aEventLoop, int aProtocol, const char *aType, const char *aDomain, ServiceCache &aCache);
+
+    ~BrowserAvahi(void);
+
+    /**
+     * This method starts browsing, services are browsed once the avahi client is running.
+     *
+     * @retval OTBR_ERROR_NONE  Successfully started browsing.
+     * @retval OTBR_ERROR_MDNS  Failed to create the avahi client.
+     *
+     */
+    otbrError Start(void);
+
+    /**
+     * This method stops browsing, and removes all the services from the cache.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method checks if browser has been started.
+     *
+     * @retval true     Already started.
+     * @retval false    Not started.
+     *
+     */
+    bool IsStarted(void) const;
+
+private:
+    typedef std::pair<std::string, uint32_t>              ResolverKey; ///< The name and interface of a service.
+    typedef std::map<ResolverKey, AvahiServiceResolver *> Resolvers;
+
+    static uint32_t GetInterface(AvahiIfIndex aInterface, AvahiProtocol aProtocol);
+    void            FreeBrowser(void);
+
+    static void HandleClientState(AvahiClient *aClient, AvahiClientState aState, void *aContext);
+    void        HandleClientState(AvahiClient *aClient, AvahiClientState aState);
+
+    static void HandleBrowse(AvahiServiceBrowser *  aBrowser,
+                             AvahiIfIndex           aInterface,
+                             AvahiProtocol          aProtocol,
+                             AvahiBrowserEvent      aEvent,
+                             const char *           aName,
+                             const char *           aType,
+                             const char *           aDomain,
+                             AvahiLookupResultFlags aFlags,
+                             void *                 aContext);
+    void        HandleBrowse(AvahiIfIndex      aInterface,
+                             AvahiProtocol     aProtocol,
+                             AvahiBrowserEvent aEvent,
+                             const char *      aName,
+                             const char *      aType,
+                             const char *      aDomain);
+
+    static void HandleResolve(AvahiServiceResolver * aResolver,
+                              AvahiIfIndex           aInterface,
+                              AvahiProtocol          aProtocol,
+                              AvahiResolverEvent     aEvent,
+                              const char *           aName,
+                              const char *           aType,
+                              const char *           aDomain,
+                              const char *           aHostName,
+                              const AvahiAddress *   aAddress,
+                              uint16_t               aPort,
+                              AvahiStringList *      aTxt,
+                              AvahiLookupResultFlags aFlags,
+                              void *                 aContext);
+    void        HandleResolve(AvahiIfIndex       aInterface,
+                              AvahiProtocol      aProtocol,
+                              AvahiResolverEvent aEvent,
+                              const char *       aName,
+                              const char *       aType,
+                              const char *       aDomain,
+                              const char *       aHostName,
+                              uint16_t           aPort,
+                              AvahiStringList *  aTxt);
+
+    ServiceCache &       mCache;
+    AvahiClient *        mClient;
+    AvahiServiceBrowser *mBrowser;
+    Resolvers            mResolvers;
+    Poller               mPoller;
+    int                  mProtocol;
+    const char *         mType;
+    const char *         mDomain;
+};
+
 } // namespace Mdns
 
 } // namespace BorderRouter
@@ -0,0 +1,276 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the cache of discovered MDNS services.
+ */
+
+#include "mdns_cache.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Mdns {
+
+const uint32_t ServiceCache::kTtlInfinite;
+
+ServiceCache::ServiceCache(void)
+    : mNextExpiry(0)
+    , mHasExpiry(false)
+{
+}
+
+bool ServiceCache::IsSame(const DiscoveredService &aLeft, const DiscoveredService &aRight)
+{
+    bool same = aLeft.mHostName == aRight.mHostName && aLeft.mPort == aRight.mPort && aLeft.mDomain == aRight.mDomain &&
+                aLeft.mTxtList.size() == aRight.mTxtList.size();
+
+    for (size_t i = 0; same && i < aLeft.mTxtList.size(); ++i)
+    {
+        same = aLeft.mTxtList[i].mName == aRight.mTxtList[i].mName &&
+               aLeft.mTxtList[i].mValue == aRight.mTxtList[i].mValue;
+    }
+
+    return same;
+}
+
+void ServiceCache::Update(const DiscoveredService &aService, uint32_t aInterface, uint32_t aTtl)
+{
+    Entries::iterator it;
+    Record            record;
+
+    VerifyOrExit(aTtl != 0, Remove(aService.mName.c_str(), aInterface));
+
+    record.mTimed = (aTtl != kTtlInfinite);
+
+    if (record.mTimed)
+    {
+        record.mExpiry = GetNow() + (aTtl < kMaxTtl ? aTtl : static_cast<uint32_t>(kMaxTtl)) * 1000UL;
+
+        if (!mHasExpiry || static_cast<long>(record.mExpiry - mNextExpiry) < 0)
+        {
+            mNextExpiry = record.mExpiry;
+            mHasExpiry  = true;
+        }
+    }
+
+    it = mEntries.find(aService.mName);
+
+    if (it == mEntries.end())
+    {
+        Entry &entry = mEntries[aService.mName];
+
+        entry.mService             = aService;
+        entry.mRecords[aInterface] = record;
+
+        otbrLog(OTBR_LOG_INFO, "MDNS service %s added on interface %u", aService.mName.c_str(), aInterface);
+        Emit<kEventServiceAdded>(entry.mService);
+    }
+    else
+    {
+        // The same service on another interface refreshes its records without being announced again.
+        it->second.mRecords[aInterface] = record;
+
+        if (!IsSame(it->second.mService, aService))
+        {
+            it->second.mService = aService;
+
+            otbrLog(OTBR_LOG_INFO, "MDNS service %s updated", aService.mName.c_str());
+            Emit<kEventServiceUpdated>(it->second.mService);
+        }
+    }
+
+exit:
+    return;
+}
+
+void ServiceCache::Remove(const char *aName, uint32_t aInterface)
+{
+    Entries::iterator it = mEntries.find(aName);
+
+    VerifyOrExit(it != mEntries.end());
+
+    it->second.mRecords.erase(aInterface);
+
+    if (it->second.mRecords.empty())
+    {
+        Erase(it);
+    }
+
+exit:
+    return;
+}
+
+void ServiceCache::Erase(Entries::iterator aEntry)
+{
+    otbrLog(OTBR_LOG_INFO, "MDNS service %s removed", aEntry->second.mService.mName.c_str());
+    Emit<kEventServiceRemoved>(aEntry->second.mService);
+    mEntries.erase(aEntry);
+}
+
+void ServiceCache::Expire(void)
+{
+    unsigned long now = GetNow();
+
+    VerifyOrExit(mHasExpiry && static_cast<long>(now - mNextExpiry) >= 0);
+
+    mHasExpiry = false;
+
+    for (Entries::iterator it = mEntries.begin(); it != mEntries.end();)
+    {
+        Records &records = it->second.mRecords;
+
+        for (Records::iterator record = records.begin(); record != records.end();)
+        {
+            if (!record->second.mTimed)
+            {
+                ++record;
+            }
+            else if (static_cast<long>(now - record->second.mExpiry) >= 0)
+            {
+                records.erase(record++);
+            }
+            else
+            {
+                if (!mHasExpiry || static_cast<long>(record->second.mExpiry - mNextExpiry) < 0)
+                {
+                    mNextExpiry = record->second.mExpiry;
+                    mHasExpiry  = true;
+                }
+
+                ++record;
+            }
+        }
+
+        if (records.empty())
+        {
+            Erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+exit:
+    return;
+}
+
+void ServiceCache::Clear(void)
+{
+    while (!mEntries.empty())
+    {
+        Erase(mEntries.begin());
+    }
+
+    mHasExpiry = false;
+}
+
+void ServiceCache::UpdateTimeout(timeval &aTimeout) const
+{
+    unsigned long now = GetNow();
+    unsigned long timeout;
+
+    VerifyOrExit(mHasExpiry);
+
+    timeout = static_cast<long>(mNextExpiry - now) > 0 ? mNextExpiry - now : 0;
+
+    if (static_cast<unsigned long>(aTimeout.tv_sec) * 1000 + static_cast<unsigned long>(aTimeout.tv_usec) / 1000 >
+        timeout)
+    {
+        aTimeout.tv_sec  = static_cast<time_t>(timeout / 1000);
+        aTimeout.tv_usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
+    }
+
+exit:
+    return;
+}
+
+const DiscoveredService *ServiceCache::Find(const char *aName) const
+{
+    Entries::const_iterator it = mEntries.find(aName);
+
+    return it == mEntries.end() ? NULL : &it->second.mService;
+}
+
+void ServiceCache::GetServices(std::vector<DiscoveredService> &aServices) const
+{
+    aServices.clear();
+    aServices.reserve(mEntries.size());
+
+    for (Entries::const_iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+    {
+        aServices.push_back(it->second.mService);
+    }
+}
+
+void AppendTxtEntry(TxtList &aTxtList, const uint8_t *aText, size_t aLength)
+{
+    const uint8_t *separator = static_cast<const uint8_t *>(memchr(aText, '=', aLength));
+    size_t         keyLength = separator == NULL ? aLength : static_cast<size_t>(separator - aText);
+
+    VerifyOrExit(keyLength > 0);
+
+    aTxtList.push_back(TxtEntry(std::string(reinterpret_cast<const char *>(aText), keyLength).c_str(),
+                                separator == NULL ? NULL : separator + 1,
+                                separator == NULL ? 0 : aLength - keyLength - 1));
+
+exit:
+    return;
+}
+
+otbrError DecodeTxtData(const uint8_t *aData, size_t aLength, TxtList &aTxtList)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    aTxtList.clear();
+
+    for (size_t offset = 0; offset < aLength; offset += 1 + aData[offset])
+    {
+        VerifyOrExit(offset + 1 + aData[offset] <= aLength, errno = EBADMSG, ret = OTBR_ERROR_ERRNO);
+        AppendTxtEntry(aTxtList, aData + offset + 1, aData[offset]);
+    }
+
+exit:
+    return ret;
+}
+
+} // namespace Mdns
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,242 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the cache of discovered MDNS services.
+ */
+
+#ifndef MDNS_CACHE_HPP_
+#define MDNS_CACHE_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+#include "mdns.hpp"
+#include "common/event_emitter.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Mdns {
+
+/**
+ * @addtogroup border-router-mdns
+ *
+ * @{
+ */
+
+/**
+ * Service cache events.
+ *
+ */
+enum
+{
+    kEventServiceAdded,   ///< A service is discovered.
+    kEventServiceUpdated, ///< The host, port or text record of a known service changed.
+    kEventServiceRemoved, ///< A service is gone from all interfaces, or its records expired.
+    kNumCacheEvents,      ///< Number of service cache events.
+};
+
+enum
+{
+    kMaxCacheEventHandlers = 4, ///< Maximum number of handlers of each service cache event.
+};
+
+/**
+ * This class template declares the handler type of service cache events, @p aService is only valid during the call.
+ *
+ */
+template <int kEvent> struct CacheEventSignature
+{
+    typedef void (*Handler)(void *aContext, const DiscoveredService &aService);
+};
+
+/**
+ * This class implements an in-memory cache of discovered services, keyed by instance name.
+ *
+ * A service announced on several interfaces, or over both IPv4 and IPv6, is kept once and announced once. It is
+ * removed when it is gone from all of them, either by goodbye or by its records expiring. Handlers of the events
+ * must not modify the cache.
+ *
+ */
+class ServiceCache : public EventEmitter<CacheEventSignature, kNumCacheEvents, kMaxCacheEventHandlers>
+{
+public:
+    static const uint32_t kTtlInfinite = 0xffffffff; ///< TTL of records expired by the MDNS service itself.
+
+    enum
+    {
+        kDefaultTtl = 120,   ///< TTL in seconds of records whose TTL is not reported, as host records in RFC 6762.
+        kMaxTtl     = 86400, ///< Max TTL in seconds, longer TTLs are cut to this.
+    };
+
+    /**
+     * The constructor to initialize an empty service cache.
+     *
+     */
+    ServiceCache(void);
+
+    /**
+     * This method adds or refreshes a service discovered on an interface.
+     *
+     * kEventServiceAdded is emitted for a new service, and kEventServiceUpdated if its host, port or text record
+     * changed. A TTL of zero is a goodbye, as Remove().
+     *
+     * @param[in]   aService    The service discovered.
+     * @param[in]   aInterface  The interface the service is discovered on.
+     * @param[in]   aTtl        The TTL of the records in seconds, or kTtlInfinite.
+     *
+     */
+    void Update(const DiscoveredService &aService, uint32_t aInterface, uint32_t aTtl);
+
+    /**
+     * This method removes a service from an interface.
+     *
+     * kEventServiceRemoved is emitted if the service is not present on any other interface.
+     *
+     * @param[in]   aName       The instance name of the service.
+     * @param[in]   aInterface  The interface the service is gone from.
+     *
+     */
+    void Remove(const char *aName, uint32_t aInterface);
+
+    /**
+     * This method removes the services whose records expired on all interfaces.
+     *
+     */
+    void Expire(void);
+
+    /**
+     * This method removes all the services, kEventServiceRemoved is emitted for each of them.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method updates the timeout for mainloop to the next expiry.
+     *
+     * @param[inout]    aTimeout    A reference to the timeout, updated if an entry expires earlier.
+     *
+     */
+    void UpdateTimeout(timeval &aTimeout) const;
+
+    /**
+     * This method finds a service by instance name.
+     *
+     * @param[in]   aName       The instance name of the service.
+     *
+     * @returns A pointer to the service, or NULL if not found. The pointer is valid until the cache is modified.
+     *
+     */
+    const DiscoveredService *Find(const char *aName) const;
+
+    /**
+     * This method copies all the services.
+     *
+     * @param[out]  aServices   A reference to the list to receive the services, ordered by instance name.
+     *
+     */
+    void GetServices(std::vector<DiscoveredService> &aServices) const;
+
+    /**
+     * This method returns the number of cached services.
+     *
+     * @returns The number of cached services.
+     *
+     */
+    size_t GetSize(void) const { return mEntries.size(); }
+
+private:
+    struct Record
+    {
+        unsigned long mExpiry; ///< The time when this record expires, in milliseconds.
+        bool          mTimed;  ///< Whether this record expires at mExpiry, false for kTtlInfinite.
+    };
+
+    typedef std::map<uint32_t, Record> Records; ///< Records of a service, keyed by interface.
+
+    struct Entry
+    {
+        DiscoveredService mService;
+        Records           mRecords;
+    };
+
+    typedef std::map<std::string, Entry> Entries;
+
+    void        Erase(Entries::iterator aEntry);
+    static bool IsSame(const DiscoveredService &aLeft, const DiscoveredService &aRight);
+
+    Entries       mEntries;
+    unsigned long mNextExpiry; ///< The earliest expiry of timed records, valid if mHasExpiry.
+    bool          mHasExpiry;
+};
+
+/**
+ * This function appends an entry of text record in the "key=value" format to a list.
+ *
+ * An entry without '=' is a boolean attribute, and has an empty value. Empty entries and entries without key are
+ * skipped.
+ *
+ * @param[in]   aTxtList    A reference to the list.
+ * @param[in]   aText       A pointer to the entry.
+ * @param[in]   aLength     The length of the entry.
+ *
+ */
+void AppendTxtEntry(TxtList &aTxtList, const uint8_t *aText, size_t aLength);
+
+/**
+ * This function decodes the data of a text record, which is a series of length-prefixed entries.
+ *
+ * @param[in]   aData       A pointer to the record data.
+ * @param[in]   aLength     The length of the record data.
+ * @param[out]  aTxtList    A reference to the list to receive the entries.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully decoded the record.
+ * @retval  OTBR_ERROR_ERRNO    The record is truncated, errno is set to EBADMSG.
+ *
+ */
+otbrError DecodeTxtData(const uint8_t *aData, size_t aLength, TxtList &aTxtList);
+
+/**
+ * @}
+ */
+
+} // namespace Mdns
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // MDNS_CACHE_HPP_
@@ -166,12 +166,18 @@ static const char *DNSErrorToString(DNSServiceErrorType aError)
     }
 }
 
-PublisherMDnsSd::PublisherMDnsSd(int          aProtocol,
+PublisherMDnsSd::PublisherMDnsSd(EventLoop &  aEventLoop,
+                                 int          aProtocol,
                                  const char * aHost,
                                  const char * aDomain,
                                  StateHandler aHandler,
                                  void *       aContext)
-    : mHost(aHost)
+    : mEventLoop(aEventLoop)
+    , mConnection(NULL)
+    , mPendingCount(0)
+    , mRegisteredCount(0)
+    , mRegisterStart(0)
+    , mHost(aHost)
     , mDomain(aDomain)
     , mState(kStateIdle)
     , mStateHandler(aHandler)
@@ -209,60 +215,35 @@ void PublisherMDnsSd::Stop(void)
 
     mServices.clear();
 
-exit:
-    return;
-}
-
-void PublisherMDnsSd::UpdateFdSet(fd_set & aReadFdSet,
-                                  fd_set & aWriteFdSet,
-                                  fd_set & aErrorFdSet,
-                                  int &    aMaxFd,
-                                  timeval &aTimeout)
-{
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
-    (void)aTimeout;
-
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    // Deallocated after the services sharing it.
+    if (mConnection != NULL)
     {
-        int fd = DNSServiceRefSockFD(it->mService);
-
-        assert(fd != -1);
+        mEventLoop.RemoveIo(DNSServiceRefSockFD(mConnection));
+        DNSServiceRefDeallocate(mConnection);
+        mConnection = NULL;
+    }
 
-        FD_SET(fd, &aReadFdSet);
+    mPendingCount    = 0;
+    mRegisteredCount = 0;
 
-        if (fd > aMaxFd)
-        {
-            aMaxFd = fd;
-        }
-    }
+exit:
+    return;
 }
 
-void PublisherMDnsSd::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void PublisherMDnsSd::HandleIo(void *aContext, int aFd, unsigned int aEvents)
 {
-    std::vector<DNSServiceRef> readyServices;
-
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
+    PublisherMDnsSd *   publisher = static_cast<PublisherMDnsSd *>(aContext);
+    DNSServiceErrorType error;
 
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
-    {
-        int fd = DNSServiceRefSockFD(it->mService);
+    (void)aFd;
+    (void)aEvents;
 
-        if (FD_ISSET(fd, &aReadFdSet))
-        {
-            readyServices.push_back(it->mService);
-        }
-    }
+    // Replies of all the services come over the shared connection.
+    error = DNSServiceProcessResult(publisher->mConnection);
 
-    for (std::vector<DNSServiceRef>::iterator it = readyServices.begin(); it != readyServices.end(); ++it)
+    if (error != kDNSServiceErr_NoError)
     {
-        DNSServiceErrorType error = DNSServiceProcessResult(*it);
-
-        if (error != kDNSServiceErr_NoError)
-        {
-            otbrLog(OTBR_LOG_WARNING, "DNSServiceProcessResult failed: %s", DNSErrorToString(error));
-        }
+        otbrLog(OTBR_LOG_WARNING, "DNSServiceProcessResult failed: %s", DNSErrorToString(error));
     }
 }
 
@@ -292,85 +273,196 @@ void PublisherMDnsSd::HandleServiceRegisterResult(DNSServiceRef         aService
         if (aFlags & kDNSServiceFlagsAdd)
         {
             otbrLog(OTBR_LOG_INFO, "MDNS added service %s", aName);
-            RecordService(aName, aType, aServiceRef);
+            RecordService(aServiceRef);
         }
         else
         {
             otbrLog(OTBR_LOG_INFO, "MDNS remove service %s", aName);
-            DiscardService(aName, aType, aServiceRef);
+            DiscardService(aServiceRef);
         }
     }
     else
     {
         otbrLog(OTBR_LOG_ERR, "Failed to register service %s: %s", aName, DNSErrorToString(aError));
-        DiscardService(aName, aType, aServiceRef);
+        DiscardService(aServiceRef);
     }
 }
 
-void PublisherMDnsSd::DiscardService(const char *aName, const char *aType, DNSServiceRef aServiceRef)
+PublisherMDnsSd::Service *PublisherMDnsSd::FindService(const char *aName, const char *aType)
 {
+    Service *service = NULL;
+
     for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
         if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)))
         {
-            assert(aServiceRef == it->mService);
-            mServices.erase(it);
-            DNSServiceRefDeallocate(aServiceRef);
-            aServiceRef = NULL;
+            service = &*it;
             break;
         }
     }
 
-    assert(aServiceRef == NULL);
+    return service;
 }
 
-void PublisherMDnsSd::RecordService(const char *aName, const char *aType, DNSServiceRef aServiceRef)
+PublisherMDnsSd::Services::iterator PublisherMDnsSd::FindService(DNSServiceRef aServiceRef)
 {
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    Services::iterator it = mServices.begin();
+
+    while (it != mServices.end() && it->mService != aServiceRef)
     {
-        if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)))
+        ++it;
+    }
+
+    return it;
+}
+
+void PublisherMDnsSd::DiscardService(DNSServiceRef aServiceRef)
+{
+    Services::iterator it = FindService(aServiceRef);
+
+    assert(it != mServices.end());
+    VerifyOrExit(it != mServices.end());
+
+    if (it->mRegistering)
+    {
+        FinishRegistration();
+    }
+
+    mServices.erase(it);
+    DNSServiceRefDeallocate(aServiceRef);
+
+exit:
+    return;
+}
+
+void PublisherMDnsSd::RecordService(DNSServiceRef aServiceRef)
+{
+    Services::iterator it = FindService(aServiceRef);
+
+    VerifyOrExit(it != mServices.end() && it->mRegistering);
+
+    it->mRegistering = false;
+    ++mRegisteredCount;
+    FinishRegistration();
+
+exit:
+    return;
+}
+
+void PublisherMDnsSd::FinishRegistration(void)
+{
+    assert(mPendingCount > 0);
+    --mPendingCount;
+
+    if (mPendingCount == 0)
+    {
+        unsigned long elapsed = GetNow() - mRegisterStart;
+
+        otbrLog(OTBR_LOG_INFO, "%zu services registered in %lu ms, %lu services per second.", mRegisteredCount,
+                elapsed, mRegisteredCount * 1000 / (elapsed > 0 ? elapsed : 1));
+        mRegisteredCount = 0;
+    }
+}
+
+DNSServiceErrorType PublisherMDnsSd::RegisterService(Service &aService)
+{
+    DNSServiceErrorType error = kDNSServiceErr_NoError;
+
+    if (mConnection == NULL)
+    {
+        SuccessOrExit(error = DNSServiceCreateConnection(&mConnection));
+
+        // The connection is watched as long as it lives.
+        if (mEventLoop.AddIo(DNSServiceRefSockFD(mConnection), EventLoop::kEventReadable, HandleIo, this) !=
+            OTBR_ERROR_NONE)
         {
-            assert(aServiceRef == it->mService);
-            ExitNow();
+            otbrLog(OTBR_LOG_ERR, "Failed to watch mDNSResponder connection: %s", strerror(errno));
+            DNSServiceRefDeallocate(mConnection);
+            mConnection = NULL;
+            ExitNow(error = kDNSServiceErr_Unknown);
         }
     }
 
+    aService.mService = mConnection;
+    error = DNSServiceRegister(&aService.mService, kDNSServiceFlagsShareConnection, kDNSServiceInterfaceIndexAny,
+                               aService.mName, aService.mType, mDomain, mHost, aService.mPort, aService.mTxtLength,
+                               aService.mTxt, HandleServiceRegisterResult, this);
+
+    if (error != kDNSServiceErr_NoError)
     {
-        Service service;
+        aService.mService = NULL;
+        ExitNow();
+    }
 
-        strcpy_safe(service.mName, sizeof(service.mName), aName);
-        strcpy_safe(service.mType, sizeof(service.mType), aType);
-        service.mService = aServiceRef;
-        mServices.push_back(service);
+    if (mPendingCount == 0)
+    {
+        mRegisterStart = GetNow();
     }
 
+    aService.mRegistering = true;
+    ++mPendingCount;
+
 exit:
-    return;
+    return error;
 }
 
 otbrError PublisherMDnsSd::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
 {
-    otbrError     ret   = OTBR_ERROR_NONE;
-    int           error = 0;
-    va_list       args;
-    uint8_t       txt[kMaxSizeOfTxtRecord];
-    uint8_t *     cur        = txt;
-    DNSServiceRef serviceRef = NULL;
+    ServiceList services(1);
+    va_list     args;
 
     va_start(args, aType);
 
     for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
     {
-        const char * value        = va_arg(args, const char *);
-        const size_t nameLength   = strlen(name);
-        const size_t valueLength  = strlen(value);
+        services[0].mTxtList.push_back(TxtEntry(name, va_arg(args, const char *)));
+    }
+
+    va_end(args);
+
+    services[0].mName = aName;
+    services[0].mType = aType;
+    services[0].mPort = aPort;
+
+    return PublishServices(services);
+}
+
+otbrError PublisherMDnsSd::PublishServices(const ServiceList &aServices)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    for (ServiceList::const_iterator it = aServices.begin(); it != aServices.end(); ++it)
+    {
+        otbrError error = PublishService(*it);
+
+        if (error != OTBR_ERROR_NONE)
+        {
+            ret = error;
+        }
+    }
+
+    return ret;
+}
+
+otbrError PublisherMDnsSd::PublishService(const ServiceInfo &aInfo)
+{
+    otbrError ret   = OTBR_ERROR_NONE;
+    int       error = 0;
+    uint8_t   txt[kMaxSizeOfTxtRecord];
+    uint8_t * cur = txt;
+    Service * service;
+
+    for (TxtList::const_iterator it = aInfo.mTxtList.begin(); it != aInfo.mTxtList.end(); ++it)
+    {
+        const size_t nameLength   = it->mName.size();
+        const size_t valueLength  = it->mValue.size();
         size_t       recordLength = nameLength + 1 + valueLength;
 
-        assert(nameLength > 0 && valueLength > 0 && recordLength < kMaxTextRecordSize);
+        assert(nameLength > 0 && recordLength < kMaxTextRecordSize);
 
         if (cur + recordLength >= txt + sizeof(txt))
         {
-            otbrLog(OTBR_LOG_WARNING, "Skip text record too much long: %s=%s", name, value);
+            otbrLog(OTBR_LOG_WARNING, "Skip text record too much long: %s", it->mName.c_str());
             continue;
         }
 
@@ -378,34 +470,43 @@ otbrError PublisherMDnsSd::PublishService(uint16_t aPort, const char *aName, con
         cur[0] = static_cast<uint8_t>(recordLength);
         cur += 1;
 
-        memcpy(cur, name, nameLength);
+        memcpy(cur, it->mName.data(), nameLength);
         cur += nameLength;
 
         cur[0] = '=';
         cur += 1;
 
-        memcpy(cur, value, valueLength);
-        cur += valueLength;
+        if (valueLength > 0)
+        {
+            memcpy(cur, &it->mValue[0], valueLength);
+            cur += valueLength;
+        }
     }
 
-    va_end(args);
+    service = FindService(aInfo.mName.c_str(), aInfo.mType.c_str());
 
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    if (service != NULL)
     {
-        if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)))
-        {
-            otbrLog(OTBR_LOG_INFO, "MDNS remove current service %s", aName);
-            DNSServiceUpdateRecord(it->mService, NULL, 0, static_cast<uint16_t>(cur - txt), txt, 0);
-            ExitNow();
-        }
+        otbrLog(OTBR_LOG_INFO, "MDNS update service %s", service->mName);
+        SuccessOrExit(error = DNSServiceUpdateRecord(service->mService, NULL, 0, static_cast<uint16_t>(cur - txt), txt,
+                                                     0));
+        service->mTxtLength = static_cast<uint16_t>(cur - txt);
+        memcpy(service->mTxt, txt, service->mTxtLength);
     }
-
-    SuccessOrExit(error = DNSServiceRegister(&serviceRef, 0, kDNSServiceInterfaceIndexAny, aName, aType, mDomain, mHost,
-                                             htons(aPort), static_cast<uint16_t>(cur - txt), txt,
-                                             HandleServiceRegisterResult, this));
-    if (serviceRef != NULL)
+    else
     {
-        RecordService(aName, aType, serviceRef);
+        Service newService;
+
+        strcpy_safe(newService.mName, sizeof(newService.mName), aInfo.mName.c_str());
+        strcpy_safe(newService.mType, sizeof(newService.mType), aInfo.mType.c_str());
+        newService.mService     = NULL;
+        newService.mPort        = htons(aInfo.mPort);
+        newService.mTxtLength   = static_cast<uint16_t>(cur - txt);
+        newService.mRegistering = false;
+        memcpy(newService.mTxt, txt, newService.mTxtLength);
+
+        SuccessOrExit(error = RegisterService(newService));
+        mServices.push_back(newService);
     }
 
 exit:
@@ -419,9 +520,54 @@ exit:
     return ret;
 }
 
-Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
+otbrError PublisherMDnsSd::RenameService(const char *aType, const char *aOldName, const char *aNewName)
 {
-    return new PublisherMDnsSd(aFamily, aHost, aDomain, aHandler, aContext);
+    otbrError ret     = OTBR_ERROR_ERRNO;
+    int       error   = 0;
+    Service * service = FindService(aOldName, aType);
+    Service   renamed;
+
+    VerifyOrExit(service != NULL, errno = ENOENT);
+    VerifyOrExit(FindService(aNewName, aType) == NULL, errno = EEXIST);
+
+    otbrLog(OTBR_LOG_INFO, "MDNS rename service %s to %s", aOldName, aNewName);
+    ret     = OTBR_ERROR_MDNS;
+    renamed = *service;
+    strcpy_safe(renamed.mName, sizeof(renamed.mName), aNewName);
+    renamed.mRegistering = false;
+    SuccessOrExit(error = RegisterService(renamed));
+
+    // Deallocating the old reference withdraws only the old name.
+    if (service->mRegistering)
+    {
+        FinishRegistration();
+    }
+
+    DNSServiceRefDeallocate(service->mService);
+    *service = renamed;
+    ret      = OTBR_ERROR_NONE;
+
+exit:
+    if (error != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to rename service for mdnssd error: %s!", DNSErrorToString(error));
+    }
+    else if (ret == OTBR_ERROR_ERRNO)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to rename service %s: %s!", aOldName, strerror(errno));
+    }
+
+    return ret;
+}
+
+Publisher *Publisher::Create(EventLoop &  aEventLoop,
+                             int          aFamily,
+                             const char * aHost,
+                             const char * aDomain,
+                             StateHandler aHandler,
+                             void *       aContext)
+{
+    return new PublisherMDnsSd(aEventLoop, aFamily, aHost, aDomain, aHandler, aContext);
 }
 
 void Publisher::Destroy(Publisher *aPublisher)
@@ -429,6 +575,451 @@ void Publisher::Destroy(Publisher *aPublisher)
     delete static_cast<PublisherMDnsSd *>(aPublisher);
 }
 
+BrowserMDnsSd::BrowserMDnsSd(EventLoop &   aEventLoop,
+                             int           aProtocol,
+                             const char *  aType,
+                             const char *  aDomain,
+                             ServiceCache &aCache)
+    : mEventLoop(aEventLoop)
+    , mCache(aCache)
+    , mConnection(NULL)
+    , mBrowser(NULL)
+    , mTimer(HandleTimer, this)
+    , mType(aType)
+    , mDomain(aDomain)
+{
+    (void)aProtocol;
+}
+
+BrowserMDnsSd::~BrowserMDnsSd(void)
+{
+    Stop();
+}
+
+otbrError BrowserMDnsSd::Start(void)
+{
+    otbrError           ret   = OTBR_ERROR_NONE;
+    DNSServiceErrorType error = kDNSServiceErr_NoError;
+
+    VerifyOrExit(mConnection == NULL);
+
+    SuccessOrExit(error = DNSServiceCreateConnection(&mConnection));
+
+    if (mEventLoop.AddIo(DNSServiceRefSockFD(mConnection), EventLoop::kEventReadable, HandleIo, this) !=
+        OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to watch mDNSResponder connection: %s", strerror(errno));
+        ExitNow(error = kDNSServiceErr_Unknown);
+    }
+
+    mBrowser = mConnection;
+    error    = DNSServiceBrowse(&mBrowser, kDNSServiceFlagsShareConnection, kDNSServiceInterfaceIndexAny, mType,
+                                mDomain, HandleBrowseResult, this);
+
+exit:
+    if (error != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", mType, DNSErrorToString(error));
+        mBrowser = NULL;
+        Stop();
+        ret = OTBR_ERROR_MDNS;
+    }
+
+    return ret;
+}
+
+bool BrowserMDnsSd::IsStarted(void) const
+{
+    return mConnection != NULL;
+}
+
+void BrowserMDnsSd::Stop(void)
+{
+    for (Instances::iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        FreeInstance(*it);
+    }
+
+    mInstances.clear();
+
+    if (mBrowser != NULL)
+    {
+        DNSServiceRefDeallocate(mBrowser);
+        mBrowser = NULL;
+    }
+
+    // Deallocated after the operations sharing it.
+    if (mConnection != NULL)
+    {
+        mEventLoop.RemoveIo(DNSServiceRefSockFD(mConnection));
+        DNSServiceRefDeallocate(mConnection);
+        mConnection = NULL;
+    }
+
+    mEventLoop.StopTimer(mTimer);
+    mCache.Clear();
+}
+
+void BrowserMDnsSd::FreeInstance(Instance &aInstance)
+{
+    if (aInstance.mResolve != NULL)
+    {
+        DNSServiceRefDeallocate(aInstance.mResolve);
+        aInstance.mResolve = NULL;
+    }
+
+    if (aInstance.mQuery != NULL)
+    {
+        DNSServiceRefDeallocate(aInstance.mQuery);
+        aInstance.mQuery = NULL;
+    }
+}
+
+BrowserMDnsSd::Instances::iterator BrowserMDnsSd::FindInstance(const char *aName, uint32_t aInterface)
+{
+    Instances::iterator it = mInstances.begin();
+
+    while (it != mInstances.end() && (it->mInterface != aInterface || it->mService.mName != aName))
+    {
+        ++it;
+    }
+
+    return it;
+}
+
+BrowserMDnsSd::Instances::iterator BrowserMDnsSd::FindInstance(DNSServiceRef aServiceRef)
+{
+    Instances::iterator it = mInstances.begin();
+
+    while (it != mInstances.end() && it->mResolve != aServiceRef && it->mQuery != aServiceRef)
+    {
+        ++it;
+    }
+
+    return it;
+}
+
+void BrowserMDnsSd::HandleBrowseResult(DNSServiceRef       aServiceRef,
+                                       DNSServiceFlags     aFlags,
+                                       uint32_t            aInterface,
+                                       DNSServiceErrorType aError,
+                                       const char *        aName,
+                                       const char *        aType,
+                                       const char *        aDomain,
+                                       void *              aContext)
+{
+    (void)aServiceRef;
+
+    static_cast<BrowserMDnsSd *>(aContext)->HandleBrowseResult(aFlags, aInterface, aError, aName, aType, aDomain);
+}
+
+void BrowserMDnsSd::HandleBrowseResult(DNSServiceFlags     aFlags,
+                                       uint32_t            aInterface,
+                                       DNSServiceErrorType aError,
+                                       const char *        aName,
+                                       const char *        aType,
+                                       const char *        aDomain)
+{
+    Instances::iterator it;
+
+    VerifyOrExit(aError == kDNSServiceErr_NoError,
+                 otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", mType, DNSErrorToString(aError)));
+
+    it = FindInstance(aName, aInterface);
+
+    if (aFlags & kDNSServiceFlagsAdd)
+    {
+        Instance            instance;
+        DNSServiceErrorType error;
+
+        VerifyOrExit(it == mInstances.end());
+
+        instance.mService.mName   = aName;
+        instance.mService.mType   = aType;
+        instance.mService.mDomain = aDomain;
+        instance.mService.mPort   = 0;
+        instance.mInterface       = aInterface;
+        instance.mResolve         = mConnection;
+        instance.mQuery           = NULL;
+        instance.mRefreshTime     = 0;
+
+        error = DNSServiceResolve(&instance.mResolve, kDNSServiceFlagsShareConnection, aInterface, aName, aType,
+                                  aDomain, HandleResolveResult, this);
+        VerifyOrExit(error == kDNSServiceErr_NoError,
+                     otbrLog(OTBR_LOG_ERR, "Failed to resolve service %s: %s!", aName, DNSErrorToString(error)));
+
+        mInstances.push_back(instance);
+    }
+    else
+    {
+        VerifyOrExit(it != mInstances.end());
+
+        FreeInstance(*it);
+        mInstances.erase(it);
+        mCache.Remove(aName, aInterface);
+    }
+
+exit:
+    return;
+}
+
+void BrowserMDnsSd::HandleResolveResult(DNSServiceRef        aServiceRef,
+                                        DNSServiceFlags      aFlags,
+                                        uint32_t             aInterface,
+                                        DNSServiceErrorType  aError,
+                                        const char *         aFullName,
+                                        const char *         aHostName,
+                                        uint16_t             aPort,
+                                        uint16_t             aTxtLength,
+                                        const unsigned char *aTxt,
+                                        void *               aContext)
+{
+    (void)aFlags;
+    (void)aInterface;
+    (void)aFullName;
+
+    static_cast<BrowserMDnsSd *>(aContext)->HandleResolveResult(aServiceRef, aError, aHostName, aPort, aTxtLength,
+                                                                aTxt);
+}
+
+void BrowserMDnsSd::HandleResolveResult(DNSServiceRef        aServiceRef,
+                                        DNSServiceErrorType  aError,
+                                        const char *         aHostName,
+                                        uint16_t             aPort,
+                                        uint16_t             aTxtLength,
+                                        const unsigned char *aTxt)
+{
+    Instances::iterator it = FindInstance(aServiceRef);
+
+    VerifyOrExit(it != mInstances.end());
+
+    // Resolved once, later changes of the text record are reported by the query.
+    DNSServiceRefDeallocate(it->mResolve);
+    it->mResolve = NULL;
+
+    if (aError != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to resolve service %s: %s!", it->mService.mName.c_str(),
+                DNSErrorToString(aError));
+
+        // Nothing would ever query or expire it, it is browsed again once the service announces itself anew.
+        FreeInstance(*it);
+        mInstances.erase(it);
+        ExitNow();
+    }
+
+    it->mService.mHostName = aHostName;
+    it->mService.mPort     = ntohs(aPort);
+
+    if (DecodeTxtData(aTxt, aTxtLength, it->mService.mTxtList) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Bad text record of service %s", it->mService.mName.c_str());
+    }
+
+    // The TTL is not reported by resolving, it is taken from the query answered right after.
+    UpdateInstance(*it, ServiceCache::kDefaultTtl);
+
+    if (QueryTxt(*it) != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to query text record of service %s", it->mService.mName.c_str());
+    }
+
+exit:
+    return;
+}
+
+DNSServiceErrorType BrowserMDnsSd::QueryTxt(Instance &aInstance)
+{
+    DNSServiceErrorType error;
+    char                fullName[kDNSServiceMaxDomainName];
+
+    if (aInstance.mQuery != NULL)
+    {
+        DNSServiceRefDeallocate(aInstance.mQuery);
+        aInstance.mQuery = NULL;
+    }
+
+    VerifyOrExit(DNSServiceConstructFullName(fullName, aInstance.mService.mName.c_str(),
+                                             aInstance.mService.mType.c_str(),
+                                             aInstance.mService.mDomain.c_str()) == 0,
+                 error = kDNSServiceErr_BadParam);
+
+    aInstance.mQuery = mConnection;
+    error = DNSServiceQueryRecord(&aInstance.mQuery, kDNSServiceFlagsShareConnection, aInstance.mInterface, fullName,
+                                  kDNSServiceType_TXT, kDNSServiceClass_IN, HandleQueryResult, this);
+
+    if (error != kDNSServiceErr_NoError)
+    {
+        aInstance.mQuery = NULL;
+    }
+
+exit:
+    return error;
+}
+
+void BrowserMDnsSd::HandleQueryResult(DNSServiceRef       aServiceRef,
+                                      DNSServiceFlags     aFlags,
+                                      uint32_t            aInterface,
+                                      DNSServiceErrorType aError,
+                                      const char *        aFullName,
+                                      uint16_t            aType,
+                                      uint16_t            aClass,
+                                      uint16_t            aDataLength,
+                                      const void *        aData,
+                                      uint32_t            aTtl,
+                                      void *              aContext)
+{
+    (void)aInterface;
+    (void)aFullName;
+    (void)aType;
+    (void)aClass;
+
+    static_cast<BrowserMDnsSd *>(aContext)->HandleQueryResult(aServiceRef, aFlags, aError, aDataLength, aData, aTtl);
+}
+
+void BrowserMDnsSd::HandleQueryResult(DNSServiceRef       aServiceRef,
+                                      DNSServiceFlags     aFlags,
+                                      DNSServiceErrorType aError,
+                                      uint16_t            aDataLength,
+                                      const void *        aData,
+                                      uint32_t            aTtl)
+{
+    Instances::iterator it = FindInstance(aServiceRef);
+
+    VerifyOrExit(it != mInstances.end());
+    VerifyOrExit(aError == kDNSServiceErr_NoError, otbrLog(OTBR_LOG_WARNING, "Failed to query service %s: %s!",
+                                                           it->mService.mName.c_str(), DNSErrorToString(aError)));
+
+    // A changed text record is reported as the old one removed and the new one added, the service itself is removed
+    // by browsing or by expiring.
+    VerifyOrExit(aFlags & kDNSServiceFlagsAdd);
+
+    VerifyOrExit(DecodeTxtData(static_cast<const uint8_t *>(aData), aDataLength, it->mService.mTxtList) ==
+                     OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_WARNING, "Bad text record of service %s", it->mService.mName.c_str()));
+
+    UpdateInstance(*it, aTtl);
+
+exit:
+    return;
+}
+
+void BrowserMDnsSd::UpdateInstance(Instance &aInstance, uint32_t aTtl)
+{
+    uint32_t ttl = aTtl < ServiceCache::kMaxTtl ? aTtl : static_cast<uint32_t>(ServiceCache::kMaxTtl);
+
+    aInstance.mRefreshTime = GetNow() + ttl * 10UL * kRefreshPercent;
+    mCache.Update(aInstance.mService, aInstance.mInterface, ttl);
+}
+
+void BrowserMDnsSd::ScheduleTimer(void)
+{
+    unsigned long now = GetNow();
+    timeval       timeout;
+    unsigned long delay;
+
+    // Later than any refresh or expiry, as TTLs are cut to kMaxTtl.
+    timeout.tv_sec  = ServiceCache::kMaxTtl + 1;
+    timeout.tv_usec = 0;
+
+    for (Instances::const_iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        unsigned long refresh;
+
+        if (it->mQuery == NULL)
+        {
+            continue;
+        }
+
+        refresh = static_cast<long>(it->mRefreshTime - now) > 0 ? it->mRefreshTime - now : 0;
+
+        if (static_cast<unsigned long>(timeout.tv_sec) * 1000 + static_cast<unsigned long>(timeout.tv_usec) / 1000 >
+            refresh)
+        {
+            timeout.tv_sec  = static_cast<time_t>(refresh / 1000);
+            timeout.tv_usec = static_cast<suseconds_t>((refresh % 1000) * 1000);
+        }
+    }
+
+    mCache.UpdateTimeout(timeout);
+
+    VerifyOrExit(timeout.tv_sec <= ServiceCache::kMaxTtl, mEventLoop.StopTimer(mTimer));
+
+    delay = static_cast<unsigned long>(timeout.tv_sec) * 1000 + static_cast<unsigned long>(timeout.tv_usec) / 1000;
+
+    // Only re-armed when the earliest refresh or expiry moved.
+    if (!mTimer.IsRunning() || mTimer.GetFireTime() != now + delay)
+    {
+        mEventLoop.StartTimer(mTimer, delay);
+    }
+
+exit:
+    return;
+}
+
+void BrowserMDnsSd::HandleIo(void *aContext, int aFd, unsigned int aEvents)
+{
+    BrowserMDnsSd *     browser = static_cast<BrowserMDnsSd *>(aContext);
+    DNSServiceErrorType error;
+
+    (void)aFd;
+    (void)aEvents;
+
+    error = DNSServiceProcessResult(browser->mConnection);
+
+    if (error != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_WARNING, "DNSServiceProcessResult failed: %s", DNSErrorToString(error));
+    }
+
+    // Results may have refreshed, added or removed instances, or stopped browsing.
+    if (browser->mConnection != NULL)
+    {
+        browser->ScheduleTimer();
+    }
+}
+
+void BrowserMDnsSd::HandleTimer(void *aContext)
+{
+    static_cast<BrowserMDnsSd *>(aContext)->HandleTimer();
+}
+
+void BrowserMDnsSd::HandleTimer(void)
+{
+    unsigned long now = GetNow();
+
+    for (Instances::iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        // Answered from the cache of mDNSResponder if the record is still alive, which refreshes the entry.
+        if (it->mQuery != NULL && static_cast<long>(now - it->mRefreshTime) >= 0)
+        {
+            it->mRefreshTime = now + ServiceCache::kDefaultTtl * 1000UL;
+
+            if (QueryTxt(*it) != kDNSServiceErr_NoError)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Failed to query text record of service %s", it->mService.mName.c_str());
+            }
+        }
+    }
+
+    mCache.Expire();
+    ScheduleTimer();
+}
+
+Browser *Browser::Create(EventLoop &   aEventLoop,
+                         int           aProtocol,
+                         const char *  aType,
+                         const char *  aDomain,
+                         ServiceCache &aCache)
+{
+    return new BrowserMDnsSd(aEventLoop, aProtocol, aType, aDomain, aCache);
+}
+
+void Browser::Destroy(Browser *aBrowser)
+{
+    delete static_cast<BrowserMDnsSd *>(aBrowser);
+}
+
 } // namespace Mdns
 
 } // namespace BorderRouter
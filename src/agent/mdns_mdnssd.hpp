@@ -35,9 +35,11 @@
 #define MDNS_MDNSSD_HPP_
 
 #include <dns_sd.h>
+#include <string>
 #include <vector>
 
 #include "mdns.hpp"
+#include "mdns_cache.hpp"
 #include "common/types.hpp"
 
 namespace ot {
@@ -56,6 +58,7 @@ public:
     /**
      * The constructor to initialize a Publisher.
      *
+     * @param[in]   aEventLoop          A reference to the event loop.
      * @param[in]   aProtocol           The protocol used for publishing. IPv4, IPv6 or both.
      * @param[in]   aHost               The name of host residing the services to be published.
                                         NULL to use default.
@@ -64,7 +67,12 @@ public:
      * @param[in]   aContext            A pointer to application-specific context.
      *
      */
-    PublisherMDnsSd(int aProtocol, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext);
+    PublisherMDnsSd(EventLoop &  aEventLoop,
+                    int          aProtocol,
+                    const char * aHost,
+                    const char * aDomain,
+                    StateHandler aHandler,
+                    void *       aContext);
 
     ~PublisherMDnsSd(void);
 
@@ -85,6 +93,35 @@ public:
      */
     otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...);
 
+    /**
+     * This method publishes or updates a list of services.
+     *
+     * All the services are registered over one connection to mDNSResponder, with kDNSServiceFlagsShareConnection.
+     *
+     * @param[in]   aServices           The services to publish.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully published or updated all the services.
+     * @retval  OTBR_ERROR_MDNS     Failed to publish or update some of the services.
+     *
+     */
+    otbrError PublishServices(const ServiceList &aServices);
+
+    /**
+     * This method renames a published service, keeping its port and text record.
+     *
+     * The service is registered again with the new name right away, other services are not affected.
+     *
+     * @param[in]   aType               The type of this service.
+     * @param[in]   aOldName            The current name of this service.
+     * @param[in]   aNewName            The new name of this service.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully renamed the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to rename the service.
+     * @retval  OTBR_ERROR_MDNS     Failed to register the service with the new name.
+     *
+     */
+    otbrError RenameService(const char *aType, const char *aOldName, const char *aNewName);
+
     /**
      * This method starts the MDNS service.
      *
@@ -109,31 +146,39 @@ public:
      */
     void Stop(void);
 
-    /**
-     * This method performs avahi poll processing.
-     *
-     * @param[in]   aReadFdSet          A reference to read file descriptors.
-     * @param[in]   aWriteFdSet         A reference to write file descriptors.
-     * @param[in]   aErrorFdSet         A reference to error file descriptors.
-     *
-     */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+private:
+    enum
+    {
+        kMaxSizeOfTxtRecord   = 128,
+        kMaxSizeOfServiceName = kDNSServiceMaxServiceName,
+        kMaxSizeOfHost        = 128,
+        kMaxSizeOfDomain      = kDNSServiceMaxDomainName,
+        kMaxSizeOfServiceType = 64,
+        kMaxTextRecordSize    = 255,
+    };
 
-    /**
-     * This method updates the fd_set and timeout for mainloop.
-     *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the max file descriptor.
-     * @param[inout]    aTimeout        A reference to the timeout.
-     *
-     */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+    struct Service
+    {
+        char          mName[kMaxSizeOfServiceName];
+        char          mType[kMaxSizeOfServiceType];
+        DNSServiceRef mService;                  ///< The registration sharing mConnection.
+        uint16_t      mPort;                     ///< The port number in network byte order.
+        uint8_t       mTxt[kMaxSizeOfTxtRecord]; ///< The text record, kept for registering again on renaming.
+        uint16_t      mTxtLength;                ///< The length of mTxt.
+        bool          mRegistering;              ///< Whether the registration is not yet confirmed.
+    };
 
-private:
-    void DiscardService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
-    void RecordService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
+    typedef std::vector<Service> Services;
+
+    otbrError           PublishService(const ServiceInfo &aInfo);
+    DNSServiceErrorType RegisterService(Service &aService);
+    void                FinishRegistration(void);
+    Service *           FindService(const char *aName, const char *aType);
+    Services::iterator  FindService(DNSServiceRef aServiceRef);
+    void                DiscardService(DNSServiceRef aServiceRef);
+    void                RecordService(DNSServiceRef aServiceRef);
+
+    static void HandleIo(void *aContext, int aFd, unsigned int aEvents);
 
     static void HandleServiceRegisterResult(DNSServiceRef         aService,
                                             const DNSServiceFlags aFlags,
@@ -149,31 +194,155 @@ private:
                                             const char *          aType,
                                             const char *          aDomain);
 
+    EventLoop &   mEventLoop;
+    Services      mServices;
+    DNSServiceRef mConnection;    ///< The connection to mDNSResponder shared by all the services.
+    size_t        mPendingCount;    ///< Number of registrations not yet confirmed.
+    size_t        mRegisteredCount; ///< Number of registrations confirmed since mRegisterStart.
+    unsigned long mRegisterStart;   ///< The time when mPendingCount became non-zero, in milliseconds.
+    const char *  mHost;
+    const char *  mDomain;
+    State         mState;
+    StateHandler  mStateHandler;
+    void *        mContext;
+};
+
+/**
+ * This class implements MDNS browser with mDNSResponder.
+ *
+ * Browsing, resolving and querying share one connection to mDNSResponder. Each service found is resolved once, then
+ * its text record is queried for updates and its TTL. The query is issued again at 80 percent of the TTL, which is
+ * answered from the cache of mDNSResponder while the records are alive, so a service expires from the cache if its
+ * records are not refreshed. One timer of the event loop is kept at the earliest refresh or expiry.
+ *
+ */
+class BrowserMDnsSd : public Browser
+{
+public:
+    /**
+     * The constructor to initialize a Browser.
+     *
+     * @param[in]   aEventLoop          A reference to the event loop.
+     * @param[in]   aProtocol           The protocol to browse on, mDNSResponder always browses both.
+     * @param[in]   aType               The type of services to browse.
+     * @param[in]   aDomain             The domain to browse in. NULL to use default.
+     * @param[in]   aCache              A reference to the cache to keep discovered services.
+     *
+     */
+    BrowserMDnsSd(EventLoop &aEventLoop, int aProtocol, const char *aType, const char *aDomain, ServiceCache &aCache);
+
+    ~BrowserMDnsSd(void);
+
+    /**
+     * This method starts browsing.
+     *
+     * @retval OTBR_ERROR_NONE  Successfully started browsing.
+     * @retval OTBR_ERROR_MDNS  Failed to connect to mDNSResponder or to browse.
+     *
+     */
+    otbrError Start(void);
+
+    /**
+     * This method stops browsing, and removes all the services from the cache.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method checks if browser has been started.
+     *
+     * @retval true     Already started.
+     * @retval false    Not started.
+     *
+     */
+    bool IsStarted(void) const;
+
+private:
     enum
     {
-        kMaxSizeOfTxtRecord   = 128,
-        kMaxSizeOfServiceName = kDNSServiceMaxServiceName,
-        kMaxSizeOfHost        = 128,
-        kMaxSizeOfDomain      = kDNSServiceMaxDomainName,
-        kMaxSizeOfServiceType = 64,
-        kMaxTextRecordSize    = 255,
+        kRefreshPercent = 80, ///< Percentage of the TTL after which the text record is queried again.
     };
 
-    struct Service
+    struct Instance
     {
-        char          mName[kMaxSizeOfServiceName];
-        char          mType[kMaxSizeOfServiceType];
-        DNSServiceRef mService;
+        DiscoveredService mService;
+        uint32_t          mInterface;   ///< The interface this instance is found on.
+        DNSServiceRef     mResolve;     ///< The resolve sharing mConnection, NULL once resolved.
+        DNSServiceRef     mQuery;       ///< The text record query sharing mConnection, NULL until resolved.
+        unsigned long     mRefreshTime; ///< The time to query the text record again, in milliseconds.
     };
 
-    typedef std::vector<Service> Services;
+    typedef std::vector<Instance> Instances;
+
+    Instances::iterator FindInstance(const char *aName, uint32_t aInterface);
+    Instances::iterator FindInstance(DNSServiceRef aServiceRef);
+    void                FreeInstance(Instance &aInstance);
+    DNSServiceErrorType QueryTxt(Instance &aInstance);
+    void                UpdateInstance(Instance &aInstance, uint32_t aTtl);
+    void                ScheduleTimer(void);
+
+    static void HandleIo(void *aContext, int aFd, unsigned int aEvents);
+    static void HandleTimer(void *aContext);
+    void        HandleTimer(void);
+
+    static void HandleBrowseResult(DNSServiceRef       aServiceRef,
+                                   DNSServiceFlags     aFlags,
+                                   uint32_t            aInterface,
+                                   DNSServiceErrorType aError,
+                                   const char *        aName,
+                                   const char *        aType,
+                                   const char *        aDomain,
+                                   void *              aContext);
+    void        HandleBrowseResult(DNSServiceFlags     aFlags,
+                                   uint32_t            aInterface,
+                                   DNSServiceErrorType aError,
+                                   const char *        aName,
+                                   const char *        aType,
+                                   const char *        aDomain);
+
+    static void HandleResolveResult(DNSServiceRef        aServiceRef,
+                                    DNSServiceFlags      aFlags,
+                                    uint32_t             aInterface,
+                                    DNSServiceErrorType  aError,
+                                    const char *         aFullName,
+                                    const char *         aHostName,
+                                    uint16_t             aPort,
+                                    uint16_t             aTxtLength,
+                                    const unsigned char *aTxt,
+                                    void *               aContext);
+    void        HandleResolveResult(DNSServiceRef        aServiceRef,
+                                    DNSServiceErrorType  aError,
+                                    const char *         aHostName,
+                                    uint16_t             aPort,
+                                    uint16_t             aTxtLength,
+                                    const unsigned char *aTxt);
+
+    static void HandleQueryResult(DNSServiceRef       aServiceRef,
+                                  DNSServiceFlags     aFlags,
+                                  uint32_t            aInterface,
+                                  DNSServiceErrorType aError,
+                                  const char *        aFullName,
+                                  uint16_t            aType,
+                                  uint16_t            aClass,
+                                  uint16_t            aDataLength,
+                                  const void *        aData,
+                                  uint32_t            aTtl,
+                                  void *              aContext);
+    void        HandleQueryResult(DNSServiceRef       aServiceRef,
+                                  DNSServiceFlags     aFlags,
+                                  DNSServiceErrorType aError,
+                                  uint16_t            aDataLength,
+                                  const void *        aData,
+                                  uint32_t            aTtl);
 
-    Services     mServices;
-    const char * mHost;
-    const char * mDomain;
-    State        mState;
-    StateHandler mStateHandler;
-    void *       mContext;
+    EventLoop &      mEventLoop;
+    ServiceCache &   mCache;
+    Instances        mInstances;
+    DNSServiceRef    mConnection; ///< The connection to mDNSResponder shared by all the operations.
+    DNSServiceRef    mBrowser;
+    EventLoop::Timer mTimer; ///< Fires when a query is to be refreshed or a cache entry expires.
+    const char *     mType;
+    const char *     mDomain;
 };
 
 /**
@@ -86,6 +86,7 @@ void MdnsMojoPublisher::TearDownMojoThreads(void)
 
 MdnsMojoPublisher::MdnsMojoPublisher(StateHandler aHandler, void *aContext)
     : mConnector(nullptr)
+    , mLastPort(0)
     , mStateHandler(aHandler)
     , mContext(aContext)
     , mStarted(false)
@@ -151,8 +152,14 @@ void MdnsMojoPublisher::StopPublishTask(void)
     {
         mResponder->UnregisterServiceInstance(mLastServiceName, mLastInstanceName, base::DoNothing());
     }
+    for (const auto &instance : mInstances)
+    {
+        mResponder->UnregisterServiceInstance(instance.first, instance.second, base::DoNothing());
+    }
+    mInstances.clear();
     mLastServiceName.clear();
     mLastInstanceName.clear();
+    mLastText.clear();
 }
 
 otbrError MdnsMojoPublisher::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
@@ -178,13 +185,11 @@ exit:
     return err;
 }
 
-void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort,
-                                           const std::string &             aType,
-                                           const std::string &             aInstanceName,
-                                           const std::vector<std::string> &aText)
+bool MdnsMojoPublisher::SplitServiceType(const std::string &aType,
+                                         std::string &      aServiceName,
+                                         std::string &      aServiceProtocol)
 {
-    std::string            serviceName;
-    std::string            serviceProtocol;
+    bool                   ret   = false;
     std::string::size_type split = aType.rfind('.');
 
     // Remove the last trailing dot since the cast mdns will add one
@@ -195,16 +200,30 @@ void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort
 
     VerifyOrExit(split != std::string::npos);
 
-    serviceName     = aType.substr(0, split);
-    serviceProtocol = aType.substr(split + 1, std::string::npos);
+    aServiceName     = aType.substr(0, split);
+    aServiceProtocol = aType.substr(split + 1, std::string::npos);
 
     // Remove the last trailing dot since the cast mdns will add one
-    if (serviceProtocol.back() == '.')
+    if (aServiceProtocol.back() == '.')
     {
-        serviceProtocol.erase(serviceProtocol.size() - 1);
+        aServiceProtocol.erase(aServiceProtocol.size() - 1);
     }
 
-    VerifyOrExit(!serviceName.empty() && !serviceProtocol.empty());
+    ret = !aServiceName.empty() && !aServiceProtocol.empty();
+
+exit:
+    return ret;
+}
+
+void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort,
+                                           const std::string &             aType,
+                                           const std::string &             aInstanceName,
+                                           const std::vector<std::string> &aText)
+{
+    std::string serviceName;
+    std::string serviceProtocol;
+
+    VerifyOrExit(SplitServiceType(aType, serviceName, serviceProtocol));
 
     mResponder->UnregisterServiceInstance(serviceName, aInstanceName, base::DoNothing());
     if (!mLastServiceName.empty())
@@ -220,29 +239,89 @@ void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort
                                         }));
     mLastServiceName  = serviceName;
     mLastInstanceName = aInstanceName;
+    mLastPort         = aPort;
+    mLastText         = aText;
 
 exit:
     return;
 }
 
-void MdnsMojoPublisher::UpdateFdSet(fd_set & aReadFdSet,
-                                    fd_set & aWriteFdSet,
-                                    fd_set & aErrorFdSet,
-                                    int &    aMaxFd,
-                                    timeval &aTimeout)
+otbrError MdnsMojoPublisher::PublishServices(const ServiceList &aServices)
 {
-    (void)aReadFdSet;
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
-    (void)aMaxFd;
-    (void)aTimeout;
+    otbrError err = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mConnector != nullptr, err = OTBR_ERROR_MDNS);
+    mMojoTaskRunner->PostTask(FROM_HERE, base::BindOnce(&MdnsMojoPublisher::PublishServicesTask,
+                                                        base::Unretained(this), aServices));
+
+exit:
+    return err;
 }
 
-void MdnsMojoPublisher::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void MdnsMojoPublisher::PublishServicesTask(const ServiceList &aServices)
 {
-    (void)aReadFdSet;
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
+    auto   start      = std::chrono::steady_clock::now();
+    size_t registered = 0;
+
+    // Unlike PublishServiceTask(), instances published before are kept.
+    for (const ServiceInfo &service : aServices)
+    {
+        std::string              serviceName;
+        std::string              serviceProtocol;
+        std::vector<std::string> text;
+
+        if (!SplitServiceType(service.mType, serviceName, serviceProtocol))
+        {
+            otbrLog(OTBR_LOG_WARNING, "Skip service %s of invalid type %s", service.mName.c_str(),
+                    service.mType.c_str());
+            continue;
+        }
+
+        for (const TxtEntry &entry : service.mTxtList)
+        {
+            text.emplace_back(entry.mName + "=" + std::string(entry.mValue.begin(), entry.mValue.end()));
+        }
+
+        mResponder->UnregisterServiceInstance(serviceName, service.mName, base::DoNothing());
+        mResponder->RegisterServiceInstance(serviceName, serviceProtocol, service.mName, service.mPort, text,
+                                            base::DoNothing());
+        mInstances.emplace_back(serviceName, service.mName);
+        ++registered;
+    }
+
+    otbrLog(OTBR_LOG_INFO, "%zu services requested in %ld us", registered,
+            static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count()));
+}
+
+otbrError MdnsMojoPublisher::RenameService(const char *aType, const char *aOldName, const char *aNewName)
+{
+    otbrError err = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mConnector != nullptr, err = OTBR_ERROR_MDNS);
+    mMojoTaskRunner->PostTask(FROM_HERE, base::BindOnce(&MdnsMojoPublisher::RenameServiceTask, base::Unretained(this),
+                                                        std::string(aType), std::string(aOldName),
+                                                        std::string(aNewName)));
+
+exit:
+    return err;
+}
+
+void MdnsMojoPublisher::RenameServiceTask(const std::string &aType,
+                                          const std::string &aOldName,
+                                          const std::string &aNewName)
+{
+    // Copied since publishing replaces the last text record.
+    std::vector<std::string> text = mLastText;
+
+    VerifyOrExit(mLastInstanceName == aOldName);
+
+    // The instance with the old name is unregistered as the last published one.
+    PublishServiceTask(mLastPort, aType, aNewName, text);
+
+exit:
+    return;
 }
 
 MdnsMojoPublisher::~MdnsMojoPublisher()
@@ -253,8 +332,15 @@ MdnsMojoPublisher::~MdnsMojoPublisher()
     mMojoCoreThread->join();
 }
 
-Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
+Publisher *Publisher::Create(EventLoop &  aEventLoop,
+                             int          aFamily,
+                             const char * aHost,
+                             const char * aDomain,
+                             StateHandler aHandler,
+                             void *       aContext)
 {
+    // Mojo runs on its own threads, nothing is served by the event loop.
+    (void)aEventLoop;
     (void)aFamily;
     (void)aHost;
     (void)aDomain;
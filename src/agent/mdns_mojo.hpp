@@ -49,9 +49,11 @@
 #include <chromecast/external_mojo/external_service_support/external_connector.h>
 #endif
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #ifndef TEST_IN_CHROMIUM
@@ -125,34 +127,30 @@ public:
     otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...) override;
 
     /**
-     * This method performs the MDNS processing.
+     * This method publishes or updates a list of services.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     * All the services are registered in one task on the Mojo thread.
+     *
+     * @param[in]   aServices           The services to publish.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully requested publishing the services.
+     * @retval  OTBR_ERROR_MDNS     Not connected to Mojo.
      *
      */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet) override;
+    otbrError PublishServices(const ServiceList &aServices) override;
 
     /**
-     * This method updates the fd_set and timeout for mainloop.
-     *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling read.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p
-     *                                  aReadFdSet and @p aWriteFdSet.
-     * @param[inout]    aTimeout        A reference to the timeout. Update this
-     *                                  value if the MDNS service has pending
-     *                                  process in less than its current
-     *                                  value.
+     * This method renames a published service, keeping its port and text record.
+     *
+     * @param[in]   aType               The type of this service.
+     * @param[in]   aOldName            The current name of this service.
+     * @param[in]   aNewName            The new name of this service.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully renamed the service.
+     * @retval  OTBR_ERROR_MDNS     Failed to rename the service.
      *
      */
-    void UpdateFdSet(fd_set & aReadFdSet,
-                     fd_set & aWriteFdSet,
-                     fd_set & aErrorFdSet,
-                     int &    aMaxFd,
-                     timeval &aTimeout) override;
+    otbrError RenameService(const char *aType, const char *aOldName, const char *aNewName) override;
 
     ~MdnsMojoPublisher(void) override;
 
@@ -162,8 +160,13 @@ private:
                             const std::string &             aInstanceName,
                             const std::vector<std::string> &aText);
 
+    void PublishServicesTask(const ServiceList &aServices);
+    void RenameServiceTask(const std::string &aType, const std::string &aOldName, const std::string &aNewName);
+
     void StopPublishTask(void);
 
+    static bool SplitServiceType(const std::string &aType, std::string &aServiceName, std::string &aServiceProtocol);
+
     void LaunchMojoThreads(void);
     void TearDownMojoThreads(void);
     void ConnectToMojo(void);
@@ -177,8 +180,12 @@ private:
     std::unique_ptr<MOJO_CONNECTOR_NS::ExternalConnector> mConnector;
     chromecast::mojom::MdnsResponderPtr                   mResponder;
 
-    std::string mLastServiceName;
-    std::string mLastInstanceName;
+    std::string              mLastServiceName;
+    std::string              mLastInstanceName;
+    uint16_t                 mLastPort;
+    std::vector<std::string> mLastText;
+
+    std::vector<std::pair<std::string, std::string>> mInstances; ///< Service name and instance published in bulk.
 
     StateHandler mStateHandler;
     void *       mContext;
@@ -40,12 +40,9 @@
 
 #include <netinet/in.h>
 #include <stddef.h>
-#if OTBR_ENABLE_NCP_WPANTUND
-#include "common/mainloop.h"
-#else
-#include <openthread-system.h>
-#endif
+#include <stdint.h>
 #include "common/event_emitter.hpp"
+#include "common/event_loop.hpp"
 #include "common/types.hpp"
 
 namespace ot {
@@ -69,28 +66,134 @@ namespace Ncp {
  */
 enum
 {
-    kEventExtPanId,         ///< Extended PAN ID arrived.
-    kEventNetworkName,      ///< Network name arrived.
-    kEventPSKc,             ///< PSKc arrived.
-    kEventThreadState,      ///< Thread State.
-    kEventUdpForwardStream, ///< UDP forward stream arrived.
+    kEventExtPanId,           ///< Extended PAN ID arrived.
+    kEventNetworkName,        ///< Network name arrived.
+    kEventPSKc,               ///< PSKc arrived.
+    kEventThreadState,        ///< Thread State.
+    kEventUdpForwardStream,   ///< UDP forward stream arrived.
+    kEventCommissionerState,  ///< Commissioner state changed.
+    kEventCommissionerResult, ///< Commissioner request handled.
+    kNumEvents,               ///< Number of NCP events.
+};
+
+/**
+ * Commissioner states of the NCP.
+ *
+ */
+enum CommissionerState
+{
+    kCommissionerStateDisabled, ///< Commissioner role is disabled.
+    kCommissionerStatePetition, ///< Petitioning to become the commissioner.
+    kCommissionerStateActive,   ///< Commissioner role is active.
+};
+
+/**
+ * Commissioner requests to the NCP.
+ *
+ */
+enum CommissionerRequest
+{
+    kCommissionerRequestStart,     ///< Controller::CommissionerStart().
+    kCommissionerRequestStop,      ///< Controller::CommissionerStop().
+    kCommissionerRequestAddJoiner, ///< Controller::CommissionerAddJoiner().
+};
+
+enum
+{
+    kMaxEventHandlers = 4, ///< Maximum number of handlers of each NCP event.
+};
+
+/**
+ * This class template declares the handler type of each NCP event.
+ *
+ */
+template <int kEvent> struct EventSignature;
+
+/**
+ * Handler of kEventExtPanId, @p aExtPanId points to the 8-byte extended PAN ID.
+ *
+ */
+template <> struct EventSignature<kEventExtPanId>
+{
+    typedef void (*Handler)(void *aContext, const uint8_t *aExtPanId);
+};
+
+/**
+ * Handler of kEventNetworkName, @p aNetworkName is a null-terminated network name.
+ *
+ */
+template <> struct EventSignature<kEventNetworkName>
+{
+    typedef void (*Handler)(void *aContext, const char *aNetworkName);
+};
+
+/**
+ * Handler of kEventPSKc, @p aPSKc points to the PSKc of kSizePSKc bytes.
+ *
+ */
+template <> struct EventSignature<kEventPSKc>
+{
+    typedef void (*Handler)(void *aContext, const uint8_t *aPSKc);
+};
+
+/**
+ * Handler of kEventThreadState, @p aStarted tells whether Thread is attached.
+ *
+ */
+template <> struct EventSignature<kEventThreadState>
+{
+    typedef void (*Handler)(void *aContext, bool aStarted);
+};
+
+/**
+ * Handler of kEventUdpForwardStream, @p aBuffer is only valid during the call.
+ *
+ */
+template <> struct EventSignature<kEventUdpForwardStream>
+{
+    typedef void (*Handler)(void *          aContext,
+                            const uint8_t * aBuffer,
+                            uint16_t        aLength,
+                            uint16_t        aPeerPort,
+                            const in6_addr &aPeerAddr,
+                            uint16_t        aSockPort);
+};
+
+/**
+ * Handler of kEventCommissionerState, @p aState is the state of the commissioner role of the NCP.
+ *
+ */
+template <> struct EventSignature<kEventCommissionerState>
+{
+    typedef void (*Handler)(void *aContext, CommissionerState aState);
+};
+
+/**
+ * Handler of kEventCommissionerResult, @p aError is 0 if the NCP accepted @p aRequest, or an errno value.
+ *
+ */
+template <> struct EventSignature<kEventCommissionerResult>
+{
+    typedef void (*Handler)(void *aContext, CommissionerRequest aRequest, int aError);
 };
 
 /**
  * This interface defines NCP Controller functionality.
  *
  */
-class Controller : public EventEmitter
+class Controller : public EventEmitter<EventSignature, kNumEvents, kMaxEventHandlers>
 {
 public:
     /**
-     * This method initalize the NCP controller.
+     * This method initalize the NCP controller, which is then served by the event loop.
+     *
+     * @param[in]   aEventLoop  A reference to the event loop.
      *
      * @retval  OTBR_ERROR_NONE     Successfully initialized NCP controller.
      * @retval  OTBR_ERROR_DBUS     Failed due to dbus error.
      *
      */
-    virtual otbrError Init(void) = 0;
+    virtual otbrError Init(EventLoop &aEventLoop) = 0;
 
 #if OTBR_ENABLE_NCP_WPANTUND
     /**
@@ -108,24 +211,51 @@ public:
 #endif // OTBR_ENABLE_NCP_WPANTUND
 
     /**
-     * This method updates the fd_set to poll.
+     * This method enables the commissioner role of the NCP.
      *
-     * @param[inout]    aMainloop   A reference to OpenThread mainloop context.
+     * The NCP petitions and keeps the session alive on its own, changes of state are emitted as
+     * kEventCommissionerState.
+     *
+     * Once the request is sent, whether the NCP accepted it is emitted as kEventCommissionerResult, which may be
+     * before this method returns. Results of the commissioner requests are emitted in the order of the requests.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully requested the commissioner role.
+     * @retval  OTBR_ERROR_ERRNO        Failed to request the commissioner role, error info in errno.
      *
      */
-    virtual void UpdateFdSet(otSysMainloopContext &aMainloop) = 0;
+    virtual otbrError CommissionerStart(void) = 0;
 
     /**
-     * This method performs the DTLS processing.
+     * This method disables the commissioner role of the NCP, which resigns from the leader.
+     *
+     * Once the request is sent, its result is emitted as kEventCommissionerResult.
      *
-     * @param[in]       aMainloop   A reference to OpenThread mainloop context.
+     * @retval  OTBR_ERROR_NONE         Successfully requested to disable the commissioner role.
+     * @retval  OTBR_ERROR_ERRNO        Failed to disable the commissioner role, error info in errno.
      *
      */
-    virtual void Process(const otSysMainloopContext &aMainloop) = 0;
+    virtual otbrError CommissionerStop(void) = 0;
+
+    /**
+     * This method allows a joiner to be commissioned by the NCP.
+     *
+     * Once the request is sent, its result is emitted as kEventCommissionerResult.
+     *
+     * @param[in]   aEui64      A pointer to the EUI-64 of the joiner, NULL for any joiner.
+     * @param[in]   aPskd       A null-terminated PSKd of the joiner.
+     * @param[in]   aTimeout    Seconds after which the joiner is removed.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully added the joiner.
+     * @retval  OTBR_ERROR_ERRNO        Failed to add the joiner, error info in errno.
+     *
+     */
+    virtual otbrError CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout) = 0;
 
     /**
      * This method request the event.
      *
+     * The event may be emitted after this method returns.
+     *
      * @param[in]   aEvent  The event id to request.
      *
      * @retval  OTBR_ERROR_NONE         Successfully requested the event.
@@ -134,6 +264,36 @@ public:
      */
     virtual otbrError RequestEvent(int aEvent) = 0;
 
+    /**
+     * This method requests several events at once.
+     *
+     * All requests are issued before any reply is processed, so an asynchronous controller has them in flight
+     * together.
+     *
+     * @param[in]   aEvents     A pointer to the event ids to request.
+     * @param[in]   aCount      The number of event ids in @p aEvents.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully requested all events.
+     * @retval  OTBR_ERROR_ERRNO        Failed to request at least one event.
+     *
+     */
+    otbrError RequestEvents(const int *aEvents, size_t aCount)
+    {
+        otbrError ret = OTBR_ERROR_NONE;
+
+        for (size_t i = 0; i < aCount; ++i)
+        {
+            otbrError error = RequestEvent(aEvents[i]);
+
+            if (ret == OTBR_ERROR_NONE)
+            {
+                ret = error;
+            }
+        }
+
+        return ret;
+    }
+
     /**
      * This method creates a NCP Controller.
      *
@@ -29,7 +29,9 @@
 #include "ncp_openthread.hpp"
 
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <openthread/cli.h>
 #include <openthread/dataset.h>
@@ -63,11 +65,12 @@ ControllerOpenThread::~ControllerOpenThread(void)
     otInstanceFinalize(mInstance);
 }
 
-otbrError ControllerOpenThread::Init(void)
+otbrError ControllerOpenThread::Init(EventLoop &aEventLoop)
 {
     otSysInitNetif(mInstance);
     otCliUartInit(mInstance);
     otSetStateChangedCallback(mInstance, &ControllerOpenThread::HandleStateChanged, this);
+    aEventLoop.AddProcessor(*this);
 
     return OTBR_ERROR_NONE;
 }
@@ -76,12 +79,12 @@ void ControllerOpenThread::HandleStateChanged(otChangedFlags aFlags)
 {
     if (aFlags | OT_CHANGED_THREAD_NETWORK_NAME)
     {
-        EventEmitter::Emit(kEventNetworkName, otThreadGetNetworkName(mInstance));
+        Emit<kEventNetworkName>(otThreadGetNetworkName(mInstance));
     }
 
     if (aFlags | OT_CHANGED_THREAD_EXT_PANID)
     {
-        EventEmitter::Emit(kEventExtPanId, otThreadGetExtendedPanId(mInstance));
+        Emit<kEventExtPanId>(otThreadGetExtendedPanId(mInstance)->m8);
     }
 
     if (aFlags | OT_CHANGED_THREAD_ROLE)
@@ -99,10 +102,96 @@ void ControllerOpenThread::HandleStateChanged(otChangedFlags aFlags)
             break;
         }
 
-        EventEmitter::Emit(kEventThreadState, attached);
+        Emit<kEventThreadState>(attached);
     }
 }
 
+static otbrError OtbrErrorFromOt(otError aError)
+{
+    otbrError ret = OTBR_ERROR_ERRNO;
+
+    switch (aError)
+    {
+    case OT_ERROR_NONE:
+        ret = OTBR_ERROR_NONE;
+        break;
+    case OT_ERROR_INVALID_ARGS:
+        errno = EINVAL;
+        break;
+    case OT_ERROR_NO_BUFS:
+        errno = ENOBUFS;
+        break;
+    case OT_ERROR_INVALID_STATE:
+        errno = EBUSY;
+        break;
+    default:
+        errno = EIO;
+        break;
+    }
+
+    return ret;
+}
+
+otbrError ControllerOpenThread::CommissionerStart(void)
+{
+    otError error = otCommissionerStart(mInstance, &ControllerOpenThread::HandleCommissionerState, NULL, this);
+
+    // Starting an active commissioner is not an error.
+    return HandleCommissionerResult(kCommissionerRequestStart, error == OT_ERROR_INVALID_STATE ? OT_ERROR_NONE : error);
+}
+
+otbrError ControllerOpenThread::CommissionerStop(void)
+{
+    otError error = otCommissionerStop(mInstance);
+
+    return HandleCommissionerResult(kCommissionerRequestStop, error == OT_ERROR_INVALID_STATE ? OT_ERROR_NONE : error);
+}
+
+otbrError ControllerOpenThread::CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout)
+{
+    otExtAddress eui64;
+
+    if (aEui64 != NULL)
+    {
+        memcpy(eui64.m8, aEui64, sizeof(eui64.m8));
+    }
+
+    return HandleCommissionerResult(kCommissionerRequestAddJoiner,
+                                    otCommissionerAddJoiner(mInstance, aEui64 ? &eui64 : NULL, aPskd, aTimeout));
+}
+
+otbrError ControllerOpenThread::HandleCommissionerResult(CommissionerRequest aRequest, otError aError)
+{
+    otbrError ret = OtbrErrorFromOt(aError);
+
+    // Requests are handled at once, so only those accepted are reported.
+    if (ret == OTBR_ERROR_NONE)
+    {
+        Emit<kEventCommissionerResult>(aRequest, 0);
+    }
+
+    return ret;
+}
+
+void ControllerOpenThread::HandleCommissionerState(otCommissionerState aState)
+{
+    CommissionerState state = kCommissionerStateDisabled;
+
+    switch (aState)
+    {
+    case OT_COMMISSIONER_STATE_PETITION:
+        state = kCommissionerStatePetition;
+        break;
+    case OT_COMMISSIONER_STATE_ACTIVE:
+        state = kCommissionerStateActive;
+        break;
+    default:
+        break;
+    }
+
+    Emit<kEventCommissionerState>(state);
+}
+
 void ControllerOpenThread::UpdateFdSet(otSysMainloopContext &aMainloop)
 {
     if (otTaskletsArePending(mInstance))
@@ -129,7 +218,7 @@ otbrError ControllerOpenThread::RequestEvent(int aEvent)
     {
     case kEventExtPanId:
     {
-        EventEmitter::Emit(kEventExtPanId, otThreadGetExtendedPanId(mInstance));
+        Emit<kEventExtPanId>(otThreadGetExtendedPanId(mInstance)->m8);
         break;
     }
     case kEventThreadState:
@@ -147,17 +236,22 @@ otbrError ControllerOpenThread::RequestEvent(int aEvent)
             break;
         }
 
-        EventEmitter::Emit(kEventThreadState, attached);
+        Emit<kEventThreadState>(attached);
         break;
     }
     case kEventNetworkName:
     {
-        EventEmitter::Emit(kEventNetworkName, otThreadGetNetworkName(mInstance));
+        Emit<kEventNetworkName>(otThreadGetNetworkName(mInstance));
         break;
     }
     case kEventPSKc:
     {
-        EventEmitter::Emit(kEventPSKc, otThreadGetPSKc(mInstance));
+        Emit<kEventPSKc>(otThreadGetPSKc(mInstance)->m8);
+        break;
+    }
+    case kEventCommissionerState:
+    {
+        HandleCommissionerState(otCommissionerGetState(mInstance));
         break;
     }
     default:
@@ -38,6 +38,8 @@
 
 #if OTBR_ENABLE_NCP_OPENTHREAD
 
+#include <openthread/commissioner.h>
+
 namespace ot {
 
 namespace BorderRouter {
@@ -48,7 +50,7 @@ namespace Ncp {
  * This interface defines NCP Controller functionality.
  *
  */
-class ControllerOpenThread : public Controller
+class ControllerOpenThread : public Controller, public MainloopProcessor
 {
 public:
     /**
@@ -64,10 +66,46 @@ public:
     /**
      * This method initalize the NCP controller.
      *
+     * The posix platform of OpenThread only polls through the select() style mainloop context, so the controller is
+     * added to @p aEventLoop as a processor.
+     *
+     * @param[in]   aEventLoop  A reference to the event loop.
+     *
      * @retval  OTBR_ERROR_NONE     Successfully initialized NCP controller.
      *
      */
-    virtual otbrError Init(void);
+    virtual otbrError Init(EventLoop &aEventLoop);
+
+    /**
+     * This method enables the commissioner role of OpenThread.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully started the commissioner role.
+     * @retval  OTBR_ERROR_ERRNO        Failed to start the commissioner role, error info in errno.
+     *
+     */
+    virtual otbrError CommissionerStart(void);
+
+    /**
+     * This method disables the commissioner role of OpenThread.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully stopped the commissioner role.
+     * @retval  OTBR_ERROR_ERRNO        Failed to stop the commissioner role, error info in errno.
+     *
+     */
+    virtual otbrError CommissionerStop(void);
+
+    /**
+     * This method allows a joiner to be commissioned by OpenThread.
+     *
+     * @param[in]   aEui64      A pointer to the EUI-64 of the joiner, NULL for any joiner.
+     * @param[in]   aPskd       A null-terminated PSKd of the joiner.
+     * @param[in]   aTimeout    Seconds after which the joiner is removed.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully added the joiner.
+     * @retval  OTBR_ERROR_ERRNO        Failed to add the joiner, error info in errno.
+     *
+     */
+    virtual otbrError CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout);
 
     /**
      * This method updates the fd_set to poll.
@@ -78,7 +116,7 @@ public:
     virtual void UpdateFdSet(otSysMainloopContext &aMainloop);
 
     /**
-     * This method performs the DTLS processing.
+     * This method performs the OpenThread processing.
      *
      * @param[in]       aMainloop   A reference to OpenThread mainloop context.
      *
@@ -105,6 +143,13 @@ private:
     }
     void HandleStateChanged(otChangedFlags aFlags);
 
+    static void HandleCommissionerState(otCommissionerState aState, void *aContext)
+    {
+        static_cast<ControllerOpenThread *>(aContext)->HandleCommissionerState(aState);
+    }
+    void      HandleCommissionerState(otCommissionerState aState);
+    otbrError HandleCommissionerResult(CommissionerRequest aRequest, otError aError);
+
     otInstance *mInstance;
 };
 
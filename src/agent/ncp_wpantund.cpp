@@ -28,8 +28,6 @@
 
 #include "ncp_wpantund.hpp"
 
-#include <vector>
-
 #include <assert.h>
 #include <errno.h>
 #include <stdio.h>
@@ -89,7 +87,16 @@ DBusHandlerResult ControllerWpantund::HandlePropertyChangedSignal(DBusMessage &a
         // DBus name of the interface has changed, possibly caused by wpantund restarted,
         // We have to restart the border agent.
         otbrLog(OTBR_LOG_WARNING, "NCP DBus name changed.");
+        AbortCommissionerCalls(ECONNRESET);
+        CancelPendingCalls();
         SuccessOrExit(UpdateInterfaceDBusPath());
+
+        {
+            const int events[] = {kEventNetworkName, kEventExtPanId, kEventThreadState, kEventPSKc};
+
+            // Refresh all cached properties in a single round trip.
+            RequestEvents(events, sizeof(events) / sizeof(events[0]));
+        }
     }
 
     VerifyOrExit(dbus_message_is_signal(&aMessage, WPANTUND_DBUS_APIv1_INTERFACE, WPANTUND_IF_SIGNAL_PROP_CHANGED),
@@ -123,7 +130,7 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
         dbus_message_iter_get_fixed_array(&subIter, &pskc, &count);
         VerifyOrExit(count == kSizePSKc, ret = OTBR_ERROR_DBUS);
 
-        EventEmitter::Emit(kEventPSKc, pskc);
+        Emit<kEventPSKc>(pskc);
     }
     else if (!strcmp(aKey, kWPANTUNDProperty_UdpForwardStream))
     {
@@ -139,6 +146,7 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
 
             dbus_message_iter_recurse(aIter, &sub_iter);
             dbus_message_iter_get_fixed_array(&sub_iter, &buf, &nelements);
+            VerifyOrExit(nelements >= kSizeOfUdpForwardTrailer, ret = OTBR_ERROR_DBUS);
             len = static_cast<uint16_t>(nelements);
         }
 
@@ -150,7 +158,8 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
         peerPort = buf[--len];
         peerPort |= buf[--len] << 8;
 
-        EventEmitter::Emit(kEventUdpForwardStream, buf, len, peerPort, &peerAddr, sockPort);
+        // The payload is borrowed from the DBus message, which outlives the emit.
+        Emit<kEventUdpForwardStream>(buf, len, peerPort, peerAddr, sockPort);
     }
     else if (!strcmp(aKey, kWPANTUNDProperty_NCPState))
     {
@@ -159,7 +168,7 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
 
         otbrLog(OTBR_LOG_INFO, "state %s", state);
 
-        EventEmitter::Emit(kEventThreadState, 0 == strcmp(state, "associated"));
+        Emit<kEventThreadState>(0 == strcmp(state, "associated"));
     }
     else if (!strcmp(aKey, kWPANTUNDProperty_NetworkName))
     {
@@ -167,7 +176,7 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
         dbus_message_iter_get_basic(aIter, &networkName);
 
         otbrLog(OTBR_LOG_INFO, "network name %s...", networkName);
-        EventEmitter::Emit(kEventNetworkName, networkName);
+        Emit<kEventNetworkName>(networkName);
     }
     else if (!strcmp(aKey, kWPANTUNDProperty_NetworkXPANID))
     {
@@ -200,7 +209,27 @@ otbrError ControllerWpantund::ParseEvent(const char *aKey, DBusMessageIter *aIte
             ExitNow(ret = OTBR_ERROR_DBUS);
         }
 
-        EventEmitter::Emit(kEventExtPanId, reinterpret_cast<uint8_t *>(&xpanid));
+        Emit<kEventExtPanId>(reinterpret_cast<const uint8_t *>(&xpanid));
+    }
+    else if (!strcmp(aKey, kWPANTUNDProperty_CommissionerState))
+    {
+        const char *      state             = NULL;
+        CommissionerState commissionerState = kCommissionerStateDisabled;
+
+        VerifyOrExit(DBUS_TYPE_STRING == dbus_message_iter_get_arg_type(aIter), ret = OTBR_ERROR_DBUS);
+        dbus_message_iter_get_basic(aIter, &state);
+
+        if (!strcmp(state, kWPANTUNDCommissionerState_Petition))
+        {
+            commissionerState = kCommissionerStatePetition;
+        }
+        else if (!strcmp(state, kWPANTUNDCommissionerState_Active))
+        {
+            commissionerState = kCommissionerStateActive;
+        }
+
+        otbrLog(OTBR_LOG_INFO, "commissioner %s", state);
+        Emit<kEventCommissionerState>(commissionerState);
     }
 
 exit:
@@ -209,22 +238,205 @@ exit:
 
 dbus_bool_t ControllerWpantund::AddDBusWatch(struct DBusWatch *aWatch, void *aContext)
 {
-    static_cast<ControllerWpantund *>(aContext)->mWatches[aWatch] = true;
+    ControllerWpantund *controller = static_cast<ControllerWpantund *>(aContext);
+
+    controller->mWatches[aWatch] = (dbus_watch_get_enabled(aWatch) ? true : false);
+    controller->UpdateWatchFd(dbus_watch_get_unix_fd(aWatch));
     return TRUE;
 }
 
 void ControllerWpantund::RemoveDBusWatch(struct DBusWatch *aWatch, void *aContext)
 {
-    static_cast<ControllerWpantund *>(aContext)->mWatches.erase(aWatch);
+    ControllerWpantund *controller = static_cast<ControllerWpantund *>(aContext);
+
+    controller->mWatches.erase(aWatch);
+    controller->UpdateWatchFd(dbus_watch_get_unix_fd(aWatch));
 }
 
 void ControllerWpantund::ToggleDBusWatch(struct DBusWatch *aWatch, void *aContext)
 {
-    static_cast<ControllerWpantund *>(aContext)->mWatches[aWatch] = (dbus_watch_get_enabled(aWatch) ? true : false);
+    ControllerWpantund *controller = static_cast<ControllerWpantund *>(aContext);
+
+    controller->mWatches[aWatch] = (dbus_watch_get_enabled(aWatch) ? true : false);
+    controller->UpdateWatchFd(dbus_watch_get_unix_fd(aWatch));
+}
+
+void ControllerWpantund::UpdateWatchFd(int aFd)
+{
+    unsigned int         events = 0;
+    WatchFdMap::iterator it     = mWatchFds.find(aFd);
+
+    VerifyOrExit(aFd >= 0);
+
+    // libdbus has separate watches for reading and writing the same socket, which share one registration.
+    for (WatchMap::const_iterator watch = mWatches.begin(); watch != mWatches.end(); ++watch)
+    {
+        unsigned int flags;
+
+        if (!watch->second || dbus_watch_get_unix_fd(watch->first) != aFd)
+        {
+            continue;
+        }
+
+        flags = dbus_watch_get_flags(watch->first);
+        events |= (flags & DBUS_WATCH_READABLE ? EventLoop::kEventReadable : 0);
+        events |= (flags & DBUS_WATCH_WRITABLE ? EventLoop::kEventWritable : 0);
+    }
+
+    if (it == mWatchFds.end())
+    {
+        VerifyOrExit(events != 0);
+        VerifyOrExit(mEventLoop->AddIo(aFd, events, HandleDBusIo, this) == OTBR_ERROR_NONE,
+                     otbrLog(OTBR_LOG_ERR, "NCP failed to watch DBus: %s", strerror(errno)));
+        mWatchFds[aFd] = events;
+    }
+    else if (events == 0)
+    {
+        mEventLoop->RemoveIo(aFd);
+        mWatchFds.erase(it);
+    }
+    else if (events != it->second)
+    {
+        VerifyOrExit(mEventLoop->ModifyIo(aFd, events) == OTBR_ERROR_NONE,
+                     otbrLog(OTBR_LOG_ERR, "NCP failed to watch DBus: %s", strerror(errno)));
+        it->second = events;
+    }
+
+exit:
+    return;
+}
+
+void ControllerWpantund::HandleDBusIo(void *aContext, int aFd, unsigned int aEvents)
+{
+    static_cast<ControllerWpantund *>(aContext)->HandleDBusIo(aFd, aEvents);
+}
+
+void ControllerWpantund::HandleDBusIo(int aFd, unsigned int aEvents)
+{
+    for (WatchMap::iterator it = mWatches.begin(); it != mWatches.end();)
+    {
+        DBusWatch *  watch = it->first;
+        unsigned int flags = dbus_watch_get_flags(watch);
+
+        if (!it->second || dbus_watch_get_unix_fd(watch) != aFd)
+        {
+            ++it;
+            continue;
+        }
+
+        if (!(aEvents & EventLoop::kEventReadable))
+        {
+            flags &= static_cast<unsigned int>(~DBUS_WATCH_READABLE);
+        }
+
+        if (!(aEvents & EventLoop::kEventWritable))
+        {
+            flags &= static_cast<unsigned int>(~DBUS_WATCH_WRITABLE);
+        }
+
+        if (aEvents & EventLoop::kEventError)
+        {
+            flags |= DBUS_WATCH_ERROR;
+        }
+
+        dbus_watch_handle(watch, flags);
+
+        // The handler may remove watches.
+        it = mWatches.upper_bound(watch);
+    }
+
+    DispatchDBus();
+}
+
+dbus_bool_t ControllerWpantund::AddDBusTimeout(DBusTimeout *aTimeout, void *aContext)
+{
+    ControllerWpantund *controller = static_cast<ControllerWpantund *>(aContext);
+    Timeout *           timeout    = new Timeout(*controller, aTimeout);
+
+    controller->mTimeouts[aTimeout] = timeout;
+
+    if (dbus_timeout_get_enabled(aTimeout))
+    {
+        controller->mEventLoop->StartTimer(timeout->mTimer,
+                                           static_cast<unsigned long>(dbus_timeout_get_interval(aTimeout)));
+    }
+
+    return TRUE;
+}
+
+void ControllerWpantund::RemoveDBusTimeout(DBusTimeout *aTimeout, void *aContext)
+{
+    ControllerWpantund * controller = static_cast<ControllerWpantund *>(aContext);
+    TimeoutMap::iterator it         = controller->mTimeouts.find(aTimeout);
+
+    VerifyOrExit(it != controller->mTimeouts.end());
+
+    controller->mEventLoop->StopTimer(it->second->mTimer);
+    delete it->second;
+    controller->mTimeouts.erase(it);
+
+exit:
+    return;
+}
+
+void ControllerWpantund::ToggleDBusTimeout(DBusTimeout *aTimeout, void *aContext)
+{
+    ControllerWpantund * controller = static_cast<ControllerWpantund *>(aContext);
+    TimeoutMap::iterator it         = controller->mTimeouts.find(aTimeout);
+
+    VerifyOrExit(it != controller->mTimeouts.end());
+
+    // Re-enabled timeouts start a new interval.
+    if (dbus_timeout_get_enabled(aTimeout))
+    {
+        controller->mEventLoop->StartTimer(it->second->mTimer,
+                                           static_cast<unsigned long>(dbus_timeout_get_interval(aTimeout)));
+    }
+    else
+    {
+        controller->mEventLoop->StopTimer(it->second->mTimer);
+    }
+
+exit:
+    return;
+}
+
+void ControllerWpantund::HandleDBusTimeout(void *aContext)
+{
+    Timeout &           timeout    = *static_cast<Timeout *>(aContext);
+    ControllerWpantund &controller = timeout.mController;
+
+    // Re-armed before handling, which may remove the timeout.
+    controller.mEventLoop->StartTimer(timeout.mTimer,
+                                      static_cast<unsigned long>(dbus_timeout_get_interval(timeout.mTimeout)));
+    dbus_timeout_handle(timeout.mTimeout);
+    controller.DispatchDBus();
+}
+
+void ControllerWpantund::DispatchDBus(void)
+{
+    while (DBUS_DISPATCH_DATA_REMAINS == dbus_connection_get_dispatch_status(mDBus) &&
+           dbus_connection_read_write_dispatch(mDBus, 0))
+        ;
+}
+
+void ControllerWpantund::ReleaseDBus(void)
+{
+    VerifyOrExit(mDBus != NULL);
+
+    // The connection is shared, so its watches and timeouts are taken back from the event loop before leaving it.
+    dbus_connection_set_watch_functions(mDBus, NULL, NULL, NULL, NULL, NULL);
+    dbus_connection_set_timeout_functions(mDBus, NULL, NULL, NULL, NULL, NULL);
+    dbus_connection_unref(mDBus);
+    mDBus = NULL;
+
+exit:
+    return;
 }
 
 ControllerWpantund::ControllerWpantund(const char *aInterfaceName)
     : mDBus(NULL)
+    , mEventLoop(NULL)
 {
     mInterfaceDBusName[0] = '\0';
     strcpy_safe(mInterfaceName, sizeof(mInterfaceName), aInterfaceName);
@@ -249,12 +461,13 @@ exit:
     return ret;
 }
 
-otbrError ControllerWpantund::Init(void)
+otbrError ControllerWpantund::Init(EventLoop &aEventLoop)
 {
     otbrError ret = OTBR_ERROR_DBUS;
     DBusError error;
     char      dbusName[DBUS_MAXIMUM_NAME_LENGTH];
 
+    mEventLoop = &aEventLoop;
     dbus_error_init(&error);
     mDBus = dbus_bus_get(DBUS_BUS_SYSTEM, &error);
     VerifyOrExit(mDBus != NULL);
@@ -269,6 +482,10 @@ otbrError ControllerWpantund::Init(void)
     VerifyOrExit(
         dbus_connection_set_watch_functions(mDBus, AddDBusWatch, RemoveDBusWatch, ToggleDBusWatch, this, NULL));
 
+    // Timeouts of pending calls are driven by the event loop.
+    VerifyOrExit(dbus_connection_set_timeout_functions(mDBus, AddDBusTimeout, RemoveDBusTimeout, ToggleDBusTimeout,
+                                                       this, NULL));
+
     dbus_bus_add_match(mDBus, kDBusMatchPropChanged, &error);
     VerifyOrExit(!dbus_error_is_set(&error));
 
@@ -286,11 +503,7 @@ exit:
 
     if (ret)
     {
-        if (mDBus)
-        {
-            dbus_connection_unref(mDBus);
-            mDBus = NULL;
-        }
+        ReleaseDBus();
     }
 
     otbrLogResult("NCP initialize", ret);
@@ -299,11 +512,50 @@ exit:
 
 ControllerWpantund::~ControllerWpantund(void)
 {
-    if (mDBus)
-    {
-        dbus_connection_unref(mDBus);
-        mDBus = NULL;
-    }
+    CancelPendingCalls();
+    ReleaseDBus();
+}
+
+otbrError ControllerWpantund::AppendUdpForwardStream(DBusMessage &   aMessage,
+                                                     const uint8_t * aBuffer,
+                                                     uint16_t        aLength,
+                                                     uint16_t        aPeerPort,
+                                                     const in6_addr &aPeerAddr,
+                                                     uint16_t        aSockPort)
+{
+    otbrError       ret   = OTBR_ERROR_ERRNO;
+    const char *    key   = kWPANTUNDProperty_UdpForwardStream;
+    const uint8_t * value = NULL;
+    uint8_t         trailer[kSizeOfUdpForwardTrailer];
+    DBusMessageIter iter;
+    DBusMessageIter subIter;
+
+    // both port and locator are encoded in network endian.
+    trailer[0] = static_cast<uint8_t>(aPeerPort >> 8);
+    trailer[1] = static_cast<uint8_t>(aPeerPort & 0xff);
+    memcpy(&trailer[sizeof(aPeerPort)], aPeerAddr.s6_addr, sizeof(aPeerAddr));
+    trailer[kSizeOfUdpForwardTrailer - 2] = static_cast<uint8_t>(aSockPort >> 8);
+    trailer[kSizeOfUdpForwardTrailer - 1] = static_cast<uint8_t>(aSockPort & 0xff);
+
+    dbus_message_iter_init_append(&aMessage, &iter);
+    VerifyOrExit(dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &key), errno = ENOMEM);
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE_AS_STRING, &subIter),
+                 errno = ENOMEM);
+
+    value = aBuffer;
+    VerifyOrExit(dbus_message_iter_append_fixed_array(&subIter, DBUS_TYPE_BYTE, &value, aLength),
+                 dbus_message_iter_abandon_container(&iter, &subIter), errno = ENOMEM);
+
+    value = trailer;
+    VerifyOrExit(dbus_message_iter_append_fixed_array(&subIter, DBUS_TYPE_BYTE, &value, sizeof(trailer)),
+                 dbus_message_iter_abandon_container(&iter, &subIter), errno = ENOMEM);
+
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter), errno = ENOMEM);
+
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
 }
 
 otbrError ControllerWpantund::UdpForwardSend(const uint8_t * aBuffer,
@@ -315,37 +567,19 @@ otbrError ControllerWpantund::UdpForwardSend(const uint8_t * aBuffer,
     otbrError    ret     = OTBR_ERROR_ERRNO;
     DBusMessage *message = NULL;
 
-    std::vector<uint8_t> data(aLength + sizeof(aPeerPort) + sizeof(aPeerAddr) + sizeof(aSockPort));
-    const uint8_t *      value = data.data();
-    const char *         key   = kWPANTUNDProperty_UdpForwardStream;
-    size_t               index = aLength;
-
     VerifyOrExit(mInterfaceDBusPath[0] != '\0', errno = EADDRNOTAVAIL);
 
-    memcpy(data.data(), aBuffer, aLength);
-    data[index]     = (aPeerPort >> 8);
-    data[index + 1] = (aPeerPort & 0xff);
-    index += sizeof(aPeerPort);
-
-    memcpy(&data[index], aPeerAddr.s6_addr, sizeof(aPeerAddr));
-    index += sizeof(aPeerAddr);
-
-    data[index]     = (aSockPort >> 8);
-    data[index + 1] = (aSockPort & 0xff);
-
+    // libdbus recycles released messages, so this does not allocate in steady state.
     message = dbus_message_new_method_call(mInterfaceDBusName, mInterfaceDBusPath, WPANTUND_DBUS_APIv1_INTERFACE,
                                            WPANTUND_IF_CMD_PROP_SET);
 
     VerifyOrExit(message != NULL, errno = ENOMEM);
 
-    VerifyOrExit(dbus_message_append_args(message, DBUS_TYPE_STRING, &key, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE, &value,
-                                          data.size(), DBUS_TYPE_INVALID),
-                 errno = EINVAL);
+    SuccessOrExit(ret = AppendUdpForwardStream(*message, aBuffer, aLength, aPeerPort, aPeerAddr, aSockPort));
 
-    VerifyOrExit(dbus_connection_send(mDBus, message, NULL), errno = ENOMEM);
+    VerifyOrExit(dbus_connection_send(mDBus, message, NULL), ret = OTBR_ERROR_ERRNO, errno = ENOMEM);
 
-    ret = OTBR_ERROR_NONE;
-    otbrDump(OTBR_LOG_INFO, "UdpForwardSend success", value, data.size());
+    otbrDump(OTBR_LOG_INFO, "UdpForwardSend success", aBuffer, aLength);
 
 exit:
 
@@ -356,107 +590,121 @@ exit:
 
     if (ret != OTBR_ERROR_NONE)
     {
-        otbrLog(OTBR_LOG_WARNING, "UdpForwardSend failed: ", otbrErrorString(ret));
+        otbrLog(OTBR_LOG_WARNING, "UdpForwardSend failed: %s", otbrErrorString(ret));
     }
 
     return ret;
 }
 
-void ControllerWpantund::UpdateFdSet(otSysMainloopContext &aMainloop)
+otbrError ControllerWpantund::Send(DBusMessage *aMessage, CommissionerRequest aRequest)
 {
-    DBusWatch *  watch = NULL;
-    unsigned int flags;
-    int          fd;
+    otbrError        ret     = OTBR_ERROR_ERRNO;
+    DBusPendingCall *pending = NULL;
+    const int        timeout = DEFAULT_TIMEOUT_IN_SECONDS * 1000;
+
+    VerifyOrExit(dbus_connection_send_with_reply(mDBus, aMessage, &pending, timeout), errno = ENOMEM);
+    // No pending call is returned when the connection is closed.
+    VerifyOrExit(pending != NULL, errno = ENOTCONN);
+    VerifyOrExit(dbus_pending_call_set_notify(pending, HandleCommissionerReply, this, NULL), errno = ENOMEM);
+
+    mCommissionerCalls.push_back(std::make_pair(pending, aRequest));
+    pending = NULL;
+    ret     = OTBR_ERROR_NONE;
+
+exit:
 
-    for (WatchMap::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
+    if (pending)
     {
-        if (!it->second)
-        {
-            continue;
-        }
+        dbus_pending_call_cancel(pending);
+        dbus_pending_call_unref(pending);
+    }
 
-        watch = it->first;
-        flags = dbus_watch_get_flags(watch);
-        fd    = dbus_watch_get_unix_fd(watch);
+    dbus_message_unref(aMessage);
+    return ret;
+}
 
-        if (fd < 0)
-        {
-            continue;
-        }
+otbrError ControllerWpantund::SetProperty(const char *aKey, const char *aValue, CommissionerRequest aRequest)
+{
+    otbrError    ret     = OTBR_ERROR_ERRNO;
+    DBusMessage *message = NULL;
 
-        if (flags & DBUS_WATCH_READABLE)
-        {
-            FD_SET(fd, &aMainloop.mReadFdSet);
-        }
+    VerifyOrExit(mInterfaceDBusPath[0] != '\0', errno = EADDRNOTAVAIL);
 
-        if ((flags & DBUS_WATCH_WRITABLE) && dbus_connection_has_messages_to_send(mDBus))
-        {
-            FD_SET(fd, &aMainloop.mWriteFdSet);
-        }
+    message = dbus_message_new_method_call(mInterfaceDBusName, mInterfaceDBusPath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                           WPANTUND_IF_CMD_PROP_SET);
+    VerifyOrExit(message != NULL, errno = ENOMEM);
+    VerifyOrExit(
+        dbus_message_append_args(message, DBUS_TYPE_STRING, &aKey, DBUS_TYPE_STRING, &aValue, DBUS_TYPE_INVALID),
+        dbus_message_unref(message), errno = ENOMEM);
 
-        FD_SET(fd, &aMainloop.mErrorFdSet);
+    ret = Send(message, aRequest);
 
-        if (fd > aMainloop.mMaxFd)
-        {
-            aMainloop.mMaxFd = fd;
-        }
-    }
+exit:
+    return ret;
 }
 
-void ControllerWpantund::Process(const otSysMainloopContext &aMainloop)
+otbrError ControllerWpantund::CommissionerStart(void)
 {
-    DBusWatch *  watch = NULL;
-    unsigned int flags;
-    int          fd;
+    otbrError ret;
 
-    for (WatchMap::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
-    {
-        if (!it->second)
-        {
-            continue;
-        }
+    SuccessOrExit(ret = SetProperty(kWPANTUNDProperty_CommissionerState, kWPANTUNDCommissionerState_Active,
+                                    kCommissionerRequestStart));
 
-        watch = it->first;
-        flags = dbus_watch_get_flags(watch);
-        fd    = dbus_watch_get_unix_fd(watch);
+    // Replies come in order, so the state read back is the one after the set. The result of the set is emitted
+    // anyway, so a failure here is only logged, and the state is still reported when wpantund signals it.
+    RequestEvent(kEventCommissionerState);
 
-        if (fd < 0)
-        {
-            continue;
-        }
+exit:
+    return ret;
+}
 
-        if ((flags & DBUS_WATCH_READABLE) && !FD_ISSET(fd, &aMainloop.mReadFdSet))
-        {
-            flags &= static_cast<unsigned int>(~DBUS_WATCH_READABLE);
-        }
+otbrError ControllerWpantund::CommissionerStop(void)
+{
+    otbrError ret;
 
-        if ((flags & DBUS_WATCH_WRITABLE) && !FD_ISSET(fd, &aMainloop.mWriteFdSet))
-        {
-            flags &= static_cast<unsigned int>(~DBUS_WATCH_WRITABLE);
-        }
+    SuccessOrExit(ret = SetProperty(kWPANTUNDProperty_CommissionerState, kWPANTUNDCommissionerState_Disabled,
+                                    kCommissionerRequestStop));
+    RequestEvent(kEventCommissionerState);
 
-        if (FD_ISSET(fd, &aMainloop.mErrorFdSet))
-        {
-            flags |= DBUS_WATCH_ERROR;
-        }
+exit:
+    return ret;
+}
 
-        dbus_watch_handle(watch, flags);
+otbrError ControllerWpantund::CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout)
+{
+    otbrError    ret     = OTBR_ERROR_ERRNO;
+    DBusMessage *message = NULL;
+
+    VerifyOrExit(mInterfaceDBusPath[0] != '\0', errno = EADDRNOTAVAIL);
+
+    message = dbus_message_new_method_call(mInterfaceDBusName, mInterfaceDBusPath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                           WPANTUND_IF_CMD_JOINER_ADD);
+    VerifyOrExit(message != NULL, errno = ENOMEM);
+    VerifyOrExit(dbus_message_append_args(message, DBUS_TYPE_STRING, &aPskd, DBUS_TYPE_UINT32, &aTimeout,
+                                          DBUS_TYPE_INVALID),
+                 dbus_message_unref(message), errno = ENOMEM);
+
+    // Any joiner is allowed without the EUI-64.
+    if (aEui64 != NULL)
+    {
+        VerifyOrExit(dbus_message_append_args(message, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE, &aEui64, kSizeEui64,
+                                              DBUS_TYPE_INVALID),
+                     dbus_message_unref(message), errno = ENOMEM);
     }
 
-    while (DBUS_DISPATCH_DATA_REMAINS == dbus_connection_get_dispatch_status(mDBus) &&
-           dbus_connection_read_write_dispatch(mDBus, 0))
-        ;
+    ret = Send(message, kCommissionerRequestAddJoiner);
+
+exit:
+    return ret;
 }
 
 otbrError ControllerWpantund::RequestEvent(int aEvent)
 {
-    otbrError       ret     = OTBR_ERROR_ERRNO;
-    DBusMessage *   message = NULL;
-    DBusMessage *   reply   = NULL;
-    DBusMessageIter iter;
-    const char *    key     = NULL;
-    const int       timeout = DEFAULT_TIMEOUT_IN_SECONDS * 1000;
-    DBusError       error;
+    otbrError        ret     = OTBR_ERROR_ERRNO;
+    DBusMessage *    message = NULL;
+    DBusPendingCall *pending = NULL;
+    const char *     key     = NULL;
+    const int        timeout = DEFAULT_TIMEOUT_IN_SECONDS * 1000;
 
     switch (aEvent)
     {
@@ -472,6 +720,9 @@ otbrError ControllerWpantund::RequestEvent(int aEvent)
     case kEventPSKc:
         key = kWPANTUNDProperty_NetworkPSKc;
         break;
+    case kEventCommissionerState:
+        key = kWPANTUNDProperty_CommissionerState;
+        break;
     default:
         assert(false);
         break;
@@ -479,6 +730,12 @@ otbrError ControllerWpantund::RequestEvent(int aEvent)
 
     VerifyOrExit(key != NULL && mInterfaceDBusPath[0] != '\0', errno = EINVAL);
 
+    for (PendingCallMap::iterator it = mPendingCalls.begin(); it != mPendingCalls.end(); ++it)
+    {
+        // The reply in flight will emit the event.
+        VerifyOrExit(strcmp(it->second, key), ret = OTBR_ERROR_NONE);
+    }
+
     otbrLog(OTBR_LOG_DEBUG, "Request event %s", key);
     VerifyOrExit((message = dbus_message_new_method_call(mInterfaceDBusName, mInterfaceDBusPath,
                                                          WPANTUND_DBUS_APIv1_INTERFACE, WPANTUND_IF_CMD_PROP_GET)) !=
@@ -487,9 +744,65 @@ otbrError ControllerWpantund::RequestEvent(int aEvent)
 
     VerifyOrExit(dbus_message_append_args(message, DBUS_TYPE_STRING, &key, DBUS_TYPE_INVALID), errno = EINVAL);
 
-    dbus_error_init(&error);
-    reply = dbus_connection_send_with_reply_and_block(mDBus, message, timeout, &error);
-    VerifyOrExit(reply != NULL, HandleDBusError(error), ret = OTBR_ERROR_DBUS);
+    VerifyOrExit(dbus_connection_send_with_reply(mDBus, message, &pending, timeout), errno = ENOMEM);
+    // No pending call is returned when the connection is closed.
+    VerifyOrExit(pending != NULL, ret = OTBR_ERROR_DBUS);
+    VerifyOrExit(dbus_pending_call_set_notify(pending, HandlePropertyGetReply, this, NULL), errno = ENOMEM);
+
+    mPendingCalls[pending] = key;
+    pending                = NULL;
+    ret                    = OTBR_ERROR_NONE;
+
+exit:
+
+    if (pending)
+    {
+        dbus_pending_call_cancel(pending);
+        dbus_pending_call_unref(pending);
+    }
+
+    if (message)
+    {
+        dbus_message_unref(message);
+    }
+
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Error requesting %s: %s", key, otbrErrorString(ret));
+    }
+    return ret;
+}
+
+void ControllerWpantund::HandlePropertyGetReply(DBusPendingCall *aPending, void *aContext)
+{
+    static_cast<ControllerWpantund *>(aContext)->HandlePropertyGetReply(*aPending);
+}
+
+void ControllerWpantund::HandlePropertyGetReply(DBusPendingCall &aPending)
+{
+    otbrError                ret   = OTBR_ERROR_ERRNO;
+    DBusMessage *            reply = dbus_pending_call_steal_reply(&aPending);
+    PendingCallMap::iterator it    = mPendingCalls.find(&aPending);
+    const char *             key   = NULL;
+    DBusMessageIter          iter;
+
+    VerifyOrExit(it != mPendingCalls.end(), errno = ENOENT);
+    key = it->second;
+    mPendingCalls.erase(it);
+    dbus_pending_call_unref(&aPending);
+
+    VerifyOrExit(reply != NULL, errno = ENOENT);
+
+    if (dbus_message_get_type(reply) == DBUS_MESSAGE_TYPE_ERROR)
+    {
+        DBusError error;
+
+        dbus_error_init(&error);
+        dbus_set_error_from_message(&error, reply);
+        HandleDBusError(error);
+        ExitNow(ret = OTBR_ERROR_DBUS);
+    }
+
     VerifyOrExit(dbus_message_iter_init(reply, &iter), errno = ENOENT);
 
     {
@@ -508,16 +821,104 @@ exit:
         dbus_message_unref(reply);
     }
 
-    if (message)
+    if (ret != OTBR_ERROR_NONE)
     {
-        dbus_message_unref(message);
+        otbrLog(OTBR_LOG_WARNING, "Error requesting %s: %s", key ? key : "unknown", otbrErrorString(ret));
     }
+}
 
-    if (ret != OTBR_ERROR_NONE)
+void ControllerWpantund::HandleCommissionerReply(DBusPendingCall *aPending, void *aContext)
+{
+    static_cast<ControllerWpantund *>(aContext)->HandleCommissionerReply(*aPending);
+}
+
+void ControllerWpantund::HandleCommissionerReply(DBusPendingCall &aPending)
+{
+    DBusMessage *                  reply = dbus_pending_call_steal_reply(&aPending);
+    CommissionerCallList::iterator it    = mCommissionerCalls.begin();
+    CommissionerRequest            request;
+    int                            error = 0;
+    DBusMessageIter                iter;
+
+    while (it != mCommissionerCalls.end() && it->first != &aPending)
     {
-        otbrLog(OTBR_LOG_WARNING, "Error requesting %s: %s", key, otbrErrorString(ret));
+        ++it;
     }
-    return ret;
+
+    VerifyOrExit(it != mCommissionerCalls.end());
+    request = it->second;
+    mCommissionerCalls.erase(it);
+    dbus_pending_call_unref(&aPending);
+
+    if (reply == NULL)
+    {
+        error = ENOENT;
+    }
+    else if (dbus_message_get_type(reply) == DBUS_MESSAGE_TYPE_ERROR)
+    {
+        DBusError dbusError;
+
+        dbus_error_init(&dbusError);
+        dbus_set_error_from_message(&dbusError, reply);
+        error = (dbus_error_has_name(&dbusError, DBUS_ERROR_NO_REPLY) ? ETIMEDOUT : EREMOTEIO);
+        HandleDBusError(dbusError);
+    }
+    else if (dbus_message_iter_init(reply, &iter))
+    {
+        uint32_t status = 0;
+
+        // wpantund answers with its status, failures of the NCP included.
+        dbus_message_iter_get_basic(&iter, &status);
+        error = (status == SPINEL_STATUS_OK ? 0 : EREMOTEIO);
+    }
+
+    if (error != 0)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Commissioner request %d failed: %s", request, strerror(error));
+    }
+
+    Emit<kEventCommissionerResult>(request, error);
+
+exit:
+
+    if (reply)
+    {
+        dbus_message_unref(reply);
+    }
+}
+
+void ControllerWpantund::AbortCommissionerCalls(int aError)
+{
+    CommissionerCallList calls;
+
+    // Handlers may send new requests.
+    calls.swap(mCommissionerCalls);
+
+    for (CommissionerCallList::iterator it = calls.begin(); it != calls.end(); ++it)
+    {
+        dbus_pending_call_cancel(it->first);
+        dbus_pending_call_unref(it->first);
+        Emit<kEventCommissionerResult>(it->second, aError);
+    }
+}
+
+void ControllerWpantund::CancelPendingCalls(void)
+{
+    for (PendingCallMap::iterator it = mPendingCalls.begin(); it != mPendingCalls.end(); ++it)
+    {
+        dbus_pending_call_cancel(it->first);
+        dbus_pending_call_unref(it->first);
+    }
+
+    mPendingCalls.clear();
+
+    for (CommissionerCallList::iterator it = mCommissionerCalls.begin(); it != mCommissionerCalls.end(); ++it)
+    {
+        dbus_pending_call_cancel(it->first);
+        dbus_pending_call_unref(it->first);
+    }
+
+    mCommissionerCalls.clear();
 }
 
 Controller *Controller::Create(const char *aInterfaceName, char *aRadioFile, char *aRadioConfig)
@@ -35,12 +35,13 @@
 #define NCP_WPANTUND_HPP_
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <arpa/inet.h>
 #include <dbus/dbus.h>
 #include <net/if.h>
 #include <stdint.h>
-#include <sys/select.h>
 
 #include "ncp.hpp"
 
@@ -69,11 +70,15 @@ public:
     /*
      * This method initalize the NCP controller.
      *
+     * The DBus watches and timeouts are registered with @p aEventLoop as libdbus adds them.
+     *
+     * @param[in]   aEventLoop  A reference to the event loop.
+     *
      * @retval  OTBR_ERROR_NONE     Successfully initialized NCP controller.
      * @retval  OTBR_ERROR_NCP      Failed due to NCP's internal error.
      *
      */
-    otbrError Init(void);
+    otbrError Init(EventLoop &aEventLoop);
 
     /**
      * This method sends a packet through UDP forward service.
@@ -89,62 +94,176 @@ public:
                                      uint16_t        aSockPort);
 
     /**
-     * This method updates the fd_set to poll.
+     * This method enables the commissioner role of the NCP.
+     *
+     * The property set is sent without waiting for the reply, the result is emitted once wpantund answers and the
+     * state once wpantund reports it.
      *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling read.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
+     * @retval  OTBR_ERROR_NONE         Successfully sent the request.
+     * @retval  OTBR_ERROR_ERRNO        Failed to send the request, error info in errno.
      *
      */
-    virtual void UpdateFdSet(otSysMainloopContext &aMainloop);
+    virtual otbrError CommissionerStart(void);
 
     /**
-     * This method performs the DTLS processing.
+     * This method disables the commissioner role of the NCP.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     * @retval  OTBR_ERROR_NONE         Successfully sent the request.
+     * @retval  OTBR_ERROR_ERRNO        Failed to send the request, error info in errno.
      *
      */
-    virtual void Process(const otSysMainloopContext &aMainloop);
+    virtual otbrError CommissionerStop(void);
+
+    /**
+     * This method allows a joiner to be commissioned by the NCP.
+     *
+     * @param[in]   aEui64      A pointer to the EUI-64 of the joiner, NULL for any joiner.
+     * @param[in]   aPskd       A null-terminated PSKd of the joiner.
+     * @param[in]   aTimeout    Seconds after which the joiner is removed.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully sent the request.
+     * @retval  OTBR_ERROR_ERRNO        Failed to send the request, error info in errno.
+     *
+     */
+    virtual otbrError CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout);
 
     /**
      * This method request the event.
      *
+     * The property get is sent without waiting for the reply, the event is emitted from the event loop once wpantund
+     * answers. A request for a property that is already in flight is not sent again.
+     *
      * @param[in]   aEvent              The event id to request.
      *
-     * @retval  OTBR_ERROR_NONE         Successfully requested the event.
+     * @retval  OTBR_ERROR_NONE         Successfully sent the request.
      * @retval  OTBR_ERROR_ERRNO        Failed to request the event.
      *
      */
     virtual otbrError RequestEvent(int aEvent);
 
+    /**
+     * This method appends a UDP forward stream property set to a DBus message.
+     *
+     * The payload is copied straight into the message and followed by the peer port, peer address and socket port
+     * trailer, no intermediate buffer is used.
+     *
+     * @param[inout]    aMessage    A reference to a wpantund property set method call.
+     * @param[in]       aBuffer     A pointer to the UDP payload.
+     * @param[in]       aLength     The length of the UDP payload.
+     * @param[in]       aPeerPort   The UDP port of the peer.
+     * @param[in]       aPeerAddr   The IPv6 address of the peer.
+     * @param[in]       aSockPort   The UDP port of the socket in Thread network.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully appended the arguments.
+     * @retval  OTBR_ERROR_ERRNO        Failed to append the arguments, error info in errno.
+     *
+     */
+    static otbrError AppendUdpForwardStream(DBusMessage &   aMessage,
+                                            const uint8_t * aBuffer,
+                                            uint16_t        aLength,
+                                            uint16_t        aPeerPort,
+                                            const in6_addr &aPeerAddr,
+                                            uint16_t        aSockPort);
+
 private:
+    enum
+    {
+        kSizeOfUdpForwardTrailer = sizeof(uint16_t) + sizeof(in6_addr) + sizeof(uint16_t), ///< Ports and peer address.
+    };
+
     /**
-     * This map is used to track DBusWatch-es.
+     * This map is used to track DBusWatch-es and whether they are enabled.
      *
      */
     typedef std::map<DBusWatch *, bool> WatchMap;
 
+    /**
+     * This map is used to track the events registered with the event loop for the file descriptors of DBusWatch-es.
+     *
+     */
+    typedef std::map<int, unsigned int> WatchFdMap;
+
+    /**
+     * This structure represents a DBusTimeout, driven by a timer of the event loop.
+     *
+     */
+    struct Timeout
+    {
+        Timeout(ControllerWpantund &aController, DBusTimeout *aTimeout)
+            : mController(aController)
+            , mTimeout(aTimeout)
+            , mTimer(HandleDBusTimeout, this)
+        {
+        }
+
+        ControllerWpantund &mController;
+        DBusTimeout *       mTimeout;
+        EventLoop::Timer    mTimer;
+    };
+
+    /**
+     * This map is used to track DBusTimeout-s and their timers.
+     *
+     */
+    typedef std::map<DBusTimeout *, Timeout *> TimeoutMap;
+
+    /**
+     * This map is used to track property gets in flight and their property keys.
+     *
+     */
+    typedef std::map<DBusPendingCall *, const char *> PendingCallMap;
+
+    /**
+     * This list is used to track commissioner requests in flight, in the order they were sent.
+     *
+     */
+    typedef std::vector<std::pair<DBusPendingCall *, CommissionerRequest>> CommissionerCallList;
+
     static DBusHandlerResult HandlePropertyChangedSignal(DBusConnection *aConnection,
                                                          DBusMessage *   aMessage,
                                                          void *          aContext);
     DBusHandlerResult        HandlePropertyChangedSignal(DBusMessage &aMessage);
 
+    static void HandlePropertyGetReply(DBusPendingCall *aPending, void *aContext);
+    void        HandlePropertyGetReply(DBusPendingCall &aPending);
+
+    static void HandleCommissionerReply(DBusPendingCall *aPending, void *aContext);
+    void        HandleCommissionerReply(DBusPendingCall &aPending);
+
     otbrError ParseEvent(const char *aKey, DBusMessageIter *aIter);
+    otbrError SetProperty(const char *aKey, const char *aValue, CommissionerRequest aRequest);
+    otbrError Send(DBusMessage *aMessage, CommissionerRequest aRequest);
+
+    void CancelPendingCalls(void);
+    void AbortCommissionerCalls(int aError);
 
     otbrError UpdateInterfaceDBusPath();
 
     static dbus_bool_t AddDBusWatch(struct DBusWatch *aWatch, void *aContext);
     static void        RemoveDBusWatch(struct DBusWatch *aWatch, void *aContext);
     static void        ToggleDBusWatch(struct DBusWatch *aWatch, void *aContext);
+    void               UpdateWatchFd(int aFd);
+    static void        HandleDBusIo(void *aContext, int aFd, unsigned int aEvents);
+    void               HandleDBusIo(int aFd, unsigned int aEvents);
+
+    static dbus_bool_t AddDBusTimeout(DBusTimeout *aTimeout, void *aContext);
+    static void        RemoveDBusTimeout(DBusTimeout *aTimeout, void *aContext);
+    static void        ToggleDBusTimeout(DBusTimeout *aTimeout, void *aContext);
+    static void        HandleDBusTimeout(void *aContext);
+
+    void DispatchDBus(void);
+    void ReleaseDBus(void);
 
-    char            mInterfaceDBusName[DBUS_MAXIMUM_NAME_LENGTH + 1];
-    char            mInterfaceDBusPath[DBUS_MAXIMUM_NAME_LENGTH + 1];
-    char            mInterfaceName[IFNAMSIZ];
-    DBusConnection *mDBus;
-    WatchMap        mWatches;
+    char                 mInterfaceDBusName[DBUS_MAXIMUM_NAME_LENGTH + 1];
+    char                 mInterfaceDBusPath[DBUS_MAXIMUM_NAME_LENGTH + 1];
+    char                 mInterfaceName[IFNAMSIZ];
+    DBusConnection *     mDBus;
+    EventLoop *          mEventLoop;
+    WatchMap             mWatches;
+    WatchFdMap           mWatchFds;
+    TimeoutMap           mTimeouts;
+    PendingCallMap       mPendingCalls;
+    CommissionerCallList mCommissionerCalls;
 };
 
 } // namespace Ncp
@@ -0,0 +1,410 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file implements the CoAP service of Thread state.
+ */
+
+#include "state_server.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+#include "utils/hex.hpp"
+#include "utils/strcpy_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+StateServer::StateServer(Ncp::Controller *aNcp, uint16_t aPort)
+    : mEventLoop(NULL)
+    , mNcp(aNcp)
+    , mPort(aPort)
+    , mSocket(-1)
+    , mCoap(NULL)
+    , mResources{Coap::Resource("s/ts", HandleGet, this, Coap::kMethodGet),
+                 Coap::Resource("s/nn", HandleGet, this, Coap::kMethodGet),
+                 Coap::Resource("s/xp", HandleGet, this, Coap::kMethodGet),
+                 Coap::Resource("s/ja", HandleGet, this, Coap::kMethodGet)}
+    , mThreadStarted(false)
+    , mJoinerActive(false)
+    , mJoinerTime(0)
+    , mChanged(0)
+    , mNotifyTimer(HandleNotifyTimer, this)
+    , mJoinerTimer(HandleJoinerTimer, this)
+    , mCoapTimer(HandleCoapTimer, this)
+{
+    memset(mNetworkName, 0, sizeof(mNetworkName));
+    memset(mExtPanId, 0, sizeof(mExtPanId));
+
+    for (int i = 0; i < kNumStates; ++i)
+    {
+        Render(i, mNotified[i]);
+    }
+}
+
+StateServer::~StateServer(void)
+{
+    if (mEventLoop != NULL)
+    {
+        mEventLoop->StopTimer(mNotifyTimer);
+        mEventLoop->StopTimer(mJoinerTimer);
+        mEventLoop->StopTimer(mCoapTimer);
+    }
+
+    if (mCoap != NULL)
+    {
+        Coap::Agent::Destroy(mCoap);
+    }
+
+    if (mSocket != -1)
+    {
+        mEventLoop->RemoveIo(mSocket);
+        close(mSocket);
+    }
+}
+
+otbrError StateServer::Init(EventLoop &aEventLoop)
+{
+    otbrError    error = OTBR_ERROR_ERRNO;
+    sockaddr_in6 sin6;
+
+    mEventLoop = &aEventLoop;
+
+    memset(&sin6, 0, sizeof(sin6));
+    sin6.sin6_family = AF_INET6;
+    sin6.sin6_addr   = in6addr_loopback;
+    sin6.sin6_port   = htons(mPort);
+
+    mSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    VerifyOrExit(mSocket != -1);
+    VerifyOrExit(fcntl(mSocket, F_SETFL, fcntl(mSocket, F_GETFL) | O_NONBLOCK) == 0);
+    VerifyOrExit(bind(mSocket, reinterpret_cast<sockaddr *>(&sin6), sizeof(sin6)) == 0);
+
+    VerifyOrExit((mCoap = Coap::Agent::Create(SendCoap, this)) != NULL, errno = ENOMEM);
+
+    for (int i = 0; i < kNumStates; ++i)
+    {
+        SuccessOrExit(mCoap->AddResource(mResources[i]));
+    }
+
+    mNcp->On<Ncp::kEventThreadState>(HandleThreadState, this);
+    mNcp->On<Ncp::kEventNetworkName>(HandleNetworkName, this);
+    mNcp->On<Ncp::kEventExtPanId>(HandleExtPanId, this);
+#if OTBR_ENABLE_NCP_WPANTUND
+    // Commissioning traffic is relayed to and from joiners.
+    mNcp->On<Ncp::kEventUdpForwardStream>(HandleUdpForwardStream, this);
+#endif
+
+    {
+        const int events[] = {Ncp::kEventThreadState, Ncp::kEventNetworkName, Ncp::kEventExtPanId};
+
+        SuccessOrExit(error = mNcp->RequestEvents(events, sizeof(events) / sizeof(events[0])));
+    }
+
+    SuccessOrExit(error = mEventLoop->AddIo(mSocket, EventLoop::kEventReadable, HandleIo, this));
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        mEventLoop->StopTimer(mNotifyTimer);
+        mEventLoop->StopTimer(mJoinerTimer);
+
+        if (mCoap != NULL)
+        {
+            Coap::Agent::Destroy(mCoap);
+            mCoap = NULL;
+        }
+
+        if (mSocket != -1)
+        {
+            close(mSocket);
+            mSocket = -1;
+        }
+    }
+
+    otbrLogResult("Start Thread state server", error);
+    return error;
+}
+
+ssize_t StateServer::SendCoap(const uint8_t *aBuffer,
+                              uint16_t       aLength,
+                              const uint8_t *aIp6,
+                              uint16_t       aPort,
+                              void *         aContext)
+{
+    StateServer *server = static_cast<StateServer *>(aContext);
+    sockaddr_in6 sin6;
+
+    memset(&sin6, 0, sizeof(sin6));
+    sin6.sin6_family = AF_INET6;
+    sin6.sin6_port   = htons(aPort);
+
+    if (aIp6 != NULL)
+    {
+        memcpy(sin6.sin6_addr.s6_addr, aIp6, sizeof(sin6.sin6_addr));
+    }
+
+    return sendto(server->mSocket, aBuffer, aLength, 0, reinterpret_cast<sockaddr *>(&sin6), sizeof(sin6));
+}
+
+void StateServer::HandleGet(const Coap::Resource &aResource,
+                            const Coap::Message & aRequest,
+                            Coap::Message &       aResponse,
+                            const uint8_t *       aIp6,
+                            uint16_t              aPort,
+                            void *                aContext)
+{
+    const StateServer *server = static_cast<const StateServer *>(aContext);
+    char               value[kMaxValueSize];
+    size_t             length = server->Render(static_cast<int>(&aResource - server->mResources), value);
+
+    aResponse.SetCode(Coap::kCodeContent);
+    aResponse.SetPayload(reinterpret_cast<const uint8_t *>(value), static_cast<uint16_t>(length));
+
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+}
+
+size_t StateServer::Render(int aState, char *aValue) const
+{
+    switch (aState)
+    {
+    case kStateThread:
+        strcpy_safe(aValue, kMaxValueSize, mThreadStarted ? "attached" : "detached");
+        break;
+
+    case kStateNetworkName:
+        strcpy_safe(aValue, kMaxValueSize, mNetworkName);
+        break;
+
+    case kStateExtPanId:
+        Utils::Bytes2Hex(mExtPanId, sizeof(mExtPanId), aValue);
+        break;
+
+    case kStateJoiner:
+        strcpy_safe(aValue, kMaxValueSize, mJoinerActive ? "active" : "idle");
+        break;
+
+    default:
+        aValue[0] = '\0';
+        break;
+    }
+
+    return strlen(aValue);
+}
+
+void StateServer::SetChanged(int aState)
+{
+    // Nothing is notified by a server which failed to start.
+    VerifyOrExit(mCoap != NULL);
+
+    // The first change starts the delay, later ones are carried along.
+    if (mChanged == 0)
+    {
+        mEventLoop->StartTimer(mNotifyTimer, kCoalesceDelay);
+    }
+
+    mChanged |= 1u << aState;
+
+exit:
+    return;
+}
+
+void StateServer::NotifyChanged(void)
+{
+    for (int i = 0; i < kNumStates; ++i)
+    {
+        char value[kMaxValueSize];
+
+        if ((mChanged & (1u << i)) == 0)
+        {
+            continue;
+        }
+
+        Render(i, value);
+
+        if (strcmp(value, mNotified[i]) != 0)
+        {
+            strcpy_safe(mNotified[i], sizeof(mNotified[i]), value);
+            mCoap->Notify(mResources[i]);
+        }
+    }
+
+    mChanged = 0;
+    ScheduleCoap();
+}
+
+void StateServer::ScheduleCoap(void)
+{
+    unsigned long now = GetNow();
+    timeval       timeout;
+    unsigned long delay;
+
+    timeout.tv_sec  = kCoapIdleTimeout;
+    timeout.tv_usec = 0;
+    mCoap->UpdateTimeout(timeout);
+
+    VerifyOrExit(timeout.tv_sec < kCoapIdleTimeout, mEventLoop->StopTimer(mCoapTimer));
+
+    delay = GetTimestamp(timeout);
+
+    // Only re-armed when the next retransmission or expiration moved.
+    if (!mCoapTimer.IsRunning() || mCoapTimer.GetFireTime() != now + delay)
+    {
+        mEventLoop->StartTimer(mCoapTimer, delay);
+    }
+
+exit:
+    return;
+}
+
+void StateServer::HandleIo(void *aContext, int aFd, unsigned int aEvents)
+{
+    (void)aFd;
+    (void)aEvents;
+
+    static_cast<StateServer *>(aContext)->HandleIo();
+}
+
+void StateServer::HandleIo(void)
+{
+    uint8_t      buffer[kMaxMessageSize];
+    sockaddr_in6 sin6;
+    socklen_t    length = sizeof(sin6);
+    ssize_t      count;
+
+    while ((count = recvfrom(mSocket, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr *>(&sin6), &length)) > 0)
+    {
+        mCoap->Input(buffer, static_cast<uint16_t>(count), sin6.sin6_addr.s6_addr, ntohs(sin6.sin6_port));
+        length = sizeof(sin6);
+    }
+
+    ScheduleCoap();
+}
+
+void StateServer::HandleCoapTimer(void *aContext)
+{
+    StateServer *server = static_cast<StateServer *>(aContext);
+
+    server->mCoap->Process();
+    server->ScheduleCoap();
+}
+
+void StateServer::HandleNotifyTimer(void *aContext)
+{
+    static_cast<StateServer *>(aContext)->NotifyChanged();
+}
+
+void StateServer::HandleJoinerTimer(void *aContext)
+{
+    static_cast<StateServer *>(aContext)->HandleJoinerTimer();
+}
+
+void StateServer::HandleJoinerTimer(void)
+{
+    long idle = static_cast<long>(GetNow() - mJoinerTime);
+
+    // Activity does not restart the timer, it is started again for the rest of the idle timeout instead.
+    if (idle < kJoinerIdleTimeout)
+    {
+        mEventLoop->StartTimer(mJoinerTimer, static_cast<unsigned long>(kJoinerIdleTimeout - idle));
+    }
+    else
+    {
+        mJoinerActive = false;
+        SetChanged(kStateJoiner);
+    }
+}
+
+void StateServer::HandleThreadState(void *aContext, bool aStarted)
+{
+    StateServer *server = static_cast<StateServer *>(aContext);
+
+    server->mThreadStarted = aStarted;
+    server->SetChanged(kStateThread);
+}
+
+void StateServer::HandleNetworkName(void *aContext, const char *aNetworkName)
+{
+    StateServer *server = static_cast<StateServer *>(aContext);
+
+    strcpy_safe(server->mNetworkName, sizeof(server->mNetworkName), aNetworkName);
+    server->SetChanged(kStateNetworkName);
+}
+
+void StateServer::HandleExtPanId(void *aContext, const uint8_t *aExtPanId)
+{
+    StateServer *server = static_cast<StateServer *>(aContext);
+
+    memcpy(server->mExtPanId, aExtPanId, sizeof(server->mExtPanId));
+    server->SetChanged(kStateExtPanId);
+}
+
+#if OTBR_ENABLE_NCP_WPANTUND
+void StateServer::HandleUdpForwardStream(void *          aContext,
+                                         const uint8_t * aBuffer,
+                                         uint16_t        aLength,
+                                         uint16_t        aPeerPort,
+                                         const in6_addr &aPeerAddr,
+                                         uint16_t        aSockPort)
+{
+    static_cast<StateServer *>(aContext)->HandleJoinerActivity();
+
+    (void)aBuffer;
+    (void)aLength;
+    (void)aPeerPort;
+    (void)aPeerAddr;
+    (void)aSockPort;
+}
+#endif
+
+void StateServer::HandleJoinerActivity(void)
+{
+    mJoinerTime = GetNow();
+
+    if (!mJoinerActive)
+    {
+        mJoinerActive = true;
+        SetChanged(kStateJoiner);
+        mEventLoop->StartTimer(mJoinerTimer, kJoinerIdleTimeout);
+    }
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
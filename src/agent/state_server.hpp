@@ -0,0 +1,170 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definition for the CoAP service of Thread state.
+ */
+
+#ifndef STATE_SERVER_HPP_
+#define STATE_SERVER_HPP_
+
+#include <stdint.h>
+
+#include "ncp.hpp"
+#include "common/coap.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a CoAP server of Thread state, so clients observe changes instead of polling.
+ *
+ * The resources are Thread state (s/ts), network name (s/nn), extended PAN ID (s/xp) and joiner activity (s/ja),
+ * all in plain text. They are driven by NCP events, and changes within kCoalesceDelay are notified at once. A
+ * resource which ends up unchanged, such as Thread state flapping down and up, is not notified at all.
+ *
+ */
+class StateServer
+{
+public:
+    enum
+    {
+        kDefaultPort       = 5683,  ///< Default UDP port, which is the CoAP port.
+        kCoalesceDelay     = 200,   ///< Delay of notifications in milliseconds, to coalesce changes.
+        kJoinerIdleTimeout = 10000, ///< Time without commissioning traffic before joiners are idle, in milliseconds.
+    };
+
+    /**
+     * The constructor to initialize the state server.
+     *
+     * @param[in]   aNcp        A pointer to the NCP controller.
+     * @param[in]   aPort       The UDP port to serve on the loopback interface.
+     *
+     */
+    StateServer(Ncp::Controller *aNcp, uint16_t aPort = kDefaultPort);
+
+    ~StateServer(void);
+
+    /**
+     * This method starts serving.
+     *
+     * @param[in]   aEventLoop  A reference to the event loop, which the socket and timers are registered to.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started the server.
+     * @retval  OTBR_ERROR_ERRNO    Failed to start the server, error code is stored in errno.
+     *
+     */
+    otbrError Init(EventLoop &aEventLoop);
+
+private:
+    enum
+    {
+        kStateThread,
+        kStateNetworkName,
+        kStateExtPanId,
+        kStateJoiner,
+        kNumStates,
+    };
+
+    enum
+    {
+        kMaxValueSize    = 32,
+        kMaxMessageSize  = 1280,
+        kCoapIdleTimeout = 3600, ///< Longer than any CoAP exchange in seconds, the timeout left if none is pending.
+    };
+
+    static ssize_t SendCoap(const uint8_t *aBuffer,
+                            uint16_t       aLength,
+                            const uint8_t *aIp6,
+                            uint16_t       aPort,
+                            void *         aContext);
+    static void    HandleGet(const Coap::Resource &aResource,
+                             const Coap::Message & aRequest,
+                             Coap::Message &       aResponse,
+                             const uint8_t *       aIp6,
+                             uint16_t              aPort,
+                             void *                aContext);
+    static void    HandleThreadState(void *aContext, bool aStarted);
+    static void    HandleNetworkName(void *aContext, const char *aNetworkName);
+    static void    HandleExtPanId(void *aContext, const uint8_t *aExtPanId);
+#if OTBR_ENABLE_NCP_WPANTUND
+    static void HandleUdpForwardStream(void *          aContext,
+                                       const uint8_t * aBuffer,
+                                       uint16_t        aLength,
+                                       uint16_t        aPeerPort,
+                                       const in6_addr &aPeerAddr,
+                                       uint16_t        aSockPort);
+#endif
+    static void HandleIo(void *aContext, int aFd, unsigned int aEvents);
+    static void HandleNotifyTimer(void *aContext);
+    static void HandleJoinerTimer(void *aContext);
+    static void HandleCoapTimer(void *aContext);
+
+    void   HandleIo(void);
+    void   HandleJoinerActivity(void);
+    void   HandleJoinerTimer(void);
+    size_t Render(int aState, char *aValue) const;
+    void   SetChanged(int aState);
+    void   NotifyChanged(void);
+    void   ScheduleCoap(void);
+
+    EventLoop *      mEventLoop;
+    Ncp::Controller *mNcp;
+    uint16_t         mPort;
+    int              mSocket;
+    Coap::Agent *    mCoap;
+    Coap::Resource   mResources[kNumStates];
+    bool             mThreadStarted;
+    char             mNetworkName[kSizeNetworkName + 1];
+    uint8_t          mExtPanId[kSizeExtPanId];
+    bool             mJoinerActive;
+    unsigned long    mJoinerTime;
+    unsigned int     mChanged;
+    char             mNotified[kNumStates][kMaxValueSize];
+    EventLoop::Timer mNotifyTimer; ///< Fires kCoalesceDelay after the first change.
+    EventLoop::Timer mJoinerTimer; ///< Fires when joiners may have become idle.
+    EventLoop::Timer mCoapTimer;   ///< Fires at the next retransmission or expiration of CoAP messages.
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // STATE_SERVER_HPP_
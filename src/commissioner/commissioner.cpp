@@ -34,15 +34,16 @@
 #include <vector>
 
 #include <assert.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include "addr_utils.hpp"
 #include "commissioner.hpp"
 #include "commissioner_utils.hpp"
 #include "agent/uris.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
 #include "common/tlv.hpp"
 #include "utils/hex.hpp"
 #include "utils/pskc.hpp"
@@ -51,12 +52,10 @@
 namespace ot {
 namespace BorderRouter {
 
-const uint16_t Commissioner::kPortJoinerSession      = 49192;
-const uint8_t  Commissioner::kSeed[]                 = "Commissioner";
-const int      Commissioner::kCipherSuites[]         = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
-const char     Commissioner::kCommissionerId[]       = "OpenThread";
-const int      Commissioner::kCoapResponseWaitSecond = 10;
-const int      Commissioner::kCoapResponseRetryTime  = 2;
+const uint8_t Commissioner::kSeed[]              = "Commissioner";
+const int     Commissioner::kCipherSuites[]      = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+const char    Commissioner::kCommissionerId[]   = "OpenThread";
+const int     Commissioner::kKeepAliveMaxMissed = 3;
 
 static void MBedDebugPrint(void *aCtx, int aLevel, const char *aFile, int aLine, const char *aStr)
 {
@@ -100,38 +99,163 @@ static int DummyKeyExport(void *               aContext,
     return 0;
 }
 
-Commissioner::Commissioner(const uint8_t *aPskcBin, int aKeepAliveRate)
-    : mDtlsInitDone(false)
+Commissioner::Commissioner(EventLoop &    aEventLoop,
+                           const uint8_t *aPskcBin,
+                           int            aKeepAliveRate,
+                           size_t         aMaxJoiners,
+                           uint16_t       aJoinerPort)
+    : mEventLoop(aEventLoop)
+    , mDtlsInitDone(false)
+    , mDtlsTimerSet(false)
     , mRelayReceiveHandler(OT_URI_PATH_RELAY_RX, Commissioner::HandleRelayReceive, this)
     , mPetitionRetryCount(0)
-    , mJoinerSession(NULL)
+    , mJoiners(aMaxJoiners)
+    , mJoinerPort(aJoinerPort)
     , mKeepAliveRate(aKeepAliveRate)
+    , mTimerTime(0)
+    , mKeepAliveTxCount(0)
+    , mKeepAliveRxCount(0)
     , mNumFinializeJoiners(0)
 {
+    memcpy(mPskcBin, aPskcBin, sizeof(mPskcBin));
+    mCoapAgent = Coap::Agent::Create(SendCoap, this);
+    mCoapToken = static_cast<uint16_t>(rand());
+    mCoapAgent->SetBlockSize(kCoapBlockSize);
+    mCoapAgent->AddResource(mRelayReceiveHandler);
+    mCommissionerState = CommissionerState::kStateInvalid;
+
+    for (size_t i = 0; i < mJoiners.size(); ++i)
+    {
+        mJoiners[i].mSession  = NULL;
+        mJoiners[i].mClientFd = -1;
+    }
+}
+
+void Commissioner::SetJoiner(const char *aPskdAscii, const SteeringData &aSteeringData)
+{
+    mDefaultPskd = (aPskdAscii != NULL ? aPskdAscii : "");
+    CommissionerSet(aSteeringData);
+}
+
+otbrError Commissioner::AddJoiner(const uint8_t *aEui64, const char *aPskdAscii)
+{
+    otbrError  ret = OTBR_ERROR_ERRNO;
+    JoinerPskd joinerPskd;
+
+    VerifyOrExit(strlen(aPskdAscii) <= kPSKdLength, errno = EINVAL);
+
+    SteeringData::ComputeJoinerId(aEui64, joinerPskd.mJoinerId);
+    joinerPskd.mPskd = aPskdAscii;
+    mJoinerPskds.push_back(joinerPskd);
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+const char *Commissioner::GetJoinerPskd(const uint8_t *aIid) const
+{
+    const char *pskd = (mDefaultPskd.empty() ? NULL : mDefaultPskd.c_str());
+    uint8_t     joinerId[SteeringData::kSizeJoinerId];
+
+    // Joiner IID is the joiner id with the universal/local bit toggled.
+    memcpy(joinerId, aIid, sizeof(joinerId));
+    joinerId[0] ^= 0x02;
+
+    for (std::vector<JoinerPskd>::const_iterator it = mJoinerPskds.begin(); it != mJoinerPskds.end(); ++it)
+    {
+        if (memcmp(it->mJoinerId, joinerId, sizeof(joinerId)) == 0)
+        {
+            pskd = it->mPskd.c_str();
+            break;
+        }
+    }
+
+    return pskd;
+}
+
+Commissioner::Joiner *Commissioner::FindJoiner(const uint8_t *aIid)
+{
+    Joiner *joiner = NULL;
+
+    for (size_t i = 0; i < mJoiners.size(); ++i)
+    {
+        if (mJoiners[i].mSession != NULL && memcmp(mJoiners[i].mIid, aIid, sizeof(mJoiners[i].mIid)) == 0)
+        {
+            joiner = &mJoiners[i];
+            break;
+        }
+    }
+
+    return joiner;
+}
+
+Commissioner::Joiner *Commissioner::NewJoiner(const uint8_t *aIid)
+{
+    Joiner *    joiner = NULL;
+    const char *pskd   = GetJoinerPskd(aIid);
     sockaddr_in addr;
+    size_t      index;
 
-    memcpy(mPskcBin, aPskcBin, sizeof(mPskcBin));
+    VerifyOrExit(pskd != NULL, otbrLog(OTBR_LOG_WARNING, "relay: no pskd for joiner"));
+
+    for (index = 0; index < mJoiners.size() && mJoiners[index].mSession != NULL; ++index)
+    {
+    }
+
+    // The joiner retransmits its handshake, so it is served once another one is done.
+    VerifyOrExit(index < mJoiners.size(), otbrLog(OTBR_LOG_WARNING, "relay: too many joiners, dropped"));
+
+    // Every joiner has a dtls server of its own, for its own pskd.
     addr.sin_family      = AF_INET;
     addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-    addr.sin_port        = htons(kPortJoinerSession);
-    mCoapAgent           = Coap::Agent::Create(SendCoap, this);
-    mCoapToken           = static_cast<uint16_t>(rand());
-    mCoapAgent->AddResource(mRelayReceiveHandler);
-    mCommissionerState = CommissionerState::kStateInvalid;
-    VerifyOrExit((mJoinerSessionClientFd = socket(AF_INET, SOCK_DGRAM, 0)) > 0);
-    SuccessOrExit(connect(mJoinerSessionClientFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+    addr.sin_port        = htons(static_cast<uint16_t>(mJoinerPort + index));
+
+    joiner = &mJoiners[index];
+    VerifyOrExit((joiner->mClientFd = socket(AF_INET, SOCK_DGRAM, 0)) >= 0, joiner = NULL);
+
+    if (connect(joiner->mClientFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        close(joiner->mClientFd);
+        joiner->mClientFd = -1;
+        ExitNow(joiner = NULL);
+    }
+
+    joiner->mSession = new JoinerSession(mEventLoop, static_cast<uint16_t>(mJoinerPort + index), pskd);
+    memcpy(joiner->mIid, aIid, sizeof(joiner->mIid));
+
+    {
+        char iid[kJoinerIidLength * 2 + 1];
+
+        ot::Utils::Bytes2Hex(aIid, kJoinerIidLength, iid);
+        otbrLog(OTBR_LOG_INFO, "relay: new joiner %s on port %zu", iid, mJoinerPort + index);
+    }
+
 exit:
-    return;
+    return joiner;
 }
 
-void Commissioner::SetJoiner(const char *aPskdAscii, const SteeringData &aSteeringData)
+void Commissioner::ReleaseJoiner(Joiner &aJoiner)
+{
+    delete aJoiner.mSession;
+    aJoiner.mSession = NULL;
+    close(aJoiner.mClientFd);
+    aJoiner.mClientFd = -1;
+}
+
+size_t Commissioner::GetNumActiveJoiners(void) const
 {
-    if (mJoinerSession)
+    size_t count = 0;
+
+    for (size_t i = 0; i < mJoiners.size(); ++i)
     {
-        delete mJoinerSession;
+        if (mJoiners[i].mSession != NULL)
+        {
+            ++count;
+        }
     }
-    mJoinerSession = new JoinerSession(kPortJoinerSession, aPskdAscii);
-    CommissionerSet(aSteeringData);
+
+    return count;
 }
 
 ssize_t Commissioner::SendCoap(const uint8_t *aBuffer,
@@ -179,32 +303,95 @@ int Commissioner::InitDtls(const char *aHost, const char *aPort)
 
     otbrLog(OTBR_LOG_INFO, "connecting: ssl-setup");
     SuccessOrExit(ret = mbedtls_ssl_setup(&mSsl, &mSslConf));
-    mbedtls_ssl_set_bio(&mSsl, &mSslClientFd, mbedtls_net_send, mbedtls_net_recv, mbedtls_net_recv_timeout);
-    mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+    // Never block the mainloop, retransmissions of the handshake are driven by UpdateFdSet() and Process().
+    SuccessOrExit(ret = mbedtls_net_set_nonblock(&mSslClientFd));
+    mbedtls_ssl_set_bio(&mSsl, &mSslClientFd, mbedtls_net_send, mbedtls_net_recv, NULL);
+    mbedtls_ssl_set_timer_cb(&mSsl, this, SetDelay, GetDelay);
 
     mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPskcBin, OT_PSKC_LENGTH);
 
+    mCommissionerState = CommissionerState::kStateConnecting;
+    ret                = TryDtlsHandshake();
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+    {
+        ret = 0;
+    }
+
 exit:
     return ret;
 }
 
+void Commissioner::SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal)
+{
+    static_cast<Commissioner *>(aContext)->SetDelay(aIntermediate, aFinal);
+}
+
+void Commissioner::SetDelay(uint32_t aIntermediate, uint32_t aFinal)
+{
+    unsigned long now = GetNow();
+
+    if (aFinal != 0)
+    {
+        mDtlsIntermediate = now + aIntermediate;
+        mDtlsFinal        = now + aFinal;
+        mDtlsTimerSet     = true;
+    }
+    else
+    {
+        mDtlsTimerSet = false;
+    }
+}
+
+int Commissioner::GetDelay(void *aContext)
+{
+    return static_cast<Commissioner *>(aContext)->GetDelay();
+}
+
+int Commissioner::GetDelay(void) const
+{
+    int           ret = 0;
+    unsigned long now = GetNow();
+
+    if (mDtlsTimerSet)
+    {
+        if (static_cast<long>(mDtlsIntermediate - now) <= 0)
+        {
+            ret = 1;
+        }
+
+        if (static_cast<long>(mDtlsFinal - now) <= 0)
+        {
+            ret = 2;
+        }
+    }
+    else
+    {
+        ret = -1;
+    }
+
+    return ret;
+}
+
 int Commissioner::TryDtlsHandshake(void)
 {
     int ret = mbedtls_ssl_handshake(&mSsl);
+
     if (ret == 0)
     {
-        mCommissionerState = CommissionerState::kStateConnected;
+        otbrLog(OTBR_LOG_INFO, "connecting: dtls connected");
+        CommissionerPetition();
     }
     else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
     {
+        otbrLog(OTBR_LOG_ERR, "connecting: dtls handshake fails with %d", ret);
         mCommissionerState = CommissionerState::kStateInvalid;
     }
+
     return ret;
 }
 
 void Commissioner::CommissionerPetition(void)
 {
-    int     retryCount = 0;
     uint8_t buffer[kSizeMaxPacket];
     Tlv *   tlv = reinterpret_cast<Tlv *>(buffer);
 
@@ -212,11 +399,6 @@ void Commissioner::CommissionerPetition(void)
     uint16_t       token = ++mCoapToken;
 
     otbrLog(OTBR_LOG_INFO, "COMM_PET.req: start");
-    if (mCommissionerState == CommissionerState::kStateRejected)
-    {
-        sleep(kPetitionAttemptDelay);
-        retryCount++;
-    }
     token   = htons(token);
     message = mCoapAgent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, reinterpret_cast<const uint8_t *>(&token),
                                      sizeof(token));
@@ -227,12 +409,53 @@ void Commissioner::CommissionerPetition(void)
     message->SetPath(OT_URI_PATH_COMMISSIONER_PETITION);
     message->SetPayload(buffer, Utils::LengthOf(buffer, tlv));
     otbrLog(OTBR_LOG_INFO, "COMM_PET.req: send");
-    mCoapAgent->Send(*message, NULL, 0, HandleCommissionerPetition, this);
+    mCommissionerState = CommissionerState::kStateConnected;
+
+    // The CoAP agent retransmits the petition, and fails it once the leader is given up.
+    if (mCoapAgent->Send(*message, NULL, 0, HandleCommissionerPetition, this) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "COMM_PET.req: failed: %s", strerror(errno));
+        RetryPetition();
+    }
+
     mCoapAgent->FreeMessage(message);
 
     otbrLog(OTBR_LOG_INFO, "COMM_PET.req: complete");
 }
 
+void Commissioner::RetryPetition(void)
+{
+    if (mPetitionRetryCount < kPetitionMaxRetry)
+    {
+        // Exponential backoff, randomized so that commissioners rejected together do not retry together.
+        unsigned long delay = static_cast<unsigned long>(kPetitionAttemptDelay * 1000) << mPetitionRetryCount;
+
+        delay += static_cast<unsigned long>(rand()) % (delay / 2 + 1);
+        mPetitionRetryCount++;
+        mCommissionerState = CommissionerState::kStateRejected;
+        mTimerTime         = GetNow() + delay;
+        otbrLog(OTBR_LOG_INFO, "COMM_PET.req: retry in %lu ms", delay);
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_WARNING, "COMM_PET.req: exceeds max retry");
+        mCommissionerState  = CommissionerState::kStateInvalid;
+        mPetitionRetryCount = 0;
+    }
+}
+
+void Commissioner::ScheduleKeepAlive(void)
+{
+    if (mKeepAliveRate > 0)
+    {
+        // Jittered earlier rather than later, so that the session never expires on the leader.
+        unsigned long period = static_cast<unsigned long>(mKeepAliveRate) * 1000;
+
+        period -= static_cast<unsigned long>(rand()) % (period / 10 + 1);
+        mTimerTime = GetNow() + period;
+    }
+}
+
 void Commissioner::LogMeshcopState(const char *aPrefix, int8_t aState)
 {
     switch (aState)
@@ -250,7 +473,7 @@ void Commissioner::LogMeshcopState(const char *aPrefix, int8_t aState)
 }
 
 /** handle c/cp response */
-void Commissioner::HandleCommissionerPetition(const Coap::Message &aMessage, void *aContext)
+void Commissioner::HandleCommissionerPetition(const Coap::Message *aMessage, otbrError aError, void *aContext)
 {
     uint16_t       length;
     int            tlvType;
@@ -258,8 +481,20 @@ void Commissioner::HandleCommissionerPetition(const Coap::Message &aMessage, voi
     const uint8_t *payload;
     Commissioner * commissioner = static_cast<Commissioner *>(aContext);
 
+    if (aError != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "COMM_PET.rsp: failed: %s", strerror(errno));
+
+        // Including ETIMEDOUT once the CoAP agent has given up retransmitting, unless the session is over.
+        if (commissioner->mCommissionerState == CommissionerState::kStateConnected)
+        {
+            commissioner->RetryPetition();
+        }
+        ExitNow();
+    }
+
     otbrLog(OTBR_LOG_INFO, "COMM_PET.rsp: start");
-    payload = aMessage.GetPayload(length);
+    payload = aMessage->GetPayload(length);
     tlv     = reinterpret_cast<const Tlv *>(payload);
 
     while (Utils::LengthOf(payload, tlv) < length)
@@ -296,10 +531,20 @@ void Commissioner::HandleCommissionerPetition(const Coap::Message &aMessage, voi
         tlv = tlv->GetNext();
     }
 
-    gettimeofday(&commissioner->mLastKeepAliveTime, NULL);
     otbrLog(OTBR_LOG_INFO, "COMM_PET.rsp: complete");
 
-    commissioner->CommissionerResponseNext();
+    if (commissioner->mCommissionerState == CommissionerState::kStateAccepted)
+    {
+        commissioner->mPetitionRetryCount = 0;
+        commissioner->ScheduleKeepAlive();
+    }
+    else if (commissioner->mCommissionerState == CommissionerState::kStateRejected)
+    {
+        commissioner->RetryPetition();
+    }
+
+exit:
+    return;
 }
 
 void Commissioner::CommissionerSet(const SteeringData &aSteeringData)
@@ -331,7 +576,7 @@ void Commissioner::CommissionerSet(const SteeringData &aSteeringData)
     mCoapAgent->FreeMessage(message);
 }
 
-void Commissioner::HandleCommissionerSet(const Coap::Message &aMessage, void *aContext)
+void Commissioner::HandleCommissionerSet(const Coap::Message *aMessage, otbrError aError, void *aContext)
 {
     uint16_t       length;
     int            tlvType;
@@ -339,8 +584,11 @@ void Commissioner::HandleCommissionerSet(const Coap::Message &aMessage, void *aC
     const uint8_t *payload;
     Commissioner * commissioner = static_cast<Commissioner *>(aContext);
 
+    VerifyOrExit(aError == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_WARNING, "COMMISSIONER_SET.rsp: failed: %s", strerror(errno)));
+
     otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.rsp: start");
-    payload = (aMessage.GetPayload(length));
+    payload = (aMessage->GetPayload(length));
     tlv     = reinterpret_cast<const Tlv *>(payload);
 
     while (Utils::LengthOf(payload, tlv) < length)
@@ -365,97 +613,203 @@ void Commissioner::HandleCommissionerSet(const Coap::Message &aMessage, void *aC
     }
     otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.rsp: complete");
 
-    commissioner->CommissionerResponseNext();
+exit:
+    return;
 }
 
-void Commissioner::CommissionerResponseNext(void)
+void Commissioner::UpdateFdSet(otSysMainloopContext &aMainloop)
 {
-    if (mCommissionerState == CommissionerState::kStateConnected ||
-        mCommissionerState == CommissionerState::kStateRejected)
+    unsigned long deadline = 0;
+    bool          hasTimer = false;
+
+    if (mCommissionerState != CommissionerState::kStateInvalid)
+    {
+        FD_SET(mSslClientFd.fd, &aMainloop.mReadFdSet);
+        aMainloop.mMaxFd = Utils::Max(mSslClientFd.fd, aMainloop.mMaxFd);
+    }
+
+    switch (mCommissionerState)
     {
-        if (mCommissionerState != CommissionerState::kStateInvalid && mPetitionRetryCount < kPetitionMaxRetry)
+    case CommissionerState::kStateConnecting:
+        hasTimer = mDtlsTimerSet;
+        deadline = mDtlsFinal;
+        break;
+    case CommissionerState::kStateAccepted:
+        hasTimer = (mKeepAliveRate > 0);
+        deadline = mTimerTime;
+        break;
+    case CommissionerState::kStateRejected:
+        hasTimer = true;
+        deadline = mTimerTime;
+        break;
+    default:
+        break;
+    }
+
+    if (hasTimer)
+    {
+        unsigned long now   = GetNow();
+        long          delay = static_cast<long>(deadline - now);
+
+        if (delay < 0)
         {
-            mPetitionRetryCount++;
-            CommissionerPetition();
+            delay = 0;
         }
-        else
+
+        if (static_cast<unsigned long>(delay) < GetTimestamp(aMainloop.mTimeout))
         {
-            mCommissionerState  = CommissionerState::kStateInvalid;
-            mPetitionRetryCount = 0;
+            aMainloop.mTimeout.tv_sec  = static_cast<time_t>(delay / 1000);
+            aMainloop.mTimeout.tv_usec = static_cast<suseconds_t>((delay % 1000) * 1000);
         }
     }
-}
 
-void Commissioner::UpdateFdSet(fd_set & aReadFdSet,
-                               fd_set & aWriteFdSet,
-                               fd_set & aErrorFdSet,
-                               int &    aMaxFd,
-                               timeval &aTimeout)
-{
-    FD_SET(mSslClientFd.fd, &aReadFdSet);
-    aMaxFd = Utils::Max(mSslClientFd.fd, aMaxFd);
-    FD_SET(mJoinerSessionClientFd, &aReadFdSet);
-    aMaxFd = Utils::Max(mJoinerSessionClientFd, aMaxFd);
-    if (mJoinerSession)
+    mCoapAgent->UpdateTimeout(aMainloop.mTimeout);
+    for (size_t i = 0; i < mJoiners.size(); ++i)
     {
-        mJoinerSession->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+        Joiner &joiner = mJoiners[i];
+
+        if (joiner.mSession != NULL)
+        {
+            FD_SET(joiner.mClientFd, &aMainloop.mReadFdSet);
+            aMainloop.mMaxFd = Utils::Max(joiner.mClientFd, aMainloop.mMaxFd);
+            joiner.mSession->UpdateTimeout(aMainloop.mTimeout);
+        }
     }
 }
 
-void Commissioner::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void Commissioner::Process(const otSysMainloopContext &aMainloop)
 {
     uint8_t buffer[kSizeMaxPacket];
-    timeval nowTime;
 
-    if (mJoinerSession)
+    ProcessDtls(aMainloop.mReadFdSet);
+
+    for (size_t i = 0; i < mJoiners.size(); ++i)
     {
-        mJoinerSession->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+        Joiner &joiner = mJoiners[i];
+
+        if (joiner.mSession == NULL)
+        {
+            continue;
+        }
+
+        joiner.mSession->Process();
+
+        if (FD_ISSET(joiner.mClientFd, &aMainloop.mReadFdSet))
+        {
+            ssize_t n = recv(joiner.mClientFd, buffer, sizeof(buffer), 0);
+
+            if (n > 0)
+            {
+                SendRelayTransmit(joiner, buffer, static_cast<uint16_t>(n));
+            }
+        }
+
+        if (joiner.mSession->IsEnded() || static_cast<long>(GetNow() - joiner.mLastActiveTime) >= kJoinerTimeout)
+        {
+            otbrLog(OTBR_LOG_INFO, "relay: joiner on port %zu done", mJoinerPort + i);
+            ReleaseJoiner(joiner);
+        }
     }
-    if (FD_ISSET(mSslClientFd.fd, &aReadFdSet))
+
+    if (mCommissionerState != CommissionerState::kStateInvalid &&
+        mCommissionerState != CommissionerState::kStateConnecting)
     {
-        int n = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer));
+        mCoapAgent->Process();
+        ProcessTimer();
+    }
+}
 
-        if (n > 0)
+void Commissioner::ProcessDtls(const fd_set &aReadFdSet)
+{
+    uint8_t buffer[kSizeMaxPacket];
+    bool    readable;
+
+    VerifyOrExit(mCommissionerState != CommissionerState::kStateInvalid);
+
+    readable = FD_ISSET(mSslClientFd.fd, &aReadFdSet);
+
+    if (mCommissionerState == CommissionerState::kStateConnecting)
+    {
+        if (readable || GetDelay() == 2)
         {
-            mCoapAgent->Input(buffer, static_cast<uint16_t>(n), NULL, 0);
+            TryDtlsHandshake();
         }
+        ExitNow();
     }
 
-    if (FD_ISSET(mJoinerSessionClientFd, &aReadFdSet))
+    VerifyOrExit(readable);
+
+    // Drain the socket, it is not readable again for datagrams already buffered by mbedtls.
+    for (;;)
     {
-        struct sockaddr_in from_addr;
-        socklen_t          addrlen = sizeof(from_addr);
+        int n = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer));
 
-        ssize_t n =
-            recvfrom(mJoinerSessionClientFd, buffer, sizeof(buffer), 0, (struct sockaddr *)(&from_addr), &addrlen);
         if (n > 0)
         {
+            mCoapAgent->Input(buffer, static_cast<uint16_t>(n), NULL, 0);
+        }
+        else
+        {
+            if (n != 0 && n != MBEDTLS_ERR_SSL_WANT_READ && n != MBEDTLS_ERR_SSL_WANT_WRITE)
             {
-                char buf[kIPAddrNameBufSize];
-                GetIPString((struct sockaddr *)(&from_addr), buf, sizeof(buf));
-                otbrLog(OTBR_LOG_INFO, "relay from: %s\n", buf);
+                otbrLog(OTBR_LOG_ERR, "dtls read fails with %d", n);
+                mCommissionerState = CommissionerState::kStateInvalid;
             }
-            SendRelayTransmit(buffer, static_cast<uint16_t>(n));
+            break;
         }
     }
-    gettimeofday(&nowTime, NULL);
-    if (mCommissionerState == CommissionerState::kStateAccepted && mKeepAliveRate > 0 &&
-        nowTime.tv_sec - mLastKeepAliveTime.tv_sec > mKeepAliveRate)
+
+exit:
+    return;
+}
+
+void Commissioner::ProcessTimer(void)
+{
+    VerifyOrExit(static_cast<long>(mTimerTime - GetNow()) <= 0);
+
+    switch (mCommissionerState)
     {
+    case CommissionerState::kStateRejected:
+        CommissionerPetition();
+        break;
+
+    case CommissionerState::kStateAccepted:
+        VerifyOrExit(mKeepAliveRate > 0);
+        if (mKeepAliveTxCount - mKeepAliveRxCount >= kKeepAliveMaxMissed)
+        {
+            otbrLog(OTBR_LOG_WARNING, "COMM_KA.rsp: %d keep alives missed", mKeepAliveTxCount - mKeepAliveRxCount);
+            mCommissionerState = CommissionerState::kStateInvalid;
+            ExitNow();
+        }
         SendCommissionerKeepAlive(static_cast<int8_t>(Meshcop::kStateAccepted));
+        ScheduleKeepAlive();
+        break;
+
+    default:
+        break;
     }
+
+exit:
+    return;
 }
 
 void Commissioner::Resign(void)
 {
     if (mCommissionerState == CommissionerState::kStateAccepted)
     {
-        SendCommissionerKeepAlive(static_cast<int8_t>(Meshcop::kStateRejected));
+        // Over once the leader answers, or the CoAP agent gives up retransmitting.
+        mCommissionerState = CommissionerState::kStateResigning;
+
+        if (SendCommissionerKeepAlive(static_cast<int8_t>(Meshcop::kStateRejected)) != OTBR_ERROR_NONE)
+        {
+            mCommissionerState = CommissionerState::kStateInvalid;
+        }
     }
 }
 
-void Commissioner::SendCommissionerKeepAlive(int8_t aState)
+otbrError Commissioner::SendCommissionerKeepAlive(int8_t aState)
 {
+    otbrError      ret;
     uint8_t        buffer[kSizeMaxPacket];
     Tlv *          tlv = reinterpret_cast<Tlv *>(buffer);
     Coap::Message *message;
@@ -476,28 +830,45 @@ void Commissioner::SendCommissionerKeepAlive(int8_t aState)
     message->SetPayload(buffer, Utils::LengthOf(buffer, tlv));
 
     otbrLog(OTBR_LOG_INFO, "COMM_KA.req: send");
-    gettimeofday(&mLastKeepAliveTime, NULL);
     mKeepAliveTxCount += 1;
-    mCoapAgent->Send(*message, NULL, 0, HandleCommissionerKeepAlive, this);
+    ret = mCoapAgent->Send(*message, NULL, 0, HandleCommissionerKeepAlive, this);
     mCoapAgent->FreeMessage(message);
+
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "COMM_KA.req: failed: %s", strerror(errno));
+    }
+
+    return ret;
 }
 
 /** Handle a COMM_KA response */
-void Commissioner::HandleCommissionerKeepAlive(const Coap::Message &aMessage, void *aContext)
+void Commissioner::HandleCommissionerKeepAlive(const Coap::Message *aMessage, otbrError aError, void *aContext)
 {
     uint16_t       length;
     int            tlvType;
     const Tlv *    tlv;
     const uint8_t *payload;
     Commissioner * commissioner = static_cast<Commissioner *>(aContext);
+    bool           resigning    = (commissioner->mCommissionerState == CommissionerState::kStateResigning);
+
+    if (aError != OTBR_ERROR_NONE)
+    {
+        // Missed keep alives are counted by the timer, a resignation is over once given up.
+        otbrLog(OTBR_LOG_WARNING, "COMM_KA.rsp: failed: %s", strerror(errno));
+        if (resigning)
+        {
+            commissioner->mCommissionerState = CommissionerState::kStateInvalid;
+        }
+        ExitNow();
+    }
 
     otbrLog(OTBR_LOG_INFO, "COMM_KA.rsp: start");
 
     /* record stats */
-    gettimeofday(&commissioner->mLastKeepAliveTime, NULL);
     commissioner->mKeepAliveRxCount += 1;
 
-    payload = (aMessage.GetPayload(length));
+    payload = (aMessage->GetPayload(length));
     tlv     = reinterpret_cast<const Tlv *>(payload);
 
     while (Utils::LengthOf(payload, tlv) < length)
@@ -530,7 +901,17 @@ void Commissioner::HandleCommissionerKeepAlive(const Coap::Message &aMessage, vo
     }
     otbrLog(OTBR_LOG_INFO, "COMM_KA.rsp: complete");
 
-    commissioner->CommissionerResponseNext();
+    if (resigning)
+    {
+        commissioner->mCommissionerState = CommissionerState::kStateInvalid;
+    }
+    else if (commissioner->mCommissionerState == CommissionerState::kStateRejected)
+    {
+        commissioner->RetryPetition();
+    }
+
+exit:
+    return;
 }
 
 void Commissioner::HandleRelayReceive(const Coap::Resource &aResource,
@@ -543,8 +924,13 @@ void Commissioner::HandleRelayReceive(const Coap::Resource &aResource,
     int            ret = 0;
     int            tlvType;
     uint16_t       length;
-    Commissioner * commissioner = static_cast<Commissioner *>(aContext);
-    const uint8_t *payload      = aMessage.GetPayload(length);
+    Commissioner * commissioner  = static_cast<Commissioner *>(aContext);
+    const uint8_t *payload       = aMessage.GetPayload(length);
+    const Tlv *    dtlsTlv       = NULL;
+    const uint8_t *iid           = NULL;
+    uint16_t       udpPort       = 0;
+    uint16_t       routerLocator = 0;
+    Joiner *       joiner;
 
     for (const Tlv *requestTlv = reinterpret_cast<const Tlv *>(payload); Utils::LengthOf(payload, requestTlv) < length;
          requestTlv            = requestTlv->GetNext())
@@ -553,27 +939,24 @@ void Commissioner::HandleRelayReceive(const Coap::Resource &aResource,
         switch (tlvType)
         {
         case Meshcop::kJoinerDtlsEncapsulation:
-            ret = static_cast<int>(
-                send(commissioner->mJoinerSessionClientFd, requestTlv->GetValue(), requestTlv->GetLength(), 0));
-            if (ret < 0)
-            {
-                otbrLog(OTBR_LOG_ERR, "relay receive, sendto() fails with %d", errno);
-            }
-            VerifyOrExit(ret != -1, ret = errno);
+            dtlsTlv = requestTlv;
             break;
 
         case Meshcop::kJoinerUdpPort:
-            commissioner->mJoinerUdpPort = requestTlv->GetValueUInt16();
-            otbrLog(OTBR_LOG_INFO, "JoinerPort: %d", commissioner->mJoinerUdpPort);
+            udpPort = requestTlv->GetValueUInt16();
+            otbrLog(OTBR_LOG_INFO, "JoinerPort: %d", udpPort);
             break;
 
         case Meshcop::kJoinerIid:
-            memcpy(commissioner->mJoinerIid, requestTlv->GetValue(), sizeof(commissioner->mJoinerIid));
+            if (requestTlv->GetLength() == kJoinerIidLength)
+            {
+                iid = static_cast<const uint8_t *>(requestTlv->GetValue());
+            }
             break;
 
         case Meshcop::kJoinerRouterLocator:
-            commissioner->mJoinerRouterLocator = requestTlv->GetValueUInt16();
-            otbrLog(OTBR_LOG_INFO, "Router locator: %d", commissioner->mJoinerRouterLocator);
+            routerLocator = requestTlv->GetValueUInt16();
+            otbrLog(OTBR_LOG_INFO, "Router locator: %d", routerLocator);
             break;
 
         default:
@@ -582,6 +965,24 @@ void Commissioner::HandleRelayReceive(const Coap::Resource &aResource,
         }
     }
 
+    VerifyOrExit(dtlsTlv != NULL && iid != NULL, otbrLog(OTBR_LOG_WARNING, "relay receive, missing tlv"));
+
+    // Joiners are told apart by IID, each relayed to its own session.
+    if ((joiner = commissioner->FindJoiner(iid)) == NULL)
+    {
+        VerifyOrExit((joiner = commissioner->NewJoiner(iid)) != NULL);
+    }
+
+    joiner->mUdpPort        = udpPort;
+    joiner->mRouterLocator  = routerLocator;
+    joiner->mLastActiveTime = GetNow();
+
+    ret = static_cast<int>(send(joiner->mClientFd, dtlsTlv->GetValue(), dtlsTlv->GetLength(), 0));
+    if (ret < 0)
+    {
+        otbrLog(OTBR_LOG_ERR, "relay receive, sendto() fails with %d", errno);
+    }
+
 exit:
 
     (void)aResource;
@@ -592,7 +993,7 @@ exit:
     return;
 }
 
-ssize_t Commissioner::SendRelayTransmit(uint8_t *aBuf, size_t aLength)
+ssize_t Commissioner::SendRelayTransmit(Joiner &aJoiner, uint8_t *aBuf, size_t aLength)
 {
     uint8_t payload[kSizeMaxPacket];
     Tlv *   responseTlv = reinterpret_cast<Tlv *>(payload);
@@ -602,25 +1003,25 @@ ssize_t Commissioner::SendRelayTransmit(uint8_t *aBuf, size_t aLength)
     responseTlv = responseTlv->GetNext();
 
     responseTlv->SetType(Meshcop::kJoinerUdpPort);
-    responseTlv->SetValue(mJoinerUdpPort);
+    responseTlv->SetValue(aJoiner.mUdpPort);
     responseTlv = responseTlv->GetNext();
 
     responseTlv->SetType(Meshcop::kJoinerIid);
-    responseTlv->SetValue(mJoinerIid, sizeof(mJoinerIid));
+    responseTlv->SetValue(aJoiner.mIid, sizeof(aJoiner.mIid));
     responseTlv = responseTlv->GetNext();
 
     responseTlv->SetType(Meshcop::kJoinerRouterLocator);
-    responseTlv->SetValue(mJoinerRouterLocator);
+    responseTlv->SetValue(aJoiner.mRouterLocator);
     responseTlv = responseTlv->GetNext();
 
-    assert(mJoinerSession != NULL);
+    assert(aJoiner.mSession != NULL);
 
-    if (mJoinerSession->NeedAppendKek())
+    if (aJoiner.mSession->NeedAppendKek())
     {
         uint8_t kek[kKEKSize];
 
-        mJoinerSession->GetKek(kek, sizeof(kek));
-        mJoinerSession->MarkKekSent();
+        aJoiner.mSession->GetKek(kek, sizeof(kek));
+        aJoiner.mSession->MarkKekSent();
         otbrLog(OTBR_LOG_INFO, "relay: KEK state");
         responseTlv->SetType(Meshcop::kJoinerRouterKek);
         responseTlv->SetValue(kek, sizeof(kek));
@@ -628,6 +1029,8 @@ ssize_t Commissioner::SendRelayTransmit(uint8_t *aBuf, size_t aLength)
         mNumFinializeJoiners++;
     }
 
+    aJoiner.mLastActiveTime = GetNow();
+
     {
         Coap::Message *message;
         uint16_t       token = ++mCoapToken;
@@ -669,12 +1072,14 @@ Commissioner::~Commissioner(void)
         mbedtls_entropy_free(&mEntropy);
     }
 
-    if (mJoinerSession)
+    for (size_t i = 0; i < mJoiners.size(); ++i)
     {
-        delete mJoinerSession;
+        if (mJoiners[i].mSession != NULL)
+        {
+            ReleaseJoiner(mJoiners[i]);
+        }
     }
 
-    close(mJoinerSessionClientFd);
     Coap::Agent::Destroy(mCoapAgent);
 }
 
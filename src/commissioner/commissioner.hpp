@@ -29,6 +29,10 @@
 /**
  * @file
  *   The file is the header for the commissioner class
+ *
+ *   The commissioner is driven by the event loop without ever blocking, so that one process may run several of them
+ *   along with other services. Its own sockets go through UpdateFdSet() and Process(), while the dtls servers of
+ *   joiners are registered with the event loop.
  */
 
 #ifndef OTBR_COMMISSIONER_HPP_
@@ -51,61 +55,76 @@
 #include <mbedtls/error.h>
 #include <mbedtls/net_sockets.h>
 #include <mbedtls/ssl.h>
-#include <mbedtls/timing.h>
 #include <sys/time.h>
 
+#include <string>
+#include <vector>
+
 #include "commissioner_constants.hpp"
 #include "joiner_session.hpp"
 #include "common/coap.hpp"
+#include "common/event_loop.hpp"
 #include "utils/pskc.hpp"
 #include "utils/steering_data.hpp"
 
 namespace ot {
 namespace BorderRouter {
 
-class Commissioner
+class Commissioner : public MainloopProcessor
 {
 public:
     /**
      * The constructor to initialize Commissioner
      *
+     * @param[in]    aEventLoop         event loop serving the dtls servers of joiners
      * @param[in]    aPskcBin           binary form of pskc
      * @param[in]    aKeepAliveRate     send keep alive packet every aKeepAliveRate seconds
+     * @param[in]    aMaxJoiners        max number of joiners commissioned concurrently
+     * @param[in]    aJoinerPort        first port of internal dtls servers of joiners, one port per joiner
      *
      */
-    Commissioner(const uint8_t *aPskcBin, int aKeepAliveRate);
+    Commissioner(EventLoop &    aEventLoop,
+                 const uint8_t *aPskcBin,
+                 int            aKeepAliveRate,
+                 size_t         aMaxJoiners,
+                 uint16_t       aJoinerPort);
 
     /**
-     * This method sets the joiner to join the thread network
+     * This method sets the joiners to join the thread network
      *
-     * @param[in]    aPskdAscii         ascii form of pskd
+     * @param[in]    aPskdAscii         ascii form of pskd of joiners not added by AddJoiner(), NULL for none
      * @param[in]    aSteeringData      steering data to filter joiner
      *
      */
     void SetJoiner(const char *aPskdAscii, const SteeringData &aSteeringData);
 
     /**
-     * This method updates the fd_set and timeout for mainloop.
-     * @p aTimeout should only be updated if session has pending process in less than its current value.
+     * This method adds a joiner with its own pskd
      *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
-     * @param[inout]    aTimeout        A reference to the timeout.
+     * @param[in]    aEui64             EUI64 of the joiner
+     * @param[in]    aPskdAscii         ascii form of pskd
+     *
+     * @retval OTBR_ERROR_NONE      Successfully added the joiner.
+     * @retval OTBR_ERROR_ERRNO     Failed to add the joiner, errno is set to EINVAL if the pskd is too long.
      *
      */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+    otbrError AddJoiner(const uint8_t *aEui64, const char *aPskdAscii);
+
+    /**
+     * This method updates the file descriptor sets and timeout for mainloop.
+     *
+     * @param[inout]    aMainloop   A reference to OpenThread mainloop context.
+     *
+     */
+    virtual void UpdateFdSet(otSysMainloopContext &aMainloop);
 
     /**
      * This method performs the session processing.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     * @param[in]       aMainloop   A reference to OpenThread mainloop context.
      *
      */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    virtual void Process(const otSysMainloopContext &aMainloop);
 
     /**
      * This method returns whether the commissioner is valid
@@ -124,7 +143,9 @@ public:
     bool IsCommissionerAccepted(void) const { return mCommissionerState == CommissionerState::kStateAccepted; }
 
     /**
-     * This method initialize the dtls session
+     * This method initialize the dtls session and starts the handshake
+     *
+     * The handshake, the petition and keep-alives then go on in Process().
      *
      * @param[in]   aHost      Address of border agent service
      * @param[in]   aPort      Port of border agent service
@@ -135,20 +156,12 @@ public:
     int InitDtls(const char *aHost, const char *aPort);
 
     /**
-     * This method initialize the dtls session
+     * This method gracefully resigns as commissioner
      *
-     * @returns 0 on success,
-     *          MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE for pending, in which case
-     *          you need to call this method again,
-     *          or other SSL error code on failure
-     */
-    int TryDtlsHandshake(void);
-
-    /**
-     * This method sends commissioner petition coap request
+     * The commissioner becomes invalid once the leader acknowledges, or after a timeout.
      *
      */
-    void CommissionerPetition(void);
+    void Resign(void);
 
     /**
      * This method gets number of nodes joined through commissioner
@@ -158,6 +171,14 @@ public:
      */
     int GetNumFinalizedJoiners(void) const;
 
+    /**
+     * This method gets number of joiners being commissioned
+     *
+     * @returns number of joiners with a session in progress
+     *
+     */
+    size_t GetNumActiveJoiners(void) const;
+
     ~Commissioner(void);
 
 private:
@@ -170,24 +191,49 @@ private:
     void CommissionerSet(const SteeringData &aSteeringData);
 
     /**
-     * This method gracefully resigns as commissioner
+     * This method sends commissioner petition coap request
      *
      */
-    void Resign(void);
+    void CommissionerPetition(void);
 
+    /**
+     * This method continues the dtls handshake
+     *
+     * @returns 0 on success,
+     *          MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE for pending, in which case
+     *          it is called again when data arrive or the retransmission timer fires,
+     *          or other SSL error code on failure
+     */
+    int TryDtlsHandshake(void);
+
+    /**
+     * The states are driven by responses of the leader and by a single timer, whose meaning depends on the state.
+     * Requests are retransmitted by the CoAP agent, whose response handlers learn when the leader is given up.
+     *
+     */
     enum class CommissionerState
     {
         kStateInvalid = 0, ///< uninitialized, encounter network error or petition exceeds max retry
-        kStateConnected,   ///< dtls connection setup done
-        kStateAccepted,    ///< commissioner petition succeeded
-        kStateRejected,    ///< rejected by leader, still retrying petition
+        kStateConnecting,  ///< dtls handshake in progress, timer of mbedtls
+        kStateConnected,   ///< dtls connection setup done, waiting for the petition response
+        kStateAccepted,    ///< commissioner petition succeeded, timer for next keep alive
+        kStateRejected,    ///< rejected by leader, timer for next petition
+        kStateResigning,   ///< resign sent, waiting for the response
     } mCommissionerState;
 
     Commissioner(const Commissioner &);
     Commissioner &operator=(const Commissioner &);
 
-    int  DtlsHandShake(const sockaddr_in &aAgentAddr);
-    void SendCommissionerKeepAlive(int8_t aState);
+    otbrError SendCommissionerKeepAlive(int8_t aState);
+    void      RetryPetition(void);
+    void      ScheduleKeepAlive(void);
+    void      ProcessTimer(void);
+    void      ProcessDtls(const fd_set &aReadFdSet);
+
+    static void SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal);
+    void        SetDelay(uint32_t aIntermediate, uint32_t aFinal);
+    static int  GetDelay(void *aContext);
+    int         GetDelay(void) const;
 
     static ssize_t SendCoap(const uint8_t *aBuffer,
                             uint16_t       aLength,
@@ -197,10 +243,34 @@ private:
 
     static void LogMeshcopState(const char *aPrefix, int8_t aState);
 
-    static void HandleCommissionerPetition(const Coap::Message &aMessage, void *aContext);
-    static void HandleCommissionerSet(const Coap::Message &aMessage, void *aContext);
-    static void HandleCommissionerKeepAlive(const Coap::Message &aMessage, void *aContext);
-    void        CommissionerResponseNext(void);
+    static void HandleCommissionerPetition(const Coap::Message *aMessage, otbrError aError, void *aContext);
+    static void HandleCommissionerSet(const Coap::Message *aMessage, otbrError aError, void *aContext);
+    static void HandleCommissionerKeepAlive(const Coap::Message *aMessage, otbrError aError, void *aContext);
+
+    /**
+     * A joiner being commissioned, relayed to its own session with the internal dtls server of its own.
+     *
+     */
+    struct Joiner
+    {
+        JoinerSession *mSession; ///< NULL if the entry is free
+        int            mClientFd;
+        uint16_t       mUdpPort;
+        uint8_t        mIid[kJoinerIidLength];
+        uint16_t       mRouterLocator;
+        unsigned long  mLastActiveTime;
+    };
+
+    struct JoinerPskd
+    {
+        uint8_t     mJoinerId[SteeringData::kSizeJoinerId];
+        std::string mPskd;
+    };
+
+    Joiner *    FindJoiner(const uint8_t *aIid);
+    Joiner *    NewJoiner(const uint8_t *aIid);
+    void        ReleaseJoiner(Joiner &aJoiner);
+    const char *GetJoinerPskd(const uint8_t *aIid) const;
 
     static void HandleRelayReceive(const Coap::Resource &aResource,
                                    const Coap::Message & aMessage,
@@ -208,15 +278,18 @@ private:
                                    const uint8_t *       aIp6,
                                    uint16_t              aPort,
                                    void *                aContext);
-    ssize_t     SendRelayTransmit(uint8_t *aBuf, size_t aLength);
+    ssize_t     SendRelayTransmit(Joiner &aJoiner, uint8_t *aBuf, size_t aLength);
 
+    EventLoop &                  mEventLoop;
     mbedtls_net_context          mSslClientFd;
     mbedtls_ssl_context          mSsl;
     mbedtls_entropy_context      mEntropy;
     mbedtls_ctr_drbg_context     mDrbg;
     mbedtls_ssl_config           mSslConf;
-    mbedtls_timing_delay_context mTimer;
     bool                         mDtlsInitDone;
+    bool                         mDtlsTimerSet;
+    unsigned long                mDtlsIntermediate;
+    unsigned long                mDtlsFinal;
 
     Coap::Agent *  mCoapAgent;
     uint16_t       mCoapToken;
@@ -226,25 +299,22 @@ private:
     int      mPetitionRetryCount;
     uint16_t mCommissionerSessionId;
 
-    JoinerSession *mJoinerSession;
-    int            mJoinerSessionClientFd;
-    uint16_t       mJoinerUdpPort;
-    uint8_t        mJoinerIid[8];
-    uint16_t       mJoinerRouterLocator;
+    std::vector<Joiner>     mJoiners;
+    std::vector<JoinerPskd> mJoinerPskds;
+    std::string             mDefaultPskd;
+    uint16_t                mJoinerPort;
 
-    int     mKeepAliveRate;
-    timeval mLastKeepAliveTime;
-    int     mKeepAliveTxCount;
-    int     mKeepAliveRxCount;
+    int           mKeepAliveRate;
+    unsigned long mTimerTime;
+    int           mKeepAliveTxCount;
+    int           mKeepAliveRxCount;
 
     int mNumFinializeJoiners;
 
-    static const uint16_t kPortJoinerSession;
-    static const uint8_t  kSeed[];
-    static const int      kCipherSuites[];
-    static const char     kCommissionerId[];
-    static const int      kCoapResponseWaitSecond;
-    static const int      kCoapResponseRetryTime;
+    static const uint8_t kSeed[];
+    static const int     kCipherSuites[];
+    static const char    kCommissionerId[];
+    static const int     kKeepAliveMaxMissed;
 };
 
 } // namespace BorderRouter
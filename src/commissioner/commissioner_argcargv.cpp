@@ -115,8 +115,10 @@ static void PrintUsage(const char *aProgram, FILE *aStream, int aExitCode)
             "    -C, --network-password     STRING      Thread network password\n"
             "    -X, --xpanid               HEX         Extended PAN ID in hex\n"
             "    -A, --allow-all                        Allow all joiners\n"
-            "    -E, --joiner-eui64         HEX         Joiner EUI64 value\n"
+            "    -E, --joiner-eui64         HEX[:STRING]\n"
+            "                                           Joiner EUI64 value, and its own PSKd if any, repeatable\n"
             "    -D, --joiner-pskd          STRING      Joiner's base32-thread encoded PSK\n"
+            "    -J, --max-joiners          NUMBER      Max joiners commissioned concurrently\n"
             "    -L, --steering-data-length NUMBER      Steering data length(1~16)\n"
             "    -l, --log-file             PATH        Log to file\n"
             "    -i, --keep-alive-interval  NUMBER      COMM_KA requests interval\n"
@@ -133,6 +135,7 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
     static struct option options[] = {{"joiner-eui64", required_argument, NULL, 'E'},
                                       {"joiner-pskd", required_argument, NULL, 'D'},
                                       {"allow-all", no_argument, NULL, 'A'},
+                                      {"max-joiners", required_argument, NULL, 'J'},
                                       {"network-password", required_argument, NULL, 'C'},
                                       {"network-name", required_argument, NULL, 'N'},
                                       {"xpanid", required_argument, NULL, 'X'},
@@ -147,19 +150,18 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
                                       {0, 0, 0, 0}};
 
     uint8_t     xPanId[kXPanIdLength];
-    uint8_t     joinerEui64[kEui64Len];
     otbrError   error           = OTBR_ERROR_ERRNO;
     const char *networkName     = NULL;
     const char *networkPassword = NULL;
     int         steeringLength  = 0;
     bool        isXPanIdSet     = false;
-    bool        isEui64Set      = false;
     bool        allowAllJoiners = false;
 
     memset(&aArgs, 0, sizeof(aArgs));
 
     aArgs.mKeepAliveInterval = 15;
     aArgs.mDebugLevel        = OTBR_LOG_ERR;
+    aArgs.mMaxJoiners        = kMaxJoiners;
 
     if (aArgc == 1)
     {
@@ -168,7 +170,7 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
 
     while (true)
     {
-        int option = getopt_long(aArgc, aArgv, "E:D:AC:N:X:H:P:L:l:qd:i:h", options, NULL);
+        int option = getopt_long(aArgc, aArgv, "E:D:AJ:C:N:X:H:P:L:l:qd:i:h", options, NULL);
 
         if (option == -1)
         {
@@ -178,10 +180,24 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
         switch (option)
         {
         case 'E':
-            isEui64Set = true;
-            VerifyOrExit(sizeof(joinerEui64) == Utils::Hex2Bytes(optarg, joinerEui64, sizeof(joinerEui64)),
+        {
+            char *      pskd   = strchr(optarg, ':');
+            JoinerArgs *joiner = &aArgs.mJoiners[aArgs.mNumJoiners];
+
+            VerifyOrExit(aArgs.mNumJoiners < kMaxJoinerEui64s, fprintf(stderr, "Too many joiner EUI64s!"));
+
+            if (pskd != NULL)
+            {
+                *pskd++ = '\0';
+                VerifyOrExit(CheckPSKd(pskd));
+            }
+
+            VerifyOrExit(sizeof(joiner->mEui64) == Utils::Hex2Bytes(optarg, joiner->mEui64, sizeof(joiner->mEui64)),
                          fprintf(stderr, "Invalid joiner EUI64!"));
+            joiner->mPSKd = pskd;
+            aArgs.mNumJoiners++;
             break;
+        }
         case 'D':
             aArgs.mPSKd = optarg;
             VerifyOrExit(CheckPSKd(aArgs.mPSKd));
@@ -189,6 +205,11 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
         case 'A':
             allowAllJoiners = true;
             break;
+        case 'J':
+            aArgs.mMaxJoiners = atoi(optarg);
+            VerifyOrExit(aArgs.mMaxJoiners >= 1 && aArgs.mMaxJoiners <= kMaxJoinerEui64s,
+                         fprintf(stderr, "Max joiners must be between 1 and %d!", kMaxJoinerEui64s));
+            break;
         case 'C':
         {
             size_t len = strlen(optarg);
@@ -248,7 +269,15 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
         }
     }
 
-    VerifyOrExit(aArgs.mPSKd != NULL, fprintf(stderr, "Missing joiner PSKd!"));
+    if (aArgs.mPSKd == NULL)
+    {
+        VerifyOrExit(!allowAllJoiners && aArgs.mNumJoiners > 0, fprintf(stderr, "Missing joiner PSKd!"));
+
+        for (int i = 0; i < aArgs.mNumJoiners; i++)
+        {
+            VerifyOrExit(aArgs.mJoiners[i].mPSKd != NULL, fprintf(stderr, "Missing joiner PSKd!"));
+        }
+    }
     VerifyOrExit(networkName != NULL, fprintf(stderr, "Missing network name!"));
     VerifyOrExit(networkPassword != NULL, fprintf(stderr, "Missing network password!"));
     VerifyOrExit(isXPanIdSet, fprintf(stderr, "Missing extended PAN ID!"));
@@ -262,11 +291,15 @@ otbrError ParseArgs(int aArgc, char *aArgv[], CommissionerArgs &aArgs)
 
     if (!allowAllJoiners)
     {
-        VerifyOrExit(aArgs.mPSKd != NULL, fprintf(stderr, "Missing PSKd!"));
-        VerifyOrExit(isEui64Set, fprintf(stderr, "Missing EUI64!"));
+        VerifyOrExit(aArgs.mNumJoiners > 0, fprintf(stderr, "Missing EUI64!"));
 
-        aArgs.mSteeringData.ComputeJoinerId(joinerEui64, joinerEui64);
-        aArgs.mSteeringData.ComputeBloomFilter(joinerEui64);
+        for (int i = 0; i < aArgs.mNumJoiners; i++)
+        {
+            uint8_t joinerId[SteeringData::kSizeJoinerId];
+
+            aArgs.mSteeringData.ComputeJoinerId(aArgs.mJoiners[i].mEui64, joinerId);
+            aArgs.mSteeringData.ComputeBloomFilter(joinerId);
+        }
     }
     else
     {
@@ -43,6 +43,12 @@
 namespace ot {
 namespace BorderRouter {
 
+struct JoinerArgs
+{
+    uint8_t     mEui64[kEui64Len];
+    const char *mPSKd; ///< NULL to use the PSKd of all joiners
+};
+
 struct CommissionerArgs
 {
     const char *mAgentPort;
@@ -51,6 +57,10 @@ struct CommissionerArgs
     const char *mPSKd;
     uint8_t     mPSKc[kPSKcLength];
 
+    JoinerArgs mJoiners[kMaxJoinerEui64s];
+    int        mNumJoiners;
+    int        mMaxJoiners;
+
     SteeringData mSteeringData;
     int          mKeepAliveInterval;
 
@@ -46,6 +46,8 @@ enum
 {
     kSizeMaxPacket = 1500, ///< max size of a network packet
 
+    kCoapBlockSize = 512, ///< CoAP block size, leaves room for DTLS and relay headers within the 1280-byte Thread MTU
+
     kPetitionAttemptDelay = 5, ///< delay between failed attempts to petition
 
     kPetitionMaxRetry = 2, ///< max retry for petition
@@ -76,6 +78,14 @@ enum
     kMbedDtlsHandshakeMaxTimeout = 60000, ///< dtls handshake min timeout
 
     kKEKSize = 32, ///< key encrypted key(KEK) size
+
+    kJoinerIidLength = 8, ///< joiner IID length in bytes
+
+    kMaxJoiners = 8, ///< default max number of joiners commissioned concurrently
+
+    kMaxJoinerEui64s = 64, ///< max number of joiner EUI64s on the command line
+
+    kJoinerTimeout = 120000, ///< joiners silent for so many milliseconds are dropped
 };
 
 } // namespace BorderRouter
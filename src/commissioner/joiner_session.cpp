@@ -40,14 +40,20 @@
 namespace ot {
 namespace BorderRouter {
 
-JoinerSession::JoinerSession(uint16_t aInternalServerPort, const char *aPskdAscii)
-    : mDtlsServer(Dtls::Server::Create(aInternalServerPort, JoinerSession::HandleSessionChange, this))
+JoinerSession::JoinerSession(EventLoop &aEventLoop, uint16_t aInternalServerPort, const char *aPskdAscii)
+    : mDtlsServer(Dtls::Server::Create(aEventLoop, aInternalServerPort, JoinerSession::HandleSessionChange, this))
+    , mDtlsSession(NULL)
     , mCoapAgent(Coap::Agent::Create(JoinerSession::SendCoap, this))
     , mJoinerFinalizeHandler(OT_URI_PATH_JOINER_FINALIZE, HandleJoinerFinalize, this)
     , mNeedAppendKek(false)
+    , mEnded(false)
 {
     mDtlsServer->SetPSK(reinterpret_cast<const uint8_t *>(aPskdAscii), static_cast<uint8_t>(strlen(aPskdAscii)));
-    mDtlsServer->Start();
+    if (mDtlsServer->Start() != OTBR_ERROR_NONE)
+    {
+        mEnded = true;
+    }
+    mCoapAgent->SetBlockSize(kCoapBlockSize);
     mCoapAgent->AddResource(mJoinerFinalizeHandler);
 }
 
@@ -68,7 +74,9 @@ void JoinerSession::HandleSessionChange(Dtls::Session &aSession, Dtls::Session::
 
     case Dtls::Session::kStateError:
     case Dtls::Session::kStateEnd:
+    case Dtls::Session::kStateExpired:
         joinerSession->mDtlsSession = NULL;
+        joinerSession->mEnded       = true;
         break;
     default:
         break;
@@ -133,18 +141,14 @@ void JoinerSession::HandleJoinerFinalize(const Coap::Resource &aResource,
     (void)aPort;
 }
 
-void JoinerSession::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void JoinerSession::Process(void)
 {
-    mDtlsServer->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    mCoapAgent->Process();
 }
 
-void JoinerSession::UpdateFdSet(fd_set & aReadFdSet,
-                                fd_set & aWriteFdSet,
-                                fd_set & aErrorFdSet,
-                                int &    aMaxFd,
-                                timeval &aTimeout)
+void JoinerSession::UpdateTimeout(timeval &aTimeout)
 {
-    mDtlsServer->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+    mCoapAgent->UpdateTimeout(aTimeout);
 }
 
 bool JoinerSession::NeedAppendKek(void)
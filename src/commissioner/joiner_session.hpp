@@ -39,6 +39,7 @@
 #include "commissioner_constants.hpp"
 #include "common/coap.hpp"
 #include "common/dtls.hpp"
+#include "common/event_loop.hpp"
 #include "utils/pskc.hpp"
 
 namespace ot {
@@ -50,34 +51,27 @@ public:
     /**
      * The constructor to initialize JoinerSession
      *
+     * @param[in]    aEventLoop             event loop serving the internal dtls server
      * @param[in]    aInternalServerPort    port for internal dtls server to listen to
      * @param[in]    aPskdAscii             ascii form of pskd
      *
      */
-    JoinerSession(uint16_t aInternalServerPort, const char *aPskdAscii);
+    JoinerSession(EventLoop &aEventLoop, uint16_t aInternalServerPort, const char *aPskdAscii);
 
     /**
-     * This method updates the fd_set and timeout @p aTimeout should
+     * This method updates the timeout to the next retransmission of the session, @p aTimeout should
      * only be updated if session has pending process in less than its current value.
      *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
      * @param[inout]    aTimeout        A reference to the timeout.
      *
      */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+    void UpdateTimeout(timeval &aTimeout);
 
     /**
      * This method performs the session processing.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
-     *
      */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    void Process(void);
 
     /**
      * This method returns whether the underlying relay service should append kek after dtls encapsulation
@@ -107,6 +101,12 @@ public:
      */
     ssize_t Write(const uint8_t *aBuf, uint16_t aLength);
 
+    /**
+     * This method returns whether the session with the joiner is over, either finished or failed
+     * @returns whether the session with the joiner is over
+     */
+    bool IsEnded(void) const { return mEnded; }
+
     ~JoinerSession();
 
 private:
@@ -134,6 +134,7 @@ private:
     Coap::Agent *  mCoapAgent;
     Coap::Resource mJoinerFinalizeHandler;
     bool           mNeedAppendKek;
+    bool           mEnded;
 };
 
 } // namespace BorderRouter
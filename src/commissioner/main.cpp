@@ -33,6 +33,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #include <signal.h>
@@ -40,14 +41,19 @@
 #include "commissioner.hpp"
 #include "commissioner_argcargv.hpp"
 #include "common/code_utils.hpp"
+#include "common/event_loop.hpp"
 #include "common/logging.hpp"
 #include "utils/hex.hpp"
 
 using namespace ot;
 using namespace ot::BorderRouter;
 
+static volatile sig_atomic_t sShouldResign = 0;
+
 static void HandleSignal(int aSignal)
 {
+    // Resign gracefully on the first signal, the second one terminates.
+    sShouldResign = 1;
     signal(aSignal, SIG_DFL);
 }
 
@@ -55,7 +61,8 @@ int main(int argc, char **argv)
 {
     otbrError        error;
     CommissionerArgs args;
-    int              ret = 0;
+    EventLoop *      eventLoop = NULL;
+    int              ret       = 0;
 
     SuccessOrExit(error = ParseArgs(argc, argv, args));
 
@@ -65,45 +72,46 @@ int main(int argc, char **argv)
 
     srand(static_cast<unsigned int>(time(0)));
 
+    VerifyOrExit((eventLoop = EventLoop::Create()) != NULL, error = OTBR_ERROR_ERRNO);
+
     {
-        Commissioner commissioner(args.mPSKc, args.mKeepAliveInterval);
+        Commissioner commissioner(*eventLoop, args.mPSKc, args.mKeepAliveInterval,
+                                  static_cast<size_t>(args.mMaxJoiners), kPortJoinerSession);
         bool         joinerSetDone = false;
 
-        commissioner.InitDtls(args.mAgentHost, args.mAgentPort);
-
-        do
-        {
-            ret = commissioner.TryDtlsHandshake();
-        } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
-
-        if (commissioner.IsValid())
+        ret = commissioner.InitDtls(args.mAgentHost, args.mAgentPort);
+        if (ret != 0)
         {
-            commissioner.CommissionerPetition();
+            otbrLog(OTBR_LOG_ERR, "failed to connect border agent: %d", ret);
         }
 
+        eventLoop->AddProcessor(commissioner);
+
         while (commissioner.IsValid())
         {
-            int            maxFd   = -1;
             struct timeval timeout = {10, 0};
-            int            rval;
-
-            fd_set readFdSet;
-            fd_set writeFdSet;
-            fd_set errorFdSet;
-
-            FD_ZERO(&readFdSet);
-            FD_ZERO(&writeFdSet);
-            FD_ZERO(&errorFdSet);
-            commissioner.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
-            rval = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout);
-            if (rval < 0)
+
+            // Signals interrupt waiting, and are handled right after.
+            if (eventLoop->Poll(timeout) != OTBR_ERROR_NONE)
             {
-                otbrLog(OTBR_LOG_ERR, "select() failed", strerror(errno));
+                otbrLog(OTBR_LOG_ERR, "Poll() failed: %s", strerror(errno));
                 break;
             }
-            commissioner.Process(readFdSet, writeFdSet, errorFdSet);
+            if (sShouldResign)
+            {
+                sShouldResign = 0;
+                VerifyOrExit(commissioner.IsCommissionerAccepted());
+                commissioner.Resign();
+            }
             if (commissioner.IsCommissionerAccepted() && !joinerSetDone)
             {
+                for (int i = 0; i < args.mNumJoiners; i++)
+                {
+                    if (args.mJoiners[i].mPSKd != NULL)
+                    {
+                        commissioner.AddJoiner(args.mJoiners[i].mEui64, args.mJoiners[i].mPSKd);
+                    }
+                }
                 commissioner.SetJoiner(args.mPSKd, args.mSteeringData);
                 joinerSetDone = true;
             }
@@ -111,5 +119,6 @@ int main(int argc, char **argv)
     }
 
 exit:
+    EventLoop::Destroy(eventLoop);
     return error;
 }
@@ -36,6 +36,7 @@
 
 #include <stdint.h>
 #include <unistd.h>
+#include <sys/time.h>
 
 #include "types.hpp"
 
@@ -72,17 +73,38 @@ enum Type
  */
 enum Code
 {
-    kCodeEmpty   = 0x00, ///< Empty message code
-    kCodeGet     = 0x01, ///< Get
-    kCodePost    = 0x02, ///< Post
-    kCodePut     = 0x03, ///< Put
-    kCodeDelete  = 0x04, ///< Delete
-    kCodeCodeMin = 0x40, ///< 2.00
-    kCodeCreated = 0x41, ///< Created
-    kCodeDeleted = 0x42, ///< Deleted
-    kCodeValid   = 0x43, ///< Valid
-    kCodeChanged = 0x44, ///< Changed
-    kCodeContent = 0x45, ///< Content
+    kCodeEmpty                   = 0x00, ///< Empty message code
+    kCodeGet                     = 0x01, ///< Get
+    kCodePost                    = 0x02, ///< Post
+    kCodePut                     = 0x03, ///< Put
+    kCodeDelete                  = 0x04, ///< Delete
+    kCodeCodeMin                 = 0x40, ///< 2.00
+    kCodeCreated                 = 0x41, ///< Created
+    kCodeDeleted                 = 0x42, ///< Deleted
+    kCodeValid                   = 0x43, ///< Valid
+    kCodeChanged                 = 0x44, ///< Changed
+    kCodeContent                 = 0x45, ///< Content
+    kCodeContinue                = 0x5f, ///< Continue
+    kCodeBadOption               = 0x82, ///< Bad Option
+    kCodeNotFound                = 0x84, ///< Not Found
+    kCodeMethodNotAllowed        = 0x85, ///< Method Not Allowed
+    kCodeRequestEntityIncomplete = 0x88, ///< Request Entity Incomplete
+    kCodeRequestEntityTooLarge   = 0x8d, ///< Request Entity Too Large
+    kCodeInternalServerError     = 0xa0, ///< Internal Server Error
+    kCodeServiceUnavailable      = 0xa3, ///< Service Unavailable
+};
+
+/**
+ * CoAP request method masks, which select the methods a resource handles.
+ *
+ */
+enum Method
+{
+    kMethodGet    = 1 << kCodeGet,                                         ///< Get
+    kMethodPost   = 1 << kCodePost,                                        ///< Post
+    kMethodPut    = 1 << kCodePut,                                         ///< Put
+    kMethodDelete = 1 << kCodeDelete,                                      ///< Delete
+    kMethodAll    = kMethodGet | kMethodPost | kMethodPut | kMethodDelete, ///< All of above
 };
 
 /**
@@ -165,6 +187,9 @@ public:
     /**
      * This method sets the CoAP payload of this message.
      *
+     * The payload is copied, except that a payload too large for one message is referenced until this message is
+     * sent. A response set by a request handler is always copied, or dropped if it exceeds the block-wise limit.
+     *
      * @param[in]   aPayload    A pointer to the payload buffer.
      * @param[in]   aLength     Number of bytes in @p aPayload.
      *
@@ -199,13 +224,18 @@ typedef void (*RequestHandler)(const Resource &aResource,
                                void *          aContext);
 
 /**
- * This function pointer is called when a CoAP response received.
+ * This function pointer is called when a CoAP response received, or when no response is to come.
+ *
+ * A confirmable message not acknowledged after all retransmissions, or rejected by the peer, is reported with
+ * OTBR_ERROR_ERRNO, errno being ETIMEDOUT or ECONNRESET respectively.
  *
- * @param[in]   aMessage        A pointer to the response message.
+ * @param[in]   aMessage        A pointer to the response message, NULL if @p aError is not OTBR_ERROR_NONE, or if
+ *                              the acknowledged message is not a request.
+ * @param[in]   aError          OTBR_ERROR_NONE if the message is answered, otherwise the reason it failed.
  * @param[in]   aContext        A pointer to application-specific context.
  *
  */
-typedef void (*ResponseHandler)(const Message &aMessage, void *aContext);
+typedef void (*ResponseHandler)(const Message *aMessage, otbrError aError, void *aContext);
 
 /**
  * This struct defines a CoAP resource and its handler.
@@ -215,6 +245,7 @@ struct Resource
     void *         mContext; ///< A pointer to application-specific context.
     const char *   mPath;    ///< The CoAP Uri Path.
     RequestHandler mHandler; ///< The function to handle request to mPath.
+    unsigned int   mMethods; ///< The methods handled, a bitwise OR of Method values.
 
     /**
      * The constructor to initialize a CoAP resource.
@@ -222,12 +253,14 @@ struct Resource
      * @param[in]   aPath       The resource path.
      * @param[in]   aHandler    The function to be called when received request to this resource.
      * @param[in]   aContext        A pointer to application-specific context.
+     * @param[in]   aMethods    The methods handled, a bitwise OR of Method values.
      *
      */
-    Resource(const char *aPath, RequestHandler aHandler, void *aContext)
+    Resource(const char *aPath, RequestHandler aHandler, void *aContext, unsigned int aMethods = kMethodPost)
         : mContext(aContext)
         , mPath(aPath)
         , mHandler(aHandler)
+        , mMethods(aMethods)
     {
     }
 };
@@ -289,6 +322,8 @@ public:
     /**
      * This method registers a CoAP resource.
      *
+     * Several resources may share a path as long as they handle different methods.
+     *
      * @param[in]   aResource       A reference to the resource.
      *
      * @retval  OTBR_ERROR_NONE     Successfully added the resource.
@@ -328,6 +363,52 @@ public:
                            ResponseHandler aHandler,
                            void *          aContext) = 0;
 
+    /**
+     * This method sets the size of blocks used by block-wise transfers.
+     *
+     * Requests and responses with payloads larger than the block size are sent block-wise (RFC 7959), and
+     * block-wise payloads received are reassembled in a bounded buffer. Small blocks, such as 64 bytes, spare the
+     * Thread link from 6LoWPAN fragmentation.
+     *
+     * @param[in]   aBlockSize  Number of bytes of a block, a power of two from 16 to 1024, or 0 to use block-wise
+     *                          transfers only for payloads that do not fit in a single message.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the block size.
+     * @retval  OTBR_ERROR_ERRNO    Invalid block size, errno is set to EINVAL.
+     *
+     */
+    virtual otbrError SetBlockSize(uint16_t aBlockSize) = 0;
+
+    /**
+     * This method notifies the observers of a resource of its current state (RFC 7641).
+     *
+     * A GET request with an Observe option of 0 registers its sender as an observer of the resource. The handler of
+     * the resource is then called once for each observer, and the response it sets is sent as a notification.
+     * Observers are removed when they deregister, reset a notification, or get an error response. A notification is
+     * confirmable now and then, and an observer not acknowledging it is removed too.
+     *
+     * @param[in]   aResource   A reference to the resource.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully notified all observers.
+     * @retval  OTBR_ERROR_ERRNO    Failed to send at least one notification.
+     *
+     */
+    virtual otbrError Notify(const Resource &aResource) = 0;
+
+    /**
+     * This method updates the mainloop timeout to the next retransmission of confirmable messages.
+     *
+     * @param[inout]    aTimeout    A reference to the timeout.
+     *
+     */
+    virtual void UpdateTimeout(timeval &aTimeout) const = 0;
+
+    /**
+     * This method retransmits confirmable messages due, and gives up on those retransmitted too many times.
+     *
+     */
+    virtual void Process(void) = 0;
+
     /**
      * This method creates a CoAP agent.
      *
@@ -0,0 +1,2020 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file implements the native CoAP service.
+ */
+
+#include "coap_native.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "code_utils.hpp"
+#include "logging.hpp"
+#include "time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+enum
+{
+    kVersion              = 1,
+    kHeaderSize           = 4,
+    kPayloadMarker        = 0xff,
+    kOptionExtended8      = 13,
+    kOptionExtended16     = 14,
+    kOptionReserved       = 15,
+    kOptionExtended8Base  = 13,
+    kOptionExtended16Base = 269,
+    kCodeClassMask        = 0xe0,
+};
+
+static uint8_t *EncodeOptionField(uint16_t aValue, uint8_t &aNibble, uint8_t *aCursor)
+{
+    if (aValue < kOptionExtended8Base)
+    {
+        aNibble = static_cast<uint8_t>(aValue);
+    }
+    else if (aValue < kOptionExtended16Base)
+    {
+        aNibble    = kOptionExtended8;
+        *aCursor++ = static_cast<uint8_t>(aValue - kOptionExtended8Base);
+    }
+    else
+    {
+        aValue -= kOptionExtended16Base;
+        aNibble    = kOptionExtended16;
+        *aCursor++ = static_cast<uint8_t>(aValue >> 8);
+        *aCursor++ = static_cast<uint8_t>(aValue & 0xff);
+    }
+
+    return aCursor;
+}
+
+static const uint8_t *DecodeOptionField(uint8_t aNibble, const uint8_t *aCursor, const uint8_t *aEnd, uint16_t &aValue)
+{
+    switch (aNibble)
+    {
+    case kOptionExtended8:
+        VerifyOrExit(aCursor + 1 <= aEnd, aCursor = NULL);
+        aValue = static_cast<uint16_t>(aCursor[0] + kOptionExtended8Base);
+        aCursor += 1;
+        break;
+
+    case kOptionExtended16:
+        VerifyOrExit(aCursor + 2 <= aEnd, aCursor = NULL);
+        aValue = static_cast<uint16_t>(((aCursor[0] << 8) | aCursor[1]) + kOptionExtended16Base);
+        aCursor += 2;
+        break;
+
+    case kOptionReserved:
+        aCursor = NULL;
+        break;
+
+    default:
+        aValue = aNibble;
+        break;
+    }
+
+exit:
+    return aCursor;
+}
+
+void MessageNative::Init(Type aType, Code aCode, uint16_t aMessageId, const uint8_t *aToken, uint8_t aTokenLength)
+{
+    mType          = static_cast<uint8_t>(aType);
+    mCode          = static_cast<uint8_t>(aCode);
+    mMessageId     = aMessageId;
+    mTokenLength   = 0;
+    mOptionCount   = 0;
+    mOverflow      = false;
+    mPayload       = NULL;
+    mPayloadLength = 0;
+    mDataLength    = 0;
+    mTransferData  = NULL;
+    mTransferSize  = 0;
+    SetToken(aToken, aTokenLength);
+}
+
+otbrError MessageNative::Parse(const uint8_t *aBuffer, uint16_t aLength)
+{
+    otbrError      error  = OTBR_ERROR_ERRNO;
+    const uint8_t *cursor = aBuffer + kHeaderSize;
+    const uint8_t *end    = aBuffer + aLength;
+    uint16_t       number = 0;
+
+    Init(kTypeConfirmable, kCodeEmpty, 0, NULL, 0);
+
+    VerifyOrExit(aLength >= kHeaderSize && (aBuffer[0] >> 6) == kVersion);
+    mType        = (aBuffer[0] >> 4) & 0x03;
+    mTokenLength = aBuffer[0] & 0x0f;
+    mCode        = aBuffer[1];
+    mMessageId   = static_cast<uint16_t>((aBuffer[2] << 8) | aBuffer[3]);
+
+    VerifyOrExit(mTokenLength <= kMaxTokenLength && cursor + mTokenLength <= end);
+    memcpy(mToken, cursor, mTokenLength);
+    cursor += mTokenLength;
+
+    while (cursor < end && *cursor != kPayloadMarker)
+    {
+        uint16_t delta;
+        uint16_t length;
+        uint8_t  byte = *cursor++;
+
+        VerifyOrExit((cursor = DecodeOptionField(byte >> 4, cursor, end, delta)) != NULL);
+        VerifyOrExit((cursor = DecodeOptionField(byte & 0x0f, cursor, end, length)) != NULL);
+        VerifyOrExit(length <= end - cursor && delta <= 0xffff - number);
+        VerifyOrExit(mOptionCount < kMaxOptions, otbrLog(OTBR_LOG_WARNING, "CoAP too many options!"));
+
+        number += delta;
+        mOptions[mOptionCount].mNumber = number;
+        mOptions[mOptionCount].mLength = length;
+        mOptions[mOptionCount].mValue  = cursor;
+        ++mOptionCount;
+        cursor += length;
+    }
+
+    if (cursor < end)
+    {
+        // A payload marker followed by a zero-length payload is a format error.
+        VerifyOrExit(++cursor < end);
+        mPayload       = cursor;
+        mPayloadLength = static_cast<uint16_t>(end - cursor);
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        errno = EBADMSG;
+    }
+
+    return error;
+}
+
+otbrError MessageNative::Serialize(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength) const
+{
+    return Write(aBuffer, aSize, aLength, true);
+}
+
+otbrError MessageNative::SerializeHeader(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength) const
+{
+    return Write(aBuffer, aSize, aLength, false);
+}
+
+otbrError MessageNative::Write(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength, bool aPayload) const
+{
+    otbrError error  = OTBR_ERROR_ERRNO;
+    uint8_t * cursor = aBuffer;
+    uint8_t * end    = aBuffer + aSize;
+    uint16_t  number = 0;
+
+    VerifyOrExit(!mOverflow);
+    VerifyOrExit(cursor + kHeaderSize + mTokenLength <= end);
+    *cursor++ = static_cast<uint8_t>((kVersion << 6) | (mType << 4) | mTokenLength);
+    *cursor++ = mCode;
+    *cursor++ = static_cast<uint8_t>(mMessageId >> 8);
+    *cursor++ = static_cast<uint8_t>(mMessageId & 0xff);
+    memcpy(cursor, mToken, mTokenLength);
+    cursor += mTokenLength;
+
+    for (uint8_t i = 0; i < mOptionCount; ++i)
+    {
+        const Option &option = mOptions[i];
+        uint8_t       field[5];
+        uint8_t *     fieldEnd = field + 1;
+        uint8_t       deltaNibble;
+        uint8_t       lengthNibble;
+
+        fieldEnd = EncodeOptionField(static_cast<uint16_t>(option.mNumber - number), deltaNibble, fieldEnd);
+        fieldEnd = EncodeOptionField(option.mLength, lengthNibble, fieldEnd);
+        field[0] = static_cast<uint8_t>((deltaNibble << 4) | lengthNibble);
+
+        VerifyOrExit((fieldEnd - field) + option.mLength <= end - cursor);
+        memcpy(cursor, field, static_cast<size_t>(fieldEnd - field));
+        cursor += fieldEnd - field;
+        memcpy(cursor, option.mValue, option.mLength);
+        cursor += option.mLength;
+        number = option.mNumber;
+    }
+
+    if (aPayload && mPayloadLength > 0)
+    {
+        VerifyOrExit(1 + mPayloadLength <= end - cursor);
+        *cursor++ = kPayloadMarker;
+        memcpy(cursor, mPayload, mPayloadLength);
+        cursor += mPayloadLength;
+    }
+
+    aLength = static_cast<uint16_t>(cursor - aBuffer);
+    error   = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        errno = EMSGSIZE;
+    }
+
+    return error;
+}
+
+uint8_t *MessageNative::Allocate(uint16_t aLength)
+{
+    uint8_t *buffer = NULL;
+
+    VerifyOrExit(aLength <= sizeof(mData) - mDataLength, mOverflow = true);
+    buffer = mData + mDataLength;
+    mDataLength += aLength;
+
+exit:
+    return buffer;
+}
+
+otbrError MessageNative::AddOption(uint16_t aNumber, const void *aValue, uint16_t aLength)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    uint8_t * value;
+    uint8_t   index = mOptionCount;
+
+    VerifyOrExit(mOptionCount < kMaxOptions, mOverflow = true);
+    VerifyOrExit((value = Allocate(aLength)) != NULL);
+
+    if (aLength > 0)
+    {
+        memcpy(value, aValue, aLength);
+    }
+
+    while (index > 0 && mOptions[index - 1].mNumber > aNumber)
+    {
+        mOptions[index] = mOptions[index - 1];
+        --index;
+    }
+
+    mOptions[index].mNumber = aNumber;
+    mOptions[index].mLength = aLength;
+    mOptions[index].mValue  = value;
+    ++mOptionCount;
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        errno = EMSGSIZE;
+    }
+
+    return error;
+}
+
+void MessageNative::RemoveOption(uint16_t aNumber)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < mOptionCount; ++i)
+    {
+        if (mOptions[i].mNumber != aNumber)
+        {
+            mOptions[count++] = mOptions[i];
+        }
+    }
+
+    mOptionCount = count;
+}
+
+const MessageNative::Option *MessageNative::FindOption(uint16_t aNumber) const
+{
+    const Option *option = NULL;
+
+    for (uint8_t i = 0; i < mOptionCount; ++i)
+    {
+        if (mOptions[i].mNumber == aNumber)
+        {
+            option = &mOptions[i];
+            break;
+        }
+    }
+
+    return option;
+}
+
+otbrError MessageNative::AddUintOption(uint16_t aNumber, uint32_t aValue)
+{
+    uint8_t  value[sizeof(aValue)];
+    uint16_t length = 0;
+
+    // Unsigned integer options are big endian without leading zeros.
+    for (uint32_t rest = aValue; rest != 0; rest >>= 8)
+    {
+        ++length;
+    }
+
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        value[i] = static_cast<uint8_t>(aValue >> (8 * (length - 1 - i)));
+    }
+
+    return AddOption(aNumber, value, length);
+}
+
+bool MessageNative::GetUintOption(uint16_t aNumber, uint32_t &aValue) const
+{
+    bool          found  = false;
+    const Option *option = FindOption(aNumber);
+
+    VerifyOrExit(option != NULL && option->mLength <= sizeof(aValue));
+    aValue = 0;
+
+    for (uint16_t i = 0; i < option->mLength; ++i)
+    {
+        aValue = (aValue << 8) | option->mValue[i];
+    }
+
+    found = true;
+
+exit:
+    return found;
+}
+
+otbrError MessageNative::AddBlockOption(uint16_t aNumber, uint32_t aBlock, bool aMore, uint8_t aSzx)
+{
+    return AddUintOption(aNumber, (aBlock << 4) | (aMore ? 0x08 : 0) | aSzx);
+}
+
+bool MessageNative::GetBlockOption(uint16_t aNumber, uint32_t &aBlock, bool &aMore, uint8_t &aSzx) const
+{
+    bool     found = false;
+    uint32_t value;
+
+    VerifyOrExit(GetUintOption(aNumber, value) && (value & 0x07) <= kMaxBlockSzx);
+    aBlock = value >> 4;
+    aMore  = (value & 0x08) != 0;
+    aSzx   = value & 0x07;
+    found  = true;
+
+exit:
+    return found;
+}
+
+bool MessageNative::MatchPath(const char *aPath) const
+{
+    bool        matched = false;
+    const char *segment = aPath;
+
+    for (uint8_t i = 0; i < mOptionCount; ++i)
+    {
+        const Option &option = mOptions[i];
+        const char *  end;
+        size_t        length;
+
+        if (option.mNumber != kOptionUriPath)
+        {
+            continue;
+        }
+
+        VerifyOrExit(segment != NULL);
+        end    = strchr(segment, '/');
+        length = (end == NULL ? strlen(segment) : static_cast<size_t>(end - segment));
+        VerifyOrExit(length == option.mLength && memcmp(segment, option.mValue, length) == 0);
+        segment = (end == NULL ? NULL : end + 1);
+    }
+
+    matched = (segment == NULL);
+
+exit:
+    return matched;
+}
+
+const uint8_t *MessageNative::GetToken(uint8_t &aLength) const
+{
+    aLength = mTokenLength;
+    return mToken;
+}
+
+void MessageNative::SetToken(const uint8_t *aToken, uint8_t aLength)
+{
+    VerifyOrExit(aLength <= kMaxTokenLength, mOverflow = true);
+
+    if (aLength > 0)
+    {
+        memcpy(mToken, aToken, aLength);
+    }
+
+    mTokenLength = aLength;
+
+exit:
+    return;
+}
+
+void MessageNative::SetPath(const char *aPath)
+{
+    while (*aPath != '\0')
+    {
+        const char *end = strchr(aPath, '/');
+        size_t      length;
+
+        if (end == NULL)
+        {
+            end = aPath + strlen(aPath);
+        }
+
+        length = static_cast<size_t>(end - aPath);
+
+        if (length > 0)
+        {
+            SuccessOrExit(AddOption(kOptionUriPath, aPath, static_cast<uint16_t>(std::min(length, size_t(0xffff)))));
+        }
+
+        aPath = (*end == '/' ? end + 1 : end);
+    }
+
+exit:
+    return;
+}
+
+const uint8_t *MessageNative::GetPayload(uint16_t &aLength) const
+{
+    aLength = mPayloadLength;
+    return mPayload;
+}
+
+void MessageNative::SetPayload(const uint8_t *aPayload, uint16_t aLength)
+{
+    // Reuse the space of the former payload if it is the last thing allocated.
+    if (mPayload == mData + mDataLength - mPayloadLength && mPayloadLength > 0)
+    {
+        mDataLength = static_cast<uint16_t>(mDataLength - mPayloadLength);
+    }
+
+    mPayload       = aPayload;
+    mPayloadLength = aLength;
+
+    VerifyOrExit(aLength > 0);
+
+    if (aLength <= sizeof(mData) - mDataLength)
+    {
+        uint8_t *payload = Allocate(aLength);
+
+        // The new payload may be a part of the former one.
+        memmove(payload, aPayload, aLength);
+        mPayload = payload;
+    }
+    else if (mTransferData != NULL)
+    {
+        // A response outlives the handler setting it, so its payload is copied for block-wise transfer too.
+        VerifyOrExit(aLength <= mTransferSize, mPayload = NULL, mPayloadLength = 0, mOverflow = true);
+        memmove(mTransferData, aPayload, aLength);
+        mPayload = mTransferData;
+    }
+
+    // Otherwise the payload is referenced, and the agent sends it block-wise.
+
+exit:
+    return;
+}
+
+AgentNative::AgentNative(NetworkSender aNetworkSender, void *aContext)
+    : mNetworkSender(aNetworkSender)
+    , mContext(aContext)
+    , mMessageId(static_cast<uint16_t>(rand()))
+    , mFreeMessages(NULL)
+    , mObserveSequence(0)
+    , mAdaptiveRto(true)
+    , mNextOrder(0)
+    , mBlockSzx(MessageNative::kMaxBlockSzx)
+    , mBlockThreshold(MessageNative::kMaxSize - kMaxHeaderSize)
+{
+    for (size_t i = 0; i < kMaxMessages; ++i)
+    {
+        mMessages[i].mNext = mFreeMessages;
+        mFreeMessages      = &mMessages[i];
+    }
+
+    memset(mTransactions, 0, sizeof(mTransactions));
+
+    for (size_t i = 0; i < kMaxTransfers; ++i)
+    {
+        mTransfers[i].mKind = kTransferNone;
+    }
+
+    for (size_t i = 0; i < kMaxObservers; ++i)
+    {
+        mObservers[i].mResource = NULL;
+    }
+
+    for (size_t i = 0; i < kMaxPeers; ++i)
+    {
+        mPeers[i].mInUse = false;
+    }
+
+    for (size_t i = 0; i < kMaxResponses; ++i)
+    {
+        mResponses[i].mLength = 0;
+    }
+}
+
+Message *AgentNative::NewMessage(Type aType, Code aCode, const uint8_t *aToken, uint8_t aTokenLength)
+{
+    MessageNative *message = mFreeMessages;
+
+    VerifyOrExit(message != NULL, errno = ENOBUFS);
+    mFreeMessages = message->mNext;
+    message->Init(aType, aCode, mMessageId++, aToken, aTokenLength);
+
+exit:
+    if (message == NULL)
+    {
+        otbrLog(OTBR_LOG_ERR, "CoAP message pool exhausted!");
+    }
+
+    return message;
+}
+
+void AgentNative::FreeMessage(Message *aMessage)
+{
+    MessageNative *message = static_cast<MessageNative *>(aMessage);
+
+    VerifyOrExit(message != NULL);
+    assert(message >= mMessages && message < mMessages + kMaxMessages);
+    message->mNext = mFreeMessages;
+    mFreeMessages  = message;
+
+exit:
+    return;
+}
+
+otbrError AgentNative::AddResource(const Resource &aResource)
+{
+    otbrError ret = mRouter.Add(aResource);
+
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "CoAP resource already added!");
+    }
+
+    return ret;
+}
+
+otbrError AgentNative::RemoveResource(const Resource &aResource)
+{
+    otbrError ret = mRouter.Remove(aResource);
+
+    for (size_t i = 0; ret == OTBR_ERROR_NONE && i < kMaxObservers; ++i)
+    {
+        if (mObservers[i].mResource == &aResource)
+        {
+            mObservers[i].mResource = NULL;
+        }
+    }
+
+    return ret;
+}
+
+otbrError AgentNative::SetBlockSize(uint16_t aBlockSize)
+{
+    otbrError ret = OTBR_ERROR_ERRNO;
+    uint8_t   szx = 0;
+
+    if (aBlockSize == 0)
+    {
+        mBlockSzx       = MessageNative::kMaxBlockSzx;
+        mBlockThreshold = MessageNative::kMaxSize - kMaxHeaderSize;
+        ExitNow(ret = OTBR_ERROR_NONE);
+    }
+
+    while (szx <= MessageNative::kMaxBlockSzx && (16u << szx) != aBlockSize)
+    {
+        ++szx;
+    }
+
+    VerifyOrExit(szx <= MessageNative::kMaxBlockSzx, errno = EINVAL);
+    mBlockSzx       = szx;
+    mBlockThreshold = aBlockSize;
+    ret             = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+static void SetPeer(uint8_t *aPeerIp6, const uint8_t *aIp6)
+{
+    if (aIp6 != NULL)
+    {
+        memcpy(aPeerIp6, aIp6, 16);
+    }
+    else
+    {
+        memset(aPeerIp6, 0, 16);
+    }
+}
+
+static const uint8_t *PeerAddress(const uint8_t *aPeerIp6)
+{
+    static const uint8_t kAny[16] = {0};
+
+    return memcmp(aPeerIp6, kAny, sizeof(kAny)) != 0 ? aPeerIp6 : NULL;
+}
+
+static bool MatchPeer(const uint8_t *aPeerIp6, uint16_t aPeerPort, const uint8_t *aIp6, uint16_t aPort)
+{
+    static const uint8_t kAny[16] = {0};
+
+    return aPeerPort == aPort && memcmp(aPeerIp6, aIp6 != NULL ? aIp6 : kAny, sizeof(kAny)) == 0;
+}
+
+otbrError AgentNative::SendMessage(const MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort)
+{
+    otbrError ret = OTBR_ERROR_ERRNO;
+    uint16_t  length;
+
+    SuccessOrExit(aMessage.Serialize(mBuffer, sizeof(mBuffer), length));
+    VerifyOrExit(mNetworkSender != NULL, errno = ENOTCONN);
+    VerifyOrExit(mNetworkSender(mBuffer, length, aIp6, aPort, mContext) >= 0);
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+void AgentNative::SendEmpty(Type aType, uint16_t aMessageId, const uint8_t *aIp6, uint16_t aPort)
+{
+    MessageNative message;
+
+    message.Init(aType, kCodeEmpty, aMessageId, NULL, 0);
+    SendMessage(message, aIp6, aPort);
+}
+
+otbrError AgentNative::Send(Message &       aMessage,
+                            const uint8_t * aIp6,
+                            uint16_t        aPort,
+                            ResponseHandler aHandler,
+                            void *          aContext)
+{
+    otbrError            ret         = OTBR_ERROR_ERRNO;
+    const MessageNative &message     = static_cast<const MessageNative &>(aMessage);
+    Transaction *        transaction = NULL;
+    Transfer *           transfer    = NULL;
+    bool                 blockwise   = message.mPayloadLength > mBlockThreshold;
+
+    if (blockwise)
+    {
+        // Large responses are only split when handling the request, see SplitResponse().
+        VerifyOrExit(message.IsRequest() && message.mPayloadLength <= kMaxTransferSize, errno = EMSGSIZE);
+        VerifyOrExit((transfer = NewTransfer(kTransferClient)) != NULL, errno = ENOBUFS);
+    }
+
+    if (blockwise || message.GetType() == kTypeConfirmable || (message.IsRequest() && aHandler != NULL))
+    {
+        VerifyOrExit((transaction = NewTransaction()) != NULL, errno = ENOBUFS);
+        InitTransaction(*transaction, message, aIp6, aPort, aHandler, aContext);
+    }
+
+    if (blockwise)
+    {
+        VerifyOrExit(transaction->mHeaderLength > 0, errno = EMSGSIZE);
+
+        transfer->mSending = true;
+        transfer->mSzx     = mBlockSzx;
+        transfer->mOffset  = 0;
+        transfer->mLength  = message.mPayloadLength;
+        memcpy(transfer->mData, message.mPayload, message.mPayloadLength);
+        transaction->mTransfer = transfer;
+
+        SuccessOrExit(SendBlock(*transaction, kOptionBlock1, 0));
+    }
+    else if (transaction != NULL)
+    {
+        SuccessOrExit(Track(*transaction, message));
+    }
+    else
+    {
+        SuccessOrExit(SendMessage(message, aIp6, aPort));
+    }
+
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "CoAP failed to send message: %s", strerror(errno));
+
+        if (transaction != NULL)
+        {
+            transaction->mInUse = false;
+        }
+
+        if (transfer != NULL)
+        {
+            transfer->mKind = kTransferNone;
+        }
+    }
+
+    return ret;
+}
+
+void AgentNative::InitTransaction(Transaction &        aTransaction,
+                                  const MessageNative &aMessage,
+                                  const uint8_t *      aIp6,
+                                  uint16_t             aPort,
+                                  ResponseHandler      aHandler,
+                                  void *               aContext)
+{
+    aTransaction.mRequest     = aMessage.IsRequest();
+    aTransaction.mTokenLength = aMessage.mTokenLength;
+    memcpy(aTransaction.mToken, aMessage.mToken, aMessage.mTokenLength);
+    aTransaction.mPort = aPort;
+    SetPeer(aTransaction.mIp6, aIp6);
+    aTransaction.mExpiration = GetNow() + kExchangeLifetime;
+    aTransaction.mHandler    = aHandler;
+    aTransaction.mContext    = aContext;
+
+    // Keep the request header to send the following blocks if any.
+    if (!aMessage.IsRequest() ||
+        aMessage.SerializeHeader(aTransaction.mHeader, sizeof(aTransaction.mHeader), aTransaction.mHeaderLength) !=
+            OTBR_ERROR_NONE)
+    {
+        aTransaction.mHeaderLength = 0;
+    }
+}
+
+otbrError AgentNative::SendBlock(Transaction &aTransaction, uint16_t aOption, uint32_t aBlock)
+{
+    otbrError     ret;
+    Transfer &    transfer = *aTransaction.mTransfer;
+    MessageNative message;
+
+    SuccessOrExit(ret = message.Parse(aTransaction.mHeader, aTransaction.mHeaderLength));
+    message.mMessageId = mMessageId++;
+
+    if (aOption == kOptionBlock1)
+    {
+        uint32_t length = std::min(16u << transfer.mSzx, transfer.mLength - transfer.mOffset);
+        bool     more   = (transfer.mOffset + length < transfer.mLength);
+
+        if (transfer.mOffset == 0)
+        {
+            // Let the peer reject a payload too large before receiving all of it.
+            SuccessOrExit(ret = message.AddUintOption(kOptionSize1, transfer.mLength));
+        }
+
+        SuccessOrExit(ret = message.AddBlockOption(kOptionBlock1, transfer.mOffset >> (transfer.mSzx + 4), more,
+                                                   transfer.mSzx));
+        message.SetPayload(transfer.mData + transfer.mOffset, static_cast<uint16_t>(length));
+        transfer.mBlockLength = length;
+    }
+    else
+    {
+        SuccessOrExit(ret = message.AddBlockOption(kOptionBlock2, aBlock, false, transfer.mSzx));
+    }
+
+    SuccessOrExit(ret = Track(aTransaction, message));
+    aTransaction.mExpiration = GetNow() + kExchangeLifetime;
+
+exit:
+    return ret;
+}
+
+otbrError AgentNative::Track(Transaction &aTransaction, const MessageNative &aMessage)
+{
+    otbrError ret;
+
+    SuccessOrExit(ret = aMessage.Serialize(aTransaction.mMessage, sizeof(aTransaction.mMessage), aTransaction.mLength));
+
+    aTransaction.mInUse         = true;
+    aTransaction.mMessageId     = aMessage.GetMessageId();
+    aTransaction.mAcknowledged  = (aMessage.GetType() != kTypeConfirmable);
+    aTransaction.mTransmissions = 0;
+    aTransaction.mOrder         = mNextOrder++;
+
+    // Confirmable messages wait in order while too many are outstanding to the peer.
+    if (aTransaction.mAcknowledged || IsSendable(aTransaction))
+    {
+        ret = Transmit(aTransaction);
+    }
+
+exit:
+    return ret;
+}
+
+bool AgentNative::IsSendable(const Transaction &aTransaction) const
+{
+    size_t outstanding = 0;
+
+    VerifyOrExit(!aTransaction.mAcknowledged);
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        const Transaction &transaction = mTransactions[i];
+
+        if (&transaction == &aTransaction || !transaction.mInUse || transaction.mAcknowledged ||
+            !MatchPeer(transaction.mIp6, transaction.mPort, PeerAddress(aTransaction.mIp6), aTransaction.mPort))
+        {
+            continue;
+        }
+
+        if (transaction.mTransmissions > 0)
+        {
+            ++outstanding;
+        }
+        else if (static_cast<int32_t>(transaction.mOrder - aTransaction.mOrder) < 0)
+        {
+            ExitNow(outstanding = kNStart);
+        }
+    }
+
+exit:
+    return outstanding < kNStart;
+}
+
+otbrError AgentNative::Transmit(Transaction &aTransaction)
+{
+    otbrError      ret  = OTBR_ERROR_ERRNO;
+    const uint8_t *ip6  = PeerAddress(aTransaction.mIp6);
+    Peer &         peer = GetPeer(ip6, aTransaction.mPort);
+    unsigned long  now  = GetNow();
+
+    VerifyOrExit(mNetworkSender != NULL, errno = ENOTCONN);
+    VerifyOrExit(mNetworkSender(aTransaction.mMessage, aTransaction.mLength, ip6, aTransaction.mPort, mContext) >= 0);
+
+    if (aTransaction.mTransmissions == 0)
+    {
+        aTransaction.mSentTime = now;
+        aTransaction.mRto      = (mAdaptiveRto ? peer.mRtoEstimator.GetRto(now)
+                                               : static_cast<unsigned long>(RtoEstimator::kInitialRto));
+
+        // ACK_RANDOM_FACTOR of 1.5.
+        aTransaction.mTimeout = aTransaction.mRto + static_cast<unsigned long>(rand()) % (aTransaction.mRto / 2 + 1);
+    }
+    else
+    {
+        aTransaction.mTimeout = (mAdaptiveRto ? RtoEstimator::Backoff(aTransaction.mTimeout, aTransaction.mRto)
+                                              : aTransaction.mTimeout * 2);
+        ++peer.mRetransmissions;
+    }
+
+    ++aTransaction.mTransmissions;
+    ++peer.mTransmissions;
+    aTransaction.mRetransmitTime = now + aTransaction.mTimeout;
+    ret                          = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+void AgentNative::Acknowledge(Transaction &aTransaction)
+{
+    unsigned long now = GetNow();
+
+    VerifyOrExit(!aTransaction.mAcknowledged);
+    aTransaction.mAcknowledged = true;
+
+    // Which transmission is acknowledged is unknown after more retransmissions, so the sample is useless.
+    if (aTransaction.mTransmissions <= kMaxWeakTransmissions)
+    {
+        GetPeer(PeerAddress(aTransaction.mIp6), aTransaction.mPort)
+            .mRtoEstimator.Update(now - aTransaction.mSentTime, aTransaction.mTransmissions == 1, now);
+    }
+
+exit:
+    return;
+}
+
+void AgentNative::SendQueued(void)
+{
+    for (;;)
+    {
+        Transaction *next = NULL;
+
+        for (size_t i = 0; i < kMaxTransactions; ++i)
+        {
+            Transaction &transaction = mTransactions[i];
+
+            if (transaction.mInUse && transaction.mTransmissions == 0 && IsSendable(transaction) &&
+                (next == NULL || static_cast<int32_t>(transaction.mOrder - next->mOrder) < 0))
+            {
+                next = &transaction;
+            }
+        }
+
+        VerifyOrExit(next != NULL);
+
+        if (Transmit(*next) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_ERR, "CoAP failed to send message %u: %s", next->mMessageId, strerror(errno));
+            FinishTransaction(*next, NULL, errno);
+        }
+    }
+
+exit:
+    return;
+}
+
+void AgentNative::UpdateTimeout(timeval &aTimeout) const
+{
+    unsigned long now     = GetNow();
+    unsigned long timeout = GetTimestamp(aTimeout);
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        const Transaction &transaction = mTransactions[i];
+        unsigned long      deadline;
+
+        if (!transaction.mInUse)
+        {
+            continue;
+        }
+
+        // Transactions waiting for a separate response, or for the response of a NON request, only expire.
+        deadline = transaction.mExpiration;
+
+        if (!transaction.mAcknowledged && transaction.mTransmissions > 0 &&
+            static_cast<long>(transaction.mRetransmitTime - deadline) < 0)
+        {
+            deadline = transaction.mRetransmitTime;
+        }
+
+        if (static_cast<long>(deadline - (now + timeout)) < 0)
+        {
+            long delay = static_cast<long>(deadline - now);
+
+            timeout = (delay > 0 ? static_cast<unsigned long>(delay) : 0);
+        }
+    }
+
+    aTimeout.tv_sec  = static_cast<time_t>(timeout / 1000);
+    aTimeout.tv_usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
+}
+
+void AgentNative::Process(void)
+{
+    unsigned long now = GetNow();
+
+    Purge();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        Transaction &transaction = mTransactions[i];
+
+        if (!transaction.mInUse || transaction.mAcknowledged || transaction.mTransmissions == 0 ||
+            static_cast<long>(now - transaction.mRetransmitTime) < 0)
+        {
+            continue;
+        }
+
+        if (transaction.mTransmissions > kMaxRetransmit)
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP message %u not acknowledged!", transaction.mMessageId);
+            ++GetPeer(PeerAddress(transaction.mIp6), transaction.mPort).mTimeouts;
+            FinishTransaction(transaction, NULL, ETIMEDOUT);
+        }
+        else if (Transmit(transaction) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_ERR, "CoAP failed to retransmit message %u: %s", transaction.mMessageId,
+                    strerror(errno));
+            FinishTransaction(transaction, NULL, errno);
+        }
+    }
+
+    SendQueued();
+}
+
+AgentNative::Peer &AgentNative::GetPeer(const uint8_t *aIp6, uint16_t aPort)
+{
+    unsigned long now   = GetNow();
+    Peer *        found = const_cast<Peer *>(FindPeer(aIp6, aPort));
+
+    if (found == NULL)
+    {
+        // Forget the peer least recently used.
+        found = &mPeers[0];
+
+        for (size_t i = 0; i < kMaxPeers && found->mInUse; ++i)
+        {
+            if (!mPeers[i].mInUse || static_cast<long>(mPeers[i].mUseTime - found->mUseTime) < 0)
+            {
+                found = &mPeers[i];
+            }
+        }
+
+        found->mInUse = true;
+        found->mPort  = aPort;
+        SetPeer(found->mIp6, aIp6);
+        found->mRtoEstimator.Reset(now);
+        found->mTransmissions   = 0;
+        found->mRetransmissions = 0;
+        found->mTimeouts        = 0;
+    }
+
+    found->mUseTime = now;
+
+    return *found;
+}
+
+const AgentNative::Peer *AgentNative::FindPeer(const uint8_t *aIp6, uint16_t aPort) const
+{
+    const Peer *found = NULL;
+
+    for (size_t i = 0; i < kMaxPeers; ++i)
+    {
+        if (mPeers[i].mInUse && MatchPeer(mPeers[i].mIp6, mPeers[i].mPort, aIp6, aPort))
+        {
+            found = &mPeers[i];
+            break;
+        }
+    }
+
+    return found;
+}
+
+otbrError AgentNative::GetPeerMetrics(const uint8_t *aIp6, uint16_t aPort, PeerMetrics &aMetrics) const
+{
+    otbrError    ret  = OTBR_ERROR_ERRNO;
+    const Peer * peer = FindPeer(aIp6, aPort);
+    RtoEstimator estimator;
+
+    VerifyOrExit(peer != NULL, errno = ENOENT);
+
+    // Aging the estimation of a copy keeps this method free of side effects.
+    estimator                 = peer->mRtoEstimator;
+    aMetrics.mRto             = estimator.GetRto(GetNow());
+    aMetrics.mStrongRtt       = estimator.GetStrongRtt();
+    aMetrics.mWeakRtt         = estimator.GetWeakRtt();
+    aMetrics.mOutstanding     = 0;
+    aMetrics.mQueued          = 0;
+    aMetrics.mTransmissions   = peer->mTransmissions;
+    aMetrics.mRetransmissions = peer->mRetransmissions;
+    aMetrics.mTimeouts        = peer->mTimeouts;
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        const Transaction &transaction = mTransactions[i];
+
+        if (transaction.mInUse && !transaction.mAcknowledged &&
+            MatchPeer(transaction.mIp6, transaction.mPort, aIp6, aPort))
+        {
+            ++(transaction.mTransmissions > 0 ? aMetrics.mOutstanding : aMetrics.mQueued);
+        }
+    }
+
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+void AgentNative::Input(const void *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort)
+{
+    const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+    MessageNative  message;
+
+    if (message.Parse(buffer, aLength) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "CoAP received malformed message!");
+
+        // Reject a malformed confirmable message if at least its header is intact.
+        if (aLength >= kHeaderSize && (buffer[0] >> 6) == kVersion && ((buffer[0] >> 4) & 0x03) == kTypeConfirmable)
+        {
+            SendEmpty(kTypeReset, static_cast<uint16_t>((buffer[2] << 8) | buffer[3]), aIp6, aPort);
+        }
+
+        ExitNow();
+    }
+
+    if (message.IsRequest())
+    {
+        HandleRequest(message, aIp6, aPort);
+    }
+    else if (message.IsResponse())
+    {
+        HandleResponse(message, aIp6, aPort);
+    }
+    else
+    {
+        HandleEmpty(message, aIp6, aPort);
+    }
+
+exit:
+    // Acknowledgments may let queued messages go.
+    SendQueued();
+}
+
+void AgentNative::HandleRequest(MessageNative &aRequest, const uint8_t *aIp6, uint16_t aPort)
+{
+    const Resource *resource;
+    bool            pathFound;
+    MessageNative   response;
+    Transfer *      transfer;
+    Response *      cached;
+    uint32_t        block;
+    bool            more;
+    uint8_t         szx;
+
+    VerifyOrExit(aRequest.GetType() == kTypeConfirmable || aRequest.GetType() == kTypeNonConfirmable);
+
+    // A retransmitted request is answered again without being handled twice, as in section 4.5 of RFC 7252.
+    if (aRequest.GetType() == kTypeConfirmable &&
+        (cached = FindResponse(aIp6, aPort, aRequest.GetMessageId())) != NULL)
+    {
+        otbrLog(OTBR_LOG_DEBUG, "CoAP received duplicate request %u", aRequest.GetMessageId());
+        VerifyOrExit(mNetworkSender != NULL);
+        mNetworkSender(cached->mMessage, cached->mLength, aIp6, aPort, mContext);
+        ExitNow();
+    }
+
+    if (aRequest.GetType() == kTypeConfirmable)
+    {
+        response.Init(kTypeAcknowledgment, kCodeEmpty, aRequest.GetMessageId(), aRequest.mToken,
+                      aRequest.mTokenLength);
+    }
+    else
+    {
+        response.Init(kTypeNonConfirmable, kCodeEmpty, mMessageId++, aRequest.mToken, aRequest.mTokenLength);
+    }
+
+    resource = mRouter.Find(aRequest, pathFound);
+
+    if (resource == NULL)
+    {
+        otbrLog(OTBR_LOG_WARNING, "CoAP received unexpected request!");
+
+        // Unknown methods are not allowed on any path.
+        response.SetCode(pathFound || aRequest.GetCode() > kCodeDelete ? kCodeMethodNotAllowed : kCodeNotFound);
+    }
+    else if (aRequest.GetBlockOption(kOptionBlock2, block, more, szx) && block > 0 &&
+             (transfer = FindTransfer(kTransferBlock2Send, *resource, aIp6, aPort)) != NULL)
+    {
+        // Following blocks are served from the kept representation without calling the handler again.
+        response.SetCode(static_cast<Code>(transfer->mCode));
+        transfer->mExpiration = GetNow() + kExchangeLifetime;
+
+        if (!SetBlock2(response, transfer->mData, transfer->mLength, block, szx))
+        {
+            transfer->mKind = kTransferNone;
+        }
+    }
+    else if (HandleBlock1(aRequest, response, *resource, aIp6, aPort))
+    {
+        response.mTransferData = mResponsePayload;
+        response.mTransferSize = sizeof(mResponsePayload);
+
+        // Code is kCodeEmpty to use separate response if no response set by handler.
+        // Handler should later respond an Non-ACK response.
+        resource->mHandler(*resource, aRequest, response, aIp6, aPort, resource->mContext);
+
+        if (response.mOverflow)
+        {
+            otbrLog(OTBR_LOG_ERR, "CoAP response too large!");
+            response.Init(response.GetType(), kCodeInternalServerError, response.GetMessageId(), aRequest.mToken,
+                          aRequest.mTokenLength);
+        }
+
+        HandleObserve(aRequest, response, *resource, aIp6, aPort);
+        SplitResponse(aRequest, response, *resource, aIp6, aPort);
+
+        // Released only now as the response may refer to the reassembled request until split.
+        if ((transfer = FindTransfer(kTransferBlock1Receive, *resource, aIp6, aPort)) != NULL)
+        {
+            transfer->mKind = kTransferNone;
+        }
+    }
+
+    if (response.GetCode() == kCodeEmpty)
+    {
+        // Only acknowledge the request, the handler will send a separate response.
+        VerifyOrExit(aRequest.GetType() == kTypeConfirmable);
+        response.Init(kTypeAcknowledgment, kCodeEmpty, aRequest.GetMessageId(), NULL, 0);
+    }
+
+    SendMessage(response, aIp6, aPort);
+
+    if (aRequest.GetType() == kTypeConfirmable)
+    {
+        CacheResponse(aRequest.GetMessageId(), response, aIp6, aPort);
+    }
+
+exit:
+    return;
+}
+
+bool AgentNative::HandleBlock1(MessageNative & aRequest,
+                               MessageNative & aResponse,
+                               const Resource &aResource,
+                               const uint8_t * aIp6,
+                               uint16_t        aPort)
+{
+    bool           complete = false;
+    Transfer *     transfer = NULL;
+    uint32_t       block;
+    bool           more;
+    uint8_t        szx;
+    uint32_t       size;
+    uint16_t       length;
+    const uint8_t *payload = aRequest.GetPayload(length);
+
+    if (!aRequest.GetBlockOption(kOptionBlock1, block, more, szx))
+    {
+        ExitNow(complete = true);
+    }
+
+    if (aRequest.GetUintOption(kOptionSize1, size) && size > kMaxTransferSize)
+    {
+        ExitNow(aResponse.SetCode(kCodeRequestEntityTooLarge));
+    }
+
+    transfer = FindTransfer(kTransferBlock1Receive, aResource, aIp6, aPort);
+
+    if (block == 0)
+    {
+        if (transfer == NULL && (transfer = NewTransfer(kTransferBlock1Receive)) == NULL)
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP no buffer for block-wise request!");
+            ExitNow(aResponse.SetCode(kCodeServiceUnavailable));
+        }
+
+        transfer->mResource = &aResource;
+        transfer->mPort     = aPort;
+        SetPeer(transfer->mIp6, aIp6);
+        transfer->mLength = 0;
+    }
+
+    // Blocks must come in order, and all but the last one must be full.
+    if (transfer == NULL || (block << (szx + 4)) != transfer->mLength || (more && length != (16u << szx)))
+    {
+        ExitNow(aResponse.SetCode(kCodeRequestEntityIncomplete));
+    }
+
+    if (transfer->mLength + length > kMaxTransferSize)
+    {
+        transfer->mKind = kTransferNone;
+        ExitNow(aResponse.SetCode(kCodeRequestEntityTooLarge));
+    }
+
+    if (length > 0)
+    {
+        memcpy(transfer->mData + transfer->mLength, payload, length);
+        transfer->mLength += length;
+    }
+
+    transfer->mExpiration = GetNow() + kExchangeLifetime;
+    aResponse.AddBlockOption(kOptionBlock1, block, more, szx);
+
+    if (more)
+    {
+        ExitNow(aResponse.SetCode(kCodeContinue));
+    }
+
+    // Hand the whole payload to the handler, the transfer is released once handled.
+    aRequest.RemoveOption(kOptionBlock1);
+    aRequest.RemoveOption(kOptionSize1);
+    aRequest.SetPayload(transfer->mData, static_cast<uint16_t>(transfer->mLength));
+    complete = true;
+
+exit:
+    if (aResponse.GetCode() == kCodeRequestEntityTooLarge)
+    {
+        aResponse.AddUintOption(kOptionSize1, kMaxTransferSize);
+    }
+
+    return complete;
+}
+
+void AgentNative::SplitResponse(const MessageNative &aRequest,
+                                MessageNative &      aResponse,
+                                const Resource &     aResource,
+                                const uint8_t *      aIp6,
+                                uint16_t             aPort)
+{
+    uint16_t       length;
+    const uint8_t *payload   = aResponse.GetPayload(length);
+    uint32_t       block     = 0;
+    uint8_t        szx       = mBlockSzx;
+    bool           requested = false;
+    bool           more;
+    Transfer *     transfer;
+
+    if (aRequest.GetBlockOption(kOptionBlock2, block, more, szx))
+    {
+        // Continue with the block size of the peer, or propose a smaller one with the first block.
+        szx       = (block == 0 ? std::min(szx, mBlockSzx) : szx);
+        requested = true;
+    }
+
+    VerifyOrExit(aResponse.GetCode() != kCodeEmpty);
+    VerifyOrExit(requested ? (block > 0 || length > (16u << szx)) : length > mBlockThreshold);
+
+    if ((transfer = FindTransfer(kTransferBlock2Send, aResource, aIp6, aPort)) == NULL)
+    {
+        transfer = NewTransfer(kTransferBlock2Send);
+    }
+
+    // Without a transfer buffer, the following blocks are regenerated by the handler.
+    if (transfer != NULL && length <= kMaxTransferSize)
+    {
+        transfer->mResource = &aResource;
+        transfer->mPort     = aPort;
+        SetPeer(transfer->mIp6, aIp6);
+        transfer->mCode       = aResponse.GetCode();
+        transfer->mExpiration = GetNow() + kExchangeLifetime;
+        transfer->mLength     = length;
+        memcpy(transfer->mData, payload, length);
+        payload = transfer->mData;
+    }
+    else if (transfer != NULL)
+    {
+        transfer->mKind = kTransferNone;
+        transfer        = NULL;
+    }
+
+    if (!SetBlock2(aResponse, payload, length, block, szx) && transfer != NULL)
+    {
+        transfer->mKind = kTransferNone;
+    }
+
+exit:
+    return;
+}
+
+bool AgentNative::SetBlock2(MessageNative &aResponse,
+                            const uint8_t *aData,
+                            uint32_t       aLength,
+                            uint32_t       aBlock,
+                            uint8_t        aSzx)
+{
+    uint32_t size   = 16u << aSzx;
+    uint32_t offset = aBlock << (aSzx + 4);
+    bool     more   = false;
+
+    if (offset >= aLength && aBlock > 0)
+    {
+        aResponse.SetCode(kCodeBadOption);
+        aResponse.SetPayload(NULL, 0);
+        ExitNow();
+    }
+
+    more = (offset + size < aLength);
+    aResponse.SetPayload(aData + offset, static_cast<uint16_t>(std::min(size, aLength - offset)));
+
+    if (aResponse.AddBlockOption(kOptionBlock2, aBlock, more, aSzx) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "CoAP no space for Block2 option!");
+    }
+
+exit:
+    return more;
+}
+
+void AgentNative::HandleResponse(MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort)
+{
+    Transaction *transaction = NULL;
+    bool         continued   = false;
+
+    switch (aMessage.GetType())
+    {
+    case kTypeAcknowledgment:
+        transaction = FindTransaction(aIp6, aPort, aMessage.GetMessageId());
+
+        if (transaction != NULL && (transaction->mTokenLength != aMessage.mTokenLength ||
+                                    memcmp(transaction->mToken, aMessage.mToken, aMessage.mTokenLength)))
+        {
+            transaction = NULL;
+        }
+
+        if (transaction != NULL)
+        {
+            Acknowledge(*transaction);
+        }
+        break;
+
+    case kTypeConfirmable:
+    case kTypeNonConfirmable:
+        transaction = FindTransaction(aIp6, aPort, aMessage.mToken, aMessage.mTokenLength);
+
+        if (transaction != NULL)
+        {
+            // The empty acknowledgment was lost, the time of this response is useless to estimate RTO.
+            transaction->mAcknowledged = true;
+        }
+
+        if (aMessage.GetType() == kTypeConfirmable)
+        {
+            SendEmpty(transaction != NULL ? kTypeAcknowledgment : kTypeReset, aMessage.GetMessageId(), aIp6, aPort);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    VerifyOrExit(transaction != NULL, otbrLog(OTBR_LOG_WARNING, "CoAP request not found!"));
+
+    if (ContinueTransfer(*transaction, aMessage, continued) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "CoAP block-wise transfer failed: %s", strerror(errno));
+        FinishTransaction(*transaction, NULL, errno);
+    }
+    else if (!continued)
+    {
+        FinishTransaction(*transaction, &aMessage, 0);
+    }
+
+exit:
+    return;
+}
+
+otbrError AgentNative::ContinueTransfer(Transaction &aTransaction, MessageNative &aResponse, bool &aContinued)
+{
+    otbrError      ret = OTBR_ERROR_NONE;
+    Transfer *     transfer;
+    uint32_t       block;
+    bool           more;
+    uint8_t        szx;
+    uint16_t       length;
+    const uint8_t *payload = aResponse.GetPayload(length);
+
+    aContinued = false;
+
+    if ((transfer = aTransaction.mTransfer) != NULL && transfer->mSending)
+    {
+        if (aResponse.GetCode() == kCodeContinue && transfer->mOffset + transfer->mBlockLength < transfer->mLength)
+        {
+            // The peer may ask for smaller blocks, which are continued from the same offset.
+            if (aResponse.GetBlockOption(kOptionBlock1, block, more, szx) && szx < transfer->mSzx)
+            {
+                transfer->mSzx = szx;
+            }
+
+            transfer->mOffset += transfer->mBlockLength;
+            SuccessOrExit(ret = SendBlock(aTransaction, kOptionBlock1, 0));
+            ExitNow(aContinued = true);
+        }
+
+        // The whole request is received, the buffer now takes the response.
+        transfer->mSending = false;
+        transfer->mLength  = 0;
+    }
+
+    VerifyOrExit(aResponse.GetBlockOption(kOptionBlock2, block, more, szx));
+
+    if (transfer == NULL)
+    {
+        VerifyOrExit(more);
+        VerifyOrExit(aTransaction.mHeaderLength > 0, ret = OTBR_ERROR_ERRNO, errno = EMSGSIZE);
+        VerifyOrExit((transfer = NewTransfer(kTransferClient)) != NULL, ret = OTBR_ERROR_ERRNO, errno = ENOBUFS);
+        transfer->mSending     = false;
+        transfer->mLength      = 0;
+        aTransaction.mTransfer = transfer;
+    }
+
+    VerifyOrExit((block << (szx + 4)) == transfer->mLength, ret = OTBR_ERROR_ERRNO, errno = EPROTO);
+    VerifyOrExit(transfer->mLength + length <= kMaxTransferSize, ret = OTBR_ERROR_ERRNO, errno = EMSGSIZE);
+
+    if (length > 0)
+    {
+        memcpy(transfer->mData + transfer->mLength, payload, length);
+        transfer->mLength += length;
+    }
+
+    if (more)
+    {
+        transfer->mSzx = szx;
+        SuccessOrExit(ret = SendBlock(aTransaction, kOptionBlock2, block + 1));
+        ExitNow(aContinued = true);
+    }
+
+    // Hand the whole payload to the handler, the transfer is released once handled.
+    aResponse.RemoveOption(kOptionBlock2);
+    aResponse.SetPayload(transfer->mData, static_cast<uint16_t>(transfer->mLength));
+
+exit:
+    return ret;
+}
+
+void AgentNative::HandleEmpty(const MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort)
+{
+    Transaction *transaction;
+
+    switch (aMessage.GetType())
+    {
+    case kTypeConfirmable:
+        // CoAP ping.
+        SendEmpty(kTypeReset, aMessage.GetMessageId(), aIp6, aPort);
+        break;
+
+    case kTypeAcknowledgment:
+        VerifyOrExit((transaction = FindTransaction(aIp6, aPort, aMessage.GetMessageId())) != NULL);
+        Acknowledge(*transaction);
+
+        // Separate response will follow a request.
+        if (!transaction->mRequest)
+        {
+            FinishTransaction(*transaction, NULL, 0);
+        }
+        break;
+
+    case kTypeReset:
+        if ((transaction = FindTransaction(aIp6, aPort, aMessage.GetMessageId())) != NULL)
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP message %u rejected by peer!", aMessage.GetMessageId());
+            FinishTransaction(*transaction, NULL, ECONNRESET);
+            ExitNow();
+        }
+
+        // A notification is reset by an observer no longer interested.
+        for (size_t i = 0; i < kMaxObservers; ++i)
+        {
+            Observer &observer = mObservers[i];
+
+            if (observer.mResource != NULL && observer.mMessageId == aMessage.GetMessageId() &&
+                MatchPeer(observer.mIp6, observer.mPort, aIp6, aPort))
+            {
+                observer.mResource = NULL;
+                break;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+exit:
+    return;
+}
+
+AgentNative::Transaction *AgentNative::FindTransaction(const uint8_t *aIp6, uint16_t aPort, uint16_t aMessageId)
+{
+    Transaction * found = NULL;
+    unsigned long now   = GetNow();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        Transaction &transaction = mTransactions[i];
+
+        if (transaction.mInUse && transaction.mTransmissions > 0 &&
+            static_cast<long>(now - transaction.mExpiration) < 0 && !transaction.mAcknowledged &&
+            transaction.mMessageId == aMessageId &&
+            MatchPeer(transaction.mIp6, transaction.mPort, aIp6, aPort))
+        {
+            found = &transaction;
+            break;
+        }
+    }
+
+    return found;
+}
+
+AgentNative::Transaction *AgentNative::FindTransaction(const uint8_t *aIp6,
+                                                       uint16_t       aPort,
+                                                       const uint8_t *aToken,
+                                                       uint8_t        aTokenLength)
+{
+    Transaction * found = NULL;
+    unsigned long now   = GetNow();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        Transaction &transaction = mTransactions[i];
+
+        if (transaction.mInUse && transaction.mTransmissions > 0 &&
+            static_cast<long>(now - transaction.mExpiration) < 0 && transaction.mRequest &&
+            transaction.mTokenLength == aTokenLength && memcmp(transaction.mToken, aToken, aTokenLength) == 0 &&
+            MatchPeer(transaction.mIp6, transaction.mPort, aIp6, aPort))
+        {
+            found = &transaction;
+            break;
+        }
+    }
+
+    return found;
+}
+
+AgentNative::Transaction *AgentNative::NewTransaction(void)
+{
+    Transaction *found = NULL;
+
+    Purge();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        if (!mTransactions[i].mInUse)
+        {
+            found            = &mTransactions[i];
+            found->mTransfer = NULL;
+            break;
+        }
+    }
+
+    return found;
+}
+
+void AgentNative::FinishTransaction(Transaction &aTransaction, const MessageNative *aResponse, int aError)
+{
+    ResponseHandler handler  = aTransaction.mHandler;
+    void *          context  = aTransaction.mContext;
+    Transfer *      transfer = aTransaction.mTransfer;
+    Observer *      observer;
+
+    // Release first, the handler may send new requests.
+    aTransaction.mInUse    = false;
+    aTransaction.mTransfer = NULL;
+
+    // An observer not acknowledging a confirmable notification is no longer interested.
+    if (aError != 0 && !aTransaction.mRequest &&
+        (observer = FindObserver(PeerAddress(aTransaction.mIp6), aTransaction.mPort, aTransaction.mToken,
+                                 aTransaction.mTokenLength)) != NULL)
+    {
+        otbrLog(OTBR_LOG_INFO, "CoAP observer removed: %s", strerror(aError));
+        observer->mResource = NULL;
+    }
+
+    if (handler != NULL && aError != 0)
+    {
+        errno = aError;
+        handler(NULL, OTBR_ERROR_ERRNO, context);
+    }
+    else if (handler != NULL)
+    {
+        handler(aResponse, OTBR_ERROR_NONE, context);
+    }
+
+    // The response may refer to the reassembled payload.
+    if (transfer != NULL)
+    {
+        transfer->mKind = kTransferNone;
+    }
+}
+
+AgentNative::Transfer *AgentNative::FindTransfer(TransferKind    aKind,
+                                                 const Resource &aResource,
+                                                 const uint8_t * aIp6,
+                                                 uint16_t        aPort)
+{
+    Transfer *    found = NULL;
+    unsigned long now   = GetNow();
+
+    for (size_t i = 0; i < kMaxTransfers; ++i)
+    {
+        Transfer &transfer = mTransfers[i];
+
+        if (transfer.mKind == aKind && transfer.mResource == &aResource &&
+            static_cast<long>(now - transfer.mExpiration) < 0 && MatchPeer(transfer.mIp6, transfer.mPort, aIp6, aPort))
+        {
+            found = &transfer;
+            break;
+        }
+    }
+
+    return found;
+}
+
+AgentNative::Transfer *AgentNative::NewTransfer(TransferKind aKind)
+{
+    Transfer *found = NULL;
+
+    Purge();
+
+    for (size_t i = 0; i < kMaxTransfers; ++i)
+    {
+        if (mTransfers[i].mKind == kTransferNone)
+        {
+            found              = &mTransfers[i];
+            found->mKind       = aKind;
+            found->mResource   = NULL;
+            found->mExpiration = GetNow() + kExchangeLifetime;
+            break;
+        }
+    }
+
+    return found;
+}
+
+void AgentNative::Purge(void)
+{
+    unsigned long now = GetNow();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        Transaction &transaction = mTransactions[i];
+
+        if (transaction.mInUse && static_cast<long>(now - transaction.mExpiration) >= 0)
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP message %u expired without response!", transaction.mMessageId);
+            FinishTransaction(transaction, NULL, ETIMEDOUT);
+        }
+    }
+
+    // Transfers of this agent's requests are released along with their transactions.
+    for (size_t i = 0; i < kMaxTransfers; ++i)
+    {
+        Transfer &transfer = mTransfers[i];
+
+        if (transfer.mKind != kTransferNone && transfer.mKind != kTransferClient &&
+            static_cast<long>(now - transfer.mExpiration) >= 0)
+        {
+            transfer.mKind = kTransferNone;
+        }
+    }
+}
+
+void AgentNative::HandleObserve(const MessageNative &aRequest,
+                                MessageNative &      aResponse,
+                                const Resource &     aResource,
+                                const uint8_t *      aIp6,
+                                uint16_t             aPort)
+{
+    uint32_t  observe;
+    Observer *observer;
+
+    VerifyOrExit(aRequest.GetCode() == kCodeGet && aRequest.GetUintOption(kOptionObserve, observe));
+
+    observer = FindObserver(aIp6, aPort, aRequest.mToken, aRequest.mTokenLength);
+
+    // Deregister, or do not register if the resource is not served.
+    if (observe != 0 || (aResponse.GetCode() & kCodeClassMask) != kCodeCodeMin)
+    {
+        if (observer != NULL)
+        {
+            observer->mResource = NULL;
+        }
+
+        ExitNow();
+    }
+
+    for (size_t i = 0; observer == NULL && i < kMaxObservers; ++i)
+    {
+        if (mObservers[i].mResource == NULL)
+        {
+            observer = &mObservers[i];
+        }
+    }
+
+    // The response goes without Observe option, which tells the client it is not registered.
+    VerifyOrExit(observer != NULL, otbrLog(OTBR_LOG_WARNING, "CoAP observers exhausted!"));
+
+    observer->mResource    = &aResource;
+    observer->mPort        = aPort;
+    observer->mTokenLength = aRequest.mTokenLength;
+    memcpy(observer->mToken, aRequest.mToken, aRequest.mTokenLength);
+    SetPeer(observer->mIp6, aIp6);
+    observer->mMessageId   = aResponse.GetMessageId();
+    observer->mNotifyCount = 0;
+    observer->mConfirmTime = GetNow();
+    aResponse.AddUintOption(kOptionObserve, mObserveSequence);
+
+exit:
+    return;
+}
+
+AgentNative::Observer *AgentNative::FindObserver(const uint8_t *aIp6,
+                                                 uint16_t       aPort,
+                                                 const uint8_t *aToken,
+                                                 uint8_t        aTokenLength)
+{
+    Observer *found = NULL;
+
+    for (size_t i = 0; i < kMaxObservers; ++i)
+    {
+        Observer &observer = mObservers[i];
+
+        if (observer.mResource != NULL && observer.mTokenLength == aTokenLength &&
+            memcmp(observer.mToken, aToken, aTokenLength) == 0 && MatchPeer(observer.mIp6, observer.mPort, aIp6, aPort))
+        {
+            found = &observer;
+            break;
+        }
+    }
+
+    return found;
+}
+
+AgentNative::Response *AgentNative::FindResponse(const uint8_t *aIp6, uint16_t aPort, uint16_t aMessageId)
+{
+    Response *    found = NULL;
+    unsigned long now   = GetNow();
+
+    for (size_t i = 0; i < kMaxResponses; ++i)
+    {
+        Response &response = mResponses[i];
+
+        if (response.mLength > 0 && static_cast<long>(now - response.mExpiration) < 0 &&
+            response.mMessageId == aMessageId && MatchPeer(response.mIp6, response.mPort, aIp6, aPort))
+        {
+            found = &response;
+            break;
+        }
+    }
+
+    return found;
+}
+
+void AgentNative::CacheResponse(uint16_t             aMessageId,
+                                const MessageNative &aResponse,
+                                const uint8_t *      aIp6,
+                                uint16_t             aPort)
+{
+    unsigned long now   = GetNow();
+    Response *    found = &mResponses[0];
+
+    // Take a free or expired entry, otherwise forget the response expiring first.
+    for (size_t i = 0; i < kMaxResponses; ++i)
+    {
+        Response &response = mResponses[i];
+
+        if (response.mLength == 0 || static_cast<long>(now - response.mExpiration) >= 0)
+        {
+            found = &response;
+            break;
+        }
+
+        if (static_cast<long>(response.mExpiration - found->mExpiration) < 0)
+        {
+            found = &response;
+        }
+    }
+
+    if (aResponse.Serialize(found->mMessage, sizeof(found->mMessage), found->mLength) != OTBR_ERROR_NONE)
+    {
+        found->mLength = 0;
+    }
+    else
+    {
+        found->mMessageId  = aMessageId;
+        found->mPort       = aPort;
+        found->mExpiration = now + kExchangeLifetime;
+        SetPeer(found->mIp6, aIp6);
+    }
+}
+
+otbrError AgentNative::Notify(const Resource &aResource)
+{
+    otbrError     ret = OTBR_ERROR_NONE;
+    unsigned long now = GetNow();
+
+    // Notifications of one change share a sequence number, which is 24 bits on the wire.
+    mObserveSequence = (mObserveSequence + 1) & 0xffffff;
+
+    for (size_t i = 0; i < kMaxObservers; ++i)
+    {
+        Observer &    observer = mObservers[i];
+        MessageNative request;
+        MessageNative notification;
+        Transaction * transaction;
+        otbrError     error;
+
+        if (observer.mResource != &aResource)
+        {
+            continue;
+        }
+
+        request.Init(kTypeNonConfirmable, kCodeGet, 0, observer.mToken, observer.mTokenLength);
+        notification.Init(kTypeNonConfirmable, kCodeEmpty, mMessageId++, observer.mToken, observer.mTokenLength);
+        aResource.mHandler(aResource, request, notification, PeerAddress(observer.mIp6), observer.mPort,
+                           aResource.mContext);
+
+        if (notification.GetCode() == kCodeEmpty)
+        {
+            continue;
+        }
+
+        // Notifications are not sent block-wise, and a larger payload is only referenced from the returned handler.
+        if (notification.mPayloadLength > 0 && !notification.IsPayloadCopied())
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP notification too large!");
+            ret   = OTBR_ERROR_ERRNO;
+            errno = EMSGSIZE;
+            continue;
+        }
+
+        // An error response ends the observation.
+        if ((notification.GetCode() & kCodeClassMask) != kCodeCodeMin)
+        {
+            observer.mResource = NULL;
+        }
+        else
+        {
+            notification.AddUintOption(kOptionObserve, mObserveSequence);
+        }
+
+        observer.mMessageId = notification.GetMessageId();
+
+        // Confirmable now and then, so that observers gone silently do not stay forever.
+        if (++observer.mNotifyCount >= kNotifyConfirmCount ||
+            now - observer.mConfirmTime >= kNotifyConfirmPeriod * 1000UL)
+        {
+            observer.mNotifyCount = 0;
+            observer.mConfirmTime = now;
+            notification.SetType(kTypeConfirmable);
+        }
+        else
+        {
+            notification.SetType(kTypeNonConfirmable);
+        }
+
+        if (notification.GetType() == kTypeNonConfirmable)
+        {
+            error = SendMessage(notification, PeerAddress(observer.mIp6), observer.mPort);
+        }
+        else if ((transaction = NewTransaction()) == NULL)
+        {
+            error = OTBR_ERROR_ERRNO;
+            errno = ENOBUFS;
+        }
+        else
+        {
+            // The observer is removed if this fails, see FinishTransaction().
+            InitTransaction(*transaction, notification, PeerAddress(observer.mIp6), observer.mPort, NULL, NULL);
+
+            if ((error = Track(*transaction, notification)) != OTBR_ERROR_NONE)
+            {
+                transaction->mInUse = false;
+            }
+        }
+
+        if (error != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_WARNING, "CoAP failed to notify observer: %s", strerror(errno));
+            ret = OTBR_ERROR_ERRNO;
+        }
+    }
+
+    return ret;
+}
+
+size_t AgentNative::GetObserverCount(const Resource &aResource) const
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < kMaxObservers; ++i)
+    {
+        if (mObservers[i].mResource == &aResource)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+size_t AgentNative::GetPendingCount(void) const
+{
+    size_t        count = 0;
+    unsigned long now   = GetNow();
+
+    for (size_t i = 0; i < kMaxTransactions; ++i)
+    {
+        if (mTransactions[i].mInUse && static_cast<long>(now - mTransactions[i].mExpiration) < 0)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+Agent *Agent::Create(NetworkSender aNetworkSender, void *aContext)
+{
+    return new AgentNative(aNetworkSender, aContext);
+}
+
+void Agent::Destroy(Agent *aAgent)
+{
+    delete static_cast<AgentNative *>(aAgent);
+}
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,609 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definition for the native CoAP service.
+ */
+
+#ifndef COAP_NATIVE_HPP_
+#define COAP_NATIVE_HPP_
+
+#include "coap.hpp"
+#include "coap_router.hpp"
+#include "coap_rto.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+/**
+ * @addtogroup border-router-coap
+ *
+ * @brief
+ *   This module includes definition for the native CoAP service.
+ *
+ * @{
+ */
+
+/**
+ * CoAP Option numbers.
+ *
+ */
+enum OptionNumber
+{
+    kOptionObserve = 6,  ///< Observe
+    kOptionUriPath = 11, ///< Uri-Path
+    kOptionBlock2  = 23, ///< Block2
+    kOptionBlock1  = 27, ///< Block1
+    kOptionSize1   = 60, ///< Size1
+};
+
+/**
+ * This class implements CoAP message functionality.
+ *
+ * A message is either built by setters, in which case option values and payload are copied into the message, or
+ * parsed from a received buffer, in which case they refer to that buffer and are only valid as long as it is.
+ * A payload too large to be copied is referenced, and must stay valid until the message is sent.
+ *
+ */
+class MessageNative : public Message
+{
+public:
+    enum
+    {
+        kMaxTokenLength = 8,    ///< Max bytes of a CoAP token.
+        kMaxOptions     = 16,   ///< Max number of options in one message.
+        kMaxSize        = 1400, ///< Max bytes of a serialized message.
+        kMaxBlockSzx    = 6,    ///< Max block size exponent, 1024 bytes.
+    };
+
+    /**
+     * This structure represents a CoAP option.
+     *
+     */
+    struct Option
+    {
+        uint16_t       mNumber; ///< The option number.
+        uint16_t       mLength; ///< Number of bytes of the option value.
+        const uint8_t *mValue;  ///< A pointer to the option value.
+    };
+
+    /**
+     * The constructor to initialize an empty CoAP message.
+     *
+     */
+    MessageNative(void) { Init(kTypeConfirmable, kCodeEmpty, 0, NULL, 0); }
+
+    /**
+     * This method resets this message with the given arguments.
+     *
+     * @param[in]   aType           The CoAP type.
+     * @param[in]   aCode           The CoAP code.
+     * @param[in]   aMessageId      The CoAP message id.
+     * @param[in]   aToken          The CoAP token.
+     * @param[in]   aTokenLength    Number of bytes in @p aToken.
+     *
+     */
+    void Init(Type aType, Code aCode, uint16_t aMessageId, const uint8_t *aToken, uint8_t aTokenLength);
+
+    /**
+     * This method parses a CoAP message in place.
+     *
+     * Options and payload of this message refer to @p aBuffer afterwards, nothing is copied.
+     *
+     * @param[in]   aBuffer     A pointer to the serialized message.
+     * @param[in]   aLength     Number of bytes of @p aBuffer.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully parsed the message.
+     * @retval  OTBR_ERROR_ERRNO    The message is malformed, errno is set to EBADMSG.
+     *
+     */
+    otbrError Parse(const uint8_t *aBuffer, uint16_t aLength);
+
+    /**
+     * This method serializes this message.
+     *
+     * @param[out]  aBuffer     A pointer to the buffer to write the message.
+     * @param[in]   aSize       Number of bytes available in @p aBuffer.
+     * @param[out]  aLength     Number of bytes written.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully serialized the message.
+     * @retval  OTBR_ERROR_ERRNO    The message does not fit, errno is set to EMSGSIZE.
+     *
+     */
+    otbrError Serialize(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength) const;
+
+    /**
+     * This method serializes this message without payload.
+     *
+     * @param[out]  aBuffer     A pointer to the buffer to write the message.
+     * @param[in]   aSize       Number of bytes available in @p aBuffer.
+     * @param[out]  aLength     Number of bytes written.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully serialized the message.
+     * @retval  OTBR_ERROR_ERRNO    The message does not fit, errno is set to EMSGSIZE.
+     *
+     */
+    otbrError SerializeHeader(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength) const;
+
+    /**
+     * This method returns the CoAP message id of this message.
+     *
+     * @returns The CoAP message id.
+     *
+     */
+    uint16_t GetMessageId(void) const { return mMessageId; }
+
+    /**
+     * This method returns whether this message is a request.
+     *
+     * @returns Whether this message is a request.
+     *
+     */
+    bool IsRequest(void) const { return mCode != kCodeEmpty && mCode < kCodeCodeMin; }
+
+    /**
+     * This method returns whether this message is a response.
+     *
+     * @returns Whether this message is a response.
+     *
+     */
+    bool IsResponse(void) const { return mCode >= kCodeCodeMin; }
+
+    /**
+     * This method adds an option to this message, options are kept in the order of their numbers.
+     *
+     * @param[in]   aNumber     The option number.
+     * @param[in]   aValue      A pointer to the option value.
+     * @param[in]   aLength     Number of bytes of @p aValue.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the option.
+     * @retval  OTBR_ERROR_ERRNO    No space for the option, errno is set to EMSGSIZE.
+     *
+     */
+    otbrError AddOption(uint16_t aNumber, const void *aValue, uint16_t aLength);
+
+    /**
+     * This method removes all options of a number from this message.
+     *
+     * @param[in]   aNumber     The option number.
+     *
+     */
+    void RemoveOption(uint16_t aNumber);
+
+    /**
+     * This method finds the first option of a number in this message.
+     *
+     * @param[in]   aNumber     The option number.
+     *
+     * @returns A pointer to the option, NULL if not found.
+     *
+     */
+    const Option *FindOption(uint16_t aNumber) const;
+
+    /**
+     * This method adds an unsigned integer option to this message.
+     *
+     * @param[in]   aNumber     The option number.
+     * @param[in]   aValue      The option value.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the option.
+     * @retval  OTBR_ERROR_ERRNO    No space for the option, errno is set to EMSGSIZE.
+     *
+     */
+    otbrError AddUintOption(uint16_t aNumber, uint32_t aValue);
+
+    /**
+     * This method reads an unsigned integer option of this message.
+     *
+     * @param[in]   aNumber     The option number.
+     * @param[out]  aValue      The option value.
+     *
+     * @returns Whether the option is present and valid.
+     *
+     */
+    bool GetUintOption(uint16_t aNumber, uint32_t &aValue) const;
+
+    /**
+     * This method adds a Block1 or Block2 option to this message.
+     *
+     * @param[in]   aNumber     The option number, kOptionBlock1 or kOptionBlock2.
+     * @param[in]   aBlock      The block number.
+     * @param[in]   aMore       Whether more blocks follow.
+     * @param[in]   aSzx        The block size exponent, the block size is 16 << @p aSzx bytes.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the option.
+     * @retval  OTBR_ERROR_ERRNO    No space for the option, errno is set to EMSGSIZE.
+     *
+     */
+    otbrError AddBlockOption(uint16_t aNumber, uint32_t aBlock, bool aMore, uint8_t aSzx);
+
+    /**
+     * This method reads a Block1 or Block2 option of this message.
+     *
+     * @param[in]   aNumber     The option number, kOptionBlock1 or kOptionBlock2.
+     * @param[out]  aBlock      The block number.
+     * @param[out]  aMore       Whether more blocks follow.
+     * @param[out]  aSzx        The block size exponent.
+     *
+     * @returns Whether the option is present and valid.
+     *
+     */
+    bool GetBlockOption(uint16_t aNumber, uint32_t &aBlock, bool &aMore, uint8_t &aSzx) const;
+
+    /**
+     * This method returns the number of options in this message.
+     *
+     * @returns The number of options.
+     *
+     */
+    uint8_t GetOptionCount(void) const { return mOptionCount; }
+
+    /**
+     * This method returns an option of this message.
+     *
+     * @param[in]   aIndex      The index of the option, less than GetOptionCount().
+     *
+     * @returns A reference to the option.
+     *
+     */
+    const Option &GetOption(uint8_t aIndex) const { return mOptions[aIndex]; }
+
+    /**
+     * This method returns whether the Uri-Path of this message equals to @p aPath.
+     *
+     * @param[in]   aPath       A pointer to the null-terminated path, with segments separated by '/'.
+     *
+     * @returns Whether the Uri-Path matches.
+     *
+     */
+    bool MatchPath(const char *aPath) const;
+
+    Code           GetCode(void) const { return static_cast<Code>(mCode); }
+    void           SetCode(Code aCode) { mCode = static_cast<uint8_t>(aCode); }
+    Type           GetType(void) const { return static_cast<Type>(mType); }
+    void           SetType(Type aType) { mType = static_cast<uint8_t>(aType); }
+    const uint8_t *GetToken(uint8_t &aLength) const;
+    void           SetToken(const uint8_t *aToken, uint8_t aLength);
+    void           SetPath(const char *aPath);
+    const uint8_t *GetPayload(uint16_t &aLength) const;
+    void           SetPayload(const uint8_t *aPayload, uint16_t aLength);
+
+private:
+    friend class AgentNative;
+
+    uint8_t * Allocate(uint16_t aLength);
+    bool      IsPayloadCopied(void) const { return mPayload >= mData && mPayload < mData + sizeof(mData); }
+    otbrError Write(uint8_t *aBuffer, uint16_t aSize, uint16_t &aLength, bool aPayload) const;
+
+    uint8_t        mType;
+    uint8_t        mCode;
+    uint16_t       mMessageId;
+    uint8_t        mToken[kMaxTokenLength];
+    uint8_t        mTokenLength;
+    uint8_t        mOptionCount;
+    bool           mOverflow;
+    Option         mOptions[kMaxOptions];
+    const uint8_t *mPayload;
+    uint16_t       mPayloadLength;
+    uint16_t       mDataLength;
+    uint8_t        mData[kMaxSize];
+    uint8_t *      mTransferData;
+    uint32_t       mTransferSize;
+    MessageNative *mNext;
+};
+
+/**
+ * This class implements a CoAP agent without external dependencies.
+ *
+ * Messages are allocated from a fixed-size pool and received messages are parsed in place. Requests and
+ * confirmable messages are tracked in a pending-transaction table, and each of them carries its own
+ * response handler.
+ *
+ * Confirmable messages are retransmitted with a retransmission timeout estimated for each peer as in CoCoA, and
+ * at most kNStart of them are outstanding to a peer at a time, while later ones wait in order.
+ *
+ * Observers of resources are kept in a fixed-size table, and each Notify() sends notifications which share one
+ * sequence number. They are non-confirmable, except one every kNotifyConfirmCount notifications or
+ * kNotifyConfirmPeriod seconds, which tells whether the observer is still there (RFC 7641 section 4.5).
+ *
+ * Large payloads are transferred block-wise. Requests are sent with Block1 and responses are split with Block2,
+ * while received blocks are reassembled in one of a few fixed-size transfer buffers, so handlers always see whole
+ * payloads.
+ *
+ */
+class AgentNative : public Agent
+{
+public:
+    enum
+    {
+        kMaxMessages          = 8,      ///< Number of messages in the pool.
+        kMaxTransactions      = 16,     ///< Max number of pending transactions.
+        kExchangeLifetime     = 247000, ///< EXCHANGE_LIFETIME of RFC 7252 in milliseconds.
+        kMaxTransfers         = 4,      ///< Max number of concurrent block-wise transfers.
+        kMaxTransferSize      = 8192,   ///< Max bytes of a block-wise payload.
+        kMaxHeaderSize        = 128,    ///< Max bytes of a request header kept for block-wise transfers.
+        kMaxObservers         = 8,      ///< Max number of observers of all resources.
+        kMaxPeers             = 8,      ///< Max number of peers whose round-trip times are kept.
+        kMaxResponses         = 8,      ///< Max number of responses kept to answer duplicate requests.
+        kMaxRetransmit        = 4,      ///< MAX_RETRANSMIT of RFC 7252.
+        kMaxWeakTransmissions = 3,      ///< Max transmissions of a message to measure a weak RTT, as in CoCoA.
+        kNStart               = 1,      ///< NSTART of RFC 7252, max outstanding confirmable messages to a peer.
+        kNotifyConfirmCount   = 16,     ///< Max notifications to an observer per confirmable one.
+        kNotifyConfirmPeriod  = 86400,  ///< Max seconds between confirmable notifications to an observer.
+    };
+
+    /**
+     * This structure represents the transmission metrics of a peer.
+     *
+     */
+    struct PeerMetrics
+    {
+        unsigned long mRto;             ///< Current retransmission timeout in milliseconds.
+        unsigned long mStrongRtt;       ///< Smoothed RTT without retransmissions in milliseconds, 0 if unknown.
+        unsigned long mWeakRtt;         ///< Smoothed RTT after retransmissions in milliseconds, 0 if unknown.
+        size_t        mOutstanding;     ///< Number of confirmable messages waiting for acknowledgment.
+        size_t        mQueued;          ///< Number of confirmable messages waiting to be sent.
+        uint32_t      mTransmissions;   ///< Number of transmissions, including retransmissions.
+        uint32_t      mRetransmissions; ///< Number of retransmissions.
+        uint32_t      mTimeouts;        ///< Number of messages never acknowledged.
+    };
+
+    /**
+     * The constructor to initialize a CoAP agent.
+     *
+     * @param[in]   aNetworkSender      A pointer to the function that actually sends the data.
+     * @param[in]   aContext            A pointer to application-specific context.
+     *
+     */
+    AgentNative(NetworkSender aNetworkSender, void *aContext);
+
+    void      Input(const void *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort);
+    otbrError Send(Message &aMessage, const uint8_t *aIp6, uint16_t aPort, ResponseHandler aHandler, void *aContext);
+    Message * NewMessage(Type aType, Code aCode, const uint8_t *aToken, uint8_t aTokenLength);
+    void      FreeMessage(Message *aMessage);
+    otbrError AddResource(const Resource &aResource);
+    otbrError RemoveResource(const Resource &aResource);
+    otbrError SetBlockSize(uint16_t aBlockSize);
+    otbrError Notify(const Resource &aResource);
+    void      UpdateTimeout(timeval &aTimeout) const;
+    void      Process(void);
+
+    /**
+     * This method returns the number of pending transactions.
+     *
+     * @returns The number of pending transactions.
+     *
+     */
+    size_t GetPendingCount(void) const;
+
+    /**
+     * This method returns the number of observers of a resource.
+     *
+     * @param[in]   aResource   A reference to the resource.
+     *
+     * @returns The number of observers.
+     *
+     */
+    size_t GetObserverCount(const Resource &aResource) const;
+
+    /**
+     * This method returns the transmission metrics of a peer.
+     *
+     * @param[in]   aIp6        A pointer to the IPv6 address of the peer.
+     * @param[in]   aPort       The UDP port of the peer.
+     * @param[out]  aMetrics    A reference to where to put the metrics.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully got the metrics.
+     * @retval  OTBR_ERROR_ERRNO    Nothing was sent to the peer, errno is set to ENOENT.
+     *
+     */
+    otbrError GetPeerMetrics(const uint8_t *aIp6, uint16_t aPort, PeerMetrics &aMetrics) const;
+
+    /**
+     * This method enables or disables the estimation of retransmission timeouts.
+     *
+     * When disabled, confirmable messages are retransmitted with the fixed timers of RFC 7252.
+     *
+     * @param[in]   aEnabled    Whether to estimate retransmission timeouts.
+     *
+     */
+    void SetAdaptiveRto(bool aEnabled) { mAdaptiveRto = aEnabled; }
+
+private:
+    enum TransferKind
+    {
+        kTransferNone,          ///< The transfer buffer is free.
+        kTransferClient,        ///< Sending Block1 or receiving Block2 of a request of this agent.
+        kTransferBlock1Receive, ///< Receiving Block1 of a request of a peer.
+        kTransferBlock2Send,    ///< Sending Block2 of a response to a peer.
+    };
+
+    struct Transfer
+    {
+        uint8_t         mKind;
+        bool            mSending;
+        uint8_t         mSzx;
+        uint8_t         mCode;
+        uint16_t        mPort;
+        uint8_t         mIp6[16];
+        const Resource *mResource;
+        unsigned long   mExpiration;
+        uint32_t        mOffset;
+        uint32_t        mBlockLength;
+        uint32_t        mLength;
+        uint8_t         mData[kMaxTransferSize];
+    };
+
+    struct Transaction
+    {
+        bool            mInUse;
+        bool            mAcknowledged;
+        bool            mRequest;
+        uint8_t         mTokenLength;
+        uint8_t         mToken[MessageNative::kMaxTokenLength];
+        uint16_t        mMessageId;
+        uint16_t        mPort;
+        uint8_t         mIp6[16];
+        unsigned long   mExpiration;
+        ResponseHandler mHandler;
+        void *          mContext;
+        Transfer *      mTransfer;
+        uint16_t        mHeaderLength;
+        uint8_t         mHeader[kMaxHeaderSize];
+        uint8_t         mTransmissions;
+        uint32_t        mOrder;
+        unsigned long   mSentTime;
+        unsigned long   mRto;
+        unsigned long   mTimeout;
+        unsigned long   mRetransmitTime;
+        uint16_t        mLength;
+        uint8_t         mMessage[MessageNative::kMaxSize];
+    };
+
+    struct Peer
+    {
+        bool          mInUse;
+        uint16_t      mPort;
+        uint8_t       mIp6[16];
+        unsigned long mUseTime;
+        RtoEstimator  mRtoEstimator;
+        uint32_t      mTransmissions;
+        uint32_t      mRetransmissions;
+        uint32_t      mTimeouts;
+    };
+
+    struct Observer
+    {
+        const Resource *mResource;
+        uint16_t        mPort;
+        uint8_t         mIp6[16];
+        uint8_t         mTokenLength;
+        uint8_t         mToken[MessageNative::kMaxTokenLength];
+        uint16_t        mMessageId;
+        uint8_t         mNotifyCount;
+        unsigned long   mConfirmTime;
+    };
+
+    struct Response
+    {
+        uint16_t      mMessageId;
+        uint16_t      mPort;
+        uint8_t       mIp6[16];
+        unsigned long mExpiration;
+        uint16_t      mLength;
+        uint8_t       mMessage[MessageNative::kMaxSize];
+    };
+
+    otbrError    SendMessage(const MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort);
+    void         SendEmpty(Type aType, uint16_t aMessageId, const uint8_t *aIp6, uint16_t aPort);
+    void         InitTransaction(Transaction &        aTransaction,
+                                 const MessageNative &aMessage,
+                                 const uint8_t *      aIp6,
+                                 uint16_t             aPort,
+                                 ResponseHandler      aHandler,
+                                 void *               aContext);
+    otbrError    Track(Transaction &aTransaction, const MessageNative &aMessage);
+    otbrError    Transmit(Transaction &aTransaction);
+    bool         IsSendable(const Transaction &aTransaction) const;
+    void         SendQueued(void);
+    void         Acknowledge(Transaction &aTransaction);
+    Peer &       GetPeer(const uint8_t *aIp6, uint16_t aPort);
+    const Peer * FindPeer(const uint8_t *aIp6, uint16_t aPort) const;
+    otbrError    SendBlock(Transaction &aTransaction, uint16_t aOption, uint32_t aBlock);
+    void         HandleRequest(MessageNative &aRequest, const uint8_t *aIp6, uint16_t aPort);
+    bool         HandleBlock1(MessageNative & aRequest,
+                              MessageNative & aResponse,
+                              const Resource &aResource,
+                              const uint8_t * aIp6,
+                              uint16_t        aPort);
+    void         SplitResponse(const MessageNative &aRequest,
+                               MessageNative &      aResponse,
+                               const Resource &     aResource,
+                               const uint8_t *      aIp6,
+                               uint16_t             aPort);
+    bool         SetBlock2(MessageNative &aResponse,
+                           const uint8_t *aData,
+                           uint32_t       aLength,
+                           uint32_t       aBlock,
+                           uint8_t        aSzx);
+    void         HandleResponse(MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort);
+    otbrError    ContinueTransfer(Transaction &aTransaction, MessageNative &aResponse, bool &aContinued);
+    void         HandleEmpty(const MessageNative &aMessage, const uint8_t *aIp6, uint16_t aPort);
+    Transaction *FindTransaction(const uint8_t *aIp6, uint16_t aPort, uint16_t aMessageId);
+    Transaction *FindTransaction(const uint8_t *aIp6, uint16_t aPort, const uint8_t *aToken, uint8_t aTokenLength);
+    Transaction *NewTransaction(void);
+    void         FinishTransaction(Transaction &aTransaction, const MessageNative *aResponse, int aError);
+    Transfer *   FindTransfer(TransferKind aKind, const Resource &aResource, const uint8_t *aIp6, uint16_t aPort);
+    Transfer *   NewTransfer(TransferKind aKind);
+    void         Purge(void);
+    void         HandleObserve(const MessageNative &aRequest,
+                               MessageNative &      aResponse,
+                               const Resource &     aResource,
+                               const uint8_t *      aIp6,
+                               uint16_t             aPort);
+    Observer *   FindObserver(const uint8_t *aIp6, uint16_t aPort, const uint8_t *aToken, uint8_t aTokenLength);
+    Response *   FindResponse(const uint8_t *aIp6, uint16_t aPort, uint16_t aMessageId);
+    void         CacheResponse(uint16_t             aMessageId,
+                               const MessageNative &aResponse,
+                               const uint8_t *      aIp6,
+                               uint16_t             aPort);
+
+    Router         mRouter;
+    NetworkSender  mNetworkSender;
+    void *         mContext;
+    uint16_t       mMessageId;
+    MessageNative  mMessages[kMaxMessages];
+    MessageNative *mFreeMessages;
+    Transaction    mTransactions[kMaxTransactions];
+    Transfer       mTransfers[kMaxTransfers];
+    Observer       mObservers[kMaxObservers];
+    uint32_t       mObserveSequence;
+    Peer           mPeers[kMaxPeers];
+    Response       mResponses[kMaxResponses];
+    bool           mAdaptiveRto;
+    uint32_t       mNextOrder;
+    uint8_t        mBlockSzx;
+    uint16_t       mBlockThreshold;
+    uint8_t        mBuffer[MessageNative::kMaxSize];
+    uint8_t        mResponsePayload[kMaxTransferSize];
+};
+
+/**
+ * @}
+ */
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // COAP_NATIVE_HPP_
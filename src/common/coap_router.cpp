@@ -0,0 +1,242 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file implements the CoAP resource router.
+ */
+
+#include "coap_router.hpp"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+
+#include "code_utils.hpp"
+#include "coap_native.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+static int CompareSegment(const std::string &aSegment, const char *aKey, size_t aLength)
+{
+    int result = memcmp(aSegment.data(), aKey, std::min(aSegment.size(), aLength));
+
+    if (result == 0)
+    {
+        result = (aSegment.size() < aLength ? -1 : (aSegment.size() > aLength ? 1 : 0));
+    }
+
+    return result;
+}
+
+Router::Router(void)
+    : mRoot(new Node)
+{
+}
+
+Router::~Router(void)
+{
+    Destroy(mRoot);
+}
+
+void Router::Destroy(Node *aNode)
+{
+    for (std::vector<Node *>::iterator it = aNode->mChildren.begin(); it != aNode->mChildren.end(); ++it)
+    {
+        Destroy(*it);
+    }
+
+    delete aNode;
+}
+
+const char *Router::NextSegment(const char *aPath, size_t &aLength)
+{
+    while (*aPath == '/')
+    {
+        ++aPath;
+    }
+
+    aLength = strcspn(aPath, "/");
+
+    return aLength > 0 ? aPath : NULL;
+}
+
+Router::Node *Router::FindChild(const Node &aNode, const char *aSegment, size_t aLength)
+{
+    Node * child = NULL;
+    size_t low   = 0;
+    size_t high  = aNode.mChildren.size();
+
+    // Children are sorted by segment.
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        int    result = CompareSegment(aNode.mChildren[middle]->mSegment, aSegment, aLength);
+
+        if (result == 0)
+        {
+            child = aNode.mChildren[middle];
+            break;
+        }
+
+        if (result < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return child;
+}
+
+otbrError Router::Add(const Resource &aResource)
+{
+    otbrError   ret  = OTBR_ERROR_ERRNO;
+    Node *      node = mRoot;
+    const char *segment;
+    size_t      length;
+
+    for (const char *path = aResource.mPath; (segment = NextSegment(path, length)) != NULL; path = segment + length)
+    {
+        Node *child = FindChild(*node, segment, length);
+
+        if (child == NULL)
+        {
+            std::vector<Node *>::iterator it = node->mChildren.begin();
+
+            while (it != node->mChildren.end() && CompareSegment((*it)->mSegment, segment, length) < 0)
+            {
+                ++it;
+            }
+
+            child           = new Node;
+            child->mSegment = std::string(segment, length);
+            node->mChildren.insert(it, child);
+        }
+
+        node = child;
+    }
+
+    for (std::vector<const Resource *>::iterator it = node->mResources.begin(); it != node->mResources.end(); ++it)
+    {
+        VerifyOrExit(*it != &aResource && ((*it)->mMethods & aResource.mMethods) == 0, errno = EEXIST);
+    }
+
+    node->mResources.push_back(&aResource);
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+otbrError Router::Remove(const Resource &aResource)
+{
+    otbrError                               ret  = OTBR_ERROR_ERRNO;
+    Node *                                  node = mRoot;
+    std::vector<Node *>                     parents;
+    std::vector<const Resource *>::iterator it;
+    const char *                            segment;
+    size_t                                  length;
+
+    for (const char *path = aResource.mPath; (segment = NextSegment(path, length)) != NULL; path = segment + length)
+    {
+        parents.push_back(node);
+        VerifyOrExit((node = FindChild(*node, segment, length)) != NULL, errno = ENOENT);
+    }
+
+    it = std::find(node->mResources.begin(), node->mResources.end(), &aResource);
+    VerifyOrExit(it != node->mResources.end(), errno = ENOENT);
+    node->mResources.erase(it);
+
+    // Prune nodes left without resources or children.
+    while (!parents.empty() && node->mResources.empty() && node->mChildren.empty())
+    {
+        Node *parent = parents.back();
+
+        parents.pop_back();
+        parent->mChildren.erase(std::find(parent->mChildren.begin(), parent->mChildren.end(), node));
+        delete node;
+        node = parent;
+    }
+
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+const Resource *Router::Find(const MessageNative &aRequest, bool &aPathFound) const
+{
+    const Resource *resource = NULL;
+    const Node *    node     = mRoot;
+    unsigned int    method   = 0;
+
+    aPathFound = false;
+
+    // Request codes go up to 0x3f, and only those of known methods are shifted to match the methods of resources.
+    VerifyOrExit(aRequest.GetCode() <= kCodeDelete);
+    method = 1U << aRequest.GetCode();
+
+    for (uint8_t i = 0; i < aRequest.GetOptionCount(); ++i)
+    {
+        const MessageNative::Option &option = aRequest.GetOption(i);
+
+        if (option.mNumber == kOptionUriPath)
+        {
+            VerifyOrExit((node = FindChild(*node, reinterpret_cast<const char *>(option.mValue), option.mLength)) !=
+                         NULL);
+        }
+    }
+
+    aPathFound = !node->mResources.empty();
+
+    for (std::vector<const Resource *>::const_iterator it = node->mResources.begin(); it != node->mResources.end();
+         ++it)
+    {
+        if ((*it)->mMethods & method)
+        {
+            ExitNow(resource = *it);
+        }
+    }
+
+exit:
+    return resource;
+}
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
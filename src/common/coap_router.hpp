@@ -0,0 +1,122 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definition for the CoAP resource router.
+ */
+
+#ifndef COAP_ROUTER_HPP_
+#define COAP_ROUTER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "coap.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+class MessageNative;
+
+/**
+ * This class implements a trie of CoAP resources keyed on Uri-Path segments.
+ *
+ * Lookup walks one trie level per segment of the request and does not allocate.
+ *
+ */
+class Router
+{
+public:
+    /**
+     * The constructor to initialize an empty router.
+     *
+     */
+    Router(void);
+
+    ~Router(void);
+
+    /**
+     * This method adds a resource.
+     *
+     * @param[in]   aResource   A reference to the resource.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the resource.
+     * @retval  OTBR_ERROR_ERRNO    Failed to add the resource.
+     *                              - EEXIST The resource, or another handling the same method of the path, was added.
+     *
+     */
+    otbrError Add(const Resource &aResource);
+
+    /**
+     * This method removes a resource.
+     *
+     * @param[in]   aResource   A reference to the resource.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully removed the resource.
+     * @retval  OTBR_ERROR_ERRNO    Failed to remove the resource.
+     *                              - ENOENT The resource was not added.
+     *
+     */
+    otbrError Remove(const Resource &aResource);
+
+    /**
+     * This method finds the resource to handle a request.
+     *
+     * @param[in]   aRequest    A reference to the request.
+     * @param[out]  aPathFound  Whether any resource is at the path of the request, regardless of the method.
+     *
+     * @returns A pointer to the resource, NULL if not found or if the method is unknown.
+     *
+     */
+    const Resource *Find(const MessageNative &aRequest, bool &aPathFound) const;
+
+private:
+    struct Node
+    {
+        std::string                   mSegment;
+        std::vector<Node *>           mChildren;
+        std::vector<const Resource *> mResources;
+    };
+
+    static Node *      FindChild(const Node &aNode, const char *aSegment, size_t aLength);
+    static void        Destroy(Node *aNode);
+    static const char *NextSegment(const char *aPath, size_t &aLength);
+
+    Node *mRoot;
+};
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // COAP_ROUTER_HPP_
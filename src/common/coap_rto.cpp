@@ -0,0 +1,147 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   The file implements the CoAP retransmission timeout estimator.
+ */
+
+#include "coap_rto.hpp"
+
+#include <algorithm>
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+enum
+{
+    kStrongK       = 4,    ///< Weight of the RTT variation in strong RTO.
+    kWeakK         = 1,    ///< Weight of the RTT variation in weak RTO.
+    kShortRto      = 1000, ///< RTO below which timeouts are backed off faster and aged upwards.
+    kLongRto       = 3000, ///< RTO above which timeouts are backed off slower and aged downwards.
+    kShortRtoAging = 16,   ///< Number of RTOs without update before a short RTO is doubled.
+    kLongRtoAging  = 4,    ///< Number of RTOs without update before a long RTO moves toward the initial RTO.
+};
+
+RtoEstimator::RtoEstimator(void)
+{
+    Reset(0);
+}
+
+void RtoEstimator::Reset(unsigned long aNow)
+{
+    mStrong.mSrtt   = 0;
+    mStrong.mRttvar = 0;
+    mWeak.mSrtt     = 0;
+    mWeak.mRttvar   = 0;
+    mRto            = kInitialRto;
+    mUpdateTime     = aNow;
+}
+
+unsigned long RtoEstimator::Estimate(Estimator &aEstimator, unsigned long aRtt, unsigned long aK)
+{
+    // RFC 6298 with alpha 1/8 and beta 1/4, and a round-trip time of 0 stands for no measurement.
+    aRtt = std::max(aRtt, 1UL);
+
+    if (aEstimator.mSrtt == 0)
+    {
+        aEstimator.mSrtt   = aRtt;
+        aEstimator.mRttvar = aRtt / 2;
+    }
+    else
+    {
+        unsigned long delta = (aEstimator.mSrtt > aRtt ? aEstimator.mSrtt - aRtt : aRtt - aEstimator.mSrtt);
+
+        aEstimator.mRttvar = (3 * aEstimator.mRttvar + delta) / 4;
+        aEstimator.mSrtt   = (7 * aEstimator.mSrtt + aRtt) / 8;
+    }
+
+    return aEstimator.mSrtt + std::max(aK * aEstimator.mRttvar, 1UL);
+}
+
+void RtoEstimator::Update(unsigned long aRtt, bool aStrong, unsigned long aNow)
+{
+    if (aStrong)
+    {
+        mRto = (Estimate(mStrong, aRtt, kStrongK) + mRto) / 2;
+    }
+    else
+    {
+        mRto = (Estimate(mWeak, aRtt, kWeakK) + 3 * mRto) / 4;
+    }
+
+    mRto        = std::min(mRto, static_cast<unsigned long>(kMaxRto));
+    mUpdateTime = aNow;
+}
+
+unsigned long RtoEstimator::GetRto(unsigned long aNow)
+{
+    unsigned long idle = aNow - mUpdateTime;
+
+    // Estimates which are not refreshed converge to the initial RTO.
+    if (mRto < kShortRto && idle >= kShortRtoAging * mRto)
+    {
+        mRto        = 2 * mRto;
+        mUpdateTime = aNow;
+    }
+    else if (mRto > kLongRto && idle >= kLongRtoAging * mRto)
+    {
+        mRto        = (kInitialRto + mRto) / 2;
+        mUpdateTime = aNow;
+    }
+
+    return mRto;
+}
+
+unsigned long RtoEstimator::Backoff(unsigned long aTimeout, unsigned long aRto)
+{
+    unsigned long timeout;
+
+    if (aRto < kShortRto)
+    {
+        timeout = 3 * aTimeout;
+    }
+    else if (aRto > kLongRto)
+    {
+        timeout = aTimeout + aTimeout / 2;
+    }
+    else
+    {
+        timeout = 2 * aTimeout;
+    }
+
+    return std::min(timeout, static_cast<unsigned long>(kMaxRto));
+}
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
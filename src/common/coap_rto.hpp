@@ -0,0 +1,143 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definition for the CoAP retransmission timeout estimator.
+ */
+
+#ifndef COAP_RTO_HPP_
+#define COAP_RTO_HPP_
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+/**
+ * This class implements a retransmission timeout estimator of a peer as in CoCoA (draft-ietf-core-cocoa).
+ *
+ * Round-trip times of exchanges acknowledged without retransmission feed the strong estimator, and those
+ * acknowledged after one or two retransmissions feed the weak one, as it is unknown which transmission was
+ * acknowledged. All times are in milliseconds.
+ *
+ */
+class RtoEstimator
+{
+public:
+    enum
+    {
+        kInitialRto = 2000,  ///< RTO before any measurement, ACK_TIMEOUT of RFC 7252.
+        kMaxRto     = 60000, ///< Upper bound of RTO and of backed off timeouts.
+    };
+
+    /**
+     * The constructor to initialize an estimator without measurements.
+     *
+     */
+    RtoEstimator(void);
+
+    /**
+     * This method drops all measurements.
+     *
+     * @param[in]   aNow    The current time.
+     *
+     */
+    void Reset(unsigned long aNow);
+
+    /**
+     * This method updates the estimation with a round-trip time measurement.
+     *
+     * @param[in]   aRtt        The round-trip time, from the first transmission of the message.
+     * @param[in]   aStrong     Whether the message was acknowledged without retransmission.
+     * @param[in]   aNow        The current time.
+     *
+     */
+    void Update(unsigned long aRtt, bool aStrong, unsigned long aNow);
+
+    /**
+     * This method returns the retransmission timeout, aged if it has not been updated for long.
+     *
+     * @param[in]   aNow    The current time.
+     *
+     * @returns The retransmission timeout.
+     *
+     */
+    unsigned long GetRto(unsigned long aNow);
+
+    /**
+     * This method returns the smoothed round-trip time of the strong estimator.
+     *
+     * @returns The smoothed round-trip time, 0 if not measured.
+     *
+     */
+    unsigned long GetStrongRtt(void) const { return mStrong.mSrtt; }
+
+    /**
+     * This method returns the smoothed round-trip time of the weak estimator.
+     *
+     * @returns The smoothed round-trip time, 0 if not measured.
+     *
+     */
+    unsigned long GetWeakRtt(void) const { return mWeak.mSrtt; }
+
+    /**
+     * This method backs off a timeout after a retransmission, by a factor depending on the initial timeout.
+     *
+     * Short timeouts are tripled, and long ones grow by half, so that neither spins nor stalls.
+     *
+     * @param[in]   aTimeout    The current timeout.
+     * @param[in]   aRto        The retransmission timeout the message was first sent with.
+     *
+     * @returns The timeout of the next retransmission.
+     *
+     */
+    static unsigned long Backoff(unsigned long aTimeout, unsigned long aRto);
+
+private:
+    struct Estimator
+    {
+        unsigned long mSrtt;
+        unsigned long mRttvar;
+    };
+
+    static unsigned long Estimate(Estimator &aEstimator, unsigned long aRtt, unsigned long aK);
+
+    Estimator     mStrong;
+    Estimator     mWeak;
+    unsigned long mRto;
+    unsigned long mUpdateTime;
+};
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // COAP_RTO_HPP_
@@ -34,9 +34,9 @@
 #ifndef DTLS_HPP_
 #define DTLS_HPP_
 
-#include <sys/select.h>
 #include <unistd.h>
 
+#include "event_loop.hpp"
 #include "types.hpp"
 
 namespace ot {
@@ -156,13 +156,14 @@ public:
     /**
      * This method creates a DTLS server.
      *
+     * @param[in]   aEventLoop          A reference to the event loop driving this DTLS server.
      * @param[in]   aPort               The listening port of this DTLS server.
      * @param[in]   aStateHandler       A pointer to a function to be called when session state changed.
      * @param[in]   aContext            A pointer to application-specific context.
      *
      * @returns pointer to the created the DTLS server.
      */
-    static Server *Create(uint16_t aPort, StateHandler aStateHandler, void *aContext);
+    static Server *Create(EventLoop &aEventLoop, uint16_t aPort, StateHandler aStateHandler, void *aContext);
 
     /**
      * This method destroy a DTLS server.
@@ -197,7 +198,7 @@ public:
     virtual otbrError SetSeed(const uint8_t *aSeed, uint16_t aLength) = 0;
 
     /**
-     * This method starts the DTLS service.
+     * This method starts the DTLS service, whose socket and timers are then served by the event loop.
      *
      * @retval      OTBR_ERROR_NONE     Successfully started.
      * @retval      OTBR_ERROR_ERRNO    Failed to start for system error.
@@ -206,33 +207,6 @@ public:
      */
     virtual otbrError Start(void) = 0;
 
-    /**
-     * This method updates the fd_set and timeout for mainloop. @p aTimeout should
-     * only be updated if the DTLS service has pending process in less than its current value.
-     *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
-     * @param[inout]    aTimeout        A reference to the timeout.
-     *
-     */
-    virtual void UpdateFdSet(fd_set & aReadFdSet,
-                             fd_set & aWriteFdSet,
-                             fd_set & aErrorFdSet,
-                             int &    aMaxFd,
-                             timeval &aTimeout) = 0;
-
-    /**
-     * This method performs the DTLS processing.
-     *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
-     *
-     */
-    virtual void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet) = 0;
-
     virtual ~Server(void) {}
 };
 
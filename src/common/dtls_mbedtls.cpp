@@ -36,6 +36,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -127,9 +128,9 @@ void MbedtlsServer::MbedtlsDebug(int aLevel, const char *aFile, int aLine, const
     }
 }
 
-Server *Server::Create(uint16_t aPort, StateHandler aStateHandler, void *aContext)
+Server *Server::Create(EventLoop &aEventLoop, uint16_t aPort, StateHandler aStateHandler, void *aContext)
 {
-    return new MbedtlsServer(aPort, aStateHandler, aContext);
+    return new MbedtlsServer(aEventLoop, aPort, aStateHandler, aContext);
 }
 
 void Server::Destroy(Server *aServer)
@@ -145,9 +146,6 @@ otbrError MbedtlsServer::Start(void)
 
     mbedtls_ssl_config_init(&mConf);
     mbedtls_ssl_cookie_init(&mCookie);
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_init(&mCache);
-#endif
     mbedtls_entropy_init(&mEntropy);
     mbedtls_ctr_drbg_init(&mCtrDrbg);
 
@@ -165,16 +163,17 @@ otbrError MbedtlsServer::Start(void)
     mbedtls_ssl_conf_dbg(&mConf, MbedtlsDebug, this);
     mbedtls_ssl_conf_ciphersuites(&mConf, ciphersuites);
     mbedtls_ssl_conf_read_timeout(&mConf, 0);
+    mbedtls_ssl_conf_export_keys_cb(&mConf, ExportKeys, this);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_conf_session_cache(&mConf, &mCache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
-#endif
+    // Reconnecting commissioners resume their session instead of running EC-JPAKE again.
+    mbedtls_ssl_conf_session_cache(&mConf, &mSessionCache, SessionCache::Get, SessionCache::Set);
 
     SuccessOrExit(error = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, &mCtrDrbg));
 
     mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check, &mCookie);
 
     SuccessOrExit(ret = Bind());
+    SuccessOrExit(ret = mEventLoop.AddIo(mSocket, EventLoop::kEventReadable, HandleIo, this));
 
 exit:
 
@@ -198,6 +197,8 @@ otbrError MbedtlsServer::Bind(void)
     sin6.sin6_port   = htons(mPort);
 
     VerifyOrExit((mSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) != -1);
+    // All sessions share this socket, so it must never block the mainloop.
+    SuccessOrExit(fcntl(mSocket, F_SETFL, fcntl(mSocket, F_GETFL, 0) | O_NONBLOCK));
     // This option enables retrieving the original destination IPv6 address.
     SuccessOrExit(setsockopt(mSocket, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one)));
     // This option allows binding to the same address.
@@ -220,6 +221,7 @@ void MbedtlsSession::SetState(State aState)
 {
     mState = aState;
     mServer.HandleSessionState(*this, aState);
+    mServer.UpdateTimer(*this);
 }
 
 void MbedtlsSession::SetDataHandler(DataHandler aDataHandler, void *aContext)
@@ -260,18 +262,19 @@ exit:
 MbedtlsSession::~MbedtlsSession(void)
 {
     Close();
-    // In case session socket is not actually created.
-    if (mNet.fd != mServer.mSocket)
-    {
-        mbedtls_net_free(&mNet);
-    }
     mbedtls_ssl_free(&mSsl);
     otbrLog(OTBR_LOG_INFO, "DTLS session destroyed: %d.", mState);
 }
 
-void MbedtlsSession::Process(void)
+void MbedtlsSession::Process(const uint8_t *aBuffer, uint16_t aLength)
 {
-    mExpiration = GetNow() + kSessionTimeout;
+    if (aBuffer != NULL)
+    {
+        mExpiration = GetNow() + kSessionTimeout;
+    }
+
+    mReceiveBuffer = aBuffer;
+    mReceiveLength = aLength;
 
     switch (mState)
     {
@@ -286,6 +289,9 @@ void MbedtlsSession::Process(void)
     default:
         break;
     }
+
+    mReceiveBuffer = NULL;
+    mReceiveLength = 0;
 }
 
 int MbedtlsSession::Read(void)
@@ -337,33 +343,42 @@ int MbedtlsSession::Read(void)
     return ret;
 } // namespace Dtls
 
-int MbedtlsSession::ExportKeys(void *               aContext,
-                               const unsigned char *aMasterSecret,
-                               const unsigned char *aKeyBlock,
-                               size_t               aMacLength,
-                               size_t               aKeyLength,
-                               size_t               aIvLength)
+int MbedtlsServer::ExportKeys(void *               aContext,
+                              const unsigned char *aMasterSecret,
+                              const unsigned char *aKeyBlock,
+                              size_t               aMacLength,
+                              size_t               aKeyLength,
+                              size_t               aIvLength)
 {
+    // The key export callback is per configuration, so keys belong to the session being processed.
+    MbedtlsSession *       session = static_cast<MbedtlsServer *>(aContext)->mProcessingSession;
     mbedtls_sha256_context sha256;
 
+    VerifyOrExit(session != NULL);
+
     mbedtls_sha256_init(&sha256);
     mbedtls_sha256_starts(&sha256, 0);
     mbedtls_sha256_update(&sha256, aKeyBlock, 2 * static_cast<uint16_t>(aMacLength + aKeyLength + aIvLength));
-    mbedtls_sha256_finish(&sha256, static_cast<MbedtlsSession *>(aContext)->mKek);
+    mbedtls_sha256_finish(&sha256, session->mKek);
+    mbedtls_sha256_free(&sha256);
 
+exit:
     (void)aMasterSecret;
     return 0;
 }
 
 MbedtlsSession::MbedtlsSession(MbedtlsServer &            aServer,
-                               const mbedtls_net_context &aNet,
                                const struct sockaddr_in6 &aRemoteSock,
-                               const sockaddr_in6 &       aLocalSock)
-    : mNet(aNet)
-    , mRemoteSock(aRemoteSock)
+                               const struct sockaddr_in6 &aLocalSock)
+    : mRemoteSock(aRemoteSock)
     , mLocalSock(aLocalSock)
     , mServer(aServer)
+    , mExpiration(GetNow() + kSessionTimeout)
     , mIsTimerSet(false)
+    , mReceiveBuffer(NULL)
+    , mReceiveLength(0)
+    , mTimerDeadline(0)
+    , mTimerIndex(kInvalidTimerIndex)
 {
 }
 
@@ -448,24 +463,45 @@ exit:
 
 int MbedtlsSession::ReadMbedtls(unsigned char *aBuffer, size_t aLength)
 {
-    return mbedtls_net_recv(&mNet, aBuffer, aLength);
+    int ret = MBEDTLS_ERR_SSL_WANT_READ;
+
+    VerifyOrExit(mReceiveBuffer != NULL && mReceiveLength > 0);
+
+    ret = static_cast<int>(std::min(aLength, static_cast<size_t>(mReceiveLength)));
+    memcpy(aBuffer, mReceiveBuffer, static_cast<size_t>(ret));
+
+    // A datagram is consumed at once.
+    mReceiveBuffer = NULL;
+    mReceiveLength = 0;
+
+exit:
+    return ret;
 }
 
 int MbedtlsSession::SendMbedtls(const unsigned char *aBuffer, size_t aLength)
 {
-    int  opt = 1;
-    int &fd  = mNet.fd;
-    int  ret = 0;
+    return mServer.SendTo(aBuffer, aLength, mRemoteSock, mLocalSock);
+}
 
-    VerifyOrExit((fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) != -1, ret = -1);
-    SuccessOrExit(ret = setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)));
-    SuccessOrExit(ret = bind(fd, reinterpret_cast<const struct sockaddr *>(&mLocalSock), sizeof(mLocalSock)));
-    SuccessOrExit(ret = connect(fd, reinterpret_cast<const struct sockaddr *>(&mRemoteSock), sizeof(mRemoteSock)));
-    SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
-    mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
-    VerifyOrExit((ret = mbedtls_net_send(&mNet, aBuffer, aLength)) != -1);
+int MbedtlsServer::SendTo(const uint8_t *     aBuffer,
+                          size_t              aLength,
+                          const sockaddr_in6 &aRemoteSock,
+                          const sockaddr_in6 &aLocalSock)
+{
+    int ret = static_cast<int>(aLength);
+
+    // Datagrams are queued and sent in a batch when the current processing is done.
+    if (mBatch.Send(mSocket, aBuffer, static_cast<uint16_t>(aLength), aRemoteSock, &aLocalSock) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "DTLS failed to send: %s!", strerror(errno));
+        ret = MBEDTLS_ERR_NET_SEND_FAILED;
+    }
+    else if (mProcessingSession == NULL && !mFlushTimer.IsRunning())
+    {
+        // Data written by sessions out of processing is sent together once the event loop is back.
+        mEventLoop.StartTimer(mFlushTimer, 0);
+    }
 
-exit:
     return ret;
 }
 
@@ -506,176 +542,276 @@ exit:
     return ret;
 }
 
-void MbedtlsServer::UpdateFdSet(fd_set & aReadFdSet,
-                                fd_set & aWriteFdSet,
-                                fd_set & aErrorFdSet,
-                                int &    aMaxFd,
-                                timeval &aTimeout)
+void MbedtlsServer::HandleSessionState(Session &aSession, Session::State aState)
 {
-    unsigned long now     = GetNow();
-    unsigned long timeout = GetTimestamp(aTimeout);
+    otbrLog(OTBR_LOG_INFO, "DTLS session state changed to %d.", aState);
+    if (mStateHandler)
+    {
+        mStateHandler(aSession, aState, mContext);
+    }
+}
 
-    for (SessionSet::iterator it = mSessions.begin(); it != mSessions.end();)
+void MbedtlsServer::ProcessServer(void)
+{
+    int count;
+
+    /* Connection is not alive yet, or is shut down */
+    VerifyOrExit(mSocket >= 0);
+
+    count = mBatch.Receive(mSocket);
+    VerifyOrExit(count >= 0, otbrLog(OTBR_LOG_ERR, "DTLS failed to receive: %s!", strerror(errno)));
+
+    for (int i = 0; i < count; ++i)
     {
-        MbedtlsSession *session = *it;
+        const UdpBatch::Datagram &datagram = mBatch.GetReceived(static_cast<size_t>(i));
+        sockaddr_in6              dst      = datagram.mLocalSock;
+        MbedtlsSession *          session  = NULL;
+        SessionMap::iterator      it;
 
-        if (session->GetExpiration() <= now)
+        if (dst.sin6_family != AF_INET6 || IN6_IS_ADDR_UNSPECIFIED(&dst.sin6_addr))
         {
-            otbrLog(OTBR_LOG_INFO, "DTLS session timeout!");
-            HandleSessionState(*session, Session::kStateExpired);
-            delete session;
-            it = mSessions.erase(it);
+            otbrLog(OTBR_LOG_WARNING, "DTLS dropped datagram without destination address.");
+            continue;
         }
-        else if (session->GetState() == Session::kStateReady || session->GetState() == Session::kStateHandshaking)
-        {
-            int fd = session->GetFd();
 
-            otbrLog(OTBR_LOG_INFO, "DTLS session[%d] alive.", fd);
-            FD_SET(fd, &aReadFdSet);
+        dst.sin6_port = htons(mPort);
+        it            = mSessions.find(SessionKey(datagram.mPeerSock, dst));
 
-            if (aMaxFd < fd)
-            {
-                aMaxFd = fd;
-            }
+        if (it != mSessions.end())
+        {
+            session = it->second;
+        }
+        else
+        {
+            otbrLog(OTBR_LOG_INFO, "Trying to accept connection...");
+            session = new MbedtlsSession(*this, datagram.mPeerSock, dst);
 
-            if (static_cast<long>(session->GetExpiration() - (now + timeout)) < 0)
+            if (session->Init() != OTBR_ERROR_NONE)
             {
-                timeout = static_cast<unsigned long>(session->GetExpiration() - now);
+                delete session;
+                continue;
             }
 
-            // TODO error set
-            ++it;
-        }
-        else
-        {
-            delete session;
-            it = mSessions.erase(it);
+            mSessions[SessionKey(datagram.mPeerSock, dst)] = session;
+            AddTimer(*session);
         }
+
+        ProcessSession(*session, datagram.mPacket, datagram.mLength);
     }
 
-    if (mSocket >= 0)
+exit:
+    return;
+}
+
+void MbedtlsServer::Flush(void)
+{
+    mEventLoop.StopTimer(mFlushTimer);
+
+    if (mBatch.HasPending())
     {
-        FD_SET(mSocket, &aReadFdSet);
+        mBatch.Flush(mSocket);
+    }
+}
+
+void MbedtlsServer::HandleIo(void *aContext, int aFd, unsigned int aEvents)
+{
+    MbedtlsServer *server = static_cast<MbedtlsServer *>(aContext);
 
-        if (aMaxFd < mSocket)
+    (void)aFd;
+    (void)aEvents;
+
+    server->ProcessServer();
+    server->Flush();
+}
+
+void MbedtlsServer::HandleTimer(void *aContext)
+{
+    MbedtlsServer *server = static_cast<MbedtlsServer *>(aContext);
+
+    server->ProcessTimers();
+    server->Flush();
+}
+
+void MbedtlsServer::HandleFlushTimer(void *aContext)
+{
+    static_cast<MbedtlsServer *>(aContext)->Flush();
+}
+
+void MbedtlsServer::ProcessSession(MbedtlsSession &aSession, const uint8_t *aBuffer, uint16_t aLength)
+{
+    mProcessingSession = &aSession;
+    aSession.Process(aBuffer, aLength);
+    mProcessingSession = NULL;
+
+    // Processing may have moved the expiration or the retransmission timer.
+    UpdateTimer(aSession);
+}
+
+void MbedtlsServer::ProcessTimers(void)
+{
+    unsigned long now = GetNow();
+
+    // Every session is visited at most once, even if mbedtls leaves its timer due.
+    for (size_t count = mTimers.size(); count > 0 && !mTimers.empty(); --count)
+    {
+        MbedtlsSession &session = *mTimers[0];
+
+        if (static_cast<long>(session.mTimerDeadline - now) > 0)
+        {
+            break;
+        }
+
+        if (!session.IsAlive())
         {
-            aMaxFd = mSocket;
+            ReleaseSession(session);
+        }
+        else if (static_cast<long>(session.mExpiration - now) <= 0)
+        {
+            otbrLog(OTBR_LOG_INFO, "DTLS session timeout!");
+            HandleSessionState(session, Session::kStateExpired);
+            ReleaseSession(session);
+        }
+        else
+        {
+            ProcessSession(session, NULL, 0);
         }
     }
 
-    aTimeout.tv_sec  = timeout / 1000;
-    aTimeout.tv_usec = (timeout % 1000) * 1000;
+    ScheduleTimer();
+}
 
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
+void MbedtlsServer::ReleaseSession(MbedtlsSession &aSession)
+{
+    RemoveTimer(aSession);
+    mSessions.erase(SessionKey(aSession.mRemoteSock, aSession.mLocalSock));
+    delete &aSession;
 }
 
-void MbedtlsServer::HandleSessionState(Session &aSession, Session::State aState)
+void MbedtlsServer::AddTimer(MbedtlsSession &aSession)
 {
-    otbrLog(OTBR_LOG_INFO, "DTLS session state changed to %d.", aState);
-    if (mStateHandler)
+    assert(aSession.mTimerIndex == MbedtlsSession::kInvalidTimerIndex);
+
+    mTimers.push_back(&aSession);
+    aSession.mTimerIndex = mTimers.size() - 1;
+    UpdateTimer(aSession);
+}
+
+void MbedtlsServer::UpdateTimer(MbedtlsSession &aSession)
+{
+    VerifyOrExit(aSession.mTimerIndex != MbedtlsSession::kInvalidTimerIndex);
+
+    if (!aSession.IsAlive())
     {
-        mStateHandler(aSession, aState, mContext);
+        // Closed or failed sessions are released on the next timer processing.
+        aSession.mExpiration = GetNow();
     }
+
+    aSession.mTimerDeadline = aSession.GetDeadline();
+    SiftUp(aSession.mTimerIndex);
+    SiftDown(aSession.mTimerIndex);
+    ScheduleTimer();
+
+exit:
+    return;
 }
 
-void MbedtlsServer::ProcessServer(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void MbedtlsServer::RemoveTimer(MbedtlsSession &aSession)
 {
-    uint8_t       packet[kMaxSizeOfPacket];
-    uint8_t       control[kMaxSizeOfControl];
-    otbrError     error = OTBR_ERROR_ERRNO; // Assume error
-    sockaddr_in6  src;
-    sockaddr_in6  dst;
-    struct msghdr msghdr;
-    struct iovec  iov[1];
+    size_t          index = aSession.mTimerIndex;
+    MbedtlsSession *last;
 
-    /* Connection is not alive yet, or is shut down */
-    VerifyOrExit(mSocket >= 0, error = OTBR_ERROR_NONE);
-
-    /* If this is not set, then some other handle became rd/wr able, it is not an error */
-    VerifyOrExit(FD_ISSET(mSocket, &aReadFdSet), error = OTBR_ERROR_NONE);
-
-    otbrLog(OTBR_LOG_INFO, "Trying to accept connection...");
-    memset(&src, 0, sizeof(src));
-    memset(&dst, 0, sizeof(dst));
-    memset(&msghdr, 0, sizeof(msghdr));
-    msghdr.msg_name    = &src;
-    msghdr.msg_namelen = sizeof(src);
-    memset(&iov, 0, sizeof(iov));
-    iov[0].iov_base       = packet;
-    iov[0].iov_len        = kMaxSizeOfPacket;
-    msghdr.msg_iov        = iov;
-    msghdr.msg_iovlen     = 1;
-    msghdr.msg_control    = control;
-    msghdr.msg_controllen = sizeof(control);
-
-    VerifyOrExit(recvmsg(mSocket, &msghdr, MSG_PEEK) > 0);
-
-    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msghdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msghdr, cmsg))
-    {
-        if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
-        {
-            const struct in6_pktinfo *pktinfo = reinterpret_cast<const struct in6_pktinfo *>(CMSG_DATA(cmsg));
-            memcpy(dst.sin6_addr.s6_addr, pktinfo->ipi6_addr.s6_addr, sizeof(dst.sin6_addr));
-            dst.sin6_family = AF_INET6;
-            dst.sin6_port   = ntohs(mPort);
-            break;
-        }
-    }
+    VerifyOrExit(index != MbedtlsSession::kInvalidTimerIndex);
 
-    VerifyOrExit(memcmp(dst.sin6_addr.s6_addr, in6addr_any.s6_addr, sizeof(dst.sin6_addr)) != 0, errno = EDESTADDRREQ);
+    last = mTimers.back();
+    mTimers.pop_back();
+    aSession.mTimerIndex = MbedtlsSession::kInvalidTimerIndex;
 
-    // TODO Should check if this client has an existing session.
+    if (last != &aSession)
     {
-        mbedtls_net_context net = {mSocket};
+        SetTimer(index, last);
+        SiftUp(index);
+        SiftDown(last->mTimerIndex);
+    }
+
+    ScheduleTimer();
+
+exit:
+    return;
+}
 
-        MbedtlsSession *session = new MbedtlsSession(*this, net, src, dst);
+void MbedtlsServer::ScheduleTimer(void)
+{
+    unsigned long now;
+    long          delay;
 
-        VerifyOrExit(session->Init() == OTBR_ERROR_NONE, delete session);
+    VerifyOrExit(!mTimers.empty(), mEventLoop.StopTimer(mTimer));
 
-        mSessions.push_back(session);
-        mbedtls_ssl_conf_export_keys_cb(&mConf, MbedtlsSession::ExportKeys, session);
-        session->Process();
+    // Only the earliest session deadline is waited for, and the timer is moved only when it changes.
+    now   = GetNow();
+    delay = static_cast<long>(mTimers[0]->mTimerDeadline - now);
+    if (delay < 0)
+    {
+        delay = 0;
     }
 
-    error = OTBR_ERROR_NONE;
+    VerifyOrExit(!mTimer.IsRunning() || mTimer.GetFireTime() != now + static_cast<unsigned long>(delay));
+    mEventLoop.StartTimer(mTimer, static_cast<unsigned long>(delay));
 
 exit:
-    if (error)
+    return;
+}
+
+void MbedtlsServer::SetTimer(size_t aIndex, MbedtlsSession *aSession)
+{
+    mTimers[aIndex]       = aSession;
+    aSession->mTimerIndex = aIndex;
+}
+
+void MbedtlsServer::SiftUp(size_t aIndex)
+{
+    MbedtlsSession *session = mTimers[aIndex];
+
+    while (aIndex > 0)
     {
-        otbrLog(OTBR_LOG_ERR, "DTLS failed to initiate new session: %s.", otbrErrorString(error));
-        otbrLog(OTBR_LOG_INFO, "Trying to create new server socket...");
-        close(mSocket);
-        mSocket = -1;
+        size_t parent = (aIndex - 1) / 2;
 
-        if (Bind())
+        if (static_cast<long>(session->mTimerDeadline - mTimers[parent]->mTimerDeadline) >= 0)
         {
-            otbrLog(OTBR_LOG_ERR, "Unable create new server socket! Die now!");
-            abort();
+            break;
         }
+
+        SetTimer(aIndex, mTimers[parent]);
+        aIndex = parent;
     }
 
-    (void)aWriteFdSet;
-    (void)aErrorFdSet;
+    SetTimer(aIndex, session);
 }
 
-void MbedtlsServer::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+void MbedtlsServer::SiftDown(size_t aIndex)
 {
-    for (SessionSet::iterator it = mSessions.begin(); it != mSessions.end(); ++it)
+    MbedtlsSession *session = mTimers[aIndex];
+    size_t          size    = mTimers.size();
+
+    while (2 * aIndex + 1 < size)
     {
-        MbedtlsSession *session = *it;
-        int             fd      = session->GetFd();
+        size_t child = 2 * aIndex + 1;
 
-        if (FD_ISSET(fd, &aReadFdSet))
+        if (child + 1 < size &&
+            static_cast<long>(mTimers[child + 1]->mTimerDeadline - mTimers[child]->mTimerDeadline) < 0)
         {
-            otbrLog(OTBR_LOG_INFO, "DTLS session [%d] become readable.", fd);
-            session->Process();
+            ++child;
         }
-    }
 
-    ProcessServer(aReadFdSet, aWriteFdSet, aErrorFdSet);
+        if (static_cast<long>(mTimers[child]->mTimerDeadline - session->mTimerDeadline) >= 0)
+        {
+            break;
+        }
 
-    (void)aErrorFdSet;
+        SetTimer(aIndex, mTimers[child]);
+        aIndex = child;
+    }
+
+    SetTimer(aIndex, session);
 }
 
 otbrError MbedtlsServer::SetPSK(const uint8_t *aPSK, uint8_t aLength)
@@ -688,6 +824,12 @@ otbrError MbedtlsServer::SetPSK(const uint8_t *aPSK, uint8_t aLength)
 
     VerifyOrExit(aLength <= sizeof(mPSK), errno = EINVAL);
 
+    if (aLength != mPSKLength || memcmp(mPSK, aPSK, aLength) != 0)
+    {
+        // Sessions established with the former PSK must not be resumed.
+        mSessionCache.Clear();
+    }
+
     memcpy(mPSK, aPSK, aLength);
     mPSKLength = aLength;
     ret        = OTBR_ERROR_NONE;
@@ -698,21 +840,42 @@ exit:
 
 MbedtlsServer::~MbedtlsServer(void)
 {
-    SessionSet::iterator it = mSessions.begin();
+    // Sessions are destroyed without rescheduling.
+    for (TimerHeap::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
+    {
+        (*it)->mTimerIndex = MbedtlsSession::kInvalidTimerIndex;
+    }
+    mTimers.clear();
+
+    for (SessionMap::iterator it = mSessions.begin(); it != mSessions.end(); ++it)
+    {
+        delete it->second;
+    }
+    mSessions.clear();
+
+    // Closing sessions above may have scheduled a flush, which is done below.
+    mEventLoop.StopTimer(mTimer);
+    mEventLoop.StopTimer(mFlushTimer);
 
-    while (it != mSessions.end())
     {
-        MbedtlsSession *session = *it;
-        delete session;
-        it = mSessions.erase(it);
+        const SessionCache::Counters &counters = mSessionCache.GetCounters();
+
+        otbrLog(OTBR_LOG_INFO, "DTLS session cache: %lu hits, %lu misses, %lu stored, %lu evicted, %lu expired",
+                counters.mHits, counters.mMisses, counters.mStores, counters.mEvictions, counters.mExpirations);
     }
 
-    close(mSocket);
+    if (mSocket >= 0)
+    {
+        if (mBatch.HasPending())
+        {
+            mBatch.Flush(mSocket);
+        }
+
+        mEventLoop.RemoveIo(mSocket);
+        close(mSocket);
+    }
     mbedtls_ssl_config_free(&mConf);
     mbedtls_ssl_cookie_free(&mCookie);
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_free(&mCache);
-#endif
     mbedtls_ctr_drbg_free(&mCtrDrbg);
     mbedtls_entropy_free(&mEntropy);
 }
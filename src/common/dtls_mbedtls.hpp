@@ -34,6 +34,7 @@
 #ifndef DTLS_MBEDTLS_HPP_
 #define DTLS_MBEDTLS_HPP_
 
+#include <map>
 #include <vector>
 
 #include <netinet/in.h>
@@ -63,13 +64,11 @@ extern "C" {
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/timing.h>
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-#include <mbedtls/ssl_cache.h>
-#endif
-
 } // extern "C"
 
 #include "dtls.hpp"
+#include "dtls_session_cache.hpp"
+#include "udp_batch.hpp"
 
 namespace ot {
 
@@ -90,8 +89,7 @@ class MbedtlsServer;
 
 enum
 {
-    kMaxSizeOfPacket  = 1500, ///< Max size of packet in bytes.
-    kMaxSizeOfControl = 1500, ///< Max size of control message in bytes.
+    kMaxSizeOfPacket = 1500, ///< Max size of packet in bytes.
 };
 
 /**
@@ -107,15 +105,11 @@ public:
      * The constructor to initialize a DTLS session.
      *
      * @param[in]   aServer     A reference to the DTLS server.
-     * @param[in]   aNet        A reference to the mbedtls_net_context.
      * @param[in]   aRemoteSock A reference to the remote sockaddr of this session.
      * @param[in]   aLocalSock  A reference to the local sockaddr of this session.
      *
      */
-    MbedtlsSession(MbedtlsServer &            aServer,
-                   const mbedtls_net_context &aNet,
-                   const struct sockaddr_in6 &aRemoteSock,
-                   const struct sockaddr_in6 &aLocalSock);
+    MbedtlsSession(MbedtlsServer &aServer, const struct sockaddr_in6 &aRemoteSock, const struct sockaddr_in6 &aLocalSock);
 
     ~MbedtlsSession(void);
 
@@ -139,14 +133,6 @@ public:
      */
     State GetState(void) const { return mState; }
 
-    /**
-     * This method returns the underlying unix fd of this session.
-     *
-     * @returns Unix file descriptor.
-     *
-     */
-    int GetFd(void) const { return mNet.fd; }
-
     /**
      * This method returns the expiration of this session.
      *
@@ -162,11 +148,34 @@ public:
      */
     const uint8_t *GetKek(void) { return mKek; }
 
+    /**
+     * This method returns the time when this session should be processed next.
+     *
+     * @returns The earlier of the pending retransmission and the expiration in miniseconds.
+     *
+     */
+    unsigned long GetDeadline(void) const
+    {
+        return (mIsTimerSet && static_cast<long>(mFinal - mExpiration) < 0) ? mFinal : mExpiration;
+    }
+
+    /**
+     * This method indicates whether this session is still handshaking or connected.
+     *
+     * @retval  true    The session is alive.
+     * @retval  false   The session is closed or failed, and will be released by the server.
+     *
+     */
+    bool IsAlive(void) const { return mState == kStateHandshaking || mState == kStateReady; }
+
     /**
      * This method performs the session processing.
      *
+     * @param[in]   aBuffer     A pointer to the received datagram, NULL if processing timers only.
+     * @param[in]   aLength     Number of bytes of @p aBuffer.
+     *
      */
-    void Process(void);
+    void Process(const uint8_t *aBuffer, uint16_t aLength);
 
     /**
      * This method closes the DTLS session.
@@ -181,12 +190,8 @@ private:
         kKekSize        = 32,    ///< Size of KEK.
     };
 
-    static int ExportKeys(void *               aContext,
-                          const unsigned char *aMasterSecret,
-                          const unsigned char *aKeyBlock,
-                          size_t               aMacLength,
-                          size_t               aKeyLength,
-                          size_t               aIvLength);
+    static const size_t kInvalidTimerIndex = static_cast<size_t>(-1);
+
     int        Handshake(void);
     int        Read(void);
     void       SetState(State aState);
@@ -207,7 +212,6 @@ private:
     static int  GetDelay(void *aContext);
     int         GetDelay(void) const;
 
-    mbedtls_net_context mNet;
     mbedtls_ssl_context mSsl;
 
     DataHandler    mDataHandler;
@@ -221,6 +225,10 @@ private:
     unsigned long  mIntermediate;
     unsigned long  mFinal;
     bool           mIsTimerSet;
+    const uint8_t *mReceiveBuffer;
+    uint16_t       mReceiveLength;
+    unsigned long  mTimerDeadline;
+    size_t         mTimerIndex;
 };
 
 /**
@@ -235,16 +243,23 @@ public:
     /**
      * The constructor to initialize a DTLS server.
      *
+     * @param[in]   aEventLoop          A reference to the event loop driving this DTLS server.
      * @param[in]   aPort               The listening port of this DTLS server.
      * @param[in]   aStateHandler       A pointer to the function to be called when an session's state changed.
      * @param[in]   aContext            A pointer to application-specific context.
      *
      */
-    MbedtlsServer(uint16_t aPort, StateHandler aStateHandler, void *aContext)
-        : mSocket(-1)
+    MbedtlsServer(EventLoop &aEventLoop, uint16_t aPort, StateHandler aStateHandler, void *aContext)
+        : mEventLoop(aEventLoop)
+        , mTimer(HandleTimer, this)
+        , mFlushTimer(HandleFlushTimer, this)
+        , mProcessingSession(NULL)
+        , mSocket(-1)
         , mPort(aPort)
         , mStateHandler(aStateHandler)
         , mContext(aContext)
+        , mSeedLength(0)
+        , mPSKLength(0)
     {
     }
 
@@ -261,39 +276,32 @@ public:
     virtual otbrError Start(void);
 
     /**
-     * This method updates the fd_set and timeout for mainloop. @p aTimeout should
-     * only be updated if the DTLS service has pending process in less than its current value.
+     * This method updates the PSK of TLS_ECJPAKE_WITH_AES_128_CCM_8 used by this server.
      *
-     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
-     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
-     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
-     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
-     * @param[inout]    aTimeout        A reference to the timeout.
+     * @param[in]   aPSK                A pointer to the PSK buffer.
+     * @param[in]   aLength             The length of the PSK.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully set PSK.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the given PSK is too long.
      *
      */
-    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+    otbrError SetPSK(const uint8_t *aPSK, uint8_t aLength);
 
     /**
-     * This method performs the DTLS processing.
+     * This method returns the counters of batched datagram I/O of this server.
      *
-     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
-     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
-     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     * @returns A reference to the counters.
      *
      */
-    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    const UdpBatch::Counters &GetCounters(void) const { return mBatch.GetCounters(); }
 
     /**
-     * This method updates the PSK of TLS_ECJPAKE_WITH_AES_128_CCM_8 used by this server.
-     *
-     * @param[in]   aPSK                A pointer to the PSK buffer.
-     * @param[in]   aLength             The length of the PSK.
+     * This method returns the counters of the session resumption cache of this server.
      *
-     * @retval      OTBR_ERROR_NONE     Successfully set PSK.
-     * @retval      OTBR_ERROR_ERRNO    Failed for the given PSK is too long.
+     * @returns A reference to the counters.
      *
      */
-    otbrError SetPSK(const uint8_t *aPSK, uint8_t aLength);
+    const SessionCache::Counters &GetSessionCacheCounters(void) const { return mSessionCache.GetCounters(); }
 
     /**
      * This method updates the seed for random generator.
@@ -308,37 +316,87 @@ public:
     otbrError SetSeed(const uint8_t *aSeed, uint16_t aLength);
 
 private:
-    typedef std::vector<MbedtlsSession *> SessionSet;
+    /**
+     * This structure identifies a session by the remote address, remote port and local address.
+     *
+     */
+    struct SessionKey
+    {
+        SessionKey(const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock)
+        {
+            memset(this, 0, sizeof(*this));
+            mRemoteAddr = aRemoteSock.sin6_addr;
+            mRemotePort = aRemoteSock.sin6_port;
+            mLocalAddr  = aLocalSock.sin6_addr;
+        }
+
+        bool operator<(const SessionKey &aOther) const { return memcmp(this, &aOther, sizeof(*this)) < 0; }
+
+        struct in6_addr mRemoteAddr;
+        struct in6_addr mLocalAddr;
+        uint16_t        mRemotePort;
+    };
+
+    typedef std::map<SessionKey, MbedtlsSession *> SessionMap;
+    typedef std::vector<MbedtlsSession *>          TimerHeap;
     enum
     {
         kMaxSizeOfPSK = 32, ///< Max size of PSK in bytes.
     };
 
+    void AddTimer(MbedtlsSession &aSession);
+    void UpdateTimer(MbedtlsSession &aSession);
+    void RemoveTimer(MbedtlsSession &aSession);
+    void SetTimer(size_t aIndex, MbedtlsSession *aSession);
+    void SiftUp(size_t aIndex);
+    void SiftDown(size_t aIndex);
+    void ScheduleTimer(void);
+    void ProcessTimers(void);
+    void ProcessSession(MbedtlsSession &aSession, const uint8_t *aBuffer, uint16_t aLength);
+    void ReleaseSession(MbedtlsSession &aSession);
+
     void HandleSessionState(Session &aSession, Session::State aState);
-    void ProcessServer(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    void ProcessServer(void);
+    void Flush(void);
+    int  SendTo(const uint8_t *aBuffer, size_t aLength, const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock);
+
+    static void HandleIo(void *aContext, int aFd, unsigned int aEvents);
+    static void HandleTimer(void *aContext);
+    static void HandleFlushTimer(void *aContext);
+
+    static int ExportKeys(void *               aContext,
+                          const unsigned char *aMasterSecret,
+                          const unsigned char *aKeyBlock,
+                          size_t               aMacLength,
+                          size_t               aKeyLength,
+                          size_t               aIvLength);
 
     otbrError Bind(void);
 
     static void MbedtlsDebug(void *aContext, int aLevel, const char *aFile, int aLine, const char *aMessage);
     void        MbedtlsDebug(int aLevel, const char *aFile, int aLine, const char *aMessage);
 
-    SessionSet   mSessions;
-    int          mSocket;
-    uint16_t     mPort;
-    StateHandler mStateHandler;
-    void *       mContext;
-    uint8_t      mSeed[MBEDTLS_CTR_DRBG_MAX_SEED_INPUT];
-    uint16_t     mSeedLength;
-    uint8_t      mPSK[kMaxSizeOfPSK];
-    uint8_t      mPSKLength;
+    EventLoop &      mEventLoop;
+    EventLoop::Timer mTimer;      ///< Fires at the earliest session deadline.
+    EventLoop::Timer mFlushTimer; ///< Sends datagrams written by sessions out of processing.
+    SessionMap       mSessions;
+    TimerHeap        mTimers;
+    SessionCache     mSessionCache;
+    UdpBatch         mBatch;
+    MbedtlsSession * mProcessingSession;
+    int              mSocket;
+    uint16_t         mPort;
+    StateHandler     mStateHandler;
+    void *           mContext;
+    uint8_t          mSeed[MBEDTLS_CTR_DRBG_MAX_SEED_INPUT];
+    uint16_t         mSeedLength;
+    uint8_t          mPSK[kMaxSizeOfPSK];
+    uint8_t          mPSKLength;
 
     mbedtls_ssl_cookie_ctx   mCookie;
     mbedtls_entropy_context  mEntropy;
     mbedtls_ctr_drbg_context mCtrDrbg;
     mbedtls_ssl_config       mConf;
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_context mCache;
-#endif
 };
 
 /**
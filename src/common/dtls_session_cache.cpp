@@ -0,0 +1,196 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * This file implements the DTLS session resumption cache.
+ */
+
+#include "dtls_session_cache.hpp"
+
+#include <string.h>
+
+extern "C" {
+#include <mbedtls/platform_util.h>
+}
+
+#include "code_utils.hpp"
+#include "time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Dtls {
+
+SessionCache::SessionCache(size_t aCapacity, unsigned long aTimeout)
+    : mCapacity(aCapacity < kMaxCapacity ? aCapacity : static_cast<size_t>(kMaxCapacity))
+    , mTimeout(aTimeout)
+    , mUseCount(0)
+{
+    memset(mEntries, 0, sizeof(mEntries));
+    memset(&mCounters, 0, sizeof(mCounters));
+}
+
+SessionCache::~SessionCache(void)
+{
+    mbedtls_platform_zeroize(mEntries, sizeof(mEntries));
+}
+
+int SessionCache::Get(void *aContext, mbedtls_ssl_session *aSession)
+{
+    return static_cast<SessionCache *>(aContext)->Get(*aSession);
+}
+
+int SessionCache::Set(void *aContext, const mbedtls_ssl_session *aSession)
+{
+    return static_cast<SessionCache *>(aContext)->Set(*aSession);
+}
+
+SessionCache::Entry *SessionCache::Find(const unsigned char *aId, size_t aIdLength, unsigned long aNow)
+{
+    Entry *ret = NULL;
+
+    for (size_t i = 0; i < mCapacity; ++i)
+    {
+        Entry &entry = mEntries[i];
+
+        if (!entry.mValid)
+        {
+            continue;
+        }
+
+        if (static_cast<long>(aNow - entry.mExpiration) >= 0)
+        {
+            mbedtls_platform_zeroize(&entry, sizeof(entry));
+            ++mCounters.mExpirations;
+            continue;
+        }
+
+        if (entry.mIdLength == aIdLength && memcmp(entry.mId, aId, aIdLength) == 0)
+        {
+            ret = &entry;
+        }
+    }
+
+    return ret;
+}
+
+int SessionCache::Get(mbedtls_ssl_session &aSession)
+{
+    int    ret   = 1;
+    Entry *entry = Find(aSession.id, aSession.id_len, GetNow());
+
+    VerifyOrExit(entry != NULL && entry->mCiphersuite == aSession.ciphersuite &&
+                     entry->mCompression == aSession.compression,
+                 ++mCounters.mMisses);
+
+    memcpy(aSession.master, entry->mMaster, sizeof(aSession.master));
+    aSession.verify_result = entry->mVerifyResult;
+    entry->mLastUsed       = ++mUseCount;
+    ++mCounters.mHits;
+    ret = 0;
+
+exit:
+    return ret;
+}
+
+int SessionCache::Set(const mbedtls_ssl_session &aSession)
+{
+    int           ret   = 1;
+    unsigned long now   = GetNow();
+    Entry *       entry = NULL;
+
+    VerifyOrExit(aSession.id_len != 0 && aSession.id_len <= kSizeOfId && mCapacity > 0);
+
+    entry = Find(aSession.id, aSession.id_len, now);
+
+    if (entry == NULL)
+    {
+        // Take a free entry, or replace the least recently used one.
+        for (size_t i = 0; i < mCapacity; ++i)
+        {
+            if (!mEntries[i].mValid)
+            {
+                entry = &mEntries[i];
+                break;
+            }
+
+            if (entry == NULL || static_cast<long>(mEntries[i].mLastUsed - entry->mLastUsed) < 0)
+            {
+                entry = &mEntries[i];
+            }
+        }
+
+        if (entry->mValid)
+        {
+            ++mCounters.mEvictions;
+        }
+    }
+
+    entry->mCiphersuite  = aSession.ciphersuite;
+    entry->mCompression  = aSession.compression;
+    entry->mVerifyResult = aSession.verify_result;
+    entry->mIdLength     = aSession.id_len;
+    memcpy(entry->mId, aSession.id, aSession.id_len);
+    memcpy(entry->mMaster, aSession.master, sizeof(entry->mMaster));
+    entry->mExpiration = now + mTimeout;
+    entry->mLastUsed   = ++mUseCount;
+    entry->mValid      = true;
+    ++mCounters.mStores;
+    ret = 0;
+
+exit:
+    return ret;
+}
+
+void SessionCache::Clear(void)
+{
+    mCounters.mInvalidations += GetSize();
+    mbedtls_platform_zeroize(mEntries, sizeof(mEntries));
+}
+
+size_t SessionCache::GetSize(void) const
+{
+    size_t size = 0;
+
+    for (size_t i = 0; i < mCapacity; ++i)
+    {
+        if (mEntries[i].mValid)
+        {
+            ++size;
+        }
+    }
+
+    return size;
+}
+
+} // namespace Dtls
+
+} // namespace BorderRouter
+
+} // namespace ot
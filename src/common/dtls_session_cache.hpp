@@ -0,0 +1,193 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the DTLS session resumption cache.
+ */
+
+#ifndef DTLS_SESSION_CACHE_HPP_
+#define DTLS_SESSION_CACHE_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <mbedtls/ssl.h>
+
+} // extern "C"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Dtls {
+
+/**
+ * @addtogroup border-router-dtls
+ *
+ * @{
+ */
+
+/**
+ * This class implements a bounded session ID cache for DTLS session resumption.
+ *
+ * Entries expire after a fixed time to live, and the least recently used entry is replaced when the cache is full.
+ * Only the session ID, ciphersuite and master secret are kept, no memory is allocated.
+ *
+ */
+class SessionCache
+{
+public:
+    enum
+    {
+        kMaxCapacity     = 32,      ///< Max number of cached sessions.
+        kDefaultCapacity = 16,      ///< Default number of cached sessions.
+        kDefaultTimeout  = 3600000, ///< Default time to live of cached sessions in miniseconds.
+    };
+
+    /**
+     * This structure represents the counters of a session cache.
+     *
+     */
+    struct Counters
+    {
+        unsigned long mHits;          ///< Number of sessions resumed.
+        unsigned long mMisses;        ///< Number of lookups without a valid session.
+        unsigned long mStores;        ///< Number of sessions stored.
+        unsigned long mEvictions;     ///< Number of valid sessions replaced for lack of room.
+        unsigned long mExpirations;   ///< Number of sessions dropped after their time to live.
+        unsigned long mInvalidations; ///< Number of sessions dropped by Clear().
+    };
+
+    /**
+     * The constructor to initialize an empty session cache.
+     *
+     * @param[in]   aCapacity   The max number of cached sessions, up to kMaxCapacity.
+     * @param[in]   aTimeout    The time to live of cached sessions in miniseconds.
+     *
+     */
+    SessionCache(size_t aCapacity = kDefaultCapacity, unsigned long aTimeout = kDefaultTimeout);
+
+    ~SessionCache(void);
+
+    /**
+     * This function restores a session from the cache, it is the get callback of mbedtls_ssl_conf_session_cache().
+     *
+     * @param[in]       aContext    A pointer to the session cache.
+     * @param[inout]    aSession    A pointer to the session being negotiated.
+     *
+     * @retval  0   The session is restored.
+     * @retval  1   No valid session is cached for the session ID.
+     *
+     */
+    static int Get(void *aContext, mbedtls_ssl_session *aSession);
+
+    /**
+     * This function stores a session to the cache, it is the set callback of mbedtls_ssl_conf_session_cache().
+     *
+     * @param[in]   aContext    A pointer to the session cache.
+     * @param[in]   aSession    A pointer to the established session.
+     *
+     * @retval  0   The session is stored.
+     * @retval  1   The session has no ID.
+     *
+     */
+    static int Set(void *aContext, const mbedtls_ssl_session *aSession);
+
+    /**
+     * This method drops all cached sessions, and wipes their master secrets.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method returns the number of cached sessions, including expired ones not yet dropped.
+     *
+     * @returns The number of cached sessions.
+     *
+     */
+    size_t GetSize(void) const;
+
+    /**
+     * This method returns the counters of this cache.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    enum
+    {
+        kSizeOfId     = sizeof(mbedtls_ssl_session::id),
+        kSizeOfMaster = sizeof(mbedtls_ssl_session::master),
+    };
+
+    struct Entry
+    {
+        int           mCiphersuite;
+        int           mCompression;
+        uint32_t      mVerifyResult;
+        size_t        mIdLength;
+        unsigned char mId[kSizeOfId];
+        unsigned char mMaster[kSizeOfMaster];
+        unsigned long mExpiration;
+        unsigned long mLastUsed;
+        bool          mValid;
+    };
+
+    int    Get(mbedtls_ssl_session &aSession);
+    int    Set(const mbedtls_ssl_session &aSession);
+    Entry *Find(const unsigned char *aId, size_t aIdLength, unsigned long aNow);
+
+    Entry         mEntries[kMaxCapacity];
+    size_t        mCapacity;
+    unsigned long mTimeout;
+    unsigned long mUseCount;
+    Counters      mCounters;
+};
+
+/**
+ * @}
+ */
+
+} // namespace Dtls
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // DTLS_SESSION_CACHE_HPP_
@@ -25,69 +25,145 @@
  *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *    POSSIBILITY OF SUCH DAMAGE.
  */
-
 #ifndef EVENT_EMITTER_HPP_
 #define EVENT_EMITTER_HPP_
 
-#include <list>
-#include <map>
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
 
-#include <stdarg.h>
+#include "types.hpp"
 
 namespace ot {
 
 namespace BorderRouter {
 
 /**
- * This class implements the basic functionality of an event emitter.
+ * This class template implements the basic functionality of an event emitter.
+ *
+ * Each event id @p aEvent has its handler type declared as `Signature<aEvent>::Handler`, a function pointer taking
+ * the context followed by the event arguments. Handlers are kept in a fixed array indexed by event id, so emitting
+ * an event is a direct call to each handler without lookup, allocation or variadic arguments.
+ *
+ * @tparam  Signature       The class template mapping event ids to handler types.
+ * @tparam  kNumEvents      The number of event ids, which are from 0 to @p kNumEvents - 1.
+ * @tparam  kMaxHandlers    The maximum number of handlers of each event.
  *
  */
-class EventEmitter
+template <template <int> class Signature, int kNumEvents, int kMaxHandlers> class EventEmitter
 {
+public:
     /**
-     * This function pointer will be called when the @p aEvent is emitted.
-     *
-     * @param[in]   aContext    A pointer to application-specific context.
-     * @param[in]   aEvent      The emitted event id.
-     * @param[in]   aArguments  The arguments associated with this event.
+     * The constructor to initialize an event emitter without handlers.
      *
      */
-    typedef void (*Callback)(void *aContext, int aEvent, va_list aArguments);
+    EventEmitter(void)
+    {
+        for (int i = 0; i < kNumEvents; ++i)
+        {
+            mNumHandlers[i] = 0;
+        }
+    }
 
-public:
     /**
      * This method register an event handler for @p aEvent.
      *
-     * @param[in]   aEvent      The event id.
-     * @param[in]   aCallback   The function poiner to be called.
+     * @param[in]   aHandler    The function poiner to be called.
      * @param[in]   aContext    A pointer to application-specific context.
      *
+     * @retval  OTBR_ERROR_NONE     Successfully registered the handler.
+     * @retval  OTBR_ERROR_ERRNO    Too many handlers of @p aEvent, errno is set to ENOBUFS.
+     *
      */
-    void On(int aEvent, Callback aCallback, void *aContext);
+    template <int aEvent> otbrError On(typename Signature<aEvent>::Handler aHandler, void *aContext)
+    {
+        otbrError ret = OTBR_ERROR_NONE;
+        int &     num = mNumHandlers[Index<aEvent>()];
+
+        assert(aHandler);
+
+        if (num < kMaxHandlers)
+        {
+            mHandlers[aEvent][num].mCallback = reinterpret_cast<Callback>(aHandler);
+            mHandlers[aEvent][num].mContext  = aContext;
+            ++num;
+        }
+        else
+        {
+            errno = ENOBUFS;
+            ret   = OTBR_ERROR_ERRNO;
+        }
+
+        return ret;
+    }
 
     /**
      * This method deregister an event handler for @p aEvent.
      *
-     * @param[in]   aEvent      The event id.
-     * @param[in]   aCallback   The function poiner to be called.
+     * @param[in]   aHandler    The function poiner to be called.
      * @param[in]   aContext    A pointer to application-specific context.
      *
      */
-    void Off(int aEvent, Callback aCallback, void *aContext);
+    template <int aEvent> void Off(typename Signature<aEvent>::Handler aHandler, void *aContext)
+    {
+        Handler *handlers = mHandlers[Index<aEvent>()];
+        int &    num      = mNumHandlers[aEvent];
+
+        assert(aHandler);
+
+        for (int i = 0; i < num; ++i)
+        {
+            if (handlers[i].mCallback == reinterpret_cast<Callback>(aHandler) && handlers[i].mContext == aContext)
+            {
+                // Keep the registration order of the remaining handlers.
+                for (--num; i < num; ++i)
+                {
+                    handlers[i] = handlers[i + 1];
+                }
+
+                break;
+            }
+        }
+    }
 
     /**
      * This method emits an event.
      *
-     * @param[in]   aEvent      The event id.
+     * Handlers are called in the order they were registered, and must not register or deregister handlers of
+     * @p aEvent.
+     *
+     * @param[in]   aArguments  The arguments of the event, converted to the parameters of the handler type.
      *
      */
-    void Emit(int aEvent, ...);
+    template <int aEvent, typename... Arguments> void Emit(Arguments &&... aArguments) const
+    {
+        typedef typename Signature<aEvent>::Handler HandlerType;
+
+        const Handler *handlers = mHandlers[Index<aEvent>()];
+
+        for (int i = 0; i < mNumHandlers[aEvent]; ++i)
+        {
+            reinterpret_cast<HandlerType>(handlers[i].mCallback)(handlers[i].mContext, aArguments...);
+        }
+    }
 
 private:
-    typedef std::pair<Callback, void *> Handler;
-    typedef std::list<Handler>          Handlers;
-    typedef std::map<int, Handlers>     Events;
-    Events                              mEvents;
+    typedef void (*Callback)(void);
+
+    struct Handler
+    {
+        Callback mCallback;
+        void *   mContext;
+    };
+
+    template <int aEvent> static int Index(void)
+    {
+        static_assert(aEvent >= 0 && aEvent < kNumEvents, "event id out of range");
+        return aEvent;
+    }
+
+    Handler mHandlers[kNumEvents][kMaxHandlers];
+    int     mNumHandlers[kNumEvents];
 };
 
 } // namespace BorderRouter
@@ -0,0 +1,265 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the event loop of Thread border router.
+ */
+
+#include "common/event_loop.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/event_loop_epoll.hpp"
+#include "common/event_loop_select.hpp"
+#include "common/time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+EventLoop::EventLoop(void)
+    : mCurrentTick(GetTick(GetNow()))
+    , mTimerCount(0)
+    , mPending(NULL)
+{
+    memset(mWheel, 0, sizeof(mWheel));
+}
+
+void EventLoop::StartTimer(Timer &aTimer, unsigned long aDelay)
+{
+    Timer **head;
+
+    StopTimer(aTimer);
+
+    aTimer.mFireTime = GetNow() + aDelay;
+    aTimer.mRunning  = true;
+
+    head         = &mWheel[GetSlot(GetTick(aTimer.mFireTime))];
+    aTimer.mPrev = NULL;
+    aTimer.mNext = *head;
+    if (*head != NULL)
+    {
+        (*head)->mPrev = &aTimer;
+    }
+    *head = &aTimer;
+
+    ++mTimerCount;
+}
+
+void EventLoop::StopTimer(Timer &aTimer)
+{
+    VerifyOrExit(aTimer.mRunning);
+
+    if (aTimer.mPrev != NULL)
+    {
+        aTimer.mPrev->mNext = aTimer.mNext;
+    }
+    else if (mPending == &aTimer)
+    {
+        mPending = aTimer.mNext;
+    }
+    else
+    {
+        assert(mWheel[GetSlot(GetTick(aTimer.mFireTime))] == &aTimer);
+        mWheel[GetSlot(GetTick(aTimer.mFireTime))] = aTimer.mNext;
+    }
+
+    if (aTimer.mNext != NULL)
+    {
+        aTimer.mNext->mPrev = aTimer.mPrev;
+    }
+
+    aTimer.mNext    = NULL;
+    aTimer.mPrev    = NULL;
+    aTimer.mRunning = false;
+    --mTimerCount;
+
+exit:
+    return;
+}
+
+long EventLoop::GetTimerDelay(unsigned long aNow) const
+{
+    long delay = -1;
+
+    VerifyOrExit(mTimerCount > 0);
+
+    // Timers of the current round are found by walking the wheel in tick order.
+    for (unsigned long tick = mCurrentTick; tick < mCurrentTick + kWheelSlots; ++tick)
+    {
+        for (const Timer *timer = mWheel[GetSlot(tick)]; timer != NULL; timer = timer->mNext)
+        {
+            if (GetTick(timer->mFireTime) <= tick)
+            {
+                ExitNow(delay = timer->mFireTime > aNow ? static_cast<long>(timer->mFireTime - aNow) : 0);
+            }
+        }
+    }
+
+    // All timers are in later rounds.
+    for (size_t slot = 0; slot < kWheelSlots; ++slot)
+    {
+        for (const Timer *timer = mWheel[slot]; timer != NULL; timer = timer->mNext)
+        {
+            long timeout = timer->mFireTime > aNow ? static_cast<long>(timer->mFireTime - aNow) : 0;
+
+            if (delay == -1 || timeout < delay)
+            {
+                delay = timeout;
+            }
+        }
+    }
+
+exit:
+    return delay;
+}
+
+void EventLoop::ProcessTimers(unsigned long aNow)
+{
+    unsigned long nowTick = GetTick(aNow);
+    unsigned long ticks   = nowTick - mCurrentTick + 1;
+
+    VerifyOrExit(mTimerCount > 0, mCurrentTick = nowTick);
+
+    if (ticks > kWheelSlots)
+    {
+        ticks = kWheelSlots;
+    }
+
+    for (unsigned long tick = nowTick + 1 - ticks; tick <= nowTick; ++tick)
+    {
+        Timer **head = &mWheel[GetSlot(tick)];
+
+        // Detach the slot, so that timers restarted by handlers never fire in this round.
+        mPending = *head;
+        *head    = NULL;
+
+        while (mPending != NULL)
+        {
+            Timer *timer = mPending;
+
+            mPending = timer->mNext;
+            if (mPending != NULL)
+            {
+                mPending->mPrev = NULL;
+            }
+
+            if (timer->mFireTime <= aNow)
+            {
+                timer->mNext    = NULL;
+                timer->mRunning = false;
+                --mTimerCount;
+                timer->mHandler(timer->mContext);
+            }
+            else
+            {
+                timer->mNext = *head;
+                if (*head != NULL)
+                {
+                    (*head)->mPrev = timer;
+                }
+                *head = timer;
+            }
+        }
+    }
+
+    mCurrentTick = nowTick;
+
+exit:
+    return;
+}
+
+otbrError EventLoop::Poll(const timeval &aMaxTimeout)
+{
+    otbrError            error = OTBR_ERROR_NONE;
+    otSysMainloopContext mainloop;
+
+    mainloop.mMaxFd   = -1;
+    mainloop.mTimeout = aMaxTimeout;
+
+    FD_ZERO(&mainloop.mReadFdSet);
+    FD_ZERO(&mainloop.mWriteFdSet);
+    FD_ZERO(&mainloop.mErrorFdSet);
+
+    // All components see the same time in one pass, and read the clock only once.
+    UpdateNow();
+
+    for (std::vector<MainloopProcessor *>::iterator it = mProcessors.begin(); it != mProcessors.end(); ++it)
+    {
+        (*it)->UpdateFdSet(mainloop);
+    }
+
+    {
+        long timerDelay = GetTimerDelay(GetNow());
+
+        // Persistent registrations are dispatched while waiting, after an unknown time.
+        ClearNow();
+        SuccessOrExit(error = Wait(mainloop, timerDelay));
+    }
+
+    UpdateNow();
+    ProcessTimers(GetNow());
+
+    for (std::vector<MainloopProcessor *>::iterator it = mProcessors.begin(); it != mProcessors.end(); ++it)
+    {
+        (*it)->Process(mainloop);
+    }
+
+exit:
+    ClearNow();
+    return error;
+}
+
+EventLoop *EventLoop::Create(int aBackend)
+{
+    EventLoop *eventLoop = NULL;
+
+    switch (aBackend)
+    {
+    case kBackendDefault:
+#ifdef __linux__
+    case kBackendEpoll:
+        eventLoop = EventLoopEpoll::Create();
+        break;
+#endif
+    case kBackendSelect:
+        eventLoop = new EventLoopSelect();
+        break;
+    default:
+        break;
+    }
+
+    return eventLoop;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,337 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the event loop of Thread border router.
+ */
+
+#ifndef EVENT_LOOP_HPP_
+#define EVENT_LOOP_HPP_
+
+#if HAVE_CONFIG_H
+#include "otbr-config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include <vector>
+
+#if OTBR_ENABLE_NCP_WPANTUND
+#include "common/mainloop.h"
+#else
+#include <openthread-system.h>
+#endif
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * This interface represents a component driven by the select() style mainloop context.
+ *
+ * It is the compatibility path for components which rebuild their file descriptor sets on every iteration.
+ *
+ */
+class MainloopProcessor
+{
+public:
+    /**
+     * This method updates the file descriptor sets and timeout for mainloop.
+     *
+     * @param[inout]    aMainloop   A reference to OpenThread mainloop context.
+     *
+     */
+    virtual void UpdateFdSet(otSysMainloopContext &aMainloop) = 0;
+
+    /**
+     * This method performs processing.
+     *
+     * @param[in]       aMainloop   A reference to OpenThread mainloop context.
+     *
+     */
+    virtual void Process(const otSysMainloopContext &aMainloop) = 0;
+
+    virtual ~MainloopProcessor(void) {}
+};
+
+/**
+ * This class defines the event loop with persistent file descriptor registrations and timers.
+ *
+ */
+class EventLoop
+{
+public:
+    enum
+    {
+        kEventReadable = 1 << 0, ///< The file descriptor is readable.
+        kEventWritable = 1 << 1, ///< The file descriptor is writable.
+        kEventError    = 1 << 2, ///< The file descriptor has an error condition.
+    };
+
+    enum
+    {
+        kBackendDefault = 0, ///< The best backend available on this platform.
+        kBackendEpoll   = 1, ///< epoll() and timerfd based backend.
+        kBackendSelect  = 2, ///< select() based backend.
+    };
+
+    /**
+     * This function pointer is called when a registered file descriptor is ready.
+     *
+     * @param[in]   aContext    A pointer to application-specific context.
+     * @param[in]   aFd         The file descriptor.
+     * @param[in]   aEvents     The ready events, a bitwise or of kEvent*.
+     *
+     */
+    typedef void (*IoHandler)(void *aContext, int aFd, unsigned int aEvents);
+
+    /**
+     * This function pointer is called when a timer fires.
+     *
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    typedef void (*TimerHandler)(void *aContext);
+
+    /**
+     * This class represents a one-shot timer, which is owned by the caller.
+     *
+     */
+    class Timer
+    {
+    public:
+        /**
+         * The constructor to initialize a timer.
+         *
+         * @param[in]   aHandler    A pointer to the function to be called when this timer fires.
+         * @param[in]   aContext    A pointer to application-specific context.
+         *
+         */
+        Timer(TimerHandler aHandler, void *aContext)
+            : mNext(NULL)
+            , mPrev(NULL)
+            , mFireTime(0)
+            , mHandler(aHandler)
+            , mContext(aContext)
+            , mRunning(false)
+        {
+        }
+
+        /**
+         * This method indicates whether this timer is running.
+         *
+         * @retval  true    This timer is running.
+         * @retval  false   This timer is not running.
+         *
+         */
+        bool IsRunning(void) const { return mRunning; }
+
+        /**
+         * This method returns the fire time of this timer.
+         *
+         * @returns The fire time in milliseconds.
+         *
+         */
+        unsigned long GetFireTime(void) const { return mFireTime; }
+
+    private:
+        friend class EventLoop;
+
+        Timer *       mNext;
+        Timer *       mPrev;
+        unsigned long mFireTime;
+        TimerHandler  mHandler;
+        void *        mContext;
+        bool          mRunning;
+    };
+
+    /**
+     * This method adds a persistent registration of a file descriptor.
+     *
+     * @param[in]   aFd         The file descriptor.
+     * @param[in]   aEvents     The events to watch, a bitwise or of kEvent*.
+     * @param[in]   aHandler    A pointer to the function to be called when @p aFd is ready.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the file descriptor.
+     * @retval  OTBR_ERROR_ERRNO    Failed to add the file descriptor, error code is stored in errno.
+     *
+     */
+    virtual otbrError AddIo(int aFd, unsigned int aEvents, IoHandler aHandler, void *aContext) = 0;
+
+    /**
+     * This method changes the events watched on a registered file descriptor.
+     *
+     * @param[in]   aFd         The file descriptor.
+     * @param[in]   aEvents     The events to watch, a bitwise or of kEvent*.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully modified the file descriptor.
+     * @retval  OTBR_ERROR_ERRNO    Failed to modify the file descriptor, error code is stored in errno.
+     *
+     */
+    virtual otbrError ModifyIo(int aFd, unsigned int aEvents) = 0;
+
+    /**
+     * This method removes the registration of a file descriptor.
+     *
+     * @param[in]   aFd         The file descriptor.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully removed the file descriptor.
+     * @retval  OTBR_ERROR_ERRNO    Failed to remove the file descriptor, error code is stored in errno.
+     *
+     */
+    virtual otbrError RemoveIo(int aFd) = 0;
+
+    /**
+     * This method starts a timer, or restarts it if already running.
+     *
+     * @param[in]   aTimer      A reference to the timer.
+     * @param[in]   aDelay      The delay in milliseconds.
+     *
+     */
+    void StartTimer(Timer &aTimer, unsigned long aDelay);
+
+    /**
+     * This method stops a timer.
+     *
+     * @param[in]   aTimer      A reference to the timer.
+     *
+     */
+    void StopTimer(Timer &aTimer);
+
+    /**
+     * This method adds a component driven by the select() style mainloop context.
+     *
+     * @param[in]   aProcessor  A reference to the component.
+     *
+     */
+    void AddProcessor(MainloopProcessor &aProcessor) { mProcessors.push_back(&aProcessor); }
+
+    /**
+     * This method waits for events and dispatches them once.
+     *
+     * @param[in]   aMaxTimeout     The max time to wait.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully processed events.
+     * @retval  OTBR_ERROR_ERRNO    Failed to wait for events, error code is stored in errno.
+     *
+     */
+    otbrError Poll(const timeval &aMaxTimeout);
+
+    /**
+     * This method creates an event loop.
+     *
+     * @param[in]   aBackend    The backend to use, one of kBackend*.
+     *
+     * @returns A pointer to the new event loop, NULL if the backend is not available.
+     *
+     */
+    static EventLoop *Create(int aBackend = kBackendDefault);
+
+    /**
+     * This method destroys an event loop.
+     *
+     * @param[in]   aEventLoop  A pointer to the event loop to be destroyed.
+     *
+     */
+    static void Destroy(EventLoop *aEventLoop) { delete aEventLoop; }
+
+    virtual ~EventLoop(void) {}
+
+protected:
+    EventLoop(void);
+
+    /**
+     * This method waits for file descriptors and timers.
+     *
+     * On return, the file descriptor sets of @p aMainloop only contain the ready descriptors which were requested
+     * by processors. Persistent registrations are dispatched by this method.
+     *
+     * @param[inout]    aMainloop   A reference to the mainloop context, collected from processors.
+     * @param[in]       aTimerDelay The delay in milliseconds before the next timer fires, -1 if no timer.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully waited.
+     * @retval  OTBR_ERROR_ERRNO    Failed to wait, error code is stored in errno.
+     *
+     */
+    virtual otbrError Wait(otSysMainloopContext &aMainloop, long aTimerDelay) = 0;
+
+    struct IoEntry
+    {
+        IoHandler    mHandler;
+        void *       mContext;
+        unsigned int mEvents;
+    };
+
+    /**
+     * This method returns the persistent registration of a file descriptor.
+     *
+     * @param[in]   aFd     The file descriptor.
+     *
+     * @returns A pointer to the registration, NULL if not registered.
+     *
+     */
+    IoEntry *GetIo(int aFd)
+    {
+        return (aFd >= 0 && static_cast<size_t>(aFd) < mIoEntries.size() && mIoEntries[aFd].mHandler != NULL)
+                   ? &mIoEntries[aFd]
+                   : NULL;
+    }
+
+    std::vector<IoEntry> mIoEntries;
+
+private:
+    enum
+    {
+        kWheelSlots = 512, ///< Number of slots in the timer wheel, must be a power of two.
+        kWheelTick  = 1,   ///< Resolution of the timer wheel in milliseconds.
+    };
+
+    long GetTimerDelay(unsigned long aNow) const;
+    void ProcessTimers(unsigned long aNow);
+
+    static unsigned long GetTick(unsigned long aTime) { return aTime / kWheelTick; }
+    static size_t        GetSlot(unsigned long aTick) { return aTick & (kWheelSlots - 1); }
+
+    Timer *                          mWheel[kWheelSlots];
+    unsigned long                    mCurrentTick;
+    size_t                           mTimerCount;
+    Timer *                          mPending;
+    std::vector<MainloopProcessor *> mProcessors;
+};
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // EVENT_LOOP_HPP_
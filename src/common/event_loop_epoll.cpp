@@ -0,0 +1,356 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the epoll based event loop.
+ */
+
+#ifdef __linux__
+
+#include "common/event_loop_epoll.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+static uint32_t ToEpollEvents(unsigned int aEvents)
+{
+    uint32_t events = 0;
+
+    if (aEvents & EventLoop::kEventReadable)
+    {
+        events |= EPOLLIN;
+    }
+
+    if (aEvents & EventLoop::kEventWritable)
+    {
+        events |= EPOLLOUT;
+    }
+
+    if (aEvents & EventLoop::kEventError)
+    {
+        events |= EPOLLPRI;
+    }
+
+    return events;
+}
+
+EventLoopEpoll::EventLoopEpoll(void)
+    : mEpoll(-1)
+    , mTimerFd(-1)
+{
+}
+
+EventLoopEpoll::~EventLoopEpoll(void)
+{
+    if (mTimerFd != -1)
+    {
+        close(mTimerFd);
+    }
+
+    if (mEpoll != -1)
+    {
+        close(mEpoll);
+    }
+}
+
+EventLoopEpoll *EventLoopEpoll::Create(void)
+{
+    EventLoopEpoll *eventLoop = new EventLoopEpoll();
+
+    if (eventLoop->Init() != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to initialize epoll: %s", strerror(errno));
+        delete eventLoop;
+        eventLoop = NULL;
+    }
+
+    return eventLoop;
+}
+
+otbrError EventLoopEpoll::Init(void)
+{
+    otbrError          error = OTBR_ERROR_ERRNO;
+    struct epoll_event event;
+
+    VerifyOrExit((mEpoll = epoll_create1(EPOLL_CLOEXEC)) != -1);
+    VerifyOrExit((mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) != -1);
+
+    memset(&event, 0, sizeof(event));
+    event.events  = EPOLLIN;
+    event.data.fd = mTimerFd;
+    VerifyOrExit(epoll_ctl(mEpoll, EPOLL_CTL_ADD, mTimerFd, &event) == 0);
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+otbrError EventLoopEpoll::AddIo(int aFd, unsigned int aEvents, IoHandler aHandler, void *aContext)
+{
+    otbrError          error = OTBR_ERROR_NONE;
+    struct epoll_event event;
+
+    VerifyOrExit(aFd >= 0 && aHandler != NULL && GetIo(aFd) == NULL, error = OTBR_ERROR_ERRNO; errno = EINVAL);
+
+    memset(&event, 0, sizeof(event));
+    event.events  = ToEpollEvents(aEvents);
+    event.data.fd = aFd;
+
+    // A descriptor closed without RemoveIo() leaves epoll implicitly, but one still open must be replaced.
+    if (epoll_ctl(mEpoll, EPOLL_CTL_ADD, aFd, &event) != 0)
+    {
+        VerifyOrExit(errno == EEXIST && epoll_ctl(mEpoll, EPOLL_CTL_MOD, aFd, &event) == 0,
+                     error = OTBR_ERROR_ERRNO);
+    }
+
+    if (static_cast<size_t>(aFd) >= mIoEntries.size())
+    {
+        IoEntry empty = {NULL, NULL, 0};
+
+        mIoEntries.resize(aFd + 1, empty);
+    }
+
+    mIoEntries[aFd].mHandler = aHandler;
+    mIoEntries[aFd].mContext = aContext;
+    mIoEntries[aFd].mEvents  = aEvents;
+
+exit:
+    return error;
+}
+
+otbrError EventLoopEpoll::ModifyIo(int aFd, unsigned int aEvents)
+{
+    otbrError          error = OTBR_ERROR_NONE;
+    IoEntry *          entry = GetIo(aFd);
+    struct epoll_event event;
+
+    VerifyOrExit(entry != NULL, error = OTBR_ERROR_ERRNO; errno = ENOENT);
+    VerifyOrExit(entry->mEvents != aEvents);
+
+    memset(&event, 0, sizeof(event));
+    event.events  = ToEpollEvents(aEvents);
+    event.data.fd = aFd;
+
+    // The descriptor number may have been closed and reused since it was added.
+    if (epoll_ctl(mEpoll, EPOLL_CTL_MOD, aFd, &event) != 0)
+    {
+        VerifyOrExit(errno == ENOENT && epoll_ctl(mEpoll, EPOLL_CTL_ADD, aFd, &event) == 0,
+                     error = OTBR_ERROR_ERRNO);
+    }
+
+    entry->mEvents = aEvents;
+
+exit:
+    return error;
+}
+
+otbrError EventLoopEpoll::RemoveIo(int aFd)
+{
+    otbrError          error = OTBR_ERROR_NONE;
+    IoEntry *          entry = GetIo(aFd);
+    struct epoll_event event;
+
+    VerifyOrExit(entry != NULL, error = OTBR_ERROR_ERRNO; errno = ENOENT);
+
+    entry->mHandler = NULL;
+    entry->mContext = NULL;
+    entry->mEvents  = 0;
+
+    // The descriptor may have been closed already, which removes it from epoll implicitly.
+    memset(&event, 0, sizeof(event));
+    epoll_ctl(mEpoll, EPOLL_CTL_DEL, aFd, &event);
+
+exit:
+    return error;
+}
+
+void EventLoopEpoll::CollectMainloop(const otSysMainloopContext &aMainloop)
+{
+    struct pollfd pollFd;
+
+    mPollFds.clear();
+
+    for (int fd = 0; fd <= aMainloop.mMaxFd; ++fd)
+    {
+        pollFd.fd      = fd;
+        pollFd.events  = 0;
+        pollFd.revents = 0;
+
+        pollFd.events |= (FD_ISSET(fd, &aMainloop.mReadFdSet) ? POLLIN : 0);
+        pollFd.events |= (FD_ISSET(fd, &aMainloop.mWriteFdSet) ? POLLOUT : 0);
+        pollFd.events |= (FD_ISSET(fd, &aMainloop.mErrorFdSet) ? POLLPRI : 0);
+
+        if (pollFd.events != 0)
+        {
+            mPollFds.push_back(pollFd);
+        }
+    }
+
+    // The epoll descriptor is readable when any persistent registration or the timer is ready.
+    pollFd.fd      = mEpoll;
+    pollFd.events  = POLLIN;
+    pollFd.revents = 0;
+    mPollFds.push_back(pollFd);
+}
+
+otbrError EventLoopEpoll::ArmTimer(long aTimerDelay)
+{
+    otbrError         error = OTBR_ERROR_NONE;
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+
+    if (aTimerDelay == 0)
+    {
+        // A zero it_value disarms the timer, so fire as soon as possible instead.
+        spec.it_value.tv_nsec = 1;
+    }
+    else if (aTimerDelay > 0)
+    {
+        spec.it_value.tv_sec  = aTimerDelay / 1000;
+        spec.it_value.tv_nsec = (aTimerDelay % 1000) * 1000000;
+    }
+
+    VerifyOrExit(timerfd_settime(mTimerFd, 0, &spec, NULL) == 0, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+otbrError EventLoopEpoll::Wait(otSysMainloopContext &aMainloop, long aTimerDelay)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    int       count = 0;
+    int       timeout;
+
+    // Round up, so that the loop never wakes before the deadline and spins.
+    timeout = static_cast<int>(aMainloop.mTimeout.tv_sec * 1000 + (aMainloop.mTimeout.tv_usec + 999) / 1000);
+
+    SuccessOrExit(error = ArmTimer(aTimerDelay));
+
+    if (aMainloop.mMaxFd < 0)
+    {
+        // Nothing is requested through the mainloop context, which is left empty.
+        count = epoll_wait(mEpoll, mEvents, kMaxEvents, timeout);
+    }
+    else
+    {
+        CollectMainloop(aMainloop);
+
+        FD_ZERO(&aMainloop.mReadFdSet);
+        FD_ZERO(&aMainloop.mWriteFdSet);
+        FD_ZERO(&aMainloop.mErrorFdSet);
+
+        if (mPollFds.size() == 1)
+        {
+            count = epoll_wait(mEpoll, mEvents, kMaxEvents, timeout);
+        }
+        else if ((count = poll(&mPollFds[0], mPollFds.size(), timeout)) > 0)
+        {
+            for (std::vector<struct pollfd>::const_iterator it = mPollFds.begin(); it + 1 != mPollFds.end(); ++it)
+            {
+                // Hang-ups and errors are reported as readable, as select() does.
+                if (it->revents & (POLLIN | POLLHUP | POLLERR))
+                {
+                    FD_SET(it->fd, &aMainloop.mReadFdSet);
+                }
+
+                if (it->revents & (POLLOUT | POLLERR))
+                {
+                    FD_SET(it->fd, &aMainloop.mWriteFdSet);
+                }
+
+                if (it->revents & POLLPRI)
+                {
+                    FD_SET(it->fd, &aMainloop.mErrorFdSet);
+                }
+            }
+
+            count = (mPollFds.back().revents ? epoll_wait(mEpoll, mEvents, kMaxEvents, 0) : 0);
+        }
+    }
+
+    if (count < 0)
+    {
+        VerifyOrExit(errno == EINTR, error = OTBR_ERROR_ERRNO);
+        ExitNow();
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        int          fd     = mEvents[i].data.fd;
+        uint32_t     events = mEvents[i].events;
+        unsigned int ready  = 0;
+        IoEntry *    entry  = NULL;
+
+        if (fd == mTimerFd)
+        {
+            uint64_t expirations;
+
+            // Timers are processed by the caller after waiting.
+            if (read(mTimerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+            {
+                ExitNow(error = OTBR_ERROR_ERRNO);
+            }
+            continue;
+        }
+
+        ready |= (events & (EPOLLIN | EPOLLHUP) ? kEventReadable : 0);
+        ready |= (events & EPOLLOUT ? kEventWritable : 0);
+        ready |= (events & (EPOLLPRI | EPOLLERR) ? kEventError : 0);
+
+        // The handler of a previous event may have removed this registration.
+        entry = GetIo(fd);
+
+        if (entry != NULL && (ready & (entry->mEvents | kEventError)))
+        {
+            entry->mHandler(entry->mContext, fd, ready & (entry->mEvents | kEventError));
+        }
+    }
+
+exit:
+    return error;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // __linux__
@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the epoll based event loop.
+ */
+
+#ifndef EVENT_LOOP_EPOLL_HPP_
+#define EVENT_LOOP_EPOLL_HPP_
+
+#ifdef __linux__
+
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include <vector>
+
+#include "common/event_loop.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * This class implements the event loop based on epoll and timerfd.
+ *
+ * Persistent registrations and the timer stay in the epoll set, so they cost nothing on each iteration. File
+ * descriptors requested by processors through the select() style mainloop context are waited by poll() together
+ * with the epoll descriptor, as they are rebuilt on each iteration anyway.
+ *
+ */
+class EventLoopEpoll : public EventLoop
+{
+public:
+    virtual otbrError AddIo(int aFd, unsigned int aEvents, IoHandler aHandler, void *aContext);
+    virtual otbrError ModifyIo(int aFd, unsigned int aEvents);
+    virtual otbrError RemoveIo(int aFd);
+
+    /**
+     * This method creates an epoll based event loop.
+     *
+     * @returns A pointer to the new event loop, NULL on failure.
+     *
+     */
+    static EventLoopEpoll *Create(void);
+
+    virtual ~EventLoopEpoll(void);
+
+protected:
+    virtual otbrError Wait(otSysMainloopContext &aMainloop, long aTimerDelay);
+
+private:
+    enum
+    {
+        kMaxEvents = 64, ///< Max events retrieved by one epoll_wait().
+    };
+
+    EventLoopEpoll(void);
+
+    otbrError Init(void);
+    void      CollectMainloop(const otSysMainloopContext &aMainloop);
+    otbrError ArmTimer(long aTimerDelay);
+
+    int                        mEpoll;
+    int                        mTimerFd;
+    std::vector<struct pollfd> mPollFds; ///< Descriptors of the mainloop context, then the epoll descriptor.
+    struct epoll_event         mEvents[kMaxEvents];
+};
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // __linux__
+
+#endif // EVENT_LOOP_EPOLL_HPP_
@@ -0,0 +1,196 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the select() based event loop.
+ */
+
+#include "common/event_loop_select.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+otbrError EventLoopSelect::AddIo(int aFd, unsigned int aEvents, IoHandler aHandler, void *aContext)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(aFd >= 0 && aFd < FD_SETSIZE && aHandler != NULL && GetIo(aFd) == NULL,
+                 error = OTBR_ERROR_ERRNO;
+                 errno = EINVAL);
+
+    if (static_cast<size_t>(aFd) >= mIoEntries.size())
+    {
+        IoEntry empty = {NULL, NULL, 0};
+
+        mIoEntries.resize(aFd + 1, empty);
+    }
+
+    mIoEntries[aFd].mHandler = aHandler;
+    mIoEntries[aFd].mContext = aContext;
+    mIoEntries[aFd].mEvents  = aEvents;
+
+    if (aFd > mMaxFd)
+    {
+        mMaxFd = aFd;
+    }
+
+exit:
+    return error;
+}
+
+otbrError EventLoopSelect::ModifyIo(int aFd, unsigned int aEvents)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    IoEntry * entry = GetIo(aFd);
+
+    VerifyOrExit(entry != NULL, error = OTBR_ERROR_ERRNO; errno = ENOENT);
+    entry->mEvents = aEvents;
+
+exit:
+    return error;
+}
+
+otbrError EventLoopSelect::RemoveIo(int aFd)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    IoEntry * entry = GetIo(aFd);
+
+    VerifyOrExit(entry != NULL, error = OTBR_ERROR_ERRNO; errno = ENOENT);
+
+    entry->mHandler = NULL;
+    entry->mContext = NULL;
+    entry->mEvents  = 0;
+
+    while (mMaxFd >= 0 && GetIo(mMaxFd) == NULL)
+    {
+        --mMaxFd;
+    }
+
+exit:
+    return error;
+}
+
+otbrError EventLoopSelect::Wait(otSysMainloopContext &aMainloop, long aTimerDelay)
+{
+    otbrError      error = OTBR_ERROR_NONE;
+    fd_set         readFdSet(aMainloop.mReadFdSet);
+    fd_set         writeFdSet(aMainloop.mWriteFdSet);
+    fd_set         errorFdSet(aMainloop.mErrorFdSet);
+    int            maxFd = (aMainloop.mMaxFd > mMaxFd ? aMainloop.mMaxFd : mMaxFd);
+    struct timeval timeout(aMainloop.mTimeout);
+    int            rval;
+
+    for (int fd = 0; fd <= mMaxFd; ++fd)
+    {
+        IoEntry *entry = GetIo(fd);
+
+        if (entry == NULL)
+        {
+            continue;
+        }
+
+        if (entry->mEvents & kEventReadable)
+        {
+            FD_SET(fd, &readFdSet);
+        }
+
+        if (entry->mEvents & kEventWritable)
+        {
+            FD_SET(fd, &writeFdSet);
+        }
+
+        FD_SET(fd, &errorFdSet);
+    }
+
+    if (aTimerDelay >= 0 && aTimerDelay < timeout.tv_sec * 1000 + timeout.tv_usec / 1000)
+    {
+        timeout.tv_sec  = aTimerDelay / 1000;
+        timeout.tv_usec = (aTimerDelay % 1000) * 1000;
+    }
+
+    rval = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout);
+
+    if (rval < 0)
+    {
+        FD_ZERO(&aMainloop.mReadFdSet);
+        FD_ZERO(&aMainloop.mWriteFdSet);
+        FD_ZERO(&aMainloop.mErrorFdSet);
+        VerifyOrExit(errno == EINTR, error = OTBR_ERROR_ERRNO);
+        ExitNow();
+    }
+
+    for (int fd = 0; fd <= maxFd; ++fd)
+    {
+        unsigned int ready = 0;
+        IoEntry *    entry = NULL;
+
+        ready |= (FD_ISSET(fd, &readFdSet) ? kEventReadable : 0);
+        ready |= (FD_ISSET(fd, &writeFdSet) ? kEventWritable : 0);
+        ready |= (FD_ISSET(fd, &errorFdSet) ? kEventError : 0);
+
+        // Only report descriptors which were requested through the mainloop context.
+        if (fd <= aMainloop.mMaxFd)
+        {
+            if (!(ready & kEventReadable))
+            {
+                FD_CLR(fd, &aMainloop.mReadFdSet);
+            }
+
+            if (!(ready & kEventWritable))
+            {
+                FD_CLR(fd, &aMainloop.mWriteFdSet);
+            }
+
+            if (!(ready & kEventError))
+            {
+                FD_CLR(fd, &aMainloop.mErrorFdSet);
+            }
+        }
+
+        entry = GetIo(fd);
+
+        if (entry != NULL && (ready & (entry->mEvents | kEventError)))
+        {
+            entry->mHandler(entry->mContext, fd, ready & (entry->mEvents | kEventError));
+        }
+    }
+
+exit:
+    return error;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
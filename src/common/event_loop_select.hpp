@@ -1,5 +1,5 @@
 /*
- *    Copyright (c) 2017, The OpenThread Authors.
+ *    Copyright (c) 2018, The OpenThread Authors.
  *    All rights reserved.
  *
  *    Redistribution and use in source and binary forms, with or without
@@ -26,31 +26,47 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef LIBCOAP_H_
-#define LIBCOAP_H_
+/**
+ * @file
+ *   This file includes definitions for the select() based event loop.
+ */
+
+#ifndef EVENT_LOOP_SELECT_HPP_
+#define EVENT_LOOP_SELECT_HPP_
 
-/// @cond
+#include "common/event_loop.hpp"
 
-#define WITH_POSIX 1
-#include "coap_config.h"
-#include <coap/coap.h>
+namespace ot {
 
-#define MAX_COAP_PACKET 1280
+namespace BorderRouter {
 
-typedef struct coap_packet_t
+/**
+ * This class implements the event loop based on select().
+ *
+ * This backend is portable, but limited to FD_SETSIZE file descriptors.
+ *
+ */
+class EventLoopSelect : public EventLoop
 {
-    coap_if_handle_t       hnd; /**< the interface handle */
-    coap_address_t         src; /**< the packet's source address */
-    coap_address_t         dst; /**< the packet's destination address */
-    const coap_endpoint_t *interface;
+public:
+    EventLoopSelect(void)
+        : mMaxFd(-1)
+    {
+    }
+
+    virtual otbrError AddIo(int aFd, unsigned int aEvents, IoHandler aHandler, void *aContext);
+    virtual otbrError ModifyIo(int aFd, unsigned int aEvents);
+    virtual otbrError RemoveIo(int aFd);
+
+protected:
+    virtual otbrError Wait(otSysMainloopContext &aMainloop, long aTimerDelay);
 
-    int   ifindex;
-    void *session; /**< opaque session data */
+private:
+    int mMaxFd;
+};
 
-    size_t        length;                   /**< length of payload */
-    unsigned char payload[MAX_COAP_PACKET]; /**< payload */
-} coap_packet_t;
+} // namespace BorderRouter
 
-/// @endcond
+} // namespace ot
 
-#endif
+#endif // EVENT_LOOP_SELECT_HPP_
@@ -0,0 +1,952 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * This file implements structured log records.
+ */
+
+#include "log_record.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Log {
+
+namespace {
+
+enum
+{
+    kLengthNone,
+    kLengthChar,
+    kLengthShort,
+    kLengthLong,
+    kLengthLongLong,
+    kLengthIntMax,
+    kLengthSize,
+    kLengthPtrDiff,
+    kLengthLongDouble,
+};
+
+enum
+{
+    kMaxSpecLength = 32, ///< Max length of a conversion specification.
+    kMaxStars      = 2,  ///< Max number of '*' in a conversion specification.
+};
+
+const char kHexChars[]     = "0123456789abcdef";
+const char kBinaryMagic[8] = {'O', 'T', 'B', 'R', 'L', 'O', 'G', '1'};
+
+/**
+ * This structure represents a parsed printf conversion specification.
+ *
+ */
+struct Spec
+{
+    const char *mBegin;         ///< The '%'.
+    const char *mEnd;           ///< Past the conversion character.
+    const char *mLengthBegin;   ///< The length modifier.
+    int         mStars;         ///< Number of '*' for width and precision.
+    int         mPrecision;     ///< The literal precision, -1 if none.
+    bool        mStarPrecision; ///< Whether precision is given as '*'.
+    int         mLength;        ///< The length modifier, one of kLength*.
+    char        mConversion;    ///< The conversion character, 0 if the specification is incomplete.
+};
+
+/**
+ * This function parses a conversion specification starting at '%'.
+ *
+ */
+const char *ParseSpec(const char *aFormat, Spec &aSpec)
+{
+    const char *p = aFormat + 1;
+
+    aSpec.mBegin         = aFormat;
+    aSpec.mStars         = 0;
+    aSpec.mPrecision     = -1;
+    aSpec.mStarPrecision = false;
+    aSpec.mLength        = kLengthNone;
+
+    while (*p != '\0' && strchr("-+ #0'", *p) != NULL)
+    {
+        ++p;
+    }
+
+    if (*p == '*')
+    {
+        ++aSpec.mStars;
+        ++p;
+    }
+    else
+    {
+        while (*p >= '0' && *p <= '9')
+        {
+            ++p;
+        }
+    }
+
+    if (*p == '.')
+    {
+        ++p;
+
+        if (*p == '*')
+        {
+            ++aSpec.mStars;
+            aSpec.mStarPrecision = true;
+            ++p;
+        }
+        else
+        {
+            aSpec.mPrecision = 0;
+
+            while (*p >= '0' && *p <= '9')
+            {
+                aSpec.mPrecision = aSpec.mPrecision * 10 + (*p - '0');
+                ++p;
+            }
+        }
+    }
+
+    aSpec.mLengthBegin = p;
+
+    switch (*p)
+    {
+    case 'h':
+        ++p;
+        aSpec.mLength = (*p == 'h' ? (++p, kLengthChar) : kLengthShort);
+        break;
+    case 'l':
+        ++p;
+        aSpec.mLength = (*p == 'l' ? (++p, kLengthLongLong) : kLengthLong);
+        break;
+    case 'q':
+        ++p;
+        aSpec.mLength = kLengthLongLong;
+        break;
+    case 'j':
+        ++p;
+        aSpec.mLength = kLengthIntMax;
+        break;
+    case 'z':
+        ++p;
+        aSpec.mLength = kLengthSize;
+        break;
+    case 't':
+        ++p;
+        aSpec.mLength = kLengthPtrDiff;
+        break;
+    case 'L':
+        ++p;
+        aSpec.mLength = kLengthLongDouble;
+        break;
+    default:
+        break;
+    }
+
+    aSpec.mConversion = *p;
+    aSpec.mEnd        = (*p != '\0' ? p + 1 : p);
+
+    return aSpec.mEnd;
+}
+
+/**
+ * This class appends values to a buffer, and drops values which do not fit.
+ *
+ */
+class Encoder
+{
+public:
+    Encoder(uint8_t *aBuffer, uint16_t aSize)
+        : mBuffer(aBuffer)
+        , mSize(aSize)
+        , mLength(0)
+        , mIsFull(false)
+    {
+    }
+
+    void PutValue(const void *aValue, size_t aLength)
+    {
+        if (!mIsFull && aLength <= mSize - mLength)
+        {
+            memcpy(mBuffer + mLength, aValue, aLength);
+            mLength += aLength;
+        }
+        else
+        {
+            mIsFull = true;
+        }
+    }
+
+    void PutInteger(int64_t aValue) { PutValue(&aValue, sizeof(aValue)); }
+
+    void PutString(const char *aString, size_t aLength)
+    {
+        uint16_t length;
+
+        VerifyOrExit(!mIsFull && mSize - mLength >= sizeof(length), mIsFull = true);
+
+        // Long strings are truncated to the space left.
+        length = static_cast<uint16_t>(std::min(aLength, mSize - mLength - sizeof(length)));
+        PutValue(&length, sizeof(length));
+        PutValue(aString, length);
+
+    exit:
+        return;
+    }
+
+    bool     IsFull(void) const { return mIsFull; }
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mLength); }
+
+private:
+    uint8_t *mBuffer;
+    size_t   mSize;
+    size_t   mLength;
+    bool     mIsFull;
+};
+
+/**
+ * This class reads values appended by Encoder.
+ *
+ */
+class Decoder
+{
+public:
+    Decoder(const uint8_t *aBuffer, uint16_t aLength)
+        : mBuffer(aBuffer)
+        , mLength(aLength)
+        , mOffset(0)
+    {
+    }
+
+    bool GetValue(void *aValue, size_t aLength)
+    {
+        bool ret = (aLength <= mLength - mOffset);
+
+        if (ret)
+        {
+            memcpy(aValue, mBuffer + mOffset, aLength);
+            mOffset += aLength;
+        }
+
+        return ret;
+    }
+
+    bool GetInteger(int64_t &aValue) { return GetValue(&aValue, sizeof(aValue)); }
+
+    bool GetString(const char *&aString, uint16_t &aLength)
+    {
+        bool ret = GetValue(&aLength, sizeof(aLength)) && aLength <= mLength - mOffset;
+
+        if (ret)
+        {
+            aString = reinterpret_cast<const char *>(mBuffer + mOffset);
+            mOffset += aLength;
+        }
+
+        return ret;
+    }
+
+    const uint8_t *GetRemaining(uint16_t &aLength) const
+    {
+        aLength = static_cast<uint16_t>(mLength - mOffset);
+        return mBuffer + mOffset;
+    }
+
+private:
+    const uint8_t *mBuffer;
+    size_t         mLength;
+    size_t         mOffset;
+};
+
+/**
+ * This class appends text to a buffer, truncating at its end.
+ *
+ */
+class Output
+{
+public:
+    Output(char *aBuffer, size_t aSize)
+        : mBuffer(aBuffer)
+        , mSize(aSize)
+        , mLength(0)
+    {
+        if (mSize > 0)
+        {
+            mBuffer[0] = '\0';
+        }
+    }
+
+    void Append(const char *aText, size_t aLength)
+    {
+        size_t length = (aLength < GetAvailable() ? aLength : GetAvailable());
+
+        memcpy(mBuffer + mLength, aText, length);
+        mLength += length;
+        Terminate();
+    }
+
+    template <typename Type> void Print(const char *aSpec, const int *aStars, int aNumStars, Type aValue)
+    {
+        int rval;
+
+        VerifyOrExit(GetAvailable() > 0);
+
+        switch (aNumStars)
+        {
+        case 0:
+            rval = snprintf(mBuffer + mLength, mSize - mLength, aSpec, aValue);
+            break;
+        case 1:
+            rval = snprintf(mBuffer + mLength, mSize - mLength, aSpec, aStars[0], aValue);
+            break;
+        default:
+            rval = snprintf(mBuffer + mLength, mSize - mLength, aSpec, aStars[0], aStars[1], aValue);
+            break;
+        }
+
+        if (rval > 0)
+        {
+            mLength += (static_cast<size_t>(rval) < GetAvailable() ? static_cast<size_t>(rval) : GetAvailable());
+        }
+
+    exit:
+        return;
+    }
+
+    size_t GetLength(void) const { return mLength; }
+
+private:
+    size_t GetAvailable(void) const { return mSize > mLength + 1 ? mSize - mLength - 1 : 0; }
+    void   Terminate(void)
+    {
+        if (mSize > 0)
+        {
+            mBuffer[mLength] = '\0';
+        }
+    }
+
+    char * mBuffer;
+    size_t mSize;
+    size_t mLength;
+};
+
+bool IsSigned(char aConversion)
+{
+    return aConversion == 'd' || aConversion == 'i';
+}
+
+bool IsUnsigned(char aConversion)
+{
+    return aConversion == 'u' || aConversion == 'o' || aConversion == 'x' || aConversion == 'X';
+}
+
+bool IsFloat(char aConversion)
+{
+    return strchr("fFeEgGaA", aConversion) != NULL;
+}
+
+int64_t GetSigned(int aLength, va_list &aArguments)
+{
+    int64_t value;
+
+    switch (aLength)
+    {
+    case kLengthChar:
+        value = static_cast<signed char>(va_arg(aArguments, int));
+        break;
+    case kLengthShort:
+        value = static_cast<short>(va_arg(aArguments, int));
+        break;
+    case kLengthLong:
+        value = va_arg(aArguments, long);
+        break;
+    case kLengthLongLong:
+        value = va_arg(aArguments, long long);
+        break;
+    case kLengthIntMax:
+        value = va_arg(aArguments, intmax_t);
+        break;
+    case kLengthSize:
+        value = static_cast<int64_t>(va_arg(aArguments, size_t));
+        break;
+    case kLengthPtrDiff:
+        value = va_arg(aArguments, ptrdiff_t);
+        break;
+    default:
+        value = va_arg(aArguments, int);
+        break;
+    }
+
+    return value;
+}
+
+uint64_t GetUnsigned(int aLength, va_list &aArguments)
+{
+    uint64_t value;
+
+    switch (aLength)
+    {
+    case kLengthChar:
+        value = static_cast<unsigned char>(va_arg(aArguments, unsigned int));
+        break;
+    case kLengthShort:
+        value = static_cast<unsigned short>(va_arg(aArguments, unsigned int));
+        break;
+    case kLengthLong:
+        value = va_arg(aArguments, unsigned long);
+        break;
+    case kLengthLongLong:
+        value = va_arg(aArguments, unsigned long long);
+        break;
+    case kLengthIntMax:
+        value = va_arg(aArguments, uintmax_t);
+        break;
+    case kLengthSize:
+        value = va_arg(aArguments, size_t);
+        break;
+    case kLengthPtrDiff:
+        value = static_cast<uint64_t>(va_arg(aArguments, ptrdiff_t));
+        break;
+    default:
+        value = va_arg(aArguments, unsigned int);
+        break;
+    }
+
+    return value;
+}
+
+/**
+ * This function builds the specification to print a captured value, with the length modifier replaced by
+ * @p aLength and the precision by @p aPrecision if not NULL.
+ *
+ */
+bool BuildSpec(const Spec &aSpec, const char *aLength, const char *aPrecision, char *aOutput)
+{
+    const char *precision = aSpec.mLengthBegin;
+    size_t      prefix;
+    bool        ret = false;
+
+    if (aPrecision != NULL)
+    {
+        // The precision starts at the '.' before the length modifier.
+        for (const char *p = aSpec.mBegin; p < aSpec.mLengthBegin; ++p)
+        {
+            if (*p == '.')
+            {
+                precision = p;
+                break;
+            }
+        }
+    }
+    else
+    {
+        aPrecision = "";
+    }
+
+    prefix = static_cast<size_t>(precision - aSpec.mBegin);
+    VerifyOrExit(prefix + strlen(aPrecision) + strlen(aLength) + 2 <= kMaxSpecLength);
+
+    memcpy(aOutput, aSpec.mBegin, prefix);
+    aOutput += prefix;
+    aOutput = strcpy(aOutput, aPrecision) + strlen(aPrecision);
+    aOutput = strcpy(aOutput, aLength) + strlen(aLength);
+    aOutput[0] = aSpec.mConversion;
+    aOutput[1] = '\0';
+    ret        = true;
+
+exit:
+    return ret;
+}
+
+void FormatArguments(Output &aOutput, const char *aFormat, const uint8_t *aArguments, uint16_t aLength)
+{
+    Decoder     decoder(aArguments, aLength);
+    const char *p = aFormat;
+
+    while (*p != '\0')
+    {
+        const char *literal = p;
+        Spec        spec;
+        char        format[kMaxSpecLength];
+        int         stars[kMaxStars + 1];
+        int         numStars = 0;
+        bool        ok       = true;
+
+        while (*p != '\0' && *p != '%')
+        {
+            ++p;
+        }
+
+        aOutput.Append(literal, static_cast<size_t>(p - literal));
+        VerifyOrExit(*p != '\0');
+
+        p = ParseSpec(p, spec);
+
+        if (spec.mConversion == '%')
+        {
+            aOutput.Append("%", 1);
+            continue;
+        }
+
+        for (int i = 0; i < spec.mStars && ok; ++i)
+        {
+            int64_t star;
+
+            ok              = decoder.GetInteger(star);
+            stars[numStars] = static_cast<int>(star);
+            ++numStars;
+        }
+
+        if (ok && (IsSigned(spec.mConversion) || IsUnsigned(spec.mConversion)))
+        {
+            int64_t value;
+
+            ok = decoder.GetInteger(value) && BuildSpec(spec, "ll", NULL, format);
+
+            if (ok && IsSigned(spec.mConversion))
+            {
+                aOutput.Print(format, stars, numStars, static_cast<long long>(value));
+            }
+            else if (ok)
+            {
+                aOutput.Print(format, stars, numStars, static_cast<unsigned long long>(value));
+            }
+        }
+        else if (ok && spec.mConversion == 'c')
+        {
+            int64_t value;
+
+            ok = decoder.GetInteger(value) && BuildSpec(spec, "", NULL, format);
+
+            if (ok)
+            {
+                aOutput.Print(format, stars, numStars, static_cast<int>(value));
+            }
+        }
+        else if (ok && IsFloat(spec.mConversion))
+        {
+            double value;
+
+            ok = decoder.GetValue(&value, sizeof(value)) && BuildSpec(spec, "", NULL, format);
+
+            if (ok)
+            {
+                aOutput.Print(format, stars, numStars, value);
+            }
+        }
+        else if (ok && spec.mConversion == 'p')
+        {
+            uint64_t value;
+
+            ok = decoder.GetValue(&value, sizeof(value)) && BuildSpec(spec, "", NULL, format);
+
+            if (ok)
+            {
+                aOutput.Print(format, stars, numStars, reinterpret_cast<void *>(static_cast<uintptr_t>(value)));
+            }
+        }
+        else if (ok && (spec.mConversion == 's' || spec.mConversion == 'm'))
+        {
+            const char *value;
+            uint16_t    length;
+
+            // Captured strings are not terminated, the precision limits the printed length.
+            if (spec.mStarPrecision)
+            {
+                --numStars;
+            }
+
+            spec.mConversion = 's';
+            ok               = decoder.GetString(value, length) && BuildSpec(spec, "", ".*", format);
+
+            if (ok)
+            {
+                stars[numStars] = length;
+                aOutput.Print(format, stars, numStars + 1, value);
+            }
+        }
+        else if (spec.mConversion != 'n')
+        {
+            ok = false;
+        }
+
+        if (!ok)
+        {
+            // Arguments not captured are printed as the specification.
+            aOutput.Append(spec.mBegin, static_cast<size_t>(spec.mEnd - spec.mBegin));
+        }
+    }
+
+exit:
+    return;
+}
+
+void FormatDump(Output &aOutput, const uint8_t *aArguments, uint16_t aLength)
+{
+    Decoder        decoder(aArguments, aLength);
+    uint16_t       offset;
+    const char *   prefix;
+    uint16_t       prefixLength;
+    const uint8_t *memory;
+    uint16_t       size;
+
+    VerifyOrExit(decoder.GetValue(&offset, sizeof(offset)) && decoder.GetString(prefix, prefixLength));
+    memory = decoder.GetRemaining(size);
+
+    // Dumps are broken into 16 byte lines in the form of "PREFIX: ADDR: XX XX XX ...".
+    for (uint16_t line = 0; line < size; line = static_cast<uint16_t>(line + 16))
+    {
+        char     hex[16 * 3];
+        char     address[8];
+        uint16_t end = (size - line > 16 ? static_cast<uint16_t>(line + 16) : size);
+        size_t   length = 0;
+
+        for (uint16_t i = line; i < end; ++i)
+        {
+            hex[length++] = kHexChars[memory[i] >> 4];
+            hex[length++] = kHexChars[memory[i] & 0x0f];
+            hex[length++] = ' ';
+        }
+
+        if (line > 0)
+        {
+            aOutput.Append("\n", 1);
+        }
+
+        snprintf(address, sizeof(address), "%04x", static_cast<unsigned int>(offset + line));
+        aOutput.Append(prefix, prefixLength);
+        aOutput.Append(": ", 2);
+        aOutput.Append(address, strlen(address));
+        aOutput.Append(": ", 2);
+        aOutput.Append(hex, length - 1);
+    }
+
+exit:
+    return;
+}
+
+} // namespace
+
+uint16_t EncodeArguments(uint8_t *aBuffer, uint16_t aSize, const char *aFormat, va_list aArguments)
+{
+    Encoder     encoder(aBuffer, aSize);
+    int         error = errno;
+    const char *p     = aFormat;
+    va_list     arguments;
+
+    va_copy(arguments, aArguments);
+
+    while (*p != '\0' && !encoder.IsFull())
+    {
+        Spec spec;
+        int  precision;
+
+        if (*p != '%')
+        {
+            ++p;
+            continue;
+        }
+
+        p         = ParseSpec(p, spec);
+        precision = spec.mPrecision;
+
+        for (int i = 0; i < spec.mStars; ++i)
+        {
+            int star = va_arg(arguments, int);
+
+            encoder.PutInteger(star);
+
+            // The precision is always the last '*'.
+            if (spec.mStarPrecision)
+            {
+                precision = star;
+            }
+        }
+
+        if (IsSigned(spec.mConversion) || spec.mConversion == 'c')
+        {
+            encoder.PutInteger(GetSigned(spec.mConversion == 'c' ? kLengthNone : spec.mLength, arguments));
+        }
+        else if (IsUnsigned(spec.mConversion))
+        {
+            encoder.PutInteger(static_cast<int64_t>(GetUnsigned(spec.mLength, arguments)));
+        }
+        else if (IsFloat(spec.mConversion))
+        {
+            double value = (spec.mLength == kLengthLongDouble ? static_cast<double>(va_arg(arguments, long double))
+                                                              : va_arg(arguments, double));
+
+            encoder.PutValue(&value, sizeof(value));
+        }
+        else if (spec.mConversion == 'p')
+        {
+            uint64_t value = reinterpret_cast<uintptr_t>(va_arg(arguments, void *));
+
+            encoder.PutValue(&value, sizeof(value));
+        }
+        else if (spec.mConversion == 's' || spec.mConversion == 'm')
+        {
+            const char *value = (spec.mConversion == 's' ? va_arg(arguments, const char *) : strerror(error));
+            size_t      length;
+
+            if (value == NULL)
+            {
+                value = "(null)";
+            }
+
+            // The string may not be terminated if a precision is given.
+            length = (precision >= 0 ? strnlen(value, static_cast<size_t>(precision)) : strlen(value));
+            encoder.PutString(value, length);
+        }
+        else if (spec.mConversion == 'n')
+        {
+            // Nothing is stored through %n.
+            va_arg(arguments, void *);
+        }
+        else if (spec.mConversion != '%')
+        {
+            // The size of an unknown argument is unknown, neither can the following arguments be captured.
+            break;
+        }
+    }
+
+    va_end(arguments);
+
+    return encoder.GetLength();
+}
+
+uint16_t EncodeDump(uint8_t *      aBuffer,
+                    uint16_t       aSize,
+                    const char *   aPrefix,
+                    uint16_t       aOffset,
+                    const uint8_t *aMemory,
+                    uint16_t       aLength)
+{
+    Encoder encoder(aBuffer, aSize);
+
+    encoder.PutValue(&aOffset, sizeof(aOffset));
+    encoder.PutString(aPrefix, strlen(aPrefix));
+    encoder.PutValue(aMemory, aLength);
+
+    return encoder.GetLength();
+}
+
+size_t FormatRecord(const Record &aRecord, char *aOutput, size_t aSize)
+{
+    Output output(aOutput, aSize);
+
+    if (aRecord.mType == kTypeDump)
+    {
+        FormatDump(output, aRecord.mArguments, aRecord.mLength);
+    }
+    else if (aRecord.mFormat != NULL)
+    {
+        FormatArguments(output, aRecord.mFormat, aRecord.mArguments, aRecord.mLength);
+    }
+
+    return output.GetLength();
+}
+
+void WriteText(FILE *aFile, uint64_t aTimestamp, const char *aText, size_t aLength)
+{
+    unsigned long msecs = static_cast<unsigned long>(aTimestamp / 1000);
+    char          stamp[32];
+    int           stampLength;
+    const char *  end = aText + aLength;
+
+    stampLength = snprintf(stamp, sizeof(stamp), "%4lu.%03lu | ", msecs / 1000, msecs % 1000);
+
+    do
+    {
+        const char *line = static_cast<const char *>(memchr(aText, '\n', static_cast<size_t>(end - aText)));
+
+        line = (line != NULL ? line + 1 : end);
+        fwrite(stamp, 1, static_cast<size_t>(stampLength), aFile);
+        fwrite(aText, 1, static_cast<size_t>(line - aText), aFile);
+        aText = line;
+    } while (aText < end);
+
+    fputc('\n', aFile);
+}
+
+BinaryWriter::BinaryWriter(FILE *aFile)
+    : mFile(aFile)
+{
+}
+
+otbrError BinaryWriter::Begin(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(fwrite(kBinaryMagic, sizeof(kBinaryMagic), 1, mFile) == 1, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+otbrError BinaryWriter::WriteRecord(uint8_t     aType,
+                                    uint8_t     aLevel,
+                                    uint32_t    aFormatId,
+                                    uint64_t    aTimestamp,
+                                    const void *aPayload,
+                                    uint16_t    aLength)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    uint8_t   header[16];
+    uint16_t  size = static_cast<uint16_t>(sizeof(header) + aLength);
+
+    // The header is size (2), type (1), level (1), format id (4) and timestamp (8).
+    memcpy(&header[0], &size, sizeof(size));
+    header[2] = aType;
+    header[3] = aLevel;
+    memcpy(&header[4], &aFormatId, sizeof(aFormatId));
+    memcpy(&header[8], &aTimestamp, sizeof(aTimestamp));
+
+    VerifyOrExit(fwrite(header, sizeof(header), 1, mFile) == 1, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(aLength == 0 || fwrite(aPayload, aLength, 1, mFile) == 1, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+otbrError BinaryWriter::Write(const Record &aRecord)
+{
+    otbrError error    = OTBR_ERROR_NONE;
+    uint32_t  formatId = 0;
+
+    if (aRecord.mType == kTypeLog)
+    {
+        FormatMap::iterator it = mFormats.find(aRecord.mFormat);
+
+        if (it == mFormats.end())
+        {
+            size_t length = strnlen(aRecord.mFormat, kMaxTextLength - 1);
+
+            formatId                  = static_cast<uint32_t>(mFormats.size());
+            mFormats[aRecord.mFormat] = formatId;
+            SuccessOrExit(error = WriteRecord(kTypeFormat, 0, formatId, 0, aRecord.mFormat,
+                                              static_cast<uint16_t>(length)));
+        }
+        else
+        {
+            formatId = it->second;
+        }
+    }
+
+    error = WriteRecord(aRecord.mType, aRecord.mLevel, formatId, aRecord.mTimestamp, aRecord.mArguments,
+                        aRecord.mLength);
+
+exit:
+    return error;
+}
+
+otbrError DecodeBinary(FILE *aInput, FILE *aOutput)
+{
+    otbrError                        error = OTBR_ERROR_ERRNO;
+    char                             magic[sizeof(kBinaryMagic)];
+    std::map<uint32_t, std::string>  formats;
+    uint8_t                          payload[kMaxTextLength];
+    char                             text[kMaxTextLength];
+
+    VerifyOrExit(fread(magic, sizeof(magic), 1, aInput) == 1, errno = EINVAL);
+    VerifyOrExit(memcmp(magic, kBinaryMagic, sizeof(magic)) == 0, errno = EINVAL);
+
+    while (true)
+    {
+        uint8_t  header[16];
+        uint16_t size;
+        Record   record;
+        uint32_t formatId;
+
+        size_t   count = fread(header, 1, sizeof(header), aInput);
+
+        if (count == 0 && feof(aInput))
+        {
+            break;
+        }
+
+        VerifyOrExit(count == sizeof(header), errno = EINVAL);
+
+        memcpy(&size, &header[0], sizeof(size));
+        VerifyOrExit(size >= sizeof(header) && size - sizeof(header) <= sizeof(payload), errno = EINVAL);
+
+        record.mLength = static_cast<uint16_t>(size - sizeof(header));
+        record.mType   = header[2];
+        record.mLevel  = header[3];
+        memcpy(&formatId, &header[4], sizeof(formatId));
+        memcpy(&record.mTimestamp, &header[8], sizeof(record.mTimestamp));
+
+        VerifyOrExit(record.mLength == 0 || fread(payload, record.mLength, 1, aInput) == 1, errno = EINVAL);
+        record.mArguments = payload;
+
+        switch (record.mType)
+        {
+        case kTypeFormat:
+            formats[formatId].assign(reinterpret_cast<const char *>(payload), record.mLength);
+            continue;
+
+        case kTypeLog:
+        {
+            std::map<uint32_t, std::string>::const_iterator it = formats.find(formatId);
+
+            VerifyOrExit(it != formats.end(), errno = EINVAL);
+            record.mFormat = it->second.c_str();
+            break;
+        }
+
+        case kTypeDump:
+            record.mFormat = NULL;
+            break;
+
+        default:
+            ExitNow(errno = EINVAL);
+        }
+
+        WriteText(aOutput, record.mTimestamp, text, FormatRecord(record, text, sizeof(text)));
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+} // namespace Log
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,230 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for structured log records.
+ */
+
+#ifndef LOG_RECORD_HPP_
+#define LOG_RECORD_HPP_
+
+#include <map>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Log {
+
+/**
+ * @addtogroup border-router-logging
+ *
+ * @brief
+ *   This module includes definitions for structured log records.
+ *
+ * @{
+ */
+
+enum
+{
+    kTypeLog    = 0, ///< A printf style message.
+    kTypeDump   = 1, ///< A hex dump of memory.
+    kTypeFormat = 2, ///< A format string definition, only used in binary log files.
+};
+
+enum
+{
+    kDestinationSyslog = 1 << 0, ///< The record is written to syslog.
+    kDestinationFile   = 1 << 1, ///< The record is written to the private log file.
+};
+
+enum
+{
+    kMaxArgumentsLength = 1024, ///< Max size of the captured arguments of a record in bytes.
+    kMaxDumpChunk       = 256,  ///< Max bytes of memory captured in a dump record.
+    kMaxTextLength      = 4096, ///< Max size of the text of a formatted record in bytes.
+};
+
+/**
+ * This structure represents a log record, which captures the arguments instead of the formatted text.
+ *
+ */
+struct Record
+{
+    uint64_t       mTimestamp;    ///< The timestamp in microseconds.
+    const char *   mFormat;       ///< The format string, NULL for dumps.
+    const uint8_t *mArguments;    ///< The captured arguments.
+    uint16_t       mLength;       ///< The size of the captured arguments in bytes.
+    uint8_t        mType;         ///< The type, one of kType*.
+    uint8_t        mLevel;        ///< The log level.
+    uint8_t        mDestinations; ///< The destinations, a bitwise or of kDestination*.
+};
+
+/**
+ * This function captures the arguments of a printf style format.
+ *
+ * Strings are copied, so the captured arguments stay valid after the caller returns. Arguments which do not fit
+ * in @p aSize bytes are dropped and printed as their conversion specifications.
+ *
+ * @param[out]  aBuffer     A pointer to the buffer to store the arguments.
+ * @param[in]   aSize       The size of @p aBuffer.
+ * @param[in]   aFormat     The format string as in printf.
+ * @param[in]   aArguments  The arguments of @p aFormat.
+ *
+ * @returns The number of bytes stored in @p aBuffer.
+ *
+ */
+uint16_t EncodeArguments(uint8_t *aBuffer, uint16_t aSize, const char *aFormat, va_list aArguments);
+
+/**
+ * This function captures a chunk of memory to be dumped.
+ *
+ * @param[out]  aBuffer     A pointer to the buffer to store the dump.
+ * @param[in]   aSize       The size of @p aBuffer.
+ * @param[in]   aPrefix     The string before each line.
+ * @param[in]   aOffset     The offset of @p aMemory in the whole dump.
+ * @param[in]   aMemory     A pointer to the memory.
+ * @param[in]   aLength     The size of @p aMemory, at most kMaxDumpChunk.
+ *
+ * @returns The number of bytes stored in @p aBuffer.
+ *
+ */
+uint16_t EncodeDump(uint8_t *      aBuffer,
+                    uint16_t       aSize,
+                    const char *   aPrefix,
+                    uint16_t       aOffset,
+                    const uint8_t *aMemory,
+                    uint16_t       aLength);
+
+/**
+ * This function formats a record into lines separated by new lines, without the trailing new line.
+ *
+ * @param[in]   aRecord     A reference to the record.
+ * @param[out]  aOutput     A pointer to the buffer to store the text.
+ * @param[in]   aSize       The size of @p aOutput.
+ *
+ * @returns The length of the text, which is truncated to fit in @p aOutput.
+ *
+ */
+size_t FormatRecord(const Record &aRecord, char *aOutput, size_t aSize);
+
+/**
+ * This function writes text to a log file, with each line prefixed by the timestamp.
+ *
+ * @param[in]   aFile       A pointer to the log file.
+ * @param[in]   aTimestamp  The timestamp in microseconds since logging started.
+ * @param[in]   aText       A pointer to the text.
+ * @param[in]   aLength     The length of @p aText.
+ *
+ */
+void WriteText(FILE *aFile, uint64_t aTimestamp, const char *aText, size_t aLength);
+
+/**
+ * This class writes records in the binary log format.
+ *
+ * A binary log starts with a magic number, followed by records with a fixed header. A format string is written
+ * once as a kTypeFormat record, and later records refer to it by id. Records are in host byte order, so a binary
+ * log is decoded on a host of the same architecture.
+ *
+ */
+class BinaryWriter
+{
+public:
+    /**
+     * The constructor to initialize a binary writer.
+     *
+     * @param[in]   aFile   A pointer to the log file.
+     *
+     */
+    explicit BinaryWriter(FILE *aFile);
+
+    /**
+     * This method writes the magic number at the beginning of the log file.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully written.
+     * @retval  OTBR_ERROR_ERRNO    Failed to write.
+     *
+     */
+    otbrError Begin(void);
+
+    /**
+     * This method writes a record.
+     *
+     * @param[in]   aRecord     A reference to the record, whose timestamp is since logging started.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully written.
+     * @retval  OTBR_ERROR_ERRNO    Failed to write.
+     *
+     */
+    otbrError Write(const Record &aRecord);
+
+private:
+    typedef std::map<const char *, uint32_t> FormatMap;
+
+    otbrError WriteRecord(uint8_t     aType,
+                          uint8_t     aLevel,
+                          uint32_t    aFormatId,
+                          uint64_t    aTimestamp,
+                          const void *aPayload,
+                          uint16_t    aLength);
+
+    FILE *    mFile;
+    FormatMap mFormats;
+};
+
+/**
+ * This function decodes a binary log into the text format.
+ *
+ * @param[in]   aInput      A pointer to the binary log file.
+ * @param[in]   aOutput     A pointer to the text output.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully decoded.
+ * @retval  OTBR_ERROR_ERRNO    The input is not a valid binary log, or is truncated.
+ *
+ */
+otbrError DecodeBinary(FILE *aInput, FILE *aOutput);
+
+/**
+ * @}
+ */
+
+} // namespace Log
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // LOG_RECORD_HPP_
@@ -0,0 +1,519 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * This file implements the asynchronous log writer.
+ */
+
+#include "log_writer.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "code_utils.hpp"
+#include "logging.hpp"
+#include "time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Log {
+
+namespace {
+
+/**
+ * This structure is the header of a record in a ring buffer, followed by the captured arguments.
+ *
+ */
+struct Entry
+{
+    uint16_t    mSize;   ///< Size of this entry in bytes including the arguments, 0 to skip to the beginning.
+    uint16_t    mLength; ///< Size of the captured arguments in bytes.
+    uint8_t     mType;
+    uint8_t     mLevel;
+    uint8_t     mDestinations;
+    uint64_t    mTimestamp;
+    const char *mFormat;
+};
+
+const size_t kAlignment = 8;
+
+size_t Align(size_t aSize)
+{
+    return (aSize + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+/**
+ * This structure identifies the ring buffer of the current thread.
+ *
+ */
+struct ThreadRing
+{
+    const AsyncWriter *mWriter;
+    unsigned long      mGeneration;
+    void *             mRing;
+};
+
+thread_local ThreadRing sThreadRing;
+
+std::atomic<unsigned long> sGeneration(0);
+
+const char kDroppedFormat[] = "%lu log records dropped!";
+
+uint16_t Encode(uint8_t *aBuffer, uint16_t aSize, const char *aFormat, ...)
+{
+    uint16_t length;
+    va_list  arguments;
+
+    va_start(arguments, aFormat);
+    length = EncodeArguments(aBuffer, aSize, aFormat, arguments);
+    va_end(arguments);
+
+    return length;
+}
+
+} // namespace
+
+/**
+ * This class implements a single producer single consumer ring buffer of records.
+ *
+ * Positions only increase, and are masked to index the buffer.
+ *
+ */
+class AsyncWriter::Ring
+{
+public:
+    Ring(void)
+        : mHead(0)
+        , mTail(0)
+        , mFlushed(0)
+        , mDropped(0)
+        , mReported(0)
+        , mNext(NULL)
+    {
+    }
+
+    bool Push(const Entry &aEntry, const uint8_t *aArguments)
+    {
+        size_t head       = mHead.load(std::memory_order_relaxed);
+        size_t tail       = mTail.load(std::memory_order_acquire);
+        size_t offset     = head & (kRingSize - 1);
+        size_t contiguous = kRingSize - offset;
+        size_t need       = (contiguous < aEntry.mSize ? contiguous + aEntry.mSize : aEntry.mSize);
+        bool   ret        = false;
+
+        VerifyOrExit(kRingSize - (head - tail) >= need, mDropped.fetch_add(1, std::memory_order_relaxed));
+
+        if (contiguous < aEntry.mSize)
+        {
+            // The entry never wraps, the rest of the buffer is skipped.
+            memset(&mBuffer[offset], 0, sizeof(aEntry.mSize));
+            head += contiguous;
+            offset = 0;
+        }
+
+        memcpy(&mBuffer[offset], &aEntry, sizeof(aEntry));
+        memcpy(&mBuffer[offset + sizeof(aEntry)], aArguments, aEntry.mLength);
+        mHead.store(head + aEntry.mSize, std::memory_order_release);
+        ret = true;
+
+    exit:
+        return ret;
+    }
+
+    bool IsHalfFull(void) const
+    {
+        return mHead.load(std::memory_order_relaxed) - mTail.load(std::memory_order_relaxed) >= kRingSize / 2;
+    }
+
+    bool IsEmpty(void) const
+    {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_relaxed);
+    }
+
+    size_t Consume(Sink &aSink)
+    {
+        size_t head  = mHead.load(std::memory_order_acquire);
+        size_t tail  = mTail.load(std::memory_order_relaxed);
+        size_t count = 0;
+
+        while (tail != head)
+        {
+            size_t   offset = tail & (kRingSize - 1);
+            uint16_t size;
+            Entry    entry;
+            Record   record;
+
+            memcpy(&size, &mBuffer[offset], sizeof(size));
+
+            if (size == 0)
+            {
+                tail += kRingSize - offset;
+                continue;
+            }
+
+            memcpy(&entry, &mBuffer[offset], sizeof(entry));
+            record.mTimestamp    = entry.mTimestamp;
+            record.mFormat       = entry.mFormat;
+            record.mArguments    = &mBuffer[offset + sizeof(entry)];
+            record.mLength       = entry.mLength;
+            record.mType         = entry.mType;
+            record.mLevel        = entry.mLevel;
+            record.mDestinations = entry.mDestinations;
+            aSink.Write(record);
+
+            tail += entry.mSize;
+            mTail.store(tail, std::memory_order_release);
+            ++count;
+        }
+
+        return count;
+    }
+
+    std::atomic<size_t>        mHead;
+    std::atomic<size_t>        mTail;
+    std::atomic<size_t>        mFlushed;
+    std::atomic<unsigned long> mDropped;
+    unsigned long              mReported;
+    Ring *                     mNext;
+    alignas(kAlignment) uint8_t mBuffer[kRingSize];
+};
+
+AsyncWriter::AsyncWriter(Sink &aSink)
+    : mSink(aSink)
+    , mRings(NULL)
+    , mRunning(false)
+    , mSleeping(false)
+    , mGeneration(0)
+    , mThread()
+{
+    mWakeupPipe[0] = -1;
+    mWakeupPipe[1] = -1;
+}
+
+AsyncWriter::~AsyncWriter(void)
+{
+    Stop();
+}
+
+otbrError AsyncWriter::Start(void)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+
+    VerifyOrExit(!IsRunning(), error = OTBR_ERROR_NONE);
+
+    VerifyOrExit(pipe(mWakeupPipe) == 0);
+    SuccessOrExit(fcntl(mWakeupPipe[0], F_SETFL, fcntl(mWakeupPipe[0], F_GETFL, 0) | O_NONBLOCK));
+    SuccessOrExit(fcntl(mWakeupPipe[1], F_SETFL, fcntl(mWakeupPipe[1], F_GETFL, 0) | O_NONBLOCK));
+
+    // Rings of a former run are never reused by threads which logged before.
+    mGeneration = ++sGeneration;
+    mRunning.store(true, std::memory_order_release);
+
+    if ((errno = pthread_create(&mThread, NULL, Run, this)) != 0)
+    {
+        mRunning.store(false, std::memory_order_release);
+        ExitNow();
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE && mWakeupPipe[0] >= 0)
+    {
+        close(mWakeupPipe[0]);
+        close(mWakeupPipe[1]);
+        mWakeupPipe[0] = -1;
+        mWakeupPipe[1] = -1;
+    }
+
+    return error;
+}
+
+void AsyncWriter::Stop(void)
+{
+    Ring *ring;
+
+    VerifyOrExit(IsRunning());
+
+    mRunning.store(false, std::memory_order_release);
+    Wakeup();
+    pthread_join(mThread, NULL);
+
+    ring = mRings.exchange(NULL);
+
+    while (ring != NULL)
+    {
+        Ring *next = ring->mNext;
+
+        delete ring;
+        ring = next;
+    }
+
+    close(mWakeupPipe[0]);
+    close(mWakeupPipe[1]);
+    mWakeupPipe[0] = -1;
+    mWakeupPipe[1] = -1;
+
+exit:
+    return;
+}
+
+AsyncWriter::Ring *AsyncWriter::GetRing(void)
+{
+    Ring *ring = static_cast<Ring *>(sThreadRing.mRing);
+
+    if (sThreadRing.mWriter != this || sThreadRing.mGeneration != mGeneration)
+    {
+        // The ring of a thread lives until the writer is stopped, since the writer may still be reading it.
+        ring = new (std::nothrow) Ring();
+        VerifyOrExit(ring != NULL);
+
+        ring->mNext = mRings.load(std::memory_order_relaxed);
+        while (!mRings.compare_exchange_weak(ring->mNext, ring, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        sThreadRing.mWriter     = this;
+        sThreadRing.mGeneration = mGeneration;
+        sThreadRing.mRing       = ring;
+    }
+
+exit:
+    return ring;
+}
+
+void AsyncWriter::Append(uint8_t        aType,
+                         uint8_t        aLevel,
+                         uint8_t        aDestinations,
+                         const char *   aFormat,
+                         const uint8_t *aArguments,
+                         uint16_t       aLength)
+{
+    Ring *ring = GetRing();
+    Entry entry;
+
+    VerifyOrExit(ring != NULL);
+
+    entry.mSize         = static_cast<uint16_t>(Align(sizeof(entry) + aLength));
+    entry.mLength       = aLength;
+    entry.mType         = aType;
+    entry.mLevel        = aLevel;
+    entry.mDestinations = aDestinations;
+    entry.mTimestamp    = GetCoarseNowMicros();
+    entry.mFormat       = aFormat;
+
+    VerifyOrExit(ring->Push(entry, aArguments));
+
+    // Pairs with the fence in Run(), so either the writer sees this record or this thread sees it sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A busy writer polls periodically, and is only woken up early if the ring is filling up.
+    if (mSleeping.load(std::memory_order_relaxed) || ring->IsHalfFull())
+    {
+        Wakeup();
+    }
+
+exit:
+    return;
+}
+
+void AsyncWriter::Log(uint8_t aLevel, uint8_t aDestinations, const char *aFormat, va_list aArguments)
+{
+    uint8_t  arguments[kMaxArgumentsLength];
+    uint16_t length = EncodeArguments(arguments, sizeof(arguments), aFormat, aArguments);
+
+    Append(kTypeLog, aLevel, aDestinations, aFormat, arguments, length);
+}
+
+void AsyncWriter::Dump(uint8_t aLevel, uint8_t aDestinations, const char *aPrefix, const void *aMemory, size_t aSize)
+{
+    const uint8_t *memory = static_cast<const uint8_t *>(aMemory);
+
+    for (size_t offset = 0; offset < aSize; offset += kMaxDumpChunk)
+    {
+        uint8_t  arguments[kMaxArgumentsLength];
+        size_t   chunk  = std::min(aSize - offset, static_cast<size_t>(kMaxDumpChunk));
+        uint16_t length = EncodeDump(arguments, sizeof(arguments), aPrefix, static_cast<uint16_t>(offset),
+                                     memory + offset, static_cast<uint16_t>(chunk));
+
+        Append(kTypeDump, aLevel, aDestinations, NULL, arguments, length);
+    }
+}
+
+void AsyncWriter::Wakeup(void)
+{
+    // A full pipe already wakes up the writer.
+    if (write(mWakeupPipe[1], "", 1) < 0)
+    {
+        assert(errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+}
+
+void AsyncWriter::Flush(void)
+{
+    Ring *ring;
+
+    VerifyOrExit(IsRunning());
+
+    for (ring = mRings.load(std::memory_order_acquire); ring != NULL; ring = ring->mNext)
+    {
+        size_t head = ring->mHead.load(std::memory_order_acquire);
+
+        while (ring->mFlushed.load(std::memory_order_acquire) < head)
+        {
+            Wakeup();
+            usleep(1000);
+        }
+    }
+
+exit:
+    return;
+}
+
+unsigned long AsyncWriter::GetDropped(void) const
+{
+    unsigned long dropped = 0;
+
+    for (Ring *ring = mRings.load(std::memory_order_acquire); ring != NULL; ring = ring->mNext)
+    {
+        dropped += ring->mDropped.load(std::memory_order_relaxed);
+    }
+
+    return dropped;
+}
+
+bool AsyncWriter::Drain(void)
+{
+    size_t count = 0;
+
+    for (Ring *ring = mRings.load(std::memory_order_acquire); ring != NULL; ring = ring->mNext)
+    {
+        unsigned long dropped = ring->mDropped.load(std::memory_order_relaxed);
+
+        count += ring->Consume(mSink);
+
+        if (dropped != ring->mReported)
+        {
+            uint8_t arguments[sizeof(uint64_t)];
+            Record  record;
+
+            record.mTimestamp    = GetCoarseNowMicros();
+            record.mFormat       = kDroppedFormat;
+            record.mArguments    = arguments;
+            record.mLength       = Encode(arguments, sizeof(arguments), kDroppedFormat, dropped - ring->mReported);
+            record.mType         = kTypeLog;
+            record.mLevel        = OTBR_LOG_WARNING;
+            record.mDestinations = kDestinationSyslog | kDestinationFile;
+            mSink.Write(record);
+
+            ring->mReported = dropped;
+            ++count;
+        }
+    }
+
+    if (count > 0)
+    {
+        mSink.Flush();
+    }
+
+    // Only records written by the sink are reported flushed.
+    for (Ring *ring = mRings.load(std::memory_order_acquire); ring != NULL; ring = ring->mNext)
+    {
+        ring->mFlushed.store(ring->mTail.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    return count > 0;
+}
+
+void *AsyncWriter::Run(void *aContext)
+{
+    static_cast<AsyncWriter *>(aContext)->Run();
+    return NULL;
+}
+
+bool AsyncWriter::IsEmpty(void) const
+{
+    bool empty = true;
+
+    for (Ring *ring = mRings.load(std::memory_order_acquire); ring != NULL && empty; ring = ring->mNext)
+    {
+        empty = ring->IsEmpty();
+    }
+
+    return empty;
+}
+
+void AsyncWriter::Run(void)
+{
+    struct pollfd pfd;
+
+    pfd.fd     = mWakeupPipe[0];
+    pfd.events = POLLIN;
+
+    while (IsRunning())
+    {
+        char buffer[64];
+        int  timeout = kFlushInterval;
+
+        if (!Drain())
+        {
+            // Sleep until the next record when idle, instead of polling.
+            mSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            timeout = (IsEmpty() ? -1 : 0);
+        }
+
+        // Records captured meanwhile are written in a batch.
+        if (poll(&pfd, 1, timeout) > 0)
+        {
+            while (read(mWakeupPipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+        }
+
+        mSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    // Records captured before stopping are still written.
+    Drain();
+}
+
+} // namespace Log
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,209 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the asynchronous log writer.
+ */
+
+#ifndef LOG_WRITER_HPP_
+#define LOG_WRITER_HPP_
+
+#include <atomic>
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log_record.hpp"
+#include "types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Log {
+
+/**
+ * @addtogroup border-router-logging
+ *
+ * @{
+ */
+
+/**
+ * This interface represents the destination of log records.
+ *
+ */
+class Sink
+{
+public:
+    /**
+     * This method writes a record.
+     *
+     * @param[in]   aRecord     A reference to the record, which is only valid during this call.
+     *
+     */
+    virtual void Write(const Record &aRecord) = 0;
+
+    /**
+     * This method flushes records written so far.
+     *
+     */
+    virtual void Flush(void) = 0;
+
+    virtual ~Sink(void) {}
+};
+
+/**
+ * This class captures log records into per-thread lock-free ring buffers, and writes them to a sink from a
+ * background thread.
+ *
+ * Logging threads never block: a record is dropped if the ring buffer of its thread is full, and the number of
+ * dropped records is logged later.
+ *
+ */
+class AsyncWriter
+{
+public:
+    /**
+     * The constructor to initialize an asynchronous writer.
+     *
+     * @param[in]   aSink   A reference to the destination of records.
+     *
+     */
+    explicit AsyncWriter(Sink &aSink);
+
+    ~AsyncWriter(void);
+
+    /**
+     * This method starts the background thread.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started.
+     * @retval  OTBR_ERROR_ERRNO    Failed to start, error code is stored in errno.
+     *
+     */
+    otbrError Start(void);
+
+    /**
+     * This method writes all pending records and stops the background thread.
+     *
+     * No other thread may log while stopping.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method indicates whether the background thread is running.
+     *
+     * @retval  true    The background thread is running.
+     * @retval  false   The background thread is not running.
+     *
+     */
+    bool IsRunning(void) const { return mRunning.load(std::memory_order_acquire); }
+
+    /**
+     * This method captures a printf style message.
+     *
+     * @param[in]   aLevel          The log level.
+     * @param[in]   aDestinations   The destinations, a bitwise or of kDestination*.
+     * @param[in]   aFormat         The format string, which must stay valid until the writer is stopped.
+     * @param[in]   aArguments      The arguments of @p aFormat.
+     *
+     */
+    void Log(uint8_t aLevel, uint8_t aDestinations, const char *aFormat, va_list aArguments);
+
+    /**
+     * This method captures a hex dump of memory.
+     *
+     * @param[in]   aLevel          The log level.
+     * @param[in]   aDestinations   The destinations, a bitwise or of kDestination*.
+     * @param[in]   aPrefix         The string before each line.
+     * @param[in]   aMemory         A pointer to the memory.
+     * @param[in]   aSize           The size of @p aMemory in bytes.
+     *
+     */
+    void Dump(uint8_t aLevel, uint8_t aDestinations, const char *aPrefix, const void *aMemory, size_t aSize);
+
+    /**
+     * This method waits until all records captured by now are written and flushed.
+     *
+     */
+    void Flush(void);
+
+    /**
+     * This method returns the number of records dropped since started.
+     *
+     * @returns The number of dropped records.
+     *
+     */
+    unsigned long GetDropped(void) const;
+
+private:
+    enum
+    {
+        kRingSize      = 64 * 1024, ///< Size of the ring buffer of each thread in bytes, must be a power of two.
+        kFlushInterval = 10,        ///< Time in milliseconds to batch records while busy.
+    };
+
+    class Ring;
+
+    Ring *GetRing(void);
+    void  Append(uint8_t        aType,
+                 uint8_t        aLevel,
+                 uint8_t        aDestinations,
+                 const char *   aFormat,
+                 const uint8_t *aArguments,
+                 uint16_t       aLength);
+    void  Wakeup(void);
+    bool  Drain(void);
+    bool  IsEmpty(void) const;
+
+    static void *Run(void *aContext);
+    void         Run(void);
+
+    Sink &              mSink;
+    std::atomic<Ring *> mRings;
+    std::atomic<bool>   mRunning;
+    std::atomic<bool>   mSleeping;
+    unsigned long       mGeneration;
+    pthread_t           mThread;
+    int                 mWakeupPipe[2];
+};
+
+/**
+ * @}
+ */
+
+} // namespace Log
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // LOG_WRITER_HPP_
@@ -38,19 +38,92 @@
 #include <sys/time.h>
 #include <syslog.h>
 
+#include "log_record.hpp"
+#include "log_writer.hpp"
 #include "time.hpp"
 
-static int        sLevel      = LOG_INFO;
-static const char kHexChars[] = "0123456789abcdef";
+using ot::BorderRouter::Log::AsyncWriter;
+using ot::BorderRouter::Log::BinaryWriter;
+using ot::BorderRouter::Log::Record;
 
-static unsigned long sMsecsStart;
-static bool          sLogCol0 = true; /* we start at col0 */
-static FILE *        sLogFp;
-static bool          sSyslogEnabled = true;
-static bool          sSyslogOpened  = false;
+static int sLevel = LOG_INFO;
 
-#define LOGFLAG_syslog 1
-#define LOGFLAG_file 2
+static uint64_t sUsecsStart;
+static FILE *   sLogFp;
+static bool     sSyslogEnabled = true;
+static bool     sSyslogOpened  = false;
+
+#define LOGFLAG_syslog ot::BorderRouter::Log::kDestinationSyslog
+#define LOGFLAG_file ot::BorderRouter::Log::kDestinationFile
+
+/** Write records to the syslog and the private log file */
+class LogSink : public ot::BorderRouter::Log::Sink
+{
+public:
+    LogSink(void)
+        : mBinary(NULL)
+    {
+    }
+
+    void Write(const Record &aRecord)
+    {
+        char   text[ot::BorderRouter::Log::kMaxTextLength];
+        size_t length = ot::BorderRouter::Log::FormatRecord(aRecord, text, sizeof(text));
+
+        if ((aRecord.mDestinations & LOGFLAG_file) && sLogFp != NULL)
+        {
+            Record record(aRecord);
+
+            record.mTimestamp -= sUsecsStart;
+
+            if (mBinary != NULL)
+            {
+                mBinary->Write(record);
+            }
+            else
+            {
+                ot::BorderRouter::Log::WriteText(sLogFp, record.mTimestamp, text, length);
+            }
+        }
+
+        if (aRecord.mDestinations & LOGFLAG_syslog)
+        {
+            char *context;
+
+            // Each line of a dump is a separate syslog message.
+            for (char *line = strtok_r(text, "\n", &context); line != NULL; line = strtok_r(NULL, "\n", &context))
+            {
+                syslog(aRecord.mLevel, "%s", line);
+            }
+        }
+    }
+
+    void Flush(void)
+    {
+        if (sLogFp != NULL)
+        {
+            fflush(sLogFp);
+        }
+    }
+
+    void SetBinary(bool aBinary)
+    {
+        delete mBinary;
+        mBinary = NULL;
+
+        if (aBinary && sLogFp != NULL)
+        {
+            mBinary = new BinaryWriter(sLogFp);
+            mBinary->Begin();
+        }
+    }
+
+private:
+    BinaryWriter *mBinary;
+};
+
+static LogSink     sSink;
+static AsyncWriter sAsyncWriter(sSink);
 
 /** Set/Clear syslog enable flag */
 void otbrLogEnableSyslog(bool b)
@@ -113,65 +186,32 @@ static int LogCheck(int aLevel)
     return r;
 }
 
-/** return the time, in milliseconds since application start */
-static unsigned long GetMsecsNow(void)
-{
-    unsigned long now = ot::BorderRouter::GetNow();
-
-    now -= sMsecsStart;
-    return now;
-}
-
-/** Write this string to the private log file, inserting the timestamp at column 0 */
-static void LogString(const char *cp)
+/** return the time, in microseconds since application start */
+static uint64_t GetUsecsNow(void)
 {
-    int ch;
-
-    while ((ch = *cp++) != 0)
-    {
-        if (sLogCol0)
-        {
-            sLogCol0 = false;
-            unsigned long n;
-            n = GetMsecsNow();
-            fprintf(sLogFp, "%4lu.%03lu | ", (n / 1000), (n % 1000));
-        }
-        if (ch == '\n')
-        {
-            sLogCol0 = true;
-        }
-        fputc(ch, sLogFp);
-        if (ch == '\n')
-        {
-            /* force flush (in case something crashes) */
-            fflush(sLogFp);
-        }
-    }
+    // Timestamps never use the cached time of the mainloop.
+    return ot::BorderRouter::GetCoarseNowMicros() - sUsecsStart;
 }
 
 /** Print to the private log file */
 static void LogVprintf(const char *fmt, va_list ap)
 {
     char buf[1024];
+    int  length;
 
     /* if not enabled ... leave */
     if (sLogFp == NULL)
     {
         return;
     }
-    vsnprintf(buf, sizeof(buf), fmt, ap);
 
-    LogString(buf);
-}
+    length = vsnprintf(buf, sizeof(buf), fmt, ap);
+    length = (length < 0 ? 0 : (length < static_cast<int>(sizeof(buf)) ? length : static_cast<int>(sizeof(buf)) - 1));
 
-/** Print to the private log file */
-static void LogPrintf(const char *fmt, ...)
-{
-    va_list ap;
+    ot::BorderRouter::Log::WriteText(sLogFp, GetUsecsNow(), buf, static_cast<size_t>(length));
 
-    va_start(ap, fmt);
-    LogVprintf(fmt, ap);
-    va_end(ap);
+    /* force flush (in case something crashes) */
+    fflush(sLogFp);
 }
 
 /** Initialize logging */
@@ -180,7 +220,7 @@ void otbrLogInit(const char *aIdent, int aLevel, bool aPrintStderr)
     assert(aIdent);
     assert(aLevel >= LOG_EMERG && aLevel <= LOG_DEBUG);
 
-    sMsecsStart = ot::BorderRouter::GetNow();
+    sUsecsStart = ot::BorderRouter::GetCoarseNowMicros();
 
     /* only open the syslog once... */
     if (!sSyslogOpened)
@@ -210,15 +250,18 @@ void otbrLogv(int aLevel, const char *aFormat, va_list ap)
 
     r = LogCheck(aLevel);
 
+    if (r != 0 && sAsyncWriter.IsRunning())
+    {
+        sAsyncWriter.Log(static_cast<uint8_t>(aLevel), static_cast<uint8_t>(r), aFormat, ap);
+        return;
+    }
+
     if (r & LOGFLAG_file)
     {
         va_list cpy;
         va_copy(cpy, ap);
         LogVprintf(aFormat, cpy);
         va_end(cpy);
-
-        /* logs do not end with a NEWLINE, we add one here */
-        LogString("\n");
     }
 
     if (r & LOGFLAG_syslog)
@@ -231,10 +274,8 @@ void otbrLogv(int aLevel, const char *aFormat, va_list ap)
 void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize)
 {
     assert(aPrefix && (aMemory || aSize == 0));
-    const uint8_t *pEnd;
-    const uint8_t *p8;
+    const uint8_t *memory = static_cast<const uint8_t *>(aMemory);
     int            r;
-    int            addr;
 
     r = LogCheck(aLevel);
     if (r == 0)
@@ -242,48 +283,39 @@ void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize
         return;
     }
 
-    /* break hex dumps into 16byte lines
+    if (sAsyncWriter.IsRunning())
+    {
+        sAsyncWriter.Dump(static_cast<uint8_t>(aLevel), static_cast<uint8_t>(r), aPrefix, aMemory, aSize);
+        return;
+    }
+
+    /* break hex dumps into chunks, which are formatted as 16byte lines
      * In the form ADDR: XX XX XX XX ...
      */
-
-    // we pre-increment... so subtract
-    addr = -16;
-
-    while (aSize > 0)
+    for (size_t offset = 0; offset < aSize; offset += ot::BorderRouter::Log::kMaxDumpChunk)
     {
-        size_t this_size;
-        char   hex[16 * 3 + 1];
-
-        addr = addr + 16;
-        p8   = (const uint8_t *)(aMemory) + addr;
-
-        /* truncate line to max 16 bytes */
-        this_size = aSize;
-        if (this_size > 16)
-        {
-            this_size = 16;
-        }
-        aSize = aSize - this_size;
-
-        char *ch = hex - 1;
+        uint8_t arguments[ot::BorderRouter::Log::kMaxArgumentsLength];
+        size_t  chunk = aSize - offset;
+        Record  record;
 
-        for (pEnd = p8 + this_size; p8 < pEnd; p8++)
+        if (chunk > ot::BorderRouter::Log::kMaxDumpChunk)
         {
-            *++ch = kHexChars[(*p8) >> 4];
-            *++ch = kHexChars[(*p8) & 0x0f];
-            *++ch = ' ';
+            chunk = ot::BorderRouter::Log::kMaxDumpChunk;
         }
-        *ch = 0;
 
-        if (r & LOGFLAG_syslog)
-        {
-            syslog(aLevel, "%s: %04x: %s", aPrefix, addr, hex);
-        }
-        if (r & LOGFLAG_file)
-        {
-            LogPrintf("%s: %04x: %s\n", aPrefix, addr, hex);
-        }
+        record.mTimestamp    = ot::BorderRouter::GetCoarseNowMicros();
+        record.mFormat       = NULL;
+        record.mArguments    = arguments;
+        record.mLength       = ot::BorderRouter::Log::EncodeDump(arguments, sizeof(arguments), aPrefix,
+                                                           static_cast<uint16_t>(offset), memory + offset,
+                                                           static_cast<uint16_t>(chunk));
+        record.mType         = ot::BorderRouter::Log::kTypeDump;
+        record.mLevel        = static_cast<uint8_t>(aLevel);
+        record.mDestinations = static_cast<uint8_t>(r);
+        sSink.Write(record);
     }
+
+    sSink.Flush();
 }
 
 const char *otbrErrorString(otbrError aError)
@@ -324,8 +356,36 @@ void otbrLogResult(const char *aAction, otbrError aError)
     otbrLog((aError == OTBR_ERROR_NONE ? OTBR_LOG_INFO : OTBR_LOG_WARNING), "%s: %s", aAction, otbrErrorString(aError));
 }
 
+otbrError otbrLogStartAsync(bool aBinary)
+{
+    otbrError error;
+
+    sSink.SetBinary(aBinary);
+    error = sAsyncWriter.Start();
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        sSink.SetBinary(false);
+    }
+
+    return error;
+}
+
+void otbrLogFlush(void)
+{
+    sAsyncWriter.Flush();
+}
+
+void otbrLogStopAsync(void)
+{
+    sAsyncWriter.Stop();
+    sSink.SetBinary(false);
+}
+
 void otbrLogDeinit(void)
 {
+    otbrLogStopAsync();
+
     sSyslogOpened = false;
     closelog();
 }
@@ -139,6 +139,38 @@ void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize
  */
 const char *otbrErrorString(otbrError aError);
 
+/**
+ * This function starts logging asynchronously.
+ *
+ * Afterwards, logging only captures the level, format string and arguments into a ring buffer of the calling
+ * thread, and a background thread formats and writes them in batches. Format strings must be string literals,
+ * or otherwise stay valid until logging is stopped.
+ *
+ * The private log file must be set before starting.
+ *
+ * @param[in]   aBinary     Whether to write the private log file in the binary format, which is decoded by the
+ *                          log-decoder tool.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully started.
+ * @retval  OTBR_ERROR_ERRNO    Failed to start the background thread.
+ *
+ */
+otbrError otbrLogStartAsync(bool aBinary);
+
+/**
+ * This function waits until logs so far are written, if logging asynchronously.
+ *
+ */
+void otbrLogFlush(void);
+
+/**
+ * This function writes pending logs, and stops logging asynchronously.
+ *
+ * No other thread may log while stopping.
+ *
+ */
+void otbrLogStopAsync(void);
+
 /**
  * This function deinitializes the logging service.
  *
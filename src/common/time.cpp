@@ -26,71 +26,87 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "event_emitter.hpp"
+/**
+ * This file implements the time source of the border router.
+ */
 
-#include <assert.h>
+#include "time.hpp"
 
 namespace ot {
 
 namespace BorderRouter {
 
-void EventEmitter::On(int aEvent, Callback aCallback, void *aContext)
+static uint64_t ToMicros(const timespec &aTime)
 {
-    assert(aCallback);
-
-    Handlers &handlers = mEvents[aEvent];
-
-    handlers.push_back(Handler(aCallback, aContext));
+    return static_cast<uint64_t>(aTime.tv_sec) * 1000000 + static_cast<uint64_t>(aTime.tv_nsec) / 1000;
 }
 
-void EventEmitter::Off(int aEvent, Callback aCallback, void *aContext)
+SystemClock::SystemClock(void)
+    : mCoarseClockId(CLOCK_MONOTONIC)
 {
-    assert(aCallback);
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec resolution;
 
-    if (!mEvents.count(aEvent))
+    if (clock_getres(CLOCK_MONOTONIC_COARSE, &resolution) == 0 && resolution.tv_sec == 0 &&
+        resolution.tv_nsec <= kMaxCoarseResolution * 1000)
     {
-        return;
+        mCoarseClockId = CLOCK_MONOTONIC_COARSE;
     }
+#endif
+}
 
-    Handler   handler  = Handler(aCallback, aContext);
-    Handlers &handlers = mEvents[aEvent];
+uint64_t SystemClock::GetMicros(void)
+{
+    timespec now;
 
-    for (Handlers::iterator it = handlers.begin(); it != handlers.end(); ++it)
-    {
-        if (*it == handler)
-        {
-            handlers.erase(it);
-            if (handlers.empty())
-            {
-                mEvents.erase(aEvent);
-            }
-            break;
-        }
-    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ToMicros(now);
 }
 
-void EventEmitter::Emit(int aEvent, ...)
+uint64_t SystemClock::GetCoarseMicros(void)
 {
-    if (!mEvents.count(aEvent))
-    {
-        return;
-    }
+    timespec now;
 
-    va_list args;
-    va_start(args, aEvent);
-    Handlers &handlers = mEvents[aEvent];
+    clock_gettime(mCoarseClockId, &now);
+    return ToMicros(now);
+}
 
-    assert(!handlers.empty());
+static Clock *  sClock       = NULL;
+static uint64_t sCachedNow   = 0;
+static bool     sIsNowCached = false;
 
-    for (Handlers::iterator it = handlers.begin(); it != handlers.end(); ++it)
-    {
-        va_list tmpArgs;
-        va_copy(tmpArgs, args);
-        it->first(it->second, aEvent, tmpArgs);
-        va_end(tmpArgs);
-    }
+static Clock &GetClock(void)
+{
+    static SystemClock sSystemClock;
+
+    return sClock != NULL ? *sClock : sSystemClock;
+}
+
+void SetClock(Clock *aClock)
+{
+    sClock       = aClock;
+    sIsNowCached = false;
+}
+
+uint64_t GetNowMicros(void)
+{
+    return sIsNowCached ? sCachedNow : GetClock().GetMicros();
+}
 
-    va_end(args);
+uint64_t GetCoarseNowMicros(void)
+{
+    return GetClock().GetCoarseMicros();
+}
+
+void UpdateNow(void)
+{
+    sCachedNow   = GetClock().GetMicros();
+    sIsNowCached = true;
+}
+
+void ClearNow(void)
+{
+    sIsNowCached = false;
 }
 
 } // namespace BorderRouter
@@ -32,6 +32,7 @@
 #include <stdint.h>
 
 #include <sys/time.h>
+#include <time.h>
 
 namespace ot {
 
@@ -50,18 +51,151 @@ inline unsigned long GetTimestamp(const timeval &aTime)
     return static_cast<unsigned long>(aTime.tv_sec * 1000 + aTime.tv_usec / 1000);
 }
 
+/**
+ * This interface represents a monotonic clock.
+ *
+ */
+class Clock
+{
+public:
+    /**
+     * This method returns the current time of this clock.
+     *
+     * @returns Current time in microseconds.
+     *
+     */
+    virtual uint64_t GetMicros(void) = 0;
+
+    /**
+     * This method returns the current time of this clock, which may be cheaper but less precise.
+     *
+     * @returns Current time in microseconds.
+     *
+     */
+    virtual uint64_t GetCoarseMicros(void) { return GetMicros(); }
+
+    virtual ~Clock(void) {}
+};
+
+/**
+ * This class implements the clock based on CLOCK_MONOTONIC.
+ *
+ */
+class SystemClock : public Clock
+{
+public:
+    /**
+     * The constructor to initialize the system clock.
+     *
+     * CLOCK_MONOTONIC_COARSE is used for coarse readings if it is available with enough resolution.
+     *
+     */
+    SystemClock(void);
+
+    uint64_t GetMicros(void);
+    uint64_t GetCoarseMicros(void);
+
+private:
+    enum
+    {
+        kMaxCoarseResolution = 10000, ///< Max resolution of coarse readings in microseconds.
+    };
+
+    clockid_t mCoarseClockId;
+};
+
+/**
+ * This class implements a clock which only moves when told to, for deterministic tests and benchmarks.
+ *
+ */
+class FakeClock : public Clock
+{
+public:
+    /**
+     * The constructor to initialize a fake clock.
+     *
+     * @param[in]   aMicros     The initial time in microseconds.
+     *
+     */
+    explicit FakeClock(uint64_t aMicros = 0)
+        : mMicros(aMicros)
+    {
+    }
+
+    uint64_t GetMicros(void) { return mMicros; }
+
+    /**
+     * This method sets the current time of this clock.
+     *
+     * @param[in]   aMicros     The time in microseconds.
+     *
+     */
+    void SetMicros(uint64_t aMicros) { mMicros = aMicros; }
+
+    /**
+     * This method moves this clock forward.
+     *
+     * @param[in]   aMicros     The duration in microseconds.
+     *
+     */
+    void Advance(uint64_t aMicros) { mMicros += aMicros; }
+
+private:
+    uint64_t mMicros;
+};
+
+/**
+ * This method sets the clock used by the border router.
+ *
+ * @param[in]   aClock  A pointer to the clock, NULL to restore the system clock.
+ *
+ */
+void SetClock(Clock *aClock);
+
+/**
+ * This method returns the current timestamp in microseconds.
+ *
+ * While the mainloop is dispatching events, this is the time cached at the beginning of dispatching,
+ * so all components see the same time in one iteration.
+ *
+ * @returns Current timestamp in microseconds.
+ *
+ */
+uint64_t GetNowMicros(void);
+
+/**
+ * This method returns the current timestamp in microseconds, which is cheaper but less precise than
+ * GetNowMicros() and never cached.
+ *
+ * @returns Current timestamp in microseconds.
+ *
+ */
+uint64_t GetCoarseNowMicros(void);
+
+/**
+ * This method caches the current time, which is returned by GetNowMicros() until ClearNow() is called.
+ *
+ */
+void UpdateNow(void);
+
+/**
+ * This method clears the cached time, so GetNowMicros() reads the clock again.
+ *
+ */
+void ClearNow(void);
+
 /**
  * This method returns the current timestamp in miniseconds.
  *
+ * The timestamp is taken from the monotonic clock, so it is only meaningful relative to other timestamps
+ * and never jumps when the wall clock is adjusted.
+ *
  * @returns Current timestamp in miniseconds.
  *
  */
 inline unsigned long GetNow(void)
 {
-    timeval now;
-
-    gettimeofday(&now, NULL);
-    return static_cast<unsigned long>(now.tv_sec * 1000 + now.tv_usec / 1000);
+    return static_cast<unsigned long>(GetNowMicros() / 1000);
 }
 
 } // namespace BorderRouter
@@ -0,0 +1,248 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements batched UDP I/O.
+ */
+
+#include "common/udp_batch.hpp"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+UdpBatch::UdpBatch(size_t aBatchSize)
+    : mBatchSize(aBatchSize > kMaxBatchSize ? static_cast<size_t>(kMaxBatchSize) : (aBatchSize == 0 ? 1 : aBatchSize))
+    , mSendingCount(0)
+    , mReceiving(new Datagram[mBatchSize])
+    , mSending(new Datagram[mBatchSize])
+    , mControls(new Control[mBatchSize * 2])
+    , mHeaders(new mmsghdr[mBatchSize * 2])
+    , mIovecs(new iovec[mBatchSize * 2])
+{
+    memset(&mCounters, 0, sizeof(mCounters));
+}
+
+UdpBatch::~UdpBatch(void)
+{
+    delete[] mIovecs;
+    delete[] mHeaders;
+    delete[] mControls;
+    delete[] mSending;
+    delete[] mReceiving;
+}
+
+int UdpBatch::Receive(int aSocket)
+{
+    int rval;
+
+    for (size_t i = 0; i < mBatchSize; ++i)
+    {
+        struct msghdr &header = mHeaders[i].msg_hdr;
+
+        mIovecs[i].iov_base = mReceiving[i].mPacket;
+        mIovecs[i].iov_len  = sizeof(mReceiving[i].mPacket);
+
+        memset(&header, 0, sizeof(header));
+        header.msg_name       = &mReceiving[i].mPeerSock;
+        header.msg_namelen    = sizeof(mReceiving[i].mPeerSock);
+        header.msg_iov        = &mIovecs[i];
+        header.msg_iovlen     = 1;
+        header.msg_control    = mControls[i].mData;
+        header.msg_controllen = sizeof(mControls[i].mData);
+        mHeaders[i].msg_len   = 0;
+    }
+
+    rval = recvmmsg(aSocket, mHeaders, static_cast<unsigned int>(mBatchSize), MSG_DONTWAIT, NULL);
+
+    if (rval < 0)
+    {
+        VerifyOrExit(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+        ExitNow(rval = 0);
+    }
+
+    for (int i = 0; i < rval; ++i)
+    {
+        struct msghdr &header   = mHeaders[i].msg_hdr;
+        Datagram &     datagram = mReceiving[i];
+
+        datagram.mLength = static_cast<uint16_t>(mHeaders[i].msg_len);
+        memset(&datagram.mLocalSock, 0, sizeof(datagram.mLocalSock));
+
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != NULL; cmsg = CMSG_NXTHDR(&header, cmsg))
+        {
+            if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
+            {
+                const struct in6_pktinfo *pktinfo = reinterpret_cast<const struct in6_pktinfo *>(CMSG_DATA(cmsg));
+
+                datagram.mLocalSock.sin6_family   = AF_INET6;
+                datagram.mLocalSock.sin6_addr     = pktinfo->ipi6_addr;
+                datagram.mLocalSock.sin6_scope_id = pktinfo->ipi6_ifindex;
+                break;
+            }
+        }
+    }
+
+    if (rval > 0)
+    {
+        ++mCounters.mReceiveBatches;
+        mCounters.mReceivedDatagrams += static_cast<unsigned long>(rval);
+
+        if (static_cast<size_t>(rval) == mBatchSize)
+        {
+            ++mCounters.mFullReceiveBatches;
+        }
+    }
+
+exit:
+    return rval;
+}
+
+otbrError UdpBatch::Send(int                 aSocket,
+                         const uint8_t *     aBuffer,
+                         uint16_t            aLength,
+                         const sockaddr_in6 &aPeerSock,
+                         const sockaddr_in6 *aLocalSock)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    Datagram *datagram;
+
+    VerifyOrExit(aLength <= kMaxSizeOfPacket, error = OTBR_ERROR_ERRNO; errno = EMSGSIZE);
+
+    if (mSendingCount == mBatchSize)
+    {
+        Flush(aSocket);
+    }
+
+    datagram = &mSending[mSendingCount];
+    memcpy(datagram->mPacket, aBuffer, aLength);
+    datagram->mLength   = aLength;
+    datagram->mPeerSock = aPeerSock;
+
+    if (aLocalSock != NULL)
+    {
+        datagram->mLocalSock = *aLocalSock;
+    }
+    else
+    {
+        memset(&datagram->mLocalSock, 0, sizeof(datagram->mLocalSock));
+    }
+
+    PrepareSending(mSendingCount);
+    ++mSendingCount;
+
+exit:
+    return error;
+}
+
+void UdpBatch::PrepareSending(size_t aIndex)
+{
+    Datagram &      datagram = mSending[aIndex];
+    struct mmsghdr &mmsg     = mHeaders[mBatchSize + aIndex];
+    struct msghdr & header   = mmsg.msg_hdr;
+    struct iovec &  iov      = mIovecs[mBatchSize + aIndex];
+    Control &       control  = mControls[mBatchSize + aIndex];
+
+    iov.iov_base = datagram.mPacket;
+    iov.iov_len  = datagram.mLength;
+
+    memset(&header, 0, sizeof(header));
+    header.msg_name    = &datagram.mPeerSock;
+    header.msg_namelen = sizeof(datagram.mPeerSock);
+    header.msg_iov     = &iov;
+    header.msg_iovlen  = 1;
+    mmsg.msg_len       = 0;
+
+    // Send from the given address, which is needed for sockets bound to any address.
+    if (datagram.mLocalSock.sin6_family == AF_INET6 && !IN6_IS_ADDR_UNSPECIFIED(&datagram.mLocalSock.sin6_addr))
+    {
+        struct cmsghdr *    cmsg;
+        struct in6_pktinfo *pktinfo;
+
+        memset(control.mData, 0, sizeof(control.mData));
+        header.msg_control    = control.mData;
+        header.msg_controllen = CMSG_SPACE(sizeof(struct in6_pktinfo));
+
+        cmsg                  = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level      = IPPROTO_IPV6;
+        cmsg->cmsg_type       = IPV6_PKTINFO;
+        cmsg->cmsg_len        = CMSG_LEN(sizeof(struct in6_pktinfo));
+        pktinfo               = reinterpret_cast<struct in6_pktinfo *>(CMSG_DATA(cmsg));
+        pktinfo->ipi6_addr    = datagram.mLocalSock.sin6_addr;
+        pktinfo->ipi6_ifindex = datagram.mLocalSock.sin6_scope_id;
+    }
+}
+
+otbrError UdpBatch::Flush(int aSocket)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    size_t    sent  = 0;
+
+    while (sent < mSendingCount)
+    {
+        int rval = sendmmsg(aSocket, &mHeaders[mBatchSize + sent], static_cast<unsigned int>(mSendingCount - sent),
+                            MSG_DONTWAIT);
+
+        ++mCounters.mSendBatches;
+
+        if (rval < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Datagrams may be dropped as on the network, so drop the failing one and go on.
+            otbrLog(OTBR_LOG_WARNING, "Failed to send UDP datagram: %s", strerror(errno));
+            error = OTBR_ERROR_ERRNO;
+            ++mCounters.mSendErrors;
+            ++sent;
+        }
+        else
+        {
+            mCounters.mSentDatagrams += static_cast<unsigned long>(rval);
+            sent += static_cast<size_t>(rval);
+        }
+    }
+
+    mSendingCount = 0;
+
+    return error;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
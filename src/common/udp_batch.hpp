@@ -0,0 +1,202 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for batched UDP I/O.
+ */
+
+#ifndef UDP_BATCH_HPP_
+#define UDP_BATCH_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * This class implements batched UDP receiving and sending over a pool of packet buffers.
+ *
+ * Up to a batch of datagrams are drained from a socket with one recvmmsg(), and outbound datagrams are queued and
+ * sent with one sendmmsg(). The buffers are allocated once, so no allocation happens per packet.
+ *
+ */
+class UdpBatch
+{
+public:
+    enum
+    {
+        kMaxSizeOfPacket = 1500, ///< Max size of packet in bytes.
+        kMaxBatchSize    = 32,   ///< Max number of datagrams in a batch.
+        kDefaultSize     = 16,   ///< Default number of datagrams in a batch.
+    };
+
+    /**
+     * This structure represents a datagram in the buffer pool.
+     *
+     */
+    struct Datagram
+    {
+        uint8_t      mPacket[kMaxSizeOfPacket]; ///< The payload.
+        uint16_t     mLength;                   ///< Length of the payload.
+        sockaddr_in6 mPeerSock;                 ///< The source on receiving, or the destination on sending.
+        sockaddr_in6 mLocalSock;                ///< The destination on receiving, or the source on sending.
+    };
+
+    /**
+     * This structure represents the counters of batched I/O.
+     *
+     */
+    struct Counters
+    {
+        unsigned long mReceiveBatches;     ///< Number of receiving system calls which returned datagrams.
+        unsigned long mReceivedDatagrams;  ///< Number of datagrams received.
+        unsigned long mFullReceiveBatches; ///< Number of receiving batches which filled all buffers.
+        unsigned long mSendBatches;        ///< Number of sending system calls.
+        unsigned long mSentDatagrams;      ///< Number of datagrams sent.
+        unsigned long mSendErrors;         ///< Number of datagrams failed to send.
+    };
+
+    /**
+     * The constructor to initialize a batch.
+     *
+     * @param[in]   aBatchSize  The max number of datagrams per batch, at most kMaxBatchSize.
+     *
+     */
+    explicit UdpBatch(size_t aBatchSize = kDefaultSize);
+
+    ~UdpBatch(void);
+
+    /**
+     * This method receives up to a batch of datagrams without blocking.
+     *
+     * The received datagrams are valid until the next call to this method.
+     *
+     * @param[in]   aSocket     The UDP socket.
+     *
+     * @returns The number of datagrams received, a negative value indicates failure and errno is set.
+     *
+     */
+    int Receive(int aSocket);
+
+    /**
+     * This method returns a received datagram.
+     *
+     * @param[in]   aIndex      The index of the datagram, less than the return value of Receive().
+     *
+     * @returns A reference to the datagram.
+     *
+     */
+    const Datagram &GetReceived(size_t aIndex) const { return mReceiving[aIndex]; }
+
+    /**
+     * This method queues a datagram to be sent.
+     *
+     * If the queue is full, queued datagrams are flushed first.
+     *
+     * @param[in]   aSocket     The UDP socket.
+     * @param[in]   aBuffer     A pointer to the payload.
+     * @param[in]   aLength     Number of bytes of @p aBuffer.
+     * @param[in]   aPeerSock   The destination.
+     * @param[in]   aLocalSock  A pointer to the source address, NULL to let the kernel choose.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully queued.
+     * @retval  OTBR_ERROR_ERRNO    Failed to queue, error code is stored in errno.
+     *
+     */
+    otbrError Send(int                 aSocket,
+                   const uint8_t *     aBuffer,
+                   uint16_t            aLength,
+                   const sockaddr_in6 &aPeerSock,
+                   const sockaddr_in6 *aLocalSock);
+
+    /**
+     * This method sends all queued datagrams.
+     *
+     * @param[in]   aSocket     The UDP socket.
+     *
+     * @retval  OTBR_ERROR_NONE     All queued datagrams are sent or dropped.
+     * @retval  OTBR_ERROR_ERRNO    Some datagrams failed to send, error code is stored in errno.
+     *
+     */
+    otbrError Flush(int aSocket);
+
+    /**
+     * This method indicates whether there are datagrams queued for sending.
+     *
+     * @retval  true    There are queued datagrams.
+     * @retval  false   There is no queued datagram.
+     *
+     */
+    bool HasPending(void) const { return mSendingCount > 0; }
+
+    /**
+     * This method returns the counters of this batch.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    enum
+    {
+        kMaxSizeOfControl = 64, ///< Max size of control message in bytes.
+    };
+
+    struct Control
+    {
+        uint8_t mData[kMaxSizeOfControl];
+    };
+
+    UdpBatch(const UdpBatch &);
+    UdpBatch &operator=(const UdpBatch &);
+
+    void PrepareSending(size_t aIndex);
+
+    size_t          mBatchSize;
+    size_t          mSendingCount;
+    Datagram *      mReceiving;
+    Datagram *      mSending;
+    Control *       mControls;
+    struct mmsghdr *mHeaders;
+    struct iovec *  mIovecs;
+    Counters        mCounters;
+};
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif // UDP_BATCH_HPP_
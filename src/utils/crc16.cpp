@@ -35,30 +35,75 @@
 
 namespace ot {
 
+namespace {
+
+/**
+ * This structure holds the lookup tables of a polynomial.
+ *
+ * Table k maps a byte to the CRC of that byte followed by k zero bytes.
+ *
+ */
+struct Crc16Tables
+{
+    explicit Crc16Tables(uint16_t aPolynomial)
+    {
+        for (uint16_t byte = 0; byte < 256; byte++)
+        {
+            uint16_t crc = static_cast<uint16_t>(byte << 8);
+
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>(static_cast<uint16_t>(crc << 1) ^ aPolynomial)
+                                     : static_cast<uint16_t>(crc << 1);
+            }
+
+            mTables[0][byte] = crc;
+        }
+
+        for (size_t table = 1; table < sizeof(mTables) / sizeof(mTables[0]); table++)
+        {
+            for (uint16_t byte = 0; byte < 256; byte++)
+            {
+                uint16_t crc = mTables[table - 1][byte];
+
+                mTables[table][byte] = static_cast<uint16_t>(crc << 8) ^ mTables[0][crc >> 8];
+            }
+        }
+    }
+
+    uint16_t mTables[8][256];
+};
+
+} // namespace
+
 Crc16::Crc16(Polynomial aPolynomial)
+    : mTables(GetTables(aPolynomial))
 {
-    mPolynomial = static_cast<uint16_t>(aPolynomial);
     Init();
 }
 
-void Crc16::Update(uint8_t aByte)
+const Crc16::Tables &Crc16::GetTables(Polynomial aPolynomial)
 {
-    uint8_t i;
+    static const Crc16Tables sCcitt(kCcitt);
+    static const Crc16Tables sAnsi(kAnsi);
 
-    mCrc = mCrc ^ static_cast<uint16_t>(aByte << 8);
-    i    = 8;
+    return aPolynomial == kCcitt ? sCcitt.mTables : sAnsi.mTables;
+}
 
-    do
+void Crc16::Update(const uint8_t *aBuffer, size_t aLength)
+{
+    for (; aLength >= kNumTables; aBuffer += kNumTables, aLength -= kNumTables)
     {
-        if (mCrc & 0x8000)
-        {
-            mCrc = static_cast<uint16_t>(mCrc << 1) ^ mPolynomial;
-        }
-        else
-        {
-            mCrc = static_cast<uint16_t>(mCrc << 1);
-        }
-    } while (--i);
+        // The CRC register is folded into the first two bytes.
+        mCrc = mTables[7][(mCrc >> 8) ^ aBuffer[0]] ^ mTables[6][(mCrc & 0xff) ^ aBuffer[1]] ^
+               mTables[5][aBuffer[2]] ^ mTables[4][aBuffer[3]] ^ mTables[3][aBuffer[4]] ^ mTables[2][aBuffer[5]] ^
+               mTables[1][aBuffer[6]] ^ mTables[0][aBuffer[7]];
+    }
+
+    while (aLength--)
+    {
+        Update(*aBuffer++);
+    }
 }
 
 } // namespace ot
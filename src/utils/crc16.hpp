@@ -34,6 +34,7 @@
 #ifndef CRC16_HPP_
 #define CRC16_HPP_
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace ot {
@@ -41,6 +42,8 @@ namespace ot {
 /**
  * This class implements CRC16 computations.
  *
+ * The CRC is computed with lookup tables, eight bytes at a time when feeding a buffer (slice-by-8).
+ *
  */
 class Crc16
 {
@@ -65,13 +68,22 @@ public:
      */
     void Init(void) { mCrc = 0; }
 
-    /*c*
+    /**
      * This method feeds a byte value into the CRC16 computation.
      *
      * @param[in]  aByte  The byte value.
      *
      */
-    void Update(uint8_t aByte);
+    void Update(uint8_t aByte) { mCrc = static_cast<uint16_t>(mCrc << 8) ^ mTables[0][(mCrc >> 8) ^ aByte]; }
+
+    /**
+     * This method feeds a buffer into the CRC16 computation.
+     *
+     * @param[in]  aBuffer  A pointer to the buffer.
+     * @param[in]  aLength  The length of the buffer in bytes.
+     *
+     */
+    void Update(const uint8_t *aBuffer, size_t aLength);
 
     /**
      * This method gets the current CRC16 value.
@@ -82,8 +94,17 @@ public:
     uint16_t Get(void) const { return mCrc; }
 
 private:
-    uint16_t mPolynomial;
-    uint16_t mCrc;
+    enum
+    {
+        kNumTables = 8, ///< Number of tables of slice-by-8.
+    };
+
+    typedef uint16_t Tables[kNumTables][256];
+
+    static const Tables &GetTables(Polynomial aPolynomial);
+
+    const Tables &mTables;
+    uint16_t      mCrc;
 };
 
 } // namespace ot
@@ -33,12 +33,140 @@
 
 #include "pskc.hpp"
 
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <mbedtls/aes.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/sha256.h>
+
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
 
 namespace ot {
 namespace Psk {
 
+namespace {
+
+enum
+{
+    kBlockSize = 16, ///< AES block size.
+};
+
+/**
+ * This class implements AES-CMAC-PRF-128 as defined in RFC 4615, with the key schedule and subkeys expanded once.
+ *
+ */
+class CmacPrf
+{
+public:
+    CmacPrf(const uint8_t *aKey, size_t aKeyLength)
+    {
+        uint8_t key[kBlockSize];
+
+        mbedtls_aes_init(&mAes);
+
+        if (aKeyLength == kBlockSize)
+        {
+            memcpy(key, aKey, sizeof(key));
+        }
+        else
+        {
+            // A key of other length is reduced with AES-CMAC under the zero key.
+            memset(key, 0, sizeof(key));
+            SetKey(key);
+            Compute(aKey, aKeyLength, key);
+        }
+
+        SetKey(key);
+        mbedtls_platform_zeroize(key, sizeof(key));
+    }
+
+    ~CmacPrf(void)
+    {
+        mbedtls_aes_free(&mAes);
+        mbedtls_platform_zeroize(mSubkey1, sizeof(mSubkey1));
+        mbedtls_platform_zeroize(mSubkey2, sizeof(mSubkey2));
+    }
+
+    void Compute(const uint8_t *aMessage, size_t aLength, uint8_t *aOutput)
+    {
+        uint8_t block[kBlockSize];
+
+        memset(block, 0, sizeof(block));
+
+        for (; aLength > kBlockSize; aMessage += kBlockSize, aLength -= kBlockSize)
+        {
+            Xor(block, aMessage, kBlockSize);
+            mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, block, block);
+        }
+
+        Xor(block, aMessage, aLength);
+
+        if (aLength == kBlockSize)
+        {
+            Xor(block, mSubkey1, kBlockSize);
+        }
+        else
+        {
+            block[aLength] ^= 0x80;
+            Xor(block, mSubkey2, kBlockSize);
+        }
+
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, block, aOutput);
+    }
+
+    /**
+     * This method computes the PRF of a single complete block in place, which costs one block encryption.
+     *
+     */
+    void ComputeBlock(uint8_t *aBlock)
+    {
+        Xor(aBlock, mSubkey1, kBlockSize);
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, aBlock, aBlock);
+    }
+
+    static void Xor(uint8_t *aBlock, const uint8_t *aOther, size_t aLength)
+    {
+        for (size_t i = 0; i < aLength; ++i)
+        {
+            aBlock[i] ^= aOther[i];
+        }
+    }
+
+private:
+    void SetKey(const uint8_t *aKey)
+    {
+        memset(mSubkey1, 0, sizeof(mSubkey1));
+        mbedtls_aes_setkey_enc(&mAes, aKey, kBlockSize * 8);
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, mSubkey1, mSubkey1);
+        DoubleSubkey(mSubkey1);
+        memcpy(mSubkey2, mSubkey1, sizeof(mSubkey2));
+        DoubleSubkey(mSubkey2);
+    }
+
+    static void DoubleSubkey(uint8_t *aSubkey)
+    {
+        uint8_t carry = (aSubkey[0] & 0x80) ? 0x87 : 0;
+
+        for (size_t i = 0; i < kBlockSize - 1; ++i)
+        {
+            aSubkey[i] = static_cast<uint8_t>((aSubkey[i] << 1) | (aSubkey[i + 1] >> 7));
+        }
+
+        aSubkey[kBlockSize - 1] = static_cast<uint8_t>((aSubkey[kBlockSize - 1] << 1) ^ carry);
+    }
+
+    mbedtls_aes_context mAes;
+    uint8_t             mSubkey1[kBlockSize];
+    uint8_t             mSubkey2[kBlockSize];
+};
+
+} // namespace
+
 void Pskc::SetSalt(const uint8_t *aExtPanId, const char *aNetworkName)
 {
     const char *saltPrefix = "Thread";
@@ -68,51 +196,213 @@ exit:
 
 const uint8_t *Pskc::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
 {
-    uint32_t blockCounter = 0;
-    uint16_t useLen       = 0;
-    uint16_t prfBlockLen  = MBEDTLS_CIPHER_BLKSIZE_MAX;
-    uint8_t  prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
-    uint8_t  prfOutput[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint8_t  keyBlock[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint16_t keyLen = OT_PSKC_LENGTH;
-    uint8_t *pskc   = mPskc;
+    CmacPrf prf(reinterpret_cast<const uint8_t *>(aPassphrase), strlen(aPassphrase));
+    uint8_t prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
+    uint8_t prfOutput[kBlockSize];
+
+    // The PSKc is as long as one PRF block, so only the first block of PBKDF2 is computed.
+    static_assert(OT_PSKC_LENGTH == kBlockSize, "PSKc must be one AES-CMAC-PRF-128 block");
 
     SetSalt(aExtPanId, aNetworkName);
 
-    while (keyLen)
+    memcpy(prfInput, mSalt, mSaltLen);
+    prfInput[mSaltLen + 0] = 0;
+    prfInput[mSaltLen + 1] = 0;
+    prfInput[mSaltLen + 2] = 0;
+    prfInput[mSaltLen + 3] = 1;
+
+    // Calculate U_1
+    prf.Compute(prfInput, mSaltLen + 4U, prfOutput);
+    memcpy(mPskc, prfOutput, sizeof(mPskc));
+
+    for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
     {
-        memcpy(prfInput, mSalt, mSaltLen);
+        // Calculate U_i
+        prf.ComputeBlock(prfOutput);
+        CmacPrf::Xor(mPskc, prfOutput, sizeof(mPskc));
+    }
 
-        blockCounter++;
-        prfInput[mSaltLen + 0] = (uint8_t)(blockCounter >> 24);
-        prfInput[mSaltLen + 1] = (uint8_t)(blockCounter >> 16);
-        prfInput[mSaltLen + 2] = (uint8_t)(blockCounter >> 8);
-        prfInput[mSaltLen + 3] = (uint8_t)(blockCounter);
-        // Calculate U_1
-        mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase), strlen(aPassphrase), prfInput,
-                                 mSaltLen + 4, prfOutput);
-        memcpy(keyBlock, prfOutput, prfBlockLen);
+    mbedtls_platform_zeroize(prfOutput, sizeof(prfOutput));
 
-        for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
-        {
-            memcpy(prfInput, prfOutput, prfBlockLen);
+    return mPskc;
+}
+
+PskcEngine::PskcEngine(size_t aCacheCapacity, unsigned aThreads)
+    : mCapacity(aCacheCapacity)
+    , mThreads(aThreads)
+{
+    if (mThreads == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        mThreads = cpus > 0 ? static_cast<unsigned>(cpus) : 1;
+    }
 
-            // Calculate U_i
-            mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase), strlen(aPassphrase), prfInput,
-                                     prfBlockLen, prfOutput);
+    memset(&mCounters, 0, sizeof(mCounters));
+}
 
-            // xor
-            for (uint32_t j = 0; j < prfBlockLen; j++)
+std::string PskcEngine::MakeKey(const PskcRequest &aRequest)
+{
+    mbedtls_sha256_context sha256;
+    unsigned char          digest[kSizeKey];
+
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts_ret(&sha256, 0);
+    mbedtls_sha256_update_ret(&sha256, aRequest.mExtPanId, sizeof(aRequest.mExtPanId));
+    // The null character separates the network name from the passphrase.
+    mbedtls_sha256_update_ret(&sha256, reinterpret_cast<const unsigned char *>(aRequest.mNetworkName),
+                              strlen(aRequest.mNetworkName) + 1);
+    mbedtls_sha256_update_ret(&sha256, reinterpret_cast<const unsigned char *>(aRequest.mPassphrase),
+                              strlen(aRequest.mPassphrase));
+    mbedtls_sha256_finish_ret(&sha256, digest);
+    mbedtls_sha256_free(&sha256);
+
+    return std::string(reinterpret_cast<const char *>(digest), sizeof(digest));
+}
+
+bool PskcEngine::Lookup(const std::string &aKey, uint8_t *aPskc)
+{
+    bool                       found = false;
+    EntryIndex::const_iterator it    = mIndex.find(aKey);
+
+    VerifyOrExit(it != mIndex.end());
+
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    memcpy(aPskc, it->second->mPskc, sizeof(it->second->mPskc));
+    ++mCounters.mHits;
+    found = true;
+
+exit:
+    return found;
+}
+
+void PskcEngine::Store(const std::string &aKey, const uint8_t *aPskc)
+{
+    EntryIndex::iterator it = mIndex.find(aKey);
+
+    VerifyOrExit(mCapacity > 0);
+
+    if (it != mIndex.end())
+    {
+        // The same network appeared twice in a batch.
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        ExitNow();
+    }
+
+    if (mEntries.size() >= mCapacity)
+    {
+        mIndex.erase(mEntries.back().mKey);
+        mEntries.pop_back();
+        ++mCounters.mEvictions;
+    }
+
+    mEntries.push_front(Entry());
+    mEntries.front().mKey = aKey;
+    memcpy(mEntries.front().mPskc, aPskc, sizeof(mEntries.front().mPskc));
+    mIndex[aKey] = mEntries.begin();
+
+exit:
+    return;
+}
+
+void PskcEngine::Clear(void)
+{
+    mIndex.clear();
+    mEntries.clear();
+}
+
+void *PskcEngine::RunBatch(void *aBatch)
+{
+    Batch &batch = *static_cast<Batch *>(aBatch);
+    Pskc   pskc;
+
+    for (size_t i = batch.mNext++; i < batch.mCount; i = batch.mNext++)
+    {
+        PskcRequest &request = batch.mRequests[batch.mPending[i]];
+
+        memcpy(request.mPskc, pskc.ComputePskc(request.mExtPanId, request.mNetworkName, request.mPassphrase),
+               sizeof(request.mPskc));
+    }
+
+    return NULL;
+}
+
+void PskcEngine::ComputePskc(PskcRequest *aRequests, size_t aCount)
+{
+    std::vector<std::string> keys(mCapacity > 0 ? aCount : 0);
+    std::vector<size_t>      pending;
+    std::vector<pthread_t>   threads;
+    Batch                    batch;
+
+    for (size_t i = 0; i < aCount; ++i)
+    {
+        if (mCapacity > 0)
+        {
+            keys[i] = MakeKey(aRequests[i]);
+
+            if (Lookup(keys[i], aRequests[i].mPskc))
             {
-                keyBlock[j] ^= prfOutput[j];
+                continue;
             }
         }
 
-        useLen = (keyLen < prfBlockLen) ? keyLen : prfBlockLen;
-        memcpy(pskc, keyBlock, useLen);
-        pskc += useLen;
-        keyLen -= useLen;
+        pending.push_back(i);
+    }
+
+    VerifyOrExit(!pending.empty());
+
+    batch.mRequests = aRequests;
+    batch.mPending  = pending.data();
+    batch.mCount    = pending.size();
+    batch.mNext     = 0;
+
+    // The calling thread computes as well.
+    for (size_t i = 1; i < mThreads && i < pending.size(); ++i)
+    {
+        pthread_t thread;
+        int       ret = pthread_create(&thread, NULL, RunBatch, &batch);
+
+        // pthread_create() returns the error rather than setting errno.
+        if (ret != 0)
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to create PSKc thread: %s", strerror(ret));
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    RunBatch(&batch);
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    mCounters.mMisses += pending.size();
+
+    if (mCapacity > 0)
+    {
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            Store(keys[pending[i]], aRequests[pending[i]].mPskc);
+        }
     }
+
+exit:
+    return;
+}
+
+const uint8_t *PskcEngine::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+{
+    PskcRequest request;
+
+    memcpy(request.mExtPanId, aExtPanId, sizeof(request.mExtPanId));
+    request.mNetworkName = aNetworkName;
+    request.mPassphrase  = aPassphrase;
+    ComputePskc(&request, 1);
+    memcpy(mPskc, request.mPskc, sizeof(mPskc));
+
     return mPskc;
 }
 
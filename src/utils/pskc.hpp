@@ -40,9 +40,15 @@
 #define OT_PBKDF2_SALT_MAX_LENGTH 30
 #define OT_PSKC_LENGTH 16
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+#include <atomic>
+#include <list>
+#include <string>
+#include <unordered_map>
+
 #include <mbedtls/cmac.h>
 
 namespace ot {
@@ -54,6 +60,13 @@ enum
     kPskcStatus_InvalidArgument = 1
 };
 
+/**
+ * This class implements the PSKc computation, PBKDF2 with AES-CMAC-PRF-128 as defined by Thread.
+ *
+ * The AES key schedule derived from the passphrase is expanded once per computation, so each of the iterations costs
+ * a single AES block encryption, which uses AES-NI when mbedtls is built with it and the CPU supports it.
+ *
+ */
 class Pskc
 {
 public:
@@ -77,6 +90,136 @@ private:
     uint8_t  mPskc[OT_PSKC_LENGTH];
 };
 
+/**
+ * This structure represents a PSKc computation of a batch.
+ *
+ */
+struct PskcRequest
+{
+    uint8_t     mExtPanId[OT_EXTENDED_PAN_ID_LENGTH]; ///< Extended PAN ID.
+    const char *mNetworkName;                         ///< Network name.
+    const char *mPassphrase;                          ///< Passphrase.
+    uint8_t     mPskc[OT_PSKC_LENGTH];                ///< The computed PSKc.
+};
+
+/**
+ * This class computes PSKc of many networks, spreading them over threads and keeping the results in an LRU cache.
+ *
+ * Cache entries are keyed by the SHA-256 digest of the inputs, so passphrases are not kept in memory.
+ * An engine must not be used by multiple threads at the same time.
+ *
+ */
+class PskcEngine
+{
+public:
+    enum
+    {
+        kDefaultCacheCapacity = 1024, ///< Default number of cached PSKc.
+    };
+
+    /**
+     * This structure represents the counters of a PSKc engine.
+     *
+     */
+    struct Counters
+    {
+        unsigned long mHits;      ///< Number of PSKc found in the cache.
+        unsigned long mMisses;    ///< Number of PSKc computed.
+        unsigned long mEvictions; ///< Number of PSKc dropped from the cache for lack of room.
+    };
+
+    /**
+     * The constructor to initialize a PSKc engine.
+     *
+     * @param[in]   aCacheCapacity  The max number of cached PSKc, 0 disables the cache.
+     * @param[in]   aThreads        The max number of threads computing a batch, 0 for the number of online CPUs.
+     *
+     */
+    PskcEngine(size_t aCacheCapacity = kDefaultCacheCapacity, unsigned aThreads = 0);
+
+    /**
+     * This method computes the PSKc of a network, or finds it in the cache.
+     *
+     * @param[in]   aExtPanId       A pointer to extended PAN ID.
+     * @param[in]   aNetworkName    A pointer to network name.
+     * @param[in]   aPassphrase     A pointer to passphrase.
+     *
+     * @returns The pointer to PSKc value, valid until the next call to this engine.
+     *
+     */
+    const uint8_t *ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase);
+
+    /**
+     * This method computes the PSKc of a batch of networks.
+     *
+     * PSKc not found in the cache are computed by up to the configured number of threads, the calling thread
+     * included.
+     *
+     * @param[inout]    aRequests   A pointer to the requests, whose mPskc are set on return.
+     * @param[in]       aCount      The number of requests.
+     *
+     */
+    void ComputePskc(PskcRequest *aRequests, size_t aCount);
+
+    /**
+     * This method drops all cached PSKc.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method returns the number of threads computing a batch.
+     *
+     * @returns The number of threads.
+     *
+     */
+    unsigned GetThreads(void) const { return mThreads; }
+
+    /**
+     * This method returns the counters of this engine.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    enum
+    {
+        kSizeKey = 32, ///< Size of SHA-256 digest.
+    };
+
+    struct Entry
+    {
+        std::string mKey;
+        uint8_t     mPskc[OT_PSKC_LENGTH];
+    };
+
+    typedef std::list<Entry>                                    EntryList;
+    typedef std::unordered_map<std::string, EntryList::iterator> EntryIndex;
+
+    struct Batch
+    {
+        PskcRequest *       mRequests;
+        const size_t *      mPending;
+        size_t              mCount;
+        std::atomic<size_t> mNext;
+    };
+
+    static std::string MakeKey(const PskcRequest &aRequest);
+    static void *      RunBatch(void *aBatch);
+
+    bool Lookup(const std::string &aKey, uint8_t *aPskc);
+    void Store(const std::string &aKey, const uint8_t *aPskc);
+
+    size_t     mCapacity;
+    unsigned   mThreads;
+    EntryList  mEntries;
+    EntryIndex mIndex;
+    Counters   mCounters;
+    uint8_t    mPskc[OT_PSKC_LENGTH];
+};
+
 } // namespace Psk
 } // namespace ot
 
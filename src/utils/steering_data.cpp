@@ -44,20 +44,37 @@ void SteeringData::Init(uint8_t aLength)
     Clear();
 }
 
-void SteeringData::ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId)
+void SteeringData::ComputeJoinerIds(const uint8_t *aEui64s, size_t aCount, uint8_t *aJoinerIds)
 {
-    const size_t           kSizeHashSha256Output = 32;
-    const size_t           kSizeEui64            = 8;
-    uint8_t                hash[kSizeHashSha256Output];
+    mbedtls_sha256_context initial;
     mbedtls_sha256_context sha256;
+    uint8_t                block[64];
 
-    mbedtls_sha256_init(&sha256);
-    mbedtls_sha256_starts(&sha256, 0);
-    mbedtls_sha256_update(&sha256, aEui64, kSizeEui64);
-    mbedtls_sha256_finish(&sha256, hash);
+    // An EUI64 fits in a single SHA-256 block, which is padded once and compressed directly.
+    memset(block, 0, sizeof(block));
+    block[kSizeEui64]        = 0x80;
+    block[sizeof(block) - 1] = kSizeEui64 * 8;
 
-    memcpy(aJoinerId, hash, kSizeJoinerId);
-    aJoinerId[0] |= 2;
+    mbedtls_sha256_init(&initial);
+    mbedtls_sha256_starts_ret(&initial, 0);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        uint8_t *joinerId = aJoinerIds + i * kSizeJoinerId;
+
+        memcpy(block, aEui64s + i * kSizeEui64, kSizeEui64);
+        memcpy(&sha256, &initial, sizeof(sha256));
+        mbedtls_internal_sha256_process(&sha256, block);
+
+        for (size_t j = 0; j < kSizeJoinerId; j++)
+        {
+            joinerId[j] = static_cast<uint8_t>(sha256.state[j / 4] >> (24 - (j % 4) * 8));
+        }
+
+        joinerId[0] |= 2;
+    }
+
+    mbedtls_sha256_free(&initial);
 }
 
 void SteeringData::ComputeBloomFilter(const uint8_t *aJoinerId)
@@ -66,15 +83,36 @@ void SteeringData::ComputeBloomFilter(const uint8_t *aJoinerId)
     Crc16          ansi(Crc16::kAnsi);
     const uint16_t numBits = mLength * 8;
 
-    for (size_t i = 0; i < kSizeJoinerId; i++)
-    {
-        uint8_t byte = aJoinerId[i];
-        ccitt.Update(byte);
-        ansi.Update(byte);
-    }
+    ccitt.Update(aJoinerId, kSizeJoinerId);
+    ansi.Update(aJoinerId, kSizeJoinerId);
 
     SetBit(static_cast<uint8_t>(ccitt.Get() % numBits));
     SetBit(static_cast<uint8_t>(ansi.Get() % numBits));
 }
 
+void SteeringData::AddJoiners(const uint8_t *aEui64s, size_t aCount)
+{
+    enum
+    {
+        kBatchSize = 64,
+    };
+
+    uint8_t joinerIds[kBatchSize * kSizeJoinerId];
+
+    while (aCount > 0)
+    {
+        size_t count = aCount < kBatchSize ? aCount : static_cast<size_t>(kBatchSize);
+
+        ComputeJoinerIds(aEui64s, count, joinerIds);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ComputeBloomFilter(joinerIds + i * kSizeJoinerId);
+        }
+
+        aEui64s += count * kSizeEui64;
+        aCount -= count;
+    }
+}
+
 } // namespace ot
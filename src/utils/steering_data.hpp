@@ -34,6 +34,7 @@
 #ifndef STEERING_DATA_HPP
 #define STEERING_DATA_HPP
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -50,6 +51,7 @@ public:
     {
         kMaxSizeOfBloomFilter = 16, ///< Max length of bloom filter in bytes.
         kSizeJoinerId         = 8,  ///< Size of Extended Joiner ID.
+        kSizeEui64            = 8,  ///< Size of EUI64.
     };
 
     /**
@@ -95,7 +97,27 @@ public:
      * @param[out]  aJoinerId   A pointer to receive joiner id. This pointer can be the same as @p aEui64.
      *
      */
-    static void ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId);
+    static void ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId) { ComputeJoinerIds(aEui64, 1, aJoinerId); }
+
+    /**
+     * This method computes joiner ids from EUI64s.
+     *
+     * @param[in]   aEui64s     A pointer to @p aCount contiguous EUI64s.
+     * @param[in]   aCount      The number of EUI64s.
+     * @param[out]  aJoinerIds  A pointer to receive @p aCount contiguous joiner ids. This pointer can be the same as
+     *                          @p aEui64s.
+     *
+     */
+    static void ComputeJoinerIds(const uint8_t *aEui64s, size_t aCount, uint8_t *aJoinerIds);
+
+    /**
+     * This method adds joiners to the bloom filter.
+     *
+     * @param[in]   aEui64s     A pointer to @p aCount contiguous EUI64s.
+     * @param[in]   aCount      The number of EUI64s.
+     *
+     */
+    void AddJoiners(const uint8_t *aEui64s, size_t aCount);
 
     /**
      * This method returns a pointer to the bloom filter.
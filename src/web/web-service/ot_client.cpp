@@ -4,6 +4,7 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <poll.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,30 +16,114 @@
 #include "platform-posix.h"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
 #include "utils/strcpy_utils.hpp"
 
 namespace ot {
 
+void ReplyParser::Reset(void)
+{
+    mScanned      = 0;
+    mLineStart    = 0;
+    mOutputOffset = 0;
+    mOutputLength = 0;
+    mStatusOffset = 0;
+    mReplyLength  = 0;
+    mHasOutput    = false;
+}
+
+ReplyParser::Result ReplyParser::Parse(const char *aBuffer, size_t aLength)
+{
+    static const char kCliPrompt[] = "> ";
+    static const char kDone[]      = "Done";
+    static const char kError[]     = "Error";
+    Result            result       = kResultPending;
+
+    while (result == kResultPending && mScanned < aLength)
+    {
+        const char *lineEnd   = static_cast<const char *>(memchr(aBuffer + mScanned, '\n', aLength - mScanned));
+        size_t      lineStart = mLineStart;
+        size_t      start     = mLineStart;
+        size_t      end;
+
+        if (lineEnd == NULL)
+        {
+            mScanned = aLength;
+            break;
+        }
+
+        end        = static_cast<size_t>(lineEnd - aBuffer);
+        mScanned   = end + 1;
+        mLineStart = mScanned;
+
+        while (end - start >= sizeof(kCliPrompt) - 1 && !memcmp(aBuffer + start, kCliPrompt, sizeof(kCliPrompt) - 1))
+        {
+            start += sizeof(kCliPrompt) - 1;
+        }
+
+        if (end > start && aBuffer[end - 1] == '\r')
+        {
+            --end;
+        }
+
+        if (end - start == sizeof(kDone) - 1 && !memcmp(aBuffer + start, kDone, sizeof(kDone) - 1))
+        {
+            result = kResultDone;
+        }
+        else if (end - start >= sizeof(kError) - 1 && !memcmp(aBuffer + start, kError, sizeof(kError) - 1))
+        {
+            result = kResultError;
+        }
+
+        // the output begins at the first line which is not blank
+        if (!mHasOutput && (end > start || result != kResultPending))
+        {
+            mOutputOffset = start;
+            mHasOutput    = true;
+        }
+
+        if (result == kResultPending)
+        {
+            continue;
+        }
+
+        // remove trailing \r\n of the output
+        while (lineStart > mOutputOffset && (aBuffer[lineStart - 1] == '\n' || aBuffer[lineStart - 1] == '\r'))
+        {
+            --lineStart;
+        }
+
+        mOutputLength = lineStart > mOutputOffset ? lineStart - mOutputOffset : 0;
+        mStatusOffset = start;
+        mReplyLength  = mScanned;
+    }
+
+    return result;
+}
+
 Client::Client(void)
-    : mTimeout(kDefaultTimeout)
+    : mLength(0)
+    , mConsumed(0)
+    , mPendingCount(0)
+    , mTimeout(kDefaultTimeout)
     , mSocket(-1)
 {
 }
 
 Client::~Client(void)
 {
-    if (mSocket != -1)
-    {
-        close(mSocket);
-    }
+    Disconnect();
 }
+
 bool Client::Connect(void)
 {
     struct sockaddr_un sockname;
-    int                ret;
+    int                ret = -1;
+
+    Disconnect();
 
     mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
-    VerifyOrExit(mSocket != -1, perror("socket"); ret = OT_EXIT_FAILURE);
+    VerifyOrExit(mSocket != -1, perror("socket"));
 
     memset(&sockname, 0, sizeof(struct sockaddr_un));
     sockname.sun_family = AF_UNIX;
@@ -49,86 +134,214 @@ bool Client::Connect(void)
     if (ret == -1)
     {
         otbrLog(OTBR_LOG_ERR, "OpenThread daemon is not running.");
+        Disconnect();
     }
 
 exit:
     return ret == 0;
 }
 
-char *Client::Execute(const char *aFormat, ...)
+void Client::Disconnect(void)
+{
+    if (mSocket != -1)
+    {
+        close(mSocket);
+        mSocket = -1;
+    }
+
+    mOutgoing.clear();
+    mLength       = 0;
+    mConsumed     = 0;
+    mPendingCount = 0;
+}
+
+bool Client::SendV(const char *aFormat, va_list aArgs)
+{
+    char command[kMaxCommandSize];
+    int  ret;
+    bool rval = false;
+
+    VerifyOrExit(mSocket != -1);
+
+    ret = vsnprintf(command, sizeof(command), aFormat, aArgs);
+    VerifyOrExit(ret >= 0, otbrLog(OTBR_LOG_ERR, "Failed to generate command: %s", strerror(errno)));
+    VerifyOrExit(static_cast<size_t>(ret) < sizeof(command),
+                 otbrLog(OTBR_LOG_ERR, "Command exceeds maximum limit: %d", kMaxCommandSize));
+
+    mOutgoing.append(command, static_cast<size_t>(ret));
+    mOutgoing.push_back('\n');
+    ++mPendingCount;
+    rval = true;
+
+exit:
+    return rval;
+}
+
+bool Client::Send(const char *aFormat, ...)
 {
     va_list args;
-    int     ret;
-    char *  rval = NULL;
-    ssize_t count;
-    size_t  rxLength = 0;
+    bool    rval;
 
     va_start(args, aFormat);
-    ret = vsnprintf(&mBuffer[1], sizeof(mBuffer) - 1, aFormat, args);
+    rval = SendV(aFormat, args);
     va_end(args);
 
-    if (ret < 0)
-    {
-        otbrLog(OTBR_LOG_ERR, "Failed to generate command: %s", strerror(errno));
-    }
+    return rval;
+}
 
-    mBuffer[0] = '\n';
-    ret++;
+bool Client::Flush(void)
+{
+    size_t sent = 0;
 
-    if (ret == sizeof(mBuffer))
+    while (sent < mOutgoing.size())
     {
-        otbrLog(OTBR_LOG_ERR, "Command exceeds maximum limit: %d", kBufferSize);
+        ssize_t count = send(mSocket, mOutgoing.data() + sent, mOutgoing.size() - sent, MSG_NOSIGNAL);
+
+        if (count == -1 && errno == EINTR)
+        {
+            continue;
+        }
+
+        VerifyOrExit(count > 0, otbrLog(OTBR_LOG_ERR, "Failed to send command: %s", strerror(errno)); Disconnect());
+        sent += static_cast<size_t>(count);
     }
 
-    mBuffer[ret] = '\n';
-    ret++;
+    mOutgoing.clear();
+
+exit:
+    return IsConnected();
+}
 
-    count = write(mSocket, mBuffer, ret);
+bool Client::WaitReadable(unsigned long aDeadline)
+{
+    bool rval = false;
 
-    if (count < ret)
+    while (!rval)
     {
-        mBuffer[ret] = '\0';
-        otbrLog(OTBR_LOG_ERR, "Failed to send command: %s", mBuffer);
+        struct pollfd pollFd    = {mSocket, POLLIN, 0};
+        long          remaining = static_cast<long>(aDeadline - BorderRouter::GetNow());
+        int           ret;
+
+        VerifyOrExit(remaining > 0, otbrLog(OTBR_LOG_ERR, "Timed out waiting for OpenThread daemon"));
+
+        ret = poll(&pollFd, 1, static_cast<int>(remaining));
+        VerifyOrExit(ret != -1 || errno == EINTR, otbrLog(OTBR_LOG_ERR, "Failed to poll: %s", strerror(errno)));
+        rval = (ret > 0);
     }
 
-    for (int i = 0; i < mTimeout; ++i)
+exit:
+    return rval;
+}
+
+char *Client::Receive(void)
+{
+    char *              rval = NULL;
+    ReplyParser::Result result;
+    unsigned long       deadline;
+
+    VerifyOrExit(mPendingCount > 0);
+    VerifyOrExit(Flush());
+
+    // drop the reply returned last time
+    mLength -= mConsumed;
+    memmove(mBuffer, mBuffer + mConsumed, mLength);
+    mConsumed = 0;
+
+    mParser.Reset();
+    deadline = BorderRouter::GetNow() + static_cast<unsigned long>(mTimeout);
+
+    while ((result = mParser.Parse(mBuffer, mLength)) == ReplyParser::kResultPending)
     {
-        fd_set  readFdSet;
-        timeval timeout = {0, 1000};
-        char *  done;
+        ssize_t count;
+
+        VerifyOrExit(mLength < kBufferSize, otbrLog(OTBR_LOG_ERR, "Reply exceeds maximum limit: %d", kBufferSize);
+                     Disconnect());
+        VerifyOrExit(WaitReadable(deadline), Disconnect());
 
-        FD_ZERO(&readFdSet);
-        FD_SET(mSocket, &readFdSet);
+        count = read(mSocket, mBuffer + mLength, kBufferSize - mLength);
 
-        ret = select(mSocket + 1, &readFdSet, NULL, NULL, &timeout);
-        VerifyOrExit(ret != -1 || errno == EINTR);
-        if (ret <= 0)
+        if (count == -1 && errno == EINTR)
         {
             continue;
         }
 
-        count = read(mSocket, &mBuffer[rxLength], sizeof(mBuffer) - rxLength);
-        VerifyOrExit(count > 0);
-        rxLength += count;
+        VerifyOrExit(count > 0, otbrLog(OTBR_LOG_ERR, "OpenThread daemon closed the connection"); Disconnect());
+        mLength += static_cast<size_t>(count);
+    }
+
+    --mPendingCount;
+    mConsumed = mParser.GetReplyLength();
+
+    if (result == ReplyParser::kResultDone)
+    {
+        rval                            = mBuffer + mParser.GetOutputOffset();
+        rval[mParser.GetOutputLength()] = '\0';
+    }
+    else
+    {
+        char *status = mBuffer + mParser.GetStatusOffset();
 
-        mBuffer[rxLength] = '\0';
-        done              = strstr(mBuffer, "Done\r\n");
+        mBuffer[mConsumed - 1]          = '\0';
+        status[strcspn(status, "\r\n")] = '\0';
+        otbrLog(OTBR_LOG_WARNING, "OpenThread command failed: %s", status);
+    }
+
+exit:
+    return rval;
+}
+
+char *Client::Execute(const char *aFormat, ...)
+{
+    va_list args;
+    bool    queued;
+    char *  rval = NULL;
 
-        if (done != NULL)
+    va_start(args, aFormat);
+    queued = SendV(aFormat, args);
+    va_end(args);
+
+    VerifyOrExit(queued);
+
+    // skip replies of commands sent earlier
+    while (mPendingCount > 1)
+    {
+        Receive();
+        VerifyOrExit(IsConnected());
+    }
+
+    rval = Receive();
+
+exit:
+    return rval;
+}
+
+bool Client::DiscardStaleInput(void)
+{
+    VerifyOrExit(mSocket != -1 && mPendingCount == 0);
+
+    for (;;)
+    {
+        ssize_t count = recv(mSocket, mBuffer, kBufferSize, MSG_DONTWAIT);
+
+        if (count > 0 || (count == -1 && errno == EINTR))
         {
-            // remove trailing \r\n
-            if (done - rval > 2)
-            {
-                done[-2] = '\0';
-            }
+            continue;
+        }
 
-            rval = mBuffer;
+        if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
             break;
         }
+
+        Disconnect();
+        break;
     }
 
+    mLength   = 0;
+    mConsumed = 0;
+
 exit:
-    return rval;
+    return IsConnected();
 }
 
 int Client::Scan(Dbus::WpanNetworkInfo *aNetworks, int aLength)
@@ -181,9 +394,8 @@ int Client::Scan(Dbus::WpanNetworkInfo *aNetworks, int aLength)
         ++rval;
     }
 
-    mTimeout = kDefaultTimeout;
-
 exit:
+    mTimeout = kDefaultTimeout;
     return rval;
 }
 
@@ -204,4 +416,65 @@ exit:
     return rval;
 }
 
+ClientPool::ClientPool(size_t aMaxIdle)
+    : mMaxIdle(aMaxIdle)
+{
+}
+
+ClientPool::~ClientPool(void)
+{
+    for (std::vector<Client *>::iterator it = mIdle.begin(); it != mIdle.end(); ++it)
+    {
+        delete *it;
+    }
+}
+
+Client *ClientPool::Acquire(void)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    Client *                     client = NULL;
+
+    while (!mIdle.empty())
+    {
+        client = mIdle.back();
+        mIdle.pop_back();
+
+        if (client->DiscardStaleInput())
+        {
+            ExitNow();
+        }
+
+        delete client;
+        client = NULL;
+    }
+
+    lock.unlock();
+
+    client = new Client();
+    VerifyOrExit(client->Connect(), delete client; client = NULL);
+
+exit:
+    return client;
+}
+
+void ClientPool::Release(Client *aClient)
+{
+    while (aClient->GetPendingCount() > 0)
+    {
+        aClient->Receive();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (aClient->IsConnected() && mIdle.size() < mMaxIdle)
+        {
+            mIdle.push_back(aClient);
+            aClient = NULL;
+        }
+    }
+
+    delete aClient;
+}
+
 } // namespace ot
@@ -28,13 +28,101 @@
 #ifndef OT_CLIENT_HPP_
 #define OT_CLIENT_HPP_
 
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <stdarg.h>
+#include <stddef.h>
+
 #include "../wpan-controller/wpan_controller.hpp"
 
 namespace ot {
 
+/**
+ * This class implements an incremental parser of OpenThread CLI replies.
+ *
+ * A reply is everything up to and including a line which is either "Done" or starts with "Error". Each call of Parse()
+ * only scans the bytes appended since the previous call.
+ *
+ */
+class ReplyParser
+{
+public:
+    /**
+     * This enumeration defines the parsing results.
+     *
+     */
+    enum Result
+    {
+        kResultPending, ///< The reply is not complete yet.
+        kResultDone,    ///< The reply ended with "Done".
+        kResultError,   ///< The reply ended with an "Error" line.
+    };
+
+    /**
+     * This constructor creates a parser waiting for a new reply.
+     *
+     */
+    ReplyParser(void) { Reset(); }
+
+    /**
+     * This method resets the parser to wait for a new reply.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method continues parsing the reply.
+     *
+     * @param[in]   aBuffer     A pointer to the beginning of the reply.
+     * @param[in]   aLength     Number of bytes received so far, including those passed in previous calls.
+     *
+     * @returns The parsing result.
+     *
+     */
+    Result Parse(const char *aBuffer, size_t aLength);
+
+    /**
+     * This method returns the offset of the command output, after any leading prompt.
+     *
+     */
+    size_t GetOutputOffset(void) const { return mOutputOffset; }
+
+    /**
+     * This method returns the length of the command output, without the status line and trailing line breaks.
+     *
+     */
+    size_t GetOutputLength(void) const { return mOutputLength; }
+
+    /**
+     * This method returns the offset of the status line, after any leading prompt.
+     *
+     */
+    size_t GetStatusOffset(void) const { return mStatusOffset; }
+
+    /**
+     * This method returns the length of the whole reply, including the status line.
+     *
+     */
+    size_t GetReplyLength(void) const { return mReplyLength; }
+
+private:
+    size_t mScanned;      ///< Number of bytes already scanned.
+    size_t mLineStart;    ///< Offset of the line being scanned.
+    size_t mOutputOffset; ///< Offset of the output.
+    size_t mOutputLength; ///< Length of the output.
+    size_t mStatusOffset; ///< Offset of the status line.
+    size_t mReplyLength;  ///< Length of the reply.
+    bool   mHasOutput;    ///< Whether the output offset has been located.
+};
+
 /**
  * This class implements functionality of OpenThread client.
  *
+ * Commands may be queued with Send() and written back to back, so the replies of several commands cost a single round
+ * trip. Replies are then taken in order with Receive().
+ *
  */
 class Client
 {
@@ -59,9 +147,59 @@ public:
      */
     bool Connect(void);
 
+    /**
+     * This method disconnects from OpenThread daemon and drops all queued commands and pending replies.
+     *
+     */
+    void Disconnect(void);
+
+    /**
+     * This method indicates whether the client is connected to OpenThread daemon.
+     *
+     */
+    bool IsConnected(void) const { return mSocket != -1; }
+
+    /**
+     * This method queues an OpenThread CLI command without waiting for its reply.
+     *
+     * @param[in]   aFormat     C style format string.
+     * @param[in]   ...         C style format arguments.
+     *
+     * @retval  true    Successfully queued the command.
+     * @retval  false   Failed to queue the command.
+     *
+     */
+    bool Send(const char *aFormat, ...);
+
+    /**
+     * This method writes all queued commands to OpenThread daemon.
+     *
+     * @retval  true    Successfully written the commands.
+     * @retval  false   Failed to write the commands, and the client is disconnected.
+     *
+     */
+    bool Flush(void);
+
+    /**
+     * This method waits for the reply of the earliest command still pending.
+     *
+     * Queued commands are flushed first.
+     *
+     * @note The output points into the receive buffer, which is compacted in place by the next call of Receive() or
+     *       Execute(). Copy it before that if it is still needed.
+     *
+     * @returns A pointer to the output if succeeded, otherwise NULL.
+     *
+     */
+    char *Receive(void);
+
     /**
      * This method executes OpenThread CLI.
      *
+     * Replies of previously sent commands that have not been received are discarded.
+     *
+     * @note As with Receive(), the output is invalid after the next call of Receive() or Execute().
+     *
      * @param[in]   aFormat     C style format string.
      * @param[in]   ...         C style format arguments.
      *
@@ -70,6 +208,21 @@ public:
      */
     char *Execute(const char *aFormat, ...);
 
+    /**
+     * This method returns the number of commands whose replies have not been received.
+     *
+     */
+    unsigned int GetPendingCount(void) const { return mPendingCount; }
+
+    /**
+     * This method discards input received while no command is pending, such as trailing prompts.
+     *
+     * @retval  true    The connection is still usable.
+     * @retval  false   The connection was closed by the daemon, and the client is disconnected.
+     *
+     */
+    bool DiscardStaleInput(void);
+
     /**
      * This method scans Thread network.
      *
@@ -90,13 +243,121 @@ public:
 private:
     enum
     {
-        kBufferSize     = 1024, ///< Maximum command line input and output buffer.
+        kMaxCommandSize = 1024, ///< Maximum command line input.
+        kBufferSize     = 4096, ///< Maximum output buffer.
         kDefaultTimeout = 800,  ///< Default timeout(ms) waiting for a command finish.
     };
 
-    char mBuffer[kBufferSize];
-    int  mTimeout; /// Timeout in milliseconds
-    int  mSocket;
+    bool SendV(const char *aFormat, va_list aArgs);
+    bool WaitReadable(unsigned long aDeadline);
+
+    ReplyParser  mParser;
+    std::string  mOutgoing;                ///< Commands queued but not written.
+    char         mBuffer[kBufferSize + 1]; ///< Received bytes, one more for the null terminator.
+    size_t       mLength;                  ///< Number of bytes in mBuffer.
+    size_t       mConsumed;                ///< Number of bytes of the reply last returned.
+    unsigned int mPendingCount;            ///< Number of commands waiting for reply.
+    int          mTimeout;                 /// Timeout in milliseconds
+    int          mSocket;
+};
+
+/**
+ * This class implements a pool of long-lived OpenThread client sessions.
+ *
+ */
+class ClientPool
+{
+public:
+    /**
+     * This constructor creates an empty pool.
+     *
+     * @param[in]   aMaxIdle    Maximum number of idle sessions kept open.
+     *
+     */
+    explicit ClientPool(size_t aMaxIdle = kDefaultMaxIdle);
+
+    /**
+     * This destructor closes all idle sessions.
+     *
+     */
+    ~ClientPool(void);
+
+    /**
+     * This method takes a connected session, reusing an idle one if it is still usable.
+     *
+     * @returns A pointer to the session, or NULL if failed to connect to OpenThread daemon.
+     *
+     */
+    Client *Acquire(void);
+
+    /**
+     * This method returns a session to the pool.
+     *
+     * Pending replies are received and discarded first so that the next user starts in sync.
+     *
+     * @param[in]   aClient     A pointer to the session taken by Acquire().
+     *
+     */
+    void Release(Client *aClient);
+
+private:
+    enum
+    {
+        kDefaultMaxIdle = 2, ///< Default number of idle sessions kept open.
+    };
+
+    std::mutex            mMutex;
+    std::vector<Client *> mIdle;
+    size_t                mMaxIdle;
+};
+
+/**
+ * This class takes a session from a pool for its lifetime.
+ *
+ */
+class PooledClient
+{
+public:
+    /**
+     * This constructor acquires a session from @p aPool.
+     *
+     */
+    explicit PooledClient(ClientPool &aPool)
+        : mPool(aPool)
+        , mClient(aPool.Acquire())
+    {
+    }
+
+    /**
+     * This destructor releases the session back to the pool.
+     *
+     */
+    ~PooledClient(void)
+    {
+        if (mClient != NULL)
+        {
+            mPool.Release(mClient);
+        }
+    }
+
+    /**
+     * This method indicates whether a session was acquired.
+     *
+     */
+    bool IsValid(void) const { return mClient != NULL; }
+
+    /**
+     * This method returns the acquired session.
+     *
+     */
+    Client *operator->(void) { return mClient; }
+
+private:
+    PooledClient(const PooledClient &);
+    PooledClient &operator=(const PooledClient &);
+
+    ClientPool &mPool;
+    Client *    mClient;
 };
 
 } // namespace ot
@@ -34,16 +34,18 @@
 #include "wpan_service.hpp"
 
 #include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include "ot_client.hpp"
 #include "common/code_utils.hpp"
+#include "utils/strcpy_utils.hpp"
 
 namespace ot {
 namespace Web {
 
-const char *WpanService::kBorderAgentHost = "127.0.0.1";
-const char *WpanService::kBorderAgentPort = "49191";
-
 std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinRequest)
 {
     Json::Value      root;
@@ -58,9 +60,9 @@ std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinReques
 #if OTBR_ENABLE_NCP_WPANTUND
     ot::Dbus::WPANController wpanController;
 #else
-    ot::Client client;
+    ot::PooledClient client(mClients);
 
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif
 
     VerifyOrExit(reader.parse(aJoinRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
@@ -87,19 +89,20 @@ std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinReques
         prefix += "/64";
     }
 
-    VerifyOrExit(client.FactoryReset(), ret = ot::Dbus::kWpantundStatus_LeaveFailed);
-    VerifyOrExit(client.Execute("masterkey %s", networkKey.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("networkname %s", mNetworks[index].mNetworkName) != NULL,
+    VerifyOrExit(client->FactoryReset(), ret = ot::Dbus::kWpantundStatus_LeaveFailed);
+    VerifyOrExit(client->Execute("masterkey %s", networkKey.c_str()) != NULL,
+                 ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("networkname %s", mNetworks[index].mNetworkName) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("channel %u", mNetworks[index].mChannel) != NULL,
+    VerifyOrExit(client->Execute("channel %u", mNetworks[index].mChannel) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("extpanid %016" PRIx64, mNetworks[index].mExtPanId) != NULL,
+    VerifyOrExit(client->Execute("extpanid %016" PRIx64, mNetworks[index].mExtPanId) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("panid %u", mNetworks[index].mPanId) != NULL,
+    VerifyOrExit(client->Execute("panid %u", mNetworks[index].mPanId) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("ifconfig up") != NULL, ret = ot::Dbus::kWpantundStatus_JoinFailed);
-    VerifyOrExit(client.Execute("thread start") != NULL, ret = ot::Dbus::kWpantundStatus_JoinFailed);
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
+    VerifyOrExit(client->Execute("ifconfig up") != NULL, ret = ot::Dbus::kWpantundStatus_JoinFailed);
+    VerifyOrExit(client->Execute("thread start") != NULL, ret = ot::Dbus::kWpantundStatus_JoinFailed);
+    VerifyOrExit(client->Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif // OTBR_ENABLE_NCP_WPANTUND
 exit:
@@ -138,9 +141,9 @@ std::string WpanService::HandleFormNetworkRequest(const std::string &aFormReques
 #if OTBR_ENABLE_NCP_WPANTUND
     ot::Dbus::WPANController wpanController;
 #else
-    ot::Client client;
+    ot::PooledClient client(mClients);
 
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif
 
     pskcStr[OT_PSKC_MAX_LENGTH * 2] = '\0'; // for manipulating with strlen
@@ -187,17 +190,18 @@ std::string WpanService::HandleFormNetworkRequest(const std::string &aFormReques
         prefix += "/64";
     }
 
-    VerifyOrExit(client.FactoryReset(), ret = ot::Dbus::kWpantundStatus_LeaveFailed);
-    VerifyOrExit(client.Execute("masterkey %s", networkKey.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("networkname %s", networkName.c_str()) != NULL,
+    VerifyOrExit(client->FactoryReset(), ret = ot::Dbus::kWpantundStatus_LeaveFailed);
+    VerifyOrExit(client->Execute("masterkey %s", networkKey.c_str()) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("channel %u", channel) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("extpanid %s", extPanId.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("panid %s", panId.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("pskc %s", pskcStr) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
-    VerifyOrExit(client.Execute("ifconfig up") != NULL, ret = ot::Dbus::kWpantundStatus_FormFailed);
-    VerifyOrExit(client.Execute("thread start") != NULL, ret = ot::Dbus::kWpantundStatus_FormFailed);
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
+    VerifyOrExit(client->Execute("networkname %s", networkName.c_str()) != NULL,
+                 ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("channel %u", channel) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("extpanid %s", extPanId.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("panid %s", panId.c_str()) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("pskc %s", pskcStr) != NULL, ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client->Execute("ifconfig up") != NULL, ret = ot::Dbus::kWpantundStatus_FormFailed);
+    VerifyOrExit(client->Execute("thread start") != NULL, ret = ot::Dbus::kWpantundStatus_FormFailed);
+    VerifyOrExit(client->Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif // OTBR_ENABLE_NCP_WPANTUND
 exit:
@@ -227,9 +231,9 @@ std::string WpanService::HandleAddPrefixRequest(const std::string &aAddPrefixReq
 #if OTBR_ENABLE_NCP_WPANTUND
     ot::Dbus::WPANController wpanController;
 #else
-    ot::Client client;
+    ot::PooledClient client(mClients);
 
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif
 
     VerifyOrExit(reader.parse(aAddPrefixRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
@@ -241,7 +245,7 @@ std::string WpanService::HandleAddPrefixRequest(const std::string &aAddPrefixReq
     VerifyOrExit(wpanController.AddGateway(prefix.c_str(), defaultRoute) == ot::Dbus::kWpantundStatus_Ok,
                  ret = ot::Dbus::kWpantundStatus_SetGatewayFailed);
 #else
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
+    VerifyOrExit(client->Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetGatewayFailed);
 #endif
 exit:
@@ -270,9 +274,9 @@ std::string WpanService::HandleDeletePrefixRequest(const std::string &aDeleteReq
 #if OTBR_ENABLE_NCP_WPANTUND
     ot::Dbus::WPANController wpanController;
 #else
-    ot::Client client;
+    ot::PooledClient client(mClients);
 
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_SetFailed);
 #endif
 
     VerifyOrExit(reader.parse(aDeleteRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
@@ -283,7 +287,7 @@ std::string WpanService::HandleDeletePrefixRequest(const std::string &aDeleteReq
     VerifyOrExit(wpanController.RemoveGateway(prefix.c_str()) == ot::Dbus::kWpantundStatus_Ok,
                  ret = ot::Dbus::kWpantundStatus_SetGatewayFailed);
 #else
-    VerifyOrExit(client.Execute("prefix remove %s", prefix.c_str()) != NULL,
+    VerifyOrExit(client->Execute("prefix remove %s", prefix.c_str()) != NULL,
                  ret = ot::Dbus::kWpantundStatus_SetGatewayFailed);
 #endif
 exit:
@@ -369,13 +373,19 @@ std::string WpanService::HandleStatusRequest()
         break;
     }
 #else
-    ot::Client client;
-    char *     rval;
+    ot::PooledClient client(mClients);
+    char *           rval;
 
     networkInfo["WPAN service"] = kWPANTUNDStateUninitialized;
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_SetFailed);
+
+    // send all queries back to back, so that their replies arrive in a single round trip
+    VerifyOrExit(client->Send("state") && client->Send("version") && client->Send("eui64") &&
+                     client->Send("channel") && client->Send("networkname") && client->Send("extpanid") &&
+                     client->Send("panid") && client->Send("dataset active") && client->Send("ipaddr"),
+                 ret = kWpanStatus_GetPropertyFailed);
 
-    VerifyOrExit((rval = client.Execute("state")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NCPState] = rval;
 
     if (!strcmp(rval, "disabled"))
@@ -393,25 +403,24 @@ std::string WpanService::HandleStatusRequest()
         networkInfo["WPAN service"] = kWPANTUNDStateAssociated;
     }
 
-    VerifyOrExit((rval = client.Execute("version")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    networkInfo[kWPANTUNDProperty_NetworkNodeType] = rval;
+
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NCPVersion] = rval;
 
-    VerifyOrExit((rval = client.Execute("eui64")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NCPHardwareAddress] = rval;
 
-    VerifyOrExit((rval = client.Execute("channel")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NCPChannel] = rval;
 
-    VerifyOrExit((rval = client.Execute("state")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo[kWPANTUNDProperty_NetworkNodeType] = rval;
-
-    VerifyOrExit((rval = client.Execute("networkname")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NetworkName] = rval;
 
-    VerifyOrExit((rval = client.Execute("extpanid")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NetworkXPANID] = rval;
 
-    VerifyOrExit((rval = client.Execute("panid")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+    VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
     networkInfo[kWPANTUNDProperty_NetworkPANID] = rval;
 
     {
@@ -419,7 +428,7 @@ std::string WpanService::HandleStatusRequest()
         static const char kMeshLocalAddressTokenLocator[] = "0:ff:fe00:";
         std::string       meshLocalPrefix;
 
-        VerifyOrExit((rval = client.Execute("dataset active")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+        VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
         rval = strstr(rval, kMeshLocalPrefixLocator);
         rval += sizeof(kMeshLocalPrefixLocator) - 1;
         *strstr(rval, "\r\n") = '\0';
@@ -429,7 +438,7 @@ std::string WpanService::HandleStatusRequest()
         meshLocalPrefix = rval;
         meshLocalPrefix.resize(meshLocalPrefix.find('/'));
 
-        VerifyOrExit((rval = client.Execute("ipaddr")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+        VerifyOrExit((rval = client->Receive()) != NULL, ret = kWpanStatus_GetPropertyFailed);
 
         for (rval = strtok(rval, "\r\n"); rval != NULL; rval = strtok(NULL, "\r\n"))
         {
@@ -488,10 +497,10 @@ std::string WpanService::HandleAvailableNetworkRequest()
     memcpy(mNetworks, wpanController.GetScanNetworksInfo(), mNetworksCount * sizeof(ot::Dbus::WpanNetworkInfo));
 
 #else
-    ot::Client client;
+    ot::PooledClient client(mClients);
 
-    VerifyOrExit(client.Connect(), ret = ot::Dbus::kWpantundStatus_ScanFailed);
-    VerifyOrExit((mNetworksCount = client.Scan(mNetworks, sizeof(mNetworks) / sizeof(mNetworks[0]))) > 0,
+    VerifyOrExit(client.IsValid(), ret = ot::Dbus::kWpantundStatus_ScanFailed);
+    VerifyOrExit((mNetworksCount = client->Scan(mNetworks, sizeof(mNetworks) / sizeof(mNetworks[0]))) > 0,
                  ret = ot::Dbus::kWpantundStatus_NetworkNotFound);
 #endif
 
@@ -556,11 +565,13 @@ int WpanService::GetWpanServiceStatus(std::string &aNetworkName, std::string &aE
         status = kWpanStatus_Uninitialized;
     }
 #else
-    ot::Client  client;
-    const char *rval;
+    ot::PooledClient client(mClients);
+    const char *     rval;
 
-    VerifyOrExit(client.Connect(), status = kWpanStatus_Uninitialized);
-    rval = client.Execute("state");
+    VerifyOrExit(client.IsValid(), status = kWpanStatus_Uninitialized);
+    VerifyOrExit(client->Send("state") && client->Send("networkname") && client->Send("extpanid"),
+                 status = kWpanStatus_Down);
+    rval = client->Receive();
     VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
     if (!strcmp(rval, "disabled"))
     {
@@ -572,11 +583,11 @@ int WpanService::GetWpanServiceStatus(std::string &aNetworkName, std::string &aE
     }
     else
     {
-        rval = client.Execute("networkname");
+        rval = client->Receive();
         VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
         aNetworkName = rval;
 
-        rval = client.Execute("extpanid");
+        rval = client->Receive();
         VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
         aExtPanId = rval;
     }
@@ -612,39 +623,25 @@ exit:
 
 std::string WpanService::CommissionDevice(const char *aPskd, const char *aNetworkPassword)
 {
-    int                            ret = ot::Dbus::kWpantundStatus_Ok;
-    Json::Value                    root, networkInfo;
-    Json::FastWriter               jsonWriter;
-    std::string                    response, networkName, extPanId, propertyValue;
-    BorderRouter::CommissionerArgs args;
-    int                            serviceStatus = GetWpanServiceStatus(networkName, extPanId);
+    int              ret = ot::Dbus::kWpantundStatus_Ok;
+    Json::Value      root, networkInfo;
+    Json::FastWriter jsonWriter;
+    std::string      response, networkName, extPanId, propertyValue;
+    uint8_t          pskcBin[OT_PSKC_MAX_LENGTH];
+    int              serviceStatus = GetWpanServiceStatus(networkName, extPanId);
 
     VerifyOrExit(serviceStatus == kWpanStatus_OK, ret = Dbus::kWpantundStatus_NetworkNotFound);
-    args.mPSKd = aPskd;
 
     {
         ot::Psk::Pskc pskc;
-        uint8_t       extPanIdHex[BorderRouter::kXPanIdLength];
+        uint8_t       extPanIdHex[kSizeExtPanId];
         VerifyOrExit(sizeof(extPanIdHex) == Utils::Hex2Bytes(extPanId.c_str(), extPanIdHex, sizeof(extPanIdHex)),
                      ret = Dbus::kWpantundStatus_Failure);
 
-        memcpy(args.mPSKc, pskc.ComputePskc(extPanIdHex, networkName.c_str(), aNetworkPassword), sizeof(args.mPSKc));
+        memcpy(pskcBin, pskc.ComputePskc(extPanIdHex, networkName.c_str(), aNetworkPassword), sizeof(pskcBin));
     }
 
-    // We allow all joiners for simplicity
-    {
-        int steeringLength = 1;
-        args.mSteeringData.Init(steeringLength);
-        args.mSteeringData.Set();
-    }
-
-    args.mKeepAliveInterval = 15;
-    args.mDebugLevel        = OTBR_LOG_EMERG;
-
-    args.mAgentHost = kBorderAgentHost;
-    args.mAgentPort = kBorderAgentPort;
-
-    RunCommission(args);
+    ret = RunCommission(aPskd, pskcBin);
 exit:
     root["error"] = ret;
     response      = jsonWriter.write(root);
@@ -652,53 +649,92 @@ exit:
     return response;
 }
 
-int WpanService::RunCommission(BorderRouter::CommissionerArgs aArgs)
+int WpanService::RunCommission(const char *aPskd, const uint8_t *aPskc)
 {
-    BorderRouter::Commissioner commissioner(aArgs.mPSKc, aArgs.mKeepAliveInterval);
-    bool                       joinerSetDone = false;
-    int                        ret;
-
-    commissioner.InitDtls(aArgs.mAgentHost, aArgs.mAgentPort);
+    int         ret     = Dbus::kWpantundStatus_Failure;
+    int         client  = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool        started = false;
+    char        pskc[OT_PSKC_MAX_LENGTH * 2 + 1];
+    char        command[kCommissionerCommandLength];
+    sockaddr_un sun;
+    std::string output;
+
+    VerifyOrExit(client != -1);
+
+    memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    strcpy_safe(sun.sun_path, sizeof(sun.sun_path), OTBR_COMMISSIONER_SOCKET_NAME);
+    VerifyOrExit(connect(client, reinterpret_cast<const sockaddr *>(&sun), sizeof(sun)) == 0,
+                 otbrLog(OTBR_LOG_ERR, "Commissioning service is not running."));
+
+    // The PSKc proves the network password, as it did for the DTLS session to the border agent.
+    Utils::Bytes2Hex(aPskc, OT_PSKC_MAX_LENGTH, pskc);
+
+    // The start is answered once the NCP is done petitioning.
+    started = true;
+    VerifyOrExit(ExecuteCommissioner(client, std::string("commissioner start ") + pskc, output,
+                                     kCommissionerPetitionWait),
+                 otbrLog(OTBR_LOG_ERR, "Commissioner petition failed."));
+
+    // The commissioning service stops the commissioner once the joiner times out.
+    snprintf(command, sizeof(command), "commissioner joiner add * %s %d", aPskd, kCommissionerJoinerTimeout);
+    VerifyOrExit(ExecuteCommissioner(client, command, output, kCommissionerReplyTimeout));
+    started = false;
+    ret     = Dbus::kWpantundStatus_Ok;
 
-    do
+exit:
+    if (started)
     {
-        ret = commissioner.TryDtlsHandshake();
-    } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+        // Do not leave the commissioner active, nor petitioning, with no joiner to commission.
+        ExecuteCommissioner(client, "commissioner stop", output, kCommissionerReplyTimeout);
+    }
 
-    if (commissioner.IsValid())
+    if (client != -1)
     {
-        commissioner.CommissionerPetition();
+        close(client);
     }
 
-    while (commissioner.IsValid() && commissioner.GetNumFinalizedJoiners() == 0)
-    {
-        int            maxFd   = -1;
-        struct timeval timeout = {10, 0};
-        int            rval;
+    return ret;
+}
+
+bool WpanService::ExecuteCommissioner(int aSocket, const std::string &aCommand, std::string &aOutput, int aTimeout)
+{
+    static const char kDone[] = "Done\r\n";
+    bool              ret     = false;
+    std::string       command = aCommand + "\n";
+    std::string       reply;
 
-        fd_set readFdSet;
-        fd_set writeFdSet;
-        fd_set errorFdSet;
+    VerifyOrExit(send(aSocket, command.c_str(), command.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(command.size()));
+
+    while (true)
+    {
+        fd_set  readFdSet;
+        timeval timeout = {aTimeout, 0};
+        char    buffer[128];
+        ssize_t count;
 
         FD_ZERO(&readFdSet);
-        FD_ZERO(&writeFdSet);
-        FD_ZERO(&errorFdSet);
-        commissioner.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
-        rval = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout);
-        if (rval < 0)
+        FD_SET(aSocket, &readFdSet);
+        VerifyOrExit(select(aSocket + 1, &readFdSet, NULL, NULL, &timeout) > 0);
+        VerifyOrExit((count = recv(aSocket, buffer, sizeof(buffer), 0)) > 0);
+        reply.append(buffer, static_cast<size_t>(count));
+
+        VerifyOrExit(reply.compare(0, 6, "Error ") != 0,
+                     otbrLog(OTBR_LOG_ERR, "%s: %s", aCommand.c_str(), reply.c_str()));
+
+        if (reply.size() >= sizeof(kDone) - 1 &&
+            reply.compare(reply.size() - (sizeof(kDone) - 1), std::string::npos, kDone) == 0)
         {
-            otbrLog(OTBR_LOG_ERR, "select() failed", strerror(errno));
+            // Strip "Done" and the line break of the output.
+            aOutput = reply.substr(0, reply.size() - (sizeof(kDone) - 1));
+            aOutput = aOutput.substr(0, aOutput.find("\r\n"));
+            ret     = true;
             break;
         }
-        commissioner.Process(readFdSet, writeFdSet, errorFdSet);
-        if (commissioner.IsCommissionerAccepted() && !joinerSetDone)
-        {
-            commissioner.SetJoiner(aArgs.mPSKd, aArgs.mSteeringData);
-            joinerSetDone = true;
-        }
     }
 
-    return commissioner.GetNumFinalizedJoiners();
+exit:
+    return ret;
 }
 
 } // namespace Web
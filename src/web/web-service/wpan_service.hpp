@@ -47,13 +47,13 @@
 
 #include "../utils/encoding.hpp"
 #include "../wpan-controller/wpan_controller.hpp"
+#include "ot_client.hpp"
+#include "agent/commissioner_server.hpp"
 #include "common/logging.hpp"
+#include "common/types.hpp"
 #include "utils/hex.hpp"
 #include "utils/pskc.hpp"
 
-#include "commissioner/commissioner.hpp"
-#include "commissioner/commissioner_argcargv.hpp"
-
 /**
  * WPAN parameter constants
  *
@@ -163,7 +163,9 @@ public:
     int GetWpanServiceStatus(std::string &aNetworkName, std::string &aExtPanId) const;
 
     /**
-     * This method starts commissioner and wait for a device to join
+     * This method starts commissioner and allows any device to join with the pskd
+     *
+     * The commissioning service of otbr-agent commissions through the NCP, the network password is only checked.
      *
      * @param[in]  aPskd                Joiner pskd
      * @param[in]  aNetworkPassword     Network password
@@ -174,7 +176,21 @@ public:
     std::string CommissionDevice(const char *aPskd, const char *aNetworkPassword);
 
 private:
-    int RunCommission(BorderRouter::CommissionerArgs aArgs);
+    /**
+     * This method has the commissioning service of otbr-agent petition and allow any joiner with the pskd.
+     *
+     * It returns once the joiner is allowed, not once it has joined. The commissioning service keeps the
+     * commissioner active for kCommissionerJoinerTimeout seconds, and stops it afterwards.
+     *
+     * @param[in]  aPskd    Joiner pskd
+     * @param[in]  aPskc    The PSKc of the network
+     *
+     * @retval  kWpantundStatus_Ok        The joiner is allowed.
+     * @retval  kWpantundStatus_Failure   Failed to petition or to allow the joiner, the commissioner is stopped.
+     *
+     */
+    int         RunCommission(const char *aPskd, const uint8_t *aPskc);
+    static bool ExecuteCommissioner(int aSocket, const std::string &aCommand, std::string &aOutput, int aTimeout);
 
     ot::Dbus::WpanNetworkInfo mNetworks[DBUS_MAXIMUM_NAME_LENGTH];
     int                       mNetworksCount;
@@ -185,6 +201,9 @@ private:
     const char *              mResponseFail    = "failed";
     const char *              mServiceUp       = "up";
     const char *              mServiceDown     = "down";
+#if !OTBR_ENABLE_NCP_WPANTUND
+    mutable ot::ClientPool    mClients; ///< Sessions to OpenThread daemon shared by requests.
+#endif
 
     enum
     {
@@ -203,8 +222,13 @@ private:
         kPropertyType_Data,
     };
 
-    static const char *kBorderAgentHost;
-    static const char *kBorderAgentPort;
+    enum
+    {
+        kCommissionerReplyTimeout  = 5,   ///< Seconds to wait for a reply of the commissioning service.
+        kCommissionerPetitionWait  = 30,  ///< Seconds to wait for the NCP to become the commissioner.
+        kCommissionerJoinerTimeout = 120, ///< Seconds to allow the joiner.
+        kCommissionerCommandLength = 128, ///< Max length of a command line of the commissioning service.
+    };
 };
 
 } // namespace Web
@@ -0,0 +1,233 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the benchmark of CoAP resource dispatch.
+ *
+ *   It registers the Thread URIs alone, and with generated ones up to 128 and 512 resources, and measures the cost of
+ *   finding the resource of a request with the trie router against a linear scan of Uri-Path, and the cost of a
+ *   whole request dispatched by the agent.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#include "agent/uris.hpp"
+#include "common/coap_native.hpp"
+
+using namespace ot::BorderRouter;
+
+enum
+{
+    kRounds = 1000000,
+};
+
+static const char *kThreadUris[] = {
+    OT_URI_PATH_ADDRESS_QUERY,
+    OT_URI_PATH_ADDRESS_NOTIFY,
+    OT_URI_PATH_ADDRESS_ERROR,
+    OT_URI_PATH_ADDRESS_RELEASE,
+    OT_URI_PATH_ADDRESS_SOLICIT,
+    OT_URI_PATH_ACTIVE_GET,
+    OT_URI_PATH_ACTIVE_SET,
+    OT_URI_PATH_DATASET_CHANGED,
+    OT_URI_PATH_ENERGY_SCAN,
+    OT_URI_PATH_ENERGY_REPORT,
+    OT_URI_PATH_PENDING_GET,
+    OT_URI_PATH_PENDING_SET,
+    OT_URI_PATH_SERVER_DATA,
+    OT_URI_PATH_ANNOUNCE_BEGIN,
+    OT_URI_PATH_RELAY_RX,
+    OT_URI_PATH_RELAY_TX,
+    OT_URI_PATH_JOINER_FINALIZE,
+    OT_URI_PATH_JOINER_ENTRUST,
+    OT_URI_PATH_LEADER_PETITION,
+    OT_URI_PATH_LEADER_KEEP_ALIVE,
+    OT_URI_PATH_PANID_CONFLICT,
+    OT_URI_PATH_PANID_QUERY,
+    OT_URI_PATH_COMMISSIONER_GET,
+    OT_URI_PATH_COMMISSIONER_SET,
+    OT_URI_PATH_COMMISSIONER_PETITION,
+    OT_URI_PATH_COMMISSIONER_KEEP_ALIVE,
+    OT_URI_PATH_DIAGNOSTIC_GET_REQUEST,
+    OT_URI_PATH_DIAGNOSTIC_GET_QUERY,
+    OT_URI_PATH_DIAGNOSTIC_GET_ANSWER,
+    OT_URI_PATH_DIAGNOSTIC_RESET,
+};
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static void HandleRequest(const Coap::Resource &aResource,
+                          const Coap::Message & aRequest,
+                          Coap::Message &       aResponse,
+                          const uint8_t *       aIp6,
+                          uint16_t              aPort,
+                          void *                aContext)
+{
+    ++*static_cast<unsigned long *>(aContext);
+    aResponse.SetCode(Coap::kCodeChanged);
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static ssize_t DiscardResponse(const uint8_t *aBuffer,
+                               uint16_t       aLength,
+                               const uint8_t *aIp6,
+                               uint16_t       aPort,
+                               void *         aContext)
+{
+    (void)aBuffer;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+
+    return aLength;
+}
+
+static void Run(size_t aCount)
+{
+    std::vector<std::string>          paths;
+    std::vector<Coap::Resource *>     resources;
+    std::vector<Coap::MessageNative>  requests;
+    std::vector<std::vector<uint8_t>> datagrams;
+    Coap::Router                      router;
+    Coap::Agent *                     agent   = Coap::Agent::Create(DiscardResponse, NULL);
+    unsigned long                     handled = 0;
+    size_t                            found   = 0;
+    uint64_t                          trie;
+    uint64_t                          linear;
+    uint64_t                          dispatch;
+
+    for (size_t i = 0; i < sizeof(kThreadUris) / sizeof(kThreadUris[0]); ++i)
+    {
+        paths.push_back(kThreadUris[i]);
+    }
+
+    for (size_t i = 0; paths.size() < aCount; ++i)
+    {
+        char path[32];
+
+        snprintf(path, sizeof(path), "v/%zu/d%zu", i % 16, i);
+        paths.push_back(path);
+    }
+
+    requests.resize(paths.size());
+    datagrams.resize(paths.size());
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        uint8_t  buffer[Coap::MessageNative::kMaxSize];
+        uint16_t length;
+
+        resources.push_back(new Coap::Resource(paths[i].c_str(), HandleRequest, &handled));
+        router.Add(*resources.back());
+        agent->AddResource(*resources.back());
+
+        requests[i].Init(Coap::kTypeNonConfirmable, Coap::kCodePost, static_cast<uint16_t>(i), NULL, 0);
+        requests[i].SetPath(paths[i].c_str());
+        requests[i].Serialize(buffer, sizeof(buffer), length);
+        datagrams[i].assign(buffer, buffer + length);
+    }
+
+    trie = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        bool pathFound;
+
+        found += (router.Find(requests[round % requests.size()], pathFound) != NULL);
+    }
+    trie = GetNanoseconds() - trie;
+
+    linear = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        const Coap::MessageNative &request = requests[round % requests.size()];
+
+        for (size_t i = 0; i < resources.size(); ++i)
+        {
+            if (request.MatchPath(resources[i]->mPath))
+            {
+                ++found;
+                break;
+            }
+        }
+    }
+    linear = GetNanoseconds() - linear;
+
+    dispatch = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        const std::vector<uint8_t> &datagram = datagrams[round % datagrams.size()];
+
+        agent->Input(&datagram[0], static_cast<uint16_t>(datagram.size()), NULL, 0);
+    }
+    dispatch = GetNanoseconds() - dispatch;
+
+    if (found != 2 * kRounds || handled != kRounds)
+    {
+        fprintf(stderr, "dispatch mismatch: found=%zu handled=%lu\n", found, handled);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%9zu %12.1f %12.1f %14.1f\n", paths.size(), static_cast<double>(trie) / kRounds,
+           static_cast<double>(linear) / kRounds, static_cast<double>(dispatch) / kRounds);
+
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        delete resources[i];
+    }
+
+    Coap::Agent::Destroy(agent);
+}
+
+int main(void)
+{
+    static const size_t kCounts[] = {sizeof(kThreadUris) / sizeof(kThreadUris[0]), 128, 512};
+
+    printf("%9s %12s %12s %14s\n", "resources", "trie(ns)", "linear(ns)", "dispatch(ns)");
+
+    for (size_t i = 0; i < sizeof(kCounts) / sizeof(kCounts[0]); ++i)
+    {
+        Run(kCounts[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the benchmark of CoAP retransmission over a lossy link.
+ *
+ *   A client sends confirmable requests one after another to a server over a simulated link with a fixed delay and
+ *   random loss in both directions, driven by a fake clock. It compares the time to complete all exchanges with the
+ *   retransmission timeouts estimated per peer against the fixed timers of RFC 7252.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <deque>
+#include <vector>
+
+#include "common/coap_native.hpp"
+#include "common/time.hpp"
+
+using namespace ot::BorderRouter;
+
+enum
+{
+    kRequests = 500,
+    kDelay    = 50, ///< One-way delay of the link in milliseconds.
+    kMaxIdle  = 60, ///< Max seconds to wait in one step.
+};
+
+struct Datagram
+{
+    Coap::Agent *        mReceiver;
+    unsigned long        mTime;
+    std::vector<uint8_t> mData;
+};
+
+struct Link
+{
+    std::deque<Datagram> mDatagrams;
+    unsigned int         mLoss; ///< Loss rate in percent.
+    unsigned int         mSeed;
+};
+
+static Link sLink;
+
+static ssize_t SendDatagram(const uint8_t *aBuffer,
+                            uint16_t       aLength,
+                            const uint8_t *aIp6,
+                            uint16_t       aPort,
+                            void *         aContext)
+{
+    Datagram datagram;
+
+    // Loss does not draw from rand(), so that both runs see the same losses.
+    sLink.mSeed = sLink.mSeed * 1103515245 + 12345;
+
+    if ((sLink.mSeed >> 16) % 100 >= sLink.mLoss)
+    {
+        datagram.mReceiver = *static_cast<Coap::Agent **>(aContext);
+        datagram.mTime     = GetNow() + kDelay;
+        datagram.mData.assign(aBuffer, aBuffer + aLength);
+        sLink.mDatagrams.push_back(datagram);
+    }
+
+    (void)aIp6;
+    (void)aPort;
+    return aLength;
+}
+
+static void HandleRequest(const Coap::Resource &aResource,
+                          const Coap::Message & aRequest,
+                          Coap::Message &       aResponse,
+                          const uint8_t *       aIp6,
+                          uint16_t              aPort,
+                          void *                aContext)
+{
+    aResponse.SetCode(Coap::kCodeChanged);
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+}
+
+static void HandleResponse(const Coap::Message *aMessage, otbrError aError, void *aContext)
+{
+    if (aError == OTBR_ERROR_NONE)
+    {
+        ++*static_cast<size_t *>(aContext);
+    }
+
+    (void)aMessage;
+}
+
+static void Run(unsigned int aLoss, bool aAdaptive)
+{
+    FakeClock                      clock(1000000);
+    Coap::Agent *                  client;
+    Coap::Agent *                  server;
+    Coap::Resource                 resource("a/b", HandleRequest, NULL);
+    Coap::AgentNative::PeerMetrics metrics;
+    size_t                         sent      = 0;
+    size_t                         completed = 0;
+    unsigned long                  start;
+
+    SetClock(&clock);
+    srand(1);
+    sLink.mLoss = aLoss;
+    sLink.mSeed = 1;
+    client      = Coap::Agent::Create(SendDatagram, &server);
+    server      = Coap::Agent::Create(SendDatagram, &client);
+    static_cast<Coap::AgentNative *>(client)->SetAdaptiveRto(aAdaptive);
+    server->AddResource(resource);
+    start = GetNow();
+
+    while (sent < kRequests || static_cast<Coap::AgentNative *>(client)->GetPendingCount() > 0)
+    {
+        timeval       timeout = {kMaxIdle, 0};
+        unsigned long next;
+
+        if (static_cast<Coap::AgentNative *>(client)->GetPendingCount() == 0)
+        {
+            Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+            message->SetPath("a/b");
+            client->Send(*message, NULL, 0, HandleResponse, &completed);
+            client->FreeMessage(message);
+            ++sent;
+        }
+
+        client->UpdateTimeout(timeout);
+        next = GetNow() + GetTimestamp(timeout);
+
+        if (!sLink.mDatagrams.empty() && static_cast<long>(sLink.mDatagrams.front().mTime - next) < 0)
+        {
+            next = sLink.mDatagrams.front().mTime;
+        }
+
+        clock.SetMicros(static_cast<uint64_t>(next) * 1000);
+
+        while (!sLink.mDatagrams.empty() && static_cast<long>(sLink.mDatagrams.front().mTime - next) <= 0)
+        {
+            Datagram datagram = sLink.mDatagrams.front();
+
+            sLink.mDatagrams.pop_front();
+            datagram.mReceiver->Input(&datagram.mData[0], static_cast<uint16_t>(datagram.mData.size()), NULL, 0);
+        }
+
+        client->Process();
+    }
+
+    static_cast<Coap::AgentNative *>(client)->GetPeerMetrics(NULL, 0, metrics);
+    printf("%7u%% %9s %12.1f %12.1f %9zu %14u %9u %8lu\n", aLoss, aAdaptive ? "adaptive" : "fixed",
+           static_cast<double>(GetNow() - start) / 1000, static_cast<double>(GetNow() - start) / kRequests, completed,
+           metrics.mTransmissions, metrics.mTimeouts, metrics.mRto);
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+    sLink.mDatagrams.clear();
+    SetClock(NULL);
+}
+
+int main(void)
+{
+    static const unsigned int kLosses[] = {0, 5, 10, 20, 30};
+
+    printf("%8s %9s %12s %12s %9s %14s %9s %8s\n", "loss", "rto", "total(s)", "mean(ms)", "completed",
+           "transmissions", "timeouts", "rto(ms)");
+
+    for (size_t i = 0; i < sizeof(kLosses) / sizeof(kLosses[0]); ++i)
+    {
+        Run(kLosses[i], false);
+        Run(kLosses[i], true);
+    }
+
+    return 0;
+}
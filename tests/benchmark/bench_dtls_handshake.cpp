@@ -0,0 +1,207 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the benchmark of full and resumed DTLS handshakes.
+ *
+ *   Clients connect to a local MbedtlsServer over loopback, first with full EC-JPAKE handshakes and then resuming
+ *   the first session, and the wall clock and CPU time per handshake are reported for both.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/dtls_mbedtls.hpp"
+#include "common/event_loop.hpp"
+
+using ot::BorderRouter::EventLoop;
+using ot::BorderRouter::Dtls::MbedtlsServer;
+using ot::BorderRouter::Dtls::Session;
+using ot::BorderRouter::Dtls::SessionCache;
+
+enum
+{
+    kRounds     = 50,
+    kServerPort = 49389,
+};
+
+static const char kPSK[] = "J01NME";
+
+static uint64_t GetNanoseconds(clockid_t aClock)
+{
+    struct timespec now;
+
+    clock_gettime(aClock, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static void HandleSessionState(Session &aSession, Session::State aState, void *aContext)
+{
+    (void)aSession;
+    (void)aState;
+    (void)aContext;
+}
+
+static void RunServer(EventLoop &aEventLoop)
+{
+    timeval timeout = {0, 1000};
+
+    if (aEventLoop.Poll(timeout) != OTBR_ERROR_NONE)
+    {
+        perror("poll");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void Handshake(EventLoop &aEventLoop, mbedtls_ssl_config &aConf, mbedtls_ssl_session *aSession)
+{
+    mbedtls_net_context          net;
+    mbedtls_ssl_context          ssl;
+    mbedtls_timing_delay_context timer;
+    int                          ret;
+
+    mbedtls_net_init(&net);
+    mbedtls_ssl_init(&ssl);
+
+    if (mbedtls_net_connect(&net, "::1", "49389", MBEDTLS_NET_PROTO_UDP) != 0 || mbedtls_net_set_nonblock(&net) != 0 ||
+        mbedtls_ssl_setup(&ssl, &aConf) != 0 ||
+        mbedtls_ssl_set_hs_ecjpake_password(&ssl, reinterpret_cast<const uint8_t *>(kPSK), sizeof(kPSK) - 1) != 0)
+    {
+        fprintf(stderr, "failed to set up client\n");
+        exit(EXIT_FAILURE);
+    }
+
+    mbedtls_ssl_set_bio(&ssl, &net, mbedtls_net_send, mbedtls_net_recv, NULL);
+    mbedtls_ssl_set_timer_cb(&ssl, &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+
+    if (aSession != NULL && aSession->id_len != 0)
+    {
+        mbedtls_ssl_set_session(&ssl, aSession);
+    }
+
+    while ((ret = mbedtls_ssl_handshake(&ssl)) != 0)
+    {
+        if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+        {
+            fprintf(stderr, "handshake failed: -0x%04x\n", -ret);
+            exit(EXIT_FAILURE);
+        }
+
+        RunServer(aEventLoop);
+    }
+
+    if (aSession != NULL && aSession->id_len == 0)
+    {
+        mbedtls_ssl_get_session(&ssl, aSession);
+    }
+
+    mbedtls_ssl_close_notify(&ssl);
+    RunServer(aEventLoop);
+    mbedtls_ssl_free(&ssl);
+    mbedtls_net_free(&net);
+}
+
+static void Run(const char *aName, EventLoop &aEventLoop, mbedtls_ssl_config &aConf, mbedtls_ssl_session *aSession)
+{
+    uint64_t wall = GetNanoseconds(CLOCK_MONOTONIC);
+    uint64_t cpu  = GetNanoseconds(CLOCK_PROCESS_CPUTIME_ID);
+
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        Handshake(aEventLoop, aConf, aSession);
+    }
+
+    wall = GetNanoseconds(CLOCK_MONOTONIC) - wall;
+    cpu  = GetNanoseconds(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+
+    printf("%-10s %8d %14.3f %14.3f\n", aName, kRounds, static_cast<double>(wall) / kRounds / 1e6,
+           static_cast<double>(cpu) / kRounds / 1e6);
+}
+
+static int Bench(EventLoop &aEventLoop)
+{
+    static const int         ciphersuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+    MbedtlsServer            server(aEventLoop, kServerPort, HandleSessionState, NULL);
+    mbedtls_ssl_session      session;
+    mbedtls_ssl_config       conf;
+    mbedtls_entropy_context  entropy;
+    mbedtls_ctr_drbg_context ctrDrbg;
+
+    server.SetPSK(reinterpret_cast<const uint8_t *>(kPSK), sizeof(kPSK) - 1);
+    server.SetSeed(reinterpret_cast<const uint8_t *>("seed"), 4);
+
+    if (server.Start() != OTBR_ERROR_NONE)
+    {
+        fprintf(stderr, "failed to start DTLS server\n");
+        return EXIT_FAILURE;
+    }
+
+    mbedtls_ssl_session_init(&session);
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctrDrbg);
+    mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, NULL, 0);
+    mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                MBEDTLS_SSL_PRESET_DEFAULT);
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctrDrbg);
+    mbedtls_ssl_conf_ciphersuites(&conf, ciphersuites);
+
+    printf("%-10s %8s %14s %14s\n", "handshake", "rounds", "wall(ms)", "cpu(ms)");
+    Run("full", aEventLoop, conf, NULL);
+
+    // The first handshake stores the session to resume.
+    Handshake(aEventLoop, conf, &session);
+    Run("resumed", aEventLoop, conf, &session);
+
+    {
+        const SessionCache::Counters &counters = server.GetSessionCacheCounters();
+
+        printf("session cache: %lu hits, %lu misses, %lu stored\n", counters.mHits, counters.mMisses,
+               counters.mStores);
+    }
+
+    mbedtls_ssl_session_free(&session);
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&ctrDrbg);
+    mbedtls_entropy_free(&entropy);
+
+    return 0;
+}
+
+int main(void)
+{
+    EventLoop *eventLoop = EventLoop::Create();
+    int        ret       = Bench(*eventLoop);
+
+    EventLoop::Destroy(eventLoop);
+
+    return ret;
+}
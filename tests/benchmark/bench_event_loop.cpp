@@ -0,0 +1,248 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the benchmark of event loop backends.
+ *
+ *   It measures the latency from writing a pipe to dispatching its handler, and the CPU time spent per event,
+ *   with 10, 100 and 1000 active file descriptors.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common/event_loop.hpp"
+
+using ot::BorderRouter::EventLoop;
+using ot::BorderRouter::MainloopProcessor;
+
+enum
+{
+    kRounds = 20000,
+};
+
+static uint64_t GetNanoseconds(clockid_t aClock)
+{
+    struct timespec now;
+
+    clock_gettime(aClock, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+class Bench : public MainloopProcessor
+{
+public:
+    Bench(size_t aCount)
+        : mReadFds(aCount)
+        , mWriteFds(aCount)
+        , mSentTime(0)
+        , mDispatched(false)
+    {
+        for (size_t i = 0; i < aCount; ++i)
+        {
+            int fds[2];
+
+            if (pipe(fds) != 0)
+            {
+                perror("pipe");
+                exit(EXIT_FAILURE);
+            }
+
+            mReadFds[i]  = fds[0];
+            mWriteFds[i] = fds[1];
+        }
+    }
+
+    ~Bench(void)
+    {
+        for (size_t i = 0; i < mReadFds.size(); ++i)
+        {
+            close(mReadFds[i]);
+            close(mWriteFds[i]);
+        }
+    }
+
+    bool Fits(void) const { return *std::max_element(mWriteFds.begin(), mWriteFds.end()) < FD_SETSIZE; }
+
+    void Register(EventLoop &aEventLoop)
+    {
+        for (size_t i = 0; i < mReadFds.size(); ++i)
+        {
+            aEventLoop.AddIo(mReadFds[i], EventLoop::kEventReadable, HandleReadable, this);
+        }
+    }
+
+    virtual void UpdateFdSet(otSysMainloopContext &aMainloop)
+    {
+        for (size_t i = 0; i < mReadFds.size(); ++i)
+        {
+            FD_SET(mReadFds[i], &aMainloop.mReadFdSet);
+
+            if (mReadFds[i] > aMainloop.mMaxFd)
+            {
+                aMainloop.mMaxFd = mReadFds[i];
+            }
+        }
+    }
+
+    virtual void Process(const otSysMainloopContext &aMainloop)
+    {
+        for (size_t i = 0; i < mReadFds.size(); ++i)
+        {
+            if (FD_ISSET(mReadFds[i], &aMainloop.mReadFdSet))
+            {
+                HandleReadable(mReadFds[i]);
+            }
+        }
+    }
+
+    void Run(EventLoop &aEventLoop, const char *aName)
+    {
+        const timeval         timeout = {1, 0};
+        std::vector<uint64_t> latencies;
+        uint64_t              cpu;
+
+        latencies.reserve(kRounds);
+        cpu = GetNanoseconds(CLOCK_PROCESS_CPUTIME_ID);
+
+        for (size_t round = 0; round < kRounds; ++round)
+        {
+            mDispatched = false;
+            mSentTime   = GetNanoseconds(CLOCK_MONOTONIC);
+
+            if (write(mWriteFds[round % mWriteFds.size()], "x", 1) != 1)
+            {
+                perror("write");
+                exit(EXIT_FAILURE);
+            }
+
+            while (!mDispatched)
+            {
+                if (aEventLoop.Poll(timeout) != OTBR_ERROR_NONE)
+                {
+                    perror("poll");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            latencies.push_back(mLatency);
+        }
+
+        cpu = GetNanoseconds(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+        std::sort(latencies.begin(), latencies.end());
+
+        printf("%-18s %6zu %12.2f %12.2f %12.2f\n", aName, mReadFds.size(), latencies[kRounds / 2] / 1000.0,
+               latencies[kRounds * 99 / 100] / 1000.0, static_cast<double>(cpu) / kRounds / 1000.0);
+    }
+
+private:
+    static void HandleReadable(void *aContext, int aFd, unsigned int aEvents)
+    {
+        static_cast<Bench *>(aContext)->HandleReadable(aFd);
+        (void)aEvents;
+    }
+
+    void HandleReadable(int aFd)
+    {
+        char byte;
+
+        if (read(aFd, &byte, sizeof(byte)) == 1)
+        {
+            mLatency    = GetNanoseconds(CLOCK_MONOTONIC) - mSentTime;
+            mDispatched = true;
+        }
+    }
+
+    std::vector<int> mReadFds;
+    std::vector<int> mWriteFds;
+    uint64_t         mSentTime;
+    uint64_t         mLatency;
+    bool             mDispatched;
+};
+
+int main(void)
+{
+    static const size_t kCounts[] = {10, 100, 1000};
+    struct rlimit       limit;
+
+    // Each descriptor under test needs a pipe.
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    printf("%-18s %6s %12s %12s %12s\n", "backend", "fds", "p50(us)", "p99(us)", "cpu/event(us)");
+
+    for (size_t i = 0; i < sizeof(kCounts) / sizeof(kCounts[0]); ++i)
+    {
+        Bench bench(kCounts[i]);
+
+        {
+            EventLoop *eventLoop = EventLoop::Create(EventLoop::kBackendEpoll);
+
+            bench.Register(*eventLoop);
+            bench.Run(*eventLoop, "epoll");
+            EventLoop::Destroy(eventLoop);
+        }
+
+        if (!bench.Fits())
+        {
+            printf("%-18s %6zu %12s\n", "select-mainloop", kCounts[i], "exceeds FD_SETSIZE");
+            printf("%-18s %6zu %12s\n", "epoll-mainloop", kCounts[i], "exceeds FD_SETSIZE");
+            continue;
+        }
+
+        {
+            EventLoop *eventLoop = EventLoop::Create(EventLoop::kBackendSelect);
+
+            eventLoop->AddProcessor(bench);
+            bench.Run(*eventLoop, "select-mainloop");
+            EventLoop::Destroy(eventLoop);
+        }
+
+        {
+            EventLoop *eventLoop = EventLoop::Create(EventLoop::kBackendEpoll);
+
+            eventLoop->AddProcessor(bench);
+            bench.Run(*eventLoop, "epoll-mainloop");
+            EventLoop::Destroy(eventLoop);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the benchmark of logging backends.
+ *
+ *   It measures the throughput and the latency seen by the caller of otbrLog(), when writing to a private log file
+ *   synchronously, and through the asynchronous writer in text and binary formats.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common/logging.hpp"
+
+enum
+{
+    kRounds = 200000,
+};
+
+static const char kLogFile[] = "/tmp/otbr-bench-logging.log";
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static void Run(const char *aName)
+{
+    std::vector<uint64_t> latencies;
+    uint64_t              start;
+    uint64_t              elapsed;
+
+    latencies.reserve(kRounds);
+    start = GetNanoseconds();
+
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        uint64_t begin = GetNanoseconds();
+
+        otbrLog(OTBR_LOG_INFO, "Received %zu bytes from %s port %u: %s", round % 1280, "fdde:ad00:beef:0:0:ff:fe00:fc00",
+                49191U, "COAP_MESSAGE");
+        latencies.push_back(GetNanoseconds() - begin);
+    }
+
+    otbrLogFlush();
+    elapsed = GetNanoseconds() - start;
+    std::sort(latencies.begin(), latencies.end());
+
+    printf("%-12s %12.0f %10.2f %10.2f %10.2f %10.2f\n", aName, kRounds * 1e9 / elapsed,
+           latencies[kRounds / 2] / 1000.0, latencies[kRounds * 99 / 100] / 1000.0,
+           latencies[kRounds * 999 / 1000] / 1000.0, latencies.back() / 1000.0);
+}
+
+int main(void)
+{
+    otbrLogInit("otbr-bench-logging", OTBR_LOG_DEBUG, false);
+    otbrLogEnableSyslog(false);
+    otbrLogSetFilename(kLogFile);
+
+    printf("%-12s %12s %10s %10s %10s %10s\n", "backend", "msgs/s", "p50(us)", "p99(us)", "p99.9(us)", "max(us)");
+
+    Run("sync");
+
+    if (otbrLogStartAsync(false) != OTBR_ERROR_NONE)
+    {
+        perror("otbrLogStartAsync");
+        return EXIT_FAILURE;
+    }
+
+    Run("async-text");
+    otbrLogStopAsync();
+
+    if (otbrLogStartAsync(true) != OTBR_ERROR_NONE)
+    {
+        perror("otbrLogStartAsync");
+        return EXIT_FAILURE;
+    }
+
+    Run("async-binary");
+    otbrLogDeinit();
+    remove(kLogFile);
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the benchmark of PSKc computation.
+ *
+ *   PSKc of distinct networks are computed with the PRF keyed per call as specified, with the PRF key expanded
+ *   once, and in batches over a growing number of threads. The throughput of cached PSKc is reported last.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#include "utils/pskc.hpp"
+
+using ot::Psk::PskcEngine;
+using ot::Psk::PskcRequest;
+
+enum
+{
+    kNetworks = 64,
+};
+
+static const char kNetworkName[] = "OpenThread";
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * This function computes the PSKc with mbedtls_aes_cmac_prf_128(), which expands the passphrase for each iteration.
+ *
+ */
+static void ComputeReference(const PskcRequest &aRequest, uint8_t *aPskc)
+{
+    size_t  passphraseLength = strlen(aRequest.mPassphrase);
+    size_t  saltLength       = 0;
+    uint8_t salt[OT_PBKDF2_SALT_MAX_LENGTH + 4];
+    uint8_t output[OT_PSKC_LENGTH];
+
+    memcpy(salt, "Thread", 6);
+    saltLength += 6;
+    memcpy(salt + saltLength, aRequest.mExtPanId, sizeof(aRequest.mExtPanId));
+    saltLength += sizeof(aRequest.mExtPanId);
+    memcpy(salt + saltLength, aRequest.mNetworkName, strlen(aRequest.mNetworkName));
+    saltLength += strlen(aRequest.mNetworkName);
+    memcpy(salt + saltLength, "\x00\x00\x00\x01", 4);
+    saltLength += 4;
+
+    mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aRequest.mPassphrase), passphraseLength, salt,
+                             saltLength, output);
+    memcpy(aPskc, output, sizeof(output));
+
+    for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
+    {
+        uint8_t input[OT_PSKC_LENGTH];
+
+        memcpy(input, output, sizeof(input));
+        mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aRequest.mPassphrase), passphraseLength, input,
+                                 sizeof(input), output);
+
+        for (size_t j = 0; j < sizeof(output); j++)
+        {
+            aPskc[j] ^= output[j];
+        }
+    }
+}
+
+static void Report(const char *aName, unsigned aThreads, size_t aCount, uint64_t aNanoseconds)
+{
+    printf("%-10s %8u %10zu %12.3f %12.1f\n", aName, aThreads, aCount, static_cast<double>(aNanoseconds) / 1e9,
+           static_cast<double>(aCount) * 1e9 / static_cast<double>(aNanoseconds));
+}
+
+int main(void)
+{
+    std::vector<PskcRequest> requests(kNetworks);
+    std::vector<std::string> passphrases(kNetworks);
+    ot::Psk::Pskc            pskc;
+    unsigned                 maxThreads = PskcEngine(0).GetThreads();
+    uint64_t                 start;
+
+    for (size_t i = 0; i < kNetworks; ++i)
+    {
+        char passphrase[16];
+
+        snprintf(passphrase, sizeof(passphrase), "J01N%06zu", i);
+        passphrases[i] = passphrase;
+
+        memset(requests[i].mExtPanId, 0, sizeof(requests[i].mExtPanId));
+        requests[i].mExtPanId[7] = static_cast<uint8_t>(i);
+        requests[i].mNetworkName = kNetworkName;
+        requests[i].mPassphrase  = passphrases[i].c_str();
+    }
+
+    printf("%-10s %8s %10s %12s %12s\n", "method", "threads", "networks", "total(s)", "pskc/s");
+
+    // The reference is slow, a few networks are enough.
+    start = GetNanoseconds();
+    for (size_t i = 0; i < kNetworks / 8; ++i)
+    {
+        uint8_t expected[OT_PSKC_LENGTH];
+
+        ComputeReference(requests[i], expected);
+
+        if (memcmp(expected, pskc.ComputePskc(requests[i].mExtPanId, kNetworkName, requests[i].mPassphrase),
+                   sizeof(expected)) != 0)
+        {
+            fprintf(stderr, "PSKc mismatch\n");
+            return EXIT_FAILURE;
+        }
+    }
+    Report("reference", 1, kNetworks / 8, GetNanoseconds() - start);
+
+    start = GetNanoseconds();
+    for (size_t i = 0; i < kNetworks; ++i)
+    {
+        pskc.ComputePskc(requests[i].mExtPanId, kNetworkName, requests[i].mPassphrase);
+    }
+    Report("expanded", 1, kNetworks, GetNanoseconds() - start);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        PskcEngine engine(0, threads);
+
+        start = GetNanoseconds();
+        engine.ComputePskc(requests.data(), requests.size());
+        Report("batch", threads, kNetworks, GetNanoseconds() - start);
+    }
+
+    {
+        PskcEngine engine(kNetworks, maxThreads);
+        size_t     rounds = 1000;
+
+        engine.ComputePskc(requests.data(), requests.size());
+
+        start = GetNanoseconds();
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            engine.ComputePskc(requests.data(), requests.size());
+        }
+        Report("cached", maxThreads, kNetworks * rounds, GetNanoseconds() - start);
+    }
+
+    return EXIT_SUCCESS;
+}
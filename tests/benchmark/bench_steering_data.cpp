@@ -0,0 +1,180 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the benchmark of steering data computation.
+ *
+ *   Steering data of an allow list is computed joiner by joiner with a full SHA-256 and bitwise CRC16, and in one
+ *   batch with SteeringData::AddJoiners(), and the results are compared. The bloom filter alone is measured from
+ *   precomputed joiner ids with both CRC16 implementations.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#include <mbedtls/sha256.h>
+
+#include "utils/steering_data.hpp"
+
+using ot::SteeringData;
+
+enum
+{
+    kJoiners = 4096,
+    kRounds  = 20,
+};
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static uint16_t ComputeCrc16Bitwise(uint16_t aPolynomial, const uint8_t *aBuffer, size_t aLength)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        crc ^= static_cast<uint16_t>(aBuffer[i] << 8);
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>(static_cast<uint16_t>(crc << 1) ^ aPolynomial)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void ComputeBloomFilterBitwise(const uint8_t *aJoinerId, SteeringData &aSteeringData)
+{
+    const uint16_t numBits = aSteeringData.GetLength() * 8;
+
+    aSteeringData.SetBit(
+        static_cast<uint8_t>(ComputeCrc16Bitwise(0x1021, aJoinerId, SteeringData::kSizeJoinerId) % numBits));
+    aSteeringData.SetBit(
+        static_cast<uint8_t>(ComputeCrc16Bitwise(0x8005, aJoinerId, SteeringData::kSizeJoinerId) % numBits));
+}
+
+static void ComputeReference(const uint8_t *aEui64s, size_t aCount, SteeringData &aSteeringData)
+{
+    for (size_t i = 0; i < aCount; i++)
+    {
+        uint8_t hash[32];
+
+        mbedtls_sha256_ret(aEui64s + i * SteeringData::kSizeEui64, SteeringData::kSizeEui64, hash, 0);
+        hash[0] |= 2;
+        ComputeBloomFilterBitwise(hash, aSteeringData);
+    }
+}
+
+static void Report(const char *aName, uint64_t aNanoseconds)
+{
+    printf("%-10s %10d %12.3f %14.1f\n", aName, kJoiners * kRounds, static_cast<double>(aNanoseconds) / 1e9,
+           static_cast<double>(kJoiners) * kRounds * 1e6 / static_cast<double>(aNanoseconds));
+}
+
+int main(void)
+{
+    std::vector<uint8_t> eui64s(kJoiners * SteeringData::kSizeEui64);
+    std::vector<uint8_t> joinerIds(kJoiners * SteeringData::kSizeJoinerId);
+    SteeringData         reference;
+    SteeringData         batch;
+    uint64_t             start;
+
+    for (size_t i = 0; i < kJoiners; i++)
+    {
+        static const uint8_t kOui[] = {0x18, 0xb4, 0x30};
+        uint8_t *            eui64  = &eui64s[i * SteeringData::kSizeEui64];
+
+        memcpy(eui64, kOui, sizeof(kOui));
+        memset(eui64 + sizeof(kOui), 0, SteeringData::kSizeEui64 - sizeof(kOui));
+        eui64[6] = static_cast<uint8_t>(i >> 8);
+        eui64[7] = static_cast<uint8_t>(i);
+    }
+
+    printf("%-10s %10s %12s %14s\n", "method", "joiners", "total(s)", "joiners/ms");
+
+    start = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        reference.Init(SteeringData::kMaxSizeOfBloomFilter);
+        ComputeReference(eui64s.data(), kJoiners, reference);
+    }
+    Report("reference", GetNanoseconds() - start);
+
+    start = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        batch.Init(SteeringData::kMaxSizeOfBloomFilter);
+        batch.AddJoiners(eui64s.data(), kJoiners);
+    }
+    Report("batch", GetNanoseconds() - start);
+
+    if (memcmp(reference.GetBloomFilter(), batch.GetBloomFilter(), SteeringData::kMaxSizeOfBloomFilter) != 0)
+    {
+        fprintf(stderr, "steering data mismatch\n");
+        return EXIT_FAILURE;
+    }
+
+    SteeringData::ComputeJoinerIds(eui64s.data(), kJoiners, joinerIds.data());
+
+    start = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        reference.Init(SteeringData::kMaxSizeOfBloomFilter);
+
+        for (size_t i = 0; i < kJoiners; i++)
+        {
+            ComputeBloomFilterBitwise(&joinerIds[i * SteeringData::kSizeJoinerId], reference);
+        }
+    }
+    Report("bitwise", GetNanoseconds() - start);
+
+    start = GetNanoseconds();
+    for (size_t round = 0; round < kRounds; round++)
+    {
+        batch.Init(SteeringData::kMaxSizeOfBloomFilter);
+
+        for (size_t i = 0; i < kJoiners; i++)
+        {
+            batch.ComputeBloomFilter(&joinerIds[i * SteeringData::kSizeJoinerId]);
+        }
+    }
+    Report("slice-by-8", GetNanoseconds() - start);
+
+    return EXIT_SUCCESS;
+}
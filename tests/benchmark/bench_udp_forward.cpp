@@ -0,0 +1,194 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the benchmark of composing UDP forward stream messages to wpantund.
+ *
+ *   It compares the former path, which copies each packet into a temporary vector with the trailer before
+ *   appending it to the message, with ControllerWpantund::AppendUdpForwardStream(), and reports packets per second
+ *   and heap allocations per packet.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#include <dbus/dbus.h>
+
+extern "C" {
+#include "wpan-dbus-v1.h"
+}
+
+#include "agent/ncp_wpantund.hpp"
+
+using ot::BorderRouter::Ncp::ControllerWpantund;
+
+enum
+{
+    kRounds = 200000,
+};
+
+static const char kInterfaceDBusName[] = "com.nestlabs.WPANTunnelDriver";
+static const char kInterfaceDBusPath[] = "/com/nestlabs/WPANTunnelDriver/wpan0";
+
+static size_t sAllocations = 0;
+
+extern "C" void *__libc_malloc(size_t aSize);
+extern "C" void *__libc_calloc(size_t aCount, size_t aSize);
+extern "C" void *__libc_realloc(void *aPointer, size_t aSize);
+
+extern "C" void *malloc(size_t aSize)
+{
+    ++sAllocations;
+    return __libc_malloc(aSize);
+}
+
+extern "C" void *calloc(size_t aCount, size_t aSize)
+{
+    ++sAllocations;
+    return __libc_calloc(aCount, aSize);
+}
+
+extern "C" void *realloc(void *aPointer, size_t aSize)
+{
+    ++sAllocations;
+    return __libc_realloc(aPointer, aSize);
+}
+
+static uint64_t GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static DBusMessage *NewPropertySet(void)
+{
+    return dbus_message_new_method_call(kInterfaceDBusName, kInterfaceDBusPath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                        WPANTUND_IF_CMD_PROP_SET);
+}
+
+static bool ComposeCopy(const uint8_t *aBuffer, uint16_t aLength, uint16_t aPeerPort, const in6_addr &aPeerAddr)
+{
+    DBusMessage *        message  = NewPropertySet();
+    uint16_t             sockPort = 49191;
+    std::vector<uint8_t> data(aLength + sizeof(aPeerPort) + sizeof(aPeerAddr) + sizeof(sockPort));
+    const uint8_t *      value = data.data();
+    const char *         key   = kWPANTUNDProperty_UdpForwardStream;
+    size_t               index = aLength;
+    bool                 ret;
+
+    memcpy(data.data(), aBuffer, aLength);
+    data[index]     = (aPeerPort >> 8);
+    data[index + 1] = (aPeerPort & 0xff);
+    index += sizeof(aPeerPort);
+
+    memcpy(&data[index], aPeerAddr.s6_addr, sizeof(aPeerAddr));
+    index += sizeof(aPeerAddr);
+
+    data[index]     = (sockPort >> 8);
+    data[index + 1] = (sockPort & 0xff);
+
+    ret = dbus_message_append_args(message, DBUS_TYPE_STRING, &key, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE, &value,
+                                   data.size(), DBUS_TYPE_INVALID);
+    dbus_message_unref(message);
+
+    return ret;
+}
+
+static bool ComposeInPlace(const uint8_t *aBuffer, uint16_t aLength, uint16_t aPeerPort, const in6_addr &aPeerAddr)
+{
+    DBusMessage *message = NewPropertySet();
+    bool         ret;
+
+    ret = (ControllerWpantund::AppendUdpForwardStream(*message, aBuffer, aLength, aPeerPort, aPeerAddr, 49191) ==
+           OTBR_ERROR_NONE);
+    dbus_message_unref(message);
+
+    return ret;
+}
+
+static void Run(const char *aName,
+                bool (*aCompose)(const uint8_t *, uint16_t, uint16_t, const in6_addr &),
+                uint16_t aLength)
+{
+    uint8_t  packet[1280];
+    in6_addr peerAddr;
+    size_t   allocations;
+    uint64_t elapsed;
+
+    memset(packet, 0xa5, sizeof(packet));
+    memset(&peerAddr, 0, sizeof(peerAddr));
+    peerAddr.s6_addr[0]  = 0xfe;
+    peerAddr.s6_addr[1]  = 0x80;
+    peerAddr.s6_addr[15] = 0x01;
+
+    // Warm up caches of libdbus and the allocator.
+    for (size_t round = 0; round < 100; ++round)
+    {
+        aCompose(packet, aLength, 1000, peerAddr);
+    }
+
+    allocations = sAllocations;
+    elapsed     = GetNanoseconds();
+
+    for (size_t round = 0; round < kRounds; ++round)
+    {
+        if (!aCompose(packet, aLength, 1000, peerAddr))
+        {
+            fprintf(stderr, "failed to compose message\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    elapsed     = GetNanoseconds() - elapsed;
+    allocations = sAllocations - allocations;
+
+    printf("%-10s %8u %14.0f %14.2f\n", aName, aLength, kRounds * 1e9 / static_cast<double>(elapsed),
+           static_cast<double>(allocations) / kRounds);
+}
+
+int main(void)
+{
+    static const uint16_t kLengths[] = {64, 256, 1024};
+
+    printf("%-10s %8s %14s %14s\n", "path", "bytes", "packets/s", "allocs/packet");
+
+    for (size_t i = 0; i < sizeof(kLengths) / sizeof(kLengths[0]); ++i)
+    {
+        Run("copy", ComposeCopy, kLengths[i]);
+        Run("in-place", ComposeInPlace, kLengths[i]);
+    }
+
+    return 0;
+}
@@ -28,50 +28,44 @@
 
 #include <assert.h>
 #include <errno.h>
-#include <limits.h>
 #include <netinet/in.h>
 #include <signal.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 
 #include "agent/mdns.hpp"
 #include "common/code_utils.hpp"
+#include "common/event_loop.hpp"
 #include "common/logging.hpp"
 
 using namespace ot::BorderRouter;
 
 static struct Context
 {
+    EventLoop *      mEventLoop;
     Mdns::Publisher *mPublisher;
     bool             mUpdate;
+    unsigned         mBulkCount;
 } sContext;
 
-int Mainloop(Mdns::Publisher &aPublisher)
+static volatile sig_atomic_t sInterrupted;
+
+static const struct timeval kPollTimeout = {1, 0};
+
+int Mainloop(EventLoop &aEventLoop)
 {
     int rval = 0;
 
-    while (true)
+    // Returns once a signal arrives, so that the tests can move to their next step.
+    for (sInterrupted = false; !sInterrupted;)
     {
-        fd_set         readFdSet;
-        fd_set         writeFdSet;
-        fd_set         errorFdSet;
-        int            maxFd   = -1;
-        struct timeval timeout = {INT_MAX, INT_MAX};
-
-        FD_ZERO(&readFdSet);
-        FD_ZERO(&writeFdSet);
-        FD_ZERO(&errorFdSet);
-
-        aPublisher.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
-        rval = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, (timeout.tv_sec == INT_MAX ? NULL : &timeout));
-
-        if (rval < 0)
+        if (aEventLoop.Poll(kPollTimeout) != OTBR_ERROR_NONE)
         {
-            perror("select() failed");
+            perror("Poll() failed");
+            rval = -1;
             break;
         }
-
-        aPublisher.Process(readFdSet, writeFdSet, errorFdSet);
     }
 
     return rval;
@@ -122,14 +116,51 @@ void PublishUpdateServices(void *aContext, Mdns::State aState)
     }
 }
 
+void PublishRenameService(void *aContext, Mdns::State aState)
+{
+    assert(aContext == &sContext);
+
+    if (aState == Mdns::kStateReady)
+    {
+        assert(OTBR_ERROR_NONE == sContext.mPublisher->PublishService(12345, "RenameService", "_meshcop._udp.", "nn",
+                                                                      "cool", "xp", "1122334455667788", NULL));
+    }
+}
+
+void PublishBulkServices(void *aContext, Mdns::State aState)
+{
+    assert(aContext == &sContext);
+
+    if (aState == Mdns::kStateReady)
+    {
+        Mdns::ServiceList services(sContext.mBulkCount);
+
+        for (unsigned i = 0; i < sContext.mBulkCount; ++i)
+        {
+            char          name[sizeof("BulkService65535")];
+            const uint8_t xpanid[] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, static_cast<uint8_t>(i)};
+
+            snprintf(name, sizeof(name), "BulkService%u", i);
+            services[i].mName = name;
+            services[i].mType = "_meshcop._udp.";
+            services[i].mPort = static_cast<uint16_t>(20000 + i);
+            services[i].mTxtList.push_back(Mdns::TxtEntry("nn", name));
+            services[i].mTxtList.push_back(Mdns::TxtEntry("xp", xpanid, sizeof(xpanid)));
+        }
+
+        assert(OTBR_ERROR_NONE == sContext.mPublisher->PublishServices(services));
+    }
+}
+
 otbrError TestSingleService(void)
 {
     otbrError ret = OTBR_ERROR_NONE;
 
-    Mdns::Publisher *pub = Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, PublishSingleService, &sContext);
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishSingleService, &sContext);
     sContext.mPublisher  = pub;
     SuccessOrExit(ret = pub->Start());
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
 
 exit:
     Mdns::Publisher::Destroy(pub);
@@ -140,10 +171,11 @@ otbrError TestMultipleServices(void)
 {
     otbrError ret = OTBR_ERROR_NONE;
 
-    Mdns::Publisher *pub = Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, PublishMultipleServices, &sContext);
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishMultipleServices, &sContext);
     sContext.mPublisher  = pub;
     SuccessOrExit(ret = pub->Start());
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
 
 exit:
     Mdns::Publisher::Destroy(pub);
@@ -154,13 +186,14 @@ otbrError TestUpdateService(void)
 {
     otbrError ret = OTBR_ERROR_NONE;
 
-    Mdns::Publisher *pub = Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, PublishUpdateServices, &sContext);
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishUpdateServices, &sContext);
     sContext.mPublisher  = pub;
     sContext.mUpdate     = false;
     SuccessOrExit(ret = pub->Start());
     sContext.mUpdate = true;
     PublishUpdateServices(&sContext, Mdns::kStateReady);
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
 
 exit:
     Mdns::Publisher::Destroy(pub);
@@ -169,6 +202,8 @@ exit:
 
 void RecoverSignal(int aSignal)
 {
+    sInterrupted = true;
+
     if (aSignal == SIGUSR1)
     {
         signal(SIGUSR1, SIG_DFL);
@@ -183,16 +218,55 @@ otbrError TestStopService(void)
 {
     otbrError ret = OTBR_ERROR_NONE;
 
-    Mdns::Publisher *pub = Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, PublishSingleService, &sContext);
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishSingleService, &sContext);
     sContext.mPublisher  = pub;
     SuccessOrExit(ret = pub->Start());
     signal(SIGUSR1, RecoverSignal);
     signal(SIGUSR2, RecoverSignal);
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
     sContext.mPublisher->Stop();
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
     SuccessOrExit(ret = sContext.mPublisher->Start());
-    Mainloop(*pub);
+    Mainloop(*sContext.mEventLoop);
+
+exit:
+    Mdns::Publisher::Destroy(pub);
+    return ret;
+}
+
+otbrError TestRenameService(void)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishRenameService, &sContext);
+    sContext.mPublisher  = pub;
+    SuccessOrExit(ret = pub->Start());
+    signal(SIGUSR1, RecoverSignal);
+    Mainloop(*sContext.mEventLoop);
+
+    // Renamed and updated the same way the border agent does when network name and extended PAN ID change.
+    SuccessOrExit(ret = pub->RenameService("_meshcop._udp.", "RenameService", "RenamedService"));
+    SuccessOrExit(ret = pub->PublishService(12345, "RenamedService", "_meshcop._udp.", "nn", "renamed", "xp",
+                                            "8877665544332211", NULL));
+    Mainloop(*sContext.mEventLoop);
+
+exit:
+    Mdns::Publisher::Destroy(pub);
+    return ret;
+}
+
+otbrError TestBulkServices(unsigned aCount)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    Mdns::Publisher *pub =
+        Mdns::Publisher::Create(*sContext.mEventLoop, AF_UNSPEC, NULL, NULL, PublishBulkServices, &sContext);
+    sContext.mPublisher  = pub;
+    sContext.mBulkCount  = aCount;
+    SuccessOrExit(ret = pub->Start());
+    Mainloop(*sContext.mEventLoop);
 
 exit:
     Mdns::Publisher::Destroy(pub);
@@ -209,6 +283,9 @@ int main(int argc, char *argv[])
     }
 
     otbrLogInit("otbr-mdns", OTBR_LOG_DEBUG, true);
+    sContext.mEventLoop = EventLoop::Create();
+    VerifyOrExit(sContext.mEventLoop != NULL, ret = 1);
+
     // allow quitting elegantly
     signal(SIGTERM, RecoverSignal);
     switch (argv[1][0])
@@ -229,10 +306,24 @@ int main(int argc, char *argv[])
         ret = TestStopService();
         break;
 
+    case 'r':
+        ret = TestRenameService();
+        break;
+
+    case 'b':
+        ret = TestBulkServices(argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 100);
+        break;
+
     default:
         ret = 1;
         break;
     }
 
+exit:
+    if (sContext.mEventLoop != NULL)
+    {
+        EventLoop::Destroy(sContext.mEventLoop);
+    }
+
     return ret;
 }
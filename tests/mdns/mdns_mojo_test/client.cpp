@@ -33,6 +33,7 @@
 
 #include <unistd.h>
 
+#include "common/event_loop.hpp"
 #include "mdns_mojo.hpp"
 
 static ot::BorderRouter::Mdns::Publisher *sPublisher;
@@ -46,12 +47,15 @@ void PublishHandler(void *aContext, ot::BorderRouter::Mdns::State aState)
 
 int main(void)
 {
-    sPublisher = ot::BorderRouter::Mdns::Publisher::Create(0, nullptr, nullptr, PublishHandler, nullptr);
+    ot::BorderRouter::EventLoop *eventLoop = ot::BorderRouter::EventLoop::Create();
+
+    sPublisher = ot::BorderRouter::Mdns::Publisher::Create(*eventLoop, 0, nullptr, nullptr, PublishHandler, nullptr);
     while (!published)
         ;
     sleep(1);
     sPublisher->Stop();
     sleep(1);
     ot::BorderRouter::Mdns::Publisher::Destroy(sPublisher);
+    ot::BorderRouter::EventLoop::Destroy(eventLoop);
     return 0;
 }
@@ -34,7 +34,12 @@
 #include <string.h>
 #include <sys/socket.h>
 
-#include "common/coap.hpp"
+#include <algorithm>
+#include <vector>
+
+#include "common/coap_native.hpp"
+#include "common/coap_rto.hpp"
+#include "common/time.hpp"
 
 using namespace ot::BorderRouter;
 
@@ -45,6 +50,8 @@ struct TestContext
     sockaddr_in6 mSockName;
     bool         mRequestHandled;
     bool         mResponseHandled;
+    otbrError    mResponseError;
+    int          mResponseErrno;
 };
 
 void TestRequestHandler(const Coap::Resource &aResource,
@@ -66,12 +73,14 @@ void TestRequestHandler(const Coap::Resource &aResource,
     (void)aContext;
 }
 
-void TestResponseHandler(const Coap::Message &aMessage, void *aContext)
+void TestResponseHandler(const Coap::Message *aMessage, otbrError aError, void *aContext)
 {
     TestContext &context = *static_cast<TestContext *>(aContext);
 
     context.mResponseHandled = true;
-    (void)aMessage;
+    context.mResponseError   = aError;
+    context.mResponseErrno   = (aError == OTBR_ERROR_ERRNO ? errno : 0);
+    CHECK_EQUAL(aError == OTBR_ERROR_NONE, aMessage != NULL);
 }
 
 ssize_t TestNetworkSender(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort, void *aContext)
@@ -167,3 +176,933 @@ TEST(Coap, TestRequest)
 
     Coap::Agent::Destroy(agent);
 }
+
+struct Datagram
+{
+    Coap::Agent *        mReceiver;
+    std::vector<uint8_t> mData;
+};
+
+static std::vector<Datagram> sDatagrams;
+static size_t                sLargestDatagram;
+
+static ssize_t QueueDatagram(const uint8_t *aBuffer,
+                             uint16_t       aLength,
+                             const uint8_t *aIp6,
+                             uint16_t       aPort,
+                             void *         aContext)
+{
+    Datagram datagram;
+
+    datagram.mReceiver = *static_cast<Coap::Agent **>(aContext);
+    datagram.mData.assign(aBuffer, aBuffer + aLength);
+    sDatagrams.push_back(datagram);
+    sLargestDatagram = std::max<size_t>(sLargestDatagram, aLength);
+
+    (void)aIp6;
+    (void)aPort;
+    return static_cast<ssize_t>(aLength);
+}
+
+static void DeliverDatagrams(void)
+{
+    while (!sDatagrams.empty())
+    {
+        Datagram datagram = sDatagrams.front();
+
+        sDatagrams.erase(sDatagrams.begin());
+        datagram.mReceiver->Input(&datagram.mData[0], static_cast<uint16_t>(datagram.mData.size()), NULL, 0);
+    }
+}
+
+struct Exchange
+{
+    const Coap::Message *mRequest;
+    Coap::Code           mResponseCode;
+    int                  mResponses;
+    uint8_t              mPayload[16];
+    uint16_t             mPayloadLength;
+};
+
+static void DeferRequest(const Coap::Resource &aResource,
+                         const Coap::Message & aRequest,
+                         Coap::Message &       aResponse,
+                         const uint8_t *       aIp6,
+                         uint16_t              aPort,
+                         void *                aContext)
+{
+    static_cast<Exchange *>(aContext)->mRequest = &aRequest;
+
+    (void)aResource;
+    (void)aResponse;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static void HandleExchangeResponse(const Coap::Message *aMessage, otbrError aError, void *aContext)
+{
+    Exchange &     exchange = *static_cast<Exchange *>(aContext);
+    const uint8_t *payload;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aError);
+    payload                = aMessage->GetPayload(exchange.mPayloadLength);
+    exchange.mResponseCode = aMessage->GetCode();
+    exchange.mResponses++;
+    if (payload != NULL)
+    {
+        memcpy(exchange.mPayload, payload, std::min<size_t>(exchange.mPayloadLength, sizeof(exchange.mPayload)));
+    }
+}
+
+TEST(Coap, TestParseSerialize)
+{
+    static const uint8_t kToken[]   = {0xde, 0xad, 0xbe, 0xef};
+    static const uint8_t kPayload[] = {1, 2, 3, 4, 5};
+    static const uint8_t kLong[300] = {0};
+    Coap::MessageNative  message;
+    Coap::MessageNative  parsed;
+    uint8_t              buffer[Coap::MessageNative::kMaxSize];
+    uint16_t             length;
+    uint8_t              tokenLength;
+    uint16_t             payloadLength;
+
+    message.Init(Coap::kTypeNonConfirmable, Coap::kCodePost, 0x1234, kToken, sizeof(kToken));
+    message.SetPayload(kPayload, sizeof(kPayload));
+    message.SetPath("/c/cp/");
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddOption(1000, kLong, sizeof(kLong)));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddOption(1, NULL, 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.Serialize(buffer, sizeof(buffer), length));
+
+    // Options are written in the order of their numbers, with extended deltas and lengths.
+    CHECK_EQUAL(OTBR_ERROR_NONE, parsed.Parse(buffer, length));
+    CHECK_EQUAL(Coap::kTypeNonConfirmable, parsed.GetType());
+    CHECK_EQUAL(Coap::kCodePost, parsed.GetCode());
+    CHECK_EQUAL(0x1234, parsed.GetMessageId());
+    CHECK_EQUAL(0, memcmp(kToken, parsed.GetToken(tokenLength), sizeof(kToken)));
+    CHECK_EQUAL(sizeof(kToken), tokenLength);
+    CHECK_EQUAL(4, parsed.GetOptionCount());
+    CHECK_EQUAL(1, parsed.GetOption(0).mNumber);
+    CHECK_EQUAL(Coap::kOptionUriPath, parsed.GetOption(1).mNumber);
+    CHECK_EQUAL(1000, parsed.GetOption(3).mNumber);
+    CHECK_EQUAL(sizeof(kLong), parsed.GetOption(3).mLength);
+    CHECK(parsed.MatchPath("c/cp"));
+    CHECK(!parsed.MatchPath("c"));
+    CHECK(!parsed.MatchPath("c/cp/x"));
+    CHECK(!parsed.MatchPath("c/ca"));
+
+    // Parsed in place.
+    CHECK(parsed.GetPayload(payloadLength) == buffer + length - sizeof(kPayload));
+    CHECK_EQUAL(sizeof(kPayload), payloadLength);
+
+    // Truncated messages are rejected.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, parsed.Parse(buffer, static_cast<uint16_t>(length - sizeof(kPayload) - 10)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, parsed.Parse(buffer, 20));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, message.Serialize(buffer, 100, length));
+    CHECK_EQUAL(EMSGSIZE, errno);
+}
+
+TEST(Coap, TestSeparateResponse)
+{
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    Exchange       exchange;
+    Coap::Resource resource("a/b", DeferRequest, &exchange);
+    uint16_t       token = 0x5a5a;
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&exchange, 0, sizeof(exchange));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                                    reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+        message->SetPath("a/b");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, HandleExchangeResponse, &exchange));
+        client->FreeMessage(message);
+    }
+
+    // The server acknowledges with an empty ACK, the client keeps waiting.
+    DeliverDatagrams();
+    CHECK(exchange.mRequest != NULL);
+    CHECK_EQUAL(0, exchange.mResponses);
+    CHECK_EQUAL(1, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    {
+        static const uint8_t kPayload[] = {'o', 'k'};
+        Coap::Message *      message    = server->NewMessage(Coap::kTypeConfirmable, Coap::kCodeChanged,
+                                                     reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+        message->SetPayload(kPayload, sizeof(kPayload));
+        CHECK_EQUAL(OTBR_ERROR_NONE, server->Send(*message, NULL, 0, NULL, NULL));
+        server->FreeMessage(message);
+    }
+
+    // The separate response is matched by token and acknowledged by the client.
+    DeliverDatagrams();
+    CHECK_EQUAL(1, exchange.mResponses);
+    CHECK_EQUAL(Coap::kCodeChanged, exchange.mResponseCode);
+    CHECK_EQUAL(2, exchange.mPayloadLength);
+    CHECK_EQUAL(0, memcmp("ok", exchange.mPayload, 2));
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(server)->GetPendingCount());
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+TEST(Coap, TestNotFound)
+{
+    Coap::Agent *client;
+    Coap::Agent *server;
+    Exchange     exchange;
+    uint16_t     token = 0x1111;
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&exchange, 0, sizeof(exchange));
+
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                                    reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+        message->SetPath("missing");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, HandleExchangeResponse, &exchange));
+        client->FreeMessage(message);
+    }
+
+    DeliverDatagrams();
+    CHECK_EQUAL(1, exchange.mResponses);
+    CHECK_EQUAL(Coap::kCodeNotFound, exchange.mResponseCode);
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+TEST(Coap, TestMessagePool)
+{
+    Coap::Message *messages[Coap::AgentNative::kMaxMessages];
+
+    agent = Coap::Agent::Create(NULL, NULL);
+
+    for (size_t i = 0; i < Coap::AgentNative::kMaxMessages; ++i)
+    {
+        messages[i] = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+        CHECK(messages[i] != NULL);
+    }
+
+    CHECK(agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0) == NULL);
+    CHECK_EQUAL(ENOBUFS, errno);
+
+    agent->FreeMessage(messages[0]);
+    messages[0] = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+    CHECK(messages[0] != NULL);
+
+    for (size_t i = 0; i < Coap::AgentNative::kMaxMessages; ++i)
+    {
+        agent->FreeMessage(messages[i]);
+    }
+
+    Coap::Agent::Destroy(agent);
+}
+
+static void HandleMethod(const Coap::Resource &aResource,
+                         const Coap::Message & aRequest,
+                         Coap::Message &       aResponse,
+                         const uint8_t *       aIp6,
+                         uint16_t              aPort,
+                         void *                aContext)
+{
+    aResponse.SetCode(aRequest.GetCode() == Coap::kCodeGet ? Coap::kCodeContent : Coap::kCodeChanged);
+
+    (void)aResource;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+}
+
+static Coap::Code Request(Coap::Agent &aClient, Coap::Code aMethod, const char *aPath)
+{
+    Exchange       exchange;
+    Coap::Message *message = aClient.NewMessage(Coap::kTypeConfirmable, aMethod, NULL, 0);
+
+    memset(&exchange, 0, sizeof(exchange));
+    message->SetPath(aPath);
+    aClient.Send(*message, NULL, 0, HandleExchangeResponse, &exchange);
+    aClient.FreeMessage(message);
+    DeliverDatagrams();
+    CHECK_EQUAL(1, exchange.mResponses);
+
+    return exchange.mResponseCode;
+}
+
+TEST(Coap, TestRouteMethods)
+{
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    Coap::Resource getter("d/dg", HandleMethod, NULL, Coap::kMethodGet);
+    Coap::Resource setter("d/dg", HandleMethod, NULL, Coap::kMethodPost | Coap::kMethodPut);
+    Coap::Resource conflict("/d/dg/", HandleMethod, NULL, Coap::kMethodPut);
+    Coap::Resource nested("d/dg/x", HandleMethod, NULL, Coap::kMethodAll);
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(getter));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(setter));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(nested));
+
+    // The same method can only be handled once for a path.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, server->AddResource(conflict));
+    CHECK_EQUAL(EEXIST, errno);
+
+    CHECK_EQUAL(Coap::kCodeContent, Request(*client, Coap::kCodeGet, "d/dg"));
+    CHECK_EQUAL(Coap::kCodeChanged, Request(*client, Coap::kCodePut, "d/dg"));
+    CHECK_EQUAL(Coap::kCodeMethodNotAllowed, Request(*client, Coap::kCodeDelete, "d/dg"));
+    CHECK_EQUAL(Coap::kCodeChanged, Request(*client, Coap::kCodeDelete, "d/dg/x"));
+    CHECK_EQUAL(Coap::kCodeNotFound, Request(*client, Coap::kCodeGet, "d"));
+    CHECK_EQUAL(Coap::kCodeNotFound, Request(*client, Coap::kCodeGet, "d/dg/y"));
+
+    // Codes of unknown methods go up to 0x3f, beyond the bits of the methods of resources.
+    CHECK_EQUAL(Coap::kCodeMethodNotAllowed, Request(*client, static_cast<Coap::Code>(0x05), "d/dg/x"));
+    CHECK_EQUAL(Coap::kCodeMethodNotAllowed, Request(*client, static_cast<Coap::Code>(0x25), "d/dg/x"));
+    CHECK_EQUAL(Coap::kCodeMethodNotAllowed, Request(*client, static_cast<Coap::Code>(0x3f), "d/dg/y"));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->RemoveResource(nested));
+    CHECK_EQUAL(Coap::kCodeNotFound, Request(*client, Coap::kCodeDelete, "d/dg/x"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->RemoveResource(getter));
+    CHECK_EQUAL(Coap::kCodeMethodNotAllowed, Request(*client, Coap::kCodeGet, "d/dg"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->RemoveResource(setter));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(conflict));
+    CHECK_EQUAL(Coap::kCodeChanged, Request(*client, Coap::kCodePut, "d/dg"));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, server->RemoveResource(getter));
+    CHECK_EQUAL(ENOENT, errno);
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+struct Dataset
+{
+    std::vector<uint8_t> mRequest;
+    std::vector<uint8_t> mResponse;
+    int                  mRequests;
+    int                  mResponses;
+};
+
+static uint8_t sDiagnostics[6000];
+
+static void HandleDataset(const Coap::Resource &aResource,
+                          const Coap::Message & aRequest,
+                          Coap::Message &       aResponse,
+                          const uint8_t *       aIp6,
+                          uint16_t              aPort,
+                          void *                aContext)
+{
+    Dataset &            dataset = *static_cast<Dataset *>(aContext);
+    uint16_t             length;
+    const uint8_t *      payload = aRequest.GetPayload(length);
+    std::vector<uint8_t> response(sDiagnostics, sDiagnostics + sizeof(sDiagnostics));
+
+    dataset.mRequest.assign(payload, payload + length);
+    dataset.mRequests++;
+
+    // The response is built in a buffer freed on return, like a handler's own stack.
+    aResponse.SetCode(Coap::kCodeChanged);
+    aResponse.SetPayload(&response[0], static_cast<uint16_t>(response.size()));
+
+    (void)aResource;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static void HandleDatasetResponse(const Coap::Message *aMessage, otbrError aError, void *aContext)
+{
+    Dataset &      dataset = *static_cast<Dataset *>(aContext);
+    uint16_t       length;
+    const uint8_t *payload;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aError);
+    payload = aMessage->GetPayload(length);
+    CHECK_EQUAL(Coap::kCodeChanged, aMessage->GetCode());
+    dataset.mResponse.assign(payload, payload + length);
+    dataset.mResponses++;
+}
+
+TEST(Coap, TestBlockwiseTransfer)
+{
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    Dataset        dataset;
+    Coap::Resource resource("c/as", HandleDataset, &dataset);
+    uint8_t        request[5000];
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    dataset.mRequests  = 0;
+    dataset.mResponses = 0;
+
+    for (size_t i = 0; i < sizeof(request); ++i)
+    {
+        request[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    for (size_t i = 0; i < sizeof(sDiagnostics); ++i)
+    {
+        sDiagnostics[i] = static_cast<uint8_t>(i * 13);
+    }
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, client->SetBlockSize(100));
+    CHECK_EQUAL(EINVAL, errno);
+    CHECK_EQUAL(OTBR_ERROR_NONE, client->SetBlockSize(64));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->SetBlockSize(64));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+        message->SetPath("c/as");
+        message->SetPayload(request, sizeof(request));
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, HandleDatasetResponse, &dataset));
+        client->FreeMessage(message);
+    }
+
+    // Both payloads go block by block, and handlers only see them whole.
+    sLargestDatagram = 0;
+    memset(request, 0, sizeof(request));
+    DeliverDatagrams();
+    CHECK_EQUAL(1, dataset.mRequests);
+    CHECK_EQUAL(1, dataset.mResponses);
+    CHECK_EQUAL(sizeof(request), dataset.mRequest.size());
+    CHECK_EQUAL(sizeof(sDiagnostics), dataset.mResponse.size());
+
+    for (size_t i = 0; i < dataset.mRequest.size(); ++i)
+    {
+        CHECK_EQUAL(static_cast<uint8_t>(i * 7), dataset.mRequest[i]);
+    }
+
+    CHECK(memcmp(sDiagnostics, &dataset.mResponse[0], sizeof(sDiagnostics)) == 0);
+    CHECK(sLargestDatagram <= 64 + 32);
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+static void HandleOversized(const Coap::Resource &aResource,
+                            const Coap::Message & aRequest,
+                            Coap::Message &       aResponse,
+                            const uint8_t *       aIp6,
+                            uint16_t              aPort,
+                            void *                aContext)
+{
+    std::vector<uint8_t> response(Coap::AgentNative::kMaxTransferSize + 1);
+
+    aResponse.SetCode(Coap::kCodeContent);
+    aResponse.SetPayload(&response[0], static_cast<uint16_t>(response.size()));
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+}
+
+TEST(Coap, TestResponseTooLarge)
+{
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    Coap::Resource resource("d/dg", HandleOversized, NULL, Coap::kMethodGet);
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    // A response beyond the block-wise limit can be neither kept nor referenced.
+    CHECK_EQUAL(Coap::kCodeInternalServerError, Request(*client, Coap::kCodeGet, "d/dg"));
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+static Coap::Code SendBlock1(Coap::Agent &aServer, uint32_t aBlock, uint32_t aSize1)
+{
+    static const uint8_t kBlock[64] = {0};
+    static uint16_t      sMessageId = 0x4321;
+    Coap::MessageNative  message;
+    Coap::MessageNative  response;
+    uint8_t              buffer[Coap::MessageNative::kMaxSize];
+    uint16_t             length;
+    uint32_t             size1;
+
+    // Each block is a new request, a message ID used again would be answered as a duplicate.
+    message.Init(Coap::kTypeConfirmable, Coap::kCodePost, sMessageId++, NULL, 0);
+    message.SetPath("c/as");
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddUintOption(Coap::kOptionSize1, aSize1));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddBlockOption(Coap::kOptionBlock1, aBlock, true, 2));
+    message.SetPayload(kBlock, sizeof(kBlock));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.Serialize(buffer, sizeof(buffer), length));
+
+    aServer.Input(buffer, length, NULL, 0);
+    CHECK_EQUAL(1, sDatagrams.size());
+    CHECK_EQUAL(OTBR_ERROR_NONE,
+                response.Parse(&sDatagrams[0].mData[0], static_cast<uint16_t>(sDatagrams[0].mData.size())));
+
+    if (response.GetCode() == Coap::kCodeRequestEntityTooLarge)
+    {
+        CHECK(response.GetUintOption(Coap::kOptionSize1, size1));
+        CHECK_EQUAL(Coap::AgentNative::kMaxTransferSize, size1);
+    }
+
+    sDatagrams.clear();
+
+    return response.GetCode();
+}
+
+TEST(Coap, TestBlockwiseRejected)
+{
+    Dataset        dataset;
+    Coap::Resource resource("c/as", HandleDataset, &dataset);
+
+    agent = Coap::Agent::Create(QueueDatagram, &agent);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->AddResource(resource));
+
+    // The reassembly buffer is bounded, and blocks must come in order.
+    CHECK_EQUAL(Coap::kCodeRequestEntityTooLarge, SendBlock1(*agent, 0, Coap::AgentNative::kMaxTransferSize + 1));
+    CHECK_EQUAL(Coap::kCodeRequestEntityIncomplete, SendBlock1(*agent, 1, 128));
+    CHECK_EQUAL(Coap::kCodeContinue, SendBlock1(*agent, 0, 128));
+    CHECK_EQUAL(Coap::kCodeRequestEntityIncomplete, SendBlock1(*agent, 2, 128));
+
+    Coap::Agent::Destroy(agent);
+}
+
+static void HandleCounter(const Coap::Resource &aResource,
+                          const Coap::Message & aRequest,
+                          Coap::Message &       aResponse,
+                          const uint8_t *       aIp6,
+                          uint16_t              aPort,
+                          void *                aContext)
+{
+    uint8_t *counter = static_cast<uint8_t *>(aContext);
+
+    aResponse.SetCode(Coap::kCodeContent);
+    aResponse.SetPayload(counter, sizeof(*counter));
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static void Observe(Coap::Agent &aServer, uint16_t aMessageId, uint8_t aToken, uint32_t aObserve)
+{
+    Coap::MessageNative message;
+    uint8_t             buffer[Coap::MessageNative::kMaxSize];
+    uint16_t            length;
+
+    message.Init(Coap::kTypeConfirmable, Coap::kCodeGet, aMessageId, &aToken, sizeof(aToken));
+    message.SetPath("s/ts");
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddUintOption(Coap::kOptionObserve, aObserve));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.Serialize(buffer, sizeof(buffer), length));
+    aServer.Input(buffer, length, NULL, 0);
+}
+
+static std::vector<uint8_t> sReceived;
+
+static void Receive(Coap::MessageNative &aMessage)
+{
+    CHECK_EQUAL(1, sDatagrams.size());
+    sReceived = sDatagrams[0].mData;
+    sDatagrams.clear();
+    CHECK_EQUAL(OTBR_ERROR_NONE, aMessage.Parse(&sReceived[0], static_cast<uint16_t>(sReceived.size())));
+}
+
+TEST(Coap, TestObserve)
+{
+    uint8_t             counter = 1;
+    Coap::Resource      resource("s/ts", HandleCounter, &counter, Coap::kMethodGet);
+    Coap::MessageNative message;
+    uint32_t            sequence;
+    uint16_t            length;
+    uint8_t             token;
+
+    agent = Coap::Agent::Create(QueueDatagram, &agent);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->AddResource(resource));
+
+    // Registration is answered with the current state.
+    Observe(*agent, 1, 0xa0, 0);
+    Receive(message);
+    CHECK_EQUAL(Coap::kCodeContent, message.GetCode());
+    CHECK(message.GetUintOption(Coap::kOptionObserve, sequence));
+    CHECK_EQUAL(1, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+
+    // Registering again with the same token replaces the former registration.
+    Observe(*agent, 2, 0xa0, 0);
+    Receive(message);
+    CHECK_EQUAL(1, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+
+    counter = 2;
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+    Receive(message);
+    CHECK_EQUAL(Coap::kTypeNonConfirmable, message.GetType());
+    CHECK_EQUAL(0xa0, *message.GetToken(token));
+    CHECK_EQUAL(2, *message.GetPayload(length));
+    CHECK(message.GetUintOption(Coap::kOptionObserve, sequence) && sequence > 0);
+
+    // An observer resets a notification to stop observing.
+    {
+        Coap::MessageNative reset;
+        uint8_t             buffer[Coap::MessageNative::kMaxSize];
+
+        reset.Init(Coap::kTypeReset, Coap::kCodeEmpty, message.GetMessageId(), NULL, 0);
+        CHECK_EQUAL(OTBR_ERROR_NONE, reset.Serialize(buffer, sizeof(buffer), length));
+        agent->Input(buffer, length, NULL, 0);
+        CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+    }
+
+    // Or deregisters.
+    Observe(*agent, 3, 0xa1, 0);
+    Receive(message);
+    CHECK_EQUAL(1, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+    Observe(*agent, 4, 0xa1, 1);
+    Receive(message);
+    CHECK(!message.GetUintOption(Coap::kOptionObserve, sequence));
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+
+    // Observers go along with the resource.
+    Observe(*agent, 5, 0xa2, 0);
+    Receive(message);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->RemoveResource(resource));
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+    CHECK(sDatagrams.empty());
+
+    Coap::Agent::Destroy(agent);
+}
+
+TEST(Coap, TestObserveConfirmable)
+{
+    FakeClock           clock(1000000);
+    uint8_t             counter = 1;
+    Coap::Resource      resource("s/ts", HandleCounter, &counter, Coap::kMethodGet);
+    Coap::MessageNative message;
+
+    SetClock(&clock);
+    agent = Coap::Agent::Create(QueueDatagram, &agent);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->AddResource(resource));
+    Observe(*agent, 1, 0xb0, 0);
+    Receive(message);
+
+    // Frequent notifications are confirmed every kNotifyConfirmCount.
+    for (int i = 1; i < Coap::AgentNative::kNotifyConfirmCount; ++i)
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+        Receive(message);
+        CHECK_EQUAL(Coap::kTypeNonConfirmable, message.GetType());
+    }
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+    Receive(message);
+    CHECK_EQUAL(Coap::kTypeConfirmable, message.GetType());
+
+    // An observer not acknowledging is removed once retransmissions run out.
+    for (int i = 0; i < 300 && static_cast<Coap::AgentNative *>(agent)->GetPendingCount() > 0; ++i)
+    {
+        sDatagrams.clear();
+        clock.Advance(1000000);
+        agent->Process();
+    }
+
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+
+    // Rare notifications are confirmed at least daily, and an observer resetting one is removed.
+    Observe(*agent, 2, 0xb1, 0);
+    Receive(message);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+    Receive(message);
+    CHECK_EQUAL(Coap::kTypeNonConfirmable, message.GetType());
+    clock.Advance(static_cast<uint64_t>(Coap::AgentNative::kNotifyConfirmPeriod) * 1000000);
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->Notify(resource));
+    Receive(message);
+    CHECK_EQUAL(Coap::kTypeConfirmable, message.GetType());
+
+    {
+        Coap::MessageNative reset;
+        uint8_t             buffer[Coap::MessageNative::kMaxSize];
+        uint16_t            length;
+
+        reset.Init(Coap::kTypeReset, Coap::kCodeEmpty, message.GetMessageId(), NULL, 0);
+        CHECK_EQUAL(OTBR_ERROR_NONE, reset.Serialize(buffer, sizeof(buffer), length));
+        agent->Input(buffer, length, NULL, 0);
+    }
+
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetObserverCount(resource));
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(agent)->GetPendingCount());
+
+    Coap::Agent::Destroy(agent);
+    SetClock(NULL);
+}
+
+TEST(Coap, TestDuplicateRequest)
+{
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    uint8_t        counter = 1;
+    Coap::Resource resource("a/b", HandleCounter, &counter, Coap::kMethodPost);
+    TestContext    context;
+    Datagram       request;
+
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&context, 0, sizeof(context));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+        message->SetPath("a/b");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, TestResponseHandler, &context));
+        client->FreeMessage(message);
+    }
+
+    // The response is lost, the retransmitted request gets the same response without being handled again.
+    CHECK_EQUAL(1, sDatagrams.size());
+    request = sDatagrams[0];
+    server->Input(&request.mData[0], static_cast<uint16_t>(request.mData.size()), NULL, 0);
+    CHECK_EQUAL(2, sDatagrams.size());
+    counter = 2;
+    server->Input(&request.mData[0], static_cast<uint16_t>(request.mData.size()), NULL, 0);
+    CHECK_EQUAL(3, sDatagrams.size());
+    CHECK(sDatagrams[1].mData == sDatagrams[2].mData);
+
+    sDatagrams.erase(sDatagrams.begin(), sDatagrams.begin() + 2);
+    DeliverDatagrams();
+    CHECK_EQUAL(true, context.mResponseHandled);
+    CHECK_EQUAL(OTBR_ERROR_NONE, context.mResponseError);
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+}
+
+TEST(Coap, TestRequestReset)
+{
+    Coap::Agent *       client;
+    TestContext         context;
+    Coap::MessageNative message;
+    uint8_t             buffer[Coap::MessageNative::kMaxSize];
+    uint16_t            length;
+
+    client = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&context, 0, sizeof(context));
+
+    {
+        Coap::Message *request = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+        request->SetPath("a/b");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*request, NULL, 0, TestResponseHandler, &context));
+        client->FreeMessage(request);
+    }
+
+    // A peer rejecting the request fails it at once.
+    Receive(message);
+    message.Init(Coap::kTypeReset, Coap::kCodeEmpty, message.GetMessageId(), NULL, 0);
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.Serialize(buffer, sizeof(buffer), length));
+    client->Input(buffer, length, NULL, 0);
+    CHECK_EQUAL(true, context.mResponseHandled);
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, context.mResponseError);
+    CHECK_EQUAL(ECONNRESET, context.mResponseErrno);
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    Coap::Agent::Destroy(client);
+}
+
+TEST(Coap, TestRtoEstimator)
+{
+    Coap::RtoEstimator estimator;
+
+    CHECK_EQUAL(Coap::RtoEstimator::kInitialRto, estimator.GetRto(0));
+
+    // A strong sample of 100 ms gives RTO 100 + 4 * 50, averaged with the former RTO.
+    estimator.Update(100, true, 0);
+    CHECK_EQUAL(100, estimator.GetStrongRtt());
+    CHECK_EQUAL(0, estimator.GetWeakRtt());
+    CHECK_EQUAL((300 + 2000) / 2, estimator.GetRto(0));
+
+    // A weak sample weighs less.
+    estimator.Update(3000, false, 0);
+    CHECK_EQUAL(3000, estimator.GetWeakRtt());
+    CHECK_EQUAL((4500 + 3 * 1150) / 4, estimator.GetRto(0));
+
+    // Short timeouts back off faster than long ones.
+    CHECK_EQUAL(1500, Coap::RtoEstimator::Backoff(500, 500));
+    CHECK_EQUAL(4000, Coap::RtoEstimator::Backoff(2000, 2000));
+    CHECK_EQUAL(6000, Coap::RtoEstimator::Backoff(4000, 4000));
+    CHECK_EQUAL(Coap::RtoEstimator::kMaxRto, Coap::RtoEstimator::Backoff(50000, 2000));
+
+    // An estimate not refreshed for long moves toward the initial RTO.
+    estimator.Reset(0);
+    estimator.Update(20, true, 0);
+    CHECK_EQUAL(1030, estimator.GetRto(0));
+    estimator.Update(20, true, 0);
+    CHECK_EQUAL(539, estimator.GetRto(0));
+    CHECK_EQUAL(539, estimator.GetRto(16 * 539 - 1));
+    CHECK_EQUAL(2 * 539, estimator.GetRto(16 * 539));
+}
+
+static void DeliverDatagrams(FakeClock &aClock, unsigned long aDelay)
+{
+    while (!sDatagrams.empty())
+    {
+        Datagram datagram = sDatagrams.front();
+
+        aClock.Advance(aDelay * 1000);
+        sDatagrams.erase(sDatagrams.begin());
+        datagram.mReceiver->Input(&datagram.mData[0], static_cast<uint16_t>(datagram.mData.size()), NULL, 0);
+    }
+}
+
+TEST(Coap, TestRetransmission)
+{
+    FakeClock                  clock(1000000);
+    Coap::Agent *                  client;
+    Coap::Agent *                  server;
+    TestContext                    context;
+    Coap::Resource                 resource("a/b", TestRequestHandler, &context);
+    Coap::AgentNative::PeerMetrics metrics;
+    timeval                        timeout = {10, 0};
+
+    SetClock(&clock);
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&context, 0, sizeof(context));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, static_cast<Coap::AgentNative *>(client)->GetPeerMetrics(NULL, 0, metrics));
+    CHECK_EQUAL(ENOENT, errno);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+        message->SetPath("a/b");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, TestResponseHandler, &context));
+        client->FreeMessage(message);
+    }
+
+    // Only NSTART requests go at once, and the first one is lost.
+    CHECK_EQUAL(1, sDatagrams.size());
+    sDatagrams.clear();
+    CHECK_EQUAL(OTBR_ERROR_NONE, static_cast<Coap::AgentNative *>(client)->GetPeerMetrics(NULL, 0, metrics));
+    CHECK_EQUAL(1, metrics.mOutstanding);
+    CHECK_EQUAL(1, metrics.mQueued);
+
+    client->UpdateTimeout(timeout);
+    CHECK(timeout.tv_sec * 1000 + timeout.tv_usec / 1000 >= Coap::RtoEstimator::kInitialRto);
+    CHECK(timeout.tv_sec * 1000 + timeout.tv_usec / 1000 <= Coap::RtoEstimator::kInitialRto * 3 / 2);
+
+    clock.Advance(1000000);
+    client->Process();
+    CHECK(sDatagrams.empty());
+
+    clock.Advance(2000000);
+    client->Process();
+    CHECK_EQUAL(1, sDatagrams.size());
+
+    // The retransmission is answered, which lets the queued request go.
+    DeliverDatagrams(clock, 50);
+    CHECK_EQUAL(OTBR_ERROR_NONE, static_cast<Coap::AgentNative *>(client)->GetPeerMetrics(NULL, 0, metrics));
+    CHECK_EQUAL(0, metrics.mOutstanding);
+    CHECK_EQUAL(0, metrics.mQueued);
+    CHECK_EQUAL(3, metrics.mTransmissions);
+    CHECK_EQUAL(1, metrics.mRetransmissions);
+    CHECK_EQUAL(3100, metrics.mWeakRtt);
+    CHECK_EQUAL(100, metrics.mStrongRtt);
+    CHECK(metrics.mRto < Coap::RtoEstimator::kInitialRto);
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    // A peer never answering is given up after MAX_RETRANSMIT retransmissions.
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+        size_t         transmissions = 0;
+
+        message->SetPath("a/b");
+        context.mResponseHandled = false;
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, TestResponseHandler, &context));
+        client->FreeMessage(message);
+
+        for (int i = 0; i < 300 && static_cast<Coap::AgentNative *>(client)->GetPendingCount() > 0; ++i)
+        {
+            transmissions += sDatagrams.size();
+            sDatagrams.clear();
+            clock.Advance(1000000);
+            client->Process();
+        }
+
+        CHECK_EQUAL(Coap::AgentNative::kMaxRetransmit + 1, transmissions);
+        CHECK_EQUAL(OTBR_ERROR_NONE, static_cast<Coap::AgentNative *>(client)->GetPeerMetrics(NULL, 0, metrics));
+        CHECK_EQUAL(1, metrics.mTimeouts);
+        CHECK_EQUAL(0, metrics.mOutstanding);
+
+        // The handler learns the request failed.
+        CHECK_EQUAL(true, context.mResponseHandled);
+        CHECK_EQUAL(OTBR_ERROR_ERRNO, context.mResponseError);
+        CHECK_EQUAL(ETIMEDOUT, context.mResponseErrno);
+    }
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+    SetClock(NULL);
+}
+
+TEST(Coap, TestExchangeExpiration)
+{
+    FakeClock      clock(1000000);
+    Coap::Agent *  client;
+    Coap::Agent *  server;
+    Exchange       exchange;
+    TestContext    context;
+    Coap::Resource resource("a/b", DeferRequest, &exchange);
+    timeval        timeout = {1000, 0};
+
+    SetClock(&clock);
+    client = Coap::Agent::Create(QueueDatagram, &server);
+    server = Coap::Agent::Create(QueueDatagram, &client);
+    memset(&exchange, 0, sizeof(exchange));
+    memset(&context, 0, sizeof(context));
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->AddResource(resource));
+
+    {
+        Coap::Message *message = client->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+
+        message->SetPath("a/b");
+        CHECK_EQUAL(OTBR_ERROR_NONE, client->Send(*message, NULL, 0, TestResponseHandler, &context));
+        client->FreeMessage(message);
+    }
+
+    // The request is acknowledged, but the separate response never comes.
+    DeliverDatagrams();
+    CHECK(exchange.mRequest != NULL);
+    CHECK_EQUAL(1, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    // The main loop is woken up when the exchange expires.
+    client->UpdateTimeout(timeout);
+    CHECK_EQUAL(Coap::AgentNative::kExchangeLifetime, timeout.tv_sec * 1000 + timeout.tv_usec / 1000);
+
+    clock.Advance((Coap::AgentNative::kExchangeLifetime - 1) * 1000);
+    client->Process();
+    CHECK_EQUAL(false, context.mResponseHandled);
+
+    // Processing alone fails the exchange, without sending another request.
+    clock.Advance(1000);
+    client->Process();
+    CHECK(sDatagrams.empty());
+    CHECK_EQUAL(true, context.mResponseHandled);
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, context.mResponseError);
+    CHECK_EQUAL(ETIMEDOUT, context.mResponseErrno);
+    CHECK_EQUAL(0, static_cast<Coap::AgentNative *>(client)->GetPendingCount());
+
+    Coap::Agent::Destroy(client);
+    Coap::Agent::Destroy(server);
+    SetClock(NULL);
+}
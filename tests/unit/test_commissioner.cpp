@@ -0,0 +1,525 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "agent/uris.hpp"
+#include "commissioner/commissioner.hpp"
+#include "common/coap.hpp"
+#include "common/coap_native.hpp"
+#include "common/dtls.hpp"
+#include "common/event_loop.hpp"
+#include "common/time.hpp"
+#include "common/tlv.hpp"
+
+using namespace ot;
+using namespace ot::BorderRouter;
+
+enum
+{
+    kLeaderPort = 49390,
+    kJoinerPort = 49400,
+};
+
+static const uint8_t kPSKc[] = {0xc3, 0xf5, 0x9e, 0x8b, 0x8a, 0xe1, 0x3d, 0x04,
+                                0xb3, 0xb8, 0x1b, 0x1a, 0x28, 0x64, 0x73, 0x8e};
+
+/**
+ * The leader answers the petitions and keep alives of the commissioner through a DTLS server of its own.
+ *
+ */
+struct TestLeader
+{
+    EventLoop *    mEventLoop;
+    Dtls::Server * mServer;
+    Dtls::Session *mSession;
+    Coap::Agent *  mCoap;
+    int8_t         mState; ///< The state answered
+    bool           mMuted;           ///< Whether requests are dropped
+    int            mDropped;         ///< Number of requests dropped, retransmissions included
+    int            mDroppedRequests; ///< Number of requests dropped, retransmissions excluded
+    uint16_t       mDroppedId;       ///< Message id of the last request dropped
+    int            mPetitions;
+    int            mKeepAlives;
+};
+
+static TestLeader sLeader;
+
+/**
+ * The event loop of a test, created once the fake clock is set, and destroyed after the commissioner.
+ *
+ */
+class TestEventLoop
+{
+public:
+    explicit TestEventLoop(FakeClock &aClock)
+        : mEventLoop(NULL)
+    {
+        SetClock(&aClock);
+        mEventLoop = EventLoop::Create();
+    }
+
+    ~TestEventLoop(void)
+    {
+        EventLoop::Destroy(mEventLoop);
+        SetClock(NULL);
+    }
+
+    operator EventLoop &(void) { return *mEventLoop; }
+
+private:
+    EventLoop *mEventLoop;
+};
+
+static void Reply(TestLeader &aLeader, Coap::Message &aResponse)
+{
+    uint8_t buffer[16];
+    Tlv *   tlv = reinterpret_cast<Tlv *>(buffer);
+
+    tlv->SetType(Meshcop::kState);
+    tlv->SetValue(aLeader.mState);
+    tlv = tlv->GetNext();
+
+    tlv->SetType(Meshcop::kCommissionerSessionId);
+    tlv->SetValue(static_cast<uint16_t>(0x1234));
+    tlv = tlv->GetNext();
+
+    aResponse.SetCode(Coap::kCodeChanged);
+    aResponse.SetPayload(buffer, static_cast<uint16_t>(reinterpret_cast<uint8_t *>(tlv) - buffer));
+}
+
+static void HandlePetition(const Coap::Resource &aResource,
+                           const Coap::Message & aRequest,
+                           Coap::Message &       aResponse,
+                           const uint8_t *       aIp6,
+                           uint16_t              aPort,
+                           void *                aContext)
+{
+    TestLeader &leader = *static_cast<TestLeader *>(aContext);
+
+    ++leader.mPetitions;
+    Reply(leader, aResponse);
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static void HandleKeepAlive(const Coap::Resource &aResource,
+                            const Coap::Message & aRequest,
+                            Coap::Message &       aResponse,
+                            const uint8_t *       aIp6,
+                            uint16_t              aPort,
+                            void *                aContext)
+{
+    TestLeader &leader = *static_cast<TestLeader *>(aContext);
+
+    ++leader.mKeepAlives;
+    Reply(leader, aResponse);
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aIp6;
+    (void)aPort;
+}
+
+static void HandleLeaderData(const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+{
+    TestLeader &leader = *static_cast<TestLeader *>(aContext);
+
+    if (!leader.mMuted)
+    {
+        leader.mCoap->Input(aBuffer, aLength, NULL, 0);
+    }
+    else
+    {
+        Coap::MessageNative message;
+
+        // Retransmissions keep the message id of the request.
+        if (message.Parse(aBuffer, aLength) == OTBR_ERROR_NONE &&
+            (leader.mDropped == 0 || message.GetMessageId() != leader.mDroppedId))
+        {
+            ++leader.mDroppedRequests;
+            leader.mDroppedId = message.GetMessageId();
+        }
+
+        ++leader.mDropped;
+    }
+}
+
+static void HandleLeaderSession(Dtls::Session &aSession, Dtls::Session::State aState, void *aContext)
+{
+    TestLeader &leader = *static_cast<TestLeader *>(aContext);
+
+    if (aState == Dtls::Session::kStateReady)
+    {
+        leader.mSession = &aSession;
+        aSession.SetDataHandler(HandleLeaderData, &leader);
+    }
+    else if (aState == Dtls::Session::kStateClose && leader.mSession == &aSession)
+    {
+        leader.mSession = NULL;
+    }
+}
+
+static ssize_t SendLeaderCoap(const uint8_t *aBuffer,
+                              uint16_t       aLength,
+                              const uint8_t *aIp6,
+                              uint16_t       aPort,
+                              void *         aContext)
+{
+    TestLeader &leader = *static_cast<TestLeader *>(aContext);
+
+    (void)aIp6;
+    (void)aPort;
+
+    return leader.mSession != NULL ? leader.mSession->Write(aBuffer, aLength) : -1;
+}
+
+/**
+ * This function runs the commissioner and the leader for one round, timers only move with the fake clock.
+ *
+ */
+static void Run(TestLeader &aLeader)
+{
+    timeval timeout = {0, 10000};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aLeader.mEventLoop->Poll(timeout));
+}
+
+static void Run(TestLeader &aLeader, int aRounds)
+{
+    for (int i = 0; i < aRounds; ++i)
+    {
+        Run(aLeader);
+    }
+}
+
+static void Advance(FakeClock &aClock, TestLeader &aLeader, unsigned long aDelay)
+{
+    aClock.Advance(static_cast<uint64_t>(aDelay) * 1000);
+    Run(aLeader, 5);
+}
+
+static const Coap::Resource kPetition(OT_URI_PATH_COMMISSIONER_PETITION, HandlePetition, &sLeader);
+static const Coap::Resource kKeepAlive(OT_URI_PATH_COMMISSIONER_KEEP_ALIVE, HandleKeepAlive, &sLeader);
+
+static void StartLeader(TestLeader &aLeader, EventLoop &aEventLoop, int8_t aState)
+{
+    memset(&aLeader, 0, sizeof(aLeader));
+    aLeader.mEventLoop = &aEventLoop;
+    aLeader.mState     = aState;
+    aLeader.mServer    = Dtls::Server::Create(aEventLoop, kLeaderPort, HandleLeaderSession, &aLeader);
+    aLeader.mCoap      = Coap::Agent::Create(SendLeaderCoap, &aLeader);
+    aLeader.mServer->SetPSK(kPSKc, sizeof(kPSKc));
+    aLeader.mServer->SetSeed(reinterpret_cast<const uint8_t *>("leader"), 6);
+    CHECK_EQUAL(OTBR_ERROR_NONE, aLeader.mServer->Start());
+    CHECK_EQUAL(OTBR_ERROR_NONE, aLeader.mCoap->AddResource(kPetition));
+    CHECK_EQUAL(OTBR_ERROR_NONE, aLeader.mCoap->AddResource(kKeepAlive));
+}
+
+static void StopLeader(TestLeader &aLeader)
+{
+    Coap::Agent::Destroy(aLeader.mCoap);
+    Dtls::Server::Destroy(aLeader.mServer);
+}
+
+/**
+ * This function connects the commissioner to the leader, until the first petition is answered.
+ *
+ */
+static void Connect(Commissioner &aCommissioner, TestLeader &aLeader)
+{
+    CHECK_EQUAL(0, aCommissioner.InitDtls("::1", "49390"));
+    aLeader.mEventLoop->AddProcessor(aCommissioner);
+
+    for (int round = 0; round < 1000 && aLeader.mPetitions == 0; ++round)
+    {
+        Run(aLeader);
+    }
+
+    CHECK_EQUAL(1, aLeader.mPetitions);
+    Run(aLeader, 5);
+}
+
+static void RelayJoiner(TestLeader &aLeader, uint8_t aJoiner)
+{
+    static const uint8_t kClientHello[] = {0x16, 0xfe, 0xfd};
+    uint8_t              iid[kJoinerIidLength];
+    uint8_t              buffer[64];
+    Tlv *                tlv   = reinterpret_cast<Tlv *>(buffer);
+    uint16_t             token = aJoiner;
+    Coap::Message *      message;
+
+    memset(iid, aJoiner, sizeof(iid));
+
+    tlv->SetType(Meshcop::kJoinerUdpPort);
+    tlv->SetValue(static_cast<uint16_t>(1000));
+    tlv = tlv->GetNext();
+
+    tlv->SetType(Meshcop::kJoinerIid);
+    tlv->SetValue(iid, sizeof(iid));
+    tlv = tlv->GetNext();
+
+    tlv->SetType(Meshcop::kJoinerRouterLocator);
+    tlv->SetValue(static_cast<uint16_t>(0x0400));
+    tlv = tlv->GetNext();
+
+    tlv->SetType(Meshcop::kJoinerDtlsEncapsulation);
+    tlv->SetValue(kClientHello, sizeof(kClientHello));
+    tlv = tlv->GetNext();
+
+    message = aLeader.mCoap->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost,
+                                        reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+    message->SetPath(OT_URI_PATH_RELAY_RX);
+    message->SetPayload(buffer, static_cast<uint16_t>(reinterpret_cast<uint8_t *>(tlv) - buffer));
+    CHECK_EQUAL(OTBR_ERROR_NONE, aLeader.mCoap->Send(*message, NULL, 0, NULL, NULL));
+    aLeader.mCoap->FreeMessage(message);
+}
+
+TEST_GROUP(Commissioner){};
+
+TEST(Commissioner, TestPetitionRetry)
+{
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, 0, kMaxJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateRejected);
+    Connect(commissioner, leader);
+    CHECK(commissioner.IsValid());
+    CHECK(!commissioner.IsCommissionerAccepted());
+
+    // The first retry is kPetitionAttemptDelay later, with up to half of it added.
+    Advance(clock, leader, kPetitionAttemptDelay * 1000 - 1);
+    CHECK_EQUAL(1, leader.mPetitions);
+    Advance(clock, leader, kPetitionAttemptDelay * 500 + 1);
+    CHECK_EQUAL(2, leader.mPetitions);
+
+    // The delay doubles for the next retry.
+    Advance(clock, leader, kPetitionAttemptDelay * 2000 - 1);
+    CHECK_EQUAL(2, leader.mPetitions);
+    Advance(clock, leader, kPetitionAttemptDelay * 1000 + 1);
+    CHECK_EQUAL(3, leader.mPetitions);
+
+    // The commissioner gives up after kPetitionMaxRetry retries.
+    CHECK(!commissioner.IsValid());
+    Advance(clock, leader, kPetitionAttemptDelay * 8000);
+    CHECK_EQUAL(kPetitionMaxRetry + 1, leader.mPetitions);
+
+    StopLeader(leader);
+}
+
+TEST(Commissioner, TestPetitionTimeout)
+{
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, 0, kMaxJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateRejected);
+    Connect(commissioner, leader);
+    CHECK_EQUAL(1, leader.mPetitions);
+
+    // A petition never answered is retried once the CoAP agent gives up on it, not while it retransmits.
+    leader.mMuted = true;
+
+    for (int i = 0; i < 120 && leader.mDroppedRequests < 2; ++i)
+    {
+        Advance(clock, leader, 1000);
+    }
+
+    CHECK_EQUAL(2, leader.mDroppedRequests);
+    CHECK_EQUAL(Coap::AgentNative::kMaxRetransmit + 2, leader.mDropped);
+    CHECK(commissioner.IsValid());
+
+    // The last retry is answered, which gives up the petition.
+    leader.mMuted = false;
+
+    for (int i = 0; i < 60 && leader.mPetitions < 2; ++i)
+    {
+        Advance(clock, leader, 1000);
+    }
+
+    CHECK_EQUAL(2, leader.mPetitions);
+    CHECK(!commissioner.IsValid());
+
+    StopLeader(leader);
+}
+
+TEST(Commissioner, TestKeepAlive)
+{
+    enum
+    {
+        kKeepAliveRate = 40,
+    };
+
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, kKeepAliveRate, kMaxJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateAccepted);
+    Connect(commissioner, leader);
+    CHECK(commissioner.IsCommissionerAccepted());
+
+    // Keep alives are sent up to a tenth of the period early, never late.
+    for (int i = 1; i <= 3; ++i)
+    {
+        Advance(clock, leader, kKeepAliveRate * 900 - 1);
+        CHECK_EQUAL(i - 1, leader.mKeepAlives);
+        Advance(clock, leader, kKeepAliveRate * 100 + 1);
+        CHECK_EQUAL(i, leader.mKeepAlives);
+        CHECK(commissioner.IsCommissionerAccepted());
+    }
+
+    // A rejected keep alive petitions again.
+    leader.mState = Meshcop::kStateRejected;
+    Advance(clock, leader, kKeepAliveRate * 1000);
+    CHECK_EQUAL(4, leader.mKeepAlives);
+    CHECK(!commissioner.IsCommissionerAccepted());
+    leader.mState = Meshcop::kStateAccepted;
+    Advance(clock, leader, kPetitionAttemptDelay * 1500);
+    CHECK_EQUAL(2, leader.mPetitions);
+    CHECK(commissioner.IsCommissionerAccepted());
+
+    StopLeader(leader);
+}
+
+TEST(Commissioner, TestResign)
+{
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, 0, kMaxJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateAccepted);
+    Connect(commissioner, leader);
+    CHECK(commissioner.IsCommissionerAccepted());
+
+    // An unanswered resignation is over once the CoAP agent gives up retransmitting it.
+    leader.mMuted = true;
+    commissioner.Resign();
+    Run(leader, 5);
+    CHECK_EQUAL(0, leader.mKeepAlives);
+    CHECK(commissioner.IsValid());
+
+    Advance(clock, leader, 10000);
+    CHECK(commissioner.IsValid());
+
+    for (int i = 0; i < 90 && commissioner.IsValid(); ++i)
+    {
+        Advance(clock, leader, 1000);
+    }
+
+    CHECK(!commissioner.IsValid());
+    CHECK_EQUAL(1, leader.mDroppedRequests);
+    CHECK_EQUAL(Coap::AgentNative::kMaxRetransmit + 1, leader.mDropped);
+
+    StopLeader(leader);
+}
+
+TEST(Commissioner, TestResignAnswered)
+{
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, 0, kMaxJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateAccepted);
+    Connect(commissioner, leader);
+
+    // The resignation is over once the leader answers.
+    commissioner.Resign();
+    Run(leader, 5);
+    CHECK_EQUAL(1, leader.mKeepAlives);
+    CHECK(!commissioner.IsValid());
+
+    StopLeader(leader);
+}
+
+TEST(Commissioner, TestJoinerTableFull)
+{
+    enum
+    {
+        kKeepAliveRate = 30,
+        kMaxTestJoiners = 2,
+    };
+
+    FakeClock     clock(1000000);
+    TestEventLoop eventLoop(clock);
+    TestLeader &  leader = sLeader;
+    Commissioner  commissioner(eventLoop, kPSKc, kKeepAliveRate, kMaxTestJoiners, kJoinerPort);
+
+    StartLeader(leader, eventLoop, Meshcop::kStateAccepted);
+    Connect(commissioner, leader);
+    SteeringData steeringData;
+
+    steeringData.Init(kSteeringDefaultLength);
+    steeringData.Set();
+    commissioner.SetJoiner("J01NME", steeringData);
+    Run(leader, 5);
+
+    RelayJoiner(leader, 1);
+    RelayJoiner(leader, 2);
+    Run(leader, 5);
+    CHECK_EQUAL(kMaxTestJoiners, commissioner.GetNumActiveJoiners());
+
+    // A joiner beyond the table is dropped, and served once it retransmits to a free entry.
+    RelayJoiner(leader, 3);
+    Run(leader, 5);
+    CHECK_EQUAL(kMaxTestJoiners, commissioner.GetNumActiveJoiners());
+
+    // Keep alives keep the session to the leader while joiners time out.
+    for (int i = 0; i < kJoinerTimeout / (kKeepAliveRate * 1000); ++i)
+    {
+        if (i == 2)
+        {
+            RelayJoiner(leader, 1);
+            Run(leader, 5);
+        }
+        Advance(clock, leader, kKeepAliveRate * 1000);
+        CHECK(commissioner.IsCommissionerAccepted());
+    }
+
+    CHECK_EQUAL(1, commissioner.GetNumActiveJoiners());
+
+    RelayJoiner(leader, 3);
+    Run(leader, 5);
+    CHECK_EQUAL(kMaxTestJoiners, commissioner.GetNumActiveJoiners());
+
+    // Only the joiners still active are kept.
+    Advance(clock, leader, kKeepAliveRate * 1000 * 2);
+    CHECK_EQUAL(1, commissioner.GetNumActiveJoiners());
+
+    StopLeader(leader);
+}
@@ -0,0 +1,336 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "agent/commissioner_server.hpp"
+#include "common/event_loop.hpp"
+#include "common/time.hpp"
+#include "utils/strcpy_utils.hpp"
+
+using namespace ot::BorderRouter;
+
+static const char    kTestSocketName[] = "/tmp/otbr-test-commissioner.sock";
+static const uint8_t kTestPSKc[]       = {0xc3, 0xf5, 0x9e, 0x8b, 0x8a, 0xe1, 0x3d, 0x04,
+                                    0xb3, 0xb8, 0x1b, 0x1a, 0x28, 0x64, 0x73, 0x8e};
+
+class FakeCommissionerController : public Ncp::Controller
+{
+public:
+    FakeCommissionerController(void)
+        : mStarted(false)
+        , mHasEui64(false)
+        , mTimeout(0)
+        , mDeferResults(false)
+    {
+        memset(mEui64, 0, sizeof(mEui64));
+        memset(mPskd, 0, sizeof(mPskd));
+    }
+
+    otbrError Init(EventLoop &) { return OTBR_ERROR_NONE; }
+    otbrError CommissionerStart(void)
+    {
+        mStarted = true;
+        return Accept(Ncp::kCommissionerRequestStart);
+    }
+    otbrError CommissionerStop(void)
+    {
+        mStarted = false;
+        return Accept(Ncp::kCommissionerRequestStop);
+    }
+    otbrError CommissionerAddJoiner(const uint8_t *aEui64, const char *aPskd, uint32_t aTimeout)
+    {
+        mHasEui64 = (aEui64 != NULL);
+        if (mHasEui64)
+        {
+            memcpy(mEui64, aEui64, sizeof(mEui64));
+        }
+        strcpy_safe(mPskd, sizeof(mPskd), aPskd);
+        mTimeout = aTimeout;
+        return Accept(Ncp::kCommissionerRequestAddJoiner);
+    }
+    otbrError Accept(Ncp::CommissionerRequest aRequest)
+    {
+        // Results are emitted at once, as the OpenThread controller does, unless the test emits them.
+        if (!mDeferResults)
+        {
+            Emit<Ncp::kEventCommissionerResult>(aRequest, 0);
+        }
+        return OTBR_ERROR_NONE;
+    }
+#if OTBR_ENABLE_NCP_WPANTUND
+    otbrError UdpForwardSend(const uint8_t *, uint16_t, uint16_t, const in6_addr &, uint16_t)
+    {
+        return OTBR_ERROR_NONE;
+    }
+#endif
+    otbrError RequestEvent(int) { return OTBR_ERROR_NONE; }
+
+    bool     mStarted;
+    bool     mHasEui64;
+    uint8_t  mEui64[ot::kSizeEui64];
+    char     mPskd[33];
+    uint32_t mTimeout;
+    bool     mDeferResults;
+};
+
+static void Poll(EventLoop &aEventLoop)
+{
+    const timeval timeout = {0, 50000};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aEventLoop.Poll(timeout));
+}
+
+static const char *Receive(EventLoop &aEventLoop, int aClient)
+{
+    static char reply[256];
+    ssize_t     count;
+
+    Poll(aEventLoop);
+    count = recv(aClient, reply, sizeof(reply) - 1, MSG_DONTWAIT);
+    reply[count > 0 ? count : 0] = '\0';
+
+    return reply;
+}
+
+static const char *Execute(EventLoop &aEventLoop, int aClient, const char *aCommand)
+{
+    CHECK_EQUAL(static_cast<ssize_t>(strlen(aCommand)), send(aClient, aCommand, strlen(aCommand), 0));
+
+    return Receive(aEventLoop, aClient);
+}
+
+static int Connect(EventLoop &aEventLoop)
+{
+    int         client = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un sun;
+
+    memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    strcpy_safe(sun.sun_path, sizeof(sun.sun_path), kTestSocketName);
+    CHECK_EQUAL(0, connect(client, reinterpret_cast<sockaddr *>(&sun), sizeof(sun)));
+    Poll(aEventLoop);
+
+    return client;
+}
+
+TEST_GROUP(CommissionerServer){};
+
+TEST(CommissionerServer, TestCommands)
+{
+    static const uint8_t       kEui64[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77};
+    FakeCommissionerController ncp;
+    EventLoop *                eventLoop = EventLoop::Create();
+    CommissionerServer *       server    = new CommissionerServer(&ncp, kTestSocketName);
+    int                        client;
+    struct stat                st;
+
+    CHECK(eventLoop != NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->Init(*eventLoop));
+    client = Connect(*eventLoop);
+
+    // Other users may not connect.
+    CHECK_EQUAL(0, stat(kTestSocketName, &st));
+    CHECK_EQUAL(S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP, st.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO));
+
+    // The PSKc is required, and cannot be checked until the NCP reports it.
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner start\n"), 9);
+    STRNCMP_EQUAL("Error 11:", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"), 9);
+    ncp.Emit<Ncp::kEventPSKc>(kTestPSKc);
+
+    // Empty lines, sent by OpenThread CLI clients, are not answered.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "\n"));
+    STRCMP_EQUAL("disabled\r\nDone\r\n", Execute(*eventLoop, client, "commissioner state\r\n"));
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner frobnicate\n"), 9);
+
+    // Joiners are only allowed once the commissioner is active.
+    STRNCMP_EQUAL("Error 16:", Execute(*eventLoop, client, "commissioner joiner add * J01NME\n"), 9);
+
+    STRNCMP_EQUAL("Error 13:", Execute(*eventLoop, client, "commissioner start 00112233445566778899aabbccddeeff\n"), 9);
+    CHECK(!ncp.mStarted);
+
+    // The start is answered once the petition is accepted.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    CHECK(ncp.mStarted);
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStatePetition);
+    STRCMP_EQUAL("", Receive(*eventLoop, client));
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStateActive);
+    STRCMP_EQUAL("Done\r\n", Receive(*eventLoop, client));
+
+    // Starting again while active is answered at once.
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    STRCMP_EQUAL("active\r\nDone\r\n", Execute(*eventLoop, client, "commissioner state\n"));
+
+    // A command split across writes is handled once complete.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner joiner add 0011223344556677"));
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, " J01NME 60\n"));
+    CHECK(ncp.mHasEui64);
+    MEMCMP_EQUAL(kEui64, ncp.mEui64, sizeof(kEui64));
+    STRCMP_EQUAL("J01NME", ncp.mPskd);
+    CHECK_EQUAL(60, ncp.mTimeout);
+
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, "commissioner joiner add * J01NME\n"));
+    CHECK(!ncp.mHasEui64);
+    CHECK_EQUAL(CommissionerServer::kDefaultJoinerTimeout, ncp.mTimeout);
+
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner joiner add 0011 J01NME\n"), 9);
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner joiner add * ABC\n"), 9);
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner joiner add * J01NME 0\n"), 9);
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner joiner add * J01NME 86401\n"), 9);
+    STRNCMP_EQUAL("Error 22:", Execute(*eventLoop, client, "commissioner joiner add * J01NME 4294968\n"), 9);
+
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, "commissioner stop\n"));
+    CHECK(!ncp.mStarted);
+
+    close(client);
+    delete server;
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST(CommissionerServer, TestPetitionRejected)
+{
+    FakeCommissionerController ncp;
+    EventLoop *                eventLoop = EventLoop::Create();
+    CommissionerServer *       server    = new CommissionerServer(&ncp, kTestSocketName);
+    int                        client;
+
+    CHECK(eventLoop != NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->Init(*eventLoop));
+    ncp.Emit<Ncp::kEventPSKc>(kTestPSKc);
+    client = Connect(*eventLoop);
+
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStatePetition);
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStateDisabled);
+    STRNCMP_EQUAL("Error 111:", Receive(*eventLoop, client), 10);
+
+    // Nothing is left pending for later petitions.
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStateActive);
+    STRCMP_EQUAL("", Receive(*eventLoop, client));
+
+    close(client);
+    delete server;
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST(CommissionerServer, TestRequestFailed)
+{
+    FakeCommissionerController ncp;
+    EventLoop *                eventLoop = EventLoop::Create();
+    CommissionerServer *       server    = new CommissionerServer(&ncp, kTestSocketName);
+    int                        client;
+    int                        other;
+
+    CHECK(eventLoop != NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->Init(*eventLoop));
+    ncp.Emit<Ncp::kEventPSKc>(kTestPSKc);
+    ncp.mDeferResults = true;
+    client            = Connect(*eventLoop);
+    other             = Connect(*eventLoop);
+
+    // A start the NCP rejects leaves the state unchanged, and is answered with the error.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestStart, EREMOTEIO);
+    STRNCMP_EQUAL("Error 121:", Receive(*eventLoop, client), 10);
+
+    // An accepted start still waits for the petition.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestStart, 0);
+    STRCMP_EQUAL("", Receive(*eventLoop, client));
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStateActive);
+    STRCMP_EQUAL("Done\r\n", Receive(*eventLoop, client));
+
+    // Results are matched to clients in the order of the requests.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner joiner add * J01NME\n"));
+    STRCMP_EQUAL("", Execute(*eventLoop, other, "commissioner joiner add * J01NME\n"));
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestAddJoiner, EREMOTEIO);
+    STRNCMP_EQUAL("Error 121:", Receive(*eventLoop, client), 10);
+    STRCMP_EQUAL("", Receive(*eventLoop, other));
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestAddJoiner, 0);
+    STRCMP_EQUAL("Done\r\n", Receive(*eventLoop, other));
+
+    // The result for a client gone is dropped, without shifting those of others.
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner joiner add * J01NME\n"));
+    STRCMP_EQUAL("", Execute(*eventLoop, other, "commissioner stop\n"));
+    close(client);
+    Poll(*eventLoop);
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestAddJoiner, 0);
+    STRCMP_EQUAL("", Receive(*eventLoop, other));
+    ncp.Emit<Ncp::kEventCommissionerResult>(Ncp::kCommissionerRequestStop, 0);
+    STRCMP_EQUAL("Done\r\n", Receive(*eventLoop, other));
+
+    close(other);
+    delete server;
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST(CommissionerServer, TestJoinerWindow)
+{
+    FakeClock                  clock(1000000);
+    FakeCommissionerController ncp;
+    EventLoop *                eventLoop;
+    CommissionerServer *       server = new CommissionerServer(&ncp, kTestSocketName);
+    int                        client;
+
+    SetClock(&clock);
+    eventLoop = EventLoop::Create();
+    CHECK(eventLoop != NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, server->Init(*eventLoop));
+    ncp.Emit<Ncp::kEventPSKc>(kTestPSKc);
+    client = Connect(*eventLoop);
+
+    STRCMP_EQUAL("", Execute(*eventLoop, client, "commissioner start c3f59e8b8ae13d04b3b81b1a2864738e\n"));
+    ncp.Emit<Ncp::kEventCommissionerState>(Ncp::kCommissionerStateActive);
+    STRCMP_EQUAL("Done\r\n", Receive(*eventLoop, client));
+
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, "commissioner joiner add * J01NME 60\n"));
+    clock.Advance(30000000);
+    STRCMP_EQUAL("Done\r\n", Execute(*eventLoop, client, "commissioner joiner add 0011223344556677 J01NME 10\n"));
+
+    // A shorter window does not cut the first one short.
+    clock.Advance(29000000);
+    Poll(*eventLoop);
+    CHECK(ncp.mStarted);
+
+    // The commissioner is stopped once the last joiner times out.
+    clock.Advance(1000000);
+    Poll(*eventLoop);
+    CHECK(!ncp.mStarted);
+
+    close(client);
+    delete server;
+    EventLoop::Destroy(eventLoop);
+    SetClock(NULL);
+}
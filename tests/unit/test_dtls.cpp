@@ -0,0 +1,376 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include <mbedtls/sha256.h>
+
+#include "common/dtls_mbedtls.hpp"
+#include "common/event_loop.hpp"
+#include "common/time.hpp"
+
+using namespace ot::BorderRouter;
+
+enum
+{
+    kServerPort = 49388,
+    kClients    = 3,
+};
+
+static const char kPSK[] = "J01NME";
+
+struct TestServer
+{
+    int            mReady;
+    int            mClosed;
+    Dtls::Session *mSessions[kClients];
+    char           mReceived[kClients][16];
+};
+
+struct TestClient
+{
+    mbedtls_net_context          mNet;
+    mbedtls_ssl_context          mSsl;
+    mbedtls_timing_delay_context mTimer;
+    uint8_t                      mKek[32];
+};
+
+static int ExportClientKeys(void *               aContext,
+                            const unsigned char *aMasterSecret,
+                            const unsigned char *aKeyBlock,
+                            size_t               aMacLength,
+                            size_t               aKeyLength,
+                            size_t               aIvLength)
+{
+    mbedtls_sha256_context sha256;
+
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts(&sha256, 0);
+    mbedtls_sha256_update(&sha256, aKeyBlock, 2 * static_cast<uint16_t>(aMacLength + aKeyLength + aIvLength));
+    mbedtls_sha256_finish(&sha256, static_cast<TestClient *>(aContext)->mKek);
+    mbedtls_sha256_free(&sha256);
+
+    (void)aMasterSecret;
+    return 0;
+}
+
+static void HandleServerData(const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+{
+    TestServer *server = static_cast<TestServer *>(aContext);
+    int         index  = aBuffer[0] - '0';
+
+    CHECK(index >= 0 && index < kClients);
+    CHECK(aLength < sizeof(server->mReceived[index]));
+    memcpy(server->mReceived[index], aBuffer, aLength);
+}
+
+static void HandleSessionState(Dtls::Session &aSession, Dtls::Session::State aState, void *aContext)
+{
+    TestServer *server = static_cast<TestServer *>(aContext);
+
+    if (aState == Dtls::Session::kStateReady)
+    {
+        server->mSessions[server->mReady++] = &aSession;
+        aSession.SetDataHandler(HandleServerData, server);
+    }
+    else if (aState == Dtls::Session::kStateClose)
+    {
+        ++server->mClosed;
+    }
+}
+
+static unsigned long RunServer(EventLoop &aEventLoop, long aTimeout)
+{
+    timeval       timeout = {0, aTimeout};
+    unsigned long start   = GetNow();
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aEventLoop.Poll(timeout));
+
+    return GetNow() - start;
+}
+
+static void InitClient(TestClient &aClient, mbedtls_ssl_config &aConf, const char *aPSK)
+{
+    mbedtls_net_init(&aClient.mNet);
+    mbedtls_ssl_init(&aClient.mSsl);
+    CHECK_EQUAL(0, mbedtls_net_connect(&aClient.mNet, "::1", "49388", MBEDTLS_NET_PROTO_UDP));
+    CHECK_EQUAL(0, mbedtls_net_set_nonblock(&aClient.mNet));
+    CHECK_EQUAL(0, mbedtls_ssl_setup(&aClient.mSsl, &aConf));
+    CHECK_EQUAL(0, mbedtls_ssl_set_hs_ecjpake_password(&aClient.mSsl, reinterpret_cast<const uint8_t *>(aPSK),
+                                                       strlen(aPSK)));
+    mbedtls_ssl_set_bio(&aClient.mSsl, &aClient.mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+    mbedtls_ssl_set_timer_cb(&aClient.mSsl, &aClient.mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+}
+
+static void FreeClient(TestClient &aClient)
+{
+    mbedtls_ssl_free(&aClient.mSsl);
+    mbedtls_net_free(&aClient.mNet);
+}
+
+static bool Handshake(TestClient &aClient, mbedtls_ssl_config &aConf, EventLoop &aEventLoop)
+{
+    mbedtls_ssl_conf_export_keys_cb(&aConf, ExportClientKeys, &aClient);
+
+    for (int round = 0; round < 1000 && aClient.mSsl.state != MBEDTLS_SSL_HANDSHAKE_OVER; ++round)
+    {
+        int ret = mbedtls_ssl_handshake(&aClient.mSsl);
+
+        CHECK(ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+        RunServer(aEventLoop, 1000);
+    }
+
+    return aClient.mSsl.state == MBEDTLS_SSL_HANDSHAKE_OVER;
+}
+
+TEST_GROUP(Dtls){};
+
+TEST(Dtls, TestSessionsShareServerSocket)
+{
+    static const int         ciphersuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+    TestServer               server;
+    TestClient               clients[kClients];
+    mbedtls_ssl_config       conf;
+    mbedtls_entropy_context  entropy;
+    mbedtls_ctr_drbg_context ctrDrbg;
+    EventLoop *              eventLoop  = EventLoop::Create();
+    Dtls::Server *           dtlsServer = Dtls::Server::Create(*eventLoop, kServerPort, HandleSessionState, &server);
+    bool                     done       = false;
+
+    memset(&server, 0, sizeof(server));
+
+    dtlsServer->SetPSK(reinterpret_cast<const uint8_t *>(kPSK), sizeof(kPSK) - 1);
+    dtlsServer->SetSeed(reinterpret_cast<const uint8_t *>("seed"), 4);
+    CHECK_EQUAL(OTBR_ERROR_NONE, dtlsServer->Start());
+
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctrDrbg);
+    CHECK_EQUAL(0, mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, NULL, 0));
+    CHECK_EQUAL(0, mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                               MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctrDrbg);
+    mbedtls_ssl_conf_ciphersuites(&conf, ciphersuites);
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        InitClient(clients[i], conf, kPSK);
+    }
+
+    // Handshake all clients concurrently.
+    for (int round = 0; round < 1000 && !done; ++round)
+    {
+        done = true;
+
+        for (int i = 0; i < kClients; ++i)
+        {
+            // The export callback is per configuration, so bind it to the client being processed.
+            mbedtls_ssl_conf_export_keys_cb(&conf, ExportClientKeys, &clients[i]);
+
+            if (clients[i].mSsl.state != MBEDTLS_SSL_HANDSHAKE_OVER)
+            {
+                int ret = mbedtls_ssl_handshake(&clients[i].mSsl);
+
+                CHECK(ret == 0 || ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+                done = false;
+            }
+        }
+
+        RunServer(*eventLoop, 1000);
+    }
+
+    CHECK(done);
+    CHECK_EQUAL(kClients, server.mReady);
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        char message[] = "0:hello";
+
+        message[0] = static_cast<char>('0' + i);
+        CHECK_EQUAL(static_cast<int>(sizeof(message) - 1),
+                    mbedtls_ssl_write(&clients[i].mSsl, reinterpret_cast<uint8_t *>(message), sizeof(message) - 1));
+    }
+
+    for (int round = 0; round < 10; ++round)
+    {
+        RunServer(*eventLoop, 10000);
+    }
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        const uint8_t *kek = server.mSessions[i]->GetKek();
+        int            j   = 0;
+
+        CHECK_EQUAL('0' + i, server.mReceived[i][0]);
+        STRCMP_EQUAL(":hello", &server.mReceived[i][1]);
+
+        // Each session exports its own KEK, matching exactly one client.
+        for (j = 0; j < kClients; ++j)
+        {
+            if (memcmp(kek, clients[j].mKek, sizeof(clients[j].mKek)) == 0)
+            {
+                break;
+            }
+        }
+        CHECK(j < kClients);
+    }
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        FreeClient(clients[i]);
+    }
+
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&ctrDrbg);
+    mbedtls_entropy_free(&entropy);
+    Dtls::Server::Destroy(dtlsServer);
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST(Dtls, TestSessionResumption)
+{
+    static const int         ciphersuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+    static const char        kNewPSK[]      = "N3WPSK";
+    TestServer               server;
+    TestClient               clients[kClients];
+    mbedtls_ssl_session      session;
+    mbedtls_ssl_config       conf;
+    mbedtls_entropy_context  entropy;
+    mbedtls_ctr_drbg_context ctrDrbg;
+    EventLoop *              eventLoop  = EventLoop::Create();
+    Dtls::MbedtlsServer *    dtlsServer = new Dtls::MbedtlsServer(*eventLoop, kServerPort, HandleSessionState, &server);
+
+    memset(&server, 0, sizeof(server));
+
+    dtlsServer->SetPSK(reinterpret_cast<const uint8_t *>(kPSK), sizeof(kPSK) - 1);
+    dtlsServer->SetSeed(reinterpret_cast<const uint8_t *>("seed"), 4);
+    CHECK_EQUAL(OTBR_ERROR_NONE, dtlsServer->Start());
+
+    mbedtls_ssl_session_init(&session);
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctrDrbg);
+    CHECK_EQUAL(0, mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, NULL, 0));
+    CHECK_EQUAL(0, mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                               MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctrDrbg);
+    mbedtls_ssl_conf_ciphersuites(&conf, ciphersuites);
+
+    // A full handshake stores the session.
+    InitClient(clients[0], conf, kPSK);
+    CHECK(Handshake(clients[0], conf, *eventLoop));
+    CHECK_EQUAL(0, mbedtls_ssl_get_session(&clients[0].mSsl, &session));
+    CHECK_EQUAL(1UL, dtlsServer->GetSessionCacheCounters().mStores);
+
+    // A reconnecting client resumes it and derives its own KEK.
+    InitClient(clients[1], conf, kPSK);
+    CHECK_EQUAL(0, mbedtls_ssl_set_session(&clients[1].mSsl, &session));
+    CHECK(Handshake(clients[1], conf, *eventLoop));
+    CHECK_EQUAL(1UL, dtlsServer->GetSessionCacheCounters().mHits);
+    CHECK_EQUAL(2, server.mReady);
+    CHECK(memcmp(server.mSessions[1]->GetKek(), clients[1].mKek, sizeof(clients[1].mKek)) == 0);
+
+    // Changing the PSK invalidates the cached session, so a full handshake with the new PSK is required.
+    dtlsServer->SetPSK(reinterpret_cast<const uint8_t *>(kNewPSK), sizeof(kNewPSK) - 1);
+    CHECK_EQUAL(1UL, dtlsServer->GetSessionCacheCounters().mInvalidations);
+
+    InitClient(clients[2], conf, kNewPSK);
+    CHECK_EQUAL(0, mbedtls_ssl_set_session(&clients[2].mSsl, &session));
+    CHECK(Handshake(clients[2], conf, *eventLoop));
+    CHECK_EQUAL(1UL, dtlsServer->GetSessionCacheCounters().mHits);
+    CHECK_EQUAL(1UL, dtlsServer->GetSessionCacheCounters().mMisses);
+    CHECK_EQUAL(3, server.mReady);
+
+    for (int i = 0; i < kClients; ++i)
+    {
+        FreeClient(clients[i]);
+    }
+
+    mbedtls_ssl_session_free(&session);
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&ctrDrbg);
+    mbedtls_entropy_free(&entropy);
+    delete dtlsServer;
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST(Dtls, TestClosedSessionReleased)
+{
+    static const int         ciphersuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+    TestServer               server;
+    TestClient               client;
+    mbedtls_ssl_config       conf;
+    mbedtls_entropy_context  entropy;
+    mbedtls_ctr_drbg_context ctrDrbg;
+    EventLoop *              eventLoop  = EventLoop::Create();
+    Dtls::MbedtlsServer *    dtlsServer = new Dtls::MbedtlsServer(*eventLoop, kServerPort, HandleSessionState, &server);
+
+    memset(&server, 0, sizeof(server));
+
+    dtlsServer->SetPSK(reinterpret_cast<const uint8_t *>(kPSK), sizeof(kPSK) - 1);
+    dtlsServer->SetSeed(reinterpret_cast<const uint8_t *>("seed"), 4);
+    CHECK_EQUAL(OTBR_ERROR_NONE, dtlsServer->Start());
+
+    // Without sessions the server never wakes up the event loop.
+    CHECK(RunServer(*eventLoop, 200000) >= 150);
+
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctrDrbg);
+    CHECK_EQUAL(0, mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, NULL, 0));
+    CHECK_EQUAL(0, mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                               MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctrDrbg);
+    mbedtls_ssl_conf_ciphersuites(&conf, ciphersuites);
+
+    InitClient(client, conf, kPSK);
+    CHECK(Handshake(client, conf, *eventLoop));
+    CHECK_EQUAL(1, server.mReady);
+
+    // An established session is only due at its expiration.
+    CHECK(RunServer(*eventLoop, 200000) >= 150);
+
+    CHECK_EQUAL(0, mbedtls_ssl_close_notify(&client.mSsl));
+    for (int round = 0; round < 10 && server.mClosed == 0; ++round)
+    {
+        RunServer(*eventLoop, 10000);
+    }
+    CHECK_EQUAL(1, server.mClosed);
+
+    // The closed session is released along with processing the close, without waiting for its expiration.
+    CHECK(RunServer(*eventLoop, 200000) >= 150);
+
+    FreeClient(client);
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&ctrDrbg);
+    mbedtls_entropy_free(&entropy);
+    delete dtlsServer;
+    EventLoop::Destroy(eventLoop);
+}
@@ -0,0 +1,144 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "common/dtls_session_cache.hpp"
+#include "common/time.hpp"
+
+using ot::BorderRouter::FakeClock;
+using ot::BorderRouter::SetClock;
+using ot::BorderRouter::Dtls::SessionCache;
+
+static void MakeSession(mbedtls_ssl_session &aSession, uint8_t aId)
+{
+    memset(&aSession, 0, sizeof(aSession));
+    aSession.ciphersuite = MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8;
+    aSession.id_len      = sizeof(aSession.id);
+    memset(aSession.id, aId, sizeof(aSession.id));
+    memset(aSession.master, aId + 1, sizeof(aSession.master));
+}
+
+static bool Resume(SessionCache &aCache, uint8_t aId)
+{
+    mbedtls_ssl_session session;
+    bool                resumed;
+
+    MakeSession(session, aId);
+    memset(session.master, 0, sizeof(session.master));
+
+    resumed = (SessionCache::Get(&aCache, &session) == 0);
+
+    if (resumed)
+    {
+        CHECK_EQUAL(aId + 1, session.master[0]);
+    }
+
+    return resumed;
+}
+
+static void Store(SessionCache &aCache, uint8_t aId)
+{
+    mbedtls_ssl_session session;
+
+    MakeSession(session, aId);
+    CHECK_EQUAL(0, SessionCache::Set(&aCache, &session));
+}
+
+TEST_GROUP(DtlsSessionCache){};
+
+TEST(DtlsSessionCache, TestHitAndMiss)
+{
+    SessionCache        cache;
+    mbedtls_ssl_session session;
+
+    CHECK(!Resume(cache, 1));
+    Store(cache, 1);
+    CHECK(Resume(cache, 1));
+    CHECK(!Resume(cache, 2));
+
+    // Sessions without ID cannot be resumed.
+    MakeSession(session, 3);
+    session.id_len = 0;
+    CHECK_EQUAL(1, SessionCache::Set(&cache, &session));
+
+    CHECK_EQUAL(1UL, cache.GetCounters().mHits);
+    CHECK_EQUAL(2UL, cache.GetCounters().mMisses);
+    CHECK_EQUAL(1UL, cache.GetSize());
+}
+
+TEST(DtlsSessionCache, TestLeastRecentlyUsedEviction)
+{
+    SessionCache cache(2);
+
+    Store(cache, 1);
+    Store(cache, 2);
+    CHECK(Resume(cache, 1));
+
+    // Session 2 is the least recently used one.
+    Store(cache, 3);
+    CHECK(Resume(cache, 1));
+    CHECK(!Resume(cache, 2));
+    CHECK(Resume(cache, 3));
+    CHECK_EQUAL(1UL, cache.GetCounters().mEvictions);
+    CHECK_EQUAL(2UL, cache.GetSize());
+}
+
+TEST(DtlsSessionCache, TestExpiration)
+{
+    FakeClock    clock(1000000);
+    SessionCache cache(SessionCache::kDefaultCapacity, 20);
+
+    SetClock(&clock);
+
+    Store(cache, 1);
+    clock.Advance(19000);
+    CHECK(Resume(cache, 1));
+
+    clock.Advance(1000);
+    CHECK(!Resume(cache, 1));
+    CHECK_EQUAL(1UL, cache.GetCounters().mExpirations);
+    CHECK_EQUAL(0UL, cache.GetSize());
+
+    SetClock(NULL);
+}
+
+TEST(DtlsSessionCache, TestClear)
+{
+    SessionCache cache;
+
+    Store(cache, 1);
+    Store(cache, 2);
+    cache.Clear();
+
+    CHECK(!Resume(cache, 1));
+    CHECK(!Resume(cache, 2));
+    CHECK_EQUAL(2UL, cache.GetCounters().mInvalidations);
+}
@@ -28,38 +28,48 @@
 
 #include <CppUTest/TestHarness.h>
 
-#include <stdarg.h>
-
 #include "common/event_emitter.hpp"
 
+enum
+{
+    kEventSingle,
+    kEventContexts,
+    kEventSequence,
+    kNumEvents,
+};
+
+template <int kEvent> struct TestEventSignature
+{
+    typedef void (*Handler)(void *aContext);
+};
+
+template <> struct TestEventSignature<kEventContexts>
+{
+    typedef void (*Handler)(void *aContext, void *aContext1, void *aContext2);
+};
+
+typedef ot::BorderRouter::EventEmitter<TestEventSignature, kNumEvents, 2> TestEventEmitter;
+
 static int   sCounter = 0;
-static int   sEvent   = 0;
 static void *sContext = NULL;
 
-static void HandleSingleEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleSingleEvent(void *aContext)
 {
     sCounter++;
 
     CHECK_EQUAL(sContext, aContext);
-    CHECK_EQUAL(sEvent, aEvent);
-    (void)aArguments;
 }
 
-static void HandleTestDifferentContextEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleTestDifferentContextEvent(void *aContext, void *aContext1, void *aContext2)
 {
-    void *context1 = va_arg(aArguments, void *);
-    void *context2 = va_arg(aArguments, void *);
-
-    CHECK_EQUAL(sEvent, aEvent);
-
     int id = *static_cast<int *>(aContext);
     if (id == 1)
     {
-        CHECK_EQUAL(context1, aContext);
+        CHECK_EQUAL(aContext1, aContext);
     }
     else if (id == 2)
     {
-        CHECK_EQUAL(context2, aContext);
+        CHECK_EQUAL(aContext2, aContext);
     }
     else
     {
@@ -69,112 +79,121 @@ static void HandleTestDifferentContextEvent(void *aContext, int aEvent, va_list
     sCounter++;
 }
 
-static void HandleTestCallSequenceEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleTestCallSequenceEvent(void *aContext)
 {
-    CHECK_EQUAL(sEvent, aEvent);
-
     int id = *static_cast<int *>(aContext);
 
     ++sCounter;
 
     CHECK_EQUAL(sCounter, id);
-
-    (void)aArguments;
 }
 
 TEST_GROUP(EventEmitter){};
 
 TEST(EventEmitter, TestSingleHandler)
 {
-    ot::BorderRouter::EventEmitter ee;
-    int                            event = 1;
-    ee.On(event, HandleSingleEvent, NULL);
+    TestEventEmitter ee;
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
 
     CHECK_EQUAL(1, sCounter);
 }
 
 TEST(EventEmitter, TestDoubleHandler)
 {
-    ot::BorderRouter::EventEmitter ee;
-    int                            event = 1;
-    ee.On(event, HandleSingleEvent, NULL);
-    ee.On(event, HandleSingleEvent, NULL);
+    TestEventEmitter ee;
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestDifferentContext)
 {
-    ot::BorderRouter::EventEmitter ee;
-    int                            event = 2;
+    TestEventEmitter ee;
 
     int context1 = 1;
     int context2 = 2;
 
-    ee.On(event, HandleTestDifferentContextEvent, &context1);
-    ee.On(event, HandleTestDifferentContextEvent, &context2);
+    ee.On<kEventContexts>(HandleTestDifferentContextEvent, &context1);
+    ee.On<kEventContexts>(HandleTestDifferentContextEvent, &context2);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event, &context1, &context2);
+    ee.Emit<kEventContexts>(&context1, &context2);
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestCallSequence)
 {
-    ot::BorderRouter::EventEmitter ee;
-    int                            event = 3;
+    TestEventEmitter ee;
 
     int context1 = 1;
     int context2 = 2;
 
-    ee.On(event, HandleTestCallSequenceEvent, &context1);
-    ee.On(event, HandleTestCallSequenceEvent, &context2);
+    ee.On<kEventSequence>(HandleTestCallSequenceEvent, &context1);
+    ee.On<kEventSequence>(HandleTestCallSequenceEvent, &context2);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSequence>();
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestRemoveHandler)
 {
-    ot::BorderRouter::EventEmitter ee;
-    int                            event = 3;
+    TestEventEmitter ee;
+    int              context = 0;
 
-    ee.On(event, HandleSingleEvent, NULL);
-    ee.On(event, HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
     CHECK_EQUAL(2, sCounter);
 
-    ee.Off(event, HandleSingleEvent, NULL);
-    ee.Emit(event);
-    CHECK_EQUAL(3, sCounter);
+    ee.Off<kEventSingle>(HandleSingleEvent, &context);
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(4, sCounter);
 
-    ee.Off(event, HandleSingleEvent, NULL);
-    ee.Emit(event);
-    CHECK_EQUAL(3, sCounter);
+    ee.Off<kEventSingle>(HandleSingleEvent, NULL);
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(5, sCounter);
+
+    ee.Off<kEventSingle>(HandleSingleEvent, NULL);
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(5, sCounter);
+}
+
+TEST(EventEmitter, TestHandlerLimit)
+{
+    TestEventEmitter ee;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, ee.On<kEventSingle>(HandleSingleEvent, NULL));
+    CHECK_EQUAL(OTBR_ERROR_NONE, ee.On<kEventSingle>(HandleSingleEvent, NULL));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, ee.On<kEventSingle>(HandleSingleEvent, NULL));
+
+    // Handlers of other events are not affected.
+    CHECK_EQUAL(OTBR_ERROR_NONE, ee.On<kEventSequence>(HandleSingleEvent, NULL));
+
+    sContext = NULL;
+    sCounter = 0;
+
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(2, sCounter);
 }
@@ -0,0 +1,291 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <unistd.h>
+
+#include "common/event_loop.hpp"
+#include "common/time.hpp"
+
+using ot::BorderRouter::EventLoop;
+using ot::BorderRouter::FakeClock;
+
+static int sFired = 0;
+
+static void HandleTimer(void *aContext)
+{
+    int *order = static_cast<int *>(aContext);
+
+    *order = ++sFired;
+}
+
+static void HandleReadable(void *aContext, int aFd, unsigned int aEvents)
+{
+    char buffer[16];
+
+    CHECK(aEvents & EventLoop::kEventReadable);
+    CHECK(read(aFd, buffer, sizeof(buffer)) > 0);
+    ++*static_cast<int *>(aContext);
+}
+
+static void TestTimerOrder(int aBackend)
+{
+    EventLoop *      eventLoop = EventLoop::Create(aBackend);
+    const timeval    timeout   = {1, 0};
+    int              order1    = 0;
+    int              order2    = 0;
+    int              order3    = 0;
+    EventLoop::Timer timer1(HandleTimer, &order1);
+    EventLoop::Timer timer2(HandleTimer, &order2);
+    EventLoop::Timer timer3(HandleTimer, &order3);
+
+    CHECK(eventLoop != NULL);
+
+    sFired = 0;
+    eventLoop->StartTimer(timer1, 30);
+    eventLoop->StartTimer(timer2, 10);
+    eventLoop->StartTimer(timer3, 700);
+    eventLoop->StopTimer(timer3);
+    CHECK(!timer3.IsRunning());
+
+    while (timer1.IsRunning() || timer2.IsRunning())
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    }
+
+    CHECK_EQUAL(1, order2);
+    CHECK_EQUAL(2, order1);
+    CHECK_EQUAL(0, order3);
+
+    EventLoop::Destroy(eventLoop);
+}
+
+static void TestPersistentIo(int aBackend)
+{
+    EventLoop *   eventLoop = EventLoop::Create(aBackend);
+    const timeval timeout   = {0, 10000};
+    int           fds[2];
+    int           count = 0;
+
+    CHECK(eventLoop != NULL);
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->AddIo(fds[0], EventLoop::kEventReadable, HandleReadable, &count));
+    CHECK(eventLoop->AddIo(fds[0], EventLoop::kEventReadable, HandleReadable, &count) != OTBR_ERROR_NONE);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK_EQUAL(0, count);
+
+    CHECK_EQUAL(1, write(fds[1], "a", 1));
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK_EQUAL(1, count);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->RemoveIo(fds[0]));
+    CHECK_EQUAL(1, write(fds[1], "a", 1));
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK_EQUAL(1, count);
+
+    close(fds[0]);
+    close(fds[1]);
+    EventLoop::Destroy(eventLoop);
+}
+
+static void TestFakeClock(int aBackend)
+{
+    FakeClock        clock(1000000);
+    EventLoop *      eventLoop;
+    const timeval    timeout = {0, 0};
+    int              order1  = 0;
+    int              order2  = 0;
+    EventLoop::Timer timer1(HandleTimer, &order1);
+    EventLoop::Timer timer2(HandleTimer, &order2);
+
+    ot::BorderRouter::SetClock(&clock);
+    eventLoop = EventLoop::Create(aBackend);
+    CHECK(eventLoop != NULL);
+
+    sFired = 0;
+    eventLoop->StartTimer(timer1, 2000);
+    eventLoop->StartTimer(timer2, 1000);
+
+    // Timers only move with the clock, so no real time passes.
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(timer1.IsRunning() && timer2.IsRunning());
+
+    clock.Advance(999000);
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(timer2.IsRunning());
+
+    clock.Advance(1000);
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(!timer2.IsRunning());
+    CHECK(timer1.IsRunning());
+
+    clock.Advance(1000000);
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(!timer1.IsRunning());
+
+    CHECK_EQUAL(1, order2);
+    CHECK_EQUAL(2, order1);
+
+    EventLoop::Destroy(eventLoop);
+    ot::BorderRouter::SetClock(NULL);
+}
+
+class PipeProcessor : public ot::BorderRouter::MainloopProcessor
+{
+public:
+    PipeProcessor(void)
+        : mFd(-1)
+        , mReadable(false)
+    {
+    }
+
+    void UpdateFdSet(otSysMainloopContext &aMainloop)
+    {
+        FD_SET(mFd, &aMainloop.mReadFdSet);
+        aMainloop.mMaxFd = (mFd > aMainloop.mMaxFd ? mFd : aMainloop.mMaxFd);
+    }
+
+    void Process(const otSysMainloopContext &aMainloop) { mReadable = FD_ISSET(mFd, &aMainloop.mReadFdSet); }
+
+    int  mFd;
+    bool mReadable;
+};
+
+static void TestDescriptorReuse(int aBackend)
+{
+    EventLoop *   eventLoop = EventLoop::Create(aBackend);
+    const timeval timeout   = {0, 10000};
+    PipeProcessor processor;
+    int           fds[2];
+    int           reused[2];
+    int           count = 0;
+
+    CHECK(eventLoop != NULL);
+    eventLoop->AddProcessor(processor);
+
+    // A descriptor requested through the mainloop context is closed and its number reused.
+    CHECK_EQUAL(0, pipe(fds));
+    processor.mFd = fds[0];
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(!processor.mReadable);
+    close(fds[0]);
+    close(fds[1]);
+
+    CHECK_EQUAL(0, pipe(reused));
+    CHECK_EQUAL(fds[0], reused[0]);
+    CHECK_EQUAL(1, write(reused[1], "a", 1));
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(processor.mReadable);
+
+    // A persistent registration whose descriptor is closed and reused can still be modified.
+    processor.mFd = reused[1];
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->AddIo(reused[0], EventLoop::kEventWritable, HandleReadable, &count));
+    close(reused[0]);
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(reused[0], fds[0]);
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->ModifyIo(fds[0], EventLoop::kEventReadable));
+    CHECK_EQUAL(1, write(fds[1], "a", 1));
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK_EQUAL(1, count);
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->RemoveIo(fds[0]));
+
+    close(fds[0]);
+    close(fds[1]);
+    close(reused[1]);
+    EventLoop::Destroy(eventLoop);
+}
+
+static void TestTimeoutRounding(int aBackend)
+{
+    EventLoop *   eventLoop = EventLoop::Create(aBackend);
+    const timeval timeout   = {0, 1500};
+    uint64_t      start;
+
+    CHECK(eventLoop != NULL);
+
+    // A timeout below the resolution of the backend must not be cut to zero.
+    start = ot::BorderRouter::GetNowMicros();
+    CHECK_EQUAL(OTBR_ERROR_NONE, eventLoop->Poll(timeout));
+    CHECK(ot::BorderRouter::GetNowMicros() - start >= 1500);
+
+    EventLoop::Destroy(eventLoop);
+}
+
+TEST_GROUP(EventLoop){};
+
+TEST(EventLoop, TestTimerOrderEpoll)
+{
+    TestTimerOrder(EventLoop::kBackendEpoll);
+}
+
+TEST(EventLoop, TestTimerOrderSelect)
+{
+    TestTimerOrder(EventLoop::kBackendSelect);
+}
+
+TEST(EventLoop, TestPersistentIoEpoll)
+{
+    TestPersistentIo(EventLoop::kBackendEpoll);
+}
+
+TEST(EventLoop, TestPersistentIoSelect)
+{
+    TestPersistentIo(EventLoop::kBackendSelect);
+}
+
+TEST(EventLoop, TestFakeClockEpoll)
+{
+    TestFakeClock(EventLoop::kBackendEpoll);
+}
+
+TEST(EventLoop, TestFakeClockSelect)
+{
+    TestFakeClock(EventLoop::kBackendSelect);
+}
+
+TEST(EventLoop, TestDescriptorReuseEpoll)
+{
+    TestDescriptorReuse(EventLoop::kBackendEpoll);
+}
+
+TEST(EventLoop, TestDescriptorReuseSelect)
+{
+    TestDescriptorReuse(EventLoop::kBackendSelect);
+}
+
+TEST(EventLoop, TestTimeoutRoundingEpoll)
+{
+    TestTimeoutRounding(EventLoop::kBackendEpoll);
+}
+
+TEST(EventLoop, TestTimeoutRoundingSelect)
+{
+    TestTimeoutRounding(EventLoop::kBackendSelect);
+}
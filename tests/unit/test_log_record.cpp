@@ -0,0 +1,283 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "common/log_record.hpp"
+#include "common/log_writer.hpp"
+
+using namespace ot::BorderRouter::Log;
+
+static Record MakeRecord(const char *aFormat, const uint8_t *aArguments, uint16_t aLength)
+{
+    Record record;
+
+    record.mTimestamp    = 1234567;
+    record.mFormat       = aFormat;
+    record.mArguments    = aArguments;
+    record.mLength       = aLength;
+    record.mType         = kTypeLog;
+    record.mLevel        = 6;
+    record.mDestinations = kDestinationFile;
+
+    return record;
+}
+
+static uint16_t Encode(uint8_t *aBuffer, uint16_t aSize, const char *aFormat, ...)
+{
+    uint16_t length;
+    va_list  ap;
+
+    va_start(ap, aFormat);
+    length = EncodeArguments(aBuffer, aSize, aFormat, ap);
+    va_end(ap);
+
+    return length;
+}
+
+static void CheckFormat(const char *aFormat, ...)
+{
+    uint8_t  arguments[kMaxArgumentsLength];
+    char     expected[kMaxTextLength];
+    char     text[kMaxTextLength];
+    uint16_t length;
+    va_list  ap;
+
+    va_start(ap, aFormat);
+    vsnprintf(expected, sizeof(expected), aFormat, ap);
+    va_end(ap);
+
+    va_start(ap, aFormat);
+    length = EncodeArguments(arguments, sizeof(arguments), aFormat, ap);
+    va_end(ap);
+
+    FormatRecord(MakeRecord(aFormat, arguments, length), text, sizeof(text));
+    STRCMP_EQUAL(expected, text);
+}
+
+TEST_GROUP(LogRecord){};
+
+TEST(LogRecord, TestFormatMatchesPrintf)
+{
+    static const char kNotTerminated[4] = {'a', 'b', 'c', 'd'};
+
+    CheckFormat("plain text");
+    CheckFormat("%d %s %u", -42, "hello", 42u);
+    CheckFormat("%5.2f|%-8s|%x|%lu|%lld|%hhx|%c|%%", 3.14159, "left", 0xbeefu, 123456789ul, -5ll, 0x1ff, 'z');
+    CheckFormat("%04x %04d %hu %zu", 0x2au, 7, static_cast<unsigned short>(65535), static_cast<size_t>(99));
+    CheckFormat("[%*d] [%-*.*s]", 6, 42, 8, 3, "truncated");
+    CheckFormat("%.3s|%.*s", kNotTerminated, 2, kNotTerminated);
+    CheckFormat("%p %s", static_cast<const void *>(kNotTerminated), static_cast<const char *>(NULL));
+}
+
+TEST(LogRecord, TestArgumentsNotFit)
+{
+    uint8_t arguments[kMaxArgumentsLength];
+    char    text[kMaxTextLength];
+
+    // Only the integer fits, the string is printed as its specification.
+    FormatRecord(MakeRecord("%d %s", arguments, Encode(arguments, 8, "%d %s", 1, "dropped")), text, sizeof(text));
+    STRCMP_EQUAL("1 %s", text);
+
+    // Long strings are truncated to fit.
+    FormatRecord(MakeRecord("%s", arguments, Encode(arguments, 6, "%s", "abcdefgh")), text, sizeof(text));
+    STRCMP_EQUAL("abcd", text);
+}
+
+TEST(LogRecord, TestDump)
+{
+    static const char kMemory[] = "one super long string with lots of text";
+    uint8_t           arguments[kMaxArgumentsLength];
+    char              text[kMaxTextLength];
+    uint16_t          length;
+    Record            record;
+
+    length = EncodeDump(arguments, sizeof(arguments), "foobar", 16, reinterpret_cast<const uint8_t *>(kMemory) + 16,
+                        sizeof(kMemory) - 16);
+
+    record       = MakeRecord(NULL, arguments, length);
+    record.mType = kTypeDump;
+
+    FormatRecord(record, text, sizeof(text));
+    STRCMP_EQUAL("foobar: 0010: 74 72 69 6e 67 20 77 69 74 68 20 6c 6f 74 73 20\n"
+                 "foobar: 0020: 6f 66 20 74 65 78 74 00",
+                 text);
+}
+
+TEST(LogRecord, TestBinaryRoundTrip)
+{
+    static const char kFormat[] = "%s joined with rloc16 0x%04x";
+    FILE *            binary    = tmpfile();
+    FILE *            decoded   = tmpfile();
+    BinaryWriter      writer(binary);
+    uint8_t           arguments[kMaxArgumentsLength];
+    char              text[kMaxTextLength];
+    size_t            length;
+
+    CHECK(binary != NULL && decoded != NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.Begin());
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        Record record =
+            MakeRecord(kFormat, arguments, Encode(arguments, sizeof(arguments), kFormat, "joiner", 0x6000 + i));
+
+        record.mTimestamp = 1000000 * i + 500;
+        CHECK_EQUAL(OTBR_ERROR_NONE, writer.Write(record));
+    }
+
+    rewind(binary);
+    CHECK_EQUAL(OTBR_ERROR_NONE, DecodeBinary(binary, decoded));
+
+    rewind(decoded);
+    length       = fread(text, 1, sizeof(text) - 1, decoded);
+    text[length] = '\0';
+    STRCMP_EQUAL("   0.000 | joiner joined with rloc16 0x6000\n"
+                 "   1.000 | joiner joined with rloc16 0x6001\n"
+                 "   2.000 | joiner joined with rloc16 0x6002\n",
+                 text);
+
+    // A truncated binary log is reported.
+    rewind(binary);
+    CHECK_EQUAL(0, ftruncate(fileno(binary), 20));
+    CHECK(DecodeBinary(binary, decoded) != OTBR_ERROR_NONE);
+
+    fclose(binary);
+    fclose(decoded);
+}
+
+class TestSink : public Sink
+{
+public:
+    TestSink(void)
+        : mFlushes(0)
+    {
+    }
+
+    void Write(const Record &aRecord)
+    {
+        char text[kMaxTextLength];
+
+        FormatRecord(aRecord, text, sizeof(text));
+        mLines.push_back(text);
+    }
+
+    void Flush(void) { ++mFlushes; }
+
+    std::vector<std::string> mLines;
+    int                      mFlushes;
+};
+
+enum
+{
+    kThreads          = 4,
+    kMessagesByThread = 2000,
+};
+
+struct LogThread
+{
+    AsyncWriter *mWriter;
+    int          mIndex;
+};
+
+static void LogMessage(AsyncWriter &aWriter, const char *aFormat, ...)
+{
+    va_list ap;
+
+    va_start(ap, aFormat);
+    aWriter.Log(6, kDestinationFile, aFormat, ap);
+    va_end(ap);
+}
+
+static void *RunLogThread(void *aContext)
+{
+    LogThread *thread = static_cast<LogThread *>(aContext);
+
+    for (int i = 0; i < kMessagesByThread; ++i)
+    {
+        LogMessage(*thread->mWriter, "thread %d message %d", thread->mIndex, i);
+
+        // Leave the writer time to drain, so no record is dropped.
+        if (i % 256 == 255)
+        {
+            thread->mWriter->Flush();
+        }
+    }
+
+    return NULL;
+}
+
+TEST(LogRecord, TestAsyncWriter)
+{
+    TestSink    sink;
+    AsyncWriter writer(sink);
+    pthread_t   threads[kThreads];
+    LogThread   contexts[kThreads];
+    int         next[kThreads] = {0};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.Start());
+
+    for (int i = 0; i < kThreads; ++i)
+    {
+        contexts[i].mWriter = &writer;
+        contexts[i].mIndex  = i;
+        CHECK_EQUAL(0, pthread_create(&threads[i], NULL, RunLogThread, &contexts[i]));
+    }
+
+    for (int i = 0; i < kThreads; ++i)
+    {
+        CHECK_EQUAL(0, pthread_join(threads[i], NULL));
+    }
+
+    writer.Flush();
+    CHECK_EQUAL(0UL, writer.GetDropped());
+    CHECK_EQUAL(static_cast<size_t>(kThreads * kMessagesByThread), sink.mLines.size());
+    CHECK(sink.mFlushes > 0);
+
+    // Records of a thread are written in order.
+    for (size_t i = 0; i < sink.mLines.size(); ++i)
+    {
+        int thread;
+        int sequence;
+
+        CHECK_EQUAL(2, sscanf(sink.mLines[i].c_str(), "thread %d message %d", &thread, &sequence));
+        CHECK_EQUAL(next[thread], sequence);
+        ++next[thread];
+    }
+
+    writer.Stop();
+    CHECK(!writer.IsRunning());
+}
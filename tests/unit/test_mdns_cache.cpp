@@ -0,0 +1,221 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "agent/mdns_cache.hpp"
+#include "common/time.hpp"
+
+using ot::BorderRouter::FakeClock;
+using ot::BorderRouter::SetClock;
+using ot::BorderRouter::Mdns::DecodeTxtData;
+using ot::BorderRouter::Mdns::DiscoveredService;
+using ot::BorderRouter::Mdns::ServiceCache;
+using ot::BorderRouter::Mdns::TxtEntry;
+using ot::BorderRouter::Mdns::TxtList;
+
+namespace Mdns = ot::BorderRouter::Mdns;
+
+struct CacheEvents
+{
+    int         mAdded;
+    int         mUpdated;
+    int         mRemoved;
+    std::string mLastName;
+};
+
+static void HandleAdded(void *aContext, const DiscoveredService &aService)
+{
+    ++static_cast<CacheEvents *>(aContext)->mAdded;
+    static_cast<CacheEvents *>(aContext)->mLastName = aService.mName;
+}
+
+static void HandleUpdated(void *aContext, const DiscoveredService &aService)
+{
+    ++static_cast<CacheEvents *>(aContext)->mUpdated;
+    static_cast<CacheEvents *>(aContext)->mLastName = aService.mName;
+}
+
+static void HandleRemoved(void *aContext, const DiscoveredService &aService)
+{
+    ++static_cast<CacheEvents *>(aContext)->mRemoved;
+    static_cast<CacheEvents *>(aContext)->mLastName = aService.mName;
+}
+
+static void Observe(ServiceCache &aCache, CacheEvents &aEvents)
+{
+    aEvents.mAdded   = 0;
+    aEvents.mUpdated = 0;
+    aEvents.mRemoved = 0;
+    aCache.On<Mdns::kEventServiceAdded>(HandleAdded, &aEvents);
+    aCache.On<Mdns::kEventServiceUpdated>(HandleUpdated, &aEvents);
+    aCache.On<Mdns::kEventServiceRemoved>(HandleRemoved, &aEvents);
+}
+
+static DiscoveredService MakeService(const char *aName, const char *aNetworkName)
+{
+    DiscoveredService service;
+
+    service.mName     = aName;
+    service.mType     = "_meshcop._udp";
+    service.mDomain   = "local";
+    service.mHostName = "host.local";
+    service.mPort     = 49191;
+    service.mTxtList.push_back(TxtEntry("nn", aNetworkName));
+
+    return service;
+}
+
+TEST_GROUP(MdnsCache){};
+
+TEST(MdnsCache, TestDeduplicateInterfaces)
+{
+    FakeClock    clock(1000000);
+    ServiceCache cache;
+    CacheEvents  events;
+
+    SetClock(&clock);
+    Observe(cache, events);
+
+    cache.Update(MakeService("BA1", "OpenThread"), 1, 120);
+    cache.Update(MakeService("BA1", "OpenThread"), 2, 120);
+    cache.Update(MakeService("BA2", "OpenThread"), 2, 120);
+    CHECK_EQUAL(2, events.mAdded);
+    CHECK_EQUAL(0, events.mUpdated);
+    CHECK_EQUAL(2UL, cache.GetSize());
+
+    // Still present on interface 2.
+    cache.Remove("BA1", 1);
+    CHECK_EQUAL(0, events.mRemoved);
+    CHECK(cache.Find("BA1") != NULL);
+
+    cache.Remove("BA1", 2);
+    CHECK_EQUAL(1, events.mRemoved);
+    STRCMP_EQUAL("BA1", events.mLastName.c_str());
+    CHECK(cache.Find("BA1") == NULL);
+
+    // Goodbye.
+    cache.Update(MakeService("BA2", "OpenThread"), 2, 0);
+    CHECK_EQUAL(2, events.mRemoved);
+    CHECK_EQUAL(0UL, cache.GetSize());
+
+    SetClock(NULL);
+}
+
+TEST(MdnsCache, TestUpdate)
+{
+    FakeClock                      clock(1000000);
+    ServiceCache                   cache;
+    CacheEvents                    events;
+    std::vector<DiscoveredService> services;
+    std::string                    networkName;
+
+    SetClock(&clock);
+    Observe(cache, events);
+
+    cache.Update(MakeService("BA1", "OpenThread"), 1, 120);
+    cache.Update(MakeService("BA1", "OpenThread"), 1, 120);
+    CHECK_EQUAL(0, events.mUpdated);
+
+    cache.Update(MakeService("BA1", "Renamed"), 1, 120);
+    CHECK_EQUAL(1, events.mAdded);
+    CHECK_EQUAL(1, events.mUpdated);
+
+    cache.GetServices(services);
+    CHECK_EQUAL(1U, services.size());
+    networkName.assign(services[0].mTxtList[0].mValue.begin(), services[0].mTxtList[0].mValue.end());
+    STRCMP_EQUAL("Renamed", networkName.c_str());
+
+    SetClock(NULL);
+}
+
+TEST(MdnsCache, TestExpiration)
+{
+    FakeClock    clock(1000000);
+    ServiceCache cache;
+    CacheEvents  events;
+    timeval      timeout;
+
+    SetClock(&clock);
+    Observe(cache, events);
+
+    cache.Update(MakeService("BA1", "OpenThread"), 1, 10);
+    cache.Update(MakeService("BA1", "OpenThread"), 2, 20);
+    cache.Update(MakeService("BA2", "OpenThread"), 1, ServiceCache::kTtlInfinite);
+
+    timeout.tv_sec  = 60;
+    timeout.tv_usec = 0;
+    cache.UpdateTimeout(timeout);
+    CHECK_EQUAL(10, timeout.tv_sec);
+
+    // The record on interface 1 expired, the one on interface 2 is still alive.
+    clock.Advance(10000000);
+    cache.Expire();
+    CHECK_EQUAL(0, events.mRemoved);
+
+    timeout.tv_sec = 60;
+    cache.UpdateTimeout(timeout);
+    CHECK_EQUAL(10, timeout.tv_sec);
+
+    clock.Advance(10000000);
+    cache.Expire();
+    CHECK_EQUAL(1, events.mRemoved);
+    STRCMP_EQUAL("BA1", events.mLastName.c_str());
+
+    // Services with infinite TTL are only removed by the MDNS service.
+    clock.Advance(1000000000);
+    cache.Expire();
+    CHECK_EQUAL(1, events.mRemoved);
+
+    cache.Clear();
+    CHECK_EQUAL(2, events.mRemoved);
+    CHECK_EQUAL(0UL, cache.GetSize());
+
+    SetClock(NULL);
+}
+
+TEST(MdnsCache, TestDecodeTxtData)
+{
+    const uint8_t data[] = {5, 'n', 'n', '=', 'O', 'T', 4, 'f', 'l', 'a', 'g', 0, 3, '=', 'n', 'o', 3, 'x', 'p', '='};
+    TxtList       txtList;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, DecodeTxtData(data, sizeof(data), txtList));
+    CHECK_EQUAL(3U, txtList.size());
+    STRCMP_EQUAL("nn", txtList[0].mName.c_str());
+    CHECK_EQUAL(2U, txtList[0].mValue.size());
+    BYTES_EQUAL('O', txtList[0].mValue[0]);
+    STRCMP_EQUAL("flag", txtList[1].mName.c_str());
+    CHECK(txtList[1].mValue.empty());
+    STRCMP_EQUAL("xp", txtList[2].mName.c_str());
+    CHECK(txtList[2].mValue.empty());
+
+    // Truncated.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, DecodeTxtData(data, 4, txtList));
+}
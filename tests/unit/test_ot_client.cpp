@@ -0,0 +1,122 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include <string>
+
+#include "web/web-service/ot_client.hpp"
+
+using ot::ReplyParser;
+
+static std::string GetOutput(const ReplyParser &aParser, const char *aBuffer)
+{
+    return std::string(aBuffer + aParser.GetOutputOffset(), aParser.GetOutputLength());
+}
+
+TEST_GROUP(ReplyParser){};
+
+TEST(ReplyParser, TestPartialLines)
+{
+    static const char kReply[] = "leader\r\nDone\r\n";
+    ReplyParser       parser;
+
+    // Lines are only taken once their line break arrives.
+    CHECK_EQUAL(ReplyParser::kResultPending, parser.Parse(kReply, 3));
+    CHECK_EQUAL(ReplyParser::kResultPending, parser.Parse(kReply, 10));
+    CHECK_EQUAL(ReplyParser::kResultPending, parser.Parse(kReply, 13));
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(kReply, 14));
+    STRCMP_EQUAL("leader", GetOutput(parser, kReply).c_str());
+    CHECK_EQUAL(8, parser.GetStatusOffset());
+    CHECK_EQUAL(14, parser.GetReplyLength());
+}
+
+TEST(ReplyParser, TestPrompts)
+{
+    static const char kReply[] = "> > leader\r\n> Done\r\n";
+    ReplyParser       parser;
+
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(kReply, sizeof(kReply) - 1));
+    STRCMP_EQUAL("leader", GetOutput(parser, kReply).c_str());
+    CHECK_EQUAL(14, parser.GetStatusOffset());
+    CHECK_EQUAL(sizeof(kReply) - 1, parser.GetReplyLength());
+}
+
+TEST(ReplyParser, TestLineBreaks)
+{
+    static const char kBlank[]  = "\r\n\n1234\r\n\r\nDone\r\n";
+    static const char kEmpty[]  = "Done\r\n";
+    static const char kBareLf[] = "1234\nDone\n";
+    ReplyParser       parser;
+
+    // Blank lines before the output and line breaks after it are not part of it.
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(kBlank, sizeof(kBlank) - 1));
+    STRCMP_EQUAL("1234", GetOutput(parser, kBlank).c_str());
+
+    parser.Reset();
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(kEmpty, sizeof(kEmpty) - 1));
+    CHECK_EQUAL(0, parser.GetOutputLength());
+
+    parser.Reset();
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(kBareLf, sizeof(kBareLf) - 1));
+    STRCMP_EQUAL("1234", GetOutput(parser, kBareLf).c_str());
+
+    // "Done" is only a status as a whole line.
+    parser.Reset();
+    CHECK_EQUAL(ReplyParser::kResultPending, parser.Parse("Done!\r\n", 7));
+}
+
+TEST(ReplyParser, TestPipelinedReplies)
+{
+    static const char kReplies[] = "1\r\nDone\r\n> Error 7: InvalidArgs\r\n> 3\r\nDone\r\n";
+    const char *      buffer     = kReplies;
+    size_t            length     = sizeof(kReplies) - 1;
+    ReplyParser       parser;
+
+    // Replies received in one read are taken one at a time.
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(buffer, length));
+    STRCMP_EQUAL("1", GetOutput(parser, buffer).c_str());
+    CHECK_EQUAL(9, parser.GetReplyLength());
+    buffer += parser.GetReplyLength();
+    length -= parser.GetReplyLength();
+
+    parser.Reset();
+    CHECK_EQUAL(ReplyParser::kResultError, parser.Parse(buffer, length));
+    STRNCMP_EQUAL("Error 7: InvalidArgs\r\n", buffer + parser.GetStatusOffset(), 22);
+    CHECK_EQUAL(0, parser.GetOutputLength());
+    buffer += parser.GetReplyLength();
+    length -= parser.GetReplyLength();
+
+    // A failed command does not affect the replies after it.
+    parser.Reset();
+    CHECK_EQUAL(ReplyParser::kResultDone, parser.Parse(buffer, length));
+    STRCMP_EQUAL("3", GetOutput(parser, buffer).c_str());
+    CHECK_EQUAL(length, parser.GetReplyLength());
+}
@@ -46,3 +46,65 @@ TEST(Pskc, Test123456_0001020304050607_OpenThread)
     pskc = mPSKc.ComputePskc(extpanid, "OpenThread", "123456");
     MEMCMP_EQUAL(expected, pskc, sizeof(expected));
 }
+
+TEST(Pskc, Test12SECRETPASSWORD34_0001020304050607_TestNetwork)
+{
+    uint8_t extpanid[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    uint8_t expected[] = {
+        0xc3, 0xf5, 0x93, 0x68, 0x44, 0x5a, 0x1b, 0x61, 0x06, 0xbe, 0x42, 0x0a, 0x70, 0x6d, 0x4c, 0xc9,
+    };
+    const uint8_t *pskc = NULL;
+
+    pskc = mPSKc.ComputePskc(extpanid, "Test Network", "12SECRETPASSWORD34");
+    MEMCMP_EQUAL(expected, pskc, sizeof(expected));
+}
+
+TEST(Pskc, TestPassphraseOfOneBlock)
+{
+    uint8_t extpanid[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    uint8_t expected[] = {
+        0x04, 0xbd, 0x94, 0xd1, 0xdc, 0x4b, 0xce, 0xa8, 0x0b, 0xae, 0x5e, 0xcc, 0x1f, 0xcb, 0x14, 0xd0,
+    };
+    const uint8_t *pskc = NULL;
+
+    // A passphrase of 16 bytes is used as the AES key without reduction.
+    pskc = mPSKc.ComputePskc(extpanid, "OpenThread", "0123456789abcdef");
+    MEMCMP_EQUAL(expected, pskc, sizeof(expected));
+}
+
+TEST(Pskc, TestEngineBatch)
+{
+    static const char *kNetworkNames[] = {"OpenThread", "Test Network", "OpenThread"};
+    static const char *kPassphrases[]  = {"123456", "12SECRETPASSWORD34", "123456"};
+    ot::Psk::PskcEngine engine(2, 3);
+    ot::Psk::PskcRequest requests[3];
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        memset(requests[i].mExtPanId, 0, sizeof(requests[i].mExtPanId));
+        requests[i].mExtPanId[7] = static_cast<uint8_t>(i);
+        requests[i].mNetworkName = kNetworkNames[i];
+        requests[i].mPassphrase  = kPassphrases[i];
+    }
+
+    engine.ComputePskc(requests, 3);
+    CHECK_EQUAL(3, engine.GetCounters().mMisses);
+    CHECK_EQUAL(1, engine.GetCounters().mEvictions);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        MEMCMP_EQUAL(mPSKc.ComputePskc(requests[i].mExtPanId, kNetworkNames[i], kPassphrases[i]), requests[i].mPskc,
+                     sizeof(requests[i].mPskc));
+    }
+
+    // The first network was evicted, the last one is cached.
+    engine.ComputePskc(requests[2].mExtPanId, kNetworkNames[2], kPassphrases[2]);
+    CHECK_EQUAL(1, engine.GetCounters().mHits);
+    engine.ComputePskc(requests[0].mExtPanId, kNetworkNames[0], kPassphrases[0]);
+    CHECK_EQUAL(4, engine.GetCounters().mMisses);
+
+    engine.Clear();
+    MEMCMP_EQUAL(requests[1].mPskc, engine.ComputePskc(requests[1].mExtPanId, kNetworkNames[1], kPassphrases[1]),
+                 sizeof(requests[1].mPskc));
+    CHECK_EQUAL(5, engine.GetCounters().mMisses);
+}
@@ -0,0 +1,187 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "agent/state_server.hpp"
+#include "common/coap_native.hpp"
+#include "common/event_loop.hpp"
+#include "common/time.hpp"
+
+using namespace ot::BorderRouter;
+
+enum
+{
+    kTestPort = 45683,
+};
+
+class FakeController : public Ncp::Controller
+{
+public:
+    otbrError Init(EventLoop &) { return OTBR_ERROR_NONE; }
+    otbrError CommissionerStart(void) { return OTBR_ERROR_NONE; }
+    otbrError CommissionerStop(void) { return OTBR_ERROR_NONE; }
+    otbrError CommissionerAddJoiner(const uint8_t *, const char *, uint32_t) { return OTBR_ERROR_NONE; }
+#if OTBR_ENABLE_NCP_WPANTUND
+    otbrError UdpForwardSend(const uint8_t *, uint16_t, uint16_t, const in6_addr &, uint16_t)
+    {
+        return OTBR_ERROR_NONE;
+    }
+#endif
+    otbrError RequestEvent(int) { return OTBR_ERROR_NONE; }
+};
+
+/**
+ * This class creates an event loop on a fake clock, which outlives the servers declared after it.
+ *
+ */
+class TestEventLoop
+{
+public:
+    explicit TestEventLoop(FakeClock &aClock)
+        : mEventLoop(NULL)
+    {
+        SetClock(&aClock);
+        mEventLoop = EventLoop::Create();
+    }
+
+    ~TestEventLoop(void)
+    {
+        EventLoop::Destroy(mEventLoop);
+        SetClock(NULL);
+    }
+
+    operator EventLoop &(void) { return *mEventLoop; }
+
+private:
+    EventLoop *mEventLoop;
+};
+
+static void Poll(EventLoop &aEventLoop)
+{
+    const timeval timeout = {0, 50000};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, aEventLoop.Poll(timeout));
+}
+
+static bool Receive(int aSocket, Coap::MessageNative &aMessage, uint8_t *aBuffer, size_t aSize)
+{
+    ssize_t count = recv(aSocket, aBuffer, aSize, MSG_DONTWAIT);
+
+    return count > 0 && aMessage.Parse(aBuffer, static_cast<uint16_t>(count)) == OTBR_ERROR_NONE;
+}
+
+TEST_GROUP(StateServer){};
+
+TEST(StateServer, TestObserveThreadState)
+{
+    FakeClock           clock(1000000);
+    TestEventLoop       eventLoop(clock);
+    FakeController      ncp;
+    StateServer         server(&ncp, kTestPort);
+    int                 client = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in6        sin6;
+    Coap::MessageNative message;
+    uint8_t             buffer[Coap::MessageNative::kMaxSize];
+    const uint8_t *     payload;
+    uint16_t            length;
+    uint8_t             token = 0x42;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, server.Init(eventLoop));
+
+    memset(&sin6, 0, sizeof(sin6));
+    sin6.sin6_family = AF_INET6;
+    sin6.sin6_addr   = in6addr_loopback;
+    sin6.sin6_port   = htons(kTestPort);
+    CHECK_EQUAL(0, connect(client, reinterpret_cast<sockaddr *>(&sin6), sizeof(sin6)));
+
+    message.Init(Coap::kTypeConfirmable, Coap::kCodeGet, 1, &token, sizeof(token));
+    message.SetPath("s/ts");
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.AddUintOption(Coap::kOptionObserve, 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, message.Serialize(buffer, sizeof(buffer), length));
+    CHECK_EQUAL(length, send(client, buffer, length, 0));
+
+    Poll(eventLoop);
+    CHECK(Receive(client, message, buffer, sizeof(buffer)));
+    CHECK_EQUAL(Coap::kCodeContent, message.GetCode());
+    payload = message.GetPayload(length);
+    CHECK_EQUAL(8, length);
+    CHECK_EQUAL(0, memcmp("detached", payload, length));
+
+    // Changes within the coalescing delay make one notification of the last state.
+    ncp.Emit<Ncp::kEventThreadState>(true);
+    ncp.Emit<Ncp::kEventThreadState>(false);
+    ncp.Emit<Ncp::kEventThreadState>(true);
+    Poll(eventLoop);
+    CHECK(!Receive(client, message, buffer, sizeof(buffer)));
+
+    clock.Advance(StateServer::kCoalesceDelay * 1000);
+    Poll(eventLoop);
+    CHECK(Receive(client, message, buffer, sizeof(buffer)));
+    CHECK_EQUAL(Coap::kTypeNonConfirmable, message.GetType());
+    payload = message.GetPayload(length);
+    CHECK_EQUAL(8, length);
+    CHECK_EQUAL(0, memcmp("attached", payload, length));
+    CHECK(!Receive(client, message, buffer, sizeof(buffer)));
+
+    // A flap back to the notified state is not notified.
+    ncp.Emit<Ncp::kEventThreadState>(false);
+    ncp.Emit<Ncp::kEventThreadState>(true);
+    clock.Advance(StateServer::kCoalesceDelay * 1000);
+    Poll(eventLoop);
+    CHECK(!Receive(client, message, buffer, sizeof(buffer)));
+
+    close(client);
+}
+
+TEST(StateServer, TestInitPortInUse)
+{
+    FakeClock      clock(1000000);
+    TestEventLoop  eventLoop(clock);
+    FakeController ncp;
+    StateServer    server(&ncp, kTestPort);
+    int            other = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in6   sin6;
+
+    memset(&sin6, 0, sizeof(sin6));
+    sin6.sin6_family = AF_INET6;
+    sin6.sin6_addr   = in6addr_loopback;
+    sin6.sin6_port   = htons(kTestPort);
+    CHECK_EQUAL(0, bind(other, reinterpret_cast<sockaddr *>(&sin6), sizeof(sin6)));
+
+    CHECK(server.Init(eventLoop) != OTBR_ERROR_NONE);
+
+    // The event loop keeps running with the server disabled.
+    Poll(eventLoop);
+
+    close(other);
+}
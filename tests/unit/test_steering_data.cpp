@@ -0,0 +1,150 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <mbedtls/sha256.h>
+
+#include "utils/crc16.hpp"
+#include "utils/steering_data.hpp"
+
+TEST_GROUP(SteeringData){};
+
+static uint16_t ComputeCrc16Bitwise(uint16_t aPolynomial, const uint8_t *aBuffer, size_t aLength)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        crc ^= static_cast<uint16_t>(aBuffer[i] << 8);
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>(static_cast<uint16_t>(crc << 1) ^ aPolynomial)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+TEST(SteeringData, TestCrc16)
+{
+    uint8_t buffer[37];
+
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    for (size_t length = 0; length <= sizeof(buffer); length++)
+    {
+        ot::Crc16 ccitt(ot::Crc16::kCcitt);
+        ot::Crc16 ansi(ot::Crc16::kAnsi);
+        ot::Crc16 ansiByByte(ot::Crc16::kAnsi);
+
+        ccitt.Update(buffer, length);
+        ansi.Update(buffer, length);
+
+        for (size_t i = 0; i < length; i++)
+        {
+            ansiByByte.Update(buffer[i]);
+        }
+
+        CHECK_EQUAL(ComputeCrc16Bitwise(ot::Crc16::kCcitt, buffer, length), ccitt.Get());
+        CHECK_EQUAL(ComputeCrc16Bitwise(ot::Crc16::kAnsi, buffer, length), ansi.Get());
+        CHECK_EQUAL(ansi.Get(), ansiByByte.Get());
+    }
+
+    {
+        // The check value of CRC-16/XMODEM.
+        ot::Crc16 ccitt(ot::Crc16::kCcitt);
+
+        ccitt.Update(reinterpret_cast<const uint8_t *>("123456789"), 9);
+        CHECK_EQUAL(0x31c3, ccitt.Get());
+    }
+}
+
+TEST(SteeringData, TestJoinerIds)
+{
+    uint8_t eui64s[3 * ot::SteeringData::kSizeEui64] = {
+        0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x02, 0x18, 0xb4, 0x30, 0x00,
+        0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    };
+    uint8_t joinerIds[sizeof(eui64s)];
+
+    ot::SteeringData::ComputeJoinerIds(eui64s, 3, joinerIds);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        uint8_t hash[32];
+
+        mbedtls_sha256_ret(eui64s + i * ot::SteeringData::kSizeEui64, ot::SteeringData::kSizeEui64, hash, 0);
+        hash[0] |= 2;
+        MEMCMP_EQUAL(hash, joinerIds + i * ot::SteeringData::kSizeJoinerId, ot::SteeringData::kSizeJoinerId);
+    }
+
+    // Joiner ids can be computed in place.
+    ot::SteeringData::ComputeJoinerIds(eui64s, 3, eui64s);
+    MEMCMP_EQUAL(joinerIds, eui64s, sizeof(eui64s));
+}
+
+TEST(SteeringData, TestAddJoiners)
+{
+    uint8_t          eui64s[200 * ot::SteeringData::kSizeEui64];
+    ot::SteeringData batch;
+    ot::SteeringData single;
+    const uint8_t    expected[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12,
+    };
+
+    batch.Init(16);
+    batch.AddJoiners(reinterpret_cast<const uint8_t *>("\x18\xb4\x30\x00\x00\x00\x00\x02"
+                                                       "\x18\xb4\x30\x00\x00\x00\x00\x03"),
+                     2);
+    MEMCMP_EQUAL(expected, batch.GetBloomFilter(), sizeof(expected));
+
+    for (size_t i = 0; i < sizeof(eui64s); i++)
+    {
+        eui64s[i] = static_cast<uint8_t>(i * 7 + i / 8);
+    }
+
+    batch.Init(15);
+    single.Init(15);
+    batch.AddJoiners(eui64s, 200);
+
+    for (size_t i = 0; i < 200; i++)
+    {
+        uint8_t joinerId[ot::SteeringData::kSizeJoinerId];
+
+        ot::SteeringData::ComputeJoinerId(eui64s + i * ot::SteeringData::kSizeEui64, joinerId);
+        single.ComputeBloomFilter(joinerId);
+    }
+
+    MEMCMP_EQUAL(single.GetBloomFilter(), batch.GetBloomFilter(), 15);
+}
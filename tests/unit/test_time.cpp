@@ -0,0 +1,85 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "common/time.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(Time){};
+
+TEST(Time, TestSystemClockMonotonic)
+{
+    SystemClock clock;
+    uint64_t    last = clock.GetMicros();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64_t now = clock.GetMicros();
+
+        CHECK(now >= last);
+        last = now;
+    }
+
+    CHECK(clock.GetCoarseMicros() > 0);
+}
+
+TEST(Time, TestFakeClock)
+{
+    FakeClock clock(5000000);
+
+    SetClock(&clock);
+    CHECK_EQUAL(5000000ULL, GetNowMicros());
+    CHECK_EQUAL(5000UL, GetNow());
+
+    clock.Advance(1500);
+    CHECK_EQUAL(5001500ULL, GetNowMicros());
+    CHECK_EQUAL(5001UL, GetNow());
+    CHECK_EQUAL(5001500ULL, GetCoarseNowMicros());
+
+    SetClock(NULL);
+}
+
+TEST(Time, TestCachedNow)
+{
+    FakeClock clock(1000);
+
+    SetClock(&clock);
+
+    UpdateNow();
+    clock.Advance(1000);
+    CHECK_EQUAL(1000ULL, GetNowMicros());
+    // Coarse readings are never cached.
+    CHECK_EQUAL(2000ULL, GetCoarseNowMicros());
+
+    ClearNow();
+    CHECK_EQUAL(2000ULL, GetNowMicros());
+
+    SetClock(NULL);
+}
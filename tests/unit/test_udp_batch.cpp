@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/udp_batch.hpp"
+
+using ot::BorderRouter::UdpBatch;
+
+static int CreateSocket(sockaddr_in6 &aSockAddr)
+{
+    int       fd      = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    socklen_t socklen = sizeof(aSockAddr);
+
+    CHECK(fd != -1);
+
+    memset(&aSockAddr, 0, sizeof(aSockAddr));
+    aSockAddr.sin6_family = AF_INET6;
+    aSockAddr.sin6_addr   = in6addr_loopback;
+    CHECK_EQUAL(0, bind(fd, reinterpret_cast<sockaddr *>(&aSockAddr), sizeof(aSockAddr)));
+    CHECK_EQUAL(0, getsockname(fd, reinterpret_cast<sockaddr *>(&aSockAddr), &socklen));
+
+    return fd;
+}
+
+TEST_GROUP(UdpBatch){};
+
+TEST(UdpBatch, TestSendAndReceiveBatch)
+{
+    sockaddr_in6 senderSock;
+    sockaddr_in6 receiverSock;
+    int          sender   = CreateSocket(senderSock);
+    int          receiver = CreateSocket(receiverSock);
+    UdpBatch     batch(4);
+    int          one = 1;
+
+    CHECK_EQUAL(0, setsockopt(receiver, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one)));
+
+    // Nothing to receive.
+    CHECK_EQUAL(0, batch.Receive(receiver));
+
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        uint8_t packet[] = {i, i, i};
+
+        CHECK_EQUAL(OTBR_ERROR_NONE, batch.Send(sender, packet, i % sizeof(packet) + 1, receiverSock, NULL));
+    }
+
+    // The queue was flushed once when full.
+    CHECK(batch.HasPending());
+    CHECK_EQUAL(OTBR_ERROR_NONE, batch.Flush(sender));
+    CHECK(!batch.HasPending());
+    CHECK_EQUAL(2UL, batch.GetCounters().mSendBatches);
+    CHECK_EQUAL(6UL, batch.GetCounters().mSentDatagrams);
+
+    CHECK_EQUAL(4, batch.Receive(receiver));
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        const UdpBatch::Datagram &datagram = batch.GetReceived(i);
+
+        CHECK_EQUAL(i % 3 + 1, datagram.mLength);
+        CHECK_EQUAL(i, datagram.mPacket[0]);
+        CHECK_EQUAL(senderSock.sin6_port, datagram.mPeerSock.sin6_port);
+        CHECK(IN6_IS_ADDR_LOOPBACK(&datagram.mLocalSock.sin6_addr));
+    }
+
+    CHECK_EQUAL(2, batch.Receive(receiver));
+    CHECK_EQUAL(4, batch.GetReceived(0).mPacket[0]);
+    CHECK_EQUAL(2UL, batch.GetCounters().mReceiveBatches);
+    CHECK_EQUAL(1UL, batch.GetCounters().mFullReceiveBatches);
+    CHECK_EQUAL(6UL, batch.GetCounters().mReceivedDatagrams);
+
+    close(sender);
+    close(receiver);
+}
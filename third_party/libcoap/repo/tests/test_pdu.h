@@ -1,11 +0,0 @@
-/* libcoap unit tests
- *
- * Copyright (C) 2012 Olaf Bergmann <bergmann@tzi.org>
- *
- * This file is part of the CoAP library libcoap. Please see
- * README for terms of use. 
- */
-
-#include <CUnit/CUnit.h>
-
-CU_pSuite t_init_pdu_tests(void);
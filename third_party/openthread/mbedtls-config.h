@@ -45,6 +45,7 @@
 #define MBEDTLS_SSL_EXPORT_KEYS
 
 #define MBEDTLS_AES_C
+#define MBEDTLS_AESNI_C
 #define MBEDTLS_ASN1_PARSE_C
 #define MBEDTLS_ASN1_WRITE_C
 #define MBEDTLS_BIGNUM_C
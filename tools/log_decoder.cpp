@@ -0,0 +1,75 @@
+/*
+ *    Copyright (c) 2018, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements a simple tool to decode binary logs.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/log_record.hpp"
+
+using namespace ot::BorderRouter;
+
+void help(void)
+{
+    printf("log-decoder - decode binary logs of otbr-agent\n"
+           "SYNTAX:\n"
+           "    log-decoder <BINARY_LOG>\n"
+           "EXAMPLE:\n"
+           "    log-decoder /var/log/otbr-agent.log\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int   ret  = -1;
+    FILE *file = NULL;
+
+    if (argc != 2)
+    {
+        ExitNow(help());
+    }
+
+    file = fopen(argv[1], "rb");
+    VerifyOrExit(file != NULL, fprintf(stderr, "Failed to open %s: %s\n", argv[1], strerror(errno)));
+    VerifyOrExit(Log::DecodeBinary(file, stdout) == OTBR_ERROR_NONE,
+                 fprintf(stderr, "Invalid or truncated binary log: %s\n", argv[1]));
+
+    ret = 0;
+
+exit:
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return ret;
+}
@@ -32,6 +32,11 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
 
 #include "common/code_utils.hpp"
 #include "utils/hex.hpp"
@@ -45,6 +50,7 @@ enum
     kMaxNetworkName = 16,
     kMaxPassphrase  = 255,
     kSizeExtPanId   = 8,
+    kBatchSize      = 256,
 };
 
 void help(void)
@@ -52,55 +58,190 @@ void help(void)
     printf("pskc - compute PSKc\n"
            "SYNTAX:\n"
            "    pskc <PASSPHRASE> <EXTPANID> <NETWORK_NAME>\n"
+           "    pskc --csv [FILE]\n"
+           "        Reads lines of PASSPHRASE,EXTPANID,NETWORK_NAME from FILE or standard input, and prints each line\n"
+           "        followed by its PSKc. Fields are split at the last two commas, so only PASSPHRASE may contain\n"
+           "        commas. Empty lines are skipped.\n"
            "EXAMPLE:\n"
-           "    pskc 654321 1122334455667788 OpenThread\n");
+           "    pskc 654321 1122334455667788 OpenThread\n"
+           "    echo 654321,1122334455667788,OpenThread | pskc --csv\n");
 }
 
-int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+bool parseArguments(const char *aPassphrase,
+                    const char *aExtPanId,
+                    const char *aNetworkName,
+                    uint8_t *   aExtPanIdBin,
+                    FILE *      aErrorStream)
 {
-    uint8_t extpanid[kSizeExtPanId];
-    size_t  length;
-    int     ret = -1;
-
-    ot::Psk::Pskc  pskcComputer;
-    const uint8_t *pskc;
+    size_t length;
+    bool   ret = false;
 
     length = strlen(aPassphrase);
-    VerifyOrExit(length > 0, printf("PASSPHRASE must not be empty.\n"));
+    VerifyOrExit(length > 0, fprintf(aErrorStream, "PASSPHRASE must not be empty.\n"));
     VerifyOrExit(length <= kMaxPassphrase,
-                 printf("PASSPHRASE Passphrase must be no more than %d bytes.\n", kMaxPassphrase));
+                 fprintf(aErrorStream, "PASSPHRASE Passphrase must be no more than %d bytes.\n", kMaxPassphrase));
 
     length = strlen(aExtPanId);
-    VerifyOrExit(length == kSizeExtPanId * 2, printf("EXTPANID length must be %d bytes.\n", kSizeExtPanId));
+    VerifyOrExit(length == kSizeExtPanId * 2,
+                 fprintf(aErrorStream, "EXTPANID length must be %d bytes.\n", kSizeExtPanId));
     for (size_t i = 0; i < length; i++)
     {
         VerifyOrExit((aExtPanId[i] <= '9' && aExtPanId[i] >= '0') || (aExtPanId[i] <= 'f' && aExtPanId[i] >= 'a') ||
                          (aExtPanId[i] <= 'F' && aExtPanId[i] >= 'A'),
-                     printf("EXTPANID must be encoded in hex.\n"));
+                     fprintf(aErrorStream, "EXTPANID must be encoded in hex.\n"));
     }
-    ot::Utils::Hex2Bytes(aExtPanId, extpanid, sizeof(extpanid));
+    ot::Utils::Hex2Bytes(aExtPanId, aExtPanIdBin, kSizeExtPanId);
 
     length = strlen(aNetworkName);
-    VerifyOrExit(length > 0, printf("NETWORK_NAME must not be empty.\n"));
+    VerifyOrExit(length > 0, fprintf(aErrorStream, "NETWORK_NAME must not be empty.\n"));
     VerifyOrExit(length <= kMaxNetworkName,
-                 printf("NETWOR_KNAME length must be no more than %d bytes.\n", kMaxNetworkName));
+                 fprintf(aErrorStream, "NETWOR_KNAME length must be no more than %d bytes.\n", kMaxNetworkName));
+
+    ret = true;
+
+exit:
+    return ret;
+}
 
-    pskc = pskcComputer.ComputePskc(extpanid, aNetworkName, aPassphrase);
-    for (int i = 0; i < 16; i++)
+void printHex(const uint8_t *aPskc)
+{
+    for (int i = 0; i < OT_PSKC_LENGTH; i++)
     {
-        printf("%02x", pskc[i]);
+        printf("%02x", aPskc[i]);
     }
     printf("\n");
+}
+
+int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+{
+    uint8_t extpanid[kSizeExtPanId];
+    int     ret = -1;
+
+    ot::Psk::Pskc pskcComputer;
+
+    VerifyOrExit(parseArguments(aPassphrase, aExtPanId, aNetworkName, extpanid, stdout));
+
+    printHex(pskcComputer.ComputePskc(extpanid, aNetworkName, aPassphrase));
     ret = 0;
 
 exit:
     return ret;
 }
 
+/**
+ * This function computes and prints PSKc of a batch of lines, which are split into fields in place.
+ *
+ */
+int printPSKcBatch(ot::Psk::PskcEngine &aEngine, std::vector<std::string> &aLines, unsigned long aLineNumber)
+{
+    std::vector<ot::Psk::PskcRequest> requests;
+    std::vector<const char *>         extPanIds;
+    int                               ret = 0;
+
+    for (size_t i = 0; i < aLines.size(); ++i)
+    {
+        std::string &        line      = aLines[i];
+        size_t               nameStart = line.rfind(',');
+        size_t               panStart  = nameStart == std::string::npos ? nameStart : line.rfind(',', nameStart - 1);
+        ot::Psk::PskcRequest request;
+
+        if (line.empty())
+        {
+            continue;
+        }
+
+        if (panStart == std::string::npos || nameStart == 0)
+        {
+            fprintf(stderr, "line %lu: expect PASSPHRASE,EXTPANID,NETWORK_NAME.\n", aLineNumber + i);
+            ret = -1;
+            continue;
+        }
+
+        line[panStart]  = '\0';
+        line[nameStart] = '\0';
+
+        request.mPassphrase  = &line[0];
+        request.mNetworkName = &line[nameStart + 1];
+
+        if (!parseArguments(request.mPassphrase, &line[panStart + 1], request.mNetworkName, request.mExtPanId, stderr))
+        {
+            fprintf(stderr, "line %lu: invalid arguments.\n", aLineNumber + i);
+            ret = -1;
+            continue;
+        }
+
+        requests.push_back(request);
+        extPanIds.push_back(&line[panStart + 1]);
+    }
+
+    aEngine.ComputePskc(requests.data(), requests.size());
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        printf("%s,%s,%s,", requests[i].mPassphrase, extPanIds[i], requests[i].mNetworkName);
+        printHex(requests[i].mPskc);
+    }
+
+    return ret;
+}
+
+int printPSKcCsv(const char *aFileName)
+{
+    FILE *                   input  = stdin;
+    char *                   buffer = NULL;
+    size_t                   size   = 0;
+    ssize_t                  length;
+    unsigned long            lineNumber = 1;
+    std::vector<std::string> lines;
+    ot::Psk::PskcEngine      engine;
+    int                      ret = 0;
+
+    if (aFileName != NULL)
+    {
+        input = fopen(aFileName, "r");
+        VerifyOrExit(input != NULL, perror(aFileName), ret = -1);
+    }
+
+    while ((length = getline(&buffer, &size, input)) != -1)
+    {
+        while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r'))
+        {
+            --length;
+        }
+
+        lines.push_back(std::string(buffer, static_cast<size_t>(length)));
+
+        if (lines.size() == kBatchSize)
+        {
+            ret |= printPSKcBatch(engine, lines, lineNumber);
+            lineNumber += lines.size();
+            lines.clear();
+        }
+    }
+
+    ret |= printPSKcBatch(engine, lines, lineNumber);
+
+exit:
+    free(buffer);
+
+    if (input != NULL && input != stdin)
+    {
+        fclose(input);
+    }
+
+    return ret;
+}
+
 int main(int argc, char *argv[])
 {
     int ret = 0;
 
+    if (argc >= 2 && strcmp(argv[1], "--csv") == 0)
+    {
+        VerifyOrExit(argc <= 3, help(), ret = -1);
+        ExitNow(ret = printPSKcCsv(argc == 3 ? argv[2] : NULL));
+    }
+
     VerifyOrExit(argc == 4, help(), ret = -1);
     ret = printPSKc(argv[1], argv[2], argv[3]);
 
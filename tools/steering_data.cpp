@@ -28,12 +28,14 @@
 
 /**
  * @file
- *   This file implements a simple tool to compute pskc.
+ *   This file implements a simple tool to compute steering data.
  */
 
-#include <mbedtls/sha256.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <vector>
 
 #include "common/code_utils.hpp"
 #include "utils/hex.hpp"
@@ -46,25 +48,74 @@ void help(void)
     printf("steering-data - compute steering data\n"
            "SYNTAX:\n"
            "    steering-data [LENGTH] <JOINER_ID> ...\n"
+           "    steering-data [LENGTH] --file <FILE>\n"
+           "        Reads one JOINER_ID per line from FILE, or from standard input if FILE is -.\n"
+           "        Empty lines are skipped.\n"
            "EXAMPLE:\n"
            "    steering-data 18b4300000000001\n"
            "    steering-data 15 18b4300000000001\n"
-           "    steering-data 18b4300000000001 18b4300000000002\n");
+           "    steering-data 18b4300000000001 18b4300000000002\n"
+           "    steering-data --file joiners.txt\n");
 }
 
-int ComputeJoinerId(const char *aEui64, uint8_t *aJoinerId)
+int ParseEui64(const char *aEui64, std::vector<uint8_t> &aEui64s)
 {
-    int ret = -1;
+    int     ret = -1;
+    uint8_t eui64[SteeringData::kSizeEui64];
 
-    VerifyOrExit(strlen(aEui64) == SteeringData::kSizeJoinerId * 2);
-    VerifyOrExit(ot::Utils::Hex2Bytes(aEui64, aJoinerId, SteeringData::kSizeJoinerId) == SteeringData::kSizeJoinerId);
-    ot::SteeringData::ComputeJoinerId(aJoinerId, aJoinerId);
+    VerifyOrExit(strlen(aEui64) == SteeringData::kSizeEui64 * 2);
+    VerifyOrExit(ot::Utils::Hex2Bytes(aEui64, eui64, sizeof(eui64)) == sizeof(eui64));
+    aEui64s.insert(aEui64s.end(), eui64, eui64 + sizeof(eui64));
     ret = 0;
 
 exit:
     if (ret != 0)
     {
-        fprintf(stderr, "Invalid EUI64: %s", aEui64);
+        fprintf(stderr, "Invalid EUI64: %s\n", aEui64);
+    }
+
+    return ret;
+}
+
+int ReadEui64s(const char *aFileName, std::vector<uint8_t> &aEui64s)
+{
+    FILE *        input  = stdin;
+    char *        buffer = NULL;
+    size_t        size   = 0;
+    ssize_t       length;
+    unsigned long lineNumber = 0;
+    int           ret        = 0;
+
+    if (strcmp(aFileName, "-") != 0)
+    {
+        input = fopen(aFileName, "r");
+        VerifyOrExit(input != NULL, perror(aFileName), ret = -1);
+    }
+
+    while ((length = getline(&buffer, &size, input)) != -1)
+    {
+        ++lineNumber;
+
+        while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r'))
+        {
+            buffer[--length] = '\0';
+        }
+
+        if (length == 0)
+        {
+            continue;
+        }
+
+        VerifyOrExit(ParseEui64(buffer, aEui64s) == 0, fprintf(stderr, "at line %lu of %s\n", lineNumber, aFileName),
+                     ret = -1);
+    }
+
+exit:
+    free(buffer);
+
+    if (input != NULL && input != stdin)
+    {
+        fclose(input);
     }
 
     return ret;
@@ -72,17 +123,18 @@ exit:
 
 int main(int argc, char *argv[])
 {
-    ot::SteeringData computer;
-    int              ret    = -1;
-    int              length = 16;
-    int              i      = 1;
+    ot::SteeringData     computer;
+    std::vector<uint8_t> eui64s;
+    int                  ret    = -1;
+    int                  length = 16;
+    int                  i      = 1;
 
     if (argc < 2)
     {
         ExitNow(help());
     }
 
-    if (strlen(argv[i]) != SteeringData::kSizeJoinerId * 2)
+    if (strlen(argv[i]) != SteeringData::kSizeJoinerId * 2 && strcmp(argv[i], "--file") != 0)
     {
         length = atoi(argv[i]);
         VerifyOrExit(length > 0 && length <= SteeringData::kMaxSizeOfBloomFilter,
@@ -93,13 +145,20 @@ int main(int argc, char *argv[])
 
     computer.Init(static_cast<uint8_t>(length));
 
-    for (; i < argc; ++i)
+    if (i < argc && strcmp(argv[i], "--file") == 0)
     {
-        uint8_t joinerId[SteeringData::kSizeJoinerId];
-
-        VerifyOrExit(ComputeJoinerId(argv[i], joinerId) == 0, fprintf(stderr, "Invalid EUI64 : %s\n", argv[i]));
-        computer.ComputeBloomFilter(joinerId);
+        VerifyOrExit(i + 2 == argc, help());
+        SuccessOrExit(ReadEui64s(argv[i + 1], eui64s));
     }
+    else
+    {
+        for (; i < argc; ++i)
+        {
+            SuccessOrExit(ParseEui64(argv[i], eui64s));
+        }
+    }
+
+    computer.AddJoiners(eui64s.data(), eui64s.size() / SteeringData::kSizeEui64);
 
     for (i = 0; i < length; i++)
     {